@@ -0,0 +1,36 @@
+#!/usr/bin/env bash
+set -euo pipefail
+
+# Builds the per-plugin offline benchmarks in Release and writes one CSV covering
+# the whole suite. Extra arguments are forwarded to every benchmark executable,
+# e.g. scripts/run_benchmarks.sh --rates=48000 --blocks=128 --seconds=2
+
+SCRIPT_DIR="$(cd "$(dirname "$0")" && pwd)"
+ROOT_DIR="$(cd "$SCRIPT_DIR/.." && pwd)"
+BUILD_DIR="${BENCH_BUILD_DIR:-$ROOT_DIR/GLS_Project/Builds/Benchmark}"
+OUTPUT_CSV="${BENCH_OUTPUT:-$BUILD_DIR/benchmark_results.csv}"
+
+cd "$ROOT_DIR/GLS_Project"
+cmake -B "$BUILD_DIR" -DCMAKE_BUILD_TYPE=Release -DGLS_BUILD_BENCHMARKS=ON
+cmake --build "$BUILD_DIR" --target GLSBenchmarks -- -j8
+
+BENCHMARKS=()
+while IFS= read -r bench; do
+  BENCHMARKS+=("$bench")
+done < <(find "$BUILD_DIR/Benchmarks" -maxdepth 1 -type f -name "*_Benchmark" -perm -u+x 2>/dev/null | sort)
+
+if [[ ${#BENCHMARKS[@]} -eq 0 ]]; then
+  echo "ERROR: No benchmark executables found under $BUILD_DIR/Benchmarks" >&2
+  exit 1
+fi
+
+echo "plugin,signal,sample_rate,block_size,ns_per_sample,realtime_factor,worst_block_load,allocations" > "$OUTPUT_CSV"
+
+for bench in "${BENCHMARKS[@]}"; do
+  echo "Benchmarking: $(basename "$bench")"
+  if ! "$bench" --csv "$@" | tail -n +2 >> "$OUTPUT_CSV"; then
+    echo "WARNING: $(basename "$bench") returned non-zero" >&2
+  fi
+done
+
+echo "Results written to $OUTPUT_CSV"
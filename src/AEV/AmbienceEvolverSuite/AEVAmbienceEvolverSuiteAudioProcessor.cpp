@@ -1,31 +1,81 @@
 #include "AEVAmbienceEvolverSuiteAudioProcessor.h"
 
+namespace
+{
+using Param = AEVAmbienceEvolverSuiteAudioProcessor::Param;
+using Spec = gls::ParameterSpec;
+
+constexpr std::array<Spec, (size_t) Param::count> parameterTable {{
+    Spec::range  ("ambience_level",    "Ambience Level", 0.0f,   1.0f,  0.001f, 0.5f),
+    Spec::range  ("deverb",            "De-Verb",        0.0f,   1.0f,  0.001f, 0.4f),
+    Spec::range  ("noise_suppression", "Noise",          0.0f,   1.0f,  0.001f, 0.5f),
+    Spec::range  ("transient_protect", "Transient",      0.0f,   1.0f,  0.001f, 0.6f),
+    Spec::range  ("tone_match",        "Tone Match",     0.0f,   1.0f,  0.001f, 0.5f),
+    Spec::range  ("hf_recover",        "HF Recover",     0.0f,   1.0f,  0.001f, 0.5f),
+    Spec::range  ("output_trim",       "Output Trim",    -12.0f, 12.0f, 0.1f,   0.0f),
+    Spec::range  ("mix",               "Mix",            0.0f,   1.0f,  0.001f, 1.0f),
+    Spec::range  ("input_trim",        "Input Trim",     -24.0f, 24.0f, 0.1f,   0.0f),
+    Spec::toggle ("ui_bypass",         "Soft Bypass",    false),
+    Spec::choice ("profile_slot",      "Profile Slot",   "Slot 1|Slot 2|Slot 3", 0),
+    Spec::choice ("nr_mode",           "NR Mode",        "Standard|Low Latency", 0)
+}};
+
+static_assert (gls::hasUniqueIds (parameterTable));
+} // namespace
+
 AEVAmbienceEvolverSuiteAudioProcessor::AEVAmbienceEvolverSuiteAudioProcessor()
     : DualPrecisionAudioProcessor(BusesProperties()
                         .withInput  ("Input", juce::AudioChannelSet::stereo(), true)
                         .withOutput ("Output", juce::AudioChannelSet::stereo(), true)),
-      apvts (*this, nullptr, "AMBIENCE_EVOLVER", createParameterLayout())
+      apvts (*this, nullptr, "AMBIENCE_EVOLVER", createParameterLayout()),
+      params (apvts, parameterTable)
 {
+    for (auto& profile : capturedProfiles)
+        profile.assign ((size_t) gls::dsp::SpectralDenoiser::profileSize, 0.0f);
+
+    pendingProfile.assign ((size_t) gls::dsp::SpectralDenoiser::profileSize, 0.0f);
+
+    bypass.snapOnResume (dryWet);
 }
 
 void AEVAmbienceEvolverSuiteAudioProcessor::prepareToPlay (double sampleRate, int samplesPerBlock)
 {
+    DualPrecisionAudioProcessor::prepareToPlay (sampleRate, samplesPerBlock);
+
     currentSampleRate = sampleRate > 0.0 ? sampleRate : 44100.0;
     lastBlockSize = (juce::uint32) juce::jmax (1, samplesPerBlock);
+    const auto numChannels = juce::jmax (1, getTotalNumOutputChannels());
     ensureStateSize (getTotalNumOutputChannels());
-    dryBuffer.setSize (juce::jmax (1, getTotalNumOutputChannels()),
-                       (int) lastBlockSize, false, false, true);
+
+    for (auto* smoother : { &inputTrimGain, &mixAmount, &outputTrimGain })
+        smoother->prepare (currentSampleRate, (int) lastBlockSize);
+
     for (auto& state : channelStates)
         state = {};
+
+    for (size_t i = 0; i < denoisers.size(); ++i)
+        denoisers[i].prepare (currentSampleRate, numChannels, (gls::dsp::SpectralDenoiser::Mode) i);
+
+    dryWet.prepare (currentSampleRate, numChannels, (int) lastBlockSize, denoisers[0].getLatencySamples());
+    bypass.prepare (currentSampleRate, numChannels, (int) lastBlockSize, denoisers[0].getLatencySamples());
+
+    profileCaptureActive.store (false);
+    profileDirty.store (true);
+    latency.invalidate();
+    updateDenoiser();
+    spectrumAnalyser.prepare (currentSampleRate);
 }
 
 void AEVAmbienceEvolverSuiteAudioProcessor::releaseResources()
 {
 }
 
-void AEVAmbienceEvolverSuiteAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer,
-                                                          juce::MidiBuffer&)
+void AEVAmbienceEvolverSuiteAudioProcessor::processFloat (juce::AudioBuffer<float>& buffer,
+                                                          juce::MidiBuffer& midi)
 {
+    if (renderInPreparedChunks (buffer, midi))
+        return;
+
     juce::ScopedNoDenormals noDenormals;
 
     auto totalIn  = getTotalNumInputChannels();
@@ -33,42 +83,65 @@ void AEVAmbienceEvolverSuiteAudioProcessor::processBlock (juce::AudioBuffer<floa
     for (int ch = totalIn; ch < totalOut; ++ch)
         buffer.clear (ch, 0, buffer.getNumSamples());
 
-    const bool bypassed = apvts.getRawParameterValue ("ui_bypass")->load() > 0.5f;
-    if (bypassed)
-        return;
+    updateDenoiser();
 
-    auto get = [this](const char* id) { return apvts.getRawParameterValue (id)->load(); };
+    // Bypass delays the dry signal by the reported latency so the host's compensation stays valid.
+    bypass.setLatency (latency.getTotalLatency());
+    dryWet.setLatency (latency.getTotalLatency());
+    if (! bypass.begin (buffer, buffer.getNumSamples(), params.isOn (Param::bypass)))
+        return;
 
-    const auto ambienceLevel = juce::jlimit (0.0f, 1.0f, get ("ambience_level"));
-    const auto deVerb        = juce::jlimit (0.0f, 1.0f, get ("deverb"));
-    const auto noiseSupp     = juce::jlimit (0.0f, 1.0f, get ("noise_suppression"));
-    const auto transientProt = juce::jlimit (0.0f, 1.0f, get ("transient_protect"));
-    const auto toneMatch     = juce::jlimit (0.0f, 1.0f, get ("tone_match"));
-    const auto hfRecover     = juce::jlimit (0.0f, 1.0f, get ("hf_recover"));
-    const auto outputTrimDb  = get ("output_trim");
-    const auto mix           = juce::jlimit (0.0f, 1.0f, get ("mix"));
-    const auto inputTrim     = juce::Decibels::decibelsToGain (get ("input_trim"));
-    const int profileSlot    = juce::jlimit (0, 2, (int) std::round (apvts.getRawParameterValue ("profile_slot")->load()));
+    const auto ambienceLevel = juce::jlimit (0.0f, 1.0f, params[Param::ambienceLevel]);
+    const auto deVerb        = juce::jlimit (0.0f, 1.0f, params[Param::deverb]);
+    const auto noiseSupp     = juce::jlimit (0.0f, 1.0f, params[Param::noiseSuppression]);
+    const auto transientProt = juce::jlimit (0.0f, 1.0f, params[Param::transientProtect]);
+    const auto toneMatch     = juce::jlimit (0.0f, 1.0f, params[Param::toneMatch]);
+    const auto hfRecover     = juce::jlimit (0.0f, 1.0f, params[Param::hfRecover]);
+    const int profileSlot    = juce::jlimit (0, 2, params.getIndex (Param::profileSlot));
 
     const int numChannels = buffer.getNumChannels();
     const int numSamples  = buffer.getNumSamples();
 
     lastBlockSize = (juce::uint32) juce::jmax (1, numSamples);
     ensureStateSize (numChannels);
-    dryBuffer.setSize (numChannels, numSamples, false, false, true);
 
-    buffer.applyGain (inputTrim);
-    dryBuffer.makeCopyOf (buffer, true);
+    // The cleanup below reads the aligned dry input, so the copy is kept at any mix.
+    dryWet.begin (buffer, numSamples, inputTrimGain, mixAmount, true);
+    const auto& dryBuffer = dryWet.getDry();
+
+    if (profileCaptureRequested.exchange (false))
+    {
+        captureSlot = profileSlot;
+        denoiser->startCapture (1.0);
+        profileCaptureActive.store (true);
+        profileProgress.store (0.0f);
+    }
+
+    updateProfiles (profileSlot);
+
+    gls::dsp::SpectralDenoiser::Settings settings;
+    settings.oversubtraction = 1.0f + noiseSupp;
+    settings.reverbWeight = deVerb * 0.6f;
+    settings.floorGain = juce::Decibels::decibelsToGain (-30.0f * noiseSupp - 12.0f * deVerb);
+    denoiser->setSettings (settings);
+    denoiser->process (buffer);
+
+    if (denoiser->isCapturing())
+        profileProgress.store (denoiser->getCaptureProgress());
+
+    if (denoiser->popCaptureComplete())
+    {
+        denoiser->getCapturedProfile (pendingProfile.data());
+        profilePending = true;
+        profileCaptureActive.store (false);
+        profileProgress.store (1.0f);
+    }
 
     const float ambienceBlend = ambienceLevel * 0.8f;
-    const float deVerbDecay = juce::jmap (deVerb, 0.1f, 0.9f);
     const float toneBlend = toneMatch * 0.5f;
     const float hfGain = juce::Decibels::decibelsToGain (hfRecover * 6.0f);
-    const float outputGain = juce::Decibels::decibelsToGain (outputTrimDb);
     const float transientThresh = juce::Decibels::decibelsToGain (-20.0f + transientProt * 10.0f);
 
-    refreshCapturedNoiseSnapshot();
-    const float noiseSnapshot = capturedNoiseValue.load();
     double rmsAccumulator = 0.0;
     auto updateRms = [numChannels, numSamples, this](double sumSquares)
     {
@@ -80,26 +153,16 @@ void AEVAmbienceEvolverSuiteAudioProcessor::processBlock (juce::AudioBuffer<floa
     for (int ch = 0; ch < numChannels; ++ch)
     {
         auto* data = buffer.getWritePointer (ch);
+        const auto* dry = dryBuffer.getReadPointer (ch);
         auto& state = channelStates[ch];
 
         for (int i = 0; i < numSamples; ++i)
         {
-            const float sample = data[i];
+            const float sample = dry[i];
             const float absSample = std::abs (sample);
 
-            state.noiseEstimate = 0.999f * state.noiseEstimate + 0.001f * absSample;
-            updateProfileState (absSample, ch);
-
-            const float ambience = state.ambienceState = 0.995f * state.ambienceState + 0.005f * sample;
-            const float ambienceRemoved = sample - ambience * ambienceBlend;
-
-            const float smear = state.toneState = state.toneState + deVerbDecay * (ambienceRemoved - state.toneState);
-            float cleaned = ambienceRemoved - smear * deVerb;
-
-            const float noiseFloor = juce::jmax (state.noiseEstimate, noiseSnapshot + 1.0e-6f);
-            const float gate = juce::jlimit (0.0f, 1.0f, (absSample - noiseFloor) / (noiseFloor + 1.0e-6f));
-            const float noiseReduction = juce::jmap (noiseSupp, 0.0f, 1.0f, gate, gate * 0.2f);
-            cleaned *= noiseReduction;
+            const float ambience = state.ambienceState = 0.995f * state.ambienceState + 0.005f * data[i];
+            float cleaned = data[i] - ambience * ambienceBlend;
 
             const float transientEnv = state.transientState = juce::jmax (absSample, state.transientState * 0.97f);
             if (transientEnv > transientThresh)
@@ -118,33 +181,35 @@ void AEVAmbienceEvolverSuiteAudioProcessor::processBlock (juce::AudioBuffer<floa
         }
     }
 
-    if (mix < 0.999f)
-    {
-        for (int ch = 0; ch < numChannels; ++ch)
-        {
-            const auto* dry = dryBuffer.getReadPointer (ch);
-            auto* data = buffer.getWritePointer (ch);
-            for (int i = 0; i < numSamples; ++i)
-                data[i] = data[i] * mix + dry[i] * (1.0f - mix);
-        }
-    }
-
-    buffer.applyGain (outputGain);
+    dryWet.end (buffer, numSamples, mixAmount, outputTrimGain);
+    bypass.end (buffer, numSamples);
     updateRms (rmsAccumulator);
+    spectrumAnalyser.push (buffer, numSamples);
 }
 
 void AEVAmbienceEvolverSuiteAudioProcessor::triggerProfileCapture()
 {
-    profileCaptureArmed = true;
-    profileSamplesRemaining = (int) currentSampleRate / 2;
-    profileAccumulators.assign (juce::jmax (1, getTotalNumInputChannels()), 0.0f);
-    profileTotalSamples = profileSamplesRemaining;
     profileProgress.store (0.0f);
+    profileCaptureRequested.store (true);
 }
 
 void AEVAmbienceEvolverSuiteAudioProcessor::getStateInformation (juce::MemoryBlock& destData)
 {
     auto state = apvts.copyState();
+    state.removeChild (state.getChildWithName ("NOISE_PROFILES"), nullptr);
+
+    juce::ValueTree profiles ("NOISE_PROFILES");
+    {
+        const juce::SpinLock::ScopedLockType lock (profileLock);
+        for (size_t slot = 0; slot < capturedProfiles.size(); ++slot)
+        {
+            const auto& profile = capturedProfiles[slot];
+            profiles.setProperty ("slot" + juce::String ((int) slot),
+                                  juce::MemoryBlock (profile.data(), profile.size() * sizeof (float)), nullptr);
+        }
+    }
+    state.appendChild (profiles, nullptr);
+
         juce::MemoryOutputStream stream (destData, false);
         state.writeToStream (stream);
 }
@@ -152,47 +217,49 @@ void AEVAmbienceEvolverSuiteAudioProcessor::getStateInformation (juce::MemoryBlo
 void AEVAmbienceEvolverSuiteAudioProcessor::setStateInformation (const void* data, int sizeInBytes)
 {
     if (auto tree = juce::ValueTree::readFromData (data, sizeInBytes); tree.isValid())
+    {
+        if (auto profiles = tree.getChildWithName ("NOISE_PROFILES"); profiles.isValid())
+        {
+            const juce::SpinLock::ScopedLockType lock (profileLock);
+            for (size_t slot = 0; slot < capturedProfiles.size(); ++slot)
+            {
+                auto& profile = capturedProfiles[slot];
+                std::fill (profile.begin(), profile.end(), 0.0f);
+
+                if (auto* block = profiles.getProperty ("slot" + juce::String ((int) slot)).getBinaryData())
+                    block->copyTo (profile.data(), 0, juce::jmin (block->getSize(), profile.size() * sizeof (float)));
+            }
+
+            tree.removeChild (profiles, nullptr);
+        }
+
         apvts.replaceState (tree);
+        profileDirty.store (true);
+    }
 }
 
 juce::AudioProcessorValueTreeState::ParameterLayout
 AEVAmbienceEvolverSuiteAudioProcessor::createParameterLayout()
 {
-    std::vector<std::unique_ptr<juce::RangedAudioParameter>> params;
-
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("ambience_level", "Ambience Level",
-                                                                   juce::NormalisableRange<float> (0.0f, 1.0f, 0.001f), 0.5f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("deverb",          "De-Verb",
-                                                                   juce::NormalisableRange<float> (0.0f, 1.0f, 0.001f), 0.4f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("noise_suppression","Noise",
-                                                                   juce::NormalisableRange<float> (0.0f, 1.0f, 0.001f), 0.5f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("transient_protect","Transient",
-                                                                   juce::NormalisableRange<float> (0.0f, 1.0f, 0.001f), 0.6f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("tone_match",      "Tone Match",
-                                                                   juce::NormalisableRange<float> (0.0f, 1.0f, 0.001f), 0.5f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("hf_recover",      "HF Recover",
-                                                                   juce::NormalisableRange<float> (0.0f, 1.0f, 0.001f), 0.5f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("output_trim",     "Output Trim",
-                                                                   juce::NormalisableRange<float> (-12.0f, 12.0f, 0.1f), 0.0f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("mix",             "Mix",
-                                                                   juce::NormalisableRange<float> (0.0f, 1.0f, 0.001f), 1.0f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("input_trim",      "Input Trim",
-                                                                   juce::NormalisableRange<float> (-24.0f, 24.0f, 0.1f), 0.0f));
-    params.push_back (std::make_unique<juce::AudioParameterBool>  ("ui_bypass",       "Soft Bypass", false));
-    params.push_back (std::make_unique<juce::AudioParameterChoice> ("profile_slot",   "Profile Slot",
-                                                                    juce::StringArray { "Slot 1", "Slot 2", "Slot 3" }, 0));
-
-    return { params.begin(), params.end() };
+    return gls::createParameterLayout (parameterTable);
 }
 
 struct AmbienceVisualComponent : public juce::Component, private juce::Timer
 {
     AmbienceVisualComponent (AEVAmbienceEvolverSuiteAudioProcessor& proc, juce::Colour accentColour)
-        : processor (proc), accent (accentColour)
+        : processor (proc), accent (accentColour),
+          spectrum (proc.getSpectrumAnalyser(), accentColour)
     {
+        addAndMakeVisible (spectrum);
         startTimerHz (24);
     }
 
+    void resized() override
+    {
+        auto infoArea = getInfoArea();
+        spectrum.setBounds (getSpectrumArea (infoArea).toNearestInt());
+    }
+
     void paint (juce::Graphics& g) override
     {
         auto bounds = getLocalBounds().toFloat().reduced (6.0f);
@@ -204,13 +271,27 @@ struct AmbienceVisualComponent : public juce::Component, private juce::Timer
         auto rmsMeter = bounds.removeFromRight (64.0f).reduced (10.0f);
         drawRmsMeter (g, rmsMeter);
 
-        auto infoArea = bounds.reduced (12.0f);
+        auto infoArea = getInfoArea();
+        g.setColour (gls::ui::Colours::grid());
+        g.drawRoundedRectangle (getSpectrumArea (infoArea), 6.0f, 1.2f);
         drawCaptureStatus (g, infoArea);
     }
 
 private:
     AEVAmbienceEvolverSuiteAudioProcessor& processor;
     juce::Colour accent;
+    gls::ui::SpectrumView spectrum;
+
+    juce::Rectangle<float> getInfoArea() const
+    {
+        return getLocalBounds().toFloat().reduced (6.0f).withTrimmedRight (64.0f).reduced (12.0f);
+    }
+
+    /** Output spectrum above the capture status, so the denoiser's effect is visible. */
+    static juce::Rectangle<float> getSpectrumArea (juce::Rectangle<float>& infoArea)
+    {
+        return infoArea.removeFromTop (infoArea.getHeight() * 0.6f).withTrimmedBottom (8.0f);
+    }
 
     void drawRmsMeter (juce::Graphics& g, juce::Rectangle<float> area)
     {
@@ -300,6 +381,9 @@ AEVAmbienceEvolverSuiteAudioProcessorEditor::AEVAmbienceEvolverSuiteAudioProcess
     profileSlotBox.setLookAndFeel (&lookAndFeel);
     profileSlotBox.addItemList ({ "Slot 1", "Slot 2", "Slot 3" }, 1);
     addAndMakeVisible (profileSlotBox);
+    nrModeBox.setLookAndFeel (&lookAndFeel);
+    nrModeBox.addItemList ({ "Standard", "Low Latency" }, 1);
+    addAndMakeVisible (nrModeBox);
 
     auto& state = processorRef.getValueTreeState();
     auto attachSlider = [this, &state](const char* id, juce::Slider& slider)
@@ -319,6 +403,7 @@ AEVAmbienceEvolverSuiteAudioProcessorEditor::AEVAmbienceEvolverSuiteAudioProcess
 
     buttonAttachments.push_back (std::make_unique<ButtonAttachment> (state, "ui_bypass", bypassButton));
     profileSlotAttachment = std::make_unique<ComboAttachment> (state, "profile_slot", profileSlotBox);
+    nrModeAttachment = std::make_unique<ComboAttachment> (state, "nr_mode", nrModeBox);
 
     setSize (960, 520);
 }
@@ -328,6 +413,7 @@ AEVAmbienceEvolverSuiteAudioProcessorEditor::~AEVAmbienceEvolverSuiteAudioProces
     profileButton.removeListener (this);
     profileButton.setLookAndFeel (nullptr);
     profileSlotBox.setLookAndFeel (nullptr);
+    nrModeBox.setLookAndFeel (nullptr);
     bypassButton.setLookAndFeel (nullptr);
     setLookAndFeel (nullptr);
 }
@@ -415,6 +501,7 @@ void AEVAmbienceEvolverSuiteAudioProcessorEditor::resized()
     hfRecoverSlider.setBounds (right.removeFromTop (right.getHeight() / 2).reduced (8));
     profileSlotBox.setBounds (right.removeFromTop (28).reduced (4));
     profileButton.setBounds (right.removeFromTop (36).reduced (4));
+    nrModeBox.setBounds (right.removeFromTop (28).reduced (4));
 
     auto footerArea = footerBounds.reduced (32, 8);
     auto slotWidth = footerArea.getWidth() / 4;
@@ -446,48 +533,52 @@ void AEVAmbienceEvolverSuiteAudioProcessor::ensureStateSize (int numChannels)
         channelStates[i] = {};
 }
 
-void AEVAmbienceEvolverSuiteAudioProcessor::updateProfileState (float sampleEnv, int channel)
+void AEVAmbienceEvolverSuiteAudioProcessor::updateDenoiser()
 {
-    if (! profileCaptureArmed)
-        return;
-
-    if (channel < (int) profileAccumulators.size())
-        profileAccumulators[(size_t) channel] += sampleEnv;
+    const auto mode = juce::jlimit (0, 1, params.getIndex (Param::nrMode));
+    auto* selected = &denoisers[(size_t) mode];
 
-    const float remaining = (float) juce::jmax (0, profileSamplesRemaining);
-    const float progress = 1.0f - (remaining / (float) juce::jmax (1, profileTotalSamples));
-    profileProgress.store (juce::jlimit (0.0f, 1.0f, progress));
-
-    if (--profileSamplesRemaining <= 0)
+    if (selected != denoiser)
     {
-        profileCaptureArmed = false;
-        const int slot = juce::jlimit (0, 2, (int) std::round (apvts.getRawParameterValue ("profile_slot")->load()));
-        if ((int) capturedProfiles[slot].size() < (int) profileAccumulators.size())
-            capturedProfiles[slot].resize (profileAccumulators.size(), 0.0f);
-
-        for (size_t i = 0; i < profileAccumulators.size(); ++i)
-        {
-            const float averaged = profileAccumulators[i] / (float) juce::jmax (1, profileTotalSamples);
-            capturedProfiles[slot][i] = averaged;
-        }
-        refreshCapturedNoiseSnapshot();
-        profileProgress.store (1.0f);
+        denoiser->cancelCapture();
+        denoiser = selected;
+        denoiser->reset();
+        profileCaptureActive.store (false);
     }
+
+    latency.setStage (0, denoiser->getLatencySamples(), denoiser->getLatencySamples());
+    latency.update();
 }
 
-void AEVAmbienceEvolverSuiteAudioProcessor::refreshCapturedNoiseSnapshot()
+void AEVAmbienceEvolverSuiteAudioProcessor::updateProfiles (int selectedSlot)
 {
-    const int slot = juce::jlimit (0, 2, (int) std::round (apvts.getRawParameterValue ("profile_slot")->load()));
-    const auto& profile = capturedProfiles[slot];
-    float average = 1.0e-6f;
-    if (! profile.empty())
+    if (! profilePending && ! profileDirty.load() && selectedSlot == loadedProfileSlot)
+        return;
+
+    const juce::SpinLock::ScopedTryLockType lock (profileLock);
+    if (! lock.isLocked())
+        return;
+
+    if (profilePending)
     {
-        float sum = 0.0f;
-        for (auto value : profile)
-            sum += juce::jmax (value, 1.0e-6f);
-        average = sum / (float) profile.size();
+        auto& slot = capturedProfiles[(size_t) captureSlot];
+        std::copy (pendingProfile.begin(), pendingProfile.end(), slot.begin());
+        profilePending = false;
     }
-    capturedNoiseValue.store (average);
+
+    profileDirty.store (false);
+    loadedProfileSlot = selectedSlot;
+
+    const auto& profile = capturedProfiles[(size_t) selectedSlot];
+    for (auto& engine : denoisers)
+        engine.setNoiseProfile (profile.data());
+
+    // Mean PSD is the noise power, so its root reads as the capture's RMS level.
+    float sum = 0.0f;
+    for (auto value : profile)
+        sum += value;
+
+    capturedNoiseValue.store (juce::jmax (1.0e-6f, std::sqrt (sum / (float) profile.size())));
 }
 
 juce::AudioProcessor* JUCE_CALLTYPE createPluginFilter()
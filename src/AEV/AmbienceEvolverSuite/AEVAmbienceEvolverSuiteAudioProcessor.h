@@ -3,17 +3,31 @@
 #include <JuceHeader.h>
 #include <array>
 #include "../../DualPrecisionAudioProcessor.h"
+#include "../../ParameterTable.h"
+#include "../../SmoothedParameter.h"
+#include "../../dsp/DryWetStage.h"
+#include "../../dsp/LatencyReporter.h"
+#include "../../dsp/SoftBypass.h"
+#include "../../dsp/SpectralDenoiser.h"
+#include "../../dsp/SpectrumAnalyser.h"
 #include "../../ui/GoodluckLookAndFeel.h"
+#include "../../ui/SpectrumView.h"
 
 class AEVAmbienceEvolverSuiteAudioProcessor : public DualPrecisionAudioProcessor
 {
 public:
+    enum class Param
+    {
+        ambienceLevel, deverb, noiseSuppression, transientProtect, toneMatch, hfRecover,
+        outputTrim, mix, inputTrim, bypass, profileSlot, nrMode,
+        count
+    };
+
     AEVAmbienceEvolverSuiteAudioProcessor();
     ~AEVAmbienceEvolverSuiteAudioProcessor() override = default;
 
     void prepareToPlay (double sampleRate, int samplesPerBlock) override;
     void releaseResources() override;
-    void processBlock (juce::AudioBuffer<float>&, juce::MidiBuffer&) override;
 
     juce::AudioProcessorEditor* createEditor() override;
     bool hasEditor() const override { return true; }
@@ -22,7 +36,6 @@ public:
     bool acceptsMidi() const override { return false; }
     bool producesMidi() const override { return false; }
     bool isMidiEffect() const override { return false; }
-    double getTailLengthSeconds() const override { return 0.0; }
 
     int getNumPrograms() override { return 1; }
     int getCurrentProgram() override { return 0; }
@@ -39,15 +52,23 @@ public:
     static juce::AudioProcessorValueTreeState::ParameterLayout createParameterLayout();
 
     float getLastRmsDb() const noexcept        { return lastRmsDb.load(); }
+    gls::dsp::SpectrumAnalyser& getSpectrumAnalyser() noexcept { return spectrumAnalyser; }
     float getProfileProgress() const noexcept  { return profileProgress.load(); }
     float getCapturedNoiseLevel() const noexcept { return capturedNoiseValue.load(); }
-    bool  isProfileCaptureActive() const noexcept { return profileCaptureArmed; }
+    bool  isProfileCaptureActive() const noexcept { return profileCaptureRequested.load() || profileCaptureActive.load(); }
+
+protected:
+    void processFloat (juce::AudioBuffer<float>&, juce::MidiBuffer&) override;
 
 private:
     juce::AudioProcessorValueTreeState apvts;
+    gls::ParameterHandles<Param> params;
+    gls::SmoothedParameter inputTrimGain  { params, Param::inputTrim,   gls::SmoothedParameter::Mapping::decibels };
+    gls::SmoothedParameter mixAmount      { params, Param::mix };
+    gls::SmoothedParameter outputTrimGain { params, Param::outputTrim,  gls::SmoothedParameter::Mapping::decibels };
+    gls::dsp::SpectrumAnalyser spectrumAnalyser;
     struct ChannelState
     {
-        float noiseEstimate = 0.0f;
         float ambienceState = 0.0f;
         float transientState = 0.0f;
         float toneState = 0.0f;
@@ -56,20 +77,31 @@ private:
     std::vector<ChannelState> channelStates;
     double currentSampleRate = 44100.0;
     juce::uint32 lastBlockSize = 512;
-    juce::AudioBuffer<float> dryBuffer;
 
-    bool profileCaptureArmed = false;
-    int profileSamplesRemaining = 0;
-    std::vector<float> profileAccumulators;
-    int profileTotalSamples = 1;
+    // One denoiser per "nr_mode" choice, both built in prepareToPlay so switching never allocates.
+    std::array<gls::dsp::SpectralDenoiser, 2> denoisers;
+    gls::dsp::SpectralDenoiser* denoiser = &denoisers[0];
+    gls::dsp::DryWetStage dryWet;
+    gls::dsp::LatencyReporter latency { *this };
+    gls::dsp::SoftBypass bypass;
+
+    // Slots hold SpectralDenoiser::profileSize noise PSD values each; all zeros is an empty slot.
+    // The lock guards them against state save/load; the audio thread only ever try-locks it.
     std::array<std::vector<float>, 3> capturedProfiles {};
+    juce::SpinLock profileLock;
+    std::vector<float> pendingProfile;
+    bool profilePending = false;
+    int captureSlot = 0, loadedProfileSlot = -1;
+    std::atomic<bool> profileDirty { true };
+    std::atomic<bool> profileCaptureRequested { false };
+    std::atomic<bool> profileCaptureActive { false };
     std::atomic<float> capturedNoiseValue { 1.0e-6f };
     std::atomic<float> lastRmsDb { -120.0f };
     std::atomic<float> profileProgress { 0.0f };
 
     void ensureStateSize (int numChannels);
-    void updateProfileState (float sampleEnv, int channel);
-    void refreshCapturedNoiseSnapshot();
+    void updateDenoiser();
+    void updateProfiles (int selectedSlot);
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (AEVAmbienceEvolverSuiteAudioProcessor)
 };
@@ -107,6 +139,7 @@ private:
     juce::ToggleButton bypassButton { "Soft Bypass" };
     juce::TextButton profileButton { "Capture Profile" };
     juce::ComboBox profileSlotBox;
+    juce::ComboBox nrModeBox;
 
     using SliderAttachment = juce::AudioProcessorValueTreeState::SliderAttachment;
     using ButtonAttachment = juce::AudioProcessorValueTreeState::ButtonAttachment;
@@ -114,6 +147,7 @@ private:
     std::vector<std::unique_ptr<SliderAttachment>> sliderAttachments;
     std::vector<std::unique_ptr<ButtonAttachment>> buttonAttachments;
     std::unique_ptr<ComboAttachment> profileSlotAttachment;
+    std::unique_ptr<ComboAttachment> nrModeAttachment;
 
     struct LabeledSliderRef
     {
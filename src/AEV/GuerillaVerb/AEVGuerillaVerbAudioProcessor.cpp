@@ -1,29 +1,65 @@
 #include "AEVGuerillaVerbAudioProcessor.h"
 
+namespace
+{
+using Param = AEVGuerillaVerbAudioProcessor::Param;
+using Spec = gls::ParameterSpec;
+
+constexpr std::array<Spec, (size_t) Param::count> parameterTable {{
+    Spec::range ("size",      "Size",      0.1f,    1.0f,     0.001f, 0.5f,     0.8f),
+    Spec::range ("predelay",  "PreDelay",  0.0f,    200.0f,   0.01f,  20.0f,    0.35f),
+    Spec::range ("decay",     "Decay",     0.1f,    15.0f,    0.01f,  4.0f,     0.6f),
+    Spec::range ("er_level",  "ER Level",  0.0f,    1.0f,     0.001f, 0.4f,     0.35f),
+    Spec::range ("density",   "Density",   0.0f,    1.0f,     0.001f, 0.6f,     0.35f),
+    Spec::range ("damping",   "Damping",   0.0f,    1.0f,     0.001f, 0.5f,     0.35f),
+    Spec::range ("mod_depth", "Mod Depth", 0.0f,    1.0f,     0.001f, 0.2f,     0.35f),
+    Spec::range ("mod_rate",  "Mod Rate",  0.05f,   10.0f,    0.001f, 0.7f,     0.4f),
+    Spec::range ("color",     "Color",     -1.0f,   1.0f,     0.001f, 0.0f,     0.35f),
+    Spec::range ("hpf",       "HPF",       20.0f,   2000.0f,  0.01f,  120.0f,   0.35f),
+    Spec::range ("lpf",       "LPF",       2000.0f, 20000.0f, 0.01f,  16000.0f, 0.35f),
+    Spec::range ("width",     "Width",     0.0f,    1.5f,     0.001f, 1.0f,     0.35f),
+    Spec::range ("ab_morph",  "A/B Morph", 0.0f,    1.0f,     0.001f, 0.0f,     0.35f),
+    Spec::range ("ir_blend",  "IR Blend",  0.0f,    1.0f,     0.001f, 0.5f,     0.35f),
+    Spec::range ("mix",       "Mix",       0.0f,    1.0f,     0.001f, 0.4f,     0.35f)
+}};
+
+static_assert (gls::hasUniqueIds (parameterTable));
+} // namespace
+
 AEVGuerillaVerbAudioProcessor::AEVGuerillaVerbAudioProcessor()
     : DualPrecisionAudioProcessor(BusesProperties()
                         .withInput  ("Input", juce::AudioChannelSet::stereo(), true)
                         .withOutput ("Output", juce::AudioChannelSet::stereo(), true)),
-      apvts (*this, nullptr, "GUERILLA_VERB", createParameterLayout())
+      apvts (*this, nullptr, "GUERILLA_VERB", createParameterLayout()),
+      params (apvts, parameterTable)
 {
 }
 
 void AEVGuerillaVerbAudioProcessor::prepareToPlay (double sampleRate, int samplesPerBlock)
 {
+    DualPrecisionAudioProcessor::prepareToPlay (sampleRate, samplesPerBlock);
+
     currentSampleRate = sampleRate > 0.0 ? sampleRate : 44100.0;
     lastBlockSize = (juce::uint32) juce::jmax (1, samplesPerBlock);
 
-    reverb.reset();
-    modulationPhase = { 0.0f, 0.5f };
-    ensureStateSize (getTotalNumOutputChannels(), (int) lastBlockSize);
+    reverb.prepare (currentSampleRate);
+    convolver.prepare (currentSampleRate, 2);
+    earlyFallback.reset (currentSampleRate, gls::dsp::PartitionedConvolver::fadeSeconds);
+    earlyFallback.setCurrentAndTargetValue (1.0f);
+    ensureStateSize (juce::jmax (getTotalNumInputChannels(), getTotalNumOutputChannels()), (int) lastBlockSize);
     updateFilters (120.0f, 16000.0f);
+    mixAmount.prepare (currentSampleRate, (int) lastBlockSize);
+    updateTail();
+
+    // prepare() drops the loaded IR; partition it again at the new rate.
+    requestImpulseResponse();
 }
 
 void AEVGuerillaVerbAudioProcessor::releaseResources()
 {
 }
 
-void AEVGuerillaVerbAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer,
+void AEVGuerillaVerbAudioProcessor::processFloat (juce::AudioBuffer<float>& buffer,
                                                   juce::MidiBuffer&)
 {
     juce::ScopedNoDenormals noDenormals;
@@ -33,138 +69,131 @@ void AEVGuerillaVerbAudioProcessor::processBlock (juce::AudioBuffer<float>& buff
     for (int ch = totalIn; ch < totalOut; ++ch)
         buffer.clear (ch, 0, buffer.getNumSamples());
 
-    auto get = [this](const char* id) { return apvts.getRawParameterValue (id)->load(); };
-
-    const auto size        = get ("size");
-    const auto predelayMs  = get ("predelay");
-    const auto decay       = get ("decay");
-    const auto erLevel     = get ("er_level");
-    const auto density     = get ("density");
-    const auto damping     = get ("damping");
-    const auto modDepth    = get ("mod_depth");
-    const auto modRate     = get ("mod_rate");
-    const auto color       = get ("color");
-    const auto hpf         = get ("hpf");
-    const auto lpf         = get ("lpf");
-    const auto width       = get ("width");
-    const auto abMorph     = get ("ab_morph");
-    const auto irBlend     = get ("ir_blend");
-    const auto mix         = get ("mix");
-
-    const int numChannels = buffer.getNumChannels();
+    // Every work buffer is sized in prepareToPlay; hosts that exceed the announced
+    // block size are rendered in prepared-size chunks instead of growing them here.
+    const int numChannels = juce::jmin (buffer.getNumChannels(), preDelayBuffer.getNumChannels());
     const int numSamples  = buffer.getNumSamples();
+    const int capacity    = preDelayBuffer.getNumSamples();
+    if (numChannels == 0 || capacity == 0)
+        return;
 
-    lastBlockSize = (juce::uint32) juce::jmax (1, numSamples);
-    ensureStateSize (numChannels, numSamples);
-
-    dryBuffer.makeCopyOf (buffer, true);
-    workBuffer.makeCopyOf (buffer, true);
-    diffusionBuffer.clear();
-
-    const float delaySamples = juce::jlimit (0.0f, 2.0f, predelayMs * 0.001f) * (float) currentSampleRate;
-
-    // Pre-delay and modulation
-    for (int ch = 0; ch < numChannels; ++ch)
+    for (int start = 0; start < numSamples; start += capacity)
     {
-        auto* data = workBuffer.getWritePointer (ch);
-        auto& delay = preDelayLines[ch % preDelayLines.size()];
-        delay.setDelay (delaySamples);
-
-        float phase = modulationPhase[ch % modulationPhase.size()];
-        const float phaseInc = juce::MathConstants<float>::twoPi * juce::jlimit (0.05f, 10.0f, modRate) / (float) currentSampleRate;
-
-        for (int i = 0; i < numSamples; ++i)
-        {
-            const float delayed = delay.popSample (0);
-            delay.pushSample (0, data[i]);
-            const float modulation = 1.0f + std::sin (phase) * modDepth * 0.3f;
-            data[i] = delayed * modulation;
-            phase += phaseInc;
-            if (phase > juce::MathConstants<float>::twoPi)
-                phase -= juce::MathConstants<float>::twoPi;
-        }
-
-        modulationPhase[ch % modulationPhase.size()] = phase;
+        juce::AudioBuffer<float> chunk (buffer.getArrayOfWritePointers(), numChannels, start,
+                                        juce::jmin (capacity, numSamples - start));
+        renderChunk (chunk);
     }
+}
 
-    // Early reflections blend
-    for (int ch = 0; ch < numChannels; ++ch)
-    {
-        auto* wet = workBuffer.getWritePointer (ch);
-        const auto* dry = dryBuffer.getReadPointer (ch);
-        for (int i = 0; i < numSamples; ++i)
-        {
-            const float early = dry[i] * erLevel * 0.4f;
-            wet[i] = wet[i] * (1.0f - erLevel * 0.2f) + early;
-        }
-    }
+void AEVGuerillaVerbAudioProcessor::updateTail()
+{
+    // Pre-delay and the loaded IR ring out at full length; the tank decays at its RT60.
+    const auto preDelaySeconds = juce::jlimit (0.0, maxPreDelaySeconds, params[Param::predelay] * 0.001);
+    tail.setTail (preDelaySeconds + convolver.getImpulseResponseLength() / currentSampleRate,
+                  params[Param::decay]);
+}
 
-    updateReverbParameters (size, decay, density, damping, width, erLevel);
-    preDelaySnapshot.makeCopyOf (workBuffer, true);
-    juce::dsp::AudioBlock<float> workBlock (workBuffer);
-    reverb.process (juce::dsp::ProcessContextReplacing<float> (workBlock));
+void AEVGuerillaVerbAudioProcessor::renderChunk (juce::AudioBuffer<float>& buffer)
+{
+    const auto size        = params[Param::size];
+    const auto predelayMs  = params[Param::predelay];
+    const auto decay       = params[Param::decay];
+    const auto erLevel     = params[Param::erLevel];
+    const auto density     = params[Param::density];
+    const auto damping     = params[Param::damping];
+    const auto modDepth    = params[Param::modDepth];
+    const auto modRate     = params[Param::modRate];
+    const auto color       = params[Param::color];
+    const auto hpf         = params[Param::hpf];
+    const auto lpf         = params[Param::lpf];
+    const auto width       = params[Param::width];
+    const auto abMorph     = params[Param::abMorph];
+    const auto irBlend     = params[Param::irBlend];
+    mixAmount.update();
 
-    // Diffusion path acts as convolution approximation
-    for (int ch = 0; ch < numChannels; ++ch)
-    {
-        auto* diffWrite = diffusionBuffer.getWritePointer (ch);
-        const auto* source = dryBuffer.getReadPointer (ch);
-        for (int i = 0; i < numSamples; ++i)
-            diffWrite[i] = processDiffusion (ch, source[i], density, damping, irBlend);
-    }
+    const int numChannels = buffer.getNumChannels();
+    const int numSamples  = buffer.getNumSamples();
 
-    // Combine algorithmic + diffusion
-    juce::AudioBuffer<float> wetBuffer;
-    wetBuffer.makeCopyOf (workBuffer, true);
+    const float delaySamples = juce::jlimit (0.0f, (float) maxPreDelaySeconds, predelayMs * 0.001f) * (float) currentSampleRate;
     for (int ch = 0; ch < numChannels; ++ch)
     {
-        auto* wet = wetBuffer.getWritePointer (ch);
-        const auto* diff = diffusionBuffer.getReadPointer (ch);
-        for (int i = 0; i < numSamples; ++i)
-            wet[i] = juce::jmap (irBlend, wet[i], diff[i]);
+        auto& line = preDelayLines[(size_t) (ch % 2)];
+        line.write (buffer.getReadPointer (ch), numSamples);
+        line.read (preDelayBuffer.getWritePointer (ch), numSamples, delaySamples);
     }
 
+    gls::dsp::FDNReverb::Parameters tank;
+    tank.size = size;
+    tank.decaySeconds = decay;
+    tank.damping = damping;
+    tank.density = density;
+    tank.modDepth = modDepth;
+    tank.modRate = modRate;
+    reverb.setParameters (tank);
+
+    const bool stereo = numChannels > 1;
+    const auto* preLeft  = preDelayBuffer.getReadPointer (0);
+    const auto* preRight = preDelayBuffer.getReadPointer (stereo ? 1 : 0);
+    auto* tankLeft   = tankBuffer.getWritePointer (0);
+    auto* tankRight  = tankBuffer.getWritePointer (1);
+    auto* earlyLeft  = earlyBuffer.getWritePointer (0);
+    auto* earlyRight = earlyBuffer.getWritePointer (1);
+    reverb.process (preLeft, preRight, tankLeft, tankRight, earlyLeft, earlyRight, numSamples);
+
+    // The IR side of ir_blend is the loaded IR, convolved with zero added latency. Until
+    // one is loaded the diffuser's early cluster stands in, crossfading out as it arrives.
+    convolver.process (preDelayBuffer, convolutionBuffer, numSamples);
+    earlyFallback.setTargetValue (convolver.hasImpulseResponse() ? 0.0f : 1.0f);
+    const auto* irLeft  = convolutionBuffer.getReadPointer (0);
+    const auto* irRight = convolutionBuffer.getReadPointer (stereo ? 1 : 0);
+
+    // One pass for blend, filters, color, morph, width and mix.
     updateFilters (hpf, lpf);
-    juce::dsp::AudioBlock<float> wetBlock (wetBuffer);
-    for (int ch = 0; ch < numChannels; ++ch)
+
+    const float colorGain  = juce::jlimit (-1.0f, 1.0f, color) * 0.5f;
+    const float blend      = juce::jlimit (0.0f, 1.0f, irBlend);
+    const float morph      = juce::jlimit (0.0f, 1.0f, abMorph);
+    const float sideGain   = juce::jlimit (0.0f, 2.0f, width);
+    const float mixWet     = mixAmount.getCurrentValue();
+    const float* mixRamp   = mixAmount.advance (numSamples);   // nullptr while mix is settled
+
+    auto shape = [&] (int ch, float tankSample, float earlySample, float irSample, float fallback, float preSample)
     {
-        auto channelBlock = wetBlock.getSingleChannelBlock ((size_t) ch);
-        juce::dsp::ProcessContextReplacing<float> ctx (channelBlock);
-        hpfFilters[ch % 2].process (ctx);
-        lpfFilters[ch % 2].process (ctx);
-    }
+        const float algorithmic = tankSample + earlySample * erLevel;
+        const float convolved = irSample + earlySample * fallback;
+        float wet = algorithmic + (convolved - algorithmic) * blend;
+        wet = lpfFilters[ch].processSample (hpfFilters[ch].processSample (wet));
+
+        const float bright = wet - juce::dsp::FastMathApproximations::tanh (juce::jlimit (-5.0f, 5.0f, wet));
+        wet += bright * colorGain;
+        return wet + (preSample - wet) * morph;
+    };
 
-    // Color shaping: simple saturation-based tilt
-    const float colorAmount = juce::jlimit (-1.0f, 1.0f, color);
-    for (int ch = 0; ch < numChannels; ++ch)
+    auto* left = buffer.getWritePointer (0);
+    if (! stereo)
     {
-        auto* wet = wetBuffer.getWritePointer (ch);
         for (int i = 0; i < numSamples; ++i)
         {
-            const float bright = wet[i] - std::tanh (wet[i]);
-            wet[i] += bright * colorAmount * 0.5f;
+            const float fallback = earlyFallback.getNextValue();
+            const float wetAmount = mixRamp != nullptr ? mixRamp[i] : mixWet;
+            left[i] += (shape (0, tankLeft[i], earlyLeft[i], irLeft[i], fallback, preLeft[i]) - left[i]) * wetAmount;
         }
-    }
 
-    // Morph between wet signal and pre-delayed input
-    for (int ch = 0; ch < numChannels; ++ch)
-    {
-        auto* wet = wetBuffer.getWritePointer (ch);
-        const auto* pre = preDelaySnapshot.getReadPointer (ch);
-        for (int i = 0; i < numSamples; ++i)
-            wet[i] = juce::jmap (abMorph, wet[i], pre[i]);
+        return;
     }
 
-    applyWidth (wetBuffer, width);
-
-    const float mixWet = juce::jlimit (0.0f, 1.0f, mix);
-    for (int ch = 0; ch < numChannels; ++ch)
+    auto* right = buffer.getWritePointer (1);
+    for (int i = 0; i < numSamples; ++i)
     {
-        auto* dest = buffer.getWritePointer (ch);
-        const auto* dry = dryBuffer.getReadPointer (ch);
-        const auto* wet = wetBuffer.getReadPointer (ch);
-        for (int i = 0; i < numSamples; ++i)
-            dest[i] = wet[i] * mixWet + dry[i] * (1.0f - mixWet);
+        const float fallback = earlyFallback.getNextValue();
+        const float wetLeft  = shape (0, tankLeft[i], earlyLeft[i], irLeft[i], fallback, preLeft[i]);
+        const float wetRight = shape (1, tankRight[i], earlyRight[i], irRight[i], fallback, preRight[i]);
+        const float mid  = 0.5f * (wetLeft + wetRight);
+        const float side = 0.5f * (wetLeft - wetRight) * sideGain;
+
+        const float wetAmount = mixRamp != nullptr ? mixRamp[i] : mixWet;
+        left[i]  += (mid + side - left[i]) * wetAmount;
+        right[i] += (mid - side - right[i]) * wetAmount;
     }
 }
 
@@ -178,58 +207,83 @@ void AEVGuerillaVerbAudioProcessor::getStateInformation (juce::MemoryBlock& dest
 void AEVGuerillaVerbAudioProcessor::setStateInformation (const void* data, int sizeInBytes)
 {
     if (auto tree = juce::ValueTree::readFromData (data, sizeInBytes); tree.isValid())
+    {
         apvts.replaceState (tree);
+        requestImpulseResponse();
+    }
 }
 
-juce::AudioProcessorValueTreeState::ParameterLayout
-AEVGuerillaVerbAudioProcessor::createParameterLayout()
+void AEVGuerillaVerbAudioProcessor::loadImpulseResponse (const juce::File& file)
 {
-    std::vector<std::unique_ptr<juce::RangedAudioParameter>> params;
+    apvts.state.setProperty (irPathProperty, file.getFullPathName(), nullptr);
+    requestImpulseResponse();
+}
 
-    const auto norm = [](float start, float end, float step = 0.01f, float skew = 0.35f)
-    {
-        return juce::NormalisableRange<float> (start, end, step, skew);
-    };
+juce::File AEVGuerillaVerbAudioProcessor::getImpulseResponseFile() const
+{
+    const auto path = apvts.state.getProperty (irPathProperty).toString();
+    return juce::File::isAbsolutePath (path) ? juce::File (path) : juce::File();
+}
+
+void AEVGuerillaVerbAudioProcessor::requestImpulseResponse()
+{
+    irLoader.load (getImpulseResponseFile(), currentSampleRate, (int) (maxImpulseResponseSeconds * currentSampleRate));
+}
 
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("size",      "Size",      norm (0.1f, 1.0f, 0.001f, 0.8f), 0.5f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("predelay",  "PreDelay",  norm (0.0f, 200.0f, 0.01f), 20.0f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("decay",     "Decay",     norm (0.1f, 15.0f, 0.01f, 0.6f), 4.0f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("er_level",  "ER Level",  norm (0.0f, 1.0f, 0.001f), 0.4f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("density",   "Density",   norm (0.0f, 1.0f, 0.001f), 0.6f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("damping",   "Damping",   norm (0.0f, 1.0f, 0.001f), 0.5f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("mod_depth", "Mod Depth", norm (0.0f, 1.0f, 0.001f), 0.2f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("mod_rate",   "Mod Rate",  norm (0.05f, 10.0f, 0.001f, 0.4f), 0.7f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("color",     "Color",     norm (-1.0f, 1.0f, 0.001f), 0.0f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("hpf",       "HPF",       norm (20.0f, 2000.0f, 0.01f), 120.0f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("lpf",       "LPF",       norm (2000.0f, 20000.0f, 0.01f), 16000.0f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("width",     "Width",     norm (0.0f, 1.5f, 0.001f), 1.0f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("ab_morph",  "A/B Morph", norm (0.0f, 1.0f, 0.001f), 0.0f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("ir_blend",  "IR Blend",  norm (0.0f, 1.0f, 0.001f), 0.5f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("mix",       "Mix",       norm (0.0f, 1.0f, 0.001f), 0.4f));
-
-    return { params.begin(), params.end() };
+juce::AudioProcessorValueTreeState::ParameterLayout
+AEVGuerillaVerbAudioProcessor::createParameterLayout()
+{
+    return gls::createParameterLayout (parameterTable);
 }
 
 AEVGuerillaVerbAudioProcessorEditor::AEVGuerillaVerbAudioProcessorEditor (AEVGuerillaVerbAudioProcessor& p)
     : juce::AudioProcessorEditor (&p), processorRef (p)
 {
-    const juce::StringArray paramIds {
-        "size", "predelay", "decay", "er_level", "density", "damping",
-        "mod_depth", "mod_rate", "color", "hpf", "lpf", "width",
-        "ab_morph", "ir_blend", "mix"
-    };
-
     const juce::StringArray labels {
         "Size", "PreDelay", "Decay", "ER", "Density", "Damping",
         "Mod Depth", "Mod Rate", "Color", "HPF", "LPF", "Width",
         "A/B", "IR Blend", "Mix"
     };
 
-    const auto numParams = paramIds.size();
-    for (int i = 0; i < numParams; ++i)
-        addSlider (paramIds[i], labels[i]);
+    for (size_t i = 0; i < parameterTable.size(); ++i)
+        addSlider (parameterTable[i].id, labels[(int) i]);
 
-    setSize (900, 420);
+    loadIRButton.onClick = [this]
+    {
+        irChooser = std::make_unique<juce::FileChooser> ("Load Impulse Response",
+                                                         processorRef.getImpulseResponseFile(),
+                                                         "*.wav;*.aif;*.aiff;*.flac");
+        irChooser->launchAsync (juce::FileBrowserComponent::openMode | juce::FileBrowserComponent::canSelectFiles,
+                                [this] (const juce::FileChooser& chooser)
+                                {
+                                    if (const auto file = chooser.getResult(); file.existsAsFile())
+                                    {
+                                        processorRef.loadImpulseResponse (file);
+                                        refreshIRName();
+                                    }
+                                });
+    };
+
+    clearIRButton.onClick = [this]
+    {
+        processorRef.loadImpulseResponse ({});
+        refreshIRName();
+    };
+
+    irNameLabel.setColour (juce::Label::textColourId, juce::Colours::lightgrey);
+    addAndMakeVisible (loadIRButton);
+    addAndMakeVisible (clearIRButton);
+    addAndMakeVisible (irNameLabel);
+    refreshIRName();
+
+    setSize (900, 450);
+}
+
+void AEVGuerillaVerbAudioProcessorEditor::refreshIRName()
+{
+    const auto file = processorRef.getImpulseResponseFile();
+    irNameLabel.setText (file == juce::File() ? "IR: early cluster" : "IR: " + file.getFileName(),
+                         juce::dontSendNotification);
 }
 
 void AEVGuerillaVerbAudioProcessorEditor::addSlider (const juce::String& paramId, const juce::String& labelText)
@@ -261,6 +315,12 @@ void AEVGuerillaVerbAudioProcessorEditor::paint (juce::Graphics& g)
 void AEVGuerillaVerbAudioProcessorEditor::resized()
 {
     auto area = getLocalBounds().reduced (10);
+
+    auto irRow = area.removeFromBottom (28);
+    loadIRButton.setBounds (irRow.removeFromLeft (100).reduced (2));
+    clearIRButton.setBounds (irRow.removeFromLeft (90).reduced (2));
+    irNameLabel.setBounds (irRow.reduced (6, 0));
+
     auto rowHeight = area.getHeight() / 3;
 
     int sliderIndex = 0;
@@ -289,41 +349,26 @@ void AEVGuerillaVerbAudioProcessor::ensureStateSize (int numChannels, int numSam
 
     if (requiredChannels <= 0)
     {
-        diffusers.clear();
-        dryBuffer.setSize (0, 0);
-        workBuffer.setSize (0, 0);
-        diffusionBuffer.setSize (0, 0);
-        preDelaySnapshot.setSize (0, 0);
+        preDelayBuffer.setSize (0, 0);
+        tankBuffer.setSize (0, 0);
+        earlyBuffer.setSize (0, 0);
+        convolutionBuffer.setSize (0, 0);
         return;
     }
 
-    diffusers.resize ((size_t) requiredChannels);
-
-    juce::dsp::ProcessSpec spec {
-        currentSampleRate > 0.0 ? currentSampleRate : 44100.0,
-        (juce::uint32) samples,
-        1
-    };
-
-    for (auto& channelDiffusers : diffusers)
-        for (auto& diff : channelDiffusers)
-        {
-            diff.line.prepare (spec);
-            diff.line.reset();
-            diff.feedback = 0.5f;
-        }
-
     for (auto& line : preDelayLines)
-    {
-        line.prepare (spec);
-        line.reset();
-    }
+        line.prepare (currentSampleRate, maxPreDelaySeconds, samples);
+
+    for (auto& filter : hpfFilters)
+        filter.reset();
+    for (auto& filter : lpfFilters)
+        filter.reset();
 
-    dryBuffer.setSize (requiredChannels, samples, false, false, true);
-    workBuffer.setSize (requiredChannels, samples, false, false, true);
-    diffusionBuffer.setSize (requiredChannels, samples, false, false, true);
-    preDelaySnapshot.setSize (requiredChannels, samples, false, false, true);
-    diffusionBuffer.clear();
+    // The tank always renders a stereo pair, even for a mono bus.
+    preDelayBuffer.setSize (requiredChannels, samples, false, false, true);
+    tankBuffer.setSize (2, samples, false, false, true);
+    earlyBuffer.setSize (2, samples, false, false, true);
+    convolutionBuffer.setSize (requiredChannels, samples, false, false, true);
 }
 
 void AEVGuerillaVerbAudioProcessor::updateFilters (float hpf, float lpf)
@@ -331,72 +376,12 @@ void AEVGuerillaVerbAudioProcessor::updateFilters (float hpf, float lpf)
     if (currentSampleRate <= 0.0)
         return;
 
-    auto hpCoeffs = juce::dsp::IIR::Coefficients<float>::makeHighPass (currentSampleRate,
-                                                                       juce::jlimit (20.0f, 5000.0f, hpf),
-                                                                       0.707f);
-    auto lpCoeffs = juce::dsp::IIR::Coefficients<float>::makeLowPass (currentSampleRate,
-                                                                      juce::jlimit (2000.0f, (float) (currentSampleRate * 0.49f), lpf),
-                                                                      0.707f);
+    const auto hpfFreq = juce::jlimit (20.0f, 5000.0f, hpf);
+    const auto lpfFreq = juce::jlimit (2000.0f, (float) (currentSampleRate * 0.49f), lpf);
     for (auto& filter : hpfFilters)
-        filter.coefficients = hpCoeffs;
+        filter.setHighPass (currentSampleRate, hpfFreq, 0.707f);
     for (auto& filter : lpfFilters)
-        filter.coefficients = lpCoeffs;
-}
-
-void AEVGuerillaVerbAudioProcessor::updateReverbParameters (float size, float decay, float density, float damping, float width, float erLevel)
-{
-    juce::dsp::Reverb::Parameters params;
-    const float decayFactor = juce::jlimit (0.1f, 1.0f, decay / 10.0f);
-    params.roomSize = juce::jlimit (0.1f, 1.0f, size * decayFactor);
-    params.damping = juce::jlimit (0.0f, 1.0f, damping);
-    params.wetLevel = juce::jlimit (0.0f, 1.0f, 0.3f + density * 0.5f);
-    params.dryLevel = juce::jlimit (0.0f, 1.0f, 1.0f - params.wetLevel);
-    params.width = juce::jlimit (0.0f, 1.0f, width * 0.8f);
-    params.freezeMode = 0.0f;
-    reverb.setParameters (params);
-    juce::ignoreUnused (erLevel);
-}
-
-float AEVGuerillaVerbAudioProcessor::processDiffusion (int channel, float input, float density, float damping, float irBlend)
-{
-    if (channel >= (int) diffusers.size())
-        return 0.0f;
-
-    auto& chain = diffusers[channel];
-    float sum = 0.0f;
-    const float baseFeedback = 0.25f + density * 0.5f;
-    for (size_t i = 0; i < chain.size(); ++i)
-    {
-        auto& diff = chain[i];
-        const float delay = juce::jlimit (10.0f, (float) maxDelaySamples - 1.0f,
-                                          600.0f + (float) i * 700.0f + density * 3500.0f);
-        diff.line.setDelay (delay);
-        diff.feedback = juce::jlimit (0.1f, 0.95f, baseFeedback - 0.05f * (float) i);
-        auto delayed = diff.line.popSample (0);
-        const float damped = delayed * (1.0f - damping * 0.5f);
-        diff.line.pushSample (0, input + damped * diff.feedback);
-        sum += delayed;
-    }
-    juce::ignoreUnused (irBlend);
-    return sum * 0.3f;
-}
-
-void AEVGuerillaVerbAudioProcessor::applyWidth (juce::AudioBuffer<float>& buffer, float widthAmount)
-{
-    if (buffer.getNumChannels() < 2)
-        return;
-
-    const float width = juce::jlimit (0.0f, 2.0f, widthAmount);
-    auto* left  = buffer.getWritePointer (0);
-    auto* right = buffer.getWritePointer (1);
-    const int numSamples = buffer.getNumSamples();
-    for (int i = 0; i < numSamples; ++i)
-    {
-        const float mid  = 0.5f * (left[i] + right[i]);
-        const float side = 0.5f * (left[i] - right[i]) * width;
-        left[i]  = mid + side;
-        right[i] = mid - side;
-    }
+        filter.setLowPass (currentSampleRate, lpfFreq, 0.707f);
 }
 
 juce::AudioProcessor* JUCE_CALLTYPE createPluginFilter()
@@ -2,17 +2,29 @@
 
 #include <JuceHeader.h>
 #include "../../DualPrecisionAudioProcessor.h"
+#include "../../ParameterTable.h"
+#include "../../SmoothedParameter.h"
+#include "../../dsp/Biquad.h"
+#include "../../dsp/DelayLine.h"
+#include "../../dsp/FDNReverb.h"
+#include "../../dsp/PartitionedConvolver.h"
 #include <array>
 
 class AEVGuerillaVerbAudioProcessor : public DualPrecisionAudioProcessor
 {
 public:
+    enum class Param
+    {
+        size, predelay, decay, erLevel, density, damping, modDepth, modRate,
+        color, hpf, lpf, width, abMorph, irBlend, mix,
+        count
+    };
+
     AEVGuerillaVerbAudioProcessor();
     ~AEVGuerillaVerbAudioProcessor() override = default;
 
     void prepareToPlay (double sampleRate, int samplesPerBlock) override;
     void releaseResources() override;
-    void processBlock (juce::AudioBuffer<float>&, juce::MidiBuffer&) override;
 
     juce::AudioProcessorEditor* createEditor() override;
     bool hasEditor() const override { return true; }
@@ -21,7 +33,6 @@ public:
     bool acceptsMidi() const override { return false; }
     bool producesMidi() const override { return false; }
     bool isMidiEffect() const override { return false; }
-    double getTailLengthSeconds() const override { return 0.0; }
 
     int getNumPrograms() override { return 1; }
     int getCurrentProgram() override { return 0; }
@@ -35,38 +46,43 @@ public:
     juce::AudioProcessorValueTreeState& getValueTreeState() { return apvts; }
     static juce::AudioProcessorValueTreeState::ParameterLayout createParameterLayout();
 
-private:
-    juce::AudioProcessorValueTreeState apvts;
-    static constexpr int maxDelaySamples = 192000;
+    /** Message thread: loads an IR file in the background for the IR side of ir_blend.
+        The path is kept in the state; an empty File returns to the early cluster. */
+    void loadImpulseResponse (const juce::File& file);
+    juce::File getImpulseResponseFile() const;
 
-    struct Diffuser
-    {
-        juce::dsp::DelayLine<float, juce::dsp::DelayLineInterpolationTypes::Linear> line { maxDelaySamples };
-        float feedback = 0.0f;
-    };
-
-    std::vector<std::array<Diffuser, 4>> diffusers;
-    std::array<juce::dsp::DelayLine<float, juce::dsp::DelayLineInterpolationTypes::Linear>, 2> preDelayLines
-        { juce::dsp::DelayLine<float, juce::dsp::DelayLineInterpolationTypes::Linear> (maxDelaySamples),
-          juce::dsp::DelayLine<float, juce::dsp::DelayLineInterpolationTypes::Linear> (maxDelaySamples) };
-    juce::dsp::Reverb reverb;
-    juce::dsp::IIR::Filter<float> hpfFilters[2];
-    juce::dsp::IIR::Filter<float> lpfFilters[2];
+protected:
+    void processFloat (juce::AudioBuffer<float>&, juce::MidiBuffer&) override;
+    void updateTail() override;
 
-    juce::AudioBuffer<float> dryBuffer;
-    juce::AudioBuffer<float> workBuffer;
-    juce::AudioBuffer<float> diffusionBuffer;
-    juce::AudioBuffer<float> preDelaySnapshot;
+private:
+    juce::AudioProcessorValueTreeState apvts;
+    gls::ParameterHandles<Param> params;
+    gls::SmoothedParameter mixAmount { params, Param::mix };
+    static constexpr double maxPreDelaySeconds = 0.2;
+    static constexpr double maxImpulseResponseSeconds = 10.0;
+    static constexpr const char* irPathProperty = "ir_path";
+
+    std::array<gls::dsp::DelayLine<float>, 2> preDelayLines;
+    gls::dsp::FDNReverb reverb;
+    gls::dsp::PartitionedConvolver convolver;
+    gls::dsp::ImpulseResponseLoader irLoader { convolver };
+    juce::SmoothedValue<float> earlyFallback { 1.0f };
+    gls::dsp::Biquad hpfFilters[2];
+    gls::dsp::Biquad lpfFilters[2];
+
+    juce::AudioBuffer<float> preDelayBuffer;
+    juce::AudioBuffer<float> tankBuffer;
+    juce::AudioBuffer<float> earlyBuffer;
+    juce::AudioBuffer<float> convolutionBuffer;
 
     double currentSampleRate = 44100.0;
     juce::uint32 lastBlockSize = 512;
-    std::array<float, 2> modulationPhase { 0.0f, 0.5f };
 
     void ensureStateSize (int numChannels, int numSamples);
+    void renderChunk (juce::AudioBuffer<float>& buffer);
     void updateFilters (float hpf, float lpf);
-    void updateReverbParameters (float size, float decay, float density, float damping, float width, float erLevel);
-    float processDiffusion (int channel, float input, float density, float damping, float irBlend);
-    void applyWidth (juce::AudioBuffer<float>& buffer, float widthAmount);
+    void requestImpulseResponse();
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (AEVGuerillaVerbAudioProcessor)
 };
@@ -87,7 +103,13 @@ private:
     juce::OwnedArray<juce::Label> labels;
     juce::OwnedArray<juce::AudioProcessorValueTreeState::SliderAttachment> attachments;
 
+    juce::TextButton loadIRButton { "Load IR..." };
+    juce::TextButton clearIRButton { "Clear IR" };
+    juce::Label irNameLabel;
+    std::unique_ptr<juce::FileChooser> irChooser;
+
     void addSlider (const juce::String& paramId, const juce::String& labelText);
+    void refreshIRName();
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (AEVGuerillaVerbAudioProcessorEditor)
 };
@@ -0,0 +1,43 @@
+#include "AllocationTrap.h"
+
+#if GLS_ALLOCATION_TRAP
+
+#include <cstdlib>
+#include <new>
+
+// Replaceable global allocation functions, linked into debug plugin builds only. The
+// benchmark harness brings its own counting operator new, which calls
+// checkAllocation() itself; as nothing else in this file is referenced, the linker
+// then never pulls this object out of the plugin library. Over-aligned forms are left
+// to the runtime.
+namespace
+{
+void* trappedAllocate (std::size_t size)
+{
+    gls::AllocationTrap::checkAllocation();
+
+    if (auto* ptr = std::malloc (size == 0 ? 1 : size))
+        return ptr;
+
+    throw std::bad_alloc();
+}
+
+void* trappedAllocate (std::size_t size, const std::nothrow_t&) noexcept
+{
+    gls::AllocationTrap::checkAllocation();
+    return std::malloc (size == 0 ? 1 : size);
+}
+} // namespace
+
+void* operator new (std::size_t size)                                       { return trappedAllocate (size); }
+void* operator new[] (std::size_t size)                                     { return trappedAllocate (size); }
+void* operator new (std::size_t size, const std::nothrow_t& tag) noexcept   { return trappedAllocate (size, tag); }
+void* operator new[] (std::size_t size, const std::nothrow_t& tag) noexcept { return trappedAllocate (size, tag); }
+void  operator delete (void* ptr) noexcept                                  { std::free (ptr); }
+void  operator delete[] (void* ptr) noexcept                                { std::free (ptr); }
+void  operator delete (void* ptr, std::size_t) noexcept                     { std::free (ptr); }
+void  operator delete[] (void* ptr, std::size_t) noexcept                   { std::free (ptr); }
+void  operator delete (void* ptr, const std::nothrow_t&) noexcept           { std::free (ptr); }
+void  operator delete[] (void* ptr, const std::nothrow_t&) noexcept         { std::free (ptr); }
+
+#endif
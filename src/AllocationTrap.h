@@ -0,0 +1,70 @@
+#pragma once
+
+#include <JuceHeader.h>
+
+#ifndef GLS_ALLOCATION_TRAP
+ #define GLS_ALLOCATION_TRAP 0
+#endif
+
+namespace gls
+{
+/** Debug-build tripwire for heap allocation on the audio thread.
+
+    While a ScopedAllocationTrap is alive on the calling thread, operator new hits a
+    jassert, so a debugger stops on the offending call. It is armed centrally rather
+    than per plugin: DualPrecisionAudioProcessor's final processBlock overloads wrap
+    every host block before handing it to the plugin's processFloat/processDouble, and
+    the benchmark harness wraps every block it renders as well. Debug
+    builds of every plugin compile the operator new replacement in AllocationTrap.cpp
+    (see GLS_Project/CMakeLists.txt); the harness routes its own counting operator new
+    through checkAllocation(). Release builds leave both untouched. */
+class AllocationTrap
+{
+public:
+    static bool isArmed() noexcept                      { return depth() > 0; }
+
+    /** Called by the operator new replacement. Disarms around the assertion because
+        logging it allocates too. */
+    static void checkAllocation() noexcept
+    {
+        if (! isArmed())
+            return;
+
+        const auto armedDepth = depth();
+        depth() = 0;
+        jassertfalse;   // heap allocation inside processBlock
+        depth() = armedDepth;
+    }
+
+    /** Temporarily allows allocation inside an armed scope, for code that knowingly does so. */
+    struct ScopedDisarm
+    {
+        ScopedDisarm() noexcept : savedDepth (depth())  { depth() = 0; }
+        ~ScopedDisarm() noexcept                        { depth() = savedDepth; }
+
+        const int savedDepth;
+    };
+
+private:
+    friend class ScopedAllocationTrap;
+
+    static int& depth() noexcept
+    {
+        static thread_local int value = 0;
+        return value;
+    }
+};
+
+class ScopedAllocationTrap
+{
+public:
+   #if GLS_ALLOCATION_TRAP
+    ScopedAllocationTrap() noexcept                     { ++AllocationTrap::depth(); }
+    ~ScopedAllocationTrap() noexcept                    { --AllocationTrap::depth(); }
+   #else
+    ScopedAllocationTrap() noexcept                     {}
+   #endif
+
+    JUCE_DECLARE_NON_COPYABLE (ScopedAllocationTrap)
+};
+} // namespace gls
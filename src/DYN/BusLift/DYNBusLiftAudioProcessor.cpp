@@ -3,6 +3,24 @@
 namespace
 {
 constexpr auto kStateId = "BUS_LIFT";
+
+using Param = DYNBusLiftAudioProcessor::Param;
+using Spec = gls::ParameterSpec;
+
+constexpr std::array<Spec, (size_t) Param::count> parameterTable {{
+    Spec::range  ("input_trim",  "Input Trim",  -18.0f, 18.0f,  0.1f,   0.0f),
+    Spec::range  ("low_thresh",  "Low Thresh",  -48.0f, 0.0f,   0.1f,   -24.0f),
+    Spec::range  ("mid_thresh",  "Mid Thresh",  -48.0f, 0.0f,   0.1f,   -18.0f),
+    Spec::range  ("high_thresh", "High Thresh", -48.0f, 0.0f,   0.1f,   -12.0f),
+    Spec::range  ("ratio",       "Ratio",       1.0f,   10.0f,  0.01f,  3.0f,   0.5f),
+    Spec::range  ("attack",      "Attack",      1.0f,   100.0f, 0.01f,  10.0f,  0.35f),
+    Spec::range  ("release",     "Release",     10.0f,  600.0f, 0.01f,  150.0f, 0.35f),
+    Spec::range  ("mix",         "Mix",         0.0f,   1.0f,   0.001f, 1.0f),
+    Spec::range  ("output_trim", "Output Trim", -18.0f, 18.0f,  0.1f,   0.0f),
+    Spec::toggle ("ui_bypass",   "Soft Bypass", false)
+}};
+
+static_assert (gls::hasUniqueIds (parameterTable));
 }
 
 const std::array<DYNBusLiftAudioProcessor::Preset, 3> DYNBusLiftAudioProcessor::presetBank {{
@@ -48,12 +66,16 @@ DYNBusLiftAudioProcessor::DYNBusLiftAudioProcessor()
     : DualPrecisionAudioProcessor(BusesProperties()
                         .withInput  ("Input", juce::AudioChannelSet::stereo(), true)
                         .withOutput ("Output", juce::AudioChannelSet::stereo(), true)),
-      apvts (*this, nullptr, kStateId, createParameterLayout())
+      apvts (*this, nullptr, kStateId, createParameterLayout()),
+      params (apvts, parameterTable)
 {
+    bypass.snapOnResume (dryWet);
 }
 
-void DYNBusLiftAudioProcessor::prepareToPlay (double sampleRate, int /*samplesPerBlock*/)
+void DYNBusLiftAudioProcessor::prepareToPlay (double sampleRate, int samplesPerBlock)
 {
+    DualPrecisionAudioProcessor::prepareToPlay (sampleRate, samplesPerBlock);
+
     currentSampleRate = juce::jmax (sampleRate, 44100.0);
     auto resetFilter = [sampleRate](auto& filter, juce::dsp::LinkwitzRileyFilterType type, float freq)
     {
@@ -70,15 +92,24 @@ void DYNBusLiftAudioProcessor::prepareToPlay (double sampleRate, int /*samplesPe
     resetFilter (midHighpass, juce::dsp::LinkwitzRileyFilterType::highpass, 200.0f);
     resetFilter (highLowpass, juce::dsp::LinkwitzRileyFilterType::lowpass, 20000.0f);
     resetFilter (highHighpass, juce::dsp::LinkwitzRileyFilterType::highpass, 2000.0f);
+
+    for (auto* smoother : { &inputTrimGain, &mixAmount, &outputTrimGain })
+        smoother->prepare (sampleRate, samplesPerBlock);
+
+    dryWet.prepare (sampleRate, juce::jmax (getTotalNumInputChannels(), getTotalNumOutputChannels()), samplesPerBlock);
+    bypass.prepare (sampleRate, juce::jmax (getTotalNumInputChannels(), getTotalNumOutputChannels()), samplesPerBlock);
 }
 
 void DYNBusLiftAudioProcessor::releaseResources()
 {
 }
 
-void DYNBusLiftAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer,
-                                             juce::MidiBuffer&)
+void DYNBusLiftAudioProcessor::processFloat (juce::AudioBuffer<float>& buffer,
+                                             juce::MidiBuffer& midi)
 {
+    if (renderInPreparedChunks (buffer, midi))
+        return;
+
     juce::ScopedNoDenormals noDenormals;
 
     auto totalIn  = getTotalNumInputChannels();
@@ -86,26 +117,20 @@ void DYNBusLiftAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer,
     for (int ch = totalIn; ch < totalOut; ++ch)
         buffer.clear (ch, 0, buffer.getNumSamples());
 
-    auto read = [this](const char* id) { return apvts.getRawParameterValue (id)->load(); };
-
-    const bool bypassed   = apvts.getRawParameterValue ("ui_bypass")->load() > 0.5f;
-    const auto inputTrim  = juce::Decibels::decibelsToGain (read ("input_trim"));
-    const auto lowThresh  = read ("low_thresh");
-    const auto midThresh  = read ("mid_thresh");
-    const auto highThresh = read ("high_thresh");
-    const auto ratio      = juce::jmax (1.0f, read ("ratio"));
-    const auto attack     = read ("attack");
-    const auto release    = read ("release");
-    const auto mix        = juce::jlimit (0.0f, 1.0f, read ("mix"));
-    const auto outputTrim = juce::Decibels::decibelsToGain (read ("output_trim"));
+    const bool bypassed   = params.isOn (Param::bypass);
+    const auto lowThresh  = params[Param::lowThresh];
+    const auto midThresh  = params[Param::midThresh];
+    const auto highThresh = params[Param::highThresh];
+    const auto ratio      = juce::jmax (1.0f, params[Param::ratio]);
+    const auto attack     = params[Param::attack];
+    const auto release    = params[Param::release];
 
-    if (bypassed)
+    if (! bypass.begin (buffer, buffer.getNumSamples(), bypassed))
         return;
 
-    buffer.applyGain (inputTrim);
-    dryBuffer.makeCopyOf (buffer, true);
     const int numChannels = buffer.getNumChannels();
     const int numSamples = buffer.getNumSamples();
+    dryWet.begin (buffer, numSamples, inputTrimGain, mixAmount);
 
     lowBuffer.setSize (numChannels, numSamples, false, false, true);
     midBuffer.setSize (numChannels, numSamples, false, false, true);
@@ -131,20 +156,17 @@ void DYNBusLiftAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer,
     for (int ch = 0; ch < numChannels; ++ch)
     {
         auto* out = buffer.getWritePointer (ch);
-        const auto* dry = dryBuffer.getReadPointer (ch);
         const auto* low = lowBuffer.getReadPointer (ch);
         const auto* mid = midBuffer.getReadPointer (ch);
         const auto* high = highBuffer.getReadPointer (ch);
 
         for (int i = 0; i < numSamples; ++i)
-        {
-            const float processed = low[i] + mid[i] + high[i];
-            out[i] = processed * mix + dry[i] * (1.0f - mix);
-        }
+            out[i] = low[i] + mid[i] + high[i];
     }
 
-    if (outputTrim != 1.0f)
-        buffer.applyGain (outputTrim);
+    dryWet.end (buffer, numSamples, mixAmount, outputTrimGain);
+
+    bypass.end (buffer, numSamples);
 }
 
 void DYNBusLiftAudioProcessor::getStateInformation (juce::MemoryBlock& destData)
@@ -165,28 +187,7 @@ void DYNBusLiftAudioProcessor::setStateInformation (const void* data, int sizeIn
 juce::AudioProcessorValueTreeState::ParameterLayout
 DYNBusLiftAudioProcessor::createParameterLayout()
 {
-    std::vector<std::unique_ptr<juce::RangedAudioParameter>> params;
-
-    auto threshRange = juce::NormalisableRange<float> (-48.0f, 0.0f, 0.1f);
-    auto timeRange   = juce::NormalisableRange<float> (1.0f, 100.0f, 0.01f, 0.35f);
-    auto releaseRange= juce::NormalisableRange<float> (10.0f, 600.0f, 0.01f, 0.35f);
-
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("input_trim", "Input Trim",
-                                                                   juce::NormalisableRange<float> (-18.0f, 18.0f, 0.1f), 0.0f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("low_thresh",  "Low Thresh",  threshRange, -24.0f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("mid_thresh",  "Mid Thresh",  threshRange, -18.0f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("high_thresh", "High Thresh", threshRange, -12.0f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("ratio",       "Ratio",
-                                                                   juce::NormalisableRange<float> (1.0f, 10.0f, 0.01f, 0.5f), 3.0f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("attack",      "Attack", timeRange, 10.0f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("release",     "Release", releaseRange, 150.0f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("mix",         "Mix",
-                                                                   juce::NormalisableRange<float> (0.0f, 1.0f, 0.001f), 1.0f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("output_trim", "Output Trim",
-                                                                   juce::NormalisableRange<float> (-18.0f, 18.0f, 0.1f), 0.0f));
-    params.push_back (std::make_unique<juce::AudioParameterBool> ("ui_bypass", "Soft Bypass", false));
-
-    return { params.begin(), params.end() };
+    return gls::createParameterLayout (parameterTable);
 }
 
 DYNBusLiftAudioProcessorEditor::DYNBusLiftAudioProcessorEditor (DYNBusLiftAudioProcessor& p)
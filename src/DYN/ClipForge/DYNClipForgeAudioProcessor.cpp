@@ -3,6 +3,23 @@
 namespace
 {
 constexpr auto kStateId = "CLIP_FORGE";
+
+using Param = DYNClipForgeAudioProcessor::Param;
+using Spec = gls::ParameterSpec;
+
+constexpr std::array<Spec, (size_t) Param::count> parameterTable {{
+    Spec::range  ("input_trim",  "Input Trim",  -18.0f, 18.0f,  0.1f,   0.0f),
+    Spec::range  ("ceiling",     "Ceiling",     -6.0f,  6.0f,   0.1f,   0.0f),
+    Spec::range  ("clip_blend",  "Clip Blend",  0.0f,   1.0f,   0.001f, 0.5f),
+    Spec::range  ("knee",        "Knee",        0.0f,   18.0f,  0.1f,   6.0f),
+    Spec::range  ("pre_hpf",     "Pre HPF",     20.0f,  400.0f, 0.01f,  60.0f, 0.35f),
+    Spec::range  ("post_tone",   "Post Tone",   -1.0f,  1.0f,   0.001f, 0.0f),
+    Spec::range  ("output_trim", "Output Trim", -12.0f, 12.0f,  0.1f,   0.0f),
+    Spec::range  ("mix",         "Mix",         0.0f,   1.0f,   0.001f, 1.0f),
+    Spec::toggle ("ui_bypass",   "Soft Bypass", false)
+}};
+
+static_assert (gls::hasUniqueIds (parameterTable));
 }
 
 const std::array<DYNClipForgeAudioProcessor::Preset, 3> DYNClipForgeAudioProcessor::presetBank {{
@@ -45,12 +62,17 @@ DYNClipForgeAudioProcessor::DYNClipForgeAudioProcessor()
     : DualPrecisionAudioProcessor(BusesProperties()
                         .withInput  ("Input", juce::AudioChannelSet::stereo(), true)
                         .withOutput ("Output", juce::AudioChannelSet::stereo(), true)),
-      apvts (*this, nullptr, kStateId, createParameterLayout())
+      apvts (*this, nullptr, kStateId, createParameterLayout()),
+      params (apvts, parameterTable)
 {
+    bypass.snapOnResume (dryWet);
+    bypass.snapOnResume ({ &inputTrimGain, &outputTrimGain });
 }
 
 void DYNClipForgeAudioProcessor::prepareToPlay (double sampleRate, int samplesPerBlock)
 {
+    DualPrecisionAudioProcessor::prepareToPlay (sampleRate, samplesPerBlock);
+
     currentSampleRate = juce::jmax (sampleRate, 44100.0);
     juce::dsp::ProcessSpec spec { currentSampleRate,
                                   static_cast<juce::uint32> (juce::jmax (1, samplesPerBlock)),
@@ -59,17 +81,25 @@ void DYNClipForgeAudioProcessor::prepareToPlay (double sampleRate, int samplesPe
     preHpfFilter.reset();
     postToneFilter.prepare (spec);
     postToneFilter.reset();
-    updateFilters (apvts.getRawParameterValue ("pre_hpf")->load(),
-                   apvts.getRawParameterValue ("post_tone")->load());
+    updateFilters (params[Param::preHpf], params[Param::postTone]);
+
+    for (auto* smoother : { &inputTrimGain, &mixAmount, &outputTrimGain })
+        smoother->prepare (sampleRate, samplesPerBlock);
+
+    dryWet.prepare (sampleRate, juce::jmax (getTotalNumInputChannels(), getTotalNumOutputChannels()), samplesPerBlock);
+    bypass.prepare (sampleRate, juce::jmax (getTotalNumInputChannels(), getTotalNumOutputChannels()), samplesPerBlock);
 }
 
 void DYNClipForgeAudioProcessor::releaseResources()
 {
 }
 
-void DYNClipForgeAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer,
-                                               juce::MidiBuffer&)
+void DYNClipForgeAudioProcessor::processFloat (juce::AudioBuffer<float>& buffer,
+                                               juce::MidiBuffer& midi)
 {
+    if (renderInPreparedChunks (buffer, midi))
+        return;
+
     juce::ScopedNoDenormals noDenormals;
 
     auto totalIn  = getTotalNumInputChannels();
@@ -77,19 +107,14 @@ void DYNClipForgeAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer,
     for (int ch = totalIn; ch < totalOut; ++ch)
         buffer.clear (ch, 0, buffer.getNumSamples());
 
-    auto get = [this](const char* id) { return apvts.getRawParameterValue (id)->load(); };
-
-    const bool bypassed = apvts.getRawParameterValue ("ui_bypass")->load() > 0.5f;
-    const auto input    = juce::Decibels::decibelsToGain (get ("input_trim"));
-    const auto ceilingDb = get ("ceiling");
-    const auto clipBlend = juce::jlimit (0.0f, 1.0f, get ("clip_blend"));
-    const auto knee      = get ("knee");
-    const auto preHpf    = get ("pre_hpf");
-    const auto postTone  = get ("post_tone");
-    const auto output    = juce::Decibels::decibelsToGain (get ("output_trim"));
-    const auto mix       = juce::jlimit (0.0f, 1.0f, get ("mix"));
+    const bool bypassed = params.isOn (Param::bypass);
+    const auto ceilingDb = params[Param::ceiling];
+    const auto clipBlend = juce::jlimit (0.0f, 1.0f, params[Param::clipBlend]);
+    const auto knee      = params[Param::knee];
+    const auto preHpf    = params[Param::preHpf];
+    const auto postTone  = params[Param::postTone];
 
-    if (bypassed)
+    if (! bypass.begin (buffer, buffer.getNumSamples(), bypassed))
         return;
 
     updateFilters (preHpf, postTone);
@@ -98,13 +123,16 @@ void DYNClipForgeAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer,
     const int numChannels = buffer.getNumChannels();
     const int numSamples = buffer.getNumSamples();
 
-    dryBuffer.makeCopyOf (buffer, true);
-    buffer.applyGain (input);
+    // Both trims act on the clipper alone; the dry signal bypasses them.
+    for (auto* smoother : { &inputTrimGain, &outputTrimGain })
+        smoother->update();
+
+    dryWet.begin (buffer, numSamples, mixAmount);
+    inputTrimGain.applyGain (buffer, numSamples);
 
     for (int ch = 0; ch < numChannels; ++ch)
     {
         auto* data = buffer.getWritePointer (ch);
-        const auto* dry = dryBuffer.getReadPointer (ch);
         for (int i = 0; i < numSamples; ++i)
         {
             float sample = data[i];
@@ -114,11 +142,14 @@ void DYNClipForgeAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer,
             const float hard = hardClip (sample, ceilingGain);
             sample = soft * (1.0f - clipBlend) + hard * clipBlend;
 
-            sample = postToneFilter.processSample (sample);
-            const float processed = sample * output;
-            data[i] = processed * mix + dry[i] * (1.0f - mix);
+            data[i] = postToneFilter.processSample (sample);
         }
     }
+
+    outputTrimGain.applyGain (buffer, numSamples);
+    dryWet.end (buffer, numSamples, mixAmount);
+
+    bypass.end (buffer, numSamples);
 }
 
 void DYNClipForgeAudioProcessor::getStateInformation (juce::MemoryBlock& destData)
@@ -137,27 +168,7 @@ void DYNClipForgeAudioProcessor::setStateInformation (const void* data, int size
 juce::AudioProcessorValueTreeState::ParameterLayout
 DYNClipForgeAudioProcessor::createParameterLayout()
 {
-    std::vector<std::unique_ptr<juce::RangedAudioParameter>> params;
-
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("input_trim","Input Trim",
-                                                                   juce::NormalisableRange<float> (-18.0f, 18.0f, 0.1f), 0.0f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("ceiling",   "Ceiling",
-                                                                   juce::NormalisableRange<float> (-6.0f, 6.0f, 0.1f), 0.0f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("clip_blend","Clip Blend",
-                                                                   juce::NormalisableRange<float> (0.0f, 1.0f, 0.001f), 0.5f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("knee",      "Knee",
-                                                                   juce::NormalisableRange<float> (0.0f, 18.0f, 0.1f), 6.0f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("pre_hpf",   "Pre HPF",
-                                                                   juce::NormalisableRange<float> (20.0f, 400.0f, 0.01f, 0.35f), 60.0f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("post_tone", "Post Tone",
-                                                                   juce::NormalisableRange<float> (-1.0f, 1.0f, 0.001f), 0.0f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("output_trim","Output Trim",
-                                                                   juce::NormalisableRange<float> (-12.0f, 12.0f, 0.1f), 0.0f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("mix", "Mix",
-                                                                   juce::NormalisableRange<float> (0.0f, 1.0f, 0.001f), 1.0f));
-    params.push_back (std::make_unique<juce::AudioParameterBool> ("ui_bypass", "Soft Bypass", false));
-
-    return { params.begin(), params.end() };
+    return gls::createParameterLayout (parameterTable);
 }
 
 DYNClipForgeAudioProcessorEditor::DYNClipForgeAudioProcessorEditor (DYNClipForgeAudioProcessor& p)
@@ -284,18 +295,15 @@ void DYNClipForgeAudioProcessor::updateFilters (float preHpfFreq, float postTone
     if (currentSampleRate <= 0.0)
         return;
 
-    auto preCoeffs = juce::dsp::IIR::Coefficients<float>::makeHighPass (currentSampleRate,
-                                                                        juce::jlimit (20.0f, 400.0f, preHpfFreq),
-                                                                        0.707f);
-    preHpfFilter.coefficients = preCoeffs;
+    preHpfFilter.setHighPass (currentSampleRate, juce::jlimit (20.0f, 400.0f, preHpfFreq), 0.707f);
 
     const bool boostHighs = postTone >= 0.0f;
     const float pivot = boostHighs ? 4000.0f : 200.0f;
     const float gain  = juce::Decibels::decibelsToGain (std::abs (postTone) * 6.0f);
     if (boostHighs)
-        postToneFilter.coefficients = juce::dsp::IIR::Coefficients<float>::makeHighShelf (currentSampleRate, pivot, 0.707f, gain);
+        postToneFilter.setHighShelf (currentSampleRate, pivot, 0.707f, gain);
     else
-        postToneFilter.coefficients = juce::dsp::IIR::Coefficients<float>::makeLowShelf  (currentSampleRate, pivot, 0.707f, 1.0f / gain);
+        postToneFilter.setLowShelf (currentSampleRate, pivot, 0.707f, 1.0f / gain);
 }
 
 float DYNClipForgeAudioProcessor::softClip (float x, float knee)
@@ -2,18 +2,28 @@
 
 #include <JuceHeader.h>
 #include "../../DualPrecisionAudioProcessor.h"
+#include "../../ParameterTable.h"
+#include "../../SmoothedParameter.h"
+#include "../../dsp/Biquad.h"
+#include "../../dsp/DryWetStage.h"
+#include "../../dsp/SoftBypass.h"
 #include "../../ui/GoodluckLookAndFeel.h"
 #include <array>
 
 class DYNClipForgeAudioProcessor : public DualPrecisionAudioProcessor
 {
 public:
+    enum class Param
+    {
+        inputTrim, ceiling, clipBlend, knee, preHpf, postTone, outputTrim, mix, bypass,
+        count
+    };
+
     DYNClipForgeAudioProcessor();
     ~DYNClipForgeAudioProcessor() override = default;
 
     void prepareToPlay (double sampleRate, int samplesPerBlock) override;
     void releaseResources() override;
-    void processBlock (juce::AudioBuffer<float>&, juce::MidiBuffer&) override;
 
     juce::AudioProcessorEditor* createEditor() override;
     bool hasEditor() const override { return true; }
@@ -22,7 +32,6 @@ public:
     bool acceptsMidi() const override { return false; }
     bool producesMidi() const override { return false; }
     bool isMidiEffect() const override { return false; }
-    double getTailLengthSeconds() const override { return 0.0; }
 
     int getNumPrograms() override;
     int getCurrentProgram() override { return currentPreset; }
@@ -36,11 +45,19 @@ public:
     juce::AudioProcessorValueTreeState& getValueTreeState() { return apvts; }
     static juce::AudioProcessorValueTreeState::ParameterLayout createParameterLayout();
 
+protected:
+    void processFloat (juce::AudioBuffer<float>&, juce::MidiBuffer&) override;
+
 private:
     juce::AudioProcessorValueTreeState apvts;
-    juce::AudioBuffer<float> dryBuffer;
-    juce::dsp::IIR::Filter<float> preHpfFilter;
-    juce::dsp::IIR::Filter<float> postToneFilter;
+    gls::ParameterHandles<Param> params;
+    gls::SmoothedParameter inputTrimGain  { params, Param::inputTrim,  gls::SmoothedParameter::Mapping::decibels };
+    gls::SmoothedParameter mixAmount      { params, Param::mix };
+    gls::SmoothedParameter outputTrimGain { params, Param::outputTrim, gls::SmoothedParameter::Mapping::decibels };
+    gls::dsp::SoftBypass bypass;
+    gls::dsp::DryWetStage dryWet;
+    gls::dsp::Biquad preHpfFilter;
+    gls::dsp::Biquad postToneFilter;
     double currentSampleRate = 44100.0;
     int currentPreset = 0;
 
@@ -6,6 +6,27 @@ constexpr auto kStateId      = "MULTIBAND_MASTER";
 constexpr auto kParamBypass  = "ui_bypass";
 constexpr auto kParamInput   = "input_trim";
 constexpr auto kParamOutput  = "output_trim";
+
+using Param = DYNMultiBandMasterAudioProcessor::Param;
+using Spec = gls::ParameterSpec;
+
+constexpr std::array<Spec, (size_t) Param::count> parameterTable {{
+    Spec::range  ("band1_freq",   "Band1 Freq",   60.0f,  8000.0f, 0.01f,  150.0f,  0.4f),
+    Spec::range  ("band2_freq",   "Band2 Freq",   60.0f,  8000.0f, 0.01f,  800.0f,  0.4f),
+    Spec::range  ("band3_freq",   "Band3 Freq",   60.0f,  8000.0f, 0.01f,  3200.0f, 0.4f),
+    Spec::range  ("band1_thresh", "Band1 Thresh", -48.0f, 0.0f,    0.1f,   -24.0f),
+    Spec::range  ("band2_thresh", "Band2 Thresh", -48.0f, 0.0f,    0.1f,   -18.0f),
+    Spec::range  ("band3_thresh", "Band3 Thresh", -48.0f, 0.0f,    0.1f,   -12.0f),
+    Spec::range  ("band1_ratio",  "Band1 Ratio",  1.0f,   10.0f,   0.01f,  2.0f,    0.5f),
+    Spec::range  ("band2_ratio",  "Band2 Ratio",  1.0f,   10.0f,   0.01f,  2.5f,    0.5f),
+    Spec::range  ("band3_ratio",  "Band3 Ratio",  1.0f,   10.0f,   0.01f,  3.0f,    0.5f),
+    Spec::range  (kParamInput,    "Input Trim",   -18.0f, 18.0f,   0.1f,   0.0f),
+    Spec::range  ("mix",          "Mix",          0.0f,   1.0f,    0.001f, 1.0f),
+    Spec::range  (kParamOutput,   "Output Trim",  -12.0f, 12.0f,   0.1f,   0.0f),
+    Spec::toggle (kParamBypass,   "Soft Bypass",  false)
+}};
+
+static_assert (gls::hasUniqueIds (parameterTable));
 }
 
 const std::array<DYNMultiBandMasterAudioProcessor::Preset, 3> DYNMultiBandMasterAudioProcessor::presetBank {{
@@ -60,24 +81,37 @@ DYNMultiBandMasterAudioProcessor::DYNMultiBandMasterAudioProcessor()
     : DualPrecisionAudioProcessor(BusesProperties()
                         .withInput  ("Input", juce::AudioChannelSet::stereo(), true)
                         .withOutput ("Output", juce::AudioChannelSet::stereo(), true)),
-      apvts (*this, nullptr, kStateId, createParameterLayout())
+      apvts (*this, nullptr, kStateId, createParameterLayout()),
+      params (apvts, parameterTable)
 {
+    bypass.snapOnResume (dryWet);
 }
 
 void DYNMultiBandMasterAudioProcessor::prepareToPlay (double sampleRate, int samplesPerBlock)
 {
+    DualPrecisionAudioProcessor::prepareToPlay (sampleRate, samplesPerBlock);
+
     currentSampleRate = juce::jmax (sampleRate, 44100.0);
     lastBlockSize = (juce::uint32) juce::jmax (1, samplesPerBlock);
     ensureBandStateSize (getTotalNumOutputChannels());
+
+    for (auto* smoother : { &inputTrimGain, &mixAmount, &outputTrimGain })
+        smoother->prepare (sampleRate, samplesPerBlock);
+
+    dryWet.prepare (sampleRate, juce::jmax (getTotalNumInputChannels(), getTotalNumOutputChannels()), samplesPerBlock);
+    bypass.prepare (sampleRate, juce::jmax (getTotalNumInputChannels(), getTotalNumOutputChannels()), samplesPerBlock);
 }
 
 void DYNMultiBandMasterAudioProcessor::releaseResources()
 {
 }
 
-void DYNMultiBandMasterAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer,
-                                                     juce::MidiBuffer&)
+void DYNMultiBandMasterAudioProcessor::processFloat (juce::AudioBuffer<float>& buffer,
+                                                     juce::MidiBuffer& midi)
 {
+    if (renderInPreparedChunks (buffer, midi))
+        return;
+
     juce::ScopedNoDenormals noDenormals;
 
     auto totalIn  = getTotalNumInputChannels();
@@ -85,44 +119,34 @@ void DYNMultiBandMasterAudioProcessor::processBlock (juce::AudioBuffer<float>& b
     for (int ch = totalIn; ch < totalOut; ++ch)
         buffer.clear (ch, 0, buffer.getNumSamples());
 
-    auto read = [this](const char* id) { return apvts.getRawParameterValue (id)->load(); };
-
-    if (apvts.getRawParameterValue (kParamBypass)->load() > 0.5f)
+    if (! bypass.begin (buffer, buffer.getNumSamples(), params.isOn (Param::bypass)))
         return;
 
     std::array<float, 3> freqs {
-        read ("band1_freq"),
-        read ("band2_freq"),
-        read ("band3_freq")
+        params[Param::band1Freq],
+        params[Param::band2Freq],
+        params[Param::band3Freq]
     };
 
     std::array<float, 3> thresholds {
-        read ("band1_thresh"),
-        read ("band2_thresh"),
-        read ("band3_thresh")
+        params[Param::band1Thresh],
+        params[Param::band2Thresh],
+        params[Param::band3Thresh]
     };
 
     std::array<float, 3> ratios {
-        juce::jmax (1.0f, read ("band1_ratio")),
-        juce::jmax (1.0f, read ("band2_ratio")),
-        juce::jmax (1.0f, read ("band3_ratio"))
+        juce::jmax (1.0f, params[Param::band1Ratio]),
+        juce::jmax (1.0f, params[Param::band2Ratio]),
+        juce::jmax (1.0f, params[Param::band3Ratio])
     };
 
-    const auto mix       = juce::jlimit (0.0f, 1.0f, read ("mix"));
-    const auto inputDb   = read (kParamInput);
-    const auto outputDb  = read (kParamOutput);
-    const auto inputGain = juce::Decibels::decibelsToGain (inputDb);
-    const auto outputGain= juce::Decibels::decibelsToGain (outputDb);
-
-    buffer.applyGain (inputGain);
-    dryBuffer.makeCopyOf (buffer, true);
+    dryWet.begin (buffer, buffer.getNumSamples(), inputTrimGain, mixAmount);
 
     lastBlockSize = (juce::uint32) juce::jmax (1, buffer.getNumSamples());
     ensureBandStateSize (buffer.getNumChannels());
     updateBandFilters (freqs);
 
     const float attackMs  = 8.0f;
-    const float releaseMs = 120.0f;
     const float attackCoeff  = std::exp (-1.0f / (attackMs * 0.001f * (float) currentSampleRate));
     const float releaseCoeff = std::exp (-1.0f / (releaseMs * 0.001f * (float) currentSampleRate));
 
@@ -161,13 +185,15 @@ void DYNMultiBandMasterAudioProcessor::processBlock (juce::AudioBuffer<float>& b
         }
     }
 
-    for (int ch = 0; ch < numChannels; ++ch)
-    {
-        auto* wet = buffer.getWritePointer (ch);
-        const auto* dry = dryBuffer.getReadPointer (ch);
-        for (int i = 0; i < numSamples; ++i)
-            wet[i] = (wet[i] * mix + dry[i] * (1.0f - mix)) * outputGain;
-    }
+    dryWet.end (buffer, numSamples, mixAmount, outputTrimGain);
+
+    bypass.end (buffer, numSamples);
+}
+
+void DYNMultiBandMasterAudioProcessor::updateTail()
+{
+    // The band envelopes release at a fixed rate.
+    tail.setTail (0.0, gls::dsp::TailTracker::getEnvelopeRT60 (releaseMs * 0.001));
 }
 
 void DYNMultiBandMasterAudioProcessor::getStateInformation (juce::MemoryBlock& destData)
@@ -186,35 +212,7 @@ void DYNMultiBandMasterAudioProcessor::setStateInformation (const void* data, in
 juce::AudioProcessorValueTreeState::ParameterLayout
 DYNMultiBandMasterAudioProcessor::createParameterLayout()
 {
-    std::vector<std::unique_ptr<juce::RangedAudioParameter>> params;
-
-    auto freqRange  = juce::NormalisableRange<float> (60.0f, 8000.0f, 0.01f, 0.4f);
-    auto threshRange= juce::NormalisableRange<float> (-48.0f, 0.0f, 0.1f);
-
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("band1_freq", "Band1 Freq", freqRange, 150.0f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("band2_freq", "Band2 Freq", freqRange, 800.0f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("band3_freq", "Band3 Freq", freqRange, 3200.0f));
-
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("band1_thresh", "Band1 Thresh", threshRange, -24.0f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("band2_thresh", "Band2 Thresh", threshRange, -18.0f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("band3_thresh", "Band3 Thresh", threshRange, -12.0f));
-
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("band1_ratio", "Band1 Ratio",
-                                                                   juce::NormalisableRange<float> (1.0f, 10.0f, 0.01f, 0.5f), 2.0f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("band2_ratio", "Band2 Ratio",
-                                                                   juce::NormalisableRange<float> (1.0f, 10.0f, 0.01f, 0.5f), 2.5f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("band3_ratio", "Band3 Ratio",
-                                                                   juce::NormalisableRange<float> (1.0f, 10.0f, 0.01f, 0.5f), 3.0f));
-
-    params.push_back (std::make_unique<juce::AudioParameterFloat> (kParamInput, "Input Trim",
-                                                                   juce::NormalisableRange<float> (-18.0f, 18.0f, 0.1f), 0.0f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("mix", "Mix",
-                                                                   juce::NormalisableRange<float> (0.0f, 1.0f, 0.001f), 1.0f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> (kParamOutput, "Output Trim",
-                                                                   juce::NormalisableRange<float> (-12.0f, 12.0f, 0.1f), 0.0f));
-    params.push_back (std::make_unique<juce::AudioParameterBool> (kParamBypass, "Soft Bypass", false));
-
-    return { params.begin(), params.end() };
+    return gls::createParameterLayout (parameterTable);
 }
 
 DYNMultiBandMasterAudioProcessorEditor::DYNMultiBandMasterAudioProcessorEditor (DYNMultiBandMasterAudioProcessor& p)
@@ -384,10 +382,9 @@ void DYNMultiBandMasterAudioProcessor::updateBandFilters (const std::array<float
     for (size_t band = 0; band < bandStates.size(); ++band)
     {
         const auto freq = juce::jlimit (40.0f, (float) (currentSampleRate * 0.45), freqs[band]);
-        auto coeffs = juce::dsp::IIR::Coefficients<float>::makeBandPass (currentSampleRate, freq, 0.8f + (float) band * 0.4f);
 
         for (auto& state : bandStates[band])
-            state.filter.coefficients = coeffs;
+            state.filter.setBandPass (currentSampleRate, freq, 0.8f + (float) band * 0.4f);
     }
 }
 
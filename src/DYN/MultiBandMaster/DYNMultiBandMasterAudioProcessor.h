@@ -2,6 +2,11 @@
 
 #include <JuceHeader.h>
 #include "../../DualPrecisionAudioProcessor.h"
+#include "../../ParameterTable.h"
+#include "../../SmoothedParameter.h"
+#include "../../dsp/Biquad.h"
+#include "../../dsp/DryWetStage.h"
+#include "../../dsp/SoftBypass.h"
 #include "../../ui/GoodluckLookAndFeel.h"
 #include <array>
 #include <vector>
@@ -9,12 +14,18 @@
 class DYNMultiBandMasterAudioProcessor : public DualPrecisionAudioProcessor
 {
 public:
+    enum class Param
+    {
+        band1Freq, band2Freq, band3Freq, band1Thresh, band2Thresh, band3Thresh,
+        band1Ratio, band2Ratio, band3Ratio, inputTrim, mix, outputTrim, bypass,
+        count
+    };
+
     DYNMultiBandMasterAudioProcessor();
     ~DYNMultiBandMasterAudioProcessor() override = default;
 
     void prepareToPlay (double sampleRate, int samplesPerBlock) override;
     void releaseResources() override;
-    void processBlock (juce::AudioBuffer<float>&, juce::MidiBuffer&) override;
 
     juce::AudioProcessorEditor* createEditor() override;
     bool hasEditor() const override { return true; }
@@ -23,7 +34,6 @@ public:
     bool acceptsMidi() const override { return false; }
     bool producesMidi() const override { return false; }
     bool isMidiEffect() const override { return false; }
-    double getTailLengthSeconds() const override { return 0.0; }
 
     int getNumPrograms() override;
     int getCurrentProgram() override { return currentPreset; }
@@ -37,17 +47,27 @@ public:
     juce::AudioProcessorValueTreeState& getValueTreeState() { return apvts; }
     static juce::AudioProcessorValueTreeState::ParameterLayout createParameterLayout();
 
+protected:
+    void processFloat (juce::AudioBuffer<float>&, juce::MidiBuffer&) override;
+    void updateTail() override;
+
 private:
     juce::AudioProcessorValueTreeState apvts;
+    gls::ParameterHandles<Param> params;
+    static constexpr float releaseMs = 120.0f;
+    gls::SmoothedParameter inputTrimGain  { params, Param::inputTrim,  gls::SmoothedParameter::Mapping::decibels };
+    gls::SmoothedParameter mixAmount      { params, Param::mix };
+    gls::SmoothedParameter outputTrimGain { params, Param::outputTrim, gls::SmoothedParameter::Mapping::decibels };
+    gls::dsp::SoftBypass bypass;
     struct DynamicBand
     {
-        juce::dsp::IIR::Filter<float> filter;
+        gls::dsp::Biquad filter;
         float envelope = 0.0f;
         float gain = 1.0f;
     };
 
     std::array<std::vector<DynamicBand>, 3> bandStates;
-    juce::AudioBuffer<float> dryBuffer;
+    gls::dsp::DryWetStage dryWet;
     double currentSampleRate = 44100.0;
     juce::uint32 lastBlockSize = 512;
     int currentPreset = 0;
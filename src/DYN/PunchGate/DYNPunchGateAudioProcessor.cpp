@@ -15,6 +15,27 @@ constexpr auto kParamMix         = "mix";
 constexpr auto kParamInputTrim   = "input_trim";
 constexpr auto kParamOutputTrim  = "output_trim";
 constexpr auto kParamBypass      = "ui_bypass";
+
+using Param = DYNPunchGateAudioProcessor::Param;
+using Spec = gls::ParameterSpec;
+
+constexpr std::array<Spec, (size_t) Param::count> parameterTable {{
+    Spec::range  (kParamThresh,       "Threshold",   -60.0f, 0.0f,     0.1f,   -30.0f),
+    Spec::range  (kParamRange,        "Range",       0.0f,   60.0f,    0.1f,   30.0f),
+    Spec::range  (kParamAttack,       "Attack",      0.1f,   50.0f,    0.01f,  2.0f,    0.35f),
+    Spec::range  (kParamHold,         "Hold",        0.0f,   200.0f,   0.01f,  20.0f,   0.35f),
+    Spec::range  (kParamRelease,      "Release",     5.0f,   500.0f,   0.01f,  120.0f,  0.3f),
+    Spec::range  (kParamHysteresis,   "Hysteresis",  0.0f,   20.0f,    0.1f,   3.0f),
+    Spec::range  (kParamPunchBoost,   "Punch Boost", 0.0f,   12.0f,    0.1f,   4.0f),
+    Spec::range  (kParamSidechainHPF, "SC HPF",      20.0f,  2000.0f,  0.01f,  120.0f,  0.45f),
+    Spec::range  (kParamSidechainLPF, "SC LPF",      500.0f, 20000.0f, 0.01f,  8000.0f, 0.45f),
+    Spec::range  (kParamMix,          "Mix",         0.0f,   1.0f,     0.001f, 1.0f),
+    Spec::range  (kParamInputTrim,    "Input Trim",  -24.0f, 24.0f,    0.1f,   0.0f),
+    Spec::range  (kParamOutputTrim,   "Output Trim", -24.0f, 24.0f,    0.1f,   0.0f),
+    Spec::toggle (kParamBypass,       "Soft Bypass", false)
+}};
+
+static_assert (gls::hasUniqueIds (parameterTable));
 }
 
 const std::array<DYNPunchGateAudioProcessor::Preset, 3> DYNPunchGateAudioProcessor::presetBank {{
@@ -70,12 +91,16 @@ DYNPunchGateAudioProcessor::DYNPunchGateAudioProcessor()
                         .withInput  ("Input", juce::AudioChannelSet::stereo(), true)
                         .withOutput ("Output", juce::AudioChannelSet::stereo(), true)
                         .withInput  ("Sidechain", juce::AudioChannelSet::stereo(), false)),
-      apvts (*this, nullptr, "PUNCH_GATE", createParameterLayout())
+      apvts (*this, nullptr, "PUNCH_GATE", createParameterLayout()),
+      params (apvts, parameterTable)
 {
+    bypass.snapOnResume (dryWet);
 }
 
 void DYNPunchGateAudioProcessor::prepareToPlay (double sampleRate, int samplesPerBlock)
 {
+    DualPrecisionAudioProcessor::prepareToPlay (sampleRate, samplesPerBlock);
+
     currentSampleRate = juce::jmax (sampleRate, 44100.0);
     ensureStateSize();
     juce::dsp::ProcessSpec spec { currentSampleRate,
@@ -97,15 +122,24 @@ void DYNPunchGateAudioProcessor::prepareToPlay (double sampleRate, int samplesPe
         state.holdCounter = 0.0f;
         state.gateGain = 1.0f;
     }
+
+    for (auto* smoother : { &inputTrimGain, &mixAmount, &outputTrimGain })
+        smoother->prepare (sampleRate, samplesPerBlock);
+
+    dryWet.prepare (sampleRate, juce::jmax (getTotalNumInputChannels(), getTotalNumOutputChannels()), samplesPerBlock);
+    bypass.prepare (sampleRate, juce::jmax (getTotalNumInputChannels(), getTotalNumOutputChannels()), samplesPerBlock);
 }
 
 void DYNPunchGateAudioProcessor::releaseResources()
 {
 }
 
-void DYNPunchGateAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer,
-                                               juce::MidiBuffer&)
+void DYNPunchGateAudioProcessor::processFloat (juce::AudioBuffer<float>& buffer,
+                                               juce::MidiBuffer& midi)
 {
+    if (renderInPreparedChunks (buffer, midi))
+        return;
+
     juce::ScopedNoDenormals noDenormals;
 
     const auto totalIn  = getTotalNumInputChannels();
@@ -113,23 +147,18 @@ void DYNPunchGateAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer,
     for (int ch = totalIn; ch < totalOut; ++ch)
         buffer.clear (ch, 0, buffer.getNumSamples());
 
-    if (apvts.getRawParameterValue (kParamBypass)->load() > 0.5f)
+    if (! bypass.begin (buffer, buffer.getNumSamples(), params.isOn (Param::bypass)))
         return;
 
-    auto read = [this](const char* id) { return apvts.getRawParameterValue (id)->load(); };
-
-    const auto threshDb    = read (kParamThresh);
-    const auto rangeDb     = juce::jmax (0.0f, read (kParamRange));
-    const auto attackMs    = juce::jmax (0.1f, read (kParamAttack));
-    const auto holdMs      = juce::jmax (0.0f, read (kParamHold));
-    const auto releaseMs   = juce::jmax (1.0f, read (kParamRelease));
-    const auto hysteresis  = juce::jmax (0.0f, read (kParamHysteresis));
-    const auto punchBoost  = juce::Decibels::decibelsToGain (read (kParamPunchBoost));
-    const auto scHpf       = read (kParamSidechainHPF);
-    const auto scLpf       = read (kParamSidechainLPF);
-    const auto mix         = juce::jlimit (0.0f, 1.0f, read (kParamMix));
-    const auto inputTrim   = juce::Decibels::decibelsToGain (read (kParamInputTrim));
-    const auto outputTrim  = juce::Decibels::decibelsToGain (read (kParamOutputTrim));
+    const auto threshDb    = params[Param::thresh];
+    const auto rangeDb     = juce::jmax (0.0f, params[Param::range]);
+    const auto attackMs    = juce::jmax (0.1f, params[Param::attack]);
+    const auto holdMs      = juce::jmax (0.0f, params[Param::hold]);
+    const auto releaseMs   = juce::jmax (1.0f, params[Param::release]);
+    const auto hysteresis  = juce::jmax (0.0f, params[Param::hysteresis]);
+    const auto punchBoost  = juce::Decibels::decibelsToGain (params[Param::punchBoost]);
+    const auto scHpf       = params[Param::scHpf];
+    const auto scLpf       = params[Param::scLpf];
 
     ensureStateSize();
 
@@ -143,9 +172,7 @@ void DYNPunchGateAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer,
     const int numSamples = buffer.getNumSamples();
     const int numChannels = buffer.getNumChannels();
 
-    dryBuffer.setSize (numChannels, numSamples, false, false, true);
-    buffer.applyGain (inputTrim);
-    dryBuffer.makeCopyOf (buffer, true);
+    dryWet.begin (buffer, numSamples, inputTrimGain, mixAmount);
 
     juce::AudioBuffer<float> sidechainBuffer;
     const bool hasSidechainBus = getBusCount (true) > 1;
@@ -157,14 +184,12 @@ void DYNPunchGateAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer,
 
     auto makeFilter = [this, scHpf, scLpf]()
     {
-        auto hp = juce::dsp::IIR::Coefficients<float>::makeHighPass (currentSampleRate,
-                                                                     juce::jlimit (20.0f, 2000.0f, scHpf));
-        auto lp = juce::dsp::IIR::Coefficients<float>::makeLowPass  (currentSampleRate,
-                                                                     juce::jlimit (200.0f, (float) (currentSampleRate * 0.45f), scLpf));
+        const auto hpFreq = juce::jlimit (20.0f, 2000.0f, scHpf);
+        const auto lpFreq = juce::jlimit (200.0f, (float) (currentSampleRate * 0.45f), scLpf);
         for (auto& filter : scHighPassFilters)
-            filter.coefficients = hp;
+            filter.setHighPass (currentSampleRate, hpFreq);
         for (auto& filter : scLowPassFilters)
-            filter.coefficients = lp;
+            filter.setLowPass (currentSampleRate, lpFreq);
     };
     makeFilter();
 
@@ -219,19 +244,16 @@ void DYNPunchGateAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer,
         }
     }
 
-    if (mix < 0.999f)
-    {
-        for (int ch = 0; ch < numChannels; ++ch)
-        {
-            auto* processed = buffer.getWritePointer (ch);
-            const auto* dry = dryBuffer.getReadPointer (ch);
-            for (int i = 0; i < numSamples; ++i)
-                processed[i] = processed[i] * mix + dry[i] * (1.0f - mix);
-        }
-    }
-
-    buffer.applyGain (outputTrim);
+    dryWet.end (buffer, numSamples, mixAmount, outputTrimGain);
     gateMeter.store (juce::jlimit (0.0f, 1.0f, meterValue));
+
+    bypass.end (buffer, numSamples);
+}
+
+void DYNPunchGateAudioProcessor::updateTail()
+{
+    // The gate holds, then its envelope releases; both run out before it settles closed.
+    tail.setTail (params[Param::hold] * 0.001, gls::dsp::TailTracker::getEnvelopeRT60 (params[Param::release] * 0.001));
 }
 
 int DYNPunchGateAudioProcessor::getNumPrograms()
@@ -272,35 +294,7 @@ void DYNPunchGateAudioProcessor::setStateInformation (const void* data, int size
 juce::AudioProcessorValueTreeState::ParameterLayout
 DYNPunchGateAudioProcessor::createParameterLayout()
 {
-    std::vector<std::unique_ptr<juce::RangedAudioParameter>> params;
-
-    params.push_back (std::make_unique<juce::AudioParameterFloat> (kParamThresh, "Threshold",
-                                                                   juce::NormalisableRange<float> (-60.0f, 0.0f, 0.1f), -30.0f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> (kParamRange, "Range",
-                                                                   juce::NormalisableRange<float> (0.0f, 60.0f, 0.1f), 30.0f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> (kParamAttack, "Attack",
-                                                                   juce::NormalisableRange<float> (0.1f, 50.0f, 0.01f, 0.35f), 2.0f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> (kParamHold, "Hold",
-                                                                   juce::NormalisableRange<float> (0.0f, 200.0f, 0.01f, 0.35f), 20.0f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> (kParamRelease, "Release",
-                                                                   juce::NormalisableRange<float> (5.0f, 500.0f, 0.01f, 0.3f), 120.0f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> (kParamHysteresis, "Hysteresis",
-                                                                   juce::NormalisableRange<float> (0.0f, 20.0f, 0.1f), 3.0f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> (kParamPunchBoost, "Punch Boost",
-                                                                   juce::NormalisableRange<float> (0.0f, 12.0f, 0.1f), 4.0f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> (kParamSidechainHPF, "SC HPF",
-                                                                   juce::NormalisableRange<float> (20.0f, 2000.0f, 0.01f, 0.45f), 120.0f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> (kParamSidechainLPF, "SC LPF",
-                                                                   juce::NormalisableRange<float> (500.0f, 20000.0f, 0.01f, 0.45f), 8000.0f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> (kParamMix, "Mix",
-                                                                   juce::NormalisableRange<float> (0.0f, 1.0f, 0.001f), 1.0f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> (kParamInputTrim, "Input Trim",
-                                                                   juce::NormalisableRange<float> (-24.0f, 24.0f, 0.1f), 0.0f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> (kParamOutputTrim, "Output Trim",
-                                                                   juce::NormalisableRange<float> (-24.0f, 24.0f, 0.1f), 0.0f));
-    params.push_back (std::make_unique<juce::AudioParameterBool>  (kParamBypass, "Soft Bypass", false));
-
-    return { params.begin(), params.end() };
+    return gls::createParameterLayout (parameterTable);
 }
 
 namespace
@@ -523,7 +517,7 @@ void DYNPunchGateAudioProcessor::ensureStateSize()
     if (static_cast<int> (channelStates.size()) != requiredChannels)
         channelStates.resize (requiredChannels);
 
-    auto ensureFilters = [this, requiredChannels](std::vector<juce::dsp::IIR::Filter<float>>& filters)
+    auto ensureFilters = [this, requiredChannels](std::vector<gls::dsp::Biquad>& filters)
     {
         if ((int) filters.size() != requiredChannels)
             filters.resize (requiredChannels);
@@ -3,17 +3,28 @@
 #include <JuceHeader.h>
 #include <array>
 #include "../../DualPrecisionAudioProcessor.h"
+#include "../../ParameterTable.h"
+#include "../../SmoothedParameter.h"
+#include "../../dsp/Biquad.h"
+#include "../../dsp/DryWetStage.h"
+#include "../../dsp/SoftBypass.h"
 #include "../../ui/GoodluckLookAndFeel.h"
 
 class DYNPunchGateAudioProcessor : public DualPrecisionAudioProcessor
 {
 public:
+    enum class Param
+    {
+        thresh, range, attack, hold, release, hysteresis, punchBoost, scHpf, scLpf, mix,
+        inputTrim, outputTrim, bypass,
+        count
+    };
+
     DYNPunchGateAudioProcessor();
     ~DYNPunchGateAudioProcessor() override = default;
 
     void prepareToPlay (double sampleRate, int samplesPerBlock) override;
     void releaseResources() override;
-    void processBlock (juce::AudioBuffer<float>&, juce::MidiBuffer&) override;
 
     juce::AudioProcessorEditor* createEditor() override;
     bool hasEditor() const override { return true; }
@@ -22,7 +33,6 @@ public:
     bool acceptsMidi() const override { return false; }
     bool producesMidi() const override { return false; }
     bool isMidiEffect() const override { return false; }
-    double getTailLengthSeconds() const override { return 0.0; }
 
     int getNumPrograms() override;
     int getCurrentProgram() override { return currentPreset; }
@@ -37,9 +47,18 @@ public:
     static juce::AudioProcessorValueTreeState::ParameterLayout createParameterLayout();
     float getGateMeter() const noexcept { return gateMeter.load(); }
 
+protected:
+    void processFloat (juce::AudioBuffer<float>&, juce::MidiBuffer&) override;
+    void updateTail() override;
+
 private:
     juce::AudioProcessorValueTreeState apvts;
-    juce::AudioBuffer<float> dryBuffer;
+    gls::ParameterHandles<Param> params;
+    gls::SmoothedParameter inputTrimGain  { params, Param::inputTrim,  gls::SmoothedParameter::Mapping::decibels };
+    gls::SmoothedParameter mixAmount      { params, Param::mix };
+    gls::SmoothedParameter outputTrimGain { params, Param::outputTrim, gls::SmoothedParameter::Mapping::decibels };
+    gls::dsp::SoftBypass bypass;
+    gls::dsp::DryWetStage dryWet;
     struct ChannelState
     {
         float envelope = 0.0f;
@@ -49,8 +68,8 @@ private:
 
     std::vector<ChannelState> channelStates;
     double currentSampleRate = 44100.0;
-    std::vector<juce::dsp::IIR::Filter<float>> scHighPassFilters;
-    std::vector<juce::dsp::IIR::Filter<float>> scLowPassFilters;
+    std::vector<gls::dsp::Biquad> scHighPassFilters;
+    std::vector<gls::dsp::Biquad> scLowPassFilters;
     std::atomic<float> gateMeter { 0.0f };
     int currentPreset = 0;
 
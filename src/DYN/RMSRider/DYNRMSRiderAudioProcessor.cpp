@@ -6,6 +6,25 @@ constexpr auto kStateId     = "RMS_RIDER";
 constexpr auto kParamBypass = "ui_bypass";
 constexpr auto kParamInput  = "input_trim";
 constexpr auto kParamOutput = "output_trim";
+constexpr auto kParamFixedLatency = "fixed_latency";
+constexpr float kMaxLookaheadMs = 20.0f;
+
+using Param = DYNRMSRiderAudioProcessor::Param;
+using Spec = gls::ParameterSpec;
+
+constexpr std::array<Spec, (size_t) Param::count> parameterTable {{
+    Spec::range  ("target_level",     "Target Level",   -30.0f, -3.0f,           0.1f,   -18.0f),
+    Spec::range  ("speed",            "Speed",          0.0f,   1.0f,            0.001f, 0.5f),
+    Spec::range  ("range",            "Range",          0.0f,   24.0f,           0.1f,   6.0f),
+    Spec::range  ("hf_sensitivity",   "HF Sensitivity", 0.0f,   1.0f,            0.001f, 0.5f),
+    Spec::range  ("lookahead",        "Lookahead",      0.1f,   kMaxLookaheadMs, 0.01f,  5.0f, 0.35f),
+    Spec::range  (kParamInput,        "Input Trim",     -12.0f, 12.0f,           0.1f,   0.0f),
+    Spec::range  (kParamOutput,       "Output Trim",    -12.0f, 12.0f,           0.1f,   0.0f),
+    Spec::toggle (kParamBypass,       "Soft Bypass",    false),
+    Spec::toggle (kParamFixedLatency, "Fixed Latency",  false)
+}};
+
+static_assert (gls::hasUniqueIds (parameterTable));
 }
 
 const std::array<DYNRMSRiderAudioProcessor::Preset, 3> DYNRMSRiderAudioProcessor::presetBank {{
@@ -45,12 +64,16 @@ DYNRMSRiderAudioProcessor::DYNRMSRiderAudioProcessor()
     : DualPrecisionAudioProcessor(BusesProperties()
                         .withInput  ("Input", juce::AudioChannelSet::stereo(), true)
                         .withOutput ("Output", juce::AudioChannelSet::stereo(), true)),
-      apvts (*this, nullptr, kStateId, createParameterLayout())
+      apvts (*this, nullptr, kStateId, createParameterLayout()),
+      params (apvts, parameterTable)
 {
+    bypass.snapOnResume ({ &inputTrimGain, &outputTrimGain });
 }
 
 void DYNRMSRiderAudioProcessor::prepareToPlay (double sampleRate, int samplesPerBlock)
 {
+    DualPrecisionAudioProcessor::prepareToPlay (sampleRate, samplesPerBlock);
+
     currentSampleRate = juce::jmax (sampleRate, 44100.0);
     lastBlockSize = (juce::uint32) juce::jmax (1, samplesPerBlock);
     ensureStateSize (juce::jmax (1, getTotalNumOutputChannels()));
@@ -65,15 +88,30 @@ void DYNRMSRiderAudioProcessor::prepareToPlay (double sampleRate, int samplesPer
     }
 
     gainSmoothed = 1.0f;
+
+    maxLookaheadSamples = juce::roundToInt (kMaxLookaheadMs * 0.001 * currentSampleRate);
+    gainDelay.prepare (maxLookaheadSamples, 1.0f);
+    gainDelay.reset (1.0f);
+    bypass.prepare (currentSampleRate, juce::jmax (getTotalNumInputChannels(), getTotalNumOutputChannels()),
+                    (int) lastBlockSize, maxLookaheadSamples);
+
+    for (auto* smoother : { &inputTrimGain, &outputTrimGain })
+        smoother->prepare (currentSampleRate, (int) lastBlockSize);
+
+    latency.invalidate();
+    updateLatency (params[Param::lookahead], params.isOn (Param::fixedLatency));
 }
 
 void DYNRMSRiderAudioProcessor::releaseResources()
 {
 }
 
-void DYNRMSRiderAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer,
-                                               juce::MidiBuffer&)
+void DYNRMSRiderAudioProcessor::processFloat (juce::AudioBuffer<float>& buffer,
+                                               juce::MidiBuffer& midi)
 {
+    if (renderInPreparedChunks (buffer, midi))
+        return;
+
     juce::ScopedNoDenormals noDenormals;
 
     auto totalIn  = getTotalNumInputChannels();
@@ -81,38 +119,37 @@ void DYNRMSRiderAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer,
     for (int ch = totalIn; ch < totalOut; ++ch)
         buffer.clear (ch, 0, buffer.getNumSamples());
 
-    auto read = [this](const char* id) { return apvts.getRawParameterValue (id)->load(); };
-
-    const auto targetDb   = read ("target_level");
-    const auto speed      = juce::jlimit (0.0f, 1.0f, read ("speed"));
-    const auto rangeDb    = juce::jlimit (0.0f, 24.0f, read ("range"));
-    const auto hfSense    = juce::jlimit (0.0f, 1.0f, read ("hf_sensitivity"));
-    const auto lookahead  = read ("lookahead");
-    const auto inputTrim  = juce::Decibels::decibelsToGain (read (kParamInput));
-    const auto outputTrim = juce::Decibels::decibelsToGain (read (kParamOutput));
-    const bool bypassed   = read (kParamBypass) > 0.5f;
+    const auto targetDb   = params[Param::targetLevel];
+    const auto speed      = juce::jlimit (0.0f, 1.0f, params[Param::speed]);
+    const auto rangeDb    = juce::jlimit (0.0f, 24.0f, params[Param::range]);
+    const auto hfSense    = juce::jlimit (0.0f, 1.0f, params[Param::hfSensitivity]);
+    const auto lookahead  = params[Param::lookahead];
+    const bool bypassed   = params.isOn (Param::bypass);
+    const bool fixedLatency = params.isOn (Param::fixedLatency);
 
     const int numSamples  = buffer.getNumSamples();
     const int numChannels = buffer.getNumChannels();
 
     ensureStateSize (numChannels);
+    updateLatency (lookahead, fixedLatency);
     if (numSamples == 0 || numChannels == 0)
         return;
 
-    buffer.applyGain (inputTrim);
-
-    if (bypassed)
+    // The bypass path delays the dry signal by the same latency, so PDC holds either way.
+    if (! bypass.begin (buffer, numSamples, bypassed))
         return;
 
-    const auto lookaheadSamples = juce::roundToInt (lookahead * 0.001f * currentSampleRate);
+    for (auto* smoother : { &inputTrimGain, &outputTrimGain })
+        smoother->update();
+
+    inputTrimGain.applyGain (buffer, numSamples);
+    const auto* outputTrims = outputTrimGain.advance (numSamples);
+    const auto outputTrim = outputTrimGain.getCurrentValue();
 
     const auto attackCoeff  = std::exp (-1.0f / ((10.0f - speed * 9.5f) * 0.001f * currentSampleRate));
     const auto releaseCoeff = std::exp (-1.0f / ((50.0f + speed * 450.0f) * 0.001f * currentSampleRate));
     const auto targetGain   = juce::Decibels::decibelsToGain (targetDb);
 
-    for (auto& state : channelStates)
-        state.lookaheadLine.setDelay (lookaheadSamples);
-
     for (int sample = 0; sample < numSamples; ++sample)
     {
         float rms = 0.0f;
@@ -148,13 +185,24 @@ void DYNRMSRiderAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer,
         else
             gainSmoothed = releaseCoeff * (gainSmoothed - gain) + gain;
 
+        const float appliedGain = gainDelay.process (gainSmoothed) * (outputTrims != nullptr ? outputTrims[sample] : outputTrim);
+
         for (int ch = 0; ch < numChannels; ++ch)
         {
             auto& state = channelStates[ch];
             float delayed = state.lookaheadLine.popSample (0);
-            buffer.setSample (ch, sample, delayed * gainSmoothed * outputTrim);
+            buffer.setSample (ch, sample, delayed * appliedGain);
         }
     }
+
+    bypass.end (buffer, numSamples);
+}
+
+void DYNRMSRiderAudioProcessor::updateTail()
+{
+    // The rider's gain drifts back at the slower of its two speeds.
+    const auto speed = juce::jlimit (0.0f, 1.0f, params[Param::speed]);
+    tail.setTail (0.0, gls::dsp::TailTracker::getEnvelopeRT60 ((50.0 + speed * 450.0) * 0.001));
 }
 
 void DYNRMSRiderAudioProcessor::getStateInformation (juce::MemoryBlock& destData)
@@ -175,25 +223,7 @@ void DYNRMSRiderAudioProcessor::setStateInformation (const void* data, int sizeI
 juce::AudioProcessorValueTreeState::ParameterLayout
 DYNRMSRiderAudioProcessor::createParameterLayout()
 {
-    std::vector<std::unique_ptr<juce::RangedAudioParameter>> params;
-
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("target_level", "Target Level",
-                                                                   juce::NormalisableRange<float> (-30.0f, -3.0f, 0.1f), -18.0f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("speed",        "Speed",
-                                                                   juce::NormalisableRange<float> (0.0f, 1.0f, 0.001f), 0.5f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("range",        "Range",
-                                                                   juce::NormalisableRange<float> (0.0f, 24.0f, 0.1f), 6.0f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("hf_sensitivity","HF Sensitivity",
-                                                                   juce::NormalisableRange<float> (0.0f, 1.0f, 0.001f), 0.5f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("lookahead",    "Lookahead",
-                                                                   juce::NormalisableRange<float> (0.1f, 20.0f, 0.01f, 0.35f), 5.0f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> (kParamInput,   "Input Trim",
-                                                                   juce::NormalisableRange<float> (-12.0f, 12.0f, 0.1f), 0.0f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> (kParamOutput,  "Output Trim",
-                                                                   juce::NormalisableRange<float> (-12.0f, 12.0f, 0.1f), 0.0f));
-    params.push_back (std::make_unique<juce::AudioParameterBool>  (kParamBypass,  "Soft Bypass", false));
-
-    return { params.begin(), params.end() };
+    return gls::createParameterLayout (parameterTable);
 }
 
 DYNRMSRiderAudioProcessorEditor::DYNRMSRiderAudioProcessorEditor (DYNRMSRiderAudioProcessor& p)
@@ -219,6 +249,7 @@ DYNRMSRiderAudioProcessorEditor::DYNRMSRiderAudioProcessorEditor (DYNRMSRiderAud
     make (inputTrimSlider,     "Input");
     make (outputTrimSlider,    "Output");
     initToggle (bypassButton);
+    initToggle (fixedLatencyButton);
 
     auto& state = processorRef.getValueTreeState();
     const juce::StringArray ids { "target_level", "speed", "range", "hf_sensitivity", "lookahead", kParamInput, kParamOutput };
@@ -227,6 +258,7 @@ DYNRMSRiderAudioProcessorEditor::DYNRMSRiderAudioProcessorEditor (DYNRMSRiderAud
     for (int i = 0; i < ids.size(); ++i)
         attachments.push_back (std::make_unique<SliderAttachment> (state, ids[i], *sliders[i]));
     buttonAttachments.push_back (std::make_unique<ButtonAttachment> (state, kParamBypass, bypassButton));
+    buttonAttachments.push_back (std::make_unique<ButtonAttachment> (state, kParamFixedLatency, fixedLatencyButton));
 
     setSize (820, 420);
 }
@@ -297,7 +329,9 @@ void DYNRMSRiderAudioProcessorEditor::resized()
     inputTrimSlider    .setBounds (bottomRow.removeFromLeft (bottomWidth).reduced (8));
     outputTrimSlider   .setBounds (bottomRow.removeFromLeft (bottomWidth).reduced (8));
 
-    bypassButton.setBounds (footerComponent.getBounds().reduced (24, 12));
+    auto footer = footerComponent.getBounds().reduced (24, 12);
+    bypassButton.setBounds (footer.removeFromLeft (140));
+    fixedLatencyButton.setBounds (footer.removeFromRight (140));
     layoutLabels();
 }
 
@@ -367,6 +401,22 @@ void DYNRMSRiderAudioProcessor::ensureStateSize (int requiredChannels)
     }
 }
 
+void DYNRMSRiderAudioProcessor::updateLatency (float lookaheadMs, bool fixedLatency)
+{
+    const auto lookaheadSamples = juce::roundToInt (lookaheadMs * 0.001 * currentSampleRate);
+
+    latency.setMode (fixedLatency ? gls::dsp::LatencyReporter::Mode::fixed
+                                  : gls::dsp::LatencyReporter::Mode::tracking);
+    latency.setStage (0, lookaheadSamples, maxLookaheadSamples);
+    latency.update();
+
+    for (auto& state : channelStates)
+        state.lookaheadLine.setDelay ((float) latency.getStageDelay (0));
+
+    gainDelay.setDelay (latency.getStagePadding (0));
+    bypass.setLatency (latency.getTotalLatency());
+}
+
 juce::AudioProcessor* JUCE_CALLTYPE createPluginFilter()
 {
     return new DYNRMSRiderAudioProcessor();
@@ -2,6 +2,10 @@
 
 #include <JuceHeader.h>
 #include "../../DualPrecisionAudioProcessor.h"
+#include "../../ParameterTable.h"
+#include "../../SmoothedParameter.h"
+#include "../../dsp/LatencyReporter.h"
+#include "../../dsp/SoftBypass.h"
 #include "../../ui/GoodluckLookAndFeel.h"
 #include <array>
 #include <vector>
@@ -9,12 +13,18 @@
 class DYNRMSRiderAudioProcessor : public DualPrecisionAudioProcessor
 {
 public:
+    enum class Param
+    {
+        targetLevel, speed, range, hfSensitivity, lookahead, inputTrim, outputTrim,
+        bypass, fixedLatency,
+        count
+    };
+
     DYNRMSRiderAudioProcessor();
     ~DYNRMSRiderAudioProcessor() override = default;
 
     void prepareToPlay (double sampleRate, int samplesPerBlock) override;
     void releaseResources() override;
-    void processBlock (juce::AudioBuffer<float>&, juce::MidiBuffer&) override;
 
     juce::AudioProcessorEditor* createEditor() override;
     bool hasEditor() const override { return true; }
@@ -23,7 +33,6 @@ public:
     bool acceptsMidi() const override { return false; }
     bool producesMidi() const override { return false; }
     bool isMidiEffect() const override { return false; }
-    double getTailLengthSeconds() const override { return 0.0; }
 
     int getNumPrograms() override;
     int getCurrentProgram() override { return currentPreset; }
@@ -37,8 +46,15 @@ public:
     juce::AudioProcessorValueTreeState& getValueTreeState() { return apvts; }
     static juce::AudioProcessorValueTreeState::ParameterLayout createParameterLayout();
 
+protected:
+    void processFloat (juce::AudioBuffer<float>&, juce::MidiBuffer&) override;
+    void updateTail() override;
+
 private:
     juce::AudioProcessorValueTreeState apvts;
+    gls::ParameterHandles<Param> params;
+    gls::SmoothedParameter inputTrimGain  { params, Param::inputTrim,   gls::SmoothedParameter::Mapping::decibels };
+    gls::SmoothedParameter outputTrimGain { params, Param::outputTrim,  gls::SmoothedParameter::Mapping::decibels };
     struct ChannelState
     {
         juce::dsp::DelayLine<float, juce::dsp::DelayLineInterpolationTypes::Linear> lookaheadLine { 48000 };
@@ -46,12 +62,17 @@ private:
     };
 
     std::vector<ChannelState> channelStates;
+    gls::dsp::LatencyReporter latency { *this };
+    gls::dsp::SoftBypass bypass;
+    gls::dsp::IntegerDelayLine gainDelay;
     double currentSampleRate = 44100.0;
     juce::uint32 lastBlockSize = 0;
+    int maxLookaheadSamples = 0;
     float gainSmoothed = 1.0f;
     int currentPreset = 0;
 
     void ensureStateSize (int requiredChannels);
+    void updateLatency (float lookaheadMs, bool fixedLatency);
     void applyPreset (int index);
 
     struct Preset
@@ -90,6 +111,7 @@ private:
     juce::Slider outputTrimSlider;
     juce::Slider inputTrimSlider;
     juce::ToggleButton bypassButton { "Soft Bypass" };
+    juce::ToggleButton fixedLatencyButton { "Fixed Latency" };
 
     using SliderAttachment = juce::AudioProcessorValueTreeState::SliderAttachment;
     using ButtonAttachment = juce::AudioProcessorValueTreeState::ButtonAttachment;
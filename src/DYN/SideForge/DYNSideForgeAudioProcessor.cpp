@@ -6,6 +6,28 @@ constexpr auto kStateId     = "SIDE_FORGE";
 constexpr auto kParamBypass = "ui_bypass";
 constexpr auto kParamInput  = "input_trim";
 constexpr auto kParamOutput = "output_trim";
+constexpr auto kParamFixedLatency = "fixed_latency";
+constexpr float kMaxLookaheadMs = 20.0f;
+
+using Param = DYNSideForgeAudioProcessor::Param;
+using Spec = gls::ParameterSpec;
+
+constexpr std::array<Spec, (size_t) Param::count> parameterTable {{
+    Spec::range  ("thresh",           "Threshold",     -48.0f,  0.0f,            0.1f,   -18.0f),
+    Spec::range  ("ratio",            "Ratio",         1.0f,    20.0f,           0.01f,  4.0f,    0.5f),
+    Spec::range  ("attack",           "Attack",        0.1f,    100.0f,          0.01f,  5.0f,    0.35f),
+    Spec::range  ("release",          "Release",       10.0f,   1000.0f,         0.01f,  200.0f,  0.35f),
+    Spec::range  ("sc_hpf",           "SC HPF",        20.0f,   400.0f,          0.01f,  80.0f,   0.35f),
+    Spec::range  ("sc_lpf",           "SC LPF",        1000.0f, 20000.0f,        0.01f,  6000.0f, 0.35f),
+    Spec::range  ("lookahead",        "Lookahead",     0.1f,    kMaxLookaheadMs, 0.01f,  2.0f,    0.35f),
+    Spec::range  ("mix",              "Mix",           0.0f,    1.0f,            0.001f, 1.0f),
+    Spec::range  (kParamInput,        "Input Trim",    -18.0f,  18.0f,           0.1f,   0.0f),
+    Spec::range  (kParamOutput,       "Output Trim",   -18.0f,  18.0f,           0.1f,   0.0f),
+    Spec::toggle (kParamBypass,       "Soft Bypass",   false),
+    Spec::toggle (kParamFixedLatency, "Fixed Latency", false)
+}};
+
+static_assert (gls::hasUniqueIds (parameterTable));
 }
 
 const std::array<DYNSideForgeAudioProcessor::Preset, 3> DYNSideForgeAudioProcessor::presetBank {{
@@ -54,25 +76,45 @@ DYNSideForgeAudioProcessor::DYNSideForgeAudioProcessor()
     : DualPrecisionAudioProcessor(BusesProperties()
                         .withInput  ("Input", juce::AudioChannelSet::stereo(), true)
                         .withOutput ("Output", juce::AudioChannelSet::stereo(), true)),
-      apvts (*this, nullptr, kStateId, createParameterLayout())
+      apvts (*this, nullptr, kStateId, createParameterLayout()),
+      params (apvts, parameterTable)
 {
+    bypass.snapOnResume ({ &inputTrimGain, &mixAmount, &outputTrimGain });
 }
 
 void DYNSideForgeAudioProcessor::prepareToPlay (double sampleRate, int samplesPerBlock)
 {
+    DualPrecisionAudioProcessor::prepareToPlay (sampleRate, samplesPerBlock);
+
     currentSampleRate = juce::jmax (sampleRate, 44100.0);
     lastBlockSize = (juce::uint32) juce::jmax (1, samplesPerBlock);
-    ensureStateSize();
+    maxLookaheadSamples = juce::roundToInt (kMaxLookaheadMs * 0.001 * currentSampleRate);
+    gainDelay.prepare (maxLookaheadSamples, 1.0f);
+    bypass.prepare (currentSampleRate, juce::jmax (getTotalNumInputChannels(), getTotalNumOutputChannels()),
+                    (int) lastBlockSize, maxLookaheadSamples);
+
+    channelStates.resize ((size_t) getTotalNumOutputChannels());
+    prepareState();
+
+    for (auto* smoother : { &inputTrimGain, &mixAmount, &outputTrimGain })
+        smoother->prepare (currentSampleRate, (int) lastBlockSize);
+
     gainSmoothed = 1.0f;
+
+    latency.invalidate();
+    updateLatency (params[Param::lookahead], params.isOn (Param::fixedLatency));
 }
 
 void DYNSideForgeAudioProcessor::releaseResources()
 {
 }
 
-void DYNSideForgeAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer,
-                                               juce::MidiBuffer&)
+void DYNSideForgeAudioProcessor::processFloat (juce::AudioBuffer<float>& buffer,
+                                               juce::MidiBuffer& midi)
 {
+    if (renderInPreparedChunks (buffer, midi))
+        return;
+
     juce::ScopedNoDenormals noDenormals;
 
     auto totalIn  = getTotalNumInputChannels();
@@ -80,41 +122,42 @@ void DYNSideForgeAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer,
     for (int ch = totalIn; ch < totalOut; ++ch)
         buffer.clear (ch, 0, buffer.getNumSamples());
 
-    auto read = [this](const char* id) { return apvts.getRawParameterValue (id)->load(); };
-
-    const auto threshDb  = read ("thresh");
-    const auto ratio     = juce::jmax (1.0f, read ("ratio"));
-    const auto attackMs  = read ("attack");
-    const auto releaseMs = read ("release");
-    const auto scHpf     = read ("sc_hpf");
-    const auto scLpf     = read ("sc_lpf");
-    const auto lookahead = read ("lookahead");
-    const auto mix       = juce::jlimit (0.0f, 1.0f, read ("mix"));
-    const auto inputGain = juce::Decibels::decibelsToGain (read (kParamInput));
-    const auto outputGain= juce::Decibels::decibelsToGain (read (kParamOutput));
-    const bool bypassed  = read (kParamBypass) > 0.5f;
+    const auto threshDb  = params[Param::thresh];
+    const auto ratio     = juce::jmax (1.0f, params[Param::ratio]);
+    const auto attackMs  = params[Param::attack];
+    const auto releaseMs = params[Param::release];
+    const auto scHpf     = params[Param::scHpf];
+    const auto scLpf     = params[Param::scLpf];
+    const auto lookahead = params[Param::lookahead];
+    const bool bypassed  = params.isOn (Param::bypass);
+    const bool fixedLatency = params.isOn (Param::fixedLatency);
 
     ensureStateSize();
-    buffer.applyGain (inputGain);
-    if (bypassed)
+    updateLatency (lookahead, fixedLatency);
+
+    const int numSamples  = buffer.getNumSamples();
+    const int numChannels = buffer.getNumChannels();
+
+    // The bypass path delays the dry signal by the same latency, so PDC holds either way.
+    if (! bypass.begin (buffer, numSamples, bypassed))
         return;
 
-    dryBuffer.makeCopyOf (buffer, true);
+    for (auto* smoother : { &inputTrimGain, &mixAmount, &outputTrimGain })
+        smoother->update();
+
+    inputTrimGain.applyGain (buffer, numSamples);
+    const auto* mixes = mixAmount.advance (numSamples);
+    const auto* outputGains = outputTrimGain.advance (numSamples);
+    const auto mix = mixAmount.getCurrentValue();
+    const auto outputGain = outputTrimGain.getCurrentValue();
 
-    scHpfFilter.coefficients = juce::dsp::IIR::Coefficients<float>::makeHighPass (currentSampleRate, scHpf);
-    scLpfFilter.coefficients = juce::dsp::IIR::Coefficients<float>::makeLowPass (currentSampleRate, scLpf);
+    scHpfFilter.setHighPass (currentSampleRate, scHpf);
+    scLpfFilter.setLowPass (currentSampleRate, scLpf);
 
     const auto attackCoeff  = std::exp (-1.0f / (attackMs * 0.001f * currentSampleRate));
     const auto releaseCoeff = std::exp (-1.0f / (releaseMs * 0.001f * currentSampleRate));
     const auto thresholdGain= juce::Decibels::decibelsToGain (threshDb);
 
-    const int numSamples  = buffer.getNumSamples();
-    const int numChannels = buffer.getNumChannels();
-    const auto delaySamples = juce::roundToInt (lookahead * 0.001f * currentSampleRate);
-
-    for (auto& state : channelStates)
-        state.lookahead.setDelay (delaySamples);
-
     for (int sample = 0; sample < numSamples; ++sample)
     {
         float scSample = 0.0f;
@@ -144,21 +187,25 @@ void DYNSideForgeAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer,
         else
             gainSmoothed = releaseCoeff * (gainSmoothed - targetGain) + targetGain;
 
+        // Dry is taken from the same delayed sample so parallel compression stays phase-aligned.
+        const float wetGain = gainDelay.process (gainSmoothed) * (outputGains != nullptr ? outputGains[sample] : outputGain);
+        const float amount = mixes != nullptr ? mixes[sample] : mix;
+        const float blend = wetGain * amount + (1.0f - amount);
+
         for (int ch = 0; ch < numChannels; ++ch)
         {
             auto& state = channelStates[ch];
             float delayed = state.lookahead.popSample (0);
-            buffer.setSample (ch, sample, delayed * gainSmoothed * outputGain);
+            buffer.setSample (ch, sample, delayed * blend);
         }
     }
 
-    for (int ch = 0; ch < numChannels; ++ch)
-    {
-        auto* wet = buffer.getWritePointer (ch);
-        const auto* dry = dryBuffer.getReadPointer (ch);
-        for (int i = 0; i < numSamples; ++i)
-            wet[i] = wet[i] * mix + dry[i] * (1.0f - mix);
-    }
+    bypass.end (buffer, numSamples);
+}
+
+void DYNSideForgeAudioProcessor::updateTail()
+{
+    tail.setTail (0.0, gls::dsp::TailTracker::getEnvelopeRT60 (params[Param::release] * 0.001));
 }
 
 void DYNSideForgeAudioProcessor::getStateInformation (juce::MemoryBlock& destData)
@@ -179,31 +226,7 @@ void DYNSideForgeAudioProcessor::setStateInformation (const void* data, int size
 juce::AudioProcessorValueTreeState::ParameterLayout
 DYNSideForgeAudioProcessor::createParameterLayout()
 {
-    std::vector<std::unique_ptr<juce::RangedAudioParameter>> params;
-
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("thresh",  "Threshold",
-                                                                   juce::NormalisableRange<float> (-48.0f, 0.0f, 0.1f), -18.0f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("ratio",   "Ratio",
-                                                                   juce::NormalisableRange<float> (1.0f, 20.0f, 0.01f, 0.5f), 4.0f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("attack",  "Attack",
-                                                                   juce::NormalisableRange<float> (0.1f, 100.0f, 0.01f, 0.35f), 5.0f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("release", "Release",
-                                                                   juce::NormalisableRange<float> (10.0f, 1000.0f, 0.01f, 0.35f), 200.0f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("sc_hpf",  "SC HPF",
-                                                                   juce::NormalisableRange<float> (20.0f, 400.0f, 0.01f, 0.35f), 80.0f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("sc_lpf",  "SC LPF",
-                                                                   juce::NormalisableRange<float> (1000.0f, 20000.0f, 0.01f, 0.35f), 6000.0f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("lookahead","Lookahead",
-                                                                   juce::NormalisableRange<float> (0.1f, 20.0f, 0.01f, 0.35f), 2.0f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("mix",     "Mix",
-                                                                   juce::NormalisableRange<float> (0.0f, 1.0f, 0.001f), 1.0f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> (kParamInput, "Input Trim",
-                                                                   juce::NormalisableRange<float> (-18.0f, 18.0f, 0.1f), 0.0f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> (kParamOutput, "Output Trim",
-                                                                   juce::NormalisableRange<float> (-18.0f, 18.0f, 0.1f), 0.0f));
-    params.push_back (std::make_unique<juce::AudioParameterBool>  (kParamBypass, "Soft Bypass", false));
-
-    return { params.begin(), params.end() };
+    return gls::createParameterLayout (parameterTable);
 }
 
 DYNSideForgeAudioProcessorEditor::DYNSideForgeAudioProcessorEditor (DYNSideForgeAudioProcessor& p)
@@ -232,6 +255,7 @@ DYNSideForgeAudioProcessorEditor::DYNSideForgeAudioProcessorEditor (DYNSideForge
     make (inputTrimSlider,"Input");
     make (outputTrimSlider,"Output");
     initToggle (bypassButton);
+    initToggle (fixedLatencyButton);
 
     auto& state = processorRef.getValueTreeState();
     const juce::StringArray ids { "thresh", "ratio", "attack", "release", "sc_hpf", "sc_lpf", "lookahead", "mix", kParamInput, kParamOutput };
@@ -242,6 +266,7 @@ DYNSideForgeAudioProcessorEditor::DYNSideForgeAudioProcessorEditor (DYNSideForge
         attachments.push_back (std::make_unique<SliderAttachment> (state, ids[i], *sliders[i]));
 
     buttonAttachments.push_back (std::make_unique<ButtonAttachment> (state, kParamBypass, bypassButton));
+    buttonAttachments.push_back (std::make_unique<ButtonAttachment> (state, kParamFixedLatency, fixedLatencyButton));
 
     setSize (880, 420);
 }
@@ -317,7 +342,9 @@ void DYNSideForgeAudioProcessorEditor::resized()
     inputTrimSlider  .setBounds (bottom.removeFromLeft (bottomWidth).reduced (8));
 
     outputTrimSlider.setBounds (footerComponent.getBounds().withSizeKeepingCentre (120, 48));
-    bypassButton.setBounds (footerComponent.getBounds().reduced (24, 12));
+    auto footer = footerComponent.getBounds().reduced (24, 12);
+    bypassButton.setBounds (footer.removeFromLeft (140));
+    fixedLatencyButton.setBounds (footer.removeFromRight (140));
 
     layoutLabels();
 }
@@ -368,11 +395,15 @@ void DYNSideForgeAudioProcessor::applyPreset (int index)
 void DYNSideForgeAudioProcessor::ensureStateSize()
 {
     const auto requiredChannels = getTotalNumOutputChannels();
-    if (static_cast<int> (channelStates.size()) != requiredChannels)
-    {
-        channelStates.resize (requiredChannels);
-    }
+    if (static_cast<int> (channelStates.size()) == requiredChannels)
+        return;
+
+    channelStates.resize (requiredChannels);
+    prepareState();
+}
 
+void DYNSideForgeAudioProcessor::prepareState()
+{
     juce::dsp::ProcessSpec spec { currentSampleRate,
                                   lastBlockSize > 0 ? lastBlockSize : 512u,
                                   1 };
@@ -386,6 +417,24 @@ void DYNSideForgeAudioProcessor::ensureStateSize()
         state.lookahead.reset();
         state.envelope = 0.0f;
     }
+
+    gainDelay.reset (1.0f);
+}
+
+void DYNSideForgeAudioProcessor::updateLatency (float lookaheadMs, bool fixedLatency)
+{
+    const auto lookaheadSamples = juce::roundToInt (lookaheadMs * 0.001 * currentSampleRate);
+
+    latency.setMode (fixedLatency ? gls::dsp::LatencyReporter::Mode::fixed
+                                  : gls::dsp::LatencyReporter::Mode::tracking);
+    latency.setStage (0, lookaheadSamples, maxLookaheadSamples);
+    latency.update();
+
+    for (auto& state : channelStates)
+        state.lookahead.setDelay ((float) latency.getStageDelay (0));
+
+    gainDelay.setDelay (latency.getStagePadding (0));
+    bypass.setLatency (latency.getTotalLatency());
 }
 
 juce::AudioProcessor* JUCE_CALLTYPE createPluginFilter()
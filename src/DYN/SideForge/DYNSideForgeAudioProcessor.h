@@ -2,6 +2,11 @@
 
 #include <JuceHeader.h>
 #include "../../DualPrecisionAudioProcessor.h"
+#include "../../ParameterTable.h"
+#include "../../SmoothedParameter.h"
+#include "../../dsp/Biquad.h"
+#include "../../dsp/LatencyReporter.h"
+#include "../../dsp/SoftBypass.h"
 #include "../../ui/GoodluckLookAndFeel.h"
 #include <array>
 #include <vector>
@@ -9,12 +14,18 @@
 class DYNSideForgeAudioProcessor : public DualPrecisionAudioProcessor
 {
 public:
+    enum class Param
+    {
+        thresh, ratio, attack, release, scHpf, scLpf, lookahead, mix, inputTrim,
+        outputTrim, bypass, fixedLatency,
+        count
+    };
+
     DYNSideForgeAudioProcessor();
     ~DYNSideForgeAudioProcessor() override = default;
 
     void prepareToPlay (double sampleRate, int samplesPerBlock) override;
     void releaseResources() override;
-    void processBlock (juce::AudioBuffer<float>&, juce::MidiBuffer&) override;
 
     juce::AudioProcessorEditor* createEditor() override;
     bool hasEditor() const override { return true; }
@@ -23,7 +34,6 @@ public:
     bool acceptsMidi() const override { return false; }
     bool producesMidi() const override { return false; }
     bool isMidiEffect() const override { return false; }
-    double getTailLengthSeconds() const override { return 0.0; }
 
     int getNumPrograms() override;
     int getCurrentProgram() override { return currentPreset; }
@@ -37,8 +47,16 @@ public:
     juce::AudioProcessorValueTreeState& getValueTreeState() { return apvts; }
     static juce::AudioProcessorValueTreeState::ParameterLayout createParameterLayout();
 
+protected:
+    void processFloat (juce::AudioBuffer<float>&, juce::MidiBuffer&) override;
+    void updateTail() override;
+
 private:
     juce::AudioProcessorValueTreeState apvts;
+    gls::ParameterHandles<Param> params;
+    gls::SmoothedParameter inputTrimGain  { params, Param::inputTrim,   gls::SmoothedParameter::Mapping::decibels };
+    gls::SmoothedParameter mixAmount      { params, Param::mix };
+    gls::SmoothedParameter outputTrimGain { params, Param::outputTrim,  gls::SmoothedParameter::Mapping::decibels };
     struct ChannelState
     {
         juce::dsp::DelayLine<float, juce::dsp::DelayLineInterpolationTypes::Linear> lookahead { 48000 };
@@ -46,15 +64,20 @@ private:
     };
 
     std::vector<ChannelState> channelStates;
-    juce::dsp::IIR::Filter<float> scHpfFilter;
-    juce::dsp::IIR::Filter<float> scLpfFilter;
-    juce::AudioBuffer<float> dryBuffer;
+    gls::dsp::Biquad scHpfFilter;
+    gls::dsp::Biquad scLpfFilter;
+    gls::dsp::LatencyReporter latency { *this };
+    gls::dsp::SoftBypass bypass;
+    gls::dsp::IntegerDelayLine gainDelay;
     double currentSampleRate = 44100.0;
     juce::uint32 lastBlockSize = 512;
+    int maxLookaheadSamples = 0;
     float gainSmoothed = 1.0f;
     int currentPreset = 0;
 
     void ensureStateSize();
+    void prepareState();
+    void updateLatency (float lookaheadMs, bool fixedLatency);
     void applyPreset (int index);
 
     struct Preset
@@ -96,6 +119,7 @@ private:
     juce::Slider inputTrimSlider;
     juce::Slider outputTrimSlider;
     juce::ToggleButton bypassButton { "Soft Bypass" };
+    juce::ToggleButton fixedLatencyButton { "Fixed Latency" };
 
     using SliderAttachment = juce::AudioProcessorValueTreeState::SliderAttachment;
     using ButtonAttachment = juce::AudioProcessorValueTreeState::ButtonAttachment;
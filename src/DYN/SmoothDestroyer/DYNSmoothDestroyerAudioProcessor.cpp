@@ -6,6 +6,28 @@ constexpr auto kStateId     = "SMOOTH_DESTROYER";
 constexpr auto kParamBypass = "ui_bypass";
 constexpr auto kParamInput  = "input_trim";
 constexpr auto kParamOutput = "output_trim";
+
+using Param = DYNSmoothDestroyerAudioProcessor::Param;
+using Spec = gls::ParameterSpec;
+
+constexpr std::array<Spec, (size_t) Param::count> parameterTable {{
+    Spec::range  ("band1_freq",     "Band1 Freq",     40.0f,  8000.0f,  0.01f,  250.0f,  0.4f),
+    Spec::range  ("band1_q",        "Band1 Q",        0.1f,   10.0f,    0.001f, 1.2f,    0.5f),
+    Spec::range  ("band1_thresh",   "Band1 Thresh",   -60.0f, 0.0f,     0.1f,   -30.0f),
+    Spec::range  ("band1_range",    "Band1 Range",    -24.0f, 24.0f,    0.1f,   -6.0f),
+    Spec::range  ("band2_freq",     "Band2 Freq",     200.0f, 18000.0f, 0.01f,  4000.0f, 0.4f),
+    Spec::range  ("band2_q",        "Band2 Q",        0.1f,   10.0f,    0.001f, 1.2f,    0.5f),
+    Spec::range  ("band2_thresh",   "Band2 Thresh",   -60.0f, 0.0f,     0.1f,   -30.0f),
+    Spec::range  ("band2_range",    "Band2 Range",    -24.0f, 24.0f,    0.1f,   -6.0f),
+    Spec::range  ("global_attack",  "Global Attack",  1.0f,   200.0f,   0.01f,  15.0f,   0.3f),
+    Spec::range  ("global_release", "Global Release", 5.0f,   1000.0f,  0.01f,  150.0f,  0.3f),
+    Spec::range  ("mix",            "Mix",            0.0f,   1.0f,     0.001f, 1.0f),
+    Spec::range  (kParamInput,      "Input Trim",     -18.0f, 18.0f,    0.1f,   0.0f),
+    Spec::range  (kParamOutput,     "Output Trim",    -18.0f, 18.0f,    0.1f,   0.0f),
+    Spec::toggle (kParamBypass,     "Soft Bypass",    false)
+}};
+
+static_assert (gls::hasUniqueIds (parameterTable));
 }
 
 const std::array<DYNSmoothDestroyerAudioProcessor::Preset, 3> DYNSmoothDestroyerAudioProcessor::presetBank {{
@@ -63,12 +85,16 @@ DYNSmoothDestroyerAudioProcessor::DYNSmoothDestroyerAudioProcessor()
     : DualPrecisionAudioProcessor (BusesProperties()
                         .withInput  ("Input", juce::AudioChannelSet::stereo(), true)
                         .withOutput ("Output", juce::AudioChannelSet::stereo(), true)),
-      apvts (*this, nullptr, kStateId, createParameterLayout())
+      apvts (*this, nullptr, kStateId, createParameterLayout()),
+      params (apvts, parameterTable)
 {
+    bypass.snapOnResume (dryWet);
 }
 
 void DYNSmoothDestroyerAudioProcessor::prepareToPlay (double sampleRate, int samplesPerBlock)
 {
+    DualPrecisionAudioProcessor::prepareToPlay (sampleRate, samplesPerBlock);
+
     currentSampleRate = juce::jmax (sampleRate, 44100.0);
     lastBlockSize = (juce::uint32) juce::jmax (1, samplesPerBlock);
     ensureStateSize();
@@ -79,15 +105,24 @@ void DYNSmoothDestroyerAudioProcessor::prepareToPlay (double sampleRate, int sam
             band.envelope = 0.0f;
             band.gain = 1.0f;
         }
+
+    for (auto* smoother : { &inputTrimGain, &mixAmount, &outputTrimGain })
+        smoother->prepare (sampleRate, samplesPerBlock);
+
+    dryWet.prepare (sampleRate, juce::jmax (getTotalNumInputChannels(), getTotalNumOutputChannels()), samplesPerBlock);
+    bypass.prepare (sampleRate, juce::jmax (getTotalNumInputChannels(), getTotalNumOutputChannels()), samplesPerBlock);
 }
 
 void DYNSmoothDestroyerAudioProcessor::releaseResources()
 {
 }
 
-void DYNSmoothDestroyerAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer,
-                                                     juce::MidiBuffer&)
+void DYNSmoothDestroyerAudioProcessor::processFloat (juce::AudioBuffer<float>& buffer,
+                                                     juce::MidiBuffer& midi)
 {
+    if (renderInPreparedChunks (buffer, midi))
+        return;
+
     juce::ScopedNoDenormals noDenormals;
 
     const auto totalIn  = getTotalNumInputChannels();
@@ -95,30 +130,23 @@ void DYNSmoothDestroyerAudioProcessor::processBlock (juce::AudioBuffer<float>& b
     for (int ch = totalIn; ch < totalOut; ++ch)
         buffer.clear (ch, 0, buffer.getNumSamples());
 
-    auto read = [this](const char* id) { return apvts.getRawParameterValue (id)->load(); };
-
-    const auto b1Freq    = read ("band1_freq");
-    const auto b1Q       = read ("band1_q");
-    const auto b1Thresh  = read ("band1_thresh");
-    const auto b1Range   = read ("band1_range");
-    const auto b2Freq    = read ("band2_freq");
-    const auto b2Q       = read ("band2_q");
-    const auto b2Thresh  = read ("band2_thresh");
-    const auto b2Range   = read ("band2_range");
-    const auto attackMs  = read ("global_attack");
-    const auto releaseMs = read ("global_release");
-    const auto mix       = juce::jlimit (0.0f, 1.0f, read ("mix"));
-    const auto inputGain = juce::Decibels::decibelsToGain (read (kParamInput));
-    const auto outputGain= juce::Decibels::decibelsToGain (read (kParamOutput));
-    const bool bypassed  = read (kParamBypass) > 0.5f;
-
-    ensureStateSize();
-    buffer.applyGain (inputGain);
-
-    if (bypassed)
+    const auto b1Freq    = params[Param::band1Freq];
+    const auto b1Q       = params[Param::band1Q];
+    const auto b1Thresh  = params[Param::band1Thresh];
+    const auto b1Range   = params[Param::band1Range];
+    const auto b2Freq    = params[Param::band2Freq];
+    const auto b2Q       = params[Param::band2Q];
+    const auto b2Thresh  = params[Param::band2Thresh];
+    const auto b2Range   = params[Param::band2Range];
+    const auto attackMs  = params[Param::globalAttack];
+    const auto releaseMs = params[Param::globalRelease];
+    const bool bypassed  = params.isOn (Param::bypass);
+
+    if (! bypass.begin (buffer, buffer.getNumSamples(), bypassed))
         return;
 
-    dryBuffer.makeCopyOf (buffer, true);
+    ensureStateSize();
+    dryWet.begin (buffer, buffer.getNumSamples(), inputTrimGain, mixAmount);
 
     const auto attackCoeff  = std::exp (-1.0f / (attackMs * 0.001f * currentSampleRate));
     const auto releaseCoeff = std::exp (-1.0f / (releaseMs * 0.001f * currentSampleRate));
@@ -165,13 +193,14 @@ void DYNSmoothDestroyerAudioProcessor::processBlock (juce::AudioBuffer<float>& b
         }
     }
 
-    for (int ch = 0; ch < numChannels; ++ch)
-    {
-        auto* wet = buffer.getWritePointer (ch);
-        const auto* dry = dryBuffer.getReadPointer (ch);
-        for (int i = 0; i < numSamples; ++i)
-            wet[i] = (wet[i] * mix + dry[i] * (1.0f - mix)) * outputGain;
-    }
+    dryWet.end (buffer, numSamples, mixAmount, outputTrimGain);
+
+    bypass.end (buffer, numSamples);
+}
+
+void DYNSmoothDestroyerAudioProcessor::updateTail()
+{
+    tail.setTail (0.0, gls::dsp::TailTracker::getEnvelopeRT60 (params[Param::globalRelease] * 0.001));
 }
 
 void DYNSmoothDestroyerAudioProcessor::getStateInformation (juce::MemoryBlock& destData)
@@ -192,38 +221,7 @@ void DYNSmoothDestroyerAudioProcessor::setStateInformation (const void* data, in
 juce::AudioProcessorValueTreeState::ParameterLayout
 DYNSmoothDestroyerAudioProcessor::createParameterLayout()
 {
-    using AP = juce::AudioParameterFloat;
-    std::vector<std::unique_ptr<juce::RangedAudioParameter>> params;
-
-    params.push_back (std::make_unique<AP> ("band1_freq",   "Band1 Freq",
-                                            juce::NormalisableRange<float> (40.0f, 8000.0f, 0.01f, 0.4f), 250.0f));
-    params.push_back (std::make_unique<AP> ("band1_q",      "Band1 Q",
-                                            juce::NormalisableRange<float> (0.1f, 10.0f, 0.001f, 0.5f), 1.2f));
-    params.push_back (std::make_unique<AP> ("band1_thresh", "Band1 Thresh",
-                                            juce::NormalisableRange<float> (-60.0f, 0.0f, 0.1f), -30.0f));
-    params.push_back (std::make_unique<AP> ("band1_range",  "Band1 Range",
-                                            juce::NormalisableRange<float> (-24.0f, 24.0f, 0.1f), -6.0f));
-    params.push_back (std::make_unique<AP> ("band2_freq",   "Band2 Freq",
-                                            juce::NormalisableRange<float> (200.0f, 18000.0f, 0.01f, 0.4f), 4000.0f));
-    params.push_back (std::make_unique<AP> ("band2_q",      "Band2 Q",
-                                            juce::NormalisableRange<float> (0.1f, 10.0f, 0.001f, 0.5f), 1.2f));
-    params.push_back (std::make_unique<AP> ("band2_thresh", "Band2 Thresh",
-                                            juce::NormalisableRange<float> (-60.0f, 0.0f, 0.1f), -30.0f));
-    params.push_back (std::make_unique<AP> ("band2_range",  "Band2 Range",
-                                            juce::NormalisableRange<float> (-24.0f, 24.0f, 0.1f), -6.0f));
-    params.push_back (std::make_unique<AP> ("global_attack","Global Attack",
-                                            juce::NormalisableRange<float> (1.0f, 200.0f, 0.01f, 0.3f), 15.0f));
-    params.push_back (std::make_unique<AP> ("global_release","Global Release",
-                                            juce::NormalisableRange<float> (5.0f, 1000.0f, 0.01f, 0.3f), 150.0f));
-    params.push_back (std::make_unique<AP> ("mix",          "Mix",
-                                            juce::NormalisableRange<float> (0.0f, 1.0f, 0.001f), 1.0f));
-    params.push_back (std::make_unique<AP> (kParamInput,    "Input Trim",
-                                            juce::NormalisableRange<float> (-18.0f, 18.0f, 0.1f), 0.0f));
-    params.push_back (std::make_unique<AP> (kParamOutput,   "Output Trim",
-                                            juce::NormalisableRange<float> (-18.0f, 18.0f, 0.1f), 0.0f));
-    params.push_back (std::make_unique<juce::AudioParameterBool> (kParamBypass, "Soft Bypass", false));
-
-    return { params.begin(), params.end() };
+    return gls::createParameterLayout (parameterTable);
 }
 
 DYNSmoothDestroyerAudioProcessorEditor::DYNSmoothDestroyerAudioProcessorEditor (DYNSmoothDestroyerAudioProcessor& p)
@@ -382,8 +380,7 @@ void DYNSmoothDestroyerAudioProcessor::updateBandCoefficients (DynamicBand& band
     if (currentSampleRate <= 0.0)
         return;
 
-    auto coeffs = juce::dsp::IIR::Coefficients<float>::makeBandPass (currentSampleRate, freq, q);
-    band.bandFilter.coefficients = coeffs;
+    band.bandFilter.setBandPass (currentSampleRate, freq, q);
 }
 
 float DYNSmoothDestroyerAudioProcessor::computeBandGain (float levelDb, float threshDb, float rangeDb) const
@@ -2,6 +2,11 @@
 
 #include <JuceHeader.h>
 #include "../../DualPrecisionAudioProcessor.h"
+#include "../../ParameterTable.h"
+#include "../../SmoothedParameter.h"
+#include "../../dsp/Biquad.h"
+#include "../../dsp/DryWetStage.h"
+#include "../../dsp/SoftBypass.h"
 #include "../../ui/GoodluckLookAndFeel.h"
 #include <array>
 #include <vector>
@@ -9,12 +14,18 @@
 class DYNSmoothDestroyerAudioProcessor : public DualPrecisionAudioProcessor
 {
 public:
+    enum class Param
+    {
+        band1Freq, band1Q, band1Thresh, band1Range, band2Freq, band2Q, band2Thresh,
+        band2Range, globalAttack, globalRelease, mix, inputTrim, outputTrim, bypass,
+        count
+    };
+
     DYNSmoothDestroyerAudioProcessor();
     ~DYNSmoothDestroyerAudioProcessor() override = default;
 
     void prepareToPlay (double sampleRate, int samplesPerBlock) override;
     void releaseResources() override;
-    void processBlock (juce::AudioBuffer<float>&, juce::MidiBuffer&) override;
 
     juce::AudioProcessorEditor* createEditor() override;
     bool hasEditor() const override { return true; }
@@ -23,7 +34,6 @@ public:
     bool acceptsMidi() const override { return false; }
     bool producesMidi() const override { return false; }
     bool isMidiEffect() const override { return false; }
-    double getTailLengthSeconds() const override { return 0.0; }
 
     int getNumPrograms() override;
     int getCurrentProgram() override { return currentPreset; }
@@ -37,18 +47,27 @@ public:
     juce::AudioProcessorValueTreeState& getValueTreeState() { return apvts; }
     static juce::AudioProcessorValueTreeState::ParameterLayout createParameterLayout();
 
+protected:
+    void processFloat (juce::AudioBuffer<float>&, juce::MidiBuffer&) override;
+    void updateTail() override;
+
 private:
     juce::AudioProcessorValueTreeState apvts;
+    gls::ParameterHandles<Param> params;
+    gls::SmoothedParameter inputTrimGain  { params, Param::inputTrim,  gls::SmoothedParameter::Mapping::decibels };
+    gls::SmoothedParameter mixAmount      { params, Param::mix };
+    gls::SmoothedParameter outputTrimGain { params, Param::outputTrim, gls::SmoothedParameter::Mapping::decibels };
+    gls::dsp::SoftBypass bypass;
     struct DynamicBand
     {
-        juce::dsp::IIR::Filter<float> bandFilter;
+        gls::dsp::Biquad bandFilter;
         float envelope = 0.0f;
         float gain = 1.0f;
     };
 
     std::vector<DynamicBand> band1States;
     std::vector<DynamicBand> band2States;
-    juce::AudioBuffer<float> dryBuffer;
+    gls::dsp::DryWetStage dryWet;
     double currentSampleRate = 44100.0;
     juce::uint32 lastBlockSize = 512;
     int currentPreset = 0;
@@ -6,6 +6,23 @@ constexpr auto kStateId     = "TRANS_FIX";
 constexpr auto kParamBypass = "ui_bypass";
 constexpr auto kParamInput  = "input_trim";
 constexpr auto kParamOutput = "output_trim";
+
+using Param = DYNTransFixAudioProcessor::Param;
+using Spec = gls::ParameterSpec;
+
+constexpr std::array<Spec, (size_t) Param::count> parameterTable {{
+    Spec::range  ("attack",      "Attack",      -12.0f, 12.0f,   0.1f,   0.0f),
+    Spec::range  ("sustain",     "Sustain",     -12.0f, 12.0f,   0.1f,   0.0f),
+    Spec::range  ("tilt_freq",   "Tilt Freq",   100.0f, 8000.0f, 0.01f,  1200.0f, 0.4f),
+    Spec::range  ("tilt_amount", "Tilt Amount", -1.0f,  1.0f,    0.001f, 0.0f),
+    Spec::choice ("detect_mode", "Detect Mode", "Wideband|HF Focus|LF Focus", 0),
+    Spec::range  ("mix",         "Mix",         0.0f,   1.0f,    0.001f, 1.0f),
+    Spec::range  (kParamInput,   "Input Trim",  -18.0f, 18.0f,   0.1f,   0.0f),
+    Spec::range  (kParamOutput,  "Output Trim", -18.0f, 18.0f,   0.1f,   0.0f),
+    Spec::toggle (kParamBypass,  "Soft Bypass", false)
+}};
+
+static_assert (gls::hasUniqueIds (parameterTable));
 }
 
 const std::array<DYNTransFixAudioProcessor::Preset, 3> DYNTransFixAudioProcessor::presetBank {{
@@ -48,12 +65,16 @@ DYNTransFixAudioProcessor::DYNTransFixAudioProcessor()
     : DualPrecisionAudioProcessor(BusesProperties()
                         .withInput  ("Input", juce::AudioChannelSet::stereo(), true)
                         .withOutput ("Output", juce::AudioChannelSet::stereo(), true)),
-      apvts (*this, nullptr, kStateId, createParameterLayout())
+      apvts (*this, nullptr, kStateId, createParameterLayout()),
+      params (apvts, parameterTable)
 {
+    bypass.snapOnResume (dryWet);
 }
 
 void DYNTransFixAudioProcessor::prepareToPlay (double sampleRate, int samplesPerBlock)
 {
+    DualPrecisionAudioProcessor::prepareToPlay (sampleRate, samplesPerBlock);
+
     currentSampleRate = sampleRate > 0.0 ? sampleRate : 44100.0;
     lastBlockSize = (juce::uint32) juce::jmax (1, samplesPerBlock);
     ensureStateSize();
@@ -65,15 +86,24 @@ void DYNTransFixAudioProcessor::prepareToPlay (double sampleRate, int samplesPer
         state.hfFilter.reset();
         state.lfFilter.reset();
     }
+
+    for (auto* smoother : { &inputTrimGain, &mixAmount, &outputTrimGain })
+        smoother->prepare (sampleRate, samplesPerBlock);
+
+    dryWet.prepare (sampleRate, juce::jmax (getTotalNumInputChannels(), getTotalNumOutputChannels()), samplesPerBlock);
+    bypass.prepare (sampleRate, juce::jmax (getTotalNumInputChannels(), getTotalNumOutputChannels()), samplesPerBlock);
 }
 
 void DYNTransFixAudioProcessor::releaseResources()
 {
 }
 
-void DYNTransFixAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer,
-                                              juce::MidiBuffer&)
+void DYNTransFixAudioProcessor::processFloat (juce::AudioBuffer<float>& buffer,
+                                              juce::MidiBuffer& midi)
 {
+    if (renderInPreparedChunks (buffer, midi))
+        return;
+
     juce::ScopedNoDenormals noDenormals;
 
     auto totalIn  = getTotalNumInputChannels();
@@ -81,28 +111,22 @@ void DYNTransFixAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer,
     for (int ch = totalIn; ch < totalOut; ++ch)
         buffer.clear (ch, 0, buffer.getNumSamples());
 
-    auto read = [this](const char* id) { return apvts.getRawParameterValue (id)->load(); };
+    const auto attackGain   = juce::Decibels::decibelsToGain (params[Param::attack]);
+    const auto sustainGain  = juce::Decibels::decibelsToGain (params[Param::sustain]);
+    const auto tiltFreq     = params[Param::tiltFreq];
+    const auto tiltAmount   = params[Param::tiltAmount];
+    const int detectMode    = params.getIndex (Param::detectMode);
+    const bool bypassed     = params.isOn (Param::bypass);
 
-    const auto attackGain   = juce::Decibels::decibelsToGain (read ("attack"));
-    const auto sustainGain  = juce::Decibels::decibelsToGain (read ("sustain"));
-    const auto tiltFreq     = read ("tilt_freq");
-    const auto tiltAmount   = read ("tilt_amount");
-    const int detectMode    = static_cast<int> (apvts.getRawParameterValue ("detect_mode")->load());
-    const auto mix          = juce::jlimit (0.0f, 1.0f, read ("mix"));
-    const auto inputGain    = juce::Decibels::decibelsToGain (read (kParamInput));
-    const auto outputGain   = juce::Decibels::decibelsToGain (read (kParamOutput));
-    const bool bypassed     = read (kParamBypass) > 0.5f;
+    if (! bypass.begin (buffer, buffer.getNumSamples(), bypassed))
+        return;
 
     lastBlockSize = (juce::uint32) juce::jmax (1, buffer.getNumSamples());
     ensureStateSize();
-    buffer.applyGain (inputGain);
-    if (bypassed)
-        return;
-
-    dryBuffer.makeCopyOf (buffer);
+    dryWet.begin (buffer, buffer.getNumSamples(), inputTrimGain, mixAmount);
 
     const auto attackCoeff  = std::exp (-1.0f / (0.001f * currentSampleRate));
-    const auto sustainCoeff = std::exp (-1.0f / (0.01f * currentSampleRate));
+    const auto sustainCoeff = std::exp (-1.0f / (sustainSeconds * currentSampleRate));
 
     const int numSamples = buffer.getNumSamples();
     const int numChannels = buffer.getNumChannels();
@@ -137,13 +161,15 @@ void DYNTransFixAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer,
         }
     }
 
-    for (int ch = 0; ch < numChannels; ++ch)
-    {
-        auto* wet = buffer.getWritePointer (ch);
-        const auto* dry = dryBuffer.getReadPointer (ch);
-        for (int i = 0; i < numSamples; ++i)
-            wet[i] = (wet[i] * mix + dry[i] * (1.0f - mix)) * outputGain;
-    }
+    dryWet.end (buffer, numSamples, mixAmount, outputTrimGain);
+
+    bypass.end (buffer, numSamples);
+}
+
+void DYNTransFixAudioProcessor::updateTail()
+{
+    // The shaper is only neutral again once the detector has fallen back to silence.
+    tail.setTail (0.0, gls::dsp::TailTracker::getEnvelopeRT60 (sustainSeconds));
 }
 
 void DYNTransFixAudioProcessor::getStateInformation (juce::MemoryBlock& destData)
@@ -164,27 +190,7 @@ void DYNTransFixAudioProcessor::setStateInformation (const void* data, int sizeI
 juce::AudioProcessorValueTreeState::ParameterLayout
 DYNTransFixAudioProcessor::createParameterLayout()
 {
-    std::vector<std::unique_ptr<juce::RangedAudioParameter>> params;
-
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("attack",     "Attack",
-                                                                   juce::NormalisableRange<float> (-12.0f, 12.0f, 0.1f), 0.0f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("sustain",    "Sustain",
-                                                                   juce::NormalisableRange<float> (-12.0f, 12.0f, 0.1f), 0.0f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("tilt_freq",  "Tilt Freq",
-                                                                   juce::NormalisableRange<float> (100.0f, 8000.0f, 0.01f, 0.4f), 1200.0f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("tilt_amount","Tilt Amount",
-                                                                   juce::NormalisableRange<float> (-1.0f, 1.0f, 0.001f), 0.0f));
-    params.push_back (std::make_unique<juce::AudioParameterChoice> ("detect_mode","Detect Mode",
-                                                                    juce::StringArray { "Wideband", "HF Focus", "LF Focus" }, 0));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("mix",        "Mix",
-                                                                   juce::NormalisableRange<float> (0.0f, 1.0f, 0.001f), 1.0f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> (kParamInput,  "Input Trim",
-                                                                   juce::NormalisableRange<float> (-18.0f, 18.0f, 0.1f), 0.0f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> (kParamOutput, "Output Trim",
-                                                                   juce::NormalisableRange<float> (-18.0f, 18.0f, 0.1f), 0.0f));
-    params.push_back (std::make_unique<juce::AudioParameterBool>  (kParamBypass, "Soft Bypass", false));
-
-    return { params.begin(), params.end() };
+    return gls::createParameterLayout (parameterTable);
 }
 
 DYNTransFixAudioProcessorEditor::DYNTransFixAudioProcessorEditor (DYNTransFixAudioProcessor& p)
@@ -306,7 +312,6 @@ void DYNTransFixAudioProcessor::ensureStateSize()
     if (requiredChannels <= 0)
     {
         channelStates.clear();
-        dryBuffer.setSize (0, 0);
         return;
     }
 
@@ -322,11 +327,9 @@ void DYNTransFixAudioProcessor::ensureStateSize()
     {
         state.hfFilter.prepare (spec);
         state.lfFilter.prepare (spec);
-        state.hfFilter.coefficients = juce::dsp::IIR::Coefficients<float>::makeHighPass (currentSampleRate, 2000.0f);
-        state.lfFilter.coefficients = juce::dsp::IIR::Coefficients<float>::makeLowPass (currentSampleRate, 500.0f);
+        state.hfFilter.setHighPass (currentSampleRate, 2000.0f);
+        state.lfFilter.setLowPass (currentSampleRate, 500.0f);
     }
-
-    dryBuffer.setSize (requiredChannels, (int) (lastBlockSize > 0 ? lastBlockSize : 512u), false, false, true);
 }
 
 float DYNTransFixAudioProcessor::applyTilt (float sample, float freq, float amount)
@@ -2,6 +2,11 @@
 
 #include <JuceHeader.h>
 #include "../../DualPrecisionAudioProcessor.h"
+#include "../../ParameterTable.h"
+#include "../../SmoothedParameter.h"
+#include "../../dsp/Biquad.h"
+#include "../../dsp/DryWetStage.h"
+#include "../../dsp/SoftBypass.h"
 #include "../../ui/GoodluckLookAndFeel.h"
 #include <array>
 #include <vector>
@@ -9,12 +14,18 @@
 class DYNTransFixAudioProcessor : public DualPrecisionAudioProcessor
 {
 public:
+    enum class Param
+    {
+        attack, sustain, tiltFreq, tiltAmount, detectMode, mix, inputTrim, outputTrim,
+        bypass,
+        count
+    };
+
     DYNTransFixAudioProcessor();
     ~DYNTransFixAudioProcessor() override = default;
 
     void prepareToPlay (double sampleRate, int samplesPerBlock) override;
     void releaseResources() override;
-    void processBlock (juce::AudioBuffer<float>&, juce::MidiBuffer&) override;
 
     juce::AudioProcessorEditor* createEditor() override;
     bool hasEditor() const override { return true; }
@@ -23,7 +34,6 @@ public:
     bool acceptsMidi() const override { return false; }
     bool producesMidi() const override { return false; }
     bool isMidiEffect() const override { return false; }
-    double getTailLengthSeconds() const override { return 0.0; }
 
     int getNumPrograms() override;
     int getCurrentProgram() override { return currentPreset; }
@@ -37,21 +47,31 @@ public:
     juce::AudioProcessorValueTreeState& getValueTreeState() { return apvts; }
     static juce::AudioProcessorValueTreeState::ParameterLayout createParameterLayout();
 
+protected:
+    void processFloat (juce::AudioBuffer<float>&, juce::MidiBuffer&) override;
+    void updateTail() override;
+
 private:
     juce::AudioProcessorValueTreeState apvts;
+    gls::ParameterHandles<Param> params;
+    static constexpr float sustainSeconds = 0.01f;
+    gls::SmoothedParameter inputTrimGain  { params, Param::inputTrim,  gls::SmoothedParameter::Mapping::decibels };
+    gls::SmoothedParameter mixAmount      { params, Param::mix };
+    gls::SmoothedParameter outputTrimGain { params, Param::outputTrim, gls::SmoothedParameter::Mapping::decibels };
+    gls::dsp::SoftBypass bypass;
     struct ChannelState
     {
         float detector = 0.0f;
         float attackEnv = 0.0f;
         float sustainEnv = 0.0f;
-        juce::dsp::IIR::Filter<float> hfFilter;
-        juce::dsp::IIR::Filter<float> lfFilter;
+        gls::dsp::Biquad hfFilter;
+        gls::dsp::Biquad lfFilter;
     };
 
     std::vector<ChannelState> channelStates;
     double currentSampleRate = 44100.0;
     juce::uint32 lastBlockSize = 512;
-    juce::AudioBuffer<float> dryBuffer;
+    gls::dsp::DryWetStage dryWet;
     int currentPreset = 0;
 
     void ensureStateSize();
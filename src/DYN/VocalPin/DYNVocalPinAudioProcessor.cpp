@@ -6,6 +6,24 @@ constexpr auto kStateId     = "VOCAL_PIN";
 constexpr auto kParamBypass = "ui_bypass";
 constexpr auto kParamInput  = "input_trim";
 constexpr auto kParamOutput = "output_trim";
+
+using Param = DYNVocalPinAudioProcessor::Param;
+using Spec = gls::ParameterSpec;
+
+constexpr std::array<Spec, (size_t) Param::count> parameterTable {{
+    Spec::range  ("thresh",       "Threshold",    -48.0f,  0.0f,     0.1f,   -18.0f),
+    Spec::range  ("ratio",        "Ratio",        1.0f,    12.0f,    0.01f,  4.0f,    0.5f),
+    Spec::range  ("attack",       "Attack",       0.1f,    100.0f,   0.01f,  5.0f,    0.35f),
+    Spec::range  ("release",      "Release",      10.0f,   600.0f,   0.01f,  150.0f,  0.35f),
+    Spec::range  ("deess_freq",   "DeEss Freq",   2000.0f, 12000.0f, 0.01f,  6000.0f, 0.35f),
+    Spec::range  ("deess_amount", "DeEss Amount", 0.0f,    1.0f,     0.001f, 0.5f),
+    Spec::range  ("mix",          "Mix",          0.0f,    1.0f,     0.001f, 1.0f),
+    Spec::range  (kParamInput,    "Input Trim",   -18.0f,  18.0f,    0.1f,   0.0f),
+    Spec::range  (kParamOutput,   "Output Trim",  -18.0f,  18.0f,    0.1f,   0.0f),
+    Spec::toggle (kParamBypass,   "Soft Bypass",  false)
+}};
+
+static_assert (gls::hasUniqueIds (parameterTable));
 }
 
 const std::array<DYNVocalPinAudioProcessor::Preset, 3> DYNVocalPinAudioProcessor::presetBank {{
@@ -51,25 +69,38 @@ DYNVocalPinAudioProcessor::DYNVocalPinAudioProcessor()
     : DualPrecisionAudioProcessor (BusesProperties()
                         .withInput  ("Input", juce::AudioChannelSet::stereo(), true)
                         .withOutput ("Output", juce::AudioChannelSet::stereo(), true)),
-      apvts (*this, nullptr, kStateId, createParameterLayout())
+      apvts (*this, nullptr, kStateId, createParameterLayout()),
+      params (apvts, parameterTable)
 {
+    bypass.snapOnResume (dryWet);
 }
 
 void DYNVocalPinAudioProcessor::prepareToPlay (double sampleRate, int samplesPerBlock)
 {
+    DualPrecisionAudioProcessor::prepareToPlay (sampleRate, samplesPerBlock);
+
     currentSampleRate = juce::jmax (sampleRate, 44100.0);
     lastBlockSize = (juce::uint32) juce::jmax (1, samplesPerBlock);
     ensureStateSize (getTotalNumOutputChannels());
     updateDeEssFilters (6000.0f);
+
+    for (auto* smoother : { &inputTrimGain, &mixAmount, &outputTrimGain })
+        smoother->prepare (sampleRate, samplesPerBlock);
+
+    dryWet.prepare (sampleRate, juce::jmax (getTotalNumInputChannels(), getTotalNumOutputChannels()), samplesPerBlock);
+    bypass.prepare (sampleRate, juce::jmax (getTotalNumInputChannels(), getTotalNumOutputChannels()), samplesPerBlock);
 }
 
 void DYNVocalPinAudioProcessor::releaseResources()
 {
 }
 
-void DYNVocalPinAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer,
-                                               juce::MidiBuffer&)
+void DYNVocalPinAudioProcessor::processFloat (juce::AudioBuffer<float>& buffer,
+                                               juce::MidiBuffer& midi)
 {
+    if (renderInPreparedChunks (buffer, midi))
+        return;
+
     juce::ScopedNoDenormals noDenormals;
 
     auto totalIn  = getTotalNumInputChannels();
@@ -77,24 +108,19 @@ void DYNVocalPinAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer,
     for (int ch = totalIn; ch < totalOut; ++ch)
         buffer.clear (ch, 0, buffer.getNumSamples());
 
-    auto get = [this](const char* id) { return apvts.getRawParameterValue (id)->load(); };
-
-    const auto threshDb    = get ("thresh");
-    const auto ratio       = juce::jmax (1.0f, get ("ratio"));
-    const auto attackMs    = juce::jmax (0.1f, get ("attack"));
-    const auto releaseMs   = juce::jmax (0.1f, get ("release"));
-    const auto deEssFreq   = get ("deess_freq");
-    const auto deEssAmount = juce::jlimit (0.0f, 1.0f, get ("deess_amount"));
-    const auto mix         = juce::jlimit (0.0f, 1.0f, get ("mix"));
-    const auto inputGain   = juce::Decibels::decibelsToGain (get (kParamInput));
-    const auto outputGain  = juce::Decibels::decibelsToGain (get (kParamOutput));
-    const bool bypassed    = get (kParamBypass) > 0.5f;
-
-    buffer.applyGain (inputGain);
-    if (bypassed)
+    const auto threshDb    = params[Param::thresh];
+    const auto ratio       = juce::jmax (1.0f, params[Param::ratio]);
+    const auto attackMs    = juce::jmax (0.1f, params[Param::attack]);
+    const auto releaseMs   = juce::jmax (0.1f, params[Param::release]);
+    const auto deEssFreq   = params[Param::deessFreq];
+    const auto deEssAmount = juce::jlimit (0.0f, 1.0f, params[Param::deessAmount]);
+    const bool bypassed    = params.isOn (Param::bypass);
+
+    if (! bypass.begin (buffer, buffer.getNumSamples(), bypassed))
         return;
 
-    dryBuffer.makeCopyOf (buffer, true);
+    dryWet.begin (buffer, buffer.getNumSamples(), inputTrimGain, mixAmount);
+
     lastBlockSize = (juce::uint32) juce::jmax (1, buffer.getNumSamples());
 
     ensureStateSize (buffer.getNumChannels());
@@ -140,13 +166,14 @@ void DYNVocalPinAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer,
         }
     }
 
-    for (int ch = 0; ch < numChannels; ++ch)
-    {
-        auto* wet = buffer.getWritePointer (ch);
-        const auto* dry = dryBuffer.getReadPointer (ch);
-        for (int i = 0; i < numSamples; ++i)
-            wet[i] = (wet[i] * mix + dry[i] * (1.0f - mix)) * outputGain;
-    }
+    dryWet.end (buffer, numSamples, mixAmount, outputTrimGain);
+
+    bypass.end (buffer, numSamples);
+}
+
+void DYNVocalPinAudioProcessor::updateTail()
+{
+    tail.setTail (0.0, gls::dsp::TailTracker::getEnvelopeRT60 (params[Param::release] * 0.001));
 }
 
 void DYNVocalPinAudioProcessor::getStateInformation (juce::MemoryBlock& destData)
@@ -168,29 +195,7 @@ void DYNVocalPinAudioProcessor::setStateInformation (const void* data, int sizeI
 juce::AudioProcessorValueTreeState::ParameterLayout
 DYNVocalPinAudioProcessor::createParameterLayout()
 {
-    std::vector<std::unique_ptr<juce::RangedAudioParameter>> params;
-
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("thresh",     "Threshold",
-                                                                   juce::NormalisableRange<float> (-48.0f, 0.0f, 0.1f), -18.0f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("ratio",      "Ratio",
-                                                                   juce::NormalisableRange<float> (1.0f, 12.0f, 0.01f, 0.5f), 4.0f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("attack",     "Attack",
-                                                                   juce::NormalisableRange<float> (0.1f, 100.0f, 0.01f, 0.35f), 5.0f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("release",    "Release",
-                                                                   juce::NormalisableRange<float> (10.0f, 600.0f, 0.01f, 0.35f), 150.0f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("deess_freq", "DeEss Freq",
-                                                                   juce::NormalisableRange<float> (2000.0f, 12000.0f, 0.01f, 0.35f), 6000.0f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("deess_amount","DeEss Amount",
-                                                                   juce::NormalisableRange<float> (0.0f, 1.0f, 0.001f), 0.5f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("mix",        "Mix",
-                                                                   juce::NormalisableRange<float> (0.0f, 1.0f, 0.001f), 1.0f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> (kParamInput,  "Input Trim",
-                                                                   juce::NormalisableRange<float> (-18.0f, 18.0f, 0.1f), 0.0f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> (kParamOutput, "Output Trim",
-                                                                   juce::NormalisableRange<float> (-18.0f, 18.0f, 0.1f), 0.0f));
-    params.push_back (std::make_unique<juce::AudioParameterBool>  (kParamBypass, "Soft Bypass", false));
-
-    return { params.begin(), params.end() };
+    return gls::createParameterLayout (parameterTable);
 }
 
 DYNVocalPinAudioProcessorEditor::DYNVocalPinAudioProcessorEditor (DYNVocalPinAudioProcessor& p)
@@ -351,10 +356,9 @@ void DYNVocalPinAudioProcessor::updateDeEssFilters (float freq)
         return;
 
     const auto limitedFreq = juce::jlimit (800.0f, (float) (currentSampleRate * 0.45), freq);
-    const auto coeffs = juce::dsp::IIR::Coefficients<float>::makeBandPass (currentSampleRate, limitedFreq, 2.0f);
 
     for (auto& filter : deEssFilters)
-        filter.coefficients = coeffs;
+        filter.setBandPass (currentSampleRate, limitedFreq, 2.0f);
 }
 
 float DYNVocalPinAudioProcessor::computeGain (float levelDb, float threshDb, float ratio) const
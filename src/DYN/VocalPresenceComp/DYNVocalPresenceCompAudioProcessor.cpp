@@ -1,15 +1,36 @@
 #include "DYNVocalPresenceCompAudioProcessor.h"
 
+namespace
+{
+using Param = DYNVocalPresenceCompAudioProcessor::Param;
+using Spec = gls::ParameterSpec;
+
+constexpr std::array<Spec, (size_t) Param::count> parameterTable {{
+    Spec::range ("presence_freq",   "Presence Freq",   500.0f, 8000.0f, 0.01f,  2500.0f, 0.4f),
+    Spec::range ("presence_q",      "Presence Q",      0.2f,   5.0f,    0.001f, 1.0f,    0.5f),
+    Spec::range ("presence_thresh", "Presence Thresh", -48.0f, 0.0f,    0.1f,   -15.0f),
+    Spec::range ("range",           "Range",           -12.0f, 12.0f,   0.1f,   3.0f),
+    Spec::range ("attack",          "Attack",          0.1f,   50.0f,   0.01f,  5.0f,    0.35f),
+    Spec::range ("release",         "Release",         10.0f,  500.0f,  0.01f,  120.0f,  0.35f),
+    Spec::range ("air_gain",        "Air Gain",        -6.0f,  6.0f,    0.1f,   0.0f)
+}};
+
+static_assert (gls::hasUniqueIds (parameterTable));
+} // namespace
+
 DYNVocalPresenceCompAudioProcessor::DYNVocalPresenceCompAudioProcessor()
     : DualPrecisionAudioProcessor(BusesProperties()
                         .withInput  ("Input", juce::AudioChannelSet::stereo(), true)
                         .withOutput ("Output", juce::AudioChannelSet::stereo(), true)),
-      apvts (*this, nullptr, "VOCAL_PRESENCE_COMP", createParameterLayout())
+      apvts (*this, nullptr, "VOCAL_PRESENCE_COMP", createParameterLayout()),
+      params (apvts, parameterTable)
 {
 }
 
 void DYNVocalPresenceCompAudioProcessor::prepareToPlay (double sampleRate, int samplesPerBlock)
 {
+    DualPrecisionAudioProcessor::prepareToPlay (sampleRate, samplesPerBlock);
+
     currentSampleRate = juce::jmax (sampleRate, 44100.0);
     lastBlockSize = (juce::uint32) juce::jmax (1, samplesPerBlock);
     ensureStateSize (getTotalNumOutputChannels());
@@ -33,7 +54,7 @@ void DYNVocalPresenceCompAudioProcessor::releaseResources()
 {
 }
 
-void DYNVocalPresenceCompAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer,
+void DYNVocalPresenceCompAudioProcessor::processFloat (juce::AudioBuffer<float>& buffer,
                                                         juce::MidiBuffer&)
 {
     juce::ScopedNoDenormals noDenormals;
@@ -43,15 +64,13 @@ void DYNVocalPresenceCompAudioProcessor::processBlock (juce::AudioBuffer<float>&
     for (int ch = totalIn; ch < totalOut; ++ch)
         buffer.clear (ch, 0, buffer.getNumSamples());
 
-    auto get = [this](const char* id) { return apvts.getRawParameterValue (id)->load(); };
-
-    const auto presenceFreq = get ("presence_freq");
-    const auto presenceQ    = get ("presence_q");
-    const auto presenceThresh = get ("presence_thresh");
-    const auto range        = get ("range");
-    const auto attack       = get ("attack");
-    const auto release      = get ("release");
-    const auto airGain      = get ("air_gain");
+    const auto presenceFreq = params[Param::presenceFreq];
+    const auto presenceQ    = params[Param::presenceQ];
+    const auto presenceThresh = params[Param::presenceThresh];
+    const auto range        = params[Param::range];
+    const auto attack       = params[Param::attack];
+    const auto release      = params[Param::release];
+    const auto airGain      = params[Param::airGain];
 
     const int numChannels = buffer.getNumChannels();
     const int numSamples  = buffer.getNumSamples();
@@ -102,6 +121,12 @@ void DYNVocalPresenceCompAudioProcessor::processBlock (juce::AudioBuffer<float>&
     }
 }
 
+void DYNVocalPresenceCompAudioProcessor::updateTail()
+{
+    // The presence followers release towards full boost while the input is silent.
+    tail.setTail (0.0, gls::dsp::TailTracker::getEnvelopeRT60 (params[Param::release] * 0.001));
+}
+
 void DYNVocalPresenceCompAudioProcessor::getStateInformation (juce::MemoryBlock& destData)
 {
     auto state = apvts.copyState();
@@ -118,24 +143,7 @@ void DYNVocalPresenceCompAudioProcessor::setStateInformation (const void* data,
 juce::AudioProcessorValueTreeState::ParameterLayout
 DYNVocalPresenceCompAudioProcessor::createParameterLayout()
 {
-    std::vector<std::unique_ptr<juce::RangedAudioParameter>> params;
-
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("presence_freq",   "Presence Freq",
-                                                                   juce::NormalisableRange<float> (500.0f, 8000.0f, 0.01f, 0.4f), 2500.0f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("presence_q",     "Presence Q",
-                                                                   juce::NormalisableRange<float> (0.2f, 5.0f, 0.001f, 0.5f), 1.0f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("presence_thresh","Presence Thresh",
-                                                                   juce::NormalisableRange<float> (-48.0f, 0.0f, 0.1f), -15.0f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("range",          "Range",
-                                                                   juce::NormalisableRange<float> (-12.0f, 12.0f, 0.1f), 3.0f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("attack",         "Attack",
-                                                                   juce::NormalisableRange<float> (0.1f, 50.0f, 0.01f, 0.35f), 5.0f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("release",        "Release",
-                                                                   juce::NormalisableRange<float> (10.0f, 500.0f, 0.01f, 0.35f), 120.0f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("air_gain",       "Air Gain",
-                                                                   juce::NormalisableRange<float> (-6.0f, 6.0f, 0.1f), 0.0f));
-
-    return { params.begin(), params.end() };
+    return gls::createParameterLayout (parameterTable);
 }
 
 DYNVocalPresenceCompAudioProcessorEditor::DYNVocalPresenceCompAudioProcessorEditor (DYNVocalPresenceCompAudioProcessor& p)
@@ -242,9 +250,9 @@ void DYNVocalPresenceCompAudioProcessor::updatePresenceFilters (float freq, floa
         return;
 
     const auto clampedFreq = juce::jlimit (200.0f, (float) (currentSampleRate * 0.45), freq);
-    const auto coeffs = juce::dsp::IIR::Coefficients<float>::makeBandPass (currentSampleRate, clampedFreq, juce::jmax (0.1f, q));
+    const auto clampedQ = juce::jmax (0.1f, q);
     for (auto& filter : presenceFilters)
-        filter.coefficients = coeffs;
+        filter.setBandPass (currentSampleRate, clampedFreq, clampedQ);
 }
 
 void DYNVocalPresenceCompAudioProcessor::updateAirFilters (float airGainDb)
@@ -253,10 +261,9 @@ void DYNVocalPresenceCompAudioProcessor::updateAirFilters (float airGainDb)
         return;
 
     const float freq = juce::jlimit (2000.0f, (float) (currentSampleRate * 0.49f), 9500.0f);
-    const auto coeffs = juce::dsp::IIR::Coefficients<float>::makeHighShelf (currentSampleRate, freq, 0.707f,
-                                                                            juce::Decibels::decibelsToGain (airGainDb));
+    const auto gain = juce::Decibels::decibelsToGain (airGainDb);
     for (auto& filter : airFilters)
-        filter.coefficients = coeffs;
+        filter.setHighShelf (currentSampleRate, freq, 0.707f, gain);
 }
 
 float DYNVocalPresenceCompAudioProcessor::computePresenceGainDb (float levelDb, float thresholdDb, float rangeDb) const
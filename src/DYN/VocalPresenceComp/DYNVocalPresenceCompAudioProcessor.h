@@ -1,17 +1,25 @@
 #pragma once
 
 #include <JuceHeader.h>
+#include <array>
 #include "../../DualPrecisionAudioProcessor.h"
+#include "../../ParameterTable.h"
+#include "../../dsp/Biquad.h"
 
 class DYNVocalPresenceCompAudioProcessor : public DualPrecisionAudioProcessor
 {
 public:
+    enum class Param
+    {
+        presenceFreq, presenceQ, presenceThresh, range, attack, release, airGain,
+        count
+    };
+
     DYNVocalPresenceCompAudioProcessor();
     ~DYNVocalPresenceCompAudioProcessor() override = default;
 
     void prepareToPlay (double sampleRate, int samplesPerBlock) override;
     void releaseResources() override;
-    void processBlock (juce::AudioBuffer<float>&, juce::MidiBuffer&) override;
 
     juce::AudioProcessorEditor* createEditor() override;
     bool hasEditor() const override { return true; }
@@ -20,7 +28,6 @@ public:
     bool acceptsMidi() const override { return false; }
     bool producesMidi() const override { return false; }
     bool isMidiEffect() const override { return false; }
-    double getTailLengthSeconds() const override { return 0.0; }
 
     int getNumPrograms() override { return 1; }
     int getCurrentProgram() override { return 0; }
@@ -34,8 +41,13 @@ public:
     juce::AudioProcessorValueTreeState& getValueTreeState() { return apvts; }
     static juce::AudioProcessorValueTreeState::ParameterLayout createParameterLayout();
 
+protected:
+    void processFloat (juce::AudioBuffer<float>&, juce::MidiBuffer&) override;
+    void updateTail() override;
+
 private:
     juce::AudioProcessorValueTreeState apvts;
+    gls::ParameterHandles<Param> params;
     struct EnvelopeFollower
     {
         void setSampleRate (double newRate)
@@ -83,8 +95,8 @@ private:
 
     std::vector<EnvelopeFollower> presenceFollowers;
     std::vector<float> presenceGainSmoothers;
-    std::vector<juce::dsp::IIR::Filter<float>> presenceFilters;
-    std::vector<juce::dsp::IIR::Filter<float>> airFilters;
+    std::vector<gls::dsp::Biquad> presenceFilters;
+    std::vector<gls::dsp::Biquad> airFilters;
     double currentSampleRate = 44100.0;
     juce::uint32 lastBlockSize = 512;
 
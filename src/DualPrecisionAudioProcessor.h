@@ -1,6 +1,8 @@
 #pragma once
 
 #include <JuceHeader.h>
+#include "AllocationTrap.h"
+#include "dsp/TailTracker.h"
 
 class DualPrecisionAudioProcessor : public juce::AudioProcessor
 {
@@ -12,33 +14,209 @@ public:
 
     bool supportsDoublePrecisionProcessing() const override { return true; }
 
-    void processBlock (juce::AudioBuffer<double>& buffer, juce::MidiBuffer& midi) override
+    /** Latency plus the decay the processor last gave its tail in updateTail(). */
+    double getTailLengthSeconds() const final { return tail.getTailSeconds(); }
+
+    /** Derived processors call this first from their own prepareToPlay so the float
+        scratch used by the 64-bit path is allocated here, never on the audio thread. */
+    void prepareToPlay (double sampleRate, int samplesPerBlock) override
     {
-        scratchBuffer.setSize (buffer.getNumChannels(), buffer.getNumSamples(), false, false, true);
+        tail.prepare (sampleRate);
+        preparedBlockSize = juce::jmax (1, samplesPerBlock);
+        chunkMidi.ensureSize (midiReserveBytes);
+        outputMidi.ensureSize (midiReserveBytes);
 
-        for (int ch = 0; ch < buffer.getNumChannels(); ++ch)
+        if (! usesFloatScratch)
         {
-            const auto* src = buffer.getReadPointer (ch);
-            auto* dst = scratchBuffer.getWritePointer (ch);
-            for (int i = 0; i < buffer.getNumSamples(); ++i)
-                dst[i] = static_cast<float> (src[i]);
+            scratchBuffer.setSize (0, 0);
+            return;
         }
 
-        processBlock (scratchBuffer, midi);
+        const auto numChannels = juce::jmax (1, getTotalNumInputChannels(), getTotalNumOutputChannels());
+        scratchBuffer.setSize (numChannels, preparedBlockSize, false, true, false);
+    }
+
+    /** Every host block enters here, with the debug allocation trap armed, and is
+        handed to the processor's processFloat(). Once the input has been silent for a
+        whole tail and the output has decayed, blocks are cleared instead. Final so that
+        no plugin can bypass the trap or the tail. */
+    void processBlock (juce::AudioBuffer<float>& buffer, juce::MidiBuffer& midi) final
+    {
+        const gls::ScopedAllocationTrap allocationTrap;
+        if (beginTail (buffer))
+        {
+            processFloat (buffer, midi);
+            endTail (buffer);
+        }
+    }
 
-        for (int ch = 0; ch < buffer.getNumChannels(); ++ch)
+    void processBlock (juce::AudioBuffer<double>& buffer, juce::MidiBuffer& midi) final
+    {
+        const gls::ScopedAllocationTrap allocationTrap;
+        if (beginTail (buffer))
         {
-            const auto* src = scratchBuffer.getReadPointer (ch);
-            auto* dst = buffer.getWritePointer (ch);
-            for (int i = 0; i < buffer.getNumSamples(); ++i)
-                dst[i] = static_cast<double> (src[i]);
+            processDouble (buffer, midi);
+            endTail (buffer);
         }
     }
 
 protected:
     using juce::AudioProcessor::AudioProcessor;
-    using juce::AudioProcessor::processBlock;
+
+    /** The plugin's DSP for a 32-bit block. */
+    virtual void processFloat (juce::AudioBuffer<float>& buffer, juce::MidiBuffer& midi) = 0;
+
+    /** The 64-bit path: by default converts to the float scratch and runs processFloat()
+        in prepared-size chunks. */
+    virtual void processDouble (juce::AudioBuffer<double>& buffer, juce::MidiBuffer& midi)
+    {
+        const auto numChannels = buffer.getNumChannels();
+        const auto numSamples  = buffer.getNumSamples();
+
+        if (scratchBuffer.getNumChannels() < numChannels || scratchBuffer.getNumSamples() == 0)
+        {
+            // prepareToPlay was skipped or the layout grew behind our back.
+            jassertfalse;
+            const gls::AllocationTrap::ScopedDisarm allowGrowth;
+            scratchBuffer.setSize (numChannels, juce::jmax (numSamples, scratchBuffer.getNumSamples()), false, true, true);
+        }
+
+        // Hosts may hand us more samples than announced: render in prepared-size
+        // chunks rather than growing the scratch buffer on the audio thread. Each chunk
+        // gets its own slice of the MIDI, with timestamps relative to the chunk.
+        const auto chunkCapacity = scratchBuffer.getNumSamples();
+        const auto chunked = numSamples > chunkCapacity;
+
+        if (chunked)
+            outputMidi.clear();
+
+        for (int start = 0; start < numSamples; start += chunkCapacity)
+        {
+            const auto chunkSize = juce::jmin (chunkCapacity, numSamples - start);
+
+            for (int ch = 0; ch < numChannels; ++ch)
+            {
+                const auto* src = buffer.getReadPointer (ch, start);
+                auto* dst = scratchBuffer.getWritePointer (ch);
+                for (int i = 0; i < chunkSize; ++i)
+                    dst[i] = static_cast<float> (src[i]);
+            }
+
+            juce::AudioBuffer<float> chunk (scratchBuffer.getArrayOfWritePointers(), numChannels, chunkSize);
+
+            if (chunked)
+            {
+                chunkMidi.clear();
+                chunkMidi.addEvents (midi, start, chunkSize, -start);
+                processFloat (chunk, chunkMidi);
+                outputMidi.addEvents (chunkMidi, 0, chunkSize, start);
+            }
+            else
+            {
+                processFloat (chunk, midi);
+            }
+
+            for (int ch = 0; ch < numChannels; ++ch)
+            {
+                const auto* src = scratchBuffer.getReadPointer (ch);
+                auto* dst = buffer.getWritePointer (ch, start);
+                for (int i = 0; i < chunkSize; ++i)
+                    dst[i] = static_cast<double> (src[i]);
+            }
+        }
+
+        if (chunked)
+            midi.swapWith (outputMidi);
+    }
+
+    /** Audio thread, before each host block: processors whose output outlasts their
+        input describe that decay here with tail.setTail(). The default has none, so
+        only the reported latency is waited out. */
+    virtual void updateTail() {}
+
+    /** Cleared by processors that render doubles natively and never need the float scratch. */
+    bool usesFloatScratch = true;
+
+    gls::dsp::TailTracker tail;
+
+    /** For processFloat/processSamples bodies whose per-block storage is sized in
+        prepareToPlay: call it first and return if it returns true. A host block longer
+        than the prepared size is then rendered in prepared-size chunks, each with its own
+        slice of the MIDI, exactly as the 64-bit path does. */
+    template <typename SampleType>
+    bool renderInPreparedChunks (juce::AudioBuffer<SampleType>& buffer, juce::MidiBuffer& midi)
+    {
+        const auto numSamples = buffer.getNumSamples();
+        if (preparedBlockSize == 0 || numSamples <= preparedBlockSize)
+            return false;
+
+        outputMidi.clear();
+
+        for (int start = 0; start < numSamples; start += preparedBlockSize)
+        {
+            const auto chunkSize = juce::jmin (preparedBlockSize, numSamples - start);
+            juce::AudioBuffer<SampleType> chunk (buffer.getArrayOfWritePointers(), buffer.getNumChannels(), start, chunkSize);
+
+            chunkMidi.clear();
+            chunkMidi.addEvents (midi, start, chunkSize, -start);
+            render (chunk, chunkMidi);
+            outputMidi.addEvents (chunkMidi, 0, chunkSize, start);
+        }
+
+        midi.swapWith (outputMidi);
+        return true;
+    }
 
 private:
+    static constexpr size_t midiReserveBytes = 4096;
+
+    template <typename SampleType>
+    bool beginTail (juce::AudioBuffer<SampleType>& buffer)
+    {
+        updateTail();
+        if (tail.beginBlock (buffer, buffer.getNumSamples()))
+            return true;
+
+        buffer.clear();
+        return false;
+    }
+
+    template <typename SampleType>
+    void endTail (const juce::AudioBuffer<SampleType>& buffer)
+    {
+        tail.setLatency (getLatencySamples());
+        tail.endBlock (buffer, buffer.getNumSamples());
+    }
+
+    void render (juce::AudioBuffer<float>& buffer, juce::MidiBuffer& midi)     { processFloat (buffer, midi); }
+    void render (juce::AudioBuffer<double>& buffer, juce::MidiBuffer& midi)    { processDouble (buffer, midi); }
+
     juce::AudioBuffer<float> scratchBuffer;
+    juce::MidiBuffer chunkMidi, outputMidi;
+    int preparedBlockSize = 0;
+};
+
+/** Base for processors whose DSP is written once as a template over the sample type.
+    Both host precisions call straight into Derived::processSamples<SampleType>() with
+    no conversion copies; state that must carry between blocks is kept in double. */
+template <typename Derived>
+class NativePrecisionAudioProcessor : public DualPrecisionAudioProcessor
+{
+public:
+    explicit NativePrecisionAudioProcessor (const BusesProperties& ioConfig)
+        : DualPrecisionAudioProcessor (ioConfig)
+    {
+        usesFloatScratch = false;
+    }
+
+protected:
+    void processFloat (juce::AudioBuffer<float>& buffer, juce::MidiBuffer& midi) override
+    {
+        static_cast<Derived&> (*this).processSamples (buffer, midi);
+    }
+
+    void processDouble (juce::AudioBuffer<double>& buffer, juce::MidiBuffer& midi) override
+    {
+        static_cast<Derived&> (*this).processSamples (buffer, midi);
+    }
 };
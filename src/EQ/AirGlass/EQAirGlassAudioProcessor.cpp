@@ -6,6 +6,21 @@ constexpr auto kStateId     = "EQ_AIR_GLASS";
 constexpr auto kParamBypass = "ui_bypass";
 constexpr auto kParamInput  = "input_trim";
 constexpr auto kParamOutput = "output_trim";
+
+using Param = EQAirGlassAudioProcessor::Param;
+using Spec = gls::ParameterSpec;
+
+constexpr std::array<Spec, (size_t) Param::count> parameterTable {{
+    Spec::range  ("air_freq",       "Air Freq",       6000.0f, 20000.0f, 0.01f,  12000.0f, 0.4f),
+    Spec::range  ("air_gain",       "Air Gain",       -6.0f,   12.0f,    0.1f,   4.0f),
+    Spec::range  ("harmonic_blend", "Harmonic Blend", 0.0f,    1.0f,     0.001f, 0.3f),
+    Spec::range  ("deharsh",        "DeHarsh",        0.0f,    1.0f,     0.001f, 0.5f),
+    Spec::range  (kParamInput,      "Input Trim",     -18.0f,  18.0f,    0.1f,   0.0f),
+    Spec::range  (kParamOutput,     "Output Trim",    -18.0f,  18.0f,    0.1f,   0.0f),
+    Spec::toggle (kParamBypass,     "Soft Bypass",    false)
+}};
+
+static_assert (gls::hasUniqueIds (parameterTable));
 }
 
 const std::array<EQAirGlassAudioProcessor::Preset, 3> EQAirGlassAudioProcessor::presetBank {{
@@ -42,15 +57,18 @@ EQAirGlassAudioProcessor::EQAirGlassAudioProcessor()
     : DualPrecisionAudioProcessor (BusesProperties()
                         .withInput  ("Input", juce::AudioChannelSet::stereo(), true)
                         .withOutput ("Output", juce::AudioChannelSet::stereo(), true)),
-      apvts (*this, nullptr, kStateId, createParameterLayout())
+      apvts (*this, nullptr, kStateId, createParameterLayout()),
+      params (apvts, parameterTable)
 {
 }
 
 void EQAirGlassAudioProcessor::prepareToPlay (double sampleRate, int samplesPerBlock)
 {
+    DualPrecisionAudioProcessor::prepareToPlay (sampleRate, samplesPerBlock);
+
     currentSampleRate = sampleRate > 0.0 ? sampleRate : 44100.0;
     lastBlockSize = (juce::uint32) juce::jmax (1, samplesPerBlock);
-    ensureStateSize (getTotalNumOutputChannels());
+    ensureStateSize (juce::jmax (getTotalNumInputChannels(), getTotalNumOutputChannels()));
 
     juce::dsp::ProcessSpec spec { currentSampleRate, lastBlockSize, 1 };
     for (auto& filter : airShelves)
@@ -65,13 +83,18 @@ void EQAirGlassAudioProcessor::prepareToPlay (double sampleRate, int samplesPerB
     }
 
     std::fill (harshEnvelopes.begin(), harshEnvelopes.end(), 0.0f);
+
+    bypass.prepare (sampleRate, juce::jmax (getTotalNumInputChannels(), getTotalNumOutputChannels()), samplesPerBlock);
+
+    for (auto* smoother : { &inputTrimGain, &outputTrimGain })
+        smoother->prepare (currentSampleRate, samplesPerBlock);
 }
 
 void EQAirGlassAudioProcessor::releaseResources()
 {
 }
 
-void EQAirGlassAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer,
+void EQAirGlassAudioProcessor::processFloat (juce::AudioBuffer<float>& buffer,
                                              juce::MidiBuffer&)
 {
     juce::ScopedNoDenormals noDenormals;
@@ -81,29 +104,32 @@ void EQAirGlassAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer,
     for (int ch = totalIn; ch < totalOut; ++ch)
         buffer.clear (ch, 0, buffer.getNumSamples());
 
-    auto get = [this](const char* id) { return apvts.getRawParameterValue (id)->load(); };
-
-    const float airFreq       = get ("air_freq");
-    const float airGainDb     = get ("air_gain");
-    const float harmonicBlend = juce::jlimit (0.0f, 1.0f, get ("harmonic_blend"));
-    const float deHarsh       = juce::jlimit (0.0f, 1.0f, get ("deharsh"));
-    const float inputGain     = juce::Decibels::decibelsToGain (get (kParamInput));
-    const float outputGain    = juce::Decibels::decibelsToGain (get (kParamOutput));
-    const bool bypassed       = get (kParamBypass) > 0.5f;
+    const float airFreq       = params[Param::airFreq];
+    const float airGainDb     = params[Param::airGain];
+    const float harmonicBlend = juce::jlimit (0.0f, 1.0f, params[Param::harmonicBlend]);
+    const float deHarsh       = juce::jlimit (0.0f, 1.0f, params[Param::deharsh]);
+    const bool bypassed       = params.isOn (Param::bypass);
 
     lastBlockSize = (juce::uint32) juce::jmax (1, buffer.getNumSamples());
     ensureStateSize (buffer.getNumChannels());
 
-    buffer.applyGain (inputGain);
-    if (bypassed)
+    for (auto* smoother : { &inputTrimGain, &outputTrimGain })
+        smoother->update();
+
+    // The input trim applies in bypass too, as it always has.
+    inputTrimGain.applyGain (buffer, buffer.getNumSamples());
+    if (! bypass.begin (buffer, buffer.getNumSamples(), bypassed))
+    {
+        outputTrimGain.snap();
         return;
+    }
 
     updateShelfCoefficients (airFreq, airGainDb);
     updateHarshFilters (airFreq * 0.8f);
 
     const float drive        = 1.0f + juce::jlimit (0.0f, 18.0f, airGainDb) / 12.0f;
     const float attackCoeff  = std::exp (-1.0f / (0.0025f * (float) currentSampleRate));
-    const float releaseCoeff = std::exp (-1.0f / (0.05f * (float) currentSampleRate));
+    const float releaseCoeff = std::exp (-1.0f / (releaseSeconds * (float) currentSampleRate));
 
     const int numSamples  = buffer.getNumSamples();
     const int numChannels = buffer.getNumChannels();
@@ -137,7 +163,14 @@ void EQAirGlassAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer,
         }
     }
 
-    buffer.applyGain (outputGain);
+    outputTrimGain.applyGain (buffer, numSamples);
+
+    bypass.end (buffer, numSamples);
+}
+
+void EQAirGlassAudioProcessor::updateTail()
+{
+    tail.setTail (0.0, gls::dsp::TailTracker::getEnvelopeRT60 (releaseSeconds));
 }
 
 void EQAirGlassAudioProcessor::getStateInformation (juce::MemoryBlock& destData)
@@ -158,23 +191,7 @@ void EQAirGlassAudioProcessor::setStateInformation (const void* data, int sizeIn
 juce::AudioProcessorValueTreeState::ParameterLayout
 EQAirGlassAudioProcessor::createParameterLayout()
 {
-    std::vector<std::unique_ptr<juce::RangedAudioParameter>> params;
-
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("air_freq",       "Air Freq",
-                                                                   juce::NormalisableRange<float> (6000.0f, 20000.0f, 0.01f, 0.4f), 12000.0f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("air_gain",       "Air Gain",
-                                                                   juce::NormalisableRange<float> (-6.0f, 12.0f, 0.1f), 4.0f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("harmonic_blend", "Harmonic Blend",
-                                                                   juce::NormalisableRange<float> (0.0f, 1.0f, 0.001f), 0.3f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("deharsh",        "DeHarsh",
-                                                                   juce::NormalisableRange<float> (0.0f, 1.0f, 0.001f), 0.5f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> (kParamInput,      "Input Trim",
-                                                                   juce::NormalisableRange<float> (-18.0f, 18.0f, 0.1f), 0.0f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> (kParamOutput,     "Output Trim",
-                                                                   juce::NormalisableRange<float> (-18.0f, 18.0f, 0.1f), 0.0f));
-    params.push_back (std::make_unique<juce::AudioParameterBool>  (kParamBypass,     "Soft Bypass", false));
-
-    return { params.begin(), params.end() };
+    return gls::createParameterLayout (parameterTable);
 }
 
 EQAirGlassAudioProcessorEditor::EQAirGlassAudioProcessorEditor (EQAirGlassAudioProcessor& p)
@@ -327,10 +344,8 @@ void EQAirGlassAudioProcessor::updateShelfCoefficients (float freq, float gainDb
 
     const auto clampedFreq = juce::jlimit (4000.0f, (float) (currentSampleRate * 0.49f), freq);
     const auto gainLinear  = juce::Decibels::decibelsToGain (gainDb);
-    auto coeffs = juce::dsp::IIR::Coefficients<float>::makeHighShelf (currentSampleRate, clampedFreq, 0.707f, gainLinear);
-
     for (auto& filter : airShelves)
-        filter.coefficients = coeffs;
+        filter.setHighShelf (currentSampleRate, clampedFreq, 0.707f, gainLinear);
 }
 
 void EQAirGlassAudioProcessor::updateHarshFilters (float freq)
@@ -339,10 +354,8 @@ void EQAirGlassAudioProcessor::updateHarshFilters (float freq)
         return;
 
     const auto clamped = juce::jlimit (2000.0f, (float) (currentSampleRate * 0.49f), freq);
-    auto coeffs = juce::dsp::IIR::Coefficients<float>::makeBandPass (currentSampleRate, clamped, 1.2f);
-
     for (auto& filter : harshFilters)
-        filter.coefficients = coeffs;
+        filter.setBandPass (currentSampleRate, clamped, 1.2f);
 }
 
 int EQAirGlassAudioProcessor::getNumPrograms()
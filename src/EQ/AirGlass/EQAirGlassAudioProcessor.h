@@ -3,17 +3,26 @@
 #include <JuceHeader.h>
 #include <array>
 #include "../../DualPrecisionAudioProcessor.h"
+#include "../../ParameterTable.h"
+#include "../../SmoothedParameter.h"
+#include "../../dsp/Biquad.h"
+#include "../../dsp/SoftBypass.h"
 #include "../../ui/GoodluckLookAndFeel.h"
 
 class EQAirGlassAudioProcessor : public DualPrecisionAudioProcessor
 {
 public:
+    enum class Param
+    {
+        airFreq, airGain, harmonicBlend, deharsh, inputTrim, outputTrim, bypass,
+        count
+    };
+
     EQAirGlassAudioProcessor();
     ~EQAirGlassAudioProcessor() override = default;
 
     void prepareToPlay (double sampleRate, int samplesPerBlock) override;
     void releaseResources() override;
-    void processBlock (juce::AudioBuffer<float>&, juce::MidiBuffer&) override;
 
     juce::AudioProcessorEditor* createEditor() override;
     bool hasEditor() const override { return true; }
@@ -22,7 +31,6 @@ public:
     bool acceptsMidi() const override { return false; }
     bool producesMidi() const override { return false; }
     bool isMidiEffect() const override { return false; }
-    double getTailLengthSeconds() const override { return 0.0; }
 
     int getNumPrograms() override;
     int getCurrentProgram() override { return currentPreset; }
@@ -36,10 +44,19 @@ public:
     juce::AudioProcessorValueTreeState& getValueTreeState() { return apvts; }
     static juce::AudioProcessorValueTreeState::ParameterLayout createParameterLayout();
 
+protected:
+    void processFloat (juce::AudioBuffer<float>&, juce::MidiBuffer&) override;
+    void updateTail() override;
+
 private:
     juce::AudioProcessorValueTreeState apvts;
-    std::vector<juce::dsp::IIR::Filter<float>> airShelves;
-    std::vector<juce::dsp::IIR::Filter<float>> harshFilters;
+    gls::ParameterHandles<Param> params;
+    static constexpr float releaseSeconds = 0.05f;
+    gls::SmoothedParameter inputTrimGain  { params, Param::inputTrim,   gls::SmoothedParameter::Mapping::decibels };
+    gls::SmoothedParameter outputTrimGain { params, Param::outputTrim,  gls::SmoothedParameter::Mapping::decibels };
+    gls::dsp::SoftBypass bypass;
+    std::vector<gls::dsp::Biquad> airShelves;
+    std::vector<gls::dsp::Biquad> harshFilters;
     std::vector<float> harshEnvelopes;
     double currentSampleRate = 44100.0;
     juce::uint32 lastBlockSize = 512;
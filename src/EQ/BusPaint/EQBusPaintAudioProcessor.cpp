@@ -6,6 +6,21 @@ constexpr auto kStateId     = "BUS_PAINT";
 constexpr auto kParamBypass = "ui_bypass";
 constexpr auto kParamInput  = "input_trim";
 constexpr auto kParamOutput = "output_trim";
+
+using Param = EQBusPaintAudioProcessor::Param;
+using Spec = gls::ParameterSpec;
+
+constexpr std::array<Spec, (size_t) Param::count> parameterTable {{
+    Spec::range  ("low_tilt",   "Low Tilt",    -6.0f,  6.0f,  0.1f, 0.0f),
+    Spec::range  ("high_tilt",  "High Tilt",   -6.0f,  6.0f,  0.1f, 0.0f),
+    Spec::range  ("presence",   "Presence",    -6.0f,  6.0f,  0.1f, 0.0f),
+    Spec::range  ("warmth",     "Warmth",      -6.0f,  6.0f,  0.1f, 0.0f),
+    Spec::range  (kParamInput,  "Input Trim",  -18.0f, 18.0f, 0.1f, 0.0f),
+    Spec::range  (kParamOutput, "Output Trim", -18.0f, 18.0f, 0.1f, 0.0f),
+    Spec::toggle (kParamBypass, "Soft Bypass", false)
+}};
+
+static_assert (gls::hasUniqueIds (parameterTable));
 }
 
 const std::array<EQBusPaintAudioProcessor::Preset, 3> EQBusPaintAudioProcessor::presetBank {{
@@ -42,12 +57,15 @@ EQBusPaintAudioProcessor::EQBusPaintAudioProcessor()
     : DualPrecisionAudioProcessor (BusesProperties()
                         .withInput  ("Input", juce::AudioChannelSet::stereo(), true)
                         .withOutput ("Output", juce::AudioChannelSet::stereo(), true)),
-      apvts (*this, nullptr, kStateId, createParameterLayout())
+      apvts (*this, nullptr, kStateId, createParameterLayout()),
+      params (apvts, parameterTable)
 {
 }
 
 void EQBusPaintAudioProcessor::prepareToPlay (double sampleRate, int samplesPerBlock)
 {
+    DualPrecisionAudioProcessor::prepareToPlay (sampleRate, samplesPerBlock);
+
     currentSampleRate = sampleRate > 0.0 ? sampleRate : 44100.0;
     lastBlockSize = (juce::uint32) juce::jmax (1, samplesPerBlock);
     ensureFilterState (getTotalNumOutputChannels());
@@ -66,13 +84,18 @@ void EQBusPaintAudioProcessor::prepareToPlay (double sampleRate, int samplesPerB
     prepareVector (highShelves);
     prepareVector (presenceBells);
     prepareVector (warmthBells);
+
+    bypass.prepare (sampleRate, juce::jmax (getTotalNumInputChannels(), getTotalNumOutputChannels()), samplesPerBlock);
+
+    for (auto* smoother : { &inputTrimGain, &outputTrimGain })
+        smoother->prepare (currentSampleRate, samplesPerBlock);
 }
 
 void EQBusPaintAudioProcessor::releaseResources()
 {
 }
 
-void EQBusPaintAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer,
+void EQBusPaintAudioProcessor::processFloat (juce::AudioBuffer<float>& buffer,
                                              juce::MidiBuffer&)
 {
     juce::ScopedNoDenormals noDenormals;
@@ -82,23 +105,26 @@ void EQBusPaintAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer,
     for (int ch = totalIn; ch < totalOut; ++ch)
         buffer.clear (ch, 0, buffer.getNumSamples());
 
-    auto get = [this](const char* id) { return apvts.getRawParameterValue (id)->load(); };
-
-    const float lowTilt    = get ("low_tilt");
-    const float highTilt   = get ("high_tilt");
-    const float presence   = get ("presence");
-    const float warmth     = get ("warmth");
-    const float inputGain  = juce::Decibels::decibelsToGain (get (kParamInput));
-    const float outputGain = juce::Decibels::decibelsToGain (get (kParamOutput));
-    const bool bypassed    = get (kParamBypass) > 0.5f;
+    const float lowTilt    = params[Param::lowTilt];
+    const float highTilt   = params[Param::highTilt];
+    const float presence   = params[Param::presence];
+    const float warmth     = params[Param::warmth];
+    const bool bypassed    = params.isOn (Param::bypass);
 
     lastBlockSize = (juce::uint32) juce::jmax (1, buffer.getNumSamples());
     ensureFilterState (buffer.getNumChannels());
     updateFilters (lowTilt, highTilt, presence, warmth);
 
-    buffer.applyGain (inputGain);
-    if (bypassed)
+    for (auto* smoother : { &inputTrimGain, &outputTrimGain })
+        smoother->update();
+
+    // The input trim applies in bypass too, as it always has.
+    inputTrimGain.applyGain (buffer, buffer.getNumSamples());
+    if (! bypass.begin (buffer, buffer.getNumSamples(), bypassed))
+    {
+        outputTrimGain.snap();
         return;
+    }
 
     juce::dsp::AudioBlock<float> block (buffer);
     for (size_t ch = 0; ch < block.getNumChannels(); ++ch)
@@ -111,7 +137,9 @@ void EQBusPaintAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer,
         warmthBells[ch].process (ctx);
     }
 
-    buffer.applyGain (outputGain);
+    outputTrimGain.applyGain (buffer, buffer.getNumSamples());
+
+    bypass.end (buffer, buffer.getNumSamples());
 }
 
 void EQBusPaintAudioProcessor::getStateInformation (juce::MemoryBlock& destData)
@@ -132,23 +160,7 @@ void EQBusPaintAudioProcessor::setStateInformation (const void* data, int sizeIn
 juce::AudioProcessorValueTreeState::ParameterLayout
 EQBusPaintAudioProcessor::createParameterLayout()
 {
-    std::vector<std::unique_ptr<juce::RangedAudioParameter>> params;
-
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("low_tilt",  "Low Tilt",
-                                                                   juce::NormalisableRange<float> (-6.0f, 6.0f, 0.1f), 0.0f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("high_tilt", "High Tilt",
-                                                                   juce::NormalisableRange<float> (-6.0f, 6.0f, 0.1f), 0.0f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("presence",  "Presence",
-                                                                   juce::NormalisableRange<float> (-6.0f, 6.0f, 0.1f), 0.0f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("warmth",    "Warmth",
-                                                                   juce::NormalisableRange<float> (-6.0f, 6.0f, 0.1f), 0.0f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> (kParamInput, "Input Trim",
-                                                                   juce::NormalisableRange<float> (-18.0f, 18.0f, 0.1f), 0.0f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> (kParamOutput,"Output Trim",
-                                                                   juce::NormalisableRange<float> (-18.0f, 18.0f, 0.1f), 0.0f));
-    params.push_back (std::make_unique<juce::AudioParameterBool>  (kParamBypass,"Soft Bypass", false));
-
-    return { params.begin(), params.end() };
+    return gls::createParameterLayout (parameterTable);
 }
 
 EQBusPaintAudioProcessorEditor::EQBusPaintAudioProcessorEditor (EQBusPaintAudioProcessor& p)
@@ -326,19 +338,14 @@ void EQBusPaintAudioProcessor::updateFilters (float lowTilt, float highTilt, flo
     constexpr float presenceFreq  = 3200.0f;
     constexpr float warmthFreq    = 450.0f;
 
-    auto lowCoeffs     = juce::dsp::IIR::Coefficients<float>::makeLowShelf  (currentSampleRate, lowShelfFreq, 0.707f, lowShelfGain);
-    auto highCoeffs    = juce::dsp::IIR::Coefficients<float>::makeHighShelf (currentSampleRate, highShelfFreq, 0.707f, highShelfGain);
-    auto presenceCoeffs= juce::dsp::IIR::Coefficients<float>::makePeakFilter (currentSampleRate, presenceFreq, 1.0f, presenceGain);
-    auto warmthCoeffs  = juce::dsp::IIR::Coefficients<float>::makePeakFilter (currentSampleRate, warmthFreq, 0.8f, warmthGain);
-
     for (auto& filter : lowShelves)
-        filter.coefficients = lowCoeffs;
+        filter.setLowShelf (currentSampleRate, lowShelfFreq, 0.707f, lowShelfGain);
     for (auto& filter : highShelves)
-        filter.coefficients = highCoeffs;
+        filter.setHighShelf (currentSampleRate, highShelfFreq, 0.707f, highShelfGain);
     for (auto& filter : presenceBells)
-        filter.coefficients = presenceCoeffs;
+        filter.setPeak (currentSampleRate, presenceFreq, 1.0f, presenceGain);
     for (auto& filter : warmthBells)
-        filter.coefficients = warmthCoeffs;
+        filter.setPeak (currentSampleRate, warmthFreq, 0.8f, warmthGain);
 }
 
 void EQBusPaintAudioProcessor::applyPreset (int index)
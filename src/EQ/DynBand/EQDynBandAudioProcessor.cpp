@@ -6,6 +6,26 @@ constexpr auto kStateId     = "DYN_BAND";
 constexpr auto kParamBypass = "ui_bypass";
 constexpr auto kParamInput  = "input_trim";
 constexpr auto kParamOutput = "output_trim";
+
+using Param = EQDynBandAudioProcessor::Param;
+using Spec = gls::ParameterSpec;
+
+constexpr std::array<Spec, (size_t) Param::count> parameterTable {{
+    Spec::range  ("band1_freq",   "Band1 Freq",   40.0f,  12000.0f, 0.01f,  250.0f,  0.4f),
+    Spec::range  ("band1_q",      "Band1 Q",      0.2f,   10.0f,    0.001f, 1.0f,    0.5f),
+    Spec::range  ("band1_thresh", "Band1 Thresh", -48.0f, 0.0f,     0.1f,   -24.0f),
+    Spec::range  ("band1_range",  "Band1 Range",  -24.0f, 24.0f,    0.1f,   -6.0f),
+    Spec::range  ("band2_freq",   "Band2 Freq",   40.0f,  12000.0f, 0.01f,  4000.0f, 0.4f),
+    Spec::range  ("band2_q",      "Band2 Q",      0.2f,   10.0f,    0.001f, 1.0f,    0.5f),
+    Spec::range  ("band2_thresh", "Band2 Thresh", -48.0f, 0.0f,     0.1f,   -18.0f),
+    Spec::range  ("band2_range",  "Band2 Range",  -24.0f, 24.0f,    0.1f,   -6.0f),
+    Spec::range  ("mix",          "Mix",          0.0f,   1.0f,     0.001f, 1.0f),
+    Spec::range  (kParamInput,    "Input Trim",   -18.0f, 18.0f,    0.1f,   0.0f),
+    Spec::range  (kParamOutput,   "Output Trim",  -18.0f, 18.0f,    0.1f,   0.0f),
+    Spec::toggle (kParamBypass,   "Soft Bypass",  false)
+}};
+
+static_assert (gls::hasUniqueIds (parameterTable));
 }
 
 const std::array<EQDynBandAudioProcessor::Preset, 3> EQDynBandAudioProcessor::presetBank {{
@@ -57,12 +77,16 @@ EQDynBandAudioProcessor::EQDynBandAudioProcessor()
     : DualPrecisionAudioProcessor (BusesProperties()
                         .withInput  ("Input", juce::AudioChannelSet::stereo(), true)
                         .withOutput ("Output", juce::AudioChannelSet::stereo(), true)),
-      apvts (*this, nullptr, kStateId, createParameterLayout())
+      apvts (*this, nullptr, kStateId, createParameterLayout()),
+      params (apvts, parameterTable)
 {
+    bypass.snapOnResume (dryWet);
 }
 
 void EQDynBandAudioProcessor::prepareToPlay (double sampleRate, int samplesPerBlock)
 {
+    DualPrecisionAudioProcessor::prepareToPlay (sampleRate, samplesPerBlock);
+
     currentSampleRate = juce::jmax (sampleRate, 44100.0);
     lastBlockSize = (juce::uint32) juce::jmax (1, samplesPerBlock);
     ensureStateSize (getTotalNumOutputChannels());
@@ -82,15 +106,24 @@ void EQDynBandAudioProcessor::prepareToPlay (double sampleRate, int samplesPerBl
         band.envelope = 0.0f;
         band.gain = 1.0f;
     }
+
+    for (auto* smoother : { &inputTrimGain, &mixAmount, &outputTrimGain })
+        smoother->prepare (sampleRate, samplesPerBlock);
+
+    dryWet.prepare (sampleRate, juce::jmax (getTotalNumInputChannels(), getTotalNumOutputChannels()), samplesPerBlock);
+    bypass.prepare (sampleRate, juce::jmax (getTotalNumInputChannels(), getTotalNumOutputChannels()), samplesPerBlock);
 }
 
 void EQDynBandAudioProcessor::releaseResources()
 {
 }
 
-void EQDynBandAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer,
-                                            juce::MidiBuffer&)
+void EQDynBandAudioProcessor::processFloat (juce::AudioBuffer<float>& buffer,
+                                            juce::MidiBuffer& midi)
 {
+    if (renderInPreparedChunks (buffer, midi))
+        return;
+
     juce::ScopedNoDenormals noDenormals;
 
     auto totalIn  = getTotalNumInputChannels();
@@ -98,30 +131,26 @@ void EQDynBandAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer,
     for (int ch = totalIn; ch < totalOut; ++ch)
         buffer.clear (ch, 0, buffer.getNumSamples());
 
-    auto get = [this](const char* id) { return apvts.getRawParameterValue (id)->load(); };
-
-    const auto b1Freq    = get ("band1_freq");
-    const auto b1Q       = get ("band1_q");
-    const auto b1Thresh  = get ("band1_thresh");
-    const auto b1Range   = get ("band1_range");
-    const auto b2Freq    = get ("band2_freq");
-    const auto b2Q       = get ("band2_q");
-    const auto b2Thresh  = get ("band2_thresh");
-    const auto b2Range   = get ("band2_range");
-    const auto mix       = juce::jlimit (0.0f, 1.0f, get ("mix"));
-    const float inputGain  = juce::Decibels::decibelsToGain (get (kParamInput));
-    const float outputGain = juce::Decibels::decibelsToGain (get (kParamOutput));
-    const bool bypassed    = get (kParamBypass) > 0.5f;
+    const auto b1Freq    = params[Param::band1Freq];
+    const auto b1Q       = params[Param::band1Q];
+    const auto b1Thresh  = params[Param::band1Thresh];
+    const auto b1Range   = params[Param::band1Range];
+    const auto b2Freq    = params[Param::band2Freq];
+    const auto b2Q       = params[Param::band2Q];
+    const auto b2Thresh  = params[Param::band2Thresh];
+    const auto b2Range   = params[Param::band2Range];
+    const bool bypassed    = params.isOn (Param::bypass);
 
     const int numChannels = buffer.getNumChannels();
     const int numSamples  = buffer.getNumSamples();
 
     lastBlockSize = (juce::uint32) juce::jmax (1, numSamples);
     ensureStateSize (numChannels);
-    dryBuffer.makeCopyOf (buffer, true);
-
-    buffer.applyGain (inputGain);
-    if (bypassed)
+    // The dry signal is taken ahead of the input trim, so the mix blends against the raw input.
+    dryWet.begin (buffer, numSamples, mixAmount);
+    inputTrimGain.update();
+    inputTrimGain.applyGain (buffer, numSamples);
+    if (! bypass.begin (buffer, numSamples, bypassed))
         return;
 
     for (int ch = 0; ch < numChannels; ++ch)
@@ -131,7 +160,6 @@ void EQDynBandAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer,
     }
 
     const float attackMs = 10.0f;
-    const float releaseMs = 120.0f;
     const float attackCoeff  = std::exp (-1.0f / (attackMs * 0.001f * (float) currentSampleRate));
     const float releaseCoeff = std::exp (-1.0f / (releaseMs * 0.001f * (float) currentSampleRate));
 
@@ -169,13 +197,14 @@ void EQDynBandAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer,
         }
     }
 
-    for (int ch = 0; ch < numChannels; ++ch)
-    {
-        auto* wet = buffer.getWritePointer (ch);
-        const auto* dry = dryBuffer.getReadPointer (ch);
-        for (int i = 0; i < numSamples; ++i)
-            wet[i] = (wet[i] * mix + dry[i] * (1.0f - mix)) * outputGain;
-    }
+    dryWet.end (buffer, numSamples, mixAmount, outputTrimGain);
+
+    bypass.end (buffer, numSamples);
+}
+
+void EQDynBandAudioProcessor::updateTail()
+{
+    tail.setTail (0.0, gls::dsp::TailTracker::getEnvelopeRT60 (releaseMs * 0.001));
 }
 
 void EQDynBandAudioProcessor::getStateInformation (juce::MemoryBlock& destData)
@@ -194,32 +223,7 @@ void EQDynBandAudioProcessor::setStateInformation (const void* data, int sizeInB
 juce::AudioProcessorValueTreeState::ParameterLayout
 EQDynBandAudioProcessor::createParameterLayout()
 {
-    std::vector<std::unique_ptr<juce::RangedAudioParameter>> params;
-
-    auto freqRange   = juce::NormalisableRange<float> (40.0f, 12000.0f, 0.01f, 0.4f);
-    auto qRange      = juce::NormalisableRange<float> (0.2f, 10.0f, 0.001f, 0.5f);
-    auto threshRange = juce::NormalisableRange<float> (-48.0f, 0.0f, 0.1f);
-    auto rangeRange  = juce::NormalisableRange<float> (-24.0f, 24.0f, 0.1f);
-
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("band1_freq",   "Band1 Freq",   freqRange,   250.0f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("band1_q",      "Band1 Q",      qRange,      1.0f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("band1_thresh", "Band1 Thresh", threshRange, -24.0f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("band1_range",  "Band1 Range",  rangeRange,  -6.0f));
-
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("band2_freq",   "Band2 Freq",   freqRange,   4000.0f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("band2_q",      "Band2 Q",      qRange,      1.0f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("band2_thresh", "Band2 Thresh", threshRange, -18.0f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("band2_range",  "Band2 Range",  rangeRange,  -6.0f));
-
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("mix",          "Mix",
-                                                                   juce::NormalisableRange<float> (0.0f, 1.0f, 0.001f), 1.0f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> (kParamInput,    "Input Trim",
-                                                                   juce::NormalisableRange<float> (-18.0f, 18.0f, 0.1f), 0.0f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> (kParamOutput,   "Output Trim",
-                                                                   juce::NormalisableRange<float> (-18.0f, 18.0f, 0.1f), 0.0f));
-    params.push_back (std::make_unique<juce::AudioParameterBool>  (kParamBypass,   "Soft Bypass", false));
-
-    return { params.begin(), params.end() };
+    return gls::createParameterLayout (parameterTable);
 }
 
 EQDynBandAudioProcessorEditor::EQDynBandAudioProcessorEditor (EQDynBandAudioProcessor& p)
@@ -363,7 +367,6 @@ void EQDynBandAudioProcessor::ensureStateSize (int numChannels)
     {
         band1States.clear();
         band2States.clear();
-        dryBuffer.setSize (0, 0);
         return;
     }
 
@@ -392,7 +395,6 @@ void EQDynBandAudioProcessor::ensureStateSize (int numChannels)
 
     prepareBand (band1States, numChannels);
     prepareBand (band2States, numChannels);
-    dryBuffer.setSize (numChannels, (int) (lastBlockSize > 0 ? lastBlockSize : 512u), false, false, true);
 }
 
 void EQDynBandAudioProcessor::updateBandFilters (DynamicBand& bandState, float freq, float q)
@@ -402,8 +404,7 @@ void EQDynBandAudioProcessor::updateBandFilters (DynamicBand& bandState, float f
 
     const auto clampedFreq = juce::jlimit (40.0f, (float) (currentSampleRate * 0.49f), freq);
     const auto clampedQ    = juce::jlimit (0.2f, 10.0f, q);
-    auto coeffs = juce::dsp::IIR::Coefficients<float>::makeBandPass (currentSampleRate, clampedFreq, clampedQ);
-    bandState.filter.coefficients = coeffs;
+    bandState.filter.setBandPass (currentSampleRate, clampedFreq, clampedQ);
 }
 
 float EQDynBandAudioProcessor::computeGainDb (float envDb, float threshDb, float rangeDb) const
@@ -3,17 +3,28 @@
 #include <JuceHeader.h>
 #include <array>
 #include "../../DualPrecisionAudioProcessor.h"
+#include "../../ParameterTable.h"
+#include "../../SmoothedParameter.h"
+#include "../../dsp/Biquad.h"
+#include "../../dsp/DryWetStage.h"
+#include "../../dsp/SoftBypass.h"
 #include "../../ui/GoodluckLookAndFeel.h"
 
 class EQDynBandAudioProcessor : public DualPrecisionAudioProcessor
 {
 public:
+    enum class Param
+    {
+        band1Freq, band1Q, band1Thresh, band1Range, band2Freq, band2Q, band2Thresh,
+        band2Range, mix, inputTrim, outputTrim, bypass,
+        count
+    };
+
     EQDynBandAudioProcessor();
     ~EQDynBandAudioProcessor() override = default;
 
     void prepareToPlay (double sampleRate, int samplesPerBlock) override;
     void releaseResources() override;
-    void processBlock (juce::AudioBuffer<float>&, juce::MidiBuffer&) override;
 
     juce::AudioProcessorEditor* createEditor() override;
     bool hasEditor() const override { return true; }
@@ -22,7 +33,6 @@ public:
     bool acceptsMidi() const override { return false; }
     bool producesMidi() const override { return false; }
     bool isMidiEffect() const override { return false; }
-    double getTailLengthSeconds() const override { return 0.0; }
 
     int getNumPrograms() override;
     int getCurrentProgram() override { return currentPreset; }
@@ -36,18 +46,28 @@ public:
     juce::AudioProcessorValueTreeState& getValueTreeState() { return apvts; }
     static juce::AudioProcessorValueTreeState::ParameterLayout createParameterLayout();
 
+protected:
+    void processFloat (juce::AudioBuffer<float>&, juce::MidiBuffer&) override;
+    void updateTail() override;
+
 private:
     juce::AudioProcessorValueTreeState apvts;
+    gls::ParameterHandles<Param> params;
+    static constexpr float releaseMs = 120.0f;
+    gls::SmoothedParameter inputTrimGain  { params, Param::inputTrim,  gls::SmoothedParameter::Mapping::decibels };
+    gls::SmoothedParameter mixAmount      { params, Param::mix };
+    gls::SmoothedParameter outputTrimGain { params, Param::outputTrim, gls::SmoothedParameter::Mapping::decibels };
+    gls::dsp::SoftBypass bypass;
     struct DynamicBand
     {
-        juce::dsp::IIR::Filter<float> filter;
+        gls::dsp::Biquad filter;
         float envelope = 0.0f;
         float gain = 1.0f;
     };
 
     std::vector<DynamicBand> band1States;
     std::vector<DynamicBand> band2States;
-    juce::AudioBuffer<float> dryBuffer;
+    gls::dsp::DryWetStage dryWet;
     double currentSampleRate = 44100.0;
     juce::uint32 lastBlockSize = 512;
     int currentPreset = 0;
@@ -1,5 +1,28 @@
 #include "EQDynamicTiltProAudioProcessor.h"
 
+namespace
+{
+using Param = EQDynamicTiltProAudioProcessor::Param;
+using Spec = gls::ParameterSpec;
+
+constexpr std::array<Spec, (size_t) Param::count> parameterTable {{
+    Spec::range  ("tilt",          "Tilt",        -12.0f, 12.0f,   0.1f,   0.0f),
+    Spec::range  ("pivot_freq",    "Pivot Freq",  150.0f, 6000.0f, 0.01f,  1000.0f, 0.4f),
+    Spec::range  ("thresh",        "Threshold",   -60.0f, 0.0f,    0.1f,   -24.0f),
+    Spec::range  ("range",         "Range",       0.0f,   12.0f,   0.1f,   3.0f),
+    Spec::range  ("attack",        "Attack",      1.0f,   200.0f,  0.01f,  15.0f,   0.35f),
+    Spec::range  ("release",       "Release",     10.0f,  1000.0f, 0.01f,  200.0f,  0.35f),
+    Spec::range  ("output_trim",   "Output Trim", -12.0f, 12.0f,   0.1f,   0.0f),
+    Spec::range  ("mix",           "Mix",         0.0f,   1.0f,    0.001f, 1.0f),
+    Spec::range  ("input_trim",    "Input Trim",  -24.0f, 24.0f,   0.1f,   0.0f),
+    Spec::choice ("detector_mode", "Detector",    "Peak|RMS",           0),
+    Spec::choice ("shelf_style",   "Shelf Style", "Classic|Wide|Tight", 0),
+    Spec::toggle ("ui_bypass",     "Soft Bypass", false)
+}};
+
+static_assert (gls::hasUniqueIds (parameterTable));
+} // namespace
+
 const std::array<EQDynamicTiltProAudioProcessor::Preset, 3> EQDynamicTiltProAudioProcessor::presetBank {{
     { "Vocal Pop", {
         { "tilt",        3.0f },
@@ -49,17 +72,19 @@ EQDynamicTiltProAudioProcessor::EQDynamicTiltProAudioProcessor()
     : DualPrecisionAudioProcessor(BusesProperties()
                         .withInput  ("Input", juce::AudioChannelSet::stereo(), true)
                         .withOutput ("Output", juce::AudioChannelSet::stereo(), true)),
-      apvts (*this, nullptr, "DYNAMIC_TILT_PRO", createParameterLayout())
+      apvts (*this, nullptr, "DYNAMIC_TILT_PRO", createParameterLayout()),
+      params (apvts, parameterTable)
 {
+    bypass.snapOnResume (dryWet);
 }
 
 void EQDynamicTiltProAudioProcessor::prepareToPlay (double sampleRate, int samplesPerBlock)
 {
+    DualPrecisionAudioProcessor::prepareToPlay (sampleRate, samplesPerBlock);
+
     currentSampleRate = juce::jmax (sampleRate, 44100.0);
     lastBlockSize = (juce::uint32) juce::jmax (1, samplesPerBlock);
     ensureStateSize (getTotalNumOutputChannels());
-    dryBuffer.setSize (juce::jmax (1, getTotalNumOutputChannels()),
-                       (int) lastBlockSize, false, false, true);
 
     juce::dsp::ProcessSpec spec { currentSampleRate, lastBlockSize, 1 };
     auto prepareVector = [&](auto& vec)
@@ -74,15 +99,24 @@ void EQDynamicTiltProAudioProcessor::prepareToPlay (double sampleRate, int sampl
     prepareVector (lowShelves);
     prepareVector (highShelves);
     std::fill (envelopes.begin(), envelopes.end(), 0.0f);
+
+    for (auto* smoother : { &inputTrimGain, &mixAmount, &outputTrimGain })
+        smoother->prepare (currentSampleRate, (int) lastBlockSize);
+
+    dryWet.prepare (currentSampleRate, juce::jmax (1, getTotalNumOutputChannels()), (int) lastBlockSize);
+    bypass.prepare (sampleRate, juce::jmax (getTotalNumInputChannels(), getTotalNumOutputChannels()), samplesPerBlock);
 }
 
 void EQDynamicTiltProAudioProcessor::releaseResources()
 {
 }
 
-void EQDynamicTiltProAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer,
-                                                   juce::MidiBuffer&)
+void EQDynamicTiltProAudioProcessor::processFloat (juce::AudioBuffer<float>& buffer,
+                                                   juce::MidiBuffer& midi)
 {
+    if (renderInPreparedChunks (buffer, midi))
+        return;
+
     juce::ScopedNoDenormals noDenormals;
 
     auto totalIn  = getTotalNumInputChannels();
@@ -90,33 +124,25 @@ void EQDynamicTiltProAudioProcessor::processBlock (juce::AudioBuffer<float>& buf
     for (int ch = totalIn; ch < totalOut; ++ch)
         buffer.clear (ch, 0, buffer.getNumSamples());
 
-    const bool bypassed = apvts.getRawParameterValue ("ui_bypass")->load() > 0.5f;
-    if (bypassed)
+    const bool bypassed = params.isOn (Param::bypass);
+    if (! bypass.begin (buffer, buffer.getNumSamples(), bypassed))
         return;
 
-    auto get = [this](const char* id) { return apvts.getRawParameterValue (id)->load(); };
-
-    const auto tiltDb     = get ("tilt");
-    const auto pivotFreq  = get ("pivot_freq");
-    const auto threshDb   = get ("thresh");
-    const auto rangeDb    = get ("range");
-    const auto attackMs   = get ("attack");
-    const auto releaseMs  = get ("release");
-    const auto outputTrim = get ("output_trim");
-    const auto mix        = juce::jlimit (0.0f, 1.0f, get ("mix"));
-    const auto inputTrim  = juce::Decibels::decibelsToGain (get ("input_trim"));
-    const int detectorMode = (int) std::round (apvts.getRawParameterValue ("detector_mode")->load());
-    const int styleIndex   = (int) std::round (apvts.getRawParameterValue ("shelf_style")->load());
+    const auto tiltDb     = params[Param::tilt];
+    const auto pivotFreq  = params[Param::pivotFreq];
+    const auto threshDb   = params[Param::thresh];
+    const auto rangeDb    = params[Param::range];
+    const auto attackMs   = params[Param::attack];
+    const auto releaseMs  = params[Param::release];
+    const int detectorMode = params.getIndex (Param::detectorMode);
+    const int styleIndex   = params.getIndex (Param::shelfStyle);
 
     const int numChannels = buffer.getNumChannels();
     const int numSamples  = buffer.getNumSamples();
 
     lastBlockSize = (juce::uint32) juce::jmax (1, numSamples);
     ensureStateSize (numChannels);
-    dryBuffer.setSize (numChannels, numSamples, false, false, true);
-
-    buffer.applyGain (inputTrim);
-    dryBuffer.makeCopyOf (buffer, true);
+    dryWet.begin (buffer, numSamples, inputTrimGain, mixAmount);
 
     const float attackSeconds  = juce::jmax (1.0f, attackMs) * 0.001f;
     const float releaseSeconds = juce::jmax (5.0f, releaseMs) * 0.001f;
@@ -172,18 +198,14 @@ void EQDynamicTiltProAudioProcessor::processBlock (juce::AudioBuffer<float>& buf
         highShelves[ch].process (ctx);
     }
 
-    if (mix < 0.999f)
-    {
-        for (int ch = 0; ch < numChannels; ++ch)
-        {
-            const auto* dry = dryBuffer.getReadPointer (ch);
-            auto* data = buffer.getWritePointer (ch);
-            for (int i = 0; i < numSamples; ++i)
-                data[i] = data[i] * mix + dry[i] * (1.0f - mix);
-        }
-    }
+    dryWet.end (buffer, numSamples, mixAmount, outputTrimGain);
 
-    buffer.applyGain (juce::Decibels::decibelsToGain (outputTrim));
+    bypass.end (buffer, numSamples);
+}
+
+void EQDynamicTiltProAudioProcessor::updateTail()
+{
+    tail.setTail (0.0, gls::dsp::TailTracker::getEnvelopeRT60 (juce::jmax (5.0f, params[Param::release]) * 0.001));
 }
 
 int EQDynamicTiltProAudioProcessor::getNumPrograms()
@@ -224,33 +246,7 @@ void EQDynamicTiltProAudioProcessor::setStateInformation (const void* data, int
 juce::AudioProcessorValueTreeState::ParameterLayout
 EQDynamicTiltProAudioProcessor::createParameterLayout()
 {
-    std::vector<std::unique_ptr<juce::RangedAudioParameter>> params;
-
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("tilt",      "Tilt",
-                                                                   juce::NormalisableRange<float> (-12.0f, 12.0f, 0.1f), 0.0f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("pivot_freq","Pivot Freq",
-                                                                   juce::NormalisableRange<float> (150.0f, 6000.0f, 0.01f, 0.4f), 1000.0f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("thresh",    "Threshold",
-                                                                   juce::NormalisableRange<float> (-60.0f, 0.0f, 0.1f), -24.0f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("range",     "Range",
-                                                                   juce::NormalisableRange<float> (0.0f, 12.0f, 0.1f), 3.0f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("attack",    "Attack",
-                                                                   juce::NormalisableRange<float> (1.0f, 200.0f, 0.01f, 0.35f), 15.0f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("release",   "Release",
-                                                                   juce::NormalisableRange<float> (10.0f, 1000.0f, 0.01f, 0.35f), 200.0f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("output_trim","Output Trim",
-                                                                   juce::NormalisableRange<float> (-12.0f, 12.0f, 0.1f), 0.0f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("mix",       "Mix",
-                                                                   juce::NormalisableRange<float> (0.0f, 1.0f, 0.001f), 1.0f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("input_trim","Input Trim",
-                                                                   juce::NormalisableRange<float> (-24.0f, 24.0f, 0.1f), 0.0f));
-    params.push_back (std::make_unique<juce::AudioParameterChoice> ("detector_mode", "Detector",
-                                                                    juce::StringArray { "Peak", "RMS" }, 0));
-    params.push_back (std::make_unique<juce::AudioParameterChoice> ("shelf_style", "Shelf Style",
-                                                                    juce::StringArray { "Classic", "Wide", "Tight" }, 0));
-    params.push_back (std::make_unique<juce::AudioParameterBool>  ("ui_bypass", "Soft Bypass", false));
-
-    return { params.begin(), params.end() };
+    return gls::createParameterLayout (parameterTable);
 }
 
 struct TiltVisualComponent : public juce::Component, private juce::Timer
@@ -554,13 +550,10 @@ void EQDynamicTiltProAudioProcessor::updateFilters (float totalTiltDb, float piv
     const float lowGain  = juce::Decibels::decibelsToGain (-halfTilt);
     const float highGain = juce::Decibels::decibelsToGain (halfTilt);
 
-    auto lowCoeffs  = juce::dsp::IIR::Coefficients<float>::makeLowShelf  (currentSampleRate, limitedPivot, shelfQ, lowGain);
-    auto highCoeffs = juce::dsp::IIR::Coefficients<float>::makeHighShelf (currentSampleRate, limitedPivot, shelfQ, highGain);
-
     for (auto& filter : lowShelves)
-        filter.coefficients = lowCoeffs;
+        filter.setLowShelf (currentSampleRate, limitedPivot, shelfQ, lowGain);
     for (auto& filter : highShelves)
-        filter.coefficients = highCoeffs;
+        filter.setHighShelf (currentSampleRate, limitedPivot, shelfQ, highGain);
 }
 
 juce::AudioProcessor* JUCE_CALLTYPE createPluginFilter()
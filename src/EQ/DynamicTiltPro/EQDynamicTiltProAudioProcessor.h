@@ -3,17 +3,28 @@
 #include <JuceHeader.h>
 #include <array>
 #include "../../DualPrecisionAudioProcessor.h"
+#include "../../ParameterTable.h"
+#include "../../SmoothedParameter.h"
+#include "../../dsp/Biquad.h"
+#include "../../dsp/DryWetStage.h"
+#include "../../dsp/SoftBypass.h"
 #include "../../ui/GoodluckLookAndFeel.h"
 
 class EQDynamicTiltProAudioProcessor : public DualPrecisionAudioProcessor
 {
 public:
+    enum class Param
+    {
+        tilt, pivotFreq, thresh, range, attack, release, outputTrim, mix, inputTrim,
+        detectorMode, shelfStyle, bypass,
+        count
+    };
+
     EQDynamicTiltProAudioProcessor();
     ~EQDynamicTiltProAudioProcessor() override = default;
 
     void prepareToPlay (double sampleRate, int samplesPerBlock) override;
     void releaseResources() override;
-    void processBlock (juce::AudioBuffer<float>&, juce::MidiBuffer&) override;
 
     juce::AudioProcessorEditor* createEditor() override;
     bool hasEditor() const override { return true; }
@@ -22,7 +33,6 @@ public:
     bool acceptsMidi() const override { return false; }
     bool producesMidi() const override { return false; }
     bool isMidiEffect() const override { return false; }
-    double getTailLengthSeconds() const override { return 0.0; }
 
     int getNumPrograms() override;
     int getCurrentProgram() override { return currentPreset; }
@@ -40,14 +50,23 @@ public:
     float getEnvelopeDb() const noexcept    { return lastEnvelopeDb.load(); }
     float getThresholdDb() const noexcept   { return lastThresholdDb.load(); }
 
+protected:
+    void processFloat (juce::AudioBuffer<float>&, juce::MidiBuffer&) override;
+    void updateTail() override;
+
 private:
     juce::AudioProcessorValueTreeState apvts;
-    std::vector<juce::dsp::IIR::Filter<float>> lowShelves;
-    std::vector<juce::dsp::IIR::Filter<float>> highShelves;
+    gls::ParameterHandles<Param> params;
+    gls::SmoothedParameter inputTrimGain  { params, Param::inputTrim,  gls::SmoothedParameter::Mapping::decibels };
+    gls::SmoothedParameter mixAmount      { params, Param::mix };
+    gls::SmoothedParameter outputTrimGain { params, Param::outputTrim, gls::SmoothedParameter::Mapping::decibels };
+    gls::dsp::SoftBypass bypass;
+    std::vector<gls::dsp::Biquad> lowShelves;
+    std::vector<gls::dsp::Biquad> highShelves;
     std::vector<float> envelopes;
     double currentSampleRate = 44100.0;
     juce::uint32 lastBlockSize = 512;
-    juce::AudioBuffer<float> dryBuffer;
+    gls::dsp::DryWetStage dryWet;
     std::atomic<float> currentTilt { 0.0f };
     std::atomic<float> lastEnvelopeDb { -120.0f };
     std::atomic<float> lastThresholdDb { -24.0f };
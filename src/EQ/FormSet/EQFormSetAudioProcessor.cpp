@@ -6,6 +6,22 @@ constexpr auto kStateId     = "FORM_SET";
 constexpr auto kParamBypass = "ui_bypass";
 constexpr auto kParamInput  = "input_trim";
 constexpr auto kParamOutput = "output_trim";
+
+using Param = EQFormSetAudioProcessor::Param;
+using Spec = gls::ParameterSpec;
+
+constexpr std::array<Spec, (size_t) Param::count> parameterTable {{
+    Spec::range  ("formant_freq",  "Formant Freq",  200.0f, 4000.0f, 0.01f,  800.0f, 0.4f),
+    Spec::range  ("formant_width", "Formant Width", 0.1f,   2.0f,    0.001f, 0.5f),
+    Spec::range  ("movement",      "Movement",      0.0f,   1.0f,    0.001f, 0.3f),
+    Spec::range  ("intensity",     "Intensity",     0.0f,   1.0f,    0.001f, 0.5f),
+    Spec::range  ("mix",           "Mix",           0.0f,   1.0f,    0.001f, 1.0f),
+    Spec::range  (kParamInput,     "Input Trim",    -18.0f, 18.0f,   0.1f,   0.0f),
+    Spec::range  (kParamOutput,    "Output Trim",   -18.0f, 18.0f,   0.1f,   0.0f),
+    Spec::toggle (kParamBypass,    "Soft Bypass",   false)
+}};
+
+static_assert (gls::hasUniqueIds (parameterTable));
 }
 
 const std::array<EQFormSetAudioProcessor::Preset, 3> EQFormSetAudioProcessor::presetBank {{
@@ -45,15 +61,19 @@ EQFormSetAudioProcessor::EQFormSetAudioProcessor()
     : DualPrecisionAudioProcessor (BusesProperties()
                         .withInput  ("Input", juce::AudioChannelSet::stereo(), true)
                         .withOutput ("Output", juce::AudioChannelSet::stereo(), true)),
-      apvts (*this, nullptr, kStateId, createParameterLayout())
+      apvts (*this, nullptr, kStateId, createParameterLayout()),
+      params (apvts, parameterTable)
 {
+    bypass.snapOnResume (dryWet);
 }
 
 void EQFormSetAudioProcessor::prepareToPlay (double sampleRate, int samplesPerBlock)
 {
+    DualPrecisionAudioProcessor::prepareToPlay (sampleRate, samplesPerBlock);
+
     currentSampleRate = juce::jmax (sampleRate, 44100.0);
     lastBlockSize = (juce::uint32) juce::jmax (1, samplesPerBlock);
-    ensureStateSize (getTotalNumOutputChannels());
+    ensureStateSize (juce::jmax (getTotalNumInputChannels(), getTotalNumOutputChannels()));
 
     juce::dsp::ProcessSpec spec { currentSampleRate, lastBlockSize, 1 };
     for (auto& formant : formantFilters)
@@ -62,15 +82,24 @@ void EQFormSetAudioProcessor::prepareToPlay (double sampleRate, int samplesPerBl
         formant.filter.reset();
         formant.phase = 0.0f;
     }
+
+    for (auto* smoother : { &inputTrimGain, &mixAmount, &outputTrimGain })
+        smoother->prepare (sampleRate, samplesPerBlock);
+
+    dryWet.prepare (sampleRate, juce::jmax (getTotalNumInputChannels(), getTotalNumOutputChannels()), samplesPerBlock);
+    bypass.prepare (sampleRate, juce::jmax (getTotalNumInputChannels(), getTotalNumOutputChannels()), samplesPerBlock);
 }
 
 void EQFormSetAudioProcessor::releaseResources()
 {
 }
 
-void EQFormSetAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer,
-                                            juce::MidiBuffer&)
+void EQFormSetAudioProcessor::processFloat (juce::AudioBuffer<float>& buffer,
+                                            juce::MidiBuffer& midi)
 {
+    if (renderInPreparedChunks (buffer, midi))
+        return;
+
     juce::ScopedNoDenormals noDenormals;
 
     auto totalIn  = getTotalNumInputChannels();
@@ -78,26 +107,22 @@ void EQFormSetAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer,
     for (int ch = totalIn; ch < totalOut; ++ch)
         buffer.clear (ch, 0, buffer.getNumSamples());
 
-    auto get = [this](const char* id) { return apvts.getRawParameterValue (id)->load(); };
-
-    const float formantFreq  = get ("formant_freq");
-    const float formantWidth = juce::jlimit (0.1f, 2.0f, get ("formant_width"));
-    const float movement     = juce::jlimit (0.0f, 1.0f, get ("movement"));
-    const float intensity    = juce::jlimit (0.0f, 1.0f, get ("intensity"));
-    const float mix          = juce::jlimit (0.0f, 1.0f, get ("mix"));
-    const float inputGain    = juce::Decibels::decibelsToGain (get (kParamInput));
-    const float outputGain   = juce::Decibels::decibelsToGain (get (kParamOutput));
-    const bool bypassed      = get (kParamBypass) > 0.5f;
+    const float formantFreq  = params[Param::formantFreq];
+    const float formantWidth = juce::jlimit (0.1f, 2.0f, params[Param::formantWidth]);
+    const float movement     = juce::jlimit (0.0f, 1.0f, params[Param::movement]);
+    const float intensity    = juce::jlimit (0.0f, 1.0f, params[Param::intensity]);
+    const bool bypassed      = params.isOn (Param::bypass);
 
     const int numChannels = buffer.getNumChannels();
     const int numSamples  = buffer.getNumSamples();
 
     lastBlockSize = (juce::uint32) juce::jmax (1, numSamples);
     ensureStateSize (numChannels);
-    dryBuffer.makeCopyOf (buffer, true);
-
-    buffer.applyGain (inputGain);
-    if (bypassed)
+    // The dry signal is taken before the input trim, which only feeds the formant.
+    dryWet.begin (buffer, numSamples, mixAmount);
+    inputTrimGain.update();
+    inputTrimGain.applyGain (buffer, numSamples);
+    if (! bypass.begin (buffer, numSamples, bypassed))
         return;
 
     updateFormantFilters (formantFreq, formantWidth, movement);
@@ -108,7 +133,6 @@ void EQFormSetAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer,
     for (int ch = 0; ch < numChannels; ++ch)
     {
         auto* data = buffer.getWritePointer (ch);
-        auto* dry  = dryBuffer.getReadPointer (ch);
         auto& formant = formantFilters[(size_t) ch];
 
         for (int i = 0; i < numSamples; ++i)
@@ -117,7 +141,7 @@ void EQFormSetAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer,
             const float modInput = data[i] + mod * 0.02f;
             const float modulated = formant.filter.processSample (modInput);
             const float enhanced = modulated * juce::Decibels::decibelsToGain (intensityGainDb * std::abs (mod));
-            data[i] = (enhanced * mix + dry[i] * (1.0f - mix)) * outputGain;
+            data[i] = enhanced;
 
             formant.phase += (juce::MathConstants<float>::twoPi * (formantFreq + modulationDepth * mod))
                              / static_cast<float> (currentSampleRate);
@@ -125,6 +149,9 @@ void EQFormSetAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer,
                 formant.phase -= juce::MathConstants<float>::twoPi;
         }
     }
+
+    dryWet.end (buffer, numSamples, mixAmount, outputTrimGain);
+    bypass.end (buffer, numSamples);
 }
 
 void EQFormSetAudioProcessor::getStateInformation (juce::MemoryBlock& destData)
@@ -145,25 +172,7 @@ void EQFormSetAudioProcessor::setStateInformation (const void* data, int sizeInB
 juce::AudioProcessorValueTreeState::ParameterLayout
 EQFormSetAudioProcessor::createParameterLayout()
 {
-    std::vector<std::unique_ptr<juce::RangedAudioParameter>> params;
-
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("formant_freq",  "Formant Freq",
-                                                                   juce::NormalisableRange<float> (200.0f, 4000.0f, 0.01f, 0.4f), 800.0f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("formant_width", "Formant Width",
-                                                                   juce::NormalisableRange<float> (0.1f, 2.0f, 0.001f), 0.5f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("movement",     "Movement",
-                                                                   juce::NormalisableRange<float> (0.0f, 1.0f, 0.001f), 0.3f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("intensity",    "Intensity",
-                                                                   juce::NormalisableRange<float> (0.0f, 1.0f, 0.001f), 0.5f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("mix",          "Mix",
-                                                                   juce::NormalisableRange<float> (0.0f, 1.0f, 0.001f), 1.0f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> (kParamInput,    "Input Trim",
-                                                                   juce::NormalisableRange<float> (-18.0f, 18.0f, 0.1f), 0.0f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> (kParamOutput,   "Output Trim",
-                                                                   juce::NormalisableRange<float> (-18.0f, 18.0f, 0.1f), 0.0f));
-    params.push_back (std::make_unique<juce::AudioParameterBool>  (kParamBypass,   "Soft Bypass", false));
-
-    return { params.begin(), params.end() };
+    return gls::createParameterLayout (parameterTable);
 }
 
 EQFormSetAudioProcessorEditor::EQFormSetAudioProcessorEditor (EQFormSetAudioProcessor& p)
@@ -286,7 +295,6 @@ void EQFormSetAudioProcessor::ensureStateSize (int numChannels)
     if (numChannels <= 0)
     {
         formantFilters.clear();
-        dryBuffer.setSize (0, 0);
         return;
     }
 
@@ -305,8 +313,6 @@ void EQFormSetAudioProcessor::ensureStateSize (int numChannels)
             formantFilters[(size_t) ch].phase = 0.0f;
         }
     }
-
-    dryBuffer.setSize (numChannels, (int) (lastBlockSize > 0 ? lastBlockSize : 512u), false, false, true);
 }
 
 void EQFormSetAudioProcessor::updateFormantFilters (float baseFreq, float width, float movement)
@@ -316,9 +322,8 @@ void EQFormSetAudioProcessor::updateFormantFilters (float baseFreq, float width,
 
     const float freq = juce::jlimit (200.0f, (float) (currentSampleRate * 0.45f), baseFreq);
     const float bandwidth = juce::jlimit (0.2f, 5.0f, width * (1.0f + movement));
-    auto coeffs = juce::dsp::IIR::Coefficients<float>::makeBandPass (currentSampleRate, freq, bandwidth);
     for (auto& formant : formantFilters)
-        formant.filter.coefficients = coeffs;
+        formant.filter.setBandPass (currentSampleRate, freq, bandwidth);
 }
 
 int EQFormSetAudioProcessor::getNumPrograms()
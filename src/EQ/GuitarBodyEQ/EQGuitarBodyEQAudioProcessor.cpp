@@ -1,15 +1,34 @@
 #include "EQGuitarBodyEQAudioProcessor.h"
 
+namespace
+{
+using Param = EQGuitarBodyEQAudioProcessor::Param;
+using Spec = gls::ParameterSpec;
+
+constexpr std::array<Spec, (size_t) Param::count> parameterTable {{
+    Spec::range ("body_freq",   "Body Freq",   80.0f,  500.0f, 0.01f, 180.0f, 0.4f),
+    Spec::range ("body_gain",   "Body Gain",   -12.0f, 12.0f,  0.1f,  0.0f),
+    Spec::range ("mud_cut",     "Mud Cut",     80.0f,  400.0f, 0.01f, 200.0f, 0.4f),
+    Spec::range ("pick_attack", "Pick Attack", -6.0f,  6.0f,   0.1f,  0.0f),
+    Spec::range ("air_lift",    "Air Lift",    -6.0f,  6.0f,   0.1f,  0.0f)
+}};
+
+static_assert (gls::hasUniqueIds (parameterTable));
+} // namespace
+
 EQGuitarBodyEQAudioProcessor::EQGuitarBodyEQAudioProcessor()
     : DualPrecisionAudioProcessor(BusesProperties()
                         .withInput  ("Input", juce::AudioChannelSet::stereo(), true)
                         .withOutput ("Output", juce::AudioChannelSet::stereo(), true)),
-      apvts (*this, nullptr, "GUITAR_BODY_EQ", createParameterLayout())
+      apvts (*this, nullptr, "GUITAR_BODY_EQ", createParameterLayout()),
+      params (apvts, parameterTable)
 {
 }
 
 void EQGuitarBodyEQAudioProcessor::prepareToPlay (double sampleRate, int samplesPerBlock)
 {
+    DualPrecisionAudioProcessor::prepareToPlay (sampleRate, samplesPerBlock);
+
     currentSampleRate = juce::jmax (sampleRate, 44100.0);
     lastBlockSize = (juce::uint32) juce::jmax (1, samplesPerBlock);
     ensureFilterState (getTotalNumOutputChannels());
@@ -34,7 +53,7 @@ void EQGuitarBodyEQAudioProcessor::releaseResources()
 {
 }
 
-void EQGuitarBodyEQAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer,
+void EQGuitarBodyEQAudioProcessor::processFloat (juce::AudioBuffer<float>& buffer,
                                                  juce::MidiBuffer&)
 {
     juce::ScopedNoDenormals noDenormals;
@@ -44,13 +63,11 @@ void EQGuitarBodyEQAudioProcessor::processBlock (juce::AudioBuffer<float>& buffe
     for (int ch = totalIn; ch < totalOut; ++ch)
         buffer.clear (ch, 0, buffer.getNumSamples());
 
-    auto get = [this](const char* id) { return apvts.getRawParameterValue (id)->load(); };
-
-    const auto bodyFreq   = get ("body_freq");
-    const auto bodyGain   = get ("body_gain");
-    const auto mudCutFreq = get ("mud_cut");
-    const auto pickAttack = get ("pick_attack");
-    const auto airLift    = get ("air_lift");
+    const auto bodyFreq   = params[Param::bodyFreq];
+    const auto bodyGain   = params[Param::bodyGain];
+    const auto mudCutFreq = params[Param::mudCut];
+    const auto pickAttack = params[Param::pickAttack];
+    const auto airLift    = params[Param::airLift];
 
     const int numChannels = buffer.getNumChannels();
     const int numSamples  = buffer.getNumSamples();
@@ -87,20 +104,7 @@ void EQGuitarBodyEQAudioProcessor::setStateInformation (const void* data, int si
 juce::AudioProcessorValueTreeState::ParameterLayout
 EQGuitarBodyEQAudioProcessor::createParameterLayout()
 {
-    std::vector<std::unique_ptr<juce::RangedAudioParameter>> params;
-
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("body_freq",   "Body Freq",
-                                                                   juce::NormalisableRange<float> (80.0f, 500.0f, 0.01f, 0.4f), 180.0f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("body_gain",   "Body Gain",
-                                                                   juce::NormalisableRange<float> (-12.0f, 12.0f, 0.1f), 0.0f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("mud_cut",     "Mud Cut",
-                                                                   juce::NormalisableRange<float> (80.0f, 400.0f, 0.01f, 0.4f), 200.0f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("pick_attack", "Pick Attack",
-                                                                   juce::NormalisableRange<float> (-6.0f, 6.0f, 0.1f), 0.0f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("air_lift",    "Air Lift",
-                                                                   juce::NormalisableRange<float> (-6.0f, 6.0f, 0.1f), 0.0f));
-
-    return { params.begin(), params.end() };
+    return gls::createParameterLayout (parameterTable);
 }
 
 EQGuitarBodyEQAudioProcessorEditor::EQGuitarBodyEQAudioProcessorEditor (EQGuitarBodyEQAudioProcessor& p)
@@ -191,30 +195,20 @@ void EQGuitarBodyEQAudioProcessor::updateFilters (float bodyFreq, float bodyGain
     if (currentSampleRate <= 0.0)
         return;
 
-    const auto bodyCoeffs = juce::dsp::IIR::Coefficients<float>::makePeakFilter (currentSampleRate,
-                                                                                 juce::jlimit (80.0f, 500.0f, bodyFreq),
-                                                                                 0.7f,
-                                                                                 juce::Decibels::decibelsToGain (bodyGain));
-    const auto mudCoeffs = juce::dsp::IIR::Coefficients<float>::makeNotch (currentSampleRate,
-                                                                           juce::jlimit (80.0f, 500.0f, mudCutFreq),
-                                                                           1.5f);
-    const auto pickCoeffs = juce::dsp::IIR::Coefficients<float>::makeHighShelf (currentSampleRate,
-                                                                                2500.0f,
-                                                                                0.7f,
-                                                                                juce::Decibels::decibelsToGain (pickGain));
-    const auto airCoeffs = juce::dsp::IIR::Coefficients<float>::makeHighShelf (currentSampleRate,
-                                                                               8000.0f,
-                                                                               0.7f,
-                                                                               juce::Decibels::decibelsToGain (airGain));
+    const auto clampedBodyFreq = juce::jlimit (80.0f, 500.0f, bodyFreq);
+    const auto clampedMudFreq  = juce::jlimit (80.0f, 500.0f, mudCutFreq);
+    const auto bodyGainLinear  = juce::Decibels::decibelsToGain (bodyGain);
+    const auto pickGainLinear  = juce::Decibels::decibelsToGain (pickGain);
+    const auto airGainLinear   = juce::Decibels::decibelsToGain (airGain);
 
     for (auto& filter : bodyFilters)
-        filter.coefficients = bodyCoeffs;
+        filter.setPeak (currentSampleRate, clampedBodyFreq, 0.7f, bodyGainLinear);
     for (auto& filter : mudFilters)
-        filter.coefficients = mudCoeffs;
+        filter.setNotch (currentSampleRate, clampedMudFreq, 1.5f);
     for (auto& filter : pickFilters)
-        filter.coefficients = pickCoeffs;
+        filter.setHighShelf (currentSampleRate, 2500.0f, 0.7f, pickGainLinear);
     for (auto& filter : airFilters)
-        filter.coefficients = airCoeffs;
+        filter.setHighShelf (currentSampleRate, 8000.0f, 0.7f, airGainLinear);
 }
 
 juce::AudioProcessor* JUCE_CALLTYPE createPluginFilter()
@@ -1,17 +1,25 @@
 #pragma once
 
 #include <JuceHeader.h>
+#include <array>
 #include "../../DualPrecisionAudioProcessor.h"
+#include "../../ParameterTable.h"
+#include "../../dsp/Biquad.h"
 
 class EQGuitarBodyEQAudioProcessor : public DualPrecisionAudioProcessor
 {
 public:
+    enum class Param
+    {
+        bodyFreq, bodyGain, mudCut, pickAttack, airLift,
+        count
+    };
+
     EQGuitarBodyEQAudioProcessor();
     ~EQGuitarBodyEQAudioProcessor() override = default;
 
     void prepareToPlay (double sampleRate, int samplesPerBlock) override;
     void releaseResources() override;
-    void processBlock (juce::AudioBuffer<float>&, juce::MidiBuffer&) override;
 
     juce::AudioProcessorEditor* createEditor() override;
     bool hasEditor() const override { return true; }
@@ -20,7 +28,6 @@ public:
     bool acceptsMidi() const override { return false; }
     bool producesMidi() const override { return false; }
     bool isMidiEffect() const override { return false; }
-    double getTailLengthSeconds() const override { return 0.0; }
 
     int getNumPrograms() override { return 1; }
     int getCurrentProgram() override { return 0; }
@@ -34,12 +41,16 @@ public:
     juce::AudioProcessorValueTreeState& getValueTreeState() { return apvts; }
     static juce::AudioProcessorValueTreeState::ParameterLayout createParameterLayout();
 
+protected:
+    void processFloat (juce::AudioBuffer<float>&, juce::MidiBuffer&) override;
+
 private:
     juce::AudioProcessorValueTreeState apvts;
-    std::vector<juce::dsp::IIR::Filter<float>> bodyFilters;
-    std::vector<juce::dsp::IIR::Filter<float>> mudFilters;
-    std::vector<juce::dsp::IIR::Filter<float>> pickFilters;
-    std::vector<juce::dsp::IIR::Filter<float>> airFilters;
+    gls::ParameterHandles<Param> params;
+    std::vector<gls::dsp::Biquad> bodyFilters;
+    std::vector<gls::dsp::Biquad> mudFilters;
+    std::vector<gls::dsp::Biquad> pickFilters;
+    std::vector<gls::dsp::Biquad> airFilters;
     double currentSampleRate = 44100.0;
     juce::uint32 lastBlockSize = 512;
 
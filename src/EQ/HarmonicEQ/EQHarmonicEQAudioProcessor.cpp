@@ -1,5 +1,21 @@
 #include "EQHarmonicEQAudioProcessor.h"
 
+namespace
+{
+using Param = EQHarmonicEQAudioProcessor::Param;
+using Spec = gls::ParameterSpec;
+
+constexpr std::array<Spec, (size_t) Param::count> parameterTable {{
+    Spec::range  ("band_freq", "Band Freq", 40.0f,  20000.0f, 0.01f,  2000.0f, 0.4f),
+    Spec::range  ("band_gain", "Band Gain", -18.0f, 18.0f,    0.1f,   0.0f),
+    Spec::range  ("band_q",    "Band Q",    0.2f,   10.0f,    0.001f, 1.0f,    0.5f),
+    Spec::choice ("harm_type", "Harm Type", "Odd|Even|Hybrid", 2),
+    Spec::range  ("mix",       "Mix",       0.0f,   1.0f,     0.001f, 1.0f)
+}};
+
+static_assert (gls::hasUniqueIds (parameterTable));
+} // namespace
+
 const std::array<EQHarmonicEQAudioProcessor::Preset, 3> EQHarmonicEQAudioProcessor::presetBank {{
     { "Vocal Air", {
         { "band_freq", 4500.0f },
@@ -28,15 +44,19 @@ EQHarmonicEQAudioProcessor::EQHarmonicEQAudioProcessor()
     : DualPrecisionAudioProcessor(BusesProperties()
                         .withInput  ("Input", juce::AudioChannelSet::stereo(), true)
                         .withOutput ("Output", juce::AudioChannelSet::stereo(), true)),
-      apvts (*this, nullptr, "HARMONIC_EQ", createParameterLayout())
+      apvts (*this, nullptr, "HARMONIC_EQ", createParameterLayout()),
+      params (apvts, parameterTable)
 {
 }
 
 void EQHarmonicEQAudioProcessor::prepareToPlay (double sampleRate, int samplesPerBlock)
 {
+    DualPrecisionAudioProcessor::prepareToPlay (sampleRate, samplesPerBlock);
+
     currentSampleRate = juce::jmax (sampleRate, 44100.0);
     lastBlockSize = (juce::uint32) juce::jmax (1, samplesPerBlock);
     ensureStateSize (getTotalNumOutputChannels());
+    mixAmount.prepare (currentSampleRate, samplesPerBlock);
 
     juce::dsp::ProcessSpec spec { currentSampleRate, lastBlockSize, 1 };
     for (auto& band : harmonicBands)
@@ -52,9 +72,12 @@ void EQHarmonicEQAudioProcessor::releaseResources()
 {
 }
 
-void EQHarmonicEQAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer,
-                                               juce::MidiBuffer&)
+void EQHarmonicEQAudioProcessor::processFloat (juce::AudioBuffer<float>& buffer,
+                                               juce::MidiBuffer& midi)
 {
+    if (renderInPreparedChunks (buffer, midi))
+        return;
+
     juce::ScopedNoDenormals noDenormals;
 
     const auto totalIn  = getTotalNumInputChannels();
@@ -62,36 +85,37 @@ void EQHarmonicEQAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer,
     for (int ch = totalIn; ch < totalOut; ++ch)
         buffer.clear (ch, 0, buffer.getNumSamples());
 
-    auto get = [this](const char* id) { return apvts.getRawParameterValue (id)->load(); };
-
-    const auto freq     = get ("band_freq");
-    const auto gainDb   = get ("band_gain");
-    const auto q        = get ("band_q");
-    const auto harmType = static_cast<int> (apvts.getRawParameterValue ("harm_type")->load());
-    const auto mix      = juce::jlimit (0.0f, 1.0f, get ("mix"));
+    const auto freq     = params[Param::bandFreq];
+    const auto gainDb   = params[Param::bandGain];
+    const auto q        = params[Param::bandQ];
+    const auto harmType = params.getIndex (Param::harmType);
 
     const int numChannels = buffer.getNumChannels();
     const int numSamples  = buffer.getNumSamples();
 
     lastBlockSize = (juce::uint32) juce::jmax (1, numSamples);
     ensureStateSize (numChannels);
-    dryBuffer.makeCopyOf (buffer, true);
     updateFilters (freq, q, gainDb, harmType);
 
     const float harmonicBlend = harmType == 0 ? 0.6f : (harmType == 1 ? 0.5f : 0.4f);
 
+    mixAmount.update();
+    const auto* mixes = mixAmount.advance (numSamples);
+    const auto mix = mixAmount.getCurrentValue();
+
     for (int ch = 0; ch < numChannels; ++ch)
     {
         auto* data = buffer.getWritePointer (ch);
-        auto* dry  = dryBuffer.getReadPointer (ch);
         auto& band = harmonicBands[ch];
 
         for (int i = 0; i < numSamples; ++i)
         {
-            const float baseSample = band.base.processSample (dry[i]);
-            const float harmonicSample = band.harmonic.processSample (dry[i]);
+            const float dry = data[i];
+            const float baseSample = band.base.processSample (dry);
+            const float harmonicSample = band.harmonic.processSample (dry);
             const float combined = juce::jlimit (-2.0f, 2.0f, baseSample + harmonicBlend * harmonicSample);
-            data[i] = combined * mix + dry[i] * (1.0f - mix);
+            const float amount = mixes != nullptr ? mixes[i] : mix;
+            data[i] = combined * amount + dry * (1.0f - amount);
         }
     }
 }
@@ -112,20 +136,7 @@ void EQHarmonicEQAudioProcessor::setStateInformation (const void* data, int size
 juce::AudioProcessorValueTreeState::ParameterLayout
 EQHarmonicEQAudioProcessor::createParameterLayout()
 {
-    std::vector<std::unique_ptr<juce::RangedAudioParameter>> params;
-
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("band_freq", "Band Freq",
-                                                                   juce::NormalisableRange<float> (40.0f, 20000.0f, 0.01f, 0.4f), 2000.0f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("band_gain", "Band Gain",
-                                                                   juce::NormalisableRange<float> (-18.0f, 18.0f, 0.1f), 0.0f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("band_q",    "Band Q",
-                                                                   juce::NormalisableRange<float> (0.2f, 10.0f, 0.001f, 0.5f), 1.0f));
-    params.push_back (std::make_unique<juce::AudioParameterChoice> ("harm_type","Harm Type",
-                                                                    juce::StringArray { "Odd", "Even", "Hybrid" }, 2));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("mix",       "Mix",
-                                                                   juce::NormalisableRange<float> (0.0f, 1.0f, 0.001f), 1.0f));
-
-    return { params.begin(), params.end() };
+    return gls::createParameterLayout (parameterTable);
 }
 
 EQHarmonicEQAudioProcessorEditor::EQHarmonicEQAudioProcessorEditor (EQHarmonicEQAudioProcessor& p)
@@ -242,13 +253,10 @@ void EQHarmonicEQAudioProcessor::updateFilters (float freq, float q, float gainD
     const auto harmonicFreq = juce::jlimit (clampedFreq, (float) (currentSampleRate * 0.49f), clampedFreq * harmonicMultiple);
     const auto harmonicQ    = clampedQ * 0.7f;
 
-    auto baseCoeffs     = juce::dsp::IIR::Coefficients<float>::makePeakFilter (currentSampleRate, clampedFreq, clampedQ, gainLinear);
-    auto harmonicCoeffs = juce::dsp::IIR::Coefficients<float>::makePeakFilter (currentSampleRate, harmonicFreq, harmonicQ, gainLinear);
-
     for (auto& band : harmonicBands)
     {
-        band.base.coefficients = baseCoeffs;
-        band.harmonic.coefficients = harmonicCoeffs;
+        band.base.setPeak (currentSampleRate, clampedFreq, clampedQ, gainLinear);
+        band.harmonic.setPeak (currentSampleRate, harmonicFreq, harmonicQ, gainLinear);
     }
 }
 
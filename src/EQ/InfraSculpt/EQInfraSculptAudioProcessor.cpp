@@ -1,27 +1,51 @@
 #include "EQInfraSculptAudioProcessor.h"
 
+namespace
+{
+using Param = EQInfraSculptAudioProcessor::Param;
+using Spec = gls::ParameterSpec;
+
+constexpr std::array<Spec, (size_t) Param::count> parameterTable {{
+    Spec::range ("sub_hpf",       "Sub HPF",       20.0f,  80.0f,  0.01f,  30.0f, 0.4f),
+    Spec::range ("infra_slope",   "Infra Slope",   6.0f,   48.0f,  6.0f,   24.0f),
+    Spec::range ("sub_resonance", "Sub Resonance", 0.0f,   1.0f,   0.001f, 0.3f),
+    Spec::range ("mono_below",    "Mono Below",    40.0f,  200.0f, 0.01f,  90.0f, 0.35f),
+    Spec::range ("output_trim",   "Output Trim",   -12.0f, 12.0f,  0.1f,   0.0f)
+}};
+
+static_assert (gls::hasUniqueIds (parameterTable));
+} // namespace
+
 EQInfraSculptAudioProcessor::EQInfraSculptAudioProcessor()
     : DualPrecisionAudioProcessor(BusesProperties()
                         .withInput  ("Input", juce::AudioChannelSet::stereo(), true)
                         .withOutput ("Output", juce::AudioChannelSet::stereo(), true)),
-      apvts (*this, nullptr, "INFRA_SCULPT", createParameterLayout())
+      apvts (*this, nullptr, "INFRA_SCULPT", createParameterLayout()),
+      params (apvts, parameterTable)
 {
 }
 
 void EQInfraSculptAudioProcessor::prepareToPlay (double sampleRate, int samplesPerBlock)
 {
+    DualPrecisionAudioProcessor::prepareToPlay (sampleRate, samplesPerBlock);
+
     currentSampleRate = juce::jmax (sampleRate, 44100.0);
     lastBlockSize = (juce::uint32) juce::jmax (1, samplesPerBlock);
     ensureStateSize (getTotalNumOutputChannels(), 4);
+    monoBuffer.setSize (2, (int) lastBlockSize);
+    outputTrimGain.prepare (currentSampleRate, (int) lastBlockSize);
 }
 
 void EQInfraSculptAudioProcessor::releaseResources()
 {
 }
 
-void EQInfraSculptAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer,
-                                                juce::MidiBuffer&)
+void EQInfraSculptAudioProcessor::processFloat (juce::AudioBuffer<float>& buffer,
+                                                juce::MidiBuffer& midi)
 {
+    if (renderInPreparedChunks (buffer, midi))
+        return;
+
     juce::ScopedNoDenormals noDenormals;
 
     auto totalIn  = getTotalNumInputChannels();
@@ -29,13 +53,10 @@ void EQInfraSculptAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer
     for (int ch = totalIn; ch < totalOut; ++ch)
         buffer.clear (ch, 0, buffer.getNumSamples());
 
-    auto get = [this](const char* id) { return apvts.getRawParameterValue (id)->load(); };
-
-    const auto subHpf      = get ("sub_hpf");
-    const auto infraSlope  = get ("infra_slope");
-    const auto subResonance= get ("sub_resonance");
-    const auto monoBelow   = get ("mono_below");
-    const auto outputTrim  = get ("output_trim");
+    const auto subHpf      = params[Param::subHpf];
+    const auto infraSlope  = params[Param::infraSlope];
+    const auto subResonance= params[Param::subResonance];
+    const auto monoBelow   = params[Param::monoBelow];
 
     const int stageCount = juce::jlimit (1, 8, (int) std::round (infraSlope / 6.0f));
     const int numChannels = buffer.getNumChannels();
@@ -46,8 +67,11 @@ void EQInfraSculptAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer
     ensureStateSize (numChannels, stageCount);
     updateFilters (subHpf, stageCount, subResonance, monoBelow);
 
-    monoBuffer.setSize (numChannels, numSamples, false, false, true);
-    monoBuffer.makeCopyOf (buffer, true);
+    // Only the first two channels fold to mono; their input is kept for the low band.
+    const auto folding = numChannels >= 2;
+    if (folding)
+        for (int ch = 0; ch < 2; ++ch)
+            monoBuffer.copyFrom (ch, 0, buffer, ch, 0, numSamples);
 
     juce::dsp::AudioBlock<float> block (buffer);
     for (int ch = 0; ch < numChannels; ++ch)
@@ -63,34 +87,44 @@ void EQInfraSculptAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer
         resonanceFilters[ch].process (resCtx);
     }
 
+    // The output trim rides in the mono fold's pass; it only renders per-sample gains
+    // while it moves.
+    outputTrimGain.update();
+    const auto* trims = outputTrimGain.advance (numSamples);
+    const auto trimGain = outputTrimGain.getCurrentValue();
+
     // Mono below threshold
-    if (numChannels >= 2)
+    if (folding)
     {
-        juce::dsp::AudioBlock<float> monoBlock (monoBuffer);
-        for (int ch = 0; ch < numChannels; ++ch)
+        auto monoBlock = juce::dsp::AudioBlock<float> (monoBuffer).getSubBlock (0, (size_t) numSamples);
+        for (int ch = 0; ch < 2; ++ch)
         {
             auto monoChannel = monoBlock.getSingleChannelBlock ((size_t) ch);
             juce::dsp::ProcessContextReplacing<float> ctx (monoChannel);
             monoLowFilters[ch].process (ctx);
         }
 
+        auto* left  = buffer.getWritePointer (0);
+        auto* right = buffer.getWritePointer (1);
+        const auto* lowLeft  = monoBuffer.getReadPointer (0);
+        const auto* lowRight = monoBuffer.getReadPointer (1);
+
         for (int i = 0; i < numSamples; ++i)
         {
-            float monoSample = 0.0f;
-            for (int ch = 0; ch < juce::jmin (2, numChannels); ++ch)
-                monoSample += monoBuffer.getReadPointer (ch)[i];
-            monoSample *= 0.5f;
-
-            for (int ch = 0; ch < juce::jmin (2, numChannels); ++ch)
-            {
-                auto* data = buffer.getWritePointer (ch);
-                float lowOnly = monoBuffer.getReadPointer (ch)[i];
-                data[i] += (monoSample - lowOnly);
-            }
+            const float monoSample = 0.5f * (lowLeft[i] + lowRight[i]);
+            const float gain = trims != nullptr ? trims[i] : trimGain;
+            left[i]  = (left[i]  + (monoSample - lowLeft[i]))  * gain;
+            right[i] = (right[i] + (monoSample - lowRight[i])) * gain;
         }
     }
 
-    buffer.applyGain (juce::Decibels::decibelsToGain (outputTrim));
+    for (int ch = folding ? 2 : 0; ch < numChannels; ++ch)
+    {
+        if (trims != nullptr)
+            juce::FloatVectorOperations::multiply (buffer.getWritePointer (ch), trims, numSamples);
+        else if (trimGain != 1.0f)
+            buffer.applyGain (ch, 0, numSamples, trimGain);
+    }
 }
 
 void EQInfraSculptAudioProcessor::getStateInformation (juce::MemoryBlock& destData)
@@ -109,20 +143,7 @@ void EQInfraSculptAudioProcessor::setStateInformation (const void* data, int siz
 juce::AudioProcessorValueTreeState::ParameterLayout
 EQInfraSculptAudioProcessor::createParameterLayout()
 {
-    std::vector<std::unique_ptr<juce::RangedAudioParameter>> params;
-
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("sub_hpf",      "Sub HPF",
-                                                                   juce::NormalisableRange<float> (20.0f, 80.0f, 0.01f, 0.4f), 30.0f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("infra_slope",  "Infra Slope",
-                                                                   juce::NormalisableRange<float> (6.0f, 48.0f, 6.0f), 24.0f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("sub_resonance","Sub Resonance",
-                                                                   juce::NormalisableRange<float> (0.0f, 1.0f, 0.001f), 0.3f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("mono_below",   "Mono Below",
-                                                                   juce::NormalisableRange<float> (40.0f, 200.0f, 0.01f, 0.35f), 90.0f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("output_trim",  "Output Trim",
-                                                                   juce::NormalisableRange<float> (-12.0f, 12.0f, 0.1f), 0.0f));
-
-    return { params.begin(), params.end() };
+    return gls::createParameterLayout (parameterTable);
 }
 
 EQInfraSculptAudioProcessorEditor::EQInfraSculptAudioProcessorEditor (EQInfraSculptAudioProcessor& p)
@@ -234,26 +255,20 @@ void EQInfraSculptAudioProcessor::updateFilters (float subHpf, int stageCount, f
         return;
 
     const auto cutoff = juce::jlimit (20.0f, (float) (currentSampleRate * 0.3f), subHpf);
-    auto hpCoeffs = juce::dsp::IIR::Coefficients<float>::makeHighPass (currentSampleRate, cutoff, 0.707f);
     const float resonanceFreq = cutoff * 1.4f;
     const float resonanceGain = juce::Decibels::decibelsToGain (resonance * 9.0f);
-    auto resonanceCoeffs = juce::dsp::IIR::Coefficients<float>::makePeakFilter (currentSampleRate,
-                                                                                resonanceFreq,
-                                                                                1.0f,
-                                                                                resonanceGain);
     const auto monoFreq = juce::jlimit (40.0f, (float) (currentSampleRate * 0.45f), monoBelow);
-    auto monoCoeffs = juce::dsp::IIR::Coefficients<float>::makeLowPass (currentSampleRate, monoFreq, 0.707f);
 
     activeStageCount = stageCount;
     for (auto& stack : hpStacks)
     {
         for (int stage = 0; stage < stageCount; ++stage)
-            stack.stages[stage].coefficients = hpCoeffs;
+            stack.stages[stage].setHighPass (currentSampleRate, cutoff, 0.707f);
     }
     for (auto& filter : resonanceFilters)
-        filter.coefficients = resonanceCoeffs;
+        filter.setPeak (currentSampleRate, resonanceFreq, 1.0f, resonanceGain);
     for (auto& filter : monoLowFilters)
-        filter.coefficients = monoCoeffs;
+        filter.setLowPass (currentSampleRate, monoFreq, 0.707f);
 }
 
 juce::AudioProcessor* JUCE_CALLTYPE createPluginFilter()
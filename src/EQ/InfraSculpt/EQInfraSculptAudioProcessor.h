@@ -1,17 +1,26 @@
 #pragma once
 
 #include <JuceHeader.h>
+#include <array>
 #include "../../DualPrecisionAudioProcessor.h"
+#include "../../ParameterTable.h"
+#include "../../SmoothedParameter.h"
+#include "../../dsp/Biquad.h"
 
 class EQInfraSculptAudioProcessor : public DualPrecisionAudioProcessor
 {
 public:
+    enum class Param
+    {
+        subHpf, infraSlope, subResonance, monoBelow, outputTrim,
+        count
+    };
+
     EQInfraSculptAudioProcessor();
     ~EQInfraSculptAudioProcessor() override = default;
 
     void prepareToPlay (double sampleRate, int samplesPerBlock) override;
     void releaseResources() override;
-    void processBlock (juce::AudioBuffer<float>&, juce::MidiBuffer&) override;
 
     juce::AudioProcessorEditor* createEditor() override;
     bool hasEditor() const override { return true; }
@@ -20,7 +29,6 @@ public:
     bool acceptsMidi() const override { return false; }
     bool producesMidi() const override { return false; }
     bool isMidiEffect() const override { return false; }
-    double getTailLengthSeconds() const override { return 0.0; }
 
     int getNumPrograms() override { return 1; }
     int getCurrentProgram() override { return 0; }
@@ -34,16 +42,21 @@ public:
     juce::AudioProcessorValueTreeState& getValueTreeState() { return apvts; }
     static juce::AudioProcessorValueTreeState::ParameterLayout createParameterLayout();
 
+protected:
+    void processFloat (juce::AudioBuffer<float>&, juce::MidiBuffer&) override;
+
 private:
     juce::AudioProcessorValueTreeState apvts;
+    gls::ParameterHandles<Param> params;
+    gls::SmoothedParameter outputTrimGain { params, Param::outputTrim, gls::SmoothedParameter::Mapping::decibels };
     struct HighPassStack
     {
-        std::vector<juce::dsp::IIR::Filter<float>> stages;
+        std::vector<gls::dsp::Biquad> stages;
     };
 
     std::vector<HighPassStack> hpStacks;
-    std::vector<juce::dsp::IIR::Filter<float>> resonanceFilters;
-    std::vector<juce::dsp::IIR::Filter<float>> monoLowFilters;
+    std::vector<gls::dsp::Biquad> resonanceFilters;
+    std::vector<gls::dsp::Biquad> monoLowFilters;
     juce::AudioBuffer<float> monoBuffer;
     double currentSampleRate = 44100.0;
     juce::uint32 lastBlockSize = 512;
@@ -1,5 +1,21 @@
 #include "EQLowBenderAudioProcessor.h"
 
+namespace
+{
+using Param = EQLowBenderAudioProcessor::Param;
+using Spec = gls::ParameterSpec;
+
+constexpr std::array<Spec, (size_t) Param::count> parameterTable {{
+    Spec::range ("sub_boost",  "Sub Boost",  -12.0f, 12.0f,  0.1f,   3.0f),
+    Spec::range ("low_cut",    "Low Cut",    20.0f,  120.0f, 0.01f,  40.0f,  0.4f),
+    Spec::range ("punch_freq", "Punch Freq", 60.0f,  400.0f, 0.01f,  120.0f, 0.4f),
+    Spec::range ("punch_gain", "Punch Gain", -12.0f, 12.0f,  0.1f,   0.0f),
+    Spec::range ("tightness",  "Tightness",  0.0f,   1.0f,   0.001f, 0.5f)
+}};
+
+static_assert (gls::hasUniqueIds (parameterTable));
+} // namespace
+
 const std::array<EQLowBenderAudioProcessor::Preset, 3> EQLowBenderAudioProcessor::presetBank {{
     { "808 Lift", {
         { "sub_boost",   3.5f },
@@ -28,12 +44,15 @@ EQLowBenderAudioProcessor::EQLowBenderAudioProcessor()
     : DualPrecisionAudioProcessor(BusesProperties()
                         .withInput  ("Input", juce::AudioChannelSet::stereo(), true)
                         .withOutput ("Output", juce::AudioChannelSet::stereo(), true)),
-      apvts (*this, nullptr, "LOW_BENDER", createParameterLayout())
+      apvts (*this, nullptr, "LOW_BENDER", createParameterLayout()),
+      params (apvts, parameterTable)
 {
 }
 
 void EQLowBenderAudioProcessor::prepareToPlay (double sampleRate, int samplesPerBlock)
 {
+    DualPrecisionAudioProcessor::prepareToPlay (sampleRate, samplesPerBlock);
+
     currentSampleRate = juce::jmax (sampleRate, 44100.0);
     lastBlockSize = (juce::uint32) juce::jmax (1, samplesPerBlock);
     ensureFilterState (getTotalNumOutputChannels());
@@ -60,7 +79,7 @@ void EQLowBenderAudioProcessor::releaseResources()
 {
 }
 
-void EQLowBenderAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer,
+void EQLowBenderAudioProcessor::processFloat (juce::AudioBuffer<float>& buffer,
                                               juce::MidiBuffer&)
 {
     juce::ScopedNoDenormals noDenormals;
@@ -70,13 +89,11 @@ void EQLowBenderAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer,
     for (int ch = totalIn; ch < totalOut; ++ch)
         buffer.clear (ch, 0, buffer.getNumSamples());
 
-    auto get = [this](const char* id) { return apvts.getRawParameterValue (id)->load(); };
-
-    const auto subBoost  = get ("sub_boost");
-    const auto lowCut    = get ("low_cut");
-    const auto punchFreq = get ("punch_freq");
-    const auto punchGain = get ("punch_gain");
-    const auto tightness = juce::jlimit (0.0f, 1.0f, get ("tightness"));
+    const auto subBoost  = params[Param::subBoost];
+    const auto lowCut    = params[Param::lowCut];
+    const auto punchFreq = params[Param::punchFreq];
+    const auto punchGain = params[Param::punchGain];
+    const auto tightness = juce::jlimit (0.0f, 1.0f, params[Param::tightness]);
 
     const int numChannels = buffer.getNumChannels();
     const int numSamples  = buffer.getNumSamples();
@@ -113,20 +130,7 @@ void EQLowBenderAudioProcessor::setStateInformation (const void* data, int sizeI
 juce::AudioProcessorValueTreeState::ParameterLayout
 EQLowBenderAudioProcessor::createParameterLayout()
 {
-    std::vector<std::unique_ptr<juce::RangedAudioParameter>> params;
-
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("sub_boost",  "Sub Boost",
-                                                                   juce::NormalisableRange<float> (-12.0f, 12.0f, 0.1f), 3.0f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("low_cut",    "Low Cut",
-                                                                   juce::NormalisableRange<float> (20.0f, 120.0f, 0.01f, 0.4f), 40.0f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("punch_freq", "Punch Freq",
-                                                                   juce::NormalisableRange<float> (60.0f, 400.0f, 0.01f, 0.4f), 120.0f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("punch_gain", "Punch Gain",
-                                                                   juce::NormalisableRange<float> (-12.0f, 12.0f, 0.1f), 0.0f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("tightness",  "Tightness",
-                                                                   juce::NormalisableRange<float> (0.0f, 1.0f, 0.001f), 0.5f));
-
-    return { params.begin(), params.end() };
+    return gls::createParameterLayout (parameterTable);
 }
 
 EQLowBenderAudioProcessorEditor::EQLowBenderAudioProcessorEditor (EQLowBenderAudioProcessor& p)
@@ -239,30 +243,22 @@ void EQLowBenderAudioProcessor::updateFilters (float subBoostDb, float punchFreq
         return;
 
     const auto subFreq = 55.0f;
-    const auto subCoeffs = juce::dsp::IIR::Coefficients<float>::makeLowShelf (currentSampleRate,
-                                                                              subFreq,
-                                                                              0.707f,
-                                                                              juce::Decibels::decibelsToGain (subBoostDb));
 
     const auto punchQ = juce::jmap (tightness, 0.4f, 2.0f);
     const auto clampedPunchFreq = juce::jlimit (40.0f, (float) (currentSampleRate * 0.45f), punchFreq);
-    const auto punchCoeffs = juce::dsp::IIR::Coefficients<float>::makePeakFilter (currentSampleRate,
-                                                                                  clampedPunchFreq,
-                                                                                  punchQ,
-                                                                                  juce::Decibels::decibelsToGain (punchGainDb));
 
     const auto hpQ = juce::jmap (tightness, 0.5f, 1.2f);
     const auto clampedLowCut = juce::jlimit (20.0f, (float) (currentSampleRate * 0.45f), lowCutFreq);
-    const auto hpCoeffs = juce::dsp::IIR::Coefficients<float>::makeHighPass (currentSampleRate,
-                                                                             clampedLowCut,
-                                                                             hpQ);
+
+    const auto subGain = juce::Decibels::decibelsToGain (subBoostDb);
+    const auto punchGain = juce::Decibels::decibelsToGain (punchGainDb);
 
     for (auto& filter : subShelves)
-        filter.coefficients = subCoeffs;
+        filter.setLowShelf (currentSampleRate, subFreq, 0.707f, subGain);
     for (auto& filter : punchFilters)
-        filter.coefficients = punchCoeffs;
+        filter.setPeak (currentSampleRate, clampedPunchFreq, punchQ, punchGain);
     for (auto& filter : lowCuts)
-        filter.coefficients = hpCoeffs;
+        filter.setHighPass (currentSampleRate, clampedLowCut, hpQ);
 }
 
 juce::AudioProcessor* JUCE_CALLTYPE createPluginFilter()
@@ -3,16 +3,23 @@
 #include <JuceHeader.h>
 #include <array>
 #include "../../DualPrecisionAudioProcessor.h"
+#include "../../ParameterTable.h"
+#include "../../dsp/Biquad.h"
 
 class EQLowBenderAudioProcessor : public DualPrecisionAudioProcessor
 {
 public:
+    enum class Param
+    {
+        subBoost, lowCut, punchFreq, punchGain, tightness,
+        count
+    };
+
     EQLowBenderAudioProcessor();
     ~EQLowBenderAudioProcessor() override = default;
 
     void prepareToPlay (double sampleRate, int samplesPerBlock) override;
     void releaseResources() override;
-    void processBlock (juce::AudioBuffer<float>&, juce::MidiBuffer&) override;
 
     juce::AudioProcessorEditor* createEditor() override;
     bool hasEditor() const override { return true; }
@@ -21,7 +28,6 @@ public:
     bool acceptsMidi() const override { return false; }
     bool producesMidi() const override { return false; }
     bool isMidiEffect() const override { return false; }
-    double getTailLengthSeconds() const override { return 0.0; }
 
     int getNumPrograms() override;
     int getCurrentProgram() override { return currentPreset; }
@@ -35,11 +41,15 @@ public:
     juce::AudioProcessorValueTreeState& getValueTreeState() { return apvts; }
     static juce::AudioProcessorValueTreeState::ParameterLayout createParameterLayout();
 
+protected:
+    void processFloat (juce::AudioBuffer<float>&, juce::MidiBuffer&) override;
+
 private:
     juce::AudioProcessorValueTreeState apvts;
-    std::vector<juce::dsp::IIR::Filter<float>> subShelves;
-    std::vector<juce::dsp::IIR::Filter<float>> punchFilters;
-    std::vector<juce::dsp::IIR::Filter<float>> lowCuts;
+    gls::ParameterHandles<Param> params;
+    std::vector<gls::dsp::Biquad> subShelves;
+    std::vector<gls::dsp::Biquad> punchFilters;
+    std::vector<gls::dsp::Biquad> lowCuts;
     double currentSampleRate = 44100.0;
     juce::uint32 lastBlockSize = 512;
     int currentPreset = 0;
@@ -1,5 +1,23 @@
 #include "EQMixNotchLabAudioProcessor.h"
 
+namespace
+{
+using Param = EQMixNotchLabAudioProcessor::Param;
+using Spec = gls::ParameterSpec;
+
+constexpr std::array<Spec, (size_t) Param::count> parameterTable {{
+    Spec::range  ("notch1_freq",  "Notch1 Freq",  20.0f,  20000.0f, 0.01f,  200.0f,  0.4f),
+    Spec::range  ("notch1_q",     "Notch1 Q",     1.0f,   30.0f,    0.001f, 5.0f,    0.5f),
+    Spec::range  ("notch1_depth", "Notch1 Depth", -60.0f, 0.0f,     0.1f,   -18.0f),
+    Spec::range  ("notch2_freq",  "Notch2 Freq",  20.0f,  20000.0f, 0.01f,  5000.0f, 0.4f),
+    Spec::range  ("notch2_q",     "Notch2 Q",     1.0f,   30.0f,    0.001f, 8.0f,    0.5f),
+    Spec::range  ("notch2_depth", "Notch2 Depth", -60.0f, 0.0f,     0.1f,   -18.0f),
+    Spec::choice ("listen_mode",  "Listen Mode",  "Normal|Notch1|Notch2", 0)
+}};
+
+static_assert (gls::hasUniqueIds (parameterTable));
+} // namespace
+
 const std::array<EQMixNotchLabAudioProcessor::Preset, 3> EQMixNotchLabAudioProcessor::presetBank {{
     { "Vocal Clean", {
         { "notch1_freq", 250.0f },
@@ -34,12 +52,15 @@ EQMixNotchLabAudioProcessor::EQMixNotchLabAudioProcessor()
     : DualPrecisionAudioProcessor(BusesProperties()
                         .withInput  ("Input", juce::AudioChannelSet::stereo(), true)
                         .withOutput ("Output", juce::AudioChannelSet::stereo(), true)),
-      apvts (*this, nullptr, "MIX_NOTCH_LAB", createParameterLayout())
+      apvts (*this, nullptr, "MIX_NOTCH_LAB", createParameterLayout()),
+      params (apvts, parameterTable)
 {
 }
 
 void EQMixNotchLabAudioProcessor::prepareToPlay (double sampleRate, int samplesPerBlock)
 {
+    DualPrecisionAudioProcessor::prepareToPlay (sampleRate, samplesPerBlock);
+
     currentSampleRate = juce::jmax (sampleRate, 44100.0);
     lastBlockSize = (juce::uint32) juce::jmax (1, samplesPerBlock);
     ensureStateSize (getTotalNumOutputChannels());
@@ -49,7 +70,7 @@ void EQMixNotchLabAudioProcessor::releaseResources()
 {
 }
 
-void EQMixNotchLabAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer,
+void EQMixNotchLabAudioProcessor::processFloat (juce::AudioBuffer<float>& buffer,
                                                 juce::MidiBuffer&)
 {
     juce::ScopedNoDenormals noDenormals;
@@ -59,52 +80,43 @@ void EQMixNotchLabAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer
     for (int ch = totalIn; ch < totalOut; ++ch)
         buffer.clear (ch, 0, buffer.getNumSamples());
 
-    auto get = [this](const char* id) { return apvts.getRawParameterValue (id)->load(); };
-
-    const auto n1Freq  = get ("notch1_freq");
-    const auto n1Q     = get ("notch1_q");
-    const auto n1Depth = get ("notch1_depth");
-    const auto n2Freq  = get ("notch2_freq");
-    const auto n2Q     = get ("notch2_q");
-    const auto n2Depth = get ("notch2_depth");
-    const auto listenMode = static_cast<int> (apvts.getRawParameterValue ("listen_mode")->load());
+    const auto n1Freq  = params[Param::notch1Freq];
+    const auto n1Q     = params[Param::notch1Q];
+    const auto n1Depth = params[Param::notch1Depth];
+    const auto n2Freq  = params[Param::notch2Freq];
+    const auto n2Q     = params[Param::notch2Q];
+    const auto n2Depth = params[Param::notch2Depth];
+    const auto listenMode = params.getIndex (Param::listenMode);
 
     const int numChannels = buffer.getNumChannels();
     const int numSamples  = buffer.getNumSamples();
 
     lastBlockSize = (juce::uint32) juce::jmax (1, numSamples);
     ensureStateSize (numChannels);
-    dryBuffer.makeCopyOf (buffer, true);
-    notchPreview1.makeCopyOf (buffer, true);
-    notchPreview2.makeCopyOf (buffer, true);
     updateFilters (n1Freq, n1Q, n1Depth, n2Freq, n2Q, n2Depth);
 
-    juce::dsp::AudioBlock<float> mainBlock (buffer);
-    juce::dsp::AudioBlock<float> previewBlock1 (notchPreview1);
-    juce::dsp::AudioBlock<float> previewBlock2 (notchPreview2);
+    // Listening to a notch solos it: only that filter runs, in place, so no path needs
+    // its own copy of the input.
+    juce::dsp::AudioBlock<float> block (buffer);
 
     for (int ch = 0; ch < numChannels; ++ch)
     {
-        auto mainChannel = mainBlock.getSingleChannelBlock ((size_t) ch);
-        juce::dsp::ProcessContextReplacing<float> ctx (mainChannel);
-        notch1Filters[ch].process (ctx);
-        notch2Filters[ch].process (ctx);
-
-        auto prev1Channel = previewBlock1.getSingleChannelBlock ((size_t) ch);
-        juce::dsp::ProcessContextReplacing<float> previewCtx1 (prev1Channel);
-        notch1PreviewFilters[ch].process (previewCtx1);
-
-        auto prev2Channel = previewBlock2.getSingleChannelBlock ((size_t) ch);
-        juce::dsp::ProcessContextReplacing<float> previewCtx2 (prev2Channel);
-        notch2PreviewFilters[ch].process (previewCtx2);
-    }
+        auto channel = block.getSingleChannelBlock ((size_t) ch);
+        juce::dsp::ProcessContextReplacing<float> ctx (channel);
 
-    if (listenMode > 0)
-    {
         if (listenMode == 1)
-            buffer.makeCopyOf (notchPreview1, true);
+        {
+            notch1PreviewFilters[ch].process (ctx);
+        }
+        else if (listenMode == 2)
+        {
+            notch2PreviewFilters[ch].process (ctx);
+        }
         else
-            buffer.makeCopyOf (notchPreview2, true);
+        {
+            notch1Filters[ch].process (ctx);
+            notch2Filters[ch].process (ctx);
+        }
     }
 }
 
@@ -124,24 +136,7 @@ void EQMixNotchLabAudioProcessor::setStateInformation (const void* data, int siz
 juce::AudioProcessorValueTreeState::ParameterLayout
 EQMixNotchLabAudioProcessor::createParameterLayout()
 {
-    std::vector<std::unique_ptr<juce::RangedAudioParameter>> params;
-
-    auto freqRange  = juce::NormalisableRange<float> (20.0f, 20000.0f, 0.01f, 0.4f);
-    auto qRange     = juce::NormalisableRange<float> (1.0f, 30.0f, 0.001f, 0.5f);
-    auto depthRange = juce::NormalisableRange<float> (-60.0f, 0.0f, 0.1f);
-
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("notch1_freq",  "Notch1 Freq",  freqRange, 200.0f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("notch1_q",     "Notch1 Q",     qRange,    5.0f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("notch1_depth", "Notch1 Depth", depthRange,-18.0f));
-
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("notch2_freq",  "Notch2 Freq",  freqRange, 5000.0f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("notch2_q",     "Notch2 Q",     qRange,    8.0f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("notch2_depth", "Notch2 Depth", depthRange,-18.0f));
-
-    params.push_back (std::make_unique<juce::AudioParameterChoice> ("listen_mode", "Listen Mode",
-                                                                    juce::StringArray { "Normal", "Notch1", "Notch2" }, 0));
-
-    return { params.begin(), params.end() };
+    return gls::createParameterLayout (parameterTable);
 }
 
 EQMixNotchLabAudioProcessorEditor::EQMixNotchLabAudioProcessorEditor (EQMixNotchLabAudioProcessor& p)
@@ -260,10 +255,6 @@ void EQMixNotchLabAudioProcessor::ensureStateSize (int numChannels)
     ensureVector (notch2Filters);
     ensureVector (notch1PreviewFilters);
     ensureVector (notch2PreviewFilters);
-
-    dryBuffer.setSize (numChannels, lastBlockSize, false, false, true);
-    notchPreview1.setSize (numChannels, lastBlockSize, false, false, true);
-    notchPreview2.setSize (numChannels, lastBlockSize, false, false, true);
 }
 
 void EQMixNotchLabAudioProcessor::updateFilters (float n1Freq, float n1Q, float n1Depth,
@@ -272,28 +263,19 @@ void EQMixNotchLabAudioProcessor::updateFilters (float n1Freq, float n1Q, float
     if (currentSampleRate <= 0.0)
         return;
 
-    auto makeNotch = [&](float freq, float q, float depthDb)
+    auto setNotch = [&](std::vector<gls::dsp::Biquad>& filters, float freq, float q, float depthDb)
     {
         const auto clampedFreq = juce::jlimit (20.0f, (float) (currentSampleRate * 0.49f), freq);
         const auto clampedQ    = juce::jlimit (1.0f, 30.0f, q);
         const float gain = juce::Decibels::decibelsToGain (depthDb);
-        return juce::dsp::IIR::Coefficients<float>::makePeakFilter (currentSampleRate,
-                                                                    clampedFreq,
-                                                                    clampedQ,
-                                                                    gain);
+        for (auto& filter : filters)
+            filter.setPeak (currentSampleRate, clampedFreq, clampedQ, gain);
     };
 
-    auto coeffs1 = makeNotch (n1Freq, n1Q, n1Depth);
-    auto coeffs2 = makeNotch (n2Freq, n2Q, n2Depth);
-
-    for (auto& filter : notch1Filters)
-        filter.coefficients = coeffs1;
-    for (auto& filter : notch2Filters)
-        filter.coefficients = coeffs2;
-    for (auto& filter : notch1PreviewFilters)
-        filter.coefficients = coeffs1;
-    for (auto& filter : notch2PreviewFilters)
-        filter.coefficients = coeffs2;
+    setNotch (notch1Filters, n1Freq, n1Q, n1Depth);
+    setNotch (notch2Filters, n2Freq, n2Q, n2Depth);
+    setNotch (notch1PreviewFilters, n1Freq, n1Q, n1Depth);
+    setNotch (notch2PreviewFilters, n2Freq, n2Q, n2Depth);
 }
 
 juce::AudioProcessor* JUCE_CALLTYPE createPluginFilter()
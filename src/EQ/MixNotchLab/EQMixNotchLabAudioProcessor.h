@@ -3,16 +3,23 @@
 #include <JuceHeader.h>
 #include <array>
 #include "../../DualPrecisionAudioProcessor.h"
+#include "../../ParameterTable.h"
+#include "../../dsp/Biquad.h"
 
 class EQMixNotchLabAudioProcessor : public DualPrecisionAudioProcessor
 {
 public:
+    enum class Param
+    {
+        notch1Freq, notch1Q, notch1Depth, notch2Freq, notch2Q, notch2Depth, listenMode,
+        count
+    };
+
     EQMixNotchLabAudioProcessor();
     ~EQMixNotchLabAudioProcessor() override = default;
 
     void prepareToPlay (double sampleRate, int samplesPerBlock) override;
     void releaseResources() override;
-    void processBlock (juce::AudioBuffer<float>&, juce::MidiBuffer&) override;
 
     juce::AudioProcessorEditor* createEditor() override;
     bool hasEditor() const override { return true; }
@@ -21,7 +28,6 @@ public:
     bool acceptsMidi() const override { return false; }
     bool producesMidi() const override { return false; }
     bool isMidiEffect() const override { return false; }
-    double getTailLengthSeconds() const override { return 0.0; }
 
     int getNumPrograms() override;
     int getCurrentProgram() override { return currentPreset; }
@@ -35,15 +41,16 @@ public:
     juce::AudioProcessorValueTreeState& getValueTreeState() { return apvts; }
     static juce::AudioProcessorValueTreeState::ParameterLayout createParameterLayout();
 
+protected:
+    void processFloat (juce::AudioBuffer<float>&, juce::MidiBuffer&) override;
+
 private:
     juce::AudioProcessorValueTreeState apvts;
-    std::vector<juce::dsp::IIR::Filter<float>> notch1Filters;
-    std::vector<juce::dsp::IIR::Filter<float>> notch2Filters;
-    std::vector<juce::dsp::IIR::Filter<float>> notch1PreviewFilters;
-    std::vector<juce::dsp::IIR::Filter<float>> notch2PreviewFilters;
-    juce::AudioBuffer<float> dryBuffer;
-    juce::AudioBuffer<float> notchPreview1;
-    juce::AudioBuffer<float> notchPreview2;
+    gls::ParameterHandles<Param> params;
+    std::vector<gls::dsp::Biquad> notch1Filters;
+    std::vector<gls::dsp::Biquad> notch2Filters;
+    std::vector<gls::dsp::Biquad> notch1PreviewFilters;
+    std::vector<gls::dsp::Biquad> notch2PreviewFilters;
     double currentSampleRate = 44100.0;
     juce::uint32 lastBlockSize = 512;
     int currentPreset = 0;
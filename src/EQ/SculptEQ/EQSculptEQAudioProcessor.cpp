@@ -1,15 +1,49 @@
 #include "EQSculptEQAudioProcessor.h"
 
+namespace
+{
+using Param = EQSculptEQAudioProcessor::Param;
+using Spec = gls::ParameterSpec;
+
+constexpr std::array<Spec, (size_t) Param::count> parameterTable {{
+    Spec::range ("hpf",        "HPF",        20.0f,   200.0f,   0.01f,  40.0f,    0.4f),
+    Spec::range ("lpf",        "LPF",        4000.0f, 20000.0f, 0.01f,  16000.0f, 0.4f),
+    Spec::range ("band1_freq", "Band1 Freq", 40.0f,   20000.0f, 0.01f,  200.0f,   0.4f),
+    Spec::range ("band1_gain", "Band1 Gain", -15.0f,  15.0f,    0.1f,   0.0f),
+    Spec::range ("band1_q",    "Band1 Q",    0.2f,    10.0f,    0.001f, 1.0f,     0.5f),
+    Spec::range ("band2_freq", "Band2 Freq", 40.0f,   20000.0f, 0.01f,  400.0f,   0.4f),
+    Spec::range ("band2_gain", "Band2 Gain", -15.0f,  15.0f,    0.1f,   0.0f),
+    Spec::range ("band2_q",    "Band2 Q",    0.2f,    10.0f,    0.001f, 1.0f,     0.5f),
+    Spec::range ("band3_freq", "Band3 Freq", 40.0f,   20000.0f, 0.01f,  600.0f,   0.4f),
+    Spec::range ("band3_gain", "Band3 Gain", -15.0f,  15.0f,    0.1f,   0.0f),
+    Spec::range ("band3_q",    "Band3 Q",    0.2f,    10.0f,    0.001f, 1.0f,     0.5f),
+    Spec::range ("band4_freq", "Band4 Freq", 40.0f,   20000.0f, 0.01f,  800.0f,   0.4f),
+    Spec::range ("band4_gain", "Band4 Gain", -15.0f,  15.0f,    0.1f,   0.0f),
+    Spec::range ("band4_q",    "Band4 Q",    0.2f,    10.0f,    0.001f, 1.0f,     0.5f),
+    Spec::range ("band5_freq", "Band5 Freq", 40.0f,   20000.0f, 0.01f,  1000.0f,  0.4f),
+    Spec::range ("band5_gain", "Band5 Gain", -15.0f,  15.0f,    0.1f,   0.0f),
+    Spec::range ("band5_q",    "Band5 Q",    0.2f,    10.0f,    0.001f, 1.0f,     0.5f),
+    Spec::range ("band6_freq", "Band6 Freq", 40.0f,   20000.0f, 0.01f,  1200.0f,  0.4f),
+    Spec::range ("band6_gain", "Band6 Gain", -15.0f,  15.0f,    0.1f,   0.0f),
+    Spec::range ("band6_q",    "Band6 Q",    0.2f,    10.0f,    0.001f, 1.0f,     0.5f)
+}};
+
+static_assert (gls::hasUniqueIds (parameterTable));
+} // namespace
+
 EQSculptEQAudioProcessor::EQSculptEQAudioProcessor()
     : DualPrecisionAudioProcessor(BusesProperties()
                         .withInput  ("Input", juce::AudioChannelSet::stereo(), true)
                         .withOutput ("Output", juce::AudioChannelSet::stereo(), true)),
-      apvts (*this, nullptr, "SCULPT_EQ", createParameterLayout())
+      apvts (*this, nullptr, "SCULPT_EQ", createParameterLayout()),
+      params (apvts, parameterTable)
 {
 }
 
 void EQSculptEQAudioProcessor::prepareToPlay (double sampleRate, int samplesPerBlock)
 {
+    DualPrecisionAudioProcessor::prepareToPlay (sampleRate, samplesPerBlock);
+
     currentSampleRate = juce::jmax (sampleRate, 44100.0);
     lastBlockSize = (juce::uint32) juce::jmax (1, samplesPerBlock);
     ensureFilterState (getTotalNumOutputChannels());
@@ -37,7 +71,7 @@ void EQSculptEQAudioProcessor::releaseResources()
 {
 }
 
-void EQSculptEQAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer,
+void EQSculptEQAudioProcessor::processFloat (juce::AudioBuffer<float>& buffer,
                                              juce::MidiBuffer&)
 {
     juce::ScopedNoDenormals noDenormals;
@@ -47,20 +81,18 @@ void EQSculptEQAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer,
     for (int ch = totalIn; ch < totalOut; ++ch)
         buffer.clear (ch, 0, buffer.getNumSamples());
 
-    auto get = [this](const juce::String& id) { return apvts.getRawParameterValue (id)->load(); };
-
-    const float hpfFreq = get ("hpf");
-    const float lpfFreq = get ("lpf");
+    const float hpfFreq = params[Param::hpf];
+    const float lpfFreq = params[Param::lpf];
 
     std::array<float, 6> freqs {};
     std::array<float, 6> gains {};
     std::array<float, 6> qs {};
     for (int i = 0; i < 6; ++i)
     {
-        const auto idx = juce::String (i + 1);
-        freqs[i] = get ("band" + idx + "_freq");
-        gains[i] = get ("band" + idx + "_gain");
-        qs[i]    = get ("band" + idx + "_q");
+        const auto band = (int) Param::band1Freq + 3 * i;
+        freqs[i] = params[(Param) band];
+        gains[i] = params[(Param) (band + 1)];
+        qs[i]    = params[(Param) (band + 2)];
     }
 
     const int numChannels = buffer.getNumChannels();
@@ -108,27 +140,7 @@ void EQSculptEQAudioProcessor::setStateInformation (const void* data, int sizeIn
 juce::AudioProcessorValueTreeState::ParameterLayout
 EQSculptEQAudioProcessor::createParameterLayout()
 {
-    std::vector<std::unique_ptr<juce::RangedAudioParameter>> params;
-
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("hpf", "HPF",
-                                                                   juce::NormalisableRange<float> (20.0f, 200.0f, 0.01f, 0.4f), 40.0f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("lpf", "LPF",
-                                                                   juce::NormalisableRange<float> (4000.0f, 20000.0f, 0.01f, 0.4f), 16000.0f));
-
-    for (int i = 0; i < 6; ++i)
-    {
-        params.push_back (std::make_unique<juce::AudioParameterFloat> ("band" + juce::String (i+1) + "_freq",
-                                                                       "Band" + juce::String (i+1) + " Freq",
-                                                                       juce::NormalisableRange<float> (40.0f, 20000.0f, 0.01f, 0.4f), 200.0f * (i + 1)));
-        params.push_back (std::make_unique<juce::AudioParameterFloat> ("band" + juce::String (i+1) + "_gain",
-                                                                       "Band" + juce::String (i+1) + " Gain",
-                                                                       juce::NormalisableRange<float> (-15.0f, 15.0f, 0.1f), 0.0f));
-        params.push_back (std::make_unique<juce::AudioParameterFloat> ("band" + juce::String (i+1) + "_q",
-                                                                       "Band" + juce::String (i+1) + " Q",
-                                                                       juce::NormalisableRange<float> (0.2f, 10.0f, 0.001f, 0.5f), 1.0f));
-    }
-
-    return { params.begin(), params.end() };
+    return gls::createParameterLayout (parameterTable);
 }
 
 EQSculptEQAudioProcessorEditor::EQSculptEQAudioProcessorEditor (EQSculptEQAudioProcessor& p)
@@ -241,22 +253,18 @@ void EQSculptEQAudioProcessor::updateFilters (float hpf, float lpf,
     const auto hpFreq = juce::jlimit (20.0f, (float) (currentSampleRate * 0.45f), hpf);
     const auto lpFreq = juce::jlimit (hpFreq + 10.0f, (float) (currentSampleRate * 0.49f), lpf);
 
-    auto hpCoeffs = juce::dsp::IIR::Coefficients<float>::makeHighPass (currentSampleRate, hpFreq, 0.707f);
-    auto lpCoeffs = juce::dsp::IIR::Coefficients<float>::makeLowPass  (currentSampleRate, lpFreq, 0.707f);
-
     for (auto& filter : highPassFilters)
-        filter.coefficients = hpCoeffs;
+        filter.setHighPass (currentSampleRate, hpFreq, 0.707f);
     for (auto& filter : lowPassFilters)
-        filter.coefficients = lpCoeffs;
+        filter.setLowPass (currentSampleRate, lpFreq, 0.707f);
 
     for (size_t i = 0; i < bandFilters.size(); ++i)
     {
         const auto freq = juce::jlimit (20.0f, (float) (currentSampleRate * 0.49f), freqs[i]);
         const auto q    = juce::jlimit (0.2f, 10.0f, qs[i]);
         const auto gainLinear = juce::Decibels::decibelsToGain (gains[i]);
-        auto coeffs = juce::dsp::IIR::Coefficients<float>::makePeakFilter (currentSampleRate, freq, q, gainLinear);
         for (auto& filter : bandFilters[i])
-            filter.coefficients = coeffs;
+            filter.setPeak (currentSampleRate, freq, q, gainLinear);
     }
 }
 
@@ -1,17 +1,27 @@
 #pragma once
 
 #include <JuceHeader.h>
+#include <array>
 #include "../../DualPrecisionAudioProcessor.h"
+#include "../../ParameterTable.h"
+#include "../../dsp/Biquad.h"
 
 class EQSculptEQAudioProcessor : public DualPrecisionAudioProcessor
 {
 public:
+    enum class Param
+    {
+        hpf, lpf, band1Freq, band1Gain, band1Q, band2Freq, band2Gain, band2Q, band3Freq,
+        band3Gain, band3Q, band4Freq, band4Gain, band4Q, band5Freq, band5Gain, band5Q,
+        band6Freq, band6Gain, band6Q,
+        count
+    };
+
     EQSculptEQAudioProcessor();
     ~EQSculptEQAudioProcessor() override = default;
 
     void prepareToPlay (double sampleRate, int samplesPerBlock) override;
     void releaseResources() override;
-    void processBlock (juce::AudioBuffer<float>&, juce::MidiBuffer&) override;
 
     juce::AudioProcessorEditor* createEditor() override;
     bool hasEditor() const override { return true; }
@@ -20,7 +30,6 @@ public:
     bool acceptsMidi() const override { return false; }
     bool producesMidi() const override { return false; }
     bool isMidiEffect() const override { return false; }
-    double getTailLengthSeconds() const override { return 0.0; }
 
     int getNumPrograms() override { return 1; }
     int getCurrentProgram() override { return 0; }
@@ -34,11 +43,15 @@ public:
     juce::AudioProcessorValueTreeState& getValueTreeState() { return apvts; }
     static juce::AudioProcessorValueTreeState::ParameterLayout createParameterLayout();
 
+protected:
+    void processFloat (juce::AudioBuffer<float>&, juce::MidiBuffer&) override;
+
 private:
     juce::AudioProcessorValueTreeState apvts;
-    std::vector<juce::dsp::IIR::Filter<float>> highPassFilters;
-    std::vector<juce::dsp::IIR::Filter<float>> lowPassFilters;
-    std::array<std::vector<juce::dsp::IIR::Filter<float>>, 6> bandFilters;
+    gls::ParameterHandles<Param> params;
+    std::vector<gls::dsp::Biquad> highPassFilters;
+    std::vector<gls::dsp::Biquad> lowPassFilters;
+    std::array<std::vector<gls::dsp::Biquad>, 6> bandFilters;
     double currentSampleRate = 44100.0;
     juce::uint32 lastBlockSize = 512;
 
@@ -1,15 +1,35 @@
 #include "EQSideSliceAudioProcessor.h"
 
+namespace
+{
+using Param = EQSideSliceAudioProcessor::Param;
+using Spec = gls::ParameterSpec;
+
+constexpr std::array<Spec, (size_t) Param::count> parameterTable {{
+    Spec::choice ("mode",      "Mode",      "Stereo|MS", 1),
+    Spec::range  ("mid_band",  "Mid Band",  -12.0f, 12.0f, 0.1f,   0.0f),
+    Spec::range  ("side_band", "Side Band", -12.0f, 12.0f, 0.1f,   0.0f),
+    Spec::range  ("mid_trim",  "Mid Trim",  -12.0f, 12.0f, 0.1f,   0.0f),
+    Spec::range  ("side_trim", "Side Trim", -12.0f, 12.0f, 0.1f,   0.0f),
+    Spec::range  ("width",     "Width",     0.0f,   2.0f,  0.001f, 1.0f)
+}};
+
+static_assert (gls::hasUniqueIds (parameterTable));
+} // namespace
+
 EQSideSliceAudioProcessor::EQSideSliceAudioProcessor()
     : DualPrecisionAudioProcessor(BusesProperties()
                         .withInput  ("Input", juce::AudioChannelSet::stereo(), true)
                         .withOutput ("Output", juce::AudioChannelSet::stereo(), true)),
-      apvts (*this, nullptr, "SIDE_SLICE", createParameterLayout())
+      apvts (*this, nullptr, "SIDE_SLICE", createParameterLayout()),
+      params (apvts, parameterTable)
 {
 }
 
 void EQSideSliceAudioProcessor::prepareToPlay (double sampleRate, int samplesPerBlock)
 {
+    DualPrecisionAudioProcessor::prepareToPlay (sampleRate, samplesPerBlock);
+
     currentSampleRate = juce::jmax (sampleRate, 44100.0);
     lastBlockSize = (juce::uint32) juce::jmax (1, samplesPerBlock);
     prepareFilters (currentSampleRate, samplesPerBlock);
@@ -19,7 +39,7 @@ void EQSideSliceAudioProcessor::releaseResources()
 {
 }
 
-void EQSideSliceAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer,
+void EQSideSliceAudioProcessor::processFloat (juce::AudioBuffer<float>& buffer,
                                               juce::MidiBuffer&)
 {
     juce::ScopedNoDenormals noDenormals;
@@ -29,14 +49,12 @@ void EQSideSliceAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer,
     for (int ch = totalIn; ch < totalOut; ++ch)
         buffer.clear (ch, 0, buffer.getNumSamples());
 
-    auto get = [this](const char* id) { return apvts.getRawParameterValue (id)->load(); };
-
-    const auto modeIndex  = static_cast<int> (apvts.getRawParameterValue ("mode")->load());
-    const auto midBandDb  = get ("mid_band");
-    const auto sideBandDb = get ("side_band");
-    const auto midTrimDb  = get ("mid_trim");
-    const auto sideTrimDb = get ("side_trim");
-    const auto width      = juce::jlimit (0.0f, 2.0f, get ("width"));
+    const auto modeIndex  = params.getIndex (Param::mode);
+    const auto midBandDb  = params[Param::midBand];
+    const auto sideBandDb = params[Param::sideBand];
+    const auto midTrimDb  = params[Param::midTrim];
+    const auto sideTrimDb = params[Param::sideTrim];
+    const auto width      = juce::jlimit (0.0f, 2.0f, params[Param::width]);
 
     const float midTrimGain  = juce::Decibels::decibelsToGain (midTrimDb);
     const float sideTrimGain = juce::Decibels::decibelsToGain (sideTrimDb);
@@ -103,22 +121,7 @@ void EQSideSliceAudioProcessor::setStateInformation (const void* data, int sizeI
 juce::AudioProcessorValueTreeState::ParameterLayout
 EQSideSliceAudioProcessor::createParameterLayout()
 {
-    std::vector<std::unique_ptr<juce::RangedAudioParameter>> params;
-
-    params.push_back (std::make_unique<juce::AudioParameterChoice> ("mode", "Mode",
-                                                                    juce::StringArray { "Stereo", "MS" }, 1));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("mid_band",  "Mid Band",
-                                                                   juce::NormalisableRange<float> (-12.0f, 12.0f, 0.1f), 0.0f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("side_band", "Side Band",
-                                                                   juce::NormalisableRange<float> (-12.0f, 12.0f, 0.1f), 0.0f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("mid_trim",  "Mid Trim",
-                                                                   juce::NormalisableRange<float> (-12.0f, 12.0f, 0.1f), 0.0f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("side_trim", "Side Trim",
-                                                                   juce::NormalisableRange<float> (-12.0f, 12.0f, 0.1f), 0.0f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("width",    "Width",
-                                                                   juce::NormalisableRange<float> (0.0f, 2.0f, 0.001f), 1.0f));
-
-    return { params.begin(), params.end() };
+    return gls::createParameterLayout (parameterTable);
 }
 
 EQSideSliceAudioProcessorEditor::EQSideSliceAudioProcessorEditor (EQSideSliceAudioProcessor& p)
@@ -201,15 +204,13 @@ void EQSideSliceAudioProcessor::updateFilterCoefficients (float midBandDb, float
     if (currentSampleRate <= 0.0)
         return;
 
-    auto midCoeffs = juce::dsp::IIR::Coefficients<float>::makePeakFilter (currentSampleRate, 400.0f, 0.8f,
-                                                                          juce::Decibels::decibelsToGain (midBandDb));
-    auto sideCoeffs = juce::dsp::IIR::Coefficients<float>::makePeakFilter (currentSampleRate, 2500.0f, 0.9f,
-                                                                           juce::Decibels::decibelsToGain (sideBandDb));
+    const auto midGain  = juce::Decibels::decibelsToGain (midBandDb);
+    const auto sideGain = juce::Decibels::decibelsToGain (sideBandDb);
 
-    midFilter.coefficients = midCoeffs;
-    stereoFilters[0].coefficients = midCoeffs;
-    sideFilter.coefficients = sideCoeffs;
-    stereoFilters[1].coefficients = sideCoeffs;
+    midFilter.setPeak (currentSampleRate, 400.0f, 0.8f, midGain);
+    stereoFilters[0].setPeak (currentSampleRate, 400.0f, 0.8f, midGain);
+    sideFilter.setPeak (currentSampleRate, 2500.0f, 0.9f, sideGain);
+    stereoFilters[1].setPeak (currentSampleRate, 2500.0f, 0.9f, sideGain);
 }
 
 juce::AudioProcessor* JUCE_CALLTYPE createPluginFilter()
@@ -2,17 +2,24 @@
 
 #include <JuceHeader.h>
 #include "../../DualPrecisionAudioProcessor.h"
+#include "../../ParameterTable.h"
+#include "../../dsp/Biquad.h"
 #include <array>
 
 class EQSideSliceAudioProcessor : public DualPrecisionAudioProcessor
 {
 public:
+    enum class Param
+    {
+        mode, midBand, sideBand, midTrim, sideTrim, width,
+        count
+    };
+
     EQSideSliceAudioProcessor();
     ~EQSideSliceAudioProcessor() override = default;
 
     void prepareToPlay (double sampleRate, int samplesPerBlock) override;
     void releaseResources() override;
-    void processBlock (juce::AudioBuffer<float>&, juce::MidiBuffer&) override;
 
     juce::AudioProcessorEditor* createEditor() override;
     bool hasEditor() const override { return true; }
@@ -21,7 +28,6 @@ public:
     bool acceptsMidi() const override { return false; }
     bool producesMidi() const override { return false; }
     bool isMidiEffect() const override { return false; }
-    double getTailLengthSeconds() const override { return 0.0; }
 
     int getNumPrograms() override { return 1; }
     int getCurrentProgram() override { return 0; }
@@ -35,11 +41,15 @@ public:
     juce::AudioProcessorValueTreeState& getValueTreeState() { return apvts; }
     static juce::AudioProcessorValueTreeState::ParameterLayout createParameterLayout();
 
+protected:
+    void processFloat (juce::AudioBuffer<float>&, juce::MidiBuffer&) override;
+
 private:
     juce::AudioProcessorValueTreeState apvts;
-    juce::dsp::IIR::Filter<float> midFilter;
-    juce::dsp::IIR::Filter<float> sideFilter;
-    std::array<juce::dsp::IIR::Filter<float>, 2> stereoFilters;
+    gls::ParameterHandles<Param> params;
+    gls::dsp::Biquad midFilter;
+    gls::dsp::Biquad sideFilter;
+    std::array<gls::dsp::Biquad, 2> stereoFilters;
     double currentSampleRate = 44100.0;
     juce::uint32 lastBlockSize = 512;
 
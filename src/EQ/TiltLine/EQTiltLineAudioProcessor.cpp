@@ -1,5 +1,21 @@
 #include "EQTiltLineAudioProcessor.h"
 
+namespace
+{
+using Param = EQTiltLineAudioProcessor::Param;
+using Spec = gls::ParameterSpec;
+
+constexpr std::array<Spec, (size_t) Param::count> parameterTable {{
+    Spec::range ("tilt",        "Tilt",        -12.0f, 12.0f,   0.1f,  0.0f),
+    Spec::range ("pivot_freq",  "Pivot Freq",  150.0f, 6000.0f, 0.01f, 1000.0f, 0.4f),
+    Spec::range ("low_shelf",   "Low Shelf",   -12.0f, 12.0f,   0.1f,  0.0f),
+    Spec::range ("high_shelf",  "High Shelf",  -12.0f, 12.0f,   0.1f,  0.0f),
+    Spec::range ("output_trim", "Output Trim", -12.0f, 12.0f,   0.1f,  0.0f)
+}};
+
+static_assert (gls::hasUniqueIds (parameterTable));
+} // namespace
+
 const std::array<EQTiltLineAudioProcessor::Preset, 3> EQTiltLineAudioProcessor::presetBank {{
     { "Bright Vocal", {
         { "tilt",        4.0f },
@@ -28,12 +44,15 @@ EQTiltLineAudioProcessor::EQTiltLineAudioProcessor()
     : DualPrecisionAudioProcessor(BusesProperties()
                         .withInput  ("Input", juce::AudioChannelSet::stereo(), true)
                         .withOutput ("Output", juce::AudioChannelSet::stereo(), true)),
-      apvts (*this, nullptr, "EQ_TILT_LINE", createParameterLayout())
+      apvts (*this, nullptr, "EQ_TILT_LINE", createParameterLayout()),
+      params (apvts, parameterTable)
 {
 }
 
 void EQTiltLineAudioProcessor::prepareToPlay (double sampleRate, int samplesPerBlock)
 {
+    DualPrecisionAudioProcessor::prepareToPlay (sampleRate, samplesPerBlock);
+
     currentSampleRate = juce::jmax (sampleRate, 44100.0);
     lastBlockSize = (juce::uint32) juce::jmax (1, samplesPerBlock);
     ensureFilterState (getTotalNumOutputChannels());
@@ -49,13 +68,15 @@ void EQTiltLineAudioProcessor::prepareToPlay (double sampleRate, int samplesPerB
         filter.prepare (spec);
         filter.reset();
     }
+
+    outputTrimGain.prepare (currentSampleRate, samplesPerBlock);
 }
 
 void EQTiltLineAudioProcessor::releaseResources()
 {
 }
 
-void EQTiltLineAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer,
+void EQTiltLineAudioProcessor::processFloat (juce::AudioBuffer<float>& buffer,
                                              juce::MidiBuffer&)
 {
     juce::ScopedNoDenormals noDenormals;
@@ -65,13 +86,10 @@ void EQTiltLineAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer,
     for (int ch = totalIn; ch < totalOut; ++ch)
         buffer.clear (ch, 0, buffer.getNumSamples());
 
-    auto get = [this](const char* id) { return apvts.getRawParameterValue (id)->load(); };
-
-    const auto tiltDb       = get ("tilt");
-    const auto pivotFreq    = get ("pivot_freq");
-    const auto lowShelfDb   = get ("low_shelf");
-    const auto highShelfDb  = get ("high_shelf");
-    const auto outputTrimDb = get ("output_trim");
+    const auto tiltDb       = params[Param::tilt];
+    const auto pivotFreq    = params[Param::pivotFreq];
+    const auto lowShelfDb   = params[Param::lowShelf];
+    const auto highShelfDb  = params[Param::highShelf];
 
     const float lowGainEffective  = lowShelfDb  - (tiltDb * 0.5f);
     const float highGainEffective = highShelfDb + (tiltDb * 0.5f);
@@ -98,7 +116,8 @@ void EQTiltLineAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer,
         }
     }
 
-    buffer.applyGain (juce::Decibels::decibelsToGain (outputTrimDb));
+    outputTrimGain.update();
+    outputTrimGain.applyGain (buffer, numSamples);
 }
 
 void EQTiltLineAudioProcessor::getStateInformation (juce::MemoryBlock& destData)
@@ -117,20 +136,7 @@ void EQTiltLineAudioProcessor::setStateInformation (const void* data, int sizeIn
 juce::AudioProcessorValueTreeState::ParameterLayout
 EQTiltLineAudioProcessor::createParameterLayout()
 {
-    std::vector<std::unique_ptr<juce::RangedAudioParameter>> params;
-
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("tilt",       "Tilt",
-                                                                   juce::NormalisableRange<float> (-12.0f, 12.0f, 0.1f), 0.0f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("pivot_freq", "Pivot Freq",
-                                                                   juce::NormalisableRange<float> (150.0f, 6000.0f, 0.01f, 0.4f), 1000.0f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("low_shelf",  "Low Shelf",
-                                                                   juce::NormalisableRange<float> (-12.0f, 12.0f, 0.1f), 0.0f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("high_shelf", "High Shelf",
-                                                                   juce::NormalisableRange<float> (-12.0f, 12.0f, 0.1f), 0.0f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("output_trim","Output Trim",
-                                                                   juce::NormalisableRange<float> (-12.0f, 12.0f, 0.1f), 0.0f));
-
-    return { params.begin(), params.end() };
+    return gls::createParameterLayout (parameterTable);
 }
 
 EQTiltLineAudioProcessorEditor::EQTiltLineAudioProcessorEditor (EQTiltLineAudioProcessor& p)
@@ -253,15 +259,14 @@ void EQTiltLineAudioProcessor::updateShelves (float pivotFreq, float lowGainDb,
         return;
 
     const auto freq = juce::jlimit (100.0f, (float) (currentSampleRate * 0.45f), pivotFreq);
-    const auto lowCoeffs  = juce::dsp::IIR::Coefficients<float>::makeLowShelf  (currentSampleRate, freq, 0.707f,
-                                                                                juce::Decibels::decibelsToGain (lowGainDb));
-    const auto highCoeffs = juce::dsp::IIR::Coefficients<float>::makeHighShelf (currentSampleRate, freq, 0.707f,
-                                                                                juce::Decibels::decibelsToGain (highGainDb));
+
+    const auto lowGain  = juce::Decibels::decibelsToGain (lowGainDb);
+    const auto highGain = juce::Decibels::decibelsToGain (highGainDb);
 
     for (auto& filter : lowShelves)
-        filter.coefficients = lowCoeffs;
+        filter.setLowShelf (currentSampleRate, freq, 0.707f, lowGain);
     for (auto& filter : highShelves)
-        filter.coefficients = highCoeffs;
+        filter.setHighShelf (currentSampleRate, freq, 0.707f, highGain);
 }
 
 juce::AudioProcessor* JUCE_CALLTYPE createPluginFilter()
@@ -1,15 +1,34 @@
 #include "EQVoxDesignerEQAudioProcessor.h"
 
+namespace
+{
+using Param = EQVoxDesignerEQAudioProcessor::Param;
+using Spec = gls::ParameterSpec;
+
+constexpr std::array<Spec, (size_t) Param::count> parameterTable {{
+    Spec::range ("chest_gain",     "Chest Gain",     -12.0f, 12.0f, 0.1f,   0.0f),
+    Spec::range ("presence_gain",  "Presence Gain",  -12.0f, 12.0f, 0.1f,   0.0f),
+    Spec::range ("sibilance_tame", "Sibilance Tame", 0.0f,   1.0f,  0.001f, 0.5f),
+    Spec::range ("air_gain",       "Air Gain",       -6.0f,  6.0f,  0.1f,   0.0f),
+    Spec::range ("exciter",        "Exciter",        0.0f,   1.0f,  0.001f, 0.3f)
+}};
+
+static_assert (gls::hasUniqueIds (parameterTable));
+} // namespace
+
 EQVoxDesignerEQAudioProcessor::EQVoxDesignerEQAudioProcessor()
     : DualPrecisionAudioProcessor(BusesProperties()
                         .withInput  ("Input", juce::AudioChannelSet::stereo(), true)
                         .withOutput ("Output", juce::AudioChannelSet::stereo(), true)),
-      apvts (*this, nullptr, "VOX_DESIGNER_EQ", createParameterLayout())
+      apvts (*this, nullptr, "VOX_DESIGNER_EQ", createParameterLayout()),
+      params (apvts, parameterTable)
 {
 }
 
 void EQVoxDesignerEQAudioProcessor::prepareToPlay (double sampleRate, int samplesPerBlock)
 {
+    DualPrecisionAudioProcessor::prepareToPlay (sampleRate, samplesPerBlock);
+
     currentSampleRate = juce::jmax (sampleRate, 44100.0);
     lastBlockSize = (juce::uint32) juce::jmax (1, samplesPerBlock);
     ensureStateSize (getTotalNumOutputChannels());
@@ -19,7 +38,7 @@ void EQVoxDesignerEQAudioProcessor::releaseResources()
 {
 }
 
-void EQVoxDesignerEQAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer,
+void EQVoxDesignerEQAudioProcessor::processFloat (juce::AudioBuffer<float>& buffer,
                                                   juce::MidiBuffer&)
 {
     juce::ScopedNoDenormals noDenormals;
@@ -29,13 +48,11 @@ void EQVoxDesignerEQAudioProcessor::processBlock (juce::AudioBuffer<float>& buff
     for (int ch = totalIn; ch < totalOut; ++ch)
         buffer.clear (ch, 0, buffer.getNumSamples());
 
-    auto get = [this](const char* id) { return apvts.getRawParameterValue (id)->load(); };
-
-    const auto chestGain     = get ("chest_gain");
-    const auto presenceGain  = get ("presence_gain");
-    const auto sibilanceTame = juce::jlimit (0.0f, 1.0f, get ("sibilance_tame"));
-    const auto airGain       = get ("air_gain");
-    const auto exciter       = juce::jlimit (0.0f, 1.0f, get ("exciter"));
+    const auto chestGain     = params[Param::chestGain];
+    const auto presenceGain  = params[Param::presenceGain];
+    const auto sibilanceTame = juce::jlimit (0.0f, 1.0f, params[Param::sibilanceTame]);
+    const auto airGain       = params[Param::airGain];
+    const auto exciter       = juce::jlimit (0.0f, 1.0f, params[Param::exciter]);
 
     const int numChannels = buffer.getNumChannels();
     const int numSamples  = buffer.getNumSamples();
@@ -48,7 +65,7 @@ void EQVoxDesignerEQAudioProcessor::processBlock (juce::AudioBuffer<float>& buff
     const float exciterDrive = 1.0f + exciter * 2.0f;
     const float sibilanceThreshold = juce::Decibels::decibelsToGain (-12.0f);
     const float attackCoeff  = std::exp (-1.0f / (0.0025f * (float) currentSampleRate));
-    const float releaseCoeff = std::exp (-1.0f / (0.08f * (float) currentSampleRate));
+    const float releaseCoeff = std::exp (-1.0f / (releaseSeconds * (float) currentSampleRate));
 
     juce::dsp::AudioBlock<float> block (buffer);
     for (int ch = 0; ch < numChannels; ++ch)
@@ -90,6 +107,11 @@ void EQVoxDesignerEQAudioProcessor::processBlock (juce::AudioBuffer<float>& buff
     }
 }
 
+void EQVoxDesignerEQAudioProcessor::updateTail()
+{
+    tail.setTail (0.0, gls::dsp::TailTracker::getEnvelopeRT60 (releaseSeconds));
+}
+
 void EQVoxDesignerEQAudioProcessor::getStateInformation (juce::MemoryBlock& destData)
 {
     auto state = apvts.copyState();
@@ -106,20 +128,7 @@ void EQVoxDesignerEQAudioProcessor::setStateInformation (const void* data, int s
 juce::AudioProcessorValueTreeState::ParameterLayout
 EQVoxDesignerEQAudioProcessor::createParameterLayout()
 {
-    std::vector<std::unique_ptr<juce::RangedAudioParameter>> params;
-
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("chest_gain",    "Chest Gain",
-                                                                   juce::NormalisableRange<float> (-12.0f, 12.0f, 0.1f), 0.0f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("presence_gain", "Presence Gain",
-                                                                   juce::NormalisableRange<float> (-12.0f, 12.0f, 0.1f), 0.0f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("sibilance_tame","Sibilance Tame",
-                                                                   juce::NormalisableRange<float> (0.0f, 1.0f, 0.001f), 0.5f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("air_gain",      "Air Gain",
-                                                                   juce::NormalisableRange<float> (-6.0f, 6.0f, 0.1f), 0.0f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("exciter",       "Exciter",
-                                                                   juce::NormalisableRange<float> (0.0f, 1.0f, 0.001f), 0.3f));
-
-    return { params.begin(), params.end() };
+    return gls::createParameterLayout (parameterTable);
 }
 
 EQVoxDesignerEQAudioProcessorEditor::EQVoxDesignerEQAudioProcessorEditor (EQVoxDesignerEQAudioProcessor& p)
@@ -233,25 +242,20 @@ void EQVoxDesignerEQAudioProcessor::updateFilters (float chestGain, float presen
     if (currentSampleRate <= 0.0)
         return;
 
-    auto chestCoeffs = juce::dsp::IIR::Coefficients<float>::makeLowShelf (currentSampleRate, 180.0f, 0.8f,
-                                                                          juce::Decibels::decibelsToGain (chestGain));
-    auto presenceCoeffs = juce::dsp::IIR::Coefficients<float>::makePeakFilter (currentSampleRate, 3200.0f, 1.2f,
-                                                                               juce::Decibels::decibelsToGain (presenceGain));
-    auto sibilanceCoeffs = juce::dsp::IIR::Coefficients<float>::makeBandPass (currentSampleRate, 6500.0f, 2.5f);
-    auto airCoeffs = juce::dsp::IIR::Coefficients<float>::makeHighShelf (currentSampleRate, 9000.0f, 0.8f,
-                                                                         juce::Decibels::decibelsToGain (airGain));
-    auto exciterCoeffs = juce::dsp::IIR::Coefficients<float>::makeHighPass (currentSampleRate, 5000.0f, 0.707f);
+    const auto chestGainLinear    = juce::Decibels::decibelsToGain (chestGain);
+    const auto presenceGainLinear = juce::Decibels::decibelsToGain (presenceGain);
+    const auto airGainLinear      = juce::Decibels::decibelsToGain (airGain);
 
     for (auto& f : chestShelves)
-        f.coefficients = chestCoeffs;
+        f.setLowShelf (currentSampleRate, 180.0f, 0.8f, chestGainLinear);
     for (auto& f : presenceBells)
-        f.coefficients = presenceCoeffs;
+        f.setPeak (currentSampleRate, 3200.0f, 1.2f, presenceGainLinear);
     for (auto& f : sibilanceFilters)
-        f.coefficients = sibilanceCoeffs;
+        f.setBandPass (currentSampleRate, 6500.0f, 2.5f);
     for (auto& f : airShelves)
-        f.coefficients = airCoeffs;
+        f.setHighShelf (currentSampleRate, 9000.0f, 0.8f, airGainLinear);
     for (auto& f : exciterHighpasses)
-        f.coefficients = exciterCoeffs;
+        f.setHighPass (currentSampleRate, 5000.0f, 0.707f);
 }
 
 juce::AudioProcessor* JUCE_CALLTYPE createPluginFilter()
@@ -1,17 +1,25 @@
 #pragma once
 
 #include <JuceHeader.h>
+#include <array>
 #include "../../DualPrecisionAudioProcessor.h"
+#include "../../ParameterTable.h"
+#include "../../dsp/Biquad.h"
 
 class EQVoxDesignerEQAudioProcessor : public DualPrecisionAudioProcessor
 {
 public:
+    enum class Param
+    {
+        chestGain, presenceGain, sibilanceTame, airGain, exciter,
+        count
+    };
+
     EQVoxDesignerEQAudioProcessor();
     ~EQVoxDesignerEQAudioProcessor() override = default;
 
     void prepareToPlay (double sampleRate, int samplesPerBlock) override;
     void releaseResources() override;
-    void processBlock (juce::AudioBuffer<float>&, juce::MidiBuffer&) override;
 
     juce::AudioProcessorEditor* createEditor() override;
     bool hasEditor() const override { return true; }
@@ -20,7 +28,6 @@ public:
     bool acceptsMidi() const override { return false; }
     bool producesMidi() const override { return false; }
     bool isMidiEffect() const override { return false; }
-    double getTailLengthSeconds() const override { return 0.0; }
 
     int getNumPrograms() override { return 1; }
     int getCurrentProgram() override { return 0; }
@@ -34,13 +41,19 @@ public:
     juce::AudioProcessorValueTreeState& getValueTreeState() { return apvts; }
     static juce::AudioProcessorValueTreeState::ParameterLayout createParameterLayout();
 
+protected:
+    void processFloat (juce::AudioBuffer<float>&, juce::MidiBuffer&) override;
+    void updateTail() override;
+
 private:
     juce::AudioProcessorValueTreeState apvts;
-    std::vector<juce::dsp::IIR::Filter<float>> chestShelves;
-    std::vector<juce::dsp::IIR::Filter<float>> presenceBells;
-    std::vector<juce::dsp::IIR::Filter<float>> sibilanceFilters;
-    std::vector<juce::dsp::IIR::Filter<float>> airShelves;
-    std::vector<juce::dsp::IIR::Filter<float>> exciterHighpasses;
+    gls::ParameterHandles<Param> params;
+    static constexpr float releaseSeconds = 0.08f;
+    std::vector<gls::dsp::Biquad> chestShelves;
+    std::vector<gls::dsp::Biquad> presenceBells;
+    std::vector<gls::dsp::Biquad> sibilanceFilters;
+    std::vector<gls::dsp::Biquad> airShelves;
+    std::vector<gls::dsp::Biquad> exciterHighpasses;
     std::vector<float> sibilanceEnvelopes;
     juce::AudioBuffer<float> dryBuffer;
     double currentSampleRate = 44100.0;
@@ -2,6 +2,24 @@
 
 namespace
 {
+using Param = GLSBusGlueAudioProcessor::Param;
+using Spec = gls::ParameterSpec;
+
+constexpr std::array<Spec, (size_t) Param::count> parameterTable {{
+    Spec::range  ("thresh",     "Threshold",   -48.0f, 0.0f,    0.1f,   -18.0f),
+    Spec::range  ("ratio",      "Ratio",       1.0f,   20.0f,   0.01f,  4.0f,   0.5f),
+    Spec::range  ("attack",     "Attack",      0.1f,   200.0f,  0.01f,  10.0f,  0.25f),
+    Spec::range  ("release",    "Release",     5.0f,   1000.0f, 0.01f,  100.0f, 0.3f),
+    Spec::range  ("knee",       "Knee",        0.0f,   18.0f,   0.1f,   3.0f),
+    Spec::range  ("sc_hpf",     "SC HPF",      20.0f,  400.0f,  0.01f,  60.0f,  0.35f),
+    Spec::range  ("input_trim", "Input Trim",  -24.0f, 24.0f,   0.1f,   0.0f),
+    Spec::range  ("mix",        "Mix",         0.0f,   1.0f,    0.001f, 1.0f),
+    Spec::range  ("output",     "Output",      -18.0f, 18.0f,   0.1f,   0.0f),
+    Spec::toggle ("ui_bypass",  "Soft Bypass", false)
+}};
+
+static_assert (gls::hasUniqueIds (parameterTable));
+
 float normaliseLog (float value, float minHz, float maxHz)
 {
     auto clamped = juce::jlimit (minHz, maxHz, value);
@@ -55,12 +73,16 @@ GLSBusGlueAudioProcessor::GLSBusGlueAudioProcessor()
     : DualPrecisionAudioProcessor(BusesProperties()
                         .withInput  ("Input", juce::AudioChannelSet::stereo(), true)
                         .withOutput ("Output", juce::AudioChannelSet::stereo(), true)),
-      apvts (*this, nullptr, "BUS_GLUE", createParameterLayout())
+      apvts (*this, nullptr, "BUS_GLUE", createParameterLayout()),
+      params (apvts, parameterTable)
 {
+    bypass.snapOnResume (dryWet);
 }
 
 void GLSBusGlueAudioProcessor::prepareToPlay (double sampleRate, int samplesPerBlock)
 {
+    DualPrecisionAudioProcessor::prepareToPlay (sampleRate, samplesPerBlock);
+
     currentSampleRate = sampleRate > 0.0 ? sampleRate : 44100.0;
     lastBlockSize = (juce::uint32) juce::jmax (1, samplesPerBlock);
 
@@ -74,15 +96,24 @@ void GLSBusGlueAudioProcessor::prepareToPlay (double sampleRate, int samplesPerB
     sidechainFilter.reset();
     detectorEnvelope = 0.0f;
     gainSmoothed = 1.0f;
+
+    for (auto* smoother : { &inputTrimGain, &mixAmount, &outputTrimGain })
+        smoother->prepare (currentSampleRate, (int) lastBlockSize);
+
+    dryWet.prepare (currentSampleRate, juce::jmax (1, getTotalNumOutputChannels()), (int) lastBlockSize);
+    bypass.prepare (sampleRate, juce::jmax (getTotalNumInputChannels(), getTotalNumOutputChannels()), samplesPerBlock);
 }
 
 void GLSBusGlueAudioProcessor::releaseResources()
 {
 }
 
-void GLSBusGlueAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer,
-                                             juce::MidiBuffer&)
+void GLSBusGlueAudioProcessor::processFloat (juce::AudioBuffer<float>& buffer,
+                                             juce::MidiBuffer& midi)
 {
+    if (renderInPreparedChunks (buffer, midi))
+        return;
+
     juce::ScopedNoDenormals noDenormals;
 
     auto totalIn  = getTotalNumInputChannels();
@@ -91,25 +122,19 @@ void GLSBusGlueAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer,
     for (int ch = totalIn; ch < totalOut; ++ch)
         buffer.clear (ch, 0, buffer.getNumSamples());
 
-    auto readParam = [this](const char* id) { return apvts.getRawParameterValue (id)->load(); };
-
-    const auto bypassed  = apvts.getRawParameterValue ("ui_bypass")->load() > 0.5f;
-    if (bypassed)
+    const auto bypassed  = params.isOn (Param::bypass);
+    if (! bypass.begin (buffer, buffer.getNumSamples(), bypassed))
         return;
 
-    const auto threshDb   = readParam ("thresh");
-    const auto ratio      = juce::jmax (1.0f, readParam ("ratio"));
-    const auto attackMs   = juce::jmax (0.1f, readParam ("attack"));
-    const auto releaseMs  = juce::jmax (1.0f, readParam ("release"));
-    const auto kneeDb     = juce::jmax (0.0f, readParam ("knee"));
-    const auto scHpf      = readParam ("sc_hpf");
-    const auto mix        = juce::jlimit (0.0f, 1.0f, readParam ("mix"));
-    const auto inputTrim  = juce::Decibels::decibelsToGain (readParam ("input_trim"));
-    const auto outputTrim = juce::Decibels::decibelsToGain (readParam ("output"));
+    const auto threshDb   = params[Param::thresh];
+    const auto ratio      = juce::jmax (1.0f, params[Param::ratio]);
+    const auto attackMs   = juce::jmax (0.1f, params[Param::attack]);
+    const auto releaseMs  = juce::jmax (1.0f, params[Param::release]);
+    const auto kneeDb     = juce::jmax (0.0f, params[Param::knee]);
+    const auto scHpf      = params[Param::scHpf];
 
     lastBlockSize = (juce::uint32) juce::jmax (1, buffer.getNumSamples());
-    buffer.applyGain (inputTrim);
-    dryBuffer.makeCopyOf (buffer, true);
+    dryWet.begin (buffer, buffer.getNumSamples(), inputTrimGain, mixAmount);
     updateSidechainFilter (scHpf);
 
     const auto attackCoeff  = std::exp (-1.0f / (attackMs * 0.001f * currentSampleRate));
@@ -147,16 +172,14 @@ void GLSBusGlueAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer,
         }
     }
 
-    for (int ch = 0; ch < numChannels; ++ch)
-    {
-        auto* wet = buffer.getWritePointer (ch);
-        const auto* dry = dryBuffer.getReadPointer (ch);
-        for (int i = 0; i < numSamples; ++i)
-            wet[i] = wet[i] * mix + dry[i] * (1.0f - mix);
-    }
+    dryWet.end (buffer, numSamples, mixAmount, outputTrimGain);
 
-    if (outputTrim != 1.0f)
-        buffer.applyGain (outputTrim);
+    bypass.end (buffer, numSamples);
+}
+
+void GLSBusGlueAudioProcessor::updateTail()
+{
+    tail.setTail (0.0, gls::dsp::TailTracker::getEnvelopeRT60 (juce::jmax (1.0f, params[Param::release]) * 0.001));
 }
 
 void GLSBusGlueAudioProcessor::getStateInformation (juce::MemoryBlock& destData)
@@ -177,25 +200,7 @@ void GLSBusGlueAudioProcessor::setStateInformation (const void* data, int sizeIn
 juce::AudioProcessorValueTreeState::ParameterLayout
 GLSBusGlueAudioProcessor::createParameterLayout()
 {
-    std::vector<std::unique_ptr<juce::RangedAudioParameter>> params;
-
-    auto dBRange      = juce::NormalisableRange<float> (-48.0f, 0.0f, 0.1f);
-    auto timeRange    = juce::NormalisableRange<float> (0.1f, 200.0f, 0.01f, 0.25f);
-    auto releaseRange = juce::NormalisableRange<float> (5.0f, 1000.0f, 0.01f, 0.3f);
-
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("thresh",  "Threshold", dBRange, -18.0f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("ratio",   "Ratio", juce::NormalisableRange<float> (1.0f, 20.0f, 0.01f, 0.5f), 4.0f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("attack",  "Attack", timeRange, 10.0f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("release", "Release", releaseRange, 100.0f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("knee",    "Knee", juce::NormalisableRange<float> (0.0f, 18.0f, 0.1f), 3.0f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("sc_hpf",  "SC HPF", juce::NormalisableRange<float> (20.0f, 400.0f, 0.01f, 0.35f), 60.0f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("input_trim", "Input Trim",
-                                                                   juce::NormalisableRange<float> (-24.0f, 24.0f, 0.1f), 0.0f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("mix",     "Mix", juce::NormalisableRange<float> (0.0f, 1.0f, 0.001f), 1.0f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("output",  "Output", juce::NormalisableRange<float> (-18.0f, 18.0f, 0.1f), 0.0f));
-    params.push_back (std::make_unique<juce::AudioParameterBool>  ("ui_bypass", "Soft Bypass", false));
-
-    return { params.begin(), params.end() };
+    return gls::createParameterLayout (parameterTable);
 }
 
 class BusGlueVisual : public juce::Component, private juce::Timer
@@ -433,8 +438,7 @@ void GLSBusGlueAudioProcessor::updateSidechainFilter (float frequency)
         return;
 
     const auto freq = juce::jlimit (10.0f, (float) (currentSampleRate * 0.45), frequency);
-    auto coeffs = juce::dsp::IIR::Coefficients<float>::makeHighPass (currentSampleRate, freq);
-    sidechainFilter.coefficients = coeffs;
+    sidechainFilter.setHighPass (currentSampleRate, freq);
 }
 
 float GLSBusGlueAudioProcessor::computeGainDb (float inputLevelDb, float thresholdDb, float ratio, float kneeDb) const
@@ -4,17 +4,27 @@
 #include <atomic>
 #include <array>
 #include "../../DualPrecisionAudioProcessor.h"
+#include "../../ParameterTable.h"
+#include "../../SmoothedParameter.h"
+#include "../../dsp/Biquad.h"
+#include "../../dsp/DryWetStage.h"
+#include "../../dsp/SoftBypass.h"
 #include "../../ui/GoodluckLookAndFeel.h"
 
 class GLSBusGlueAudioProcessor : public DualPrecisionAudioProcessor
 {
 public:
+    enum class Param
+    {
+        thresh, ratio, attack, release, knee, scHpf, inputTrim, mix, output, bypass,
+        count
+    };
+
     GLSBusGlueAudioProcessor();
     ~GLSBusGlueAudioProcessor() override = default;
 
     void prepareToPlay (double sampleRate, int samplesPerBlock) override;
     void releaseResources() override;
-    void processBlock (juce::AudioBuffer<float>&, juce::MidiBuffer&) override;
 
     juce::AudioProcessorEditor* createEditor() override;
     bool hasEditor() const override { return true; }
@@ -23,7 +33,6 @@ public:
     bool acceptsMidi() const override { return false; }
     bool producesMidi() const override { return false; }
     bool isMidiEffect() const override { return false; }
-    double getTailLengthSeconds() const override { return 0.0; }
 
     int getNumPrograms() override;
     int getCurrentProgram() override { return currentPreset; }
@@ -38,12 +47,21 @@ public:
     static juce::AudioProcessorValueTreeState::ParameterLayout createParameterLayout();
     float getLastGainReductionDb() const noexcept { return lastReductionDb.load(); }
 
+protected:
+    void processFloat (juce::AudioBuffer<float>&, juce::MidiBuffer&) override;
+    void updateTail() override;
+
 private:
     juce::AudioProcessorValueTreeState apvts;
+    gls::ParameterHandles<Param> params;
+    gls::SmoothedParameter inputTrimGain  { params, Param::inputTrim, gls::SmoothedParameter::Mapping::decibels };
+    gls::SmoothedParameter mixAmount      { params, Param::mix };
+    gls::SmoothedParameter outputTrimGain { params, Param::output,    gls::SmoothedParameter::Mapping::decibels };
+    gls::dsp::SoftBypass bypass;
     double currentSampleRate = 44100.0;
     juce::uint32 lastBlockSize = 512;
-    juce::AudioBuffer<float> dryBuffer;
-    juce::dsp::IIR::Filter<float> sidechainFilter;
+    gls::dsp::DryWetStage dryWet;
+    gls::dsp::Biquad sidechainFilter;
     float detectorEnvelope = 0.0f;
     float gainSmoothed = 1.0f;
     std::atomic<float> lastReductionDb { 0.0f };
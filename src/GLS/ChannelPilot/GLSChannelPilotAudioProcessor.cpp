@@ -13,6 +13,23 @@ constexpr auto kParamSlope     = "filter_slope";
 constexpr auto kParamAutoGain  = "auto_gain";
 constexpr auto kParamBypass    = "ui_bypass";
 
+using Param = GLSChannelPilotAudioProcessor::Param;
+using Spec = gls::ParameterSpec;
+
+constexpr std::array<Spec, (size_t) Param::count> parameterTable {{
+    Spec::range  (kParamInputTrim, "Input Trim",   -24.0f,  24.0f,    0.01f,   0.0f),
+    Spec::range  (kParamHpf,       "HPF Freq",     20.0f,   400.0f,   0.01f,   60.0f,    0.3f),
+    Spec::range  (kParamLpf,       "LPF Freq",     4000.0f, 20000.0f, 0.01f,   12000.0f, 0.4f),
+    Spec::toggle (kParamPhase,     "Phase",        false),
+    Spec::range  (kParamPan,       "Pan",          -1.0f,   1.0f,     0.0001f, 0.0f),
+    Spec::range  (kParamOutput,    "Output Trim",  -24.0f,  24.0f,    0.01f,   0.0f),
+    Spec::choice (kParamSlope,     "Filter Slope", "12 dB|24 dB", 0),
+    Spec::toggle (kParamAutoGain,  "Auto Gain",    false),
+    Spec::toggle (kParamBypass,    "Soft Bypass",  false)
+}};
+
+static_assert (gls::hasUniqueIds (parameterTable));
+
 class ChannelPilotHeroComponent : public juce::Component, private juce::Timer
 {
 public:
@@ -178,23 +195,35 @@ GLSChannelPilotAudioProcessor::GLSChannelPilotAudioProcessor()
     : DualPrecisionAudioProcessor (BusesProperties()
                         .withInput  ("Input", juce::AudioChannelSet::stereo(), true)
                         .withOutput ("Output", juce::AudioChannelSet::stereo(), true)),
-      apvts (*this, nullptr, kStateId, createParameterLayout())
+      apvts (*this, nullptr, kStateId, createParameterLayout()),
+      params (apvts, parameterTable)
 {
+    bypass.snapOnResume ({ &inputTrimGain, &outputTrimGain });
 }
 
 void GLSChannelPilotAudioProcessor::prepareToPlay (double sampleRate, int samplesPerBlock)
 {
+    DualPrecisionAudioProcessor::prepareToPlay (sampleRate, samplesPerBlock);
+
     currentSampleRate = juce::jmax (sampleRate, 44100.0);
     ensureFilterStateSize();
+
+    bypass.prepare (sampleRate, juce::jmax (getTotalNumInputChannels(), getTotalNumOutputChannels()), samplesPerBlock);
+
+    for (auto* smoother : { &inputTrimGain, &outputTrimGain })
+        smoother->prepare (currentSampleRate, samplesPerBlock);
 }
 
 void GLSChannelPilotAudioProcessor::releaseResources()
 {
 }
 
-void GLSChannelPilotAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer,
-                                                  juce::MidiBuffer&)
+void GLSChannelPilotAudioProcessor::processFloat (juce::AudioBuffer<float>& buffer,
+                                                  juce::MidiBuffer& midi)
 {
+    if (renderInPreparedChunks (buffer, midi))
+        return;
+
     juce::ScopedNoDenormals noDenormals;
 
     const auto totalNumInputChannels  = getTotalNumInputChannels();
@@ -204,23 +233,26 @@ void GLSChannelPilotAudioProcessor::processBlock (juce::AudioBuffer<float>& buff
     for (int i = totalNumInputChannels; i < totalNumOutputChannels; ++i)
         buffer.clear (i, 0, numSamples);
 
-    if (apvts.getRawParameterValue (kParamBypass)->load() > 0.5f)
+    if (! bypass.begin (buffer, numSamples, params.isOn (Param::bypass)))
         return;
 
-    const auto inputTrimDb   = apvts.getRawParameterValue (kParamInputTrim)->load();
-    const auto hpfFreq       = apvts.getRawParameterValue (kParamHpf)->load();
-    const auto lpfFreq       = apvts.getRawParameterValue (kParamLpf)->load();
-    const auto phaseInvert   = apvts.getRawParameterValue (kParamPhase)->load() > 0.5f;
-    const auto panValue      = juce::jlimit (-1.0f, 1.0f, apvts.getRawParameterValue (kParamPan)->load());
-    const auto outputTrimDb  = apvts.getRawParameterValue (kParamOutput)->load();
-    const auto slopeChoice   = (int) apvts.getRawParameterValue (kParamSlope)->load();
-    const bool autoGainEnabled = apvts.getRawParameterValue (kParamAutoGain)->load() > 0.5f;
+    const auto hpfFreq       = params[Param::hpfFreq];
+    const auto lpfFreq       = params[Param::lpfFreq];
+    const auto phaseInvert   = params.isOn (Param::phase);
+    const auto panValue      = juce::jlimit (-1.0f, 1.0f, params[Param::pan]);
+    const auto slopeChoice   = params.getIndex (Param::filterSlope);
+    const bool autoGainEnabled = params.isOn (Param::autoGain);
 
     ensureFilterStateSize();
     updateFilterCoefficients (hpfFreq, lpfFreq, slopeChoice);
 
-    const auto inputGain  = juce::Decibels::decibelsToGain (inputTrimDb);
-    const auto outputGain = juce::Decibels::decibelsToGain (outputTrimDb);
+    for (auto* smoother : { &inputTrimGain, &outputTrimGain })
+        smoother->update();
+
+    const auto* inputGains  = inputTrimGain.advance (numSamples);
+    const auto* outputGains = outputTrimGain.advance (numSamples);
+    const auto inputGain    = inputTrimGain.getCurrentValue();
+    const auto outputGain   = outputTrimGain.getCurrentValue();
     const bool useSecondStage = slopeChoice > 0;
     double inputEnergy = 0.0;
     double filteredEnergy = 0.0;
@@ -234,7 +266,7 @@ void GLSChannelPilotAudioProcessor::processBlock (juce::AudioBuffer<float>& buff
 
         for (int sample = 0; sample < numSamples; ++sample)
         {
-            float value = channelData[sample] * inputGain;
+            float value = channelData[sample] * (inputGains != nullptr ? inputGains[sample] : inputGain);
             inputEnergy += value * value;
 
             value = hpfStages[0].processSample (value);
@@ -280,7 +312,6 @@ void GLSChannelPilotAudioProcessor::processBlock (juce::AudioBuffer<float>& buff
 
     lastAutoGain.store (autoGainFactor);
 
-    const float appliedOutputGain = outputGain * autoGainFactor;
     const float panAngle = (panValue + 1.0f) * (juce::MathConstants<float>::pi * 0.25f);
     const float panLeft  = std::cos (panAngle);
     const float panRight = std::sin (panAngle);
@@ -292,6 +323,7 @@ void GLSChannelPilotAudioProcessor::processBlock (juce::AudioBuffer<float>& buff
 
         for (int i = 0; i < numSamples; ++i)
         {
+            const float appliedOutputGain = (outputGains != nullptr ? outputGains[i] : outputGain) * autoGainFactor;
             const float l = left[i] * panLeft * appliedOutputGain;
             const float r = right[i] * panRight * appliedOutputGain;
 
@@ -299,10 +331,21 @@ void GLSChannelPilotAudioProcessor::processBlock (juce::AudioBuffer<float>& buff
             right[i] = r;
         }
     }
+    else if (outputGains != nullptr)
+    {
+        for (int ch = 0; ch < buffer.getNumChannels(); ++ch)
+        {
+            auto* data = buffer.getWritePointer (ch);
+            for (int i = 0; i < numSamples; ++i)
+                data[i] *= outputGains[i] * autoGainFactor;
+        }
+    }
     else
     {
-        buffer.applyGain (appliedOutputGain);
+        buffer.applyGain (outputGain * autoGainFactor);
     }
+
+    bypass.end (buffer, numSamples);
 }
 
 void GLSChannelPilotAudioProcessor::getStateInformation (juce::MemoryBlock& destData)
@@ -322,36 +365,18 @@ void GLSChannelPilotAudioProcessor::setStateInformation (const void* data, int s
 
 juce::AudioProcessorValueTreeState::ParameterLayout GLSChannelPilotAudioProcessor::createParameterLayout()
 {
-    std::vector<std::unique_ptr<juce::RangedAudioParameter>> params;
-
-    params.push_back (std::make_unique<juce::AudioParameterFloat> (kParamInputTrim, "Input Trim",
-                                                                   juce::NormalisableRange<float> (-24.0f, 24.0f, 0.01f), 0.0f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> (kParamHpf, "HPF Freq",
-                                                                   juce::NormalisableRange<float> (20.0f, 400.0f, 0.01f, 0.3f), 60.0f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> (kParamLpf, "LPF Freq",
-                                                                   juce::NormalisableRange<float> (4000.0f, 20000.0f, 0.01f, 0.4f), 12000.0f));
-    params.push_back (std::make_unique<juce::AudioParameterBool>  (kParamPhase, "Phase", false));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> (kParamPan, "Pan",
-                                                                   juce::NormalisableRange<float> (-1.0f, 1.0f, 0.0001f), 0.0f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> (kParamOutput, "Output Trim",
-                                                                   juce::NormalisableRange<float> (-24.0f, 24.0f, 0.01f), 0.0f));
-    params.push_back (std::make_unique<juce::AudioParameterChoice> (kParamSlope, "Filter Slope",
-                                                                    juce::StringArray { "12 dB", "24 dB" }, 0));
-    params.push_back (std::make_unique<juce::AudioParameterBool>  (kParamAutoGain, "Auto Gain", false));
-    params.push_back (std::make_unique<juce::AudioParameterBool>  (kParamBypass, "Soft Bypass", false));
-
-    return { params.begin(), params.end() };
+    return gls::createParameterLayout (parameterTable);
 }
 
 void GLSChannelPilotAudioProcessor::updateFilterCoefficients (float hpfFreq, float lpfFreq, int slopeChoice)
 {
     const bool useSecondStage = slopeChoice > 0;
-    const auto setup = [&](juce::dsp::IIR::Filter<float>& filter, float freq, bool isHigh)
+    const auto setup = [&](gls::dsp::Biquad& filter, float freq, bool isHigh)
     {
         if (isHigh)
-            filter.coefficients = juce::dsp::IIR::Coefficients<float>::makeHighPass (currentSampleRate, freq, 0.707f);
+            filter.setHighPass (currentSampleRate, freq, 0.707f);
         else
-            filter.coefficients = juce::dsp::IIR::Coefficients<float>::makeLowPass (currentSampleRate, freq, 0.707f);
+            filter.setLowPass (currentSampleRate, freq, 0.707f);
     };
 
     for (auto& pair : filterPairs)
@@ -3,17 +3,27 @@
 #include <JuceHeader.h>
 #include <array>
 #include "../../DualPrecisionAudioProcessor.h"
+#include "../../ParameterTable.h"
+#include "../../SmoothedParameter.h"
+#include "../../dsp/Biquad.h"
+#include "../../dsp/SoftBypass.h"
 #include "../../ui/GoodluckLookAndFeel.h"
 
 class GLSChannelPilotAudioProcessor : public DualPrecisionAudioProcessor
 {
 public:
+    enum class Param
+    {
+        inputTrim, hpfFreq, lpfFreq, phase, pan, outputTrim, filterSlope, autoGain,
+        bypass,
+        count
+    };
+
     GLSChannelPilotAudioProcessor();
     ~GLSChannelPilotAudioProcessor() override = default;
 
     void prepareToPlay (double sampleRate, int samplesPerBlock) override;
     void releaseResources() override;
-    void processBlock (juce::AudioBuffer<float>&, juce::MidiBuffer&) override;
 
     juce::AudioProcessorEditor* createEditor() override;
     bool hasEditor() const override { return true; }
@@ -22,7 +32,6 @@ public:
     bool acceptsMidi() const override { return false; }
     bool producesMidi() const override { return false; }
     bool isMidiEffect() const override { return false; }
-    double getTailLengthSeconds() const override { return 0.0; }
 
     int getNumPrograms() override;
     int getCurrentProgram() override { return currentPreset; }
@@ -37,8 +46,15 @@ public:
     static juce::AudioProcessorValueTreeState::ParameterLayout createParameterLayout();
     float getAutoGainMeter() const noexcept { return lastAutoGain.load(); }
 
+protected:
+    void processFloat (juce::AudioBuffer<float>&, juce::MidiBuffer&) override;
+
 private:
     juce::AudioProcessorValueTreeState apvts;
+    gls::ParameterHandles<Param> params;
+    gls::SmoothedParameter inputTrimGain  { params, Param::inputTrim,   gls::SmoothedParameter::Mapping::decibels };
+    gls::SmoothedParameter outputTrimGain { params, Param::outputTrim,  gls::SmoothedParameter::Mapping::decibels };
+    gls::dsp::SoftBypass bypass;
     double currentSampleRate = 44100.0;
     float autoGainState = 1.0f;
     std::atomic<float> lastAutoGain { 1.0f };
@@ -46,8 +62,8 @@ private:
 
     struct FilterPair
     {
-        std::array<juce::dsp::IIR::Filter<float>, 2> highPass;
-        std::array<juce::dsp::IIR::Filter<float>, 2> lowPass;
+        std::array<gls::dsp::Biquad, 2> highPass;
+        std::array<gls::dsp::Biquad, 2> lowPass;
     };
 
     std::vector<FilterPair> filterPairs;
@@ -1,20 +1,53 @@
 #include "GLSChannelStripOneAudioProcessor.h"
 #include <array>
 
+namespace
+{
+using Param = GLSChannelStripOneAudioProcessor::Param;
+using Spec = gls::ParameterSpec;
+
+constexpr std::array<Spec, (size_t) Param::count> parameterTable {{
+    Spec::range  ("gate_thresh",   "Gate Thresh",  -60.0f, 0.0f,    0.1f,   -40.0f),
+    Spec::range  ("gate_range",    "Gate Range",   0.0f,   60.0f,   0.1f,   20.0f),
+    Spec::range  ("comp_thresh",   "Comp Thresh",  -60.0f, 0.0f,    0.1f,   -20.0f),
+    Spec::range  ("comp_ratio",    "Comp Ratio",   1.0f,   20.0f,   0.01f,  4.0f,   0.5f),
+    Spec::range  ("comp_attack",   "Comp Attack",  0.1f,   200.0f,  0.01f,  10.0f,  0.25f),
+    Spec::range  ("comp_release",  "Comp Release", 5.0f,   1000.0f, 0.01f,  150.0f, 0.3f),
+    Spec::range  ("low_gain",      "Low Gain",     -15.0f, 15.0f,   0.1f,   0.0f),
+    Spec::range  ("low_mid_gain",  "LowMid Gain",  -15.0f, 15.0f,   0.1f,   0.0f),
+    Spec::range  ("high_mid_gain", "HighMid Gain", -15.0f, 15.0f,   0.1f,   0.0f),
+    Spec::range  ("high_gain",     "High Gain",    -15.0f, 15.0f,   0.1f,   0.0f),
+    Spec::range  ("sat_amount",    "Sat Amount",   0.0f,   1.0f,    0.001f, 0.2f),
+    Spec::range  ("mix",           "Mix",          0.0f,   1.0f,    0.001f, 1.0f),
+    Spec::range  ("input_trim",    "Input Trim",   -24.0f, 24.0f,   0.1f,   0.0f),
+    Spec::range  ("output_trim",   "Output Trim",  -24.0f, 24.0f,   0.1f,   0.0f),
+    Spec::toggle ("ui_bypass",     "Soft Bypass",  false)
+}};
+
+static_assert (gls::hasUniqueIds (parameterTable));
+} // namespace
+
 GLSChannelStripOneAudioProcessor::GLSChannelStripOneAudioProcessor()
     : DualPrecisionAudioProcessor (BusesProperties()
                         .withInput  ("Input", juce::AudioChannelSet::stereo(), true)
                         .withOutput ("Output", juce::AudioChannelSet::stereo(), true)),
-      apvts (*this, nullptr, "CHANNEL_STRIP_ONE", createParameterLayout())
+      apvts (*this, nullptr, "CHANNEL_STRIP_ONE", createParameterLayout()),
+      params (apvts, parameterTable)
 {
+    bypass.snapOnResume (dryWet);
 }
 
 void GLSChannelStripOneAudioProcessor::prepareToPlay (double sampleRate, int samplesPerBlock)
 {
+    DualPrecisionAudioProcessor::prepareToPlay (sampleRate, samplesPerBlock);
+
     currentSampleRate = sampleRate > 0.0 ? sampleRate : 44100.0;
     const auto totalChannels = juce::jmax (2, getTotalNumOutputChannels());
     const auto blockSize = juce::jmax (1, samplesPerBlock);
-    dryBuffer.setSize (totalChannels, blockSize);
+    for (auto* smoother : { &inputTrimGain, &mixAmount, &outputTrimGain })
+        smoother->prepare (currentSampleRate, blockSize);
+
+    dryWet.prepare (currentSampleRate, totalChannels, blockSize);
     ensureStateSize();
 
     for (auto& state : channelStates)
@@ -28,15 +61,20 @@ void GLSChannelStripOneAudioProcessor::prepareToPlay (double sampleRate, int sam
         state.compEnvelope = 0.0f;
         state.compGain = 1.0f;
     }
+
+    bypass.prepare (sampleRate, juce::jmax (getTotalNumInputChannels(), getTotalNumOutputChannels()), samplesPerBlock);
 }
 
 void GLSChannelStripOneAudioProcessor::releaseResources()
 {
 }
 
-void GLSChannelStripOneAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer,
-                                                     juce::MidiBuffer&)
+void GLSChannelStripOneAudioProcessor::processFloat (juce::AudioBuffer<float>& buffer,
+                                                     juce::MidiBuffer& midi)
 {
+    if (renderInPreparedChunks (buffer, midi))
+        return;
+
     juce::ScopedNoDenormals noDenormals;
 
     const auto totalNumInputChannels  = getTotalNumInputChannels();
@@ -46,36 +84,24 @@ void GLSChannelStripOneAudioProcessor::processBlock (juce::AudioBuffer<float>& b
     for (int i = totalNumInputChannels; i < totalNumOutputChannels; ++i)
         buffer.clear (i, 0, numSamples);
 
-    auto readParam = [this](const juce::String& id)
-    {
-        if (auto* param = apvts.getRawParameterValue (id))
-            return param->load();
-        return 0.0f;
-    };
-
-    const bool bypassed   = readParam ("ui_bypass") > 0.5f;
-    if (bypassed)
+    const bool bypassed   = params.isOn (Param::bypass);
+    if (! bypass.begin (buffer, numSamples, bypassed))
         return;
 
-    const auto gateThresh  = readParam ("gate_thresh");
-    const auto gateRange   = readParam ("gate_range");
-    const auto compThresh  = readParam ("comp_thresh");
-    const auto compRatio   = juce::jmax (1.0f, readParam ("comp_ratio"));
-    const auto compAttack  = juce::jmax (0.1f, readParam ("comp_attack"));
-    const auto compRelease = juce::jmax (1.0f, readParam ("comp_release"));
-    const auto lowGain     = readParam ("low_gain");
-    const auto lowMidGain  = readParam ("low_mid_gain");
-    const auto highMidGain = readParam ("high_mid_gain");
-    const auto highGain    = readParam ("high_gain");
-    const auto satAmount   = juce::jlimit (0.0f, 1.0f, readParam ("sat_amount"));
-    const auto mix         = juce::jlimit (0.0f, 1.0f, readParam ("mix"));
-    const auto inputTrim   = juce::Decibels::decibelsToGain (readParam ("input_trim"));
-    const auto outputTrim  = juce::Decibels::decibelsToGain (readParam ("output_trim"));
+    const auto gateThresh  = params[Param::gateThresh];
+    const auto gateRange   = params[Param::gateRange];
+    const auto compThresh  = params[Param::compThresh];
+    const auto compRatio   = juce::jmax (1.0f, params[Param::compRatio]);
+    const auto compAttack  = juce::jmax (0.1f, params[Param::compAttack]);
+    const auto compRelease = juce::jmax (1.0f, params[Param::compRelease]);
+    const auto lowGain     = params[Param::lowGain];
+    const auto lowMidGain  = params[Param::lowMidGain];
+    const auto highMidGain = params[Param::highMidGain];
+    const auto highGain    = params[Param::highGain];
+    const auto satAmount   = juce::jlimit (0.0f, 1.0f, params[Param::satAmount]);
 
     ensureStateSize();
-    buffer.applyGain (inputTrim);
-    dryBuffer.setSize (buffer.getNumChannels(), numSamples, false, false, true);
-    dryBuffer.makeCopyOf (buffer, true);
+    dryWet.begin (buffer, numSamples, inputTrimGain, mixAmount);
 
     const auto gateThresholdLinear = juce::Decibels::decibelsToGain (gateThresh);
     const auto gateAttenuation     = juce::Decibels::decibelsToGain (-juce::jmax (0.0f, gateRange));
@@ -92,7 +118,6 @@ void GLSChannelStripOneAudioProcessor::processBlock (juce::AudioBuffer<float>& b
         updateEqCoefficients (state, lowGain, lowMidGain, highMidGain, highGain);
 
         auto* data = buffer.getWritePointer (ch);
-        const auto* dry = dryBuffer.getReadPointer (ch);
 
         for (int i = 0; i < numSamples; ++i)
         {
@@ -137,13 +162,18 @@ void GLSChannelStripOneAudioProcessor::processBlock (juce::AudioBuffer<float>& b
 
             data[i] = sample;
         }
-
-        // Mix
-        for (int i = 0; i < numSamples; ++i)
-            data[i] = data[i] * mix + dry[i] * (1.0f - mix);
     }
 
-    buffer.applyGain (outputTrim);
+    dryWet.end (buffer, numSamples, mixAmount, outputTrimGain);
+
+    bypass.end (buffer, numSamples);
+}
+
+void GLSChannelStripOneAudioProcessor::updateTail()
+{
+    // The compressor and the gate's 5 ms envelope both settle before the strip goes quiet.
+    const auto releaseSeconds = juce::jmax (1.0f, params[Param::compRelease]) * 0.001;
+    tail.setTail (0.0, gls::dsp::TailTracker::getEnvelopeRT60 (juce::jmax (0.005, releaseSeconds)));
 }
 
 void GLSChannelStripOneAudioProcessor::getStateInformation (juce::MemoryBlock& destData)
@@ -163,30 +193,7 @@ void GLSChannelStripOneAudioProcessor::setStateInformation (const void* data, in
 juce::AudioProcessorValueTreeState::ParameterLayout
 GLSChannelStripOneAudioProcessor::createParameterLayout()
 {
-    std::vector<std::unique_ptr<juce::RangedAudioParameter>> params;
-
-    auto dBRange    = juce::NormalisableRange<float> (-60.0f, 0.0f, 0.1f);
-    auto gainRange  = juce::NormalisableRange<float> (-15.0f, 15.0f, 0.1f);
-    auto timeRange  = juce::NormalisableRange<float> (0.1f, 200.0f, 0.01f, 0.25f);
-    auto trimRange  = juce::NormalisableRange<float> (-24.0f, 24.0f, 0.1f);
-
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("gate_thresh",  "Gate Thresh", dBRange, -40.0f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("gate_range",   "Gate Range",  juce::NormalisableRange<float> (0.0f, 60.0f, 0.1f), 20.0f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("comp_thresh",  "Comp Thresh", dBRange, -20.0f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("comp_ratio",   "Comp Ratio",  juce::NormalisableRange<float> (1.0f, 20.0f, 0.01f, 0.5f), 4.0f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("comp_attack",  "Comp Attack", timeRange, 10.0f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("comp_release", "Comp Release", juce::NormalisableRange<float> (5.0f, 1000.0f, 0.01f, 0.3f), 150.0f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("low_gain",     "Low Gain",     gainRange, 0.0f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("low_mid_gain", "LowMid Gain",  gainRange, 0.0f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("high_mid_gain","HighMid Gain", gainRange, 0.0f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("high_gain",    "High Gain",    gainRange, 0.0f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("sat_amount",   "Sat Amount",   juce::NormalisableRange<float> (0.0f, 1.0f, 0.001f), 0.2f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("mix",          "Mix",          juce::NormalisableRange<float> (0.0f, 1.0f, 0.001f), 1.0f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("input_trim",   "Input Trim",   trimRange, 0.0f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("output_trim",  "Output Trim",  trimRange, 0.0f));
-    params.push_back (std::make_unique<juce::AudioParameterBool>  ("ui_bypass",    "Soft Bypass",  false));
-
-    return { params.begin(), params.end() };
+    return gls::createParameterLayout (parameterTable);
 }
 
 class ChannelStripVisual : public juce::Component, private juce::Timer
@@ -492,19 +499,11 @@ void GLSChannelStripOneAudioProcessor::updateEqCoefficients (ChannelState& state
                                                              float lowGain, float lowMidGain,
                                                              float highMidGain, float highGain)
 {
-    const auto lowShelfCoeffs = juce::dsp::IIR::Coefficients<float>::makeLowShelf (currentSampleRate, 120.0f, 0.707f,
-                                                                                   juce::Decibels::decibelsToGain (lowGain));
-    const auto lowMidCoeffs   = juce::dsp::IIR::Coefficients<float>::makePeakFilter (currentSampleRate, 400.0f, 0.9f,
-                                                                                     juce::Decibels::decibelsToGain (lowMidGain));
-    const auto highMidCoeffs  = juce::dsp::IIR::Coefficients<float>::makePeakFilter (currentSampleRate, 3000.0f, 0.9f,
-                                                                                     juce::Decibels::decibelsToGain (highMidGain));
-    const auto highShelfCoeffs= juce::dsp::IIR::Coefficients<float>::makeHighShelf (currentSampleRate, 8000.0f, 0.707f,
-                                                                                    juce::Decibels::decibelsToGain (highGain));
-
-    state.lowShelf.coefficients  = lowShelfCoeffs;
-    state.lowMidBell.coefficients= lowMidCoeffs;
-    state.highMidBell.coefficients= highMidCoeffs;
-    state.highShelf.coefficients = highShelfCoeffs;
+
+    state.lowShelf.setLowShelf (currentSampleRate, 120.0f, 0.707f, juce::Decibels::decibelsToGain (lowGain));
+    state.lowMidBell.setPeak (currentSampleRate, 400.0f, 0.9f, juce::Decibels::decibelsToGain (lowMidGain));
+    state.highMidBell.setPeak (currentSampleRate, 3000.0f, 0.9f, juce::Decibels::decibelsToGain (highMidGain));
+    state.highShelf.setHighShelf (currentSampleRate, 8000.0f, 0.707f, juce::Decibels::decibelsToGain (highGain));
 }
 
 float GLSChannelStripOneAudioProcessor::softClip (float input, float amount)
@@ -2,17 +2,29 @@
 
 #include <JuceHeader.h>
 #include "../../DualPrecisionAudioProcessor.h"
+#include "../../ParameterTable.h"
+#include "../../SmoothedParameter.h"
+#include "../../dsp/Biquad.h"
+#include "../../dsp/DryWetStage.h"
+#include "../../dsp/SoftBypass.h"
 #include "../../ui/GoodluckLookAndFeel.h"
 
 class GLSChannelStripOneAudioProcessor : public DualPrecisionAudioProcessor
 {
 public:
+    enum class Param
+    {
+        gateThresh, gateRange, compThresh, compRatio, compAttack, compRelease, lowGain,
+        lowMidGain, highMidGain, highGain, satAmount, mix, inputTrim, outputTrim,
+        bypass,
+        count
+    };
+
     GLSChannelStripOneAudioProcessor();
     ~GLSChannelStripOneAudioProcessor() override = default;
 
     void prepareToPlay (double sampleRate, int samplesPerBlock) override;
     void releaseResources() override;
-    void processBlock (juce::AudioBuffer<float>&, juce::MidiBuffer&) override;
 
     juce::AudioProcessorEditor* createEditor() override;
     bool hasEditor() const override { return true; }
@@ -21,7 +33,6 @@ public:
     bool acceptsMidi() const override { return false; }
     bool producesMidi() const override { return false; }
     bool isMidiEffect() const override { return false; }
-    double getTailLengthSeconds() const override { return 0.0; }
 
     int getNumPrograms() override { return 1; }
     int getCurrentProgram() override { return 0; }
@@ -39,14 +50,23 @@ public:
 
     static juce::AudioProcessorValueTreeState::ParameterLayout createParameterLayout();
 
+protected:
+    void processFloat (juce::AudioBuffer<float>&, juce::MidiBuffer&) override;
+    void updateTail() override;
+
 private:
     juce::AudioProcessorValueTreeState apvts;
+    gls::ParameterHandles<Param> params;
+    gls::SmoothedParameter inputTrimGain  { params, Param::inputTrim,  gls::SmoothedParameter::Mapping::decibels };
+    gls::SmoothedParameter mixAmount      { params, Param::mix };
+    gls::SmoothedParameter outputTrimGain { params, Param::outputTrim, gls::SmoothedParameter::Mapping::decibels };
+    gls::dsp::SoftBypass bypass;
     struct ChannelState
     {
-        juce::dsp::IIR::Filter<float> lowShelf;
-        juce::dsp::IIR::Filter<float> lowMidBell;
-        juce::dsp::IIR::Filter<float> highMidBell;
-        juce::dsp::IIR::Filter<float> highShelf;
+        gls::dsp::Biquad lowShelf;
+        gls::dsp::Biquad lowMidBell;
+        gls::dsp::Biquad highMidBell;
+        gls::dsp::Biquad highShelf;
         float gateEnvelope = 0.0f;
         float gateGain = 1.0f;
         float compEnvelope = 0.0f;
@@ -54,7 +74,7 @@ private:
     };
 
     std::vector<ChannelState> channelStates;
-    juce::AudioBuffer<float> dryBuffer;
+    gls::dsp::DryWetStage dryWet;
     double currentSampleRate = 44100.0;
 
     void ensureStateSize();
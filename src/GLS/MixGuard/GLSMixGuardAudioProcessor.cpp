@@ -1,38 +1,70 @@
 #include "GLSMixGuardAudioProcessor.h"
 
+namespace
+{
+constexpr float kMaxLookaheadMs = 20.0f;
+constexpr float kAutoGainRangeDb = 12.0f;
+constexpr float kAutoGainRate = 0.025f;  // fraction of the short-term error corrected per 100 ms
+
+using Param = GLSMixGuardAudioProcessor::Param;
+using Spec = gls::ParameterSpec;
+
+constexpr std::array<Spec, (size_t) Param::count> parameterTable {{
+    Spec::range  ("ceiling",       "Ceiling",       -12.0f, 0.0f,            0.1f,  -1.0f),
+    Spec::range  ("threshold",     "Threshold",     -24.0f, 0.0f,            0.1f,  -6.0f),
+    Spec::range  ("lookahead",     "Lookahead",     0.1f,   kMaxLookaheadMs, 0.01f, 3.0f,   0.35f),
+    Spec::range  ("release",       "Release",       5.0f,   1000.0f,         0.01f, 100.0f, 0.3f),
+    Spec::range  ("target_lufs",   "Target LUFS",   -30.0f, -6.0f,           0.1f,  -14.0f),
+    Spec::toggle ("tp_enabled",    "TP Enabled",    true),
+    Spec::toggle ("fixed_latency", "Fixed Latency", false),
+    Spec::toggle ("auto_gain",     "Auto Gain",     false)
+}};
+
+static_assert (gls::hasUniqueIds (parameterTable));
+}
+
 GLSMixGuardAudioProcessor::GLSMixGuardAudioProcessor()
     : DualPrecisionAudioProcessor(BusesProperties()
                         .withInput  ("Input", juce::AudioChannelSet::stereo(), true)
                         .withOutput ("Output", juce::AudioChannelSet::stereo(), true)),
-      apvts (*this, nullptr, "MIX_GUARD", createParameterLayout())
+      apvts (*this, nullptr, "MIX_GUARD", createParameterLayout()),
+      params (apvts, parameterTable)
 {
+    for (auto& value : loudnessValues)
+        value.store (gls::dsp::LoudnessMeter::silenceLufs);
+    loudnessValues[3].store (0.0f);
 }
 
 void GLSMixGuardAudioProcessor::prepareToPlay (double sampleRate, int samplesPerBlock)
 {
+    DualPrecisionAudioProcessor::prepareToPlay (sampleRate, samplesPerBlock);
+
     currentSampleRate = sampleRate > 0.0 ? sampleRate : 44100.0;
-    limiterGain = 1.0f;
-    loudnessAccumulator = 0.0f;
-    loudnessSamples = 0;
 
-    const auto blockSize = juce::jmax (1, samplesPerBlock);
-    delaySpec.sampleRate = currentSampleRate;
-    delaySpec.maximumBlockSize = static_cast<juce::uint32> (blockSize);
-    delaySpec.numChannels = 1;
-    delaySpecConfigured = true;
+    maxLookaheadSamples = juce::roundToInt (kMaxLookaheadMs * 0.001 * currentSampleRate);
+    gainComputer.prepare (maxLookaheadSamples);
+    gainDelay.prepare (maxLookaheadSamples + gls::dsp::TruePeakDetector::latencySamples, 1.0f);
 
-    maxDelaySamples = juce::jmax (1, juce::roundToInt (currentSampleRate * 0.05));
-    delayCapacitySamples = juce::jmax (1, maxDelaySamples + 32);
+    channelStates.resize ((size_t) juce::jmax (1, getTotalNumOutputChannels()));
+    prepareChannelStates();
 
-    ensureStateSize();
-    updateDelayCapacity();
+    loudness.prepare (currentSampleRate, (int) channelStates.size());
+    autoGain.reset (currentSampleRate, 0.1);
+    autoGain.setCurrentAndTargetValue (juce::Decibels::decibelsToGain (autoGainDb));
+    ceiling.prepare (currentSampleRate, maxChunkSize);
+    publishLoudness();
+
+    latency.invalidate();
+    updateLatency (params[Param::lookahead],
+                   params.isOn (Param::fixedLatency),
+                   params.isOn (Param::tpEnabled));
 }
 
 void GLSMixGuardAudioProcessor::releaseResources()
 {
 }
 
-void GLSMixGuardAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer,
+void GLSMixGuardAudioProcessor::processFloat (juce::AudioBuffer<float>& buffer,
                                               juce::MidiBuffer&)
 {
     juce::ScopedNoDenormals noDenormals;
@@ -42,60 +74,76 @@ void GLSMixGuardAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer,
     for (int ch = totalIn; ch < totalOut; ++ch)
         buffer.clear (ch, 0, buffer.getNumSamples());
 
-    auto get = [this](const char* id) { return apvts.getRawParameterValue (id)->load(); };
-
-    const auto ceilingDb  = get ("ceiling");
-    const auto thresholdDb= get ("threshold");
-    const auto lookahead  = get ("lookahead");
-    const auto releaseMs  = get ("release");
-    const auto targetLUFS = get ("target_lufs");
-    const bool tpEnabled  = apvts.getRawParameterValue ("tp_enabled")->load() > 0.5f;
-
-    juce::ignoreUnused (targetLUFS);
+    const auto thresholdDb= params[Param::threshold];
+    const auto lookahead  = params[Param::lookahead];
+    const auto releaseMs  = params[Param::release];
+    const auto targetLUFS = params[Param::targetLufs];
+    const bool tpEnabled  = params.isOn (Param::tpEnabled);
+    const bool fixedLatency = params.isOn (Param::fixedLatency);
+    const bool autoGainEnabled = params.isOn (Param::autoGain);
 
     ensureStateSize();
-    const auto lookaheadSamples = juce::jlimit (0, maxDelaySamples, juce::roundToInt (lookahead * 0.001 * currentSampleRate));
-    const auto releaseCoeff = std::exp (-1.0f / (releaseMs * 0.001f * currentSampleRate));
-    const auto attackCoeff  = std::exp (-1.0f / (0.001f * currentSampleRate));
-    const auto ceilingGain  = juce::Decibels::decibelsToGain (ceilingDb);
+    updateLatency (lookahead, fixedLatency, tpEnabled);
+    gainComputer.setReleaseCoefficient (std::exp (-1.0f / (releaseMs * 0.001f * (float) currentSampleRate)));
+    ceiling.update();
     const auto thresholdGain= juce::Decibels::decibelsToGain (thresholdDb);
 
     const int numSamples = buffer.getNumSamples();
-    const int numChannels = buffer.getNumChannels();
-
-    for (auto& state : channelStates)
-        state.delayLine.setDelay (lookaheadSamples);
+    const int numChannels = juce::jmin (buffer.getNumChannels(), (int) channelStates.size());
 
-    for (int sample = 0; sample < numSamples; ++sample)
+    for (int start = 0; start < numSamples; start += maxChunkSize)
     {
-        float peak = 0.0f;
+        const auto chunk = juce::jmin (maxChunkSize, numSamples - start);
+        auto* gain = gainScratch.data();
+
+        applyAutoGain (buffer, start, chunk, numChannels);
+
+        // Linked peak across channels, true-peak or sample-peak.
+        std::fill (gain, gain + chunk, 0.0f);
         for (int ch = 0; ch < numChannels; ++ch)
         {
-            auto& state = channelStates[ch];
-            const float in = buffer.getSample (ch, sample);
-            state.delayLine.pushSample (0, in);
+            const auto* in = buffer.getReadPointer (ch, start);
 
-            const float tp = measureTruePeak (state, in, tpEnabled);
-            peak = juce::jmax (peak, tp);
+            if (tpEnabled)
+                truePeak.processMax (ch, in, gain, chunk);
+            else
+                for (int i = 0; i < chunk; ++i)
+                    gain[i] = juce::jmax (gain[i], std::abs (in[i]));
         }
 
-        const float targetGain = peak > thresholdGain ? thresholdGain / peak : 1.0f;
-        if (targetGain < limiterGain)
-            limiterGain = attackCoeff * (limiterGain - targetGain) + targetGain;
+        for (int i = 0; i < chunk; ++i)
+            gain[i] = gain[i] > thresholdGain ? thresholdGain / gain[i] : 1.0f;
+
+        gainComputer.process (gain, chunk);
+        gainDelay.process (gain, chunk);
+        if (const auto* ceilingGains = ceiling.advance (chunk))
+            juce::FloatVectorOperations::multiply (gain, ceilingGains, chunk);
         else
-            limiterGain = releaseCoeff * (limiterGain - targetGain) + targetGain;
+            juce::FloatVectorOperations::multiply (gain, ceiling.getCurrentValue(), chunk);
 
         for (int ch = 0; ch < numChannels; ++ch)
         {
-            auto& state = channelStates[ch];
-            float delayed = state.delayLine.popSample (0);
-            delayed *= limiterGain * ceilingGain;
-            buffer.setSample (ch, sample, delayed);
-
-            loudnessAccumulator += delayed * delayed;
-            ++loudnessSamples;
+            auto* data = buffer.getWritePointer (ch, start);
+            channelStates[(size_t) ch].delayLine.process (data, chunk);
+            juce::FloatVectorOperations::multiply (data, gain, chunk);
         }
+
+        // Metered after the limiter, so auto-gain settles on what actually leaves the plugin.
+        const auto* const* output = buffer.getArrayOfReadPointers();
+        const float* channels[2] = { output[0] + start, numChannels > 1 ? output[1] + start : nullptr };
+
+        if (loudness.process (channels, juce::jmin (numChannels, 2), chunk))
+            updateAutoGain (autoGainEnabled, targetLUFS);
     }
+
+    publishLoudness();
+}
+
+void GLSMixGuardAudioProcessor::updateTail()
+{
+    // The limiter releases, and the short-term window has to empty before the meters
+    // and the auto-gain see silence.
+    tail.setTail (3.0, gls::dsp::TailTracker::getEnvelopeRT60 (params[Param::release] * 0.001));
 }
 
 void GLSMixGuardAudioProcessor::getStateInformation (juce::MemoryBlock& destData)
@@ -114,17 +162,7 @@ void GLSMixGuardAudioProcessor::setStateInformation (const void* data, int sizeI
 juce::AudioProcessorValueTreeState::ParameterLayout
 GLSMixGuardAudioProcessor::createParameterLayout()
 {
-    std::vector<std::unique_ptr<juce::RangedAudioParameter>> params;
-
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("ceiling",    "Ceiling",   juce::NormalisableRange<float> (-12.0f, 0.0f, 0.1f), -1.0f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("threshold",  "Threshold", juce::NormalisableRange<float> (-24.0f, 0.0f, 0.1f), -6.0f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("lookahead",  "Lookahead", juce::NormalisableRange<float> (0.1f, 20.0f, 0.01f, 0.35f), 3.0f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("release",    "Release",   juce::NormalisableRange<float> (5.0f, 1000.0f, 0.01f, 0.3f), 100.0f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("target_lufs","Target LUFS",
-                                                                   juce::NormalisableRange<float> (-30.0f, -6.0f, 0.1f), -14.0f));
-    params.push_back (std::make_unique<juce::AudioParameterBool>  ("tp_enabled", "TP Enabled", true));
-
-    return { params.begin(), params.end() };
+    return gls::createParameterLayout (parameterTable);
 }
 
 GLSMixGuardAudioProcessorEditor::GLSMixGuardAudioProcessorEditor (GLSMixGuardAudioProcessor& p)
@@ -136,6 +174,8 @@ GLSMixGuardAudioProcessorEditor::GLSMixGuardAudioProcessorEditor (GLSMixGuardAud
     initialiseSlider (releaseSlider,   "Release");
     initialiseSlider (targetLufsSlider,"Target LUFS");
     addAndMakeVisible (tpButton);
+    addAndMakeVisible (fixedLatencyButton);
+    addAndMakeVisible (autoGainButton);
 
     auto& state = processorRef.getValueTreeState();
     ceilingAttachment   = std::make_unique<SliderAttachment> (state, "ceiling",    ceilingSlider);
@@ -144,8 +184,11 @@ GLSMixGuardAudioProcessorEditor::GLSMixGuardAudioProcessorEditor (GLSMixGuardAud
     releaseAttachment   = std::make_unique<SliderAttachment> (state, "release",    releaseSlider);
     targetLufsAttachment= std::make_unique<SliderAttachment> (state, "target_lufs",targetLufsSlider);
     tpAttachment        = std::make_unique<ButtonAttachment> (state, "tp_enabled", tpButton);
+    fixedLatencyAttachment = std::make_unique<ButtonAttachment> (state, "fixed_latency", fixedLatencyButton);
+    autoGainAttachment  = std::make_unique<ButtonAttachment> (state, "auto_gain",  autoGainButton);
 
-    setSize (600, 260);
+    setSize (600, 290);
+    startTimerHz (10);
 }
 
 void GLSMixGuardAudioProcessorEditor::initialiseSlider (juce::Slider& slider, const juce::String& name)
@@ -162,11 +205,25 @@ void GLSMixGuardAudioProcessorEditor::paint (juce::Graphics& g)
     g.setColour (juce::Colours::white);
     g.setFont (16.0f);
     g.drawFittedText ("GLS Mix Guard", getLocalBounds().removeFromTop (24), juce::Justification::centred, 1);
+
+    auto formatLufs = [](float lufs)
+    {
+        return lufs > gls::dsp::LoudnessMeter::absoluteGateLufs ? juce::String (lufs, 1) : juce::String ("--");
+    };
+
+    const auto snapshot = processorRef.getLoudnessSnapshot();
+    const auto readout = "M " + formatLufs (snapshot.momentary)
+                       + "   S " + formatLufs (snapshot.shortTerm)
+                       + "   I " + formatLufs (snapshot.integrated) + " LUFS"
+                       + "   Auto Gain " + juce::String (snapshot.autoGainDb, 1) + " dB";
+
+    g.setFont (13.0f);
+    g.drawFittedText (readout, getLocalBounds().removeFromBottom (28), juce::Justification::centred, 1);
 }
 
 void GLSMixGuardAudioProcessorEditor::resized()
 {
-    auto area = getLocalBounds().reduced (10);
+    auto area = getLocalBounds().withTrimmedBottom (28).reduced (10);
     auto topRow = area.removeFromTop (area.getHeight() / 2);
 
     auto layoutRow = [](juce::Rectangle<int> bounds, std::initializer_list<juce::Component*> comps)
@@ -177,8 +234,12 @@ void GLSMixGuardAudioProcessorEditor::resized()
     };
 
     layoutRow (topRow, { &ceilingSlider, &thresholdSlider, &lookaheadSlider });
+    auto toggles = area.removeFromRight (140);
     layoutRow (area,   { &releaseSlider, &targetLufsSlider });
-    tpButton.setBounds (area.removeFromRight (120).reduced (8));
+    const auto toggleHeight = toggles.getHeight() / 3;
+    tpButton.setBounds (toggles.removeFromTop (toggleHeight).reduced (8, 4));
+    fixedLatencyButton.setBounds (toggles.removeFromTop (toggleHeight).reduced (8, 4));
+    autoGainButton.setBounds (toggles.reduced (8, 4));
 }
 
 juce::AudioProcessorEditor* GLSMixGuardAudioProcessor::createEditor()
@@ -189,49 +250,95 @@ juce::AudioProcessorEditor* GLSMixGuardAudioProcessor::createEditor()
 void GLSMixGuardAudioProcessor::ensureStateSize()
 {
     const auto requiredChannels = juce::jmax (1, getTotalNumOutputChannels());
-    const auto previousSize = channelStates.size();
-
-    if (static_cast<int> (previousSize) == requiredChannels)
+    if (static_cast<int> (channelStates.size()) == requiredChannels)
         return;
 
     channelStates.resize (static_cast<size_t> (requiredChannels));
+    prepareChannelStates();
+}
 
-    if (! delaySpecConfigured || delayCapacitySamples <= 0)
-        return;
+void GLSMixGuardAudioProcessor::prepareChannelStates()
+{
+    const auto capacity = maxLookaheadSamples + gls::dsp::TruePeakDetector::latencySamples;
 
-    for (size_t idx = previousSize; idx < channelStates.size(); ++idx)
-        initialiseChannelState (channelStates[idx]);
+    for (auto& state : channelStates)
+    {
+        state.delayLine.prepare (capacity);
+        state.delayLine.setDelay (latency.getStageDelay (0) + latency.getStageDelay (1));
+    }
+
+    truePeak.prepare ((int) channelStates.size());
+    gainComputer.reset();
+    gainDelay.reset (1.0f);
 }
 
-void GLSMixGuardAudioProcessor::initialiseChannelState (ChannelState& state)
+void GLSMixGuardAudioProcessor::updateLatency (float lookaheadMs, bool fixedLatency, bool tpEnabled)
 {
-    if (! delaySpecConfigured || delayCapacitySamples <= 0)
-        return;
+    constexpr auto detectorLatency = gls::dsp::TruePeakDetector::latencySamples;
+    const auto lookaheadSamples = juce::jlimit (0, maxLookaheadSamples, juce::roundToInt (lookaheadMs * 0.001 * currentSampleRate));
+
+    latency.setMode (fixedLatency ? gls::dsp::LatencyReporter::Mode::fixed
+                                  : gls::dsp::LatencyReporter::Mode::tracking);
+    latency.setStage (0, lookaheadSamples, maxLookaheadSamples);
+    latency.setStage (1, tpEnabled ? detectorLatency : 0, detectorLatency);
+    latency.update();
+
+    // Fixed mode: the audio always runs at the full lookahead and the gain is held
+    // back by the unused part, so the detector still leads by lookaheadSamples.
+    const auto delaySamples = latency.getStageDelay (0) + latency.getStageDelay (1);
+    for (auto& state : channelStates)
+        state.delayLine.setDelay (delaySamples);
 
-    state.delayLine.prepare (delaySpec);
-    state.delayLine.setMaximumDelayInSamples (delayCapacitySamples);
-    state.delayLine.setDelay (0);
-    state.delayLine.reset();
-    state.previousSample = 0.0f;
+    gainComputer.setLookahead (lookaheadSamples);
+    gainDelay.setDelay (latency.getStagePadding (0) + latency.getStagePadding (1));
 }
 
-float GLSMixGuardAudioProcessor::measureTruePeak (ChannelState& state, float currentSample, bool tpEnabled)
+void GLSMixGuardAudioProcessor::applyAutoGain (juce::AudioBuffer<float>& buffer, int start, int numSamples, int numChannels)
 {
-    if (! tpEnabled)
-        return std::abs (currentSample);
+    if (autoGain.isSmoothing())
+    {
+        auto* ramp = gainScratch.data();
+        for (int i = 0; i < numSamples; ++i)
+            ramp[i] = autoGain.getNextValue();
 
-    const float interpolated = 0.5f * (currentSample + state.previousSample);
-    state.previousSample = currentSample;
-    return juce::jmax (std::abs (currentSample), std::abs (interpolated));
+        for (int ch = 0; ch < numChannels; ++ch)
+            juce::FloatVectorOperations::multiply (buffer.getWritePointer (ch, start), ramp, numSamples);
+    }
+    else if (const auto gain = autoGain.getCurrentValue(); gain != 1.0f)
+    {
+        for (int ch = 0; ch < numChannels; ++ch)
+            juce::FloatVectorOperations::multiply (buffer.getWritePointer (ch, start), gain, numSamples);
+    }
 }
 
-void GLSMixGuardAudioProcessor::updateDelayCapacity()
+void GLSMixGuardAudioProcessor::updateAutoGain (bool enabled, float targetLufs)
 {
-    if (! delaySpecConfigured || delayCapacitySamples <= 0)
-        return;
+    // A slow integrator on the output short-term loudness; held through silence so
+    // gaps between songs do not wind it up.
+    if (! enabled)
+        autoGainDb = 0.0f;
+    else if (const auto shortTerm = loudness.getShortTermLufs(); shortTerm > gls::dsp::LoudnessMeter::absoluteGateLufs)
+        autoGainDb = juce::jlimit (-kAutoGainRangeDb, kAutoGainRangeDb, autoGainDb + kAutoGainRate * (targetLufs - shortTerm));
+
+    autoGain.setTargetValue (juce::Decibels::decibelsToGain (autoGainDb));
+}
 
-    for (auto& state : channelStates)
-        initialiseChannelState (state);
+void GLSMixGuardAudioProcessor::publishLoudness() noexcept
+{
+    loudnessValues[0].store (loudness.getMomentaryLufs());
+    loudnessValues[1].store (loudness.getShortTermLufs());
+    loudnessValues[2].store (loudness.getIntegratedLufs());
+    loudnessValues[3].store (autoGainDb);
+}
+
+GLSMixGuardAudioProcessor::LoudnessSnapshot GLSMixGuardAudioProcessor::getLoudnessSnapshot() const noexcept
+{
+    LoudnessSnapshot snapshot;
+    snapshot.momentary  = loudnessValues[0].load();
+    snapshot.shortTerm  = loudnessValues[1].load();
+    snapshot.integrated = loudnessValues[2].load();
+    snapshot.autoGainDb = loudnessValues[3].load();
+    return snapshot;
 }
 
 
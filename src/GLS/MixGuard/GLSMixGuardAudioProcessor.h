@@ -2,16 +2,29 @@
 
 #include <JuceHeader.h>
 #include "../../DualPrecisionAudioProcessor.h"
+#include "../../ParameterTable.h"
+#include "../../SmoothedParameter.h"
+#include "../../dsp/LatencyReporter.h"
+#include "../../dsp/LoudnessMeter.h"
+#include "../../dsp/TruePeakLimiter.h"
+#include <array>
+#include <atomic>
 
 class GLSMixGuardAudioProcessor : public DualPrecisionAudioProcessor
 {
 public:
+    enum class Param
+    {
+        ceiling, threshold, lookahead, release, targetLufs, tpEnabled, fixedLatency,
+        autoGain,
+        count
+    };
+
     GLSMixGuardAudioProcessor();
     ~GLSMixGuardAudioProcessor() override = default;
 
     void prepareToPlay (double sampleRate, int samplesPerBlock) override;
     void releaseResources() override;
-    void processBlock (juce::AudioBuffer<float>&, juce::MidiBuffer&) override;
 
     juce::AudioProcessorEditor* createEditor() override;
     bool hasEditor() const override { return true; }
@@ -20,7 +33,6 @@ public:
     bool acceptsMidi() const override { return false; }
     bool producesMidi() const override { return false; }
     bool isMidiEffect() const override { return false; }
-    double getTailLengthSeconds() const override { return 0.0; }
 
     int getNumPrograms() override { return 1; }
     int getCurrentProgram() override { return 0; }
@@ -37,34 +49,58 @@ public:
     juce::AudioProcessorValueTreeState& getValueTreeState() { return apvts; }
     static juce::AudioProcessorValueTreeState::ParameterLayout createParameterLayout();
 
+    struct LoudnessSnapshot
+    {
+        float momentary  = gls::dsp::LoudnessMeter::silenceLufs;
+        float shortTerm  = gls::dsp::LoudnessMeter::silenceLufs;
+        float integrated = gls::dsp::LoudnessMeter::silenceLufs;
+        float autoGainDb = 0.0f;
+    };
+
+    LoudnessSnapshot getLoudnessSnapshot() const noexcept;
+
+protected:
+    void processFloat (juce::AudioBuffer<float>&, juce::MidiBuffer&) override;
+    void updateTail() override;
+
 private:
     juce::AudioProcessorValueTreeState apvts;
+    gls::ParameterHandles<Param> params;
+    static constexpr int maxChunkSize = 256;
+    gls::SmoothedParameter ceiling { params, Param::ceiling, gls::SmoothedParameter::Mapping::decibels };
+
     double currentSampleRate = 44100.0;
-    int maxDelaySamples = 2048;
+    int maxLookaheadSamples = 0;
+    gls::dsp::LatencyReporter latency { *this };
+    gls::dsp::TruePeakDetector truePeak;
+    gls::dsp::LookaheadGainComputer gainComputer;
+    gls::dsp::IntegerDelayLine gainDelay;
+    std::array<float, maxChunkSize> gainScratch {};
+
+    gls::dsp::LoudnessMeter loudness;
+    juce::SmoothedValue<float, juce::ValueSmoothingTypes::Multiplicative> autoGain { 1.0f };
+    float autoGainDb = 0.0f;
+    std::array<std::atomic<float>, 4> loudnessValues;
 
     struct ChannelState
     {
-        juce::dsp::DelayLine<float, juce::dsp::DelayLineInterpolationTypes::Linear> delayLine { 48000 };
-        float previousSample = 0.0f;
+        gls::dsp::IntegerDelayLine delayLine;
     };
 
     std::vector<ChannelState> channelStates;
-    float limiterGain = 1.0f;
-    float loudnessAccumulator = 0.0f;
-    int loudnessSamples = 0;
-    juce::dsp::ProcessSpec delaySpec { 44100.0, 512, 1 };
-    bool delaySpecConfigured = false;
-    int delayCapacitySamples = 0;
 
     void ensureStateSize();
-    void initialiseChannelState (ChannelState& state);
-    float measureTruePeak (ChannelState& state, float currentSample, bool tpEnabled);
-    void updateDelayCapacity();
+    void prepareChannelStates();
+    void updateLatency (float lookaheadMs, bool fixedLatency, bool tpEnabled);
+    void applyAutoGain (juce::AudioBuffer<float>& buffer, int start, int numSamples, int numChannels);
+    void updateAutoGain (bool enabled, float targetLufs);
+    void publishLoudness() noexcept;
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (GLSMixGuardAudioProcessor)
 };
 
-class GLSMixGuardAudioProcessorEditor : public juce::AudioProcessorEditor
+class GLSMixGuardAudioProcessorEditor : public juce::AudioProcessorEditor,
+                                        private juce::Timer
 {
 public:
     explicit GLSMixGuardAudioProcessorEditor (GLSMixGuardAudioProcessor&);
@@ -82,6 +118,8 @@ private:
     juce::Slider releaseSlider;
     juce::Slider targetLufsSlider;
     juce::ToggleButton tpButton { "True Peak" };
+    juce::ToggleButton fixedLatencyButton { "Fixed Latency" };
+    juce::ToggleButton autoGainButton { "Auto Gain" };
 
     using SliderAttachment = juce::AudioProcessorValueTreeState::SliderAttachment;
     using ButtonAttachment = juce::AudioProcessorValueTreeState::ButtonAttachment;
@@ -92,8 +130,11 @@ private:
     std::unique_ptr<SliderAttachment> releaseAttachment;
     std::unique_ptr<SliderAttachment> targetLufsAttachment;
     std::unique_ptr<ButtonAttachment> tpAttachment;
+    std::unique_ptr<ButtonAttachment> fixedLatencyAttachment;
+    std::unique_ptr<ButtonAttachment> autoGainAttachment;
 
     void initialiseSlider (juce::Slider& slider, const juce::String& name);
+    void timerCallback() override { repaint (getLocalBounds().removeFromBottom (28)); }
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (GLSMixGuardAudioProcessorEditor)
 };
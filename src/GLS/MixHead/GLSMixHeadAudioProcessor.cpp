@@ -1,29 +1,54 @@
 #include "GLSMixHeadAudioProcessor.h"
 
+namespace
+{
+using Param = GLSMixHeadAudioProcessor::Param;
+using Spec = gls::ParameterSpec;
+
+constexpr std::array<Spec, (size_t) Param::count> parameterTable {{
+    Spec::range ("drive",       "Drive",       0.0f,   1.0f,  0.001f, 0.25f),
+    Spec::range ("headroom",    "Headroom",    -12.0f, 12.0f, 0.1f,   0.0f),
+    Spec::range ("tone",        "Tone",        -1.0f,  1.0f,  0.001f, 0.0f),
+    Spec::range ("width",       "Width",       0.0f,   2.0f,  0.001f, 1.0f),
+    Spec::range ("output_trim", "Output Trim", -18.0f, 18.0f, 0.1f,   0.0f)
+}};
+
+static_assert (gls::hasUniqueIds (parameterTable));
+} // namespace
+
 GLSMixHeadAudioProcessor::GLSMixHeadAudioProcessor()
-    : DualPrecisionAudioProcessor(BusesProperties()
+    : NativePrecisionAudioProcessor (BusesProperties()
                         .withInput  ("Input", juce::AudioChannelSet::stereo(), true)
                         .withOutput ("Output", juce::AudioChannelSet::stereo(), true)),
-      apvts (*this, nullptr, "MIX_HEAD", createParameterLayout())
+      apvts (*this, nullptr, "MIX_HEAD", createParameterLayout()),
+      params (apvts, parameterTable)
 {
 }
 
-void GLSMixHeadAudioProcessor::prepareToPlay (double sampleRate, int /*samplesPerBlock*/)
+void GLSMixHeadAudioProcessor::prepareToPlay (double sampleRate, int samplesPerBlock)
 {
+    DualPrecisionAudioProcessor::prepareToPlay (sampleRate, samplesPerBlock);
+
     currentSampleRate = juce::jmax (sampleRate, 44100.0);
     toneSmoothingCoeff = 1.0f - std::exp (-2.0f * juce::MathConstants<float>::pi * 600.0f / (float) currentSampleRate);
     ensureStateSize();
     for (auto& state : channelStates)
-        state.toneLowState = 0.0f;
+        state.toneLowState = 0.0;
+
+    outputTrimGain.prepare (currentSampleRate, samplesPerBlock);
 }
 
 void GLSMixHeadAudioProcessor::releaseResources()
 {
 }
 
-void GLSMixHeadAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer,
-                                             juce::MidiBuffer&)
+template <typename SampleType>
+void GLSMixHeadAudioProcessor::processSamples (juce::AudioBuffer<SampleType>& buffer,
+                                               juce::MidiBuffer& midi)
 {
+    if (renderInPreparedChunks (buffer, midi))
+        return;
+
     juce::ScopedNoDenormals noDenormals;
 
     auto totalIn  = getTotalNumInputChannels();
@@ -31,22 +56,16 @@ void GLSMixHeadAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer,
     for (int ch = totalIn; ch < totalOut; ++ch)
         buffer.clear (ch, 0, buffer.getNumSamples());
 
-    auto readParam = [this](const juce::String& id)
-    {
-        return apvts.getRawParameterValue (id)->load();
-    };
-
-    const auto drive      = juce::jlimit (0.0f, 1.0f, readParam ("drive"));
-    const auto headroom   = readParam ("headroom");
-    const auto tone       = juce::jlimit (-1.0f, 1.0f, readParam ("tone"));
-    const auto widthParam = juce::jlimit (0.0f, 2.0f, readParam ("width"));
-    const auto outputTrim = juce::Decibels::decibelsToGain (readParam ("output_trim"));
+    const auto drive      = juce::jlimit ((SampleType) 0, (SampleType) 1, (SampleType) params[Param::drive]);
+    const auto headroom   = (SampleType) params[Param::headroom];
+    const auto tone       = juce::jlimit ((SampleType) -1, (SampleType) 1, (SampleType) params[Param::tone]);
+    const auto widthParam = juce::jlimit ((SampleType) 0, (SampleType) 2, (SampleType) params[Param::width]);
 
     ensureStateSize();
 
     const auto headroomGain = juce::Decibels::decibelsToGain (-headroom);
-    const auto lowTiltDb    = -tone * 4.0f;
-    const auto highTiltDb   = tone * 4.0f;
+    const auto lowTiltDb    = -tone * (SampleType) 4;
+    const auto highTiltDb   = tone * (SampleType) 4;
     const auto lowGain      = juce::Decibels::decibelsToGain (lowTiltDb);
     const auto highGain     = juce::Decibels::decibelsToGain (highTiltDb);
 
@@ -60,13 +79,13 @@ void GLSMixHeadAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer,
 
         for (int i = 0; i < numSamples; ++i)
         {
-            float sample = data[i];
+            auto sample = data[i];
 
             sample *= headroomGain;
             sample = applySaturation (sample, drive);
 
-            const float low = processTone (state, sample);
-            const float high = sample - low;
+            const auto low = processTone (state, sample);
+            const auto high = sample - low;
             sample = low * lowGain + high * highGain;
 
             data[i] = sample;
@@ -80,16 +99,33 @@ void GLSMixHeadAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer,
 
         for (int i = 0; i < numSamples; ++i)
         {
-            float mid  = 0.5f * (left[i] + right[i]);
-            float side = 0.5f * (left[i] - right[i]) * widthParam;
+            const auto mid  = (SampleType) 0.5 * (left[i] + right[i]);
+            const auto side = (SampleType) 0.5 * (left[i] - right[i]) * widthParam;
             left[i]  = mid + side;
             right[i] = mid - side;
         }
     }
 
-    buffer.applyGain (outputTrim);
+    // The ramp is rendered in float and applied at the host precision.
+    outputTrimGain.update();
+    if (const auto* gains = outputTrimGain.advance (numSamples))
+    {
+        for (int ch = 0; ch < numChannels; ++ch)
+        {
+            auto* data = buffer.getWritePointer (ch);
+            for (int i = 0; i < numSamples; ++i)
+                data[i] *= (SampleType) gains[i];
+        }
+    }
+    else
+    {
+        buffer.applyGain ((SampleType) outputTrimGain.getCurrentValue());
+    }
 }
 
+template void GLSMixHeadAudioProcessor::processSamples<float>  (juce::AudioBuffer<float>&,  juce::MidiBuffer&);
+template void GLSMixHeadAudioProcessor::processSamples<double> (juce::AudioBuffer<double>&, juce::MidiBuffer&);
+
 void GLSMixHeadAudioProcessor::getStateInformation (juce::MemoryBlock& destData)
 {
     auto state = apvts.copyState();
@@ -106,15 +142,7 @@ void GLSMixHeadAudioProcessor::setStateInformation (const void* data, int sizeIn
 juce::AudioProcessorValueTreeState::ParameterLayout
 GLSMixHeadAudioProcessor::createParameterLayout()
 {
-    std::vector<std::unique_ptr<juce::RangedAudioParameter>> params;
-
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("drive",       "Drive",       juce::NormalisableRange<float> (0.0f, 1.0f, 0.001f), 0.25f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("headroom",    "Headroom",    juce::NormalisableRange<float> (-12.0f, 12.0f, 0.1f), 0.0f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("tone",        "Tone",        juce::NormalisableRange<float> (-1.0f, 1.0f, 0.001f), 0.0f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("width",       "Width",       juce::NormalisableRange<float> (0.0f, 2.0f, 0.001f), 1.0f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("output_trim", "Output Trim", juce::NormalisableRange<float> (-18.0f, 18.0f, 0.1f), 0.0f));
-
-    return { params.begin(), params.end() };
+    return gls::createParameterLayout (parameterTable);
 }
 
 GLSMixHeadAudioProcessorEditor::GLSMixHeadAudioProcessorEditor (GLSMixHeadAudioProcessor& p)
@@ -179,18 +207,20 @@ void GLSMixHeadAudioProcessor::ensureStateSize()
         channelStates.resize (requiredChannels);
 }
 
-float GLSMixHeadAudioProcessor::processTone (ChannelState& state, float sample) const
+template <typename SampleType>
+SampleType GLSMixHeadAudioProcessor::processTone (ChannelState& state, SampleType sample) const
 {
-    state.toneLowState += toneSmoothingCoeff * (sample - state.toneLowState);
-    return state.toneLowState;
+    state.toneLowState += (double) toneSmoothingCoeff * ((double) sample - state.toneLowState);
+    return (SampleType) state.toneLowState;
 }
 
-float GLSMixHeadAudioProcessor::applySaturation (float sample, float drive)
+template <typename SampleType>
+SampleType GLSMixHeadAudioProcessor::applySaturation (SampleType sample, SampleType drive)
 {
-    if (drive <= 0.0f)
+    if (drive <= (SampleType) 0)
         return sample;
 
-    const auto driveAmount = juce::jmap (drive, 1.0f, 8.0f);
+    const auto driveAmount = juce::jmap (drive, (SampleType) 1, (SampleType) 8);
     const auto saturated = std::tanh (sample * driveAmount);
     return juce::jmap (drive, sample, saturated);
 }
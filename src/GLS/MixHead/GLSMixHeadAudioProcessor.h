@@ -1,17 +1,28 @@
 #pragma once
 
 #include <JuceHeader.h>
+#include <array>
 #include "../../DualPrecisionAudioProcessor.h"
+#include "../../ParameterTable.h"
+#include "../../SmoothedParameter.h"
 
-class GLSMixHeadAudioProcessor : public DualPrecisionAudioProcessor
+class GLSMixHeadAudioProcessor : public NativePrecisionAudioProcessor<GLSMixHeadAudioProcessor>
 {
 public:
+    enum class Param
+    {
+        drive, headroom, tone, width, outputTrim,
+        count
+    };
+
     GLSMixHeadAudioProcessor();
     ~GLSMixHeadAudioProcessor() override = default;
 
     void prepareToPlay (double sampleRate, int samplesPerBlock) override;
     void releaseResources() override;
-    void processBlock (juce::AudioBuffer<float>&, juce::MidiBuffer&) override;
+
+    template <typename SampleType>
+    void processSamples (juce::AudioBuffer<SampleType>&, juce::MidiBuffer&);
 
     juce::AudioProcessorEditor* createEditor() override;
     bool hasEditor() const override { return true; }
@@ -20,7 +31,6 @@ public:
     bool acceptsMidi() const override { return false; }
     bool producesMidi() const override { return false; }
     bool isMidiEffect() const override { return false; }
-    double getTailLengthSeconds() const override { return 0.0; }
 
     int getNumPrograms() override { return 1; }
     int getCurrentProgram() override { return 0; }
@@ -39,9 +49,11 @@ public:
 
 private:
     juce::AudioProcessorValueTreeState apvts;
+    gls::ParameterHandles<Param> params;
+    gls::SmoothedParameter outputTrimGain { params, Param::outputTrim, gls::SmoothedParameter::Mapping::decibels };
     struct ChannelState
     {
-        float toneLowState = 0.0f;
+        double toneLowState = 0.0;
     };
 
     std::vector<ChannelState> channelStates;
@@ -49,8 +61,10 @@ private:
     float toneSmoothingCoeff = 0.0f;
 
     void ensureStateSize();
-    float processTone (ChannelState& state, float sample) const;
-    static float applySaturation (float sample, float drive);
+    template <typename SampleType>
+    SampleType processTone (ChannelState& state, SampleType sample) const;
+    template <typename SampleType>
+    static SampleType applySaturation (SampleType sample, SampleType drive);
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (GLSMixHeadAudioProcessor)
 };
@@ -2,6 +2,23 @@
 
 namespace
 {
+using Param = GLSMonoizeProAudioProcessor::Param;
+using Spec = gls::ParameterSpec;
+
+constexpr std::array<Spec, (size_t) Param::count> parameterTable {{
+    Spec::range  ("mono_below",   "Mono Below",   40.0f,   400.0f,   0.01f,  120.0f,  0.35f),
+    Spec::range  ("stereo_above", "Stereo Above", 1000.0f, 12000.0f, 0.01f,  3000.0f, 0.35f),
+    Spec::range  ("width",        "Width",        0.0f,    2.0f,     0.001f, 1.0f),
+    Spec::range  ("center_lift",  "Center Lift",  -12.0f,  12.0f,    0.1f,   0.0f),
+    Spec::range  ("side_trim",    "Side Trim",    -12.0f,  12.0f,    0.1f,   0.0f),
+    Spec::range  ("mix",          "Dry/Wet",      0.0f,    1.0f,     0.001f, 1.0f),
+    Spec::range  ("input_trim",   "Input Trim",   -24.0f,  24.0f,    0.1f,   0.0f),
+    Spec::range  ("output_trim",  "Output Trim",  -24.0f,  24.0f,    0.1f,   0.0f),
+    Spec::toggle ("ui_bypass",    "Soft Bypass",  false)
+}};
+
+static_assert (gls::hasUniqueIds (parameterTable));
+
 float normaliseLog (float value, float minHz, float maxHz)
 {
     auto clamped = juce::jlimit (minHz, maxHz, value);
@@ -16,12 +33,16 @@ GLSMonoizeProAudioProcessor::GLSMonoizeProAudioProcessor()
     : DualPrecisionAudioProcessor(BusesProperties()
                         .withInput  ("Input", juce::AudioChannelSet::stereo(), true)
                         .withOutput ("Output", juce::AudioChannelSet::stereo(), true)),
-      apvts (*this, nullptr, "MONOIZE_PRO", createParameterLayout())
+      apvts (*this, nullptr, "MONOIZE_PRO", createParameterLayout()),
+      params (apvts, parameterTable)
 {
+    bypass.snapOnResume (dryWet);
 }
 
 void GLSMonoizeProAudioProcessor::prepareToPlay (double sampleRate, int samplesPerBlock)
 {
+    DualPrecisionAudioProcessor::prepareToPlay (sampleRate, samplesPerBlock);
+
     currentSampleRate = sampleRate > 0.0 ? sampleRate : 44100.0;
     lastBlockSize = (juce::uint32) juce::jmax (1, samplesPerBlock);
 
@@ -36,17 +57,25 @@ void GLSMonoizeProAudioProcessor::prepareToPlay (double sampleRate, int samplesP
     monoLowFilter.reset();
     stereoHighFilter.reset();
 
-    updateFilters (apvts.getRawParameterValue ("mono_below")->load(),
-                   apvts.getRawParameterValue ("stereo_above")->load());
+    updateFilters (params[Param::monoBelow], params[Param::stereoAbove]);
+
+    for (auto* smoother : { &inputTrimGain, &mixAmount, &outputTrimGain })
+        smoother->prepare (currentSampleRate, (int) lastBlockSize);
+
+    dryWet.prepare (currentSampleRate, juce::jmax (1, getTotalNumOutputChannels()), (int) lastBlockSize);
+    bypass.prepare (sampleRate, juce::jmax (getTotalNumInputChannels(), getTotalNumOutputChannels()), samplesPerBlock);
 }
 
 void GLSMonoizeProAudioProcessor::releaseResources()
 {
 }
 
-void GLSMonoizeProAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer,
-                                                juce::MidiBuffer&)
+void GLSMonoizeProAudioProcessor::processFloat (juce::AudioBuffer<float>& buffer,
+                                                juce::MidiBuffer& midi)
 {
+    if (renderInPreparedChunks (buffer, midi))
+        return;
+
     juce::ScopedNoDenormals noDenormals;
 
     auto totalIn  = getTotalNumInputChannels();
@@ -54,26 +83,20 @@ void GLSMonoizeProAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer
     for (int ch = totalIn; ch < totalOut; ++ch)
         buffer.clear (ch, 0, buffer.getNumSamples());
 
-    auto read = [this](const char* id) { return apvts.getRawParameterValue (id)->load(); };
-
-    const bool bypassed = apvts.getRawParameterValue ("ui_bypass")->load() > 0.5f;
-    if (bypassed)
+    const bool bypassed = params.isOn (Param::bypass);
+    if (! bypass.begin (buffer, buffer.getNumSamples(), bypassed))
         return;
 
-    const auto monoBelow   = read ("mono_below");
-    const auto stereoAbove = read ("stereo_above");
-    const auto widthParam  = juce::jlimit (0.0f, 2.0f, read ("width"));
-    const auto centerLift  = juce::Decibels::decibelsToGain (read ("center_lift"));
-    const auto sideTrim    = juce::Decibels::decibelsToGain (read ("side_trim"));
-    const auto mix         = juce::jlimit (0.0f, 1.0f, read ("mix"));
-    const auto inputTrim   = juce::Decibels::decibelsToGain (read ("input_trim"));
-    const auto outputTrim  = juce::Decibels::decibelsToGain (read ("output_trim"));
+    const auto monoBelow   = params[Param::monoBelow];
+    const auto stereoAbove = params[Param::stereoAbove];
+    const auto widthParam  = juce::jlimit (0.0f, 2.0f, params[Param::width]);
+    const auto centerLift  = juce::Decibels::decibelsToGain (params[Param::centerLift]);
+    const auto sideTrim    = juce::Decibels::decibelsToGain (params[Param::sideTrim]);
 
     lastBlockSize = (juce::uint32) juce::jmax (1, buffer.getNumSamples());
     updateFilters (monoBelow, stereoAbove);
 
-    buffer.applyGain (inputTrim);
-    dryBuffer.makeCopyOf (buffer, true);
+    dryWet.begin (buffer, buffer.getNumSamples(), inputTrimGain, mixAmount);
 
     auto* left  = buffer.getWritePointer (0);
     auto* right = buffer.getWritePointer (1);
@@ -99,18 +122,10 @@ void GLSMonoizeProAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer
         left[i]  = mid + side;
         right[i] = mid - side;
     }
-    if (mix < 1.0f)
-    {
-        for (int ch = 0; ch < buffer.getNumChannels(); ++ch)
-        {
-            auto* wet = buffer.getWritePointer (ch);
-            const auto* dry = dryBuffer.getReadPointer (ch);
-            for (int i = 0; i < numSamples; ++i)
-                wet[i] = wet[i] * mix + dry[i] * (1.0f - mix);
-        }
-    }
 
-    buffer.applyGain (outputTrim);
+    dryWet.end (buffer, numSamples, mixAmount, outputTrimGain);
+
+    bypass.end (buffer, numSamples);
 }
 
 void GLSMonoizeProAudioProcessor::getStateInformation (juce::MemoryBlock& destData)
@@ -129,27 +144,7 @@ void GLSMonoizeProAudioProcessor::setStateInformation (const void* data, int siz
 juce::AudioProcessorValueTreeState::ParameterLayout
 GLSMonoizeProAudioProcessor::createParameterLayout()
 {
-    std::vector<std::unique_ptr<juce::RangedAudioParameter>> params;
-
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("mono_below",   "Mono Below",
-                                                                   juce::NormalisableRange<float> (40.0f, 400.0f, 0.01f, 0.35f), 120.0f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("stereo_above", "Stereo Above",
-                                                                   juce::NormalisableRange<float> (1000.0f, 12000.0f, 0.01f, 0.35f), 3000.0f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("width",        "Width",
-                                                                   juce::NormalisableRange<float> (0.0f, 2.0f, 0.001f), 1.0f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("center_lift",  "Center Lift",
-                                                                   juce::NormalisableRange<float> (-12.0f, 12.0f, 0.1f), 0.0f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("side_trim",    "Side Trim",
-                                                                   juce::NormalisableRange<float> (-12.0f, 12.0f, 0.1f), 0.0f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("mix",          "Dry/Wet",
-                                                                   juce::NormalisableRange<float> (0.0f, 1.0f, 0.001f), 1.0f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("input_trim",   "Input Trim",
-                                                                   juce::NormalisableRange<float> (-24.0f, 24.0f, 0.1f), 0.0f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("output_trim",  "Output Trim",
-                                                                   juce::NormalisableRange<float> (-24.0f, 24.0f, 0.1f), 0.0f));
-    params.push_back (std::make_unique<juce::AudioParameterBool> ("ui_bypass", "Soft Bypass", false));
-
-    return { params.begin(), params.end() };
+    return gls::createParameterLayout (parameterTable);
 }
 
 class MonoizeVisual : public juce::Component, private juce::Timer
@@ -375,13 +370,9 @@ void GLSMonoizeProAudioProcessor::updateFilters (float monoFreq, float stereoFre
     if (currentSampleRate <= 0.0)
         return;
 
-    const auto lp = juce::dsp::IIR::Coefficients<float>::makeLowPass (currentSampleRate,
-                                                                      juce::jlimit (20.0f, (float) (currentSampleRate * 0.45), monoFreq));
-    const auto hp = juce::dsp::IIR::Coefficients<float>::makeHighPass (currentSampleRate,
-                                                                       juce::jlimit (100.0f, (float) (currentSampleRate * 0.45), stereoFreq));
-
-    monoLowFilter.coefficients = lp;
-    stereoHighFilter.coefficients = hp;
+    const auto maxFreq = (float) (currentSampleRate * 0.45);
+    monoLowFilter.setLowPass (currentSampleRate, juce::jlimit (20.0f, maxFreq, monoFreq));
+    stereoHighFilter.setHighPass (currentSampleRate, juce::jlimit (100.0f, maxFreq, stereoFreq));
 }
 
 juce::AudioProcessor* JUCE_CALLTYPE createPluginFilter()
@@ -10,6 +10,28 @@ float normaliseLogFreq (float value, float minHz, float maxHz)
     const auto logVal = std::log10 (clamped);
     return juce::jlimit (0.0f, 1.0f, (float) ((logVal - logMin) / (logMax - logMin)));
 }
+
+using Param = GLSParallelPressAudioProcessor::Param;
+using Spec = gls::ParameterSpec;
+
+constexpr std::array<Spec, (size_t) Param::count> parameterTable {{
+    Spec::range  ("drive",       "Drive",       0.0f,    1.0f,     0.001f, 0.4f),
+    Spec::range  ("comp_thresh", "Comp Thresh", -48.0f,  0.0f,     0.1f,   -24.0f),
+    Spec::range  ("comp_ratio",  "Comp Ratio",  1.0f,    20.0f,    0.01f,  6.0f,     0.5f),
+    Spec::range  ("attack",      "Attack",      0.1f,    50.0f,    0.01f,  5.0f,     0.3f),
+    Spec::range  ("release",     "Release",     10.0f,   500.0f,   0.01f,  120.0f,   0.3f),
+    Spec::range  ("hpf_to_wet",  "HPF to Wet",  20.0f,   400.0f,   0.01f,  80.0f,    0.35f),
+    Spec::range  ("lpf_to_wet",  "LPF to Wet",  2000.0f, 20000.0f, 0.01f,  15000.0f, 0.35f),
+    Spec::range  ("wet_level",   "Wet Level",   -24.0f,  6.0f,     0.1f,   0.0f),
+    Spec::range  ("dry_level",   "Dry Level",   -24.0f,  6.0f,     0.1f,   0.0f),
+    Spec::range  ("mix",         "Mix",         0.0f,    1.0f,     0.001f, 1.0f),
+    Spec::range  ("input_trim",  "Input Trim",  -24.0f,  24.0f,    0.1f,   0.0f),
+    Spec::range  ("output_trim", "Output Trim", -24.0f,  24.0f,    0.1f,   0.0f),
+    Spec::toggle ("auto_gain",   "Auto Gain",   false),
+    Spec::toggle ("ui_bypass",   "Soft Bypass", false)
+}};
+
+static_assert (gls::hasUniqueIds (parameterTable));
 } // namespace
 
 const std::array<GLSParallelPressAudioProcessor::Preset, 3> GLSParallelPressAudioProcessor::presetBank {{
@@ -67,19 +89,28 @@ GLSParallelPressAudioProcessor::GLSParallelPressAudioProcessor()
     : DualPrecisionAudioProcessor(BusesProperties()
                         .withInput  ("Input", juce::AudioChannelSet::stereo(), true)
                         .withOutput ("Output", juce::AudioChannelSet::stereo(), true)),
-      apvts (*this, nullptr, "PARALLEL_PRESS", createParameterLayout())
+      apvts (*this, nullptr, "PARALLEL_PRESS", createParameterLayout()),
+      params (apvts, parameterTable)
 {
+    bypass.snapOnResume (dryWet);
+    bypass.snapOnResume ({ &wetGain, &dryGain });
 }
 
 void GLSParallelPressAudioProcessor::prepareToPlay (double sampleRate, int samplesPerBlock)
 {
+    DualPrecisionAudioProcessor::prepareToPlay (sampleRate, samplesPerBlock);
+
     currentSampleRate = juce::jmax (sampleRate, 44100.0);
     lastBlockSize = (juce::uint32) juce::jmax (1, samplesPerBlock);
+    spectrumAnalyser.prepare (sampleRate > 0.0 ? sampleRate : 44100.0);
     ensureStateSize();
-    dryBuffer.setSize (juce::jmax (1, getTotalNumOutputChannels()),
-                       (int) lastBlockSize, false, false, true);
-    wetBuffer.setSize (juce::jmax (1, getTotalNumOutputChannels()),
-                       (int) lastBlockSize, false, false, true);
+    dryWet.prepare (currentSampleRate, juce::jmax (1, getTotalNumOutputChannels()), (int) lastBlockSize);
+
+    for (auto* smoother : { &inputTrimGain, &wetGain, &dryGain, &mixAmount, &outputTrimGain })
+        smoother->prepare (currentSampleRate, (int) lastBlockSize);
+
+    bypass.prepare (currentSampleRate, juce::jmax (getTotalNumInputChannels(), getTotalNumOutputChannels()), (int) lastBlockSize);
+
     for (auto& state : channelStates)
     {
         state.hpf.reset();
@@ -93,9 +124,12 @@ void GLSParallelPressAudioProcessor::releaseResources()
 {
 }
 
-void GLSParallelPressAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer,
-                                                   juce::MidiBuffer&)
+void GLSParallelPressAudioProcessor::processFloat (juce::AudioBuffer<float>& buffer,
+                                                   juce::MidiBuffer& midi)
 {
+    if (renderInPreparedChunks (buffer, midi))
+        return;
+
     juce::ScopedNoDenormals noDenormals;
 
     auto totalIn  = getTotalNumInputChannels();
@@ -103,42 +137,32 @@ void GLSParallelPressAudioProcessor::processBlock (juce::AudioBuffer<float>& buf
     for (int ch = totalIn; ch < totalOut; ++ch)
         buffer.clear (ch, 0, buffer.getNumSamples());
 
-    const bool bypassed = apvts.getRawParameterValue ("ui_bypass")->load() > 0.5f;
-    if (bypassed)
+    if (! bypass.begin (buffer, buffer.getNumSamples(), params.isOn (Param::bypass)))
         return;
 
-    auto read = [this](const char* id) { return apvts.getRawParameterValue (id)->load(); };
-
-    const auto drive      = read ("drive");
-    const auto thresh     = read ("comp_thresh");
-    const auto ratio      = juce::jmax (1.0f, read ("comp_ratio"));
-    const auto attack     = read ("attack");
-    const auto release    = read ("release");
-    const auto hpfWet     = read ("hpf_to_wet");
-    const auto lpfWet     = read ("lpf_to_wet");
-    const auto wetLevel   = read ("wet_level");
-    const auto dryLevel   = read ("dry_level");
-    const auto mix        = juce::jlimit (0.0f, 1.0f, read ("mix"));
-    const auto inputTrim  = juce::Decibels::decibelsToGain (read ("input_trim"));
-    const auto outputTrim = juce::Decibels::decibelsToGain (read ("output_trim"));
-    const bool autoGain   = apvts.getRawParameterValue ("auto_gain")->load() > 0.5f;
-
-    lastBlockSize = (juce::uint32) juce::jmax (1, buffer.getNumSamples());
+    const auto drive      = params[Param::drive];
+    const auto thresh     = params[Param::compThresh];
+    const auto ratio      = juce::jmax (1.0f, params[Param::compRatio]);
+    const auto attack     = params[Param::attack];
+    const auto release    = params[Param::release];
+    const auto hpfWet     = params[Param::hpfToWet];
+    const auto lpfWet     = params[Param::lpfToWet];
+    const bool autoGain   = params.isOn (Param::autoGain);
+
+    wetGain.update();
+    dryGain.update();
+
+    const auto numSamples   = buffer.getNumSamples();
+    const auto numChannels  = buffer.getNumChannels();
+    lastBlockSize = (juce::uint32) juce::jmax (1, numSamples);
     ensureStateSize();
-    dryBuffer.setSize (buffer.getNumChannels(), buffer.getNumSamples(), false, false, true);
-    wetBuffer.setSize (buffer.getNumChannels(), buffer.getNumSamples(), false, false, true);
-    buffer.applyGain (inputTrim);
-    dryBuffer.makeCopyOf (buffer, true);
-    wetBuffer.makeCopyOf (buffer, true);
+
+    // The compressed path runs in place; the dry path is always part of the sum.
+    dryWet.begin (buffer, numSamples, inputTrimGain, mixAmount, true);
 
     const auto attackCoeff  = std::exp (-1.0f / (juce::jmax (0.1f, attack) * 0.001f * currentSampleRate));
     const auto releaseCoeff = std::exp (-1.0f / (juce::jmax (1.0f, release) * 0.001f * currentSampleRate));
     const auto threshDb     = thresh;
-    const auto wetGain      = juce::Decibels::decibelsToGain (wetLevel);
-    const auto dryGain      = juce::Decibels::decibelsToGain (dryLevel);
-
-    const auto numSamples   = wetBuffer.getNumSamples();
-    const auto numChannels  = wetBuffer.getNumChannels();
     float blockReductionDb  = 0.0f;
 
     for (int ch = 0; ch < numChannels; ++ch)
@@ -146,7 +170,7 @@ void GLSParallelPressAudioProcessor::processBlock (juce::AudioBuffer<float>& buf
         auto& state = channelStates[ch];
         updateFilterCoefficients (state, hpfWet, lpfWet);
 
-        auto* wetData = wetBuffer.getWritePointer (ch);
+        auto* wetData = buffer.getWritePointer (ch);
 
         for (int i = 0; i < numSamples; ++i)
         {
@@ -175,37 +199,33 @@ void GLSParallelPressAudioProcessor::processBlock (juce::AudioBuffer<float>& buf
         }
     }
 
-    for (int ch = 0; ch < numChannels; ++ch)
-    {
-        auto* wetData = wetBuffer.getWritePointer (ch);
-        auto* dryData = dryBuffer.getWritePointer (ch);
-        auto* outData = buffer.getWritePointer (ch);
-
-        for (int i = 0; i < numSamples; ++i)
-            outData[i] = wetData[i] * wetGain + dryData[i] * dryGain;
-    }
-
-    if (autoGain)
-    {
-        const auto makeupDb = juce::jlimit (-12.0f, 12.0f, -blockReductionDb);
-        const auto makeupGain = juce::Decibels::decibelsToGain (makeupDb);
-        buffer.applyGain (makeupGain);
-    }
+    // out = trim * (mix * makeup * (wet * wetLevel + dry * dryLevel) + (1 - mix) * dry):
+    // the parallel sum is formed here, then the stage runs the usual mix over it.
+    const auto* wetLevels = wetGain.advance (numSamples);
+    const auto* dryLevels = dryGain.advance (numSamples);
+    const auto& dry = dryWet.getDry();
 
-    if (mix < 0.999f)
+    for (int ch = 0; ch < juce::jmin (numChannels, dry.getNumChannels()); ++ch)
     {
-        for (int ch = 0; ch < buffer.getNumChannels(); ++ch)
-        {
-            const auto* dryData = dryBuffer.getReadPointer (ch);
-            auto* out = buffer.getWritePointer (ch);
+        auto* out = buffer.getWritePointer (ch);
+        const auto* in = dry.getReadPointer (ch);
 
-            for (int i = 0; i < buffer.getNumSamples(); ++i)
-                out[i] = out[i] * mix + dryData[i] * (1.0f - mix);
-        }
+        for (int i = 0; i < numSamples; ++i)
+            out[i] = out[i] * (wetLevels != nullptr ? wetLevels[i] : wetGain.getCurrentValue())
+                   + in[i] * (dryLevels != nullptr ? dryLevels[i] : dryGain.getCurrentValue());
     }
 
-    buffer.applyGain (outputTrim);
+    const auto makeupGain = autoGain ? juce::Decibels::decibelsToGain (juce::jlimit (-12.0f, 12.0f, -blockReductionDb))
+                                     : 1.0f;
+    dryWet.end (buffer, numSamples, mixAmount, outputTrimGain, makeupGain);
+    bypass.end (buffer, numSamples);
     lastReductionDb.store (blockReductionDb);
+    spectrumAnalyser.push (buffer, buffer.getNumSamples());
+}
+
+void GLSParallelPressAudioProcessor::updateTail()
+{
+    tail.setTail (0.0, gls::dsp::TailTracker::getEnvelopeRT60 (juce::jmax (1.0f, params[Param::release]) * 0.001));
 }
 
 int GLSParallelPressAudioProcessor::getNumPrograms()
@@ -246,31 +266,7 @@ void GLSParallelPressAudioProcessor::setStateInformation (const void* data, int
 juce::AudioProcessorValueTreeState::ParameterLayout
 GLSParallelPressAudioProcessor::createParameterLayout()
 {
-    std::vector<std::unique_ptr<juce::RangedAudioParameter>> params;
-
-    auto dBRange     = juce::NormalisableRange<float> (-48.0f, 0.0f, 0.1f);
-    auto timeRange   = juce::NormalisableRange<float> (0.1f, 50.0f, 0.01f, 0.3f);
-    auto releaseRange= juce::NormalisableRange<float> (10.0f, 500.0f, 0.01f, 0.3f);
-
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("drive",        "Drive", juce::NormalisableRange<float> (0.0f, 1.0f, 0.001f), 0.4f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("comp_thresh",  "Comp Thresh", dBRange, -24.0f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("comp_ratio",   "Comp Ratio", juce::NormalisableRange<float> (1.0f, 20.0f, 0.01f, 0.5f), 6.0f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("attack",       "Attack", timeRange, 5.0f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("release",      "Release", releaseRange, 120.0f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("hpf_to_wet",   "HPF to Wet", juce::NormalisableRange<float> (20.0f, 400.0f, 0.01f, 0.35f), 80.0f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("lpf_to_wet",   "LPF to Wet", juce::NormalisableRange<float> (2000.0f, 20000.0f, 0.01f, 0.35f), 15000.0f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("wet_level",    "Wet Level", juce::NormalisableRange<float> (-24.0f, 6.0f, 0.1f), 0.0f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("dry_level",    "Dry Level", juce::NormalisableRange<float> (-24.0f, 6.0f, 0.1f), 0.0f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("mix",          "Mix",
-                                                                   juce::NormalisableRange<float> (0.0f, 1.0f, 0.001f), 1.0f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("input_trim",   "Input Trim",
-                                                                   juce::NormalisableRange<float> (-24.0f, 24.0f, 0.1f), 0.0f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("output_trim",  "Output Trim",
-                                                                   juce::NormalisableRange<float> (-24.0f, 24.0f, 0.1f), 0.0f));
-    params.push_back (std::make_unique<juce::AudioParameterBool>  ("auto_gain",    "Auto Gain", false));
-    params.push_back (std::make_unique<juce::AudioParameterBool>  ("ui_bypass",    "Soft Bypass", false));
-
-    return { params.begin(), params.end() };
+    return gls::createParameterLayout (parameterTable);
 }
 
 class ParallelPressVisual : public juce::Component, private juce::Timer
@@ -279,8 +275,10 @@ public:
     ParallelPressVisual (GLSParallelPressAudioProcessor& proc,
                          juce::AudioProcessorValueTreeState& stateRef,
                          juce::Colour accentColour)
-        : processor (proc), apvts (stateRef), accent (accentColour)
+        : processor (proc), apvts (stateRef), accent (accentColour),
+          spectrum (proc.getSpectrumAnalyser(), accentColour)
     {
+        addAndMakeVisible (spectrum);
         hpf   = apvts.getRawParameterValue ("hpf_to_wet");
         lpf   = apvts.getRawParameterValue ("lpf_to_wet");
         wet   = apvts.getRawParameterValue ("wet_level");
@@ -300,11 +298,17 @@ public:
         auto meter = bounds.removeFromRight (64.0f).reduced (10.0f);
         drawGainReductionMeter (g, meter);
 
-        auto freqArea = bounds.reduced (12.0f);
+        auto freqArea = getFrequencyArea();
         drawFilterBand (g, freqArea);
         drawLabels (g, freqArea);
     }
 
+    void resized() override
+    {
+        // Same 20 Hz - 20 kHz log axis as the filter band, so the curve lines up with it.
+        spectrum.setBounds (getFrequencyArea().toNearestInt());
+    }
+
 private:
     GLSParallelPressAudioProcessor& processor;
     juce::AudioProcessorValueTreeState& apvts;
@@ -314,9 +318,15 @@ private:
     std::atomic<float>* wet = nullptr;
     std::atomic<float>* dry = nullptr;
     std::atomic<float>* mix = nullptr;
+    gls::ui::SpectrumView spectrum;
 
     void timerCallback() override { repaint(); }
 
+    juce::Rectangle<float> getFrequencyArea() const
+    {
+        return getLocalBounds().toFloat().reduced (6.0f).withTrimmedRight (64.0f).reduced (12.0f);
+    }
+
     void drawGainReductionMeter (juce::Graphics& g, juce::Rectangle<float> meter)
     {
         g.setColour (gls::ui::Colours::grid());
@@ -581,13 +591,8 @@ void GLSParallelPressAudioProcessor::updateFilterCoefficients (ChannelState& sta
     if (currentSampleRate <= 0.0)
         return;
 
-    const auto hpf = juce::dsp::IIR::Coefficients<float>::makeHighPass (currentSampleRate,
-                                                                        juce::jlimit (10.0f, (float) (currentSampleRate * 0.45), hpfFreq));
-    const auto lpf = juce::dsp::IIR::Coefficients<float>::makeLowPass (currentSampleRate,
-                                                                       juce::jlimit (100.0f, (float) (currentSampleRate * 0.49), lpfFreq));
-
-    state.hpf.coefficients = hpf;
-    state.lpf.coefficients = lpf;
+    state.hpf.setHighPass (currentSampleRate, juce::jlimit (10.0f, (float) (currentSampleRate * 0.45), hpfFreq));
+    state.lpf.setLowPass (currentSampleRate, juce::jlimit (100.0f, (float) (currentSampleRate * 0.49), lpfFreq));
 }
 
 float GLSParallelPressAudioProcessor::computeCompressorGain (float levelDb, float threshDb, float ratio) const
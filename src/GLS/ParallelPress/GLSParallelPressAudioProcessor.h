@@ -3,17 +3,30 @@
 #include <JuceHeader.h>
 #include <array>
 #include "../../DualPrecisionAudioProcessor.h"
+#include "../../ParameterTable.h"
+#include "../../SmoothedParameter.h"
+#include "../../dsp/Biquad.h"
+#include "../../dsp/DryWetStage.h"
+#include "../../dsp/SoftBypass.h"
+#include "../../dsp/SpectrumAnalyser.h"
 #include "../../ui/GoodluckLookAndFeel.h"
+#include "../../ui/SpectrumView.h"
 
 class GLSParallelPressAudioProcessor : public DualPrecisionAudioProcessor
 {
 public:
+    enum class Param
+    {
+        drive, compThresh, compRatio, attack, release, hpfToWet, lpfToWet,
+        wetLevel, dryLevel, mix, inputTrim, outputTrim, autoGain, bypass,
+        count
+    };
+
     GLSParallelPressAudioProcessor();
     ~GLSParallelPressAudioProcessor() override = default;
 
     void prepareToPlay (double sampleRate, int samplesPerBlock) override;
     void releaseResources() override;
-    void processBlock (juce::AudioBuffer<float>&, juce::MidiBuffer&) override;
 
     juce::AudioProcessorEditor* createEditor() override;
     bool hasEditor() const override { return true; }
@@ -22,7 +35,6 @@ public:
     bool acceptsMidi() const override { return false; }
     bool producesMidi() const override { return false; }
     bool isMidiEffect() const override { return false; }
-    double getTailLengthSeconds() const override { return 0.0; }
 
     int getNumPrograms() override;
     int getCurrentProgram() override { return currentPreset; }
@@ -36,20 +48,32 @@ public:
     juce::AudioProcessorValueTreeState& getValueTreeState() { return apvts; }
     static juce::AudioProcessorValueTreeState::ParameterLayout createParameterLayout();
     float getLastReductionDb() const noexcept { return lastReductionDb.load(); }
+    gls::dsp::SpectrumAnalyser& getSpectrumAnalyser() noexcept { return spectrumAnalyser; }
+
+protected:
+    void processFloat (juce::AudioBuffer<float>&, juce::MidiBuffer&) override;
+    void updateTail() override;
 
 private:
     juce::AudioProcessorValueTreeState apvts;
+    gls::ParameterHandles<Param> params;
+    gls::SmoothedParameter inputTrimGain  { params, Param::inputTrim,  gls::SmoothedParameter::Mapping::decibels };
+    gls::SmoothedParameter wetGain        { params, Param::wetLevel,   gls::SmoothedParameter::Mapping::decibels };
+    gls::SmoothedParameter dryGain        { params, Param::dryLevel,   gls::SmoothedParameter::Mapping::decibels };
+    gls::SmoothedParameter mixAmount      { params, Param::mix };
+    gls::SmoothedParameter outputTrimGain { params, Param::outputTrim, gls::SmoothedParameter::Mapping::decibels };
+    gls::dsp::SpectrumAnalyser spectrumAnalyser;
+    gls::dsp::SoftBypass bypass;
     double currentSampleRate = 44100.0;
     juce::uint32 lastBlockSize = 512;
-    juce::AudioBuffer<float> dryBuffer;
-    juce::AudioBuffer<float> wetBuffer;
+    gls::dsp::DryWetStage dryWet;
     std::atomic<float> lastReductionDb { 0.0f };
     int currentPreset = 0;
 
     struct ChannelState
     {
-        juce::dsp::IIR::Filter<float> hpf;
-        juce::dsp::IIR::Filter<float> lpf;
+        gls::dsp::Biquad hpf;
+        gls::dsp::Biquad lpf;
         float envelope = 0.0f;
         float gain = 1.0f;
     };
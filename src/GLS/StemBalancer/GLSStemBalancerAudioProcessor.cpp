@@ -2,6 +2,23 @@
 
 namespace
 {
+using Param = GLSStemBalancerAudioProcessor::Param;
+using Spec = gls::ParameterSpec;
+
+constexpr std::array<Spec, (size_t) Param::count> parameterTable {{
+    Spec::range  ("stem_gain",   "Stem Gain",   -12.0f, 12.0f, 0.1f,   0.0f),
+    Spec::range  ("tilt",        "Tilt",        -12.0f, 12.0f, 0.1f,   0.0f),
+    Spec::range  ("presence",    "Presence",    -6.0f,  6.0f,  0.1f,   0.0f),
+    Spec::range  ("low_tight",   "Low Tight",   0.0f,   1.0f,  0.001f, 0.5f),
+    Spec::toggle ("auto_gain",   "Auto Gain",   true),
+    Spec::range  ("mix",         "Mix",         0.0f,   1.0f,  0.001f, 1.0f),
+    Spec::range  ("input_trim",  "Input Trim",  -24.0f, 24.0f, 0.1f,   0.0f),
+    Spec::range  ("output_trim", "Output Trim", -24.0f, 24.0f, 0.1f,   0.0f),
+    Spec::toggle ("ui_bypass",   "Soft Bypass", false)
+}};
+
+static_assert (gls::hasUniqueIds (parameterTable));
+
 float normaliseLogFreq (float value, float minHz, float maxHz)
 {
     auto clamped = juce::jlimit (minHz, maxHz, value);
@@ -16,17 +33,23 @@ GLSStemBalancerAudioProcessor::GLSStemBalancerAudioProcessor()
     : DualPrecisionAudioProcessor(BusesProperties()
                         .withInput  ("Input", juce::AudioChannelSet::stereo(), true)
                         .withOutput ("Output", juce::AudioChannelSet::stereo(), true)),
-      apvts (*this, nullptr, "STEM_BALANCER", createParameterLayout())
+      apvts (*this, nullptr, "STEM_BALANCER", createParameterLayout()),
+      params (apvts, parameterTable)
 {
+    bypass.snapOnResume (dryWet);
 }
 
 void GLSStemBalancerAudioProcessor::prepareToPlay (double sampleRate, int samplesPerBlock)
 {
+    DualPrecisionAudioProcessor::prepareToPlay (sampleRate, samplesPerBlock);
+
     currentSampleRate = sampleRate > 0.0 ? sampleRate : 44100.0;
     lastBlockSize = (juce::uint32) juce::jmax (1, samplesPerBlock);
     ensureStateSize();
-    dryBuffer.setSize (juce::jmax (1, getTotalNumOutputChannels()),
-                       (int) lastBlockSize, false, false, true);
+    for (auto* smoother : { &inputTrimGain, &mixAmount, &outputTrimGain })
+        smoother->prepare (currentSampleRate, (int) lastBlockSize);
+
+    dryWet.prepare (currentSampleRate, juce::jmax (1, getTotalNumOutputChannels()), (int) lastBlockSize);
 
     for (auto& state : channelStates)
     {
@@ -35,15 +58,20 @@ void GLSStemBalancerAudioProcessor::prepareToPlay (double sampleRate, int sample
         state.presenceBell.reset();
         state.lowTightHpf.reset();
     }
+
+    bypass.prepare (sampleRate, juce::jmax (getTotalNumInputChannels(), getTotalNumOutputChannels()), samplesPerBlock);
 }
 
 void GLSStemBalancerAudioProcessor::releaseResources()
 {
 }
 
-void GLSStemBalancerAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer,
-                                                   juce::MidiBuffer&)
+void GLSStemBalancerAudioProcessor::processFloat (juce::AudioBuffer<float>& buffer,
+                                                   juce::MidiBuffer& midi)
 {
+    if (renderInPreparedChunks (buffer, midi))
+        return;
+
     juce::ScopedNoDenormals noDenormals;
 
     auto totalIn  = getTotalNumInputChannels();
@@ -51,30 +79,23 @@ void GLSStemBalancerAudioProcessor::processBlock (juce::AudioBuffer<float>& buff
     for (int ch = totalIn; ch < totalOut; ++ch)
         buffer.clear (ch, 0, buffer.getNumSamples());
 
-    auto get = [this](const char* id) { return apvts.getRawParameterValue (id)->load(); };
-
-    const bool bypassed   = apvts.getRawParameterValue ("ui_bypass")->load() > 0.5f;
-    if (bypassed)
+    const bool bypassed   = params.isOn (Param::bypass);
+    if (! bypass.begin (buffer, buffer.getNumSamples(), bypassed))
         return;
 
-    const auto stemGainDb = get ("stem_gain");
-    const auto tilt       = get ("tilt");
-    const auto presence   = get ("presence");
-    const auto lowTight   = get ("low_tight");
-    const bool autoGain   = apvts.getRawParameterValue ("auto_gain")->load() > 0.5f;
-    const auto mix        = juce::jlimit (0.0f, 1.0f, get ("mix"));
-    const auto inputTrim  = juce::Decibels::decibelsToGain (get ("input_trim"));
-    const auto outputTrim = juce::Decibels::decibelsToGain (get ("output_trim"));
+    const auto stemGainDb = params[Param::stemGain];
+    const auto tilt       = params[Param::tilt];
+    const auto presence   = params[Param::presence];
+    const auto lowTight   = params[Param::lowTight];
+    const bool autoGain   = params.isOn (Param::autoGain);
 
     lastBlockSize = (juce::uint32) juce::jmax (1, buffer.getNumSamples());
     ensureStateSize();
-    dryBuffer.setSize (buffer.getNumChannels(), buffer.getNumSamples(), false, false, true);
     updateFilters (tilt, presence, lowTight);
-    buffer.applyGain (inputTrim);
-    dryBuffer.makeCopyOf (buffer, true);
+    dryWet.begin (buffer, buffer.getNumSamples(), inputTrimGain, mixAmount);
 
     const auto stemGain = juce::Decibels::decibelsToGain (stemGainDb);
-    double preEnergy = 0.0;
+    double preEnergy = 0.0, postEnergy = 0.0;
 
     const int numSamples = buffer.getNumSamples();
     const int numChannels = buffer.getNumChannels();
@@ -83,11 +104,10 @@ void GLSStemBalancerAudioProcessor::processBlock (juce::AudioBuffer<float>& buff
     {
         auto& state = channelStates[ch];
         auto* data = buffer.getWritePointer (ch);
-        const auto* dryData = dryBuffer.getReadPointer (ch);
 
         for (int i = 0; i < numSamples; ++i)
         {
-            const float original = dryData[i];
+            const float original = data[i];
             preEnergy += original * original;
 
             float sample = original;
@@ -96,38 +116,18 @@ void GLSStemBalancerAudioProcessor::processBlock (juce::AudioBuffer<float>& buff
             sample = state.presenceBell.processSample (sample);
             sample = state.lowTightHpf.processSample (sample);
             sample *= stemGain;
+            postEnergy += sample * sample;
 
             data[i] = sample;
         }
     }
 
-    double postEnergy = 0.0;
-    for (int ch = 0; ch < numChannels; ++ch)
-    {
-        const auto* data = buffer.getReadPointer (ch);
-        for (int i = 0; i < numSamples; ++i)
-            postEnergy += data[i] * data[i];
-    }
+    const auto compensation = autoGain && postEnergy > 0.0 && preEnergy > 0.0
+                                  ? (float) std::sqrt (preEnergy / postEnergy) : 1.0f;
 
-    if (autoGain && postEnergy > 0.0 && preEnergy > 0.0)
-    {
-        const auto compensation = std::sqrt (preEnergy / postEnergy);
-        buffer.applyGain ((float) compensation);
-    }
-
-    if (mix < 0.999f)
-    {
-        for (int ch = 0; ch < numChannels; ++ch)
-        {
-            const auto* dryData = dryBuffer.getReadPointer (ch);
-            auto* data = buffer.getWritePointer (ch);
-
-            for (int i = 0; i < numSamples; ++i)
-                data[i] = data[i] * mix + dryData[i] * (1.0f - mix);
-        }
-    }
+    dryWet.end (buffer, numSamples, mixAmount, outputTrimGain, compensation);
 
-    buffer.applyGain (outputTrim);
+    bypass.end (buffer, numSamples);
 }
 
 void GLSStemBalancerAudioProcessor::getStateInformation (juce::MemoryBlock& destData)
@@ -146,26 +146,7 @@ void GLSStemBalancerAudioProcessor::setStateInformation (const void* data, int s
 juce::AudioProcessorValueTreeState::ParameterLayout
 GLSStemBalancerAudioProcessor::createParameterLayout()
 {
-    std::vector<std::unique_ptr<juce::RangedAudioParameter>> params;
-
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("stem_gain", "Stem Gain",
-                                                                   juce::NormalisableRange<float> (-12.0f, 12.0f, 0.1f), 0.0f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("tilt",      "Tilt",
-                                                                   juce::NormalisableRange<float> (-12.0f, 12.0f, 0.1f), 0.0f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("presence",  "Presence",
-                                                                   juce::NormalisableRange<float> (-6.0f, 6.0f, 0.1f), 0.0f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("low_tight", "Low Tight",
-                                                                   juce::NormalisableRange<float> (0.0f, 1.0f, 0.001f), 0.5f));
-    params.push_back (std::make_unique<juce::AudioParameterBool>  ("auto_gain", "Auto Gain", true));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("mix",       "Mix",
-                                                                   juce::NormalisableRange<float> (0.0f, 1.0f, 0.001f), 1.0f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("input_trim","Input Trim",
-                                                                   juce::NormalisableRange<float> (-24.0f, 24.0f, 0.1f), 0.0f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("output_trim","Output Trim",
-                                                                   juce::NormalisableRange<float> (-24.0f, 24.0f, 0.1f), 0.0f));
-    params.push_back (std::make_unique<juce::AudioParameterBool>  ("ui_bypass", "Soft Bypass", false));
-
-    return { params.begin(), params.end() };
+    return gls::createParameterLayout (parameterTable);
 }
 
 class StemBalancerVisual : public juce::Component, private juce::Timer
@@ -447,10 +428,10 @@ void GLSStemBalancerAudioProcessor::updateFilters (float tilt, float presenceDb,
 
     for (auto& state : channelStates)
     {
-        state.lowShelf.coefficients  = juce::dsp::IIR::Coefficients<float>::makeLowShelf (currentSampleRate, 250.0f, 0.707f, lowGain);
-        state.highShelf.coefficients = juce::dsp::IIR::Coefficients<float>::makeHighShelf (currentSampleRate, 4000.0f, 0.707f, highGain);
-        state.presenceBell.coefficients = juce::dsp::IIR::Coefficients<float>::makePeakFilter (currentSampleRate, 2500.0f, 0.9f, presenceGain);
-        state.lowTightHpf.coefficients  = juce::dsp::IIR::Coefficients<float>::makeHighPass (currentSampleRate, hpfFreq);
+        state.lowShelf.setLowShelf (currentSampleRate, 250.0f, 0.707f, lowGain);
+        state.highShelf.setHighShelf (currentSampleRate, 4000.0f, 0.707f, highGain);
+        state.presenceBell.setPeak (currentSampleRate, 2500.0f, 0.9f, presenceGain);
+        state.lowTightHpf.setHighPass (currentSampleRate, hpfFreq);
     }
 }
 
@@ -1,23 +1,43 @@
 #include "GLSSubCommandAudioProcessor.h"
 
+namespace
+{
+using Param = GLSSubCommandAudioProcessor::Param;
+using Spec = gls::ParameterSpec;
+
+constexpr std::array<Spec, (size_t) Param::count> parameterTable {{
+    Spec::range  ("xover_freq",  "Xover Freq",  40.0f,  250.0f, 0.01f,  90.0f, 0.4f),
+    Spec::range  ("sub_level",   "Sub Level",   -12.0f, 12.0f,  0.1f,   0.0f),
+    Spec::range  ("tightness",   "Tightness",   0.0f,   1.0f,   0.001f, 0.5f),
+    Spec::range  ("harmonics",   "Harmonics",   0.0f,   1.0f,   0.001f, 0.3f),
+    Spec::range  ("out_hpf",     "Out HPF",     20.0f,  120.0f, 0.01f,  35.0f, 0.4f),
+    Spec::range  ("mix",         "Mix",         0.0f,   1.0f,   0.001f, 1.0f),
+    Spec::range  ("input_trim",  "Input Trim",  -24.0f, 24.0f,  0.01f,  0.0f),
+    Spec::range  ("output_trim", "Output Trim", -24.0f, 24.0f,  0.01f,  0.0f),
+    Spec::toggle ("ui_bypass",   "Soft Bypass", false)
+}};
+
+static_assert (gls::hasUniqueIds (parameterTable));
+} // namespace
+
 GLSSubCommandAudioProcessor::GLSSubCommandAudioProcessor()
     : DualPrecisionAudioProcessor(BusesProperties()
                         .withInput  ("Input", juce::AudioChannelSet::stereo(), true)
                         .withOutput ("Output", juce::AudioChannelSet::stereo(), true)),
-      apvts (*this, nullptr, "SUB_COMMAND", createParameterLayout())
+      apvts (*this, nullptr, "SUB_COMMAND", createParameterLayout()),
+      params (apvts, parameterTable)
 {
+    bypass.snapOnResume ({ &inputTrimGain, &mixAmount, &outputTrimGain });
 }
 
 void GLSSubCommandAudioProcessor::prepareToPlay (double sampleRate, int samplesPerBlock)
 {
+    DualPrecisionAudioProcessor::prepareToPlay (sampleRate, samplesPerBlock);
+
     currentSampleRate = sampleRate > 0.0 ? sampleRate : 44100.0;
     lastBlockSize = (juce::uint32) juce::jmax (1, samplesPerBlock);
     ensureStateSize();
 
-    originalBuffer.setSize (juce::jmax (1, getTotalNumOutputChannels()),
-                            (int) lastBlockSize,
-                            false, false, true);
-
     for (auto& state : channelStates)
     {
         state.lowPass.reset();
@@ -25,45 +45,45 @@ void GLSSubCommandAudioProcessor::prepareToPlay (double sampleRate, int samplesP
         state.envelope = 0.0f;
         state.gain = 1.0f;
     }
+
+    bypass.prepare (currentSampleRate, juce::jmax (getTotalNumInputChannels(), getTotalNumOutputChannels()), (int) lastBlockSize);
+
+    const auto numChannels = juce::jmax (1, getTotalNumInputChannels(), getTotalNumOutputChannels());
+    lowBuffer.setSize (numChannels, (int) lastBlockSize);
+    highBuffer.setSize (numChannels, (int) lastBlockSize);
+
+    for (auto* smoother : { &inputTrimGain, &mixAmount, &outputTrimGain })
+        smoother->prepare (currentSampleRate, (int) lastBlockSize);
 }
 
 void GLSSubCommandAudioProcessor::releaseResources()
 {
 }
 
-void GLSSubCommandAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer,
-                                                juce::MidiBuffer&)
+void GLSSubCommandAudioProcessor::processFloat (juce::AudioBuffer<float>& buffer,
+                                                juce::MidiBuffer& midi)
 {
-    juce::ScopedNoDenormals noDenormals;
-
-    const auto* bypassParam = apvts.getRawParameterValue ("ui_bypass");
-    const bool softBypass = bypassParam != nullptr && bypassParam->load() > 0.5f;
-    if (softBypass)
+    if (renderInPreparedChunks (buffer, midi))
         return;
 
+    juce::ScopedNoDenormals noDenormals;
+
     auto totalIn  = getTotalNumInputChannels();
     auto totalOut = getTotalNumOutputChannels();
     for (int ch = totalIn; ch < totalOut; ++ch)
         buffer.clear (ch, 0, buffer.getNumSamples());
 
-    auto read = [this](const char* id) { return apvts.getRawParameterValue (id)->load(); };
+    if (! bypass.begin (buffer, buffer.getNumSamples(), params.isOn (Param::bypass)))
+        return;
 
-    const auto xoverFreq = read ("xover_freq");
-    const auto subLevelDb= read ("sub_level");
-    const auto tightness = juce::jlimit (0.0f, 1.0f, read ("tightness"));
-    const auto harmonics = juce::jlimit (0.0f, 1.0f, read ("harmonics"));
-    const auto outHpf    = read ("out_hpf");
-    const auto mix       = juce::jlimit (0.0f, 1.0f, read ("mix"));
-    const auto inputTrim = juce::Decibels::decibelsToGain (read ("input_trim"));
-    const auto outputTrim = juce::Decibels::decibelsToGain (read ("output_trim"));
+    const auto xoverFreq = params[Param::xoverFreq];
+    const auto subLevelDb= params[Param::subLevel];
+    const auto tightness = juce::jlimit (0.0f, 1.0f, params[Param::tightness]);
+    const auto harmonics = juce::jlimit (0.0f, 1.0f, params[Param::harmonics]);
+    const auto outHpf    = params[Param::outHpf];
 
-    buffer.applyGain (inputTrim);
-    lastBlockSize = (juce::uint32) juce::jmax (1, buffer.getNumSamples());
     ensureStateSize();
 
-    originalBuffer.setSize (buffer.getNumChannels(), buffer.getNumSamples(), false, false, true);
-    originalBuffer.makeCopyOf (buffer, true);
-
     const auto subGain     = juce::Decibels::decibelsToGain (subLevelDb);
     const auto attackCoeff = std::exp (-1.0f / ((0.5f + tightness * 4.5f) * 0.001f * currentSampleRate));
     const auto releaseCoeff= std::exp (-1.0f / ((10.0f - tightness * 9.0f) * 0.001f * currentSampleRate));
@@ -71,23 +91,34 @@ void GLSSubCommandAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer
     const int numSamples   = buffer.getNumSamples();
     const int numChannels  = buffer.getNumChannels();
 
-    juce::AudioBuffer<float> lowBuffer (numChannels, numSamples);
-    juce::AudioBuffer<float> highBuffer (numChannels, numSamples);
+    for (auto* smoother : { &inputTrimGain, &mixAmount, &outputTrimGain })
+        smoother->update();
+
+    // Each smoother renders its own ramp, so all three stay valid across the channel loops.
+    const auto* inputTrims  = inputTrimGain.advance (numSamples);
+    const auto* mixes       = mixAmount.advance (numSamples);
+    const auto* outputTrims = outputTrimGain.advance (numSamples);
+    const auto inputTrim    = inputTrimGain.getCurrentValue();
+    const auto mix          = mixAmount.getCurrentValue();
+    const auto outputTrim   = outputTrimGain.getCurrentValue();
 
     for (int ch = 0; ch < numChannels; ++ch)
     {
         auto& state = channelStates[ch];
         updateFilters (state, xoverFreq, outHpf);
 
-        const auto* input = originalBuffer.getReadPointer (ch);
+        // buffer keeps the untrimmed input until the final loop, which also uses it as
+        // the dry signal; the trim is folded into each read.
+        const auto* input = buffer.getReadPointer (ch);
         auto* lowPtr  = lowBuffer.getWritePointer (ch);
-
-        for (int i = 0; i < numSamples; ++i)
-            lowPtr[i] = state.lowPass.processSample (input[i]);
-
         auto* highPtr = highBuffer.getWritePointer (ch);
+
         for (int i = 0; i < numSamples; ++i)
-            highPtr[i] = input[i] - lowPtr[i];
+        {
+            const auto trimmed = input[i] * (inputTrims != nullptr ? inputTrims[i] : inputTrim);
+            lowPtr[i] = state.lowPass.processSample (trimmed);
+            highPtr[i] = trimmed - lowPtr[i];
+        }
 
         for (int i = 0; i < numSamples; ++i)
         {
@@ -118,13 +149,20 @@ void GLSSubCommandAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer
         for (int i = 0; i < numSamples; ++i)
         {
             const float processed = lowPtr[i] + highPtr[i];
-            const float original  = originalBuffer.getSample (ch, i);
-            auto sample = processed * mix + original * (1.0f - mix);
-            outPtr[i] = state.outputHPF.processSample (sample);
+            const auto amount = mixes != nullptr ? mixes[i] : mix;
+            const auto dryGain = (1.0f - amount) * (inputTrims != nullptr ? inputTrims[i] : inputTrim);
+            auto sample = processed * amount + outPtr[i] * dryGain;
+            outPtr[i] = state.outputHPF.processSample (sample) * (outputTrims != nullptr ? outputTrims[i] : outputTrim);
         }
     }
 
-    buffer.applyGain (outputTrim);
+    bypass.end (buffer, buffer.getNumSamples());
+}
+
+void GLSSubCommandAudioProcessor::updateTail()
+{
+    const auto tightness = juce::jlimit (0.0f, 1.0f, params[Param::tightness]);
+    tail.setTail (0.0, gls::dsp::TailTracker::getEnvelopeRT60 ((10.0 - tightness * 9.0) * 0.001));
 }
 
 void GLSSubCommandAudioProcessor::getStateInformation (juce::MemoryBlock& destData)
@@ -143,27 +181,7 @@ void GLSSubCommandAudioProcessor::setStateInformation (const void* data, int siz
 juce::AudioProcessorValueTreeState::ParameterLayout
 GLSSubCommandAudioProcessor::createParameterLayout()
 {
-    std::vector<std::unique_ptr<juce::RangedAudioParameter>> params;
-
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("xover_freq", "Xover Freq",
-                                                                   juce::NormalisableRange<float> (40.0f, 250.0f, 0.01f, 0.4f), 90.0f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("sub_level",  "Sub Level",
-                                                                   juce::NormalisableRange<float> (-12.0f, 12.0f, 0.1f), 0.0f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("tightness",  "Tightness",
-                                                                   juce::NormalisableRange<float> (0.0f, 1.0f, 0.001f), 0.5f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("harmonics",  "Harmonics",
-                                                                   juce::NormalisableRange<float> (0.0f, 1.0f, 0.001f), 0.3f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("out_hpf",    "Out HPF",
-                                                                   juce::NormalisableRange<float> (20.0f, 120.0f, 0.01f, 0.4f), 35.0f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("mix",        "Mix",
-                                                                   juce::NormalisableRange<float> (0.0f, 1.0f, 0.001f), 1.0f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("input_trim", "Input Trim",
-                                                                   juce::NormalisableRange<float> (-24.0f, 24.0f, 0.01f), 0.0f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("output_trim", "Output Trim",
-                                                                   juce::NormalisableRange<float> (-24.0f, 24.0f, 0.01f), 0.0f));
-    params.push_back (std::make_unique<juce::AudioParameterBool> ("ui_bypass", "Soft Bypass", false));
-
-    return { params.begin(), params.end() };
+    return gls::createParameterLayout (parameterTable);
 }
 
 namespace
@@ -428,7 +446,6 @@ void GLSSubCommandAudioProcessor::ensureStateSize()
     if (requiredChannels <= 0)
     {
         channelStates.clear();
-        originalBuffer.setSize (0, 0);
         return;
     }
 
@@ -445,8 +462,6 @@ void GLSSubCommandAudioProcessor::ensureStateSize()
         state.lowPass.prepare (spec);
         state.outputHPF.prepare (spec);
     }
-
-    originalBuffer.setSize (requiredChannels, (int) (lastBlockSize > 0 ? lastBlockSize : 512u), false, false, true);
 }
 
 void GLSSubCommandAudioProcessor::updateFilters (ChannelState& state, float xoverFreq, float outHpfFreq)
@@ -454,13 +469,9 @@ void GLSSubCommandAudioProcessor::updateFilters (ChannelState& state, float xove
     if (currentSampleRate <= 0.0)
         return;
 
-    const auto lp = juce::dsp::IIR::Coefficients<float>::makeLowPass (currentSampleRate,
-                                                                      juce::jlimit (20.0f, (float) (currentSampleRate * 0.45), xoverFreq));
-    const auto hp = juce::dsp::IIR::Coefficients<float>::makeHighPass (currentSampleRate,
-                                                                       juce::jlimit (10.0f, (float) (currentSampleRate * 0.45), outHpfFreq));
-
-    state.lowPass.coefficients   = lp;
-    state.outputHPF.coefficients = hp;
+    const auto maxFreq = (float) (currentSampleRate * 0.45);
+    state.lowPass.setLowPass (currentSampleRate, juce::jlimit (20.0f, maxFreq, xoverFreq));
+    state.outputHPF.setHighPass (currentSampleRate, juce::jlimit (10.0f, maxFreq, outHpfFreq));
 }
 
 float GLSSubCommandAudioProcessor::generateHarmonics (float sample, float amount)
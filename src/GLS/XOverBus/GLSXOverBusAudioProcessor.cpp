@@ -2,6 +2,24 @@
 
 namespace
 {
+using Param = GLSXOverBusAudioProcessor::Param;
+using Spec = gls::ParameterSpec;
+
+constexpr std::array<Spec, (size_t) Param::count> parameterTable {{
+    Spec::range  ("split_freq1", "Split Freq 1", 50.0f,  8000.0f, 0.01f,  200.0f,  0.4f),
+    Spec::range  ("split_freq2", "Split Freq 2", 50.0f,  8000.0f, 0.01f,  2000.0f, 0.4f),
+    Spec::range  ("slope",       "Slope",        6.0f,   48.0f,   6.0f,   24.0f),
+    Spec::toggle ("band_solo1",  "Band 1 Solo",  false),
+    Spec::toggle ("band_solo2",  "Band 2 Solo",  false),
+    Spec::toggle ("band_solo3",  "Band 3 Solo",  false),
+    Spec::range  ("output_trim", "Output Trim",  -12.0f, 12.0f,   0.1f,   0.0f),
+    Spec::range  ("mix",         "Dry/Wet",      0.0f,   1.0f,    0.001f, 1.0f),
+    Spec::range  ("input_trim",  "Input Trim",   -24.0f, 24.0f,   0.01f,  0.0f),
+    Spec::toggle ("ui_bypass",   "Soft Bypass",  false)
+}};
+
+static_assert (gls::hasUniqueIds (parameterTable));
+
 float normaliseLog (float value, float minHz, float maxHz)
 {
     auto clamped = juce::jlimit (minHz, maxHz, value);
@@ -16,12 +34,16 @@ GLSXOverBusAudioProcessor::GLSXOverBusAudioProcessor()
     : DualPrecisionAudioProcessor(BusesProperties()
                         .withInput  ("Input", juce::AudioChannelSet::stereo(), true)
                         .withOutput ("Output", juce::AudioChannelSet::stereo(), true)),
-      apvts (*this, nullptr, "XOVER_BUS", createParameterLayout())
+      apvts (*this, nullptr, "XOVER_BUS", createParameterLayout()),
+      params (apvts, parameterTable)
 {
+    bypass.snapOnResume ({ &inputTrimGain, &mixAmount, &outputTrimGain });
 }
 
 void GLSXOverBusAudioProcessor::prepareToPlay (double sampleRate, int samplesPerBlock)
 {
+    DualPrecisionAudioProcessor::prepareToPlay (sampleRate, samplesPerBlock);
+
     currentSampleRate = sampleRate > 0.0 ? sampleRate : 44100.0;
     lastBlockSize = (juce::uint32) juce::jmax (1, samplesPerBlock);
     const auto channels = (juce::uint32) juce::jmax (1, getTotalNumOutputChannels());
@@ -33,45 +55,46 @@ void GLSXOverBusAudioProcessor::prepareToPlay (double sampleRate, int samplesPer
         prepareFilters (band, order, spec);
     };
 
-    const int order = juce::roundToInt (apvts.getRawParameterValue ("slope")->load());
+    const int order = juce::roundToInt (params[Param::slope]);
     prepareBand (lowBand, order);
     prepareBand (midBandLow, order);
     prepareBand (midBandHigh, order);
     prepareBand (highBand, order);
 
     ensureBufferSize ((int) channels, (int) lastBlockSize);
+
+    bypass.prepare (currentSampleRate, juce::jmax (getTotalNumInputChannels(), getTotalNumOutputChannels()), (int) lastBlockSize);
+
+    for (auto* smoother : { &inputTrimGain, &mixAmount, &outputTrimGain })
+        smoother->prepare (currentSampleRate, (int) lastBlockSize);
 }
 
 void GLSXOverBusAudioProcessor::releaseResources()
 {
 }
 
-void GLSXOverBusAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer,
-                                              juce::MidiBuffer&)
+void GLSXOverBusAudioProcessor::processFloat (juce::AudioBuffer<float>& buffer,
+                                              juce::MidiBuffer& midi)
 {
-    juce::ScopedNoDenormals noDenormals;
-
-    const auto* bypassParam = apvts.getRawParameterValue ("ui_bypass");
-    const bool softBypass = bypassParam != nullptr && bypassParam->load() > 0.5f;
-    if (softBypass)
+    if (renderInPreparedChunks (buffer, midi))
         return;
 
+    juce::ScopedNoDenormals noDenormals;
+
     auto totalIn  = getTotalNumInputChannels();
     auto totalOut = getTotalNumOutputChannels();
     for (int ch = totalIn; ch < totalOut; ++ch)
         buffer.clear (ch, 0, buffer.getNumSamples());
 
-    auto get = [this](const char* id) { return apvts.getRawParameterValue (id)->load(); };
+    if (! bypass.begin (buffer, buffer.getNumSamples(), params.isOn (Param::bypass)))
+        return;
 
-    const auto split1 = get ("split_freq1");
-    const auto split2 = get ("split_freq2");
-    const auto slope  = juce::roundToInt (get ("slope"));
-    const bool solo1  = apvts.getRawParameterValue ("band_solo1")->load() > 0.5f;
-    const bool solo2  = apvts.getRawParameterValue ("band_solo2")->load() > 0.5f;
-    const bool solo3  = apvts.getRawParameterValue ("band_solo3")->load() > 0.5f;
-    const auto output = get ("output_trim");
-    const auto mixAmount = juce::jlimit (0.0f, 1.0f, get ("mix"));
-    const auto inputTrim = juce::Decibels::decibelsToGain (get ("input_trim"));
+    const auto split1 = params[Param::splitFreq1];
+    const auto split2 = params[Param::splitFreq2];
+    const auto slope  = juce::roundToInt (params[Param::slope]);
+    const bool solo1  = params.isOn (Param::bandSolo1);
+    const bool solo2  = params.isOn (Param::bandSolo2);
+    const bool solo3  = params.isOn (Param::bandSolo3);
 
     lastBlockSize = (juce::uint32) juce::jmax (1, buffer.getNumSamples());
     const auto numChannels = (juce::uint32) juce::jmax (1, buffer.getNumChannels());
@@ -89,13 +112,25 @@ void GLSXOverBusAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer,
 
     ensureBufferSize (buffer.getNumChannels(), buffer.getNumSamples());
 
-    buffer.applyGain (inputTrim);
-    originalBuffer.setSize (buffer.getNumChannels(), buffer.getNumSamples(), false, false, true);
-    originalBuffer.makeCopyOf (buffer, true);
+    for (auto* smoother : { &inputTrimGain, &mixAmount, &outputTrimGain })
+        smoother->update();
 
-    lowBuffer.makeCopyOf (buffer);
-    midBuffer.makeCopyOf (buffer);
-    highBuffer.makeCopyOf (buffer);
+    const auto numSamples = buffer.getNumSamples();
+    const auto* inputTrims  = inputTrimGain.advance (numSamples);
+    const auto* mixes       = mixAmount.advance (numSamples);
+    const auto* outputTrims = outputTrimGain.advance (numSamples);
+    const auto inputTrim    = inputTrimGain.getCurrentValue();
+
+    // The bands take trimmed copies, so buffer still holds the input when the sum below
+    // overwrites it and serves as the dry signal without a copy of its own.
+    for (auto* band : { &lowBuffer, &midBuffer, &highBuffer })
+        for (int ch = 0; ch < buffer.getNumChannels(); ++ch)
+        {
+            if (inputTrims != nullptr)
+                juce::FloatVectorOperations::multiply (band->getWritePointer (ch), buffer.getReadPointer (ch), inputTrims, numSamples);
+            else
+                band->copyFrom (ch, 0, buffer.getReadPointer (ch), numSamples, inputTrim);
+        }
 
     applyFilters (lowBand, lowBuffer, true);
     applyFilters (midBandLow, midBuffer, false);
@@ -103,6 +138,12 @@ void GLSXOverBusAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer,
     applyFilters (highBand, highBuffer, false);
 
     const bool anySolo = solo1 || solo2 || solo3;
+    const auto mix = mixAmount.getCurrentValue();
+    const auto outputGain = outputTrimGain.getCurrentValue();
+    const auto moving = inputTrims != nullptr || mixes != nullptr || outputTrims != nullptr;
+    auto wetGain = mix * outputGain;
+    auto dryGain = (1.0f - mix) * inputTrim * outputGain;
+
     for (int ch = 0; ch < buffer.getNumChannels(); ++ch)
     {
         auto* low = lowBuffer.getWritePointer (ch);
@@ -110,18 +151,25 @@ void GLSXOverBusAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer,
         auto* high = highBuffer.getWritePointer (ch);
         auto* out = buffer.getWritePointer (ch);
 
-        for (int i = 0; i < buffer.getNumSamples(); ++i)
+        for (int i = 0; i < numSamples; ++i)
         {
+            if (moving)
+            {
+                const auto amount = mixes != nullptr ? mixes[i] : mix;
+                const auto gain = outputTrims != nullptr ? outputTrims[i] : outputGain;
+                wetGain = amount * gain;
+                dryGain = (1.0f - amount) * (inputTrims != nullptr ? inputTrims[i] : inputTrim) * gain;
+            }
+
             float sample = 0.0f;
             if (!anySolo || solo1) sample += low[i];
             if (!anySolo || solo2) sample += mid[i];
             if (!anySolo || solo3) sample += high[i];
-            const auto original = originalBuffer.getSample (ch, i);
-            out[i] = sample * mixAmount + original * (1.0f - mixAmount);
+            out[i] = sample * wetGain + out[i] * dryGain;
         }
     }
 
-    buffer.applyGain (juce::Decibels::decibelsToGain (output));
+    bypass.end (buffer, buffer.getNumSamples());
 }
 
 void GLSXOverBusAudioProcessor::getStateInformation (juce::MemoryBlock& destData)
@@ -140,26 +188,7 @@ void GLSXOverBusAudioProcessor::setStateInformation (const void* data, int sizeI
 juce::AudioProcessorValueTreeState::ParameterLayout
 GLSXOverBusAudioProcessor::createParameterLayout()
 {
-    std::vector<std::unique_ptr<juce::RangedAudioParameter>> params;
-
-    auto freqRange = juce::NormalisableRange<float> (50.0f, 8000.0f, 0.01f, 0.4f);
-
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("split_freq1", "Split Freq 1", freqRange, 200.0f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("split_freq2", "Split Freq 2", freqRange, 2000.0f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("slope",      "Slope",
-                                                                   juce::NormalisableRange<float> (6.0f, 48.0f, 6.0f), 24.0f));
-    params.push_back (std::make_unique<juce::AudioParameterBool>  ("band_solo1", "Band 1 Solo", false));
-    params.push_back (std::make_unique<juce::AudioParameterBool>  ("band_solo2", "Band 2 Solo", false));
-    params.push_back (std::make_unique<juce::AudioParameterBool>  ("band_solo3", "Band 3 Solo", false));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("output_trim", "Output Trim",
-                                                                   juce::NormalisableRange<float> (-12.0f, 12.0f, 0.1f), 0.0f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("mix", "Dry/Wet",
-                                                                   juce::NormalisableRange<float> (0.0f, 1.0f, 0.001f), 1.0f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("input_trim", "Input Trim",
-                                                                   juce::NormalisableRange<float> (-24.0f, 24.0f, 0.01f), 0.0f));
-    params.push_back (std::make_unique<juce::AudioParameterBool> ("ui_bypass", "Soft Bypass", false));
-
-    return { params.begin(), params.end() };
+    return gls::createParameterLayout (parameterTable);
 }
 
 class XOverVisual : public juce::Component, private juce::Timer
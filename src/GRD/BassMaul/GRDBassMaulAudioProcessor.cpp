@@ -1,27 +1,64 @@
 #include "GRDBassMaulAudioProcessor.h"
 
+namespace
+{
+using Param = GRDBassMaulAudioProcessor::Param;
+using Spec = gls::ParameterSpec;
+
+constexpr std::array<Spec, (size_t) Param::count> parameterTable {{
+    Spec::range  ("drive",       "Drive",       0.0f,   1.0f,   0.001f, 0.5f),
+    Spec::range  ("sub_boost",   "Sub Boost",   0.0f,   12.0f,  0.01f,  6.0f),
+    Spec::range  ("tightness",   "Tightness",   20.0f,  220.0f, 0.01f,  90.0f, 0.3f),
+    Spec::range  ("blend",       "Blend",       0.0f,   1.0f,   0.001f, 0.7f),
+    Spec::range  ("output_trim", "Output Trim", -12.0f, 12.0f,  0.01f,  0.0f),
+    Spec::range  ("input_trim",  "Input Trim",  -24.0f, 24.0f,  0.01f,  0.0f),
+    Spec::toggle ("ui_bypass",   "Soft Bypass", false)
+}};
+
+static_assert (gls::hasUniqueIds (parameterTable));
+} // namespace
+
 GRDBassMaulAudioProcessor::GRDBassMaulAudioProcessor()
     : DualPrecisionAudioProcessor (BusesProperties()
                         .withInput  ("Input", juce::AudioChannelSet::stereo(), true)
                         .withOutput ("Output", juce::AudioChannelSet::stereo(), true)),
-      apvts (*this, nullptr, "BASS_MAUL", createParameterLayout())
+      apvts (*this, nullptr, "BASS_MAUL", createParameterLayout()),
+      params (apvts, parameterTable)
 {
+    oversampler.attach (apvts);
+    bypass.snapOnResume ({ &blendAmount, &outputTrimGain });
 }
 
 void GRDBassMaulAudioProcessor::prepareToPlay (double sampleRate, int samplesPerBlock)
 {
+    DualPrecisionAudioProcessor::prepareToPlay (sampleRate, samplesPerBlock);
+
     currentSampleRate = sampleRate > 0.0 ? sampleRate : 44100.0;
     lastBlockSize = (juce::uint32) juce::jmax (1, samplesPerBlock);
     ensureChannelState (juce::jmax (1, getTotalNumOutputChannels()));
+
+    oversampler.prepare (juce::jmax (1, getTotalNumOutputChannels()), samplesPerBlock);
+    bypass.prepare (currentSampleRate, juce::jmax (getTotalNumInputChannels(), getTotalNumOutputChannels()), samplesPerBlock,
+                    oversampler.getMaximumLatencySamples());
+    blendAmount.prepare (currentSampleRate * oversampler.getFactor(), samplesPerBlock << gls::dsp::Oversampler<float>::maxFactorLog2);
+
+    for (auto* smoother : { &inputTrimGain, &outputTrimGain })
+        smoother->prepare (currentSampleRate, samplesPerBlock);
+
+    latency.invalidate();
+    updateOversampling();
 }
 
 void GRDBassMaulAudioProcessor::releaseResources()
 {
 }
 
-void GRDBassMaulAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer,
-                                              juce::MidiBuffer&)
+void GRDBassMaulAudioProcessor::processFloat (juce::AudioBuffer<float>& buffer,
+                                              juce::MidiBuffer& midi)
 {
+    if (renderInPreparedChunks (buffer, midi))
+        return;
+
     juce::ScopedNoDenormals noDenormals;
 
     const auto totalIn  = getTotalNumInputChannels();
@@ -34,50 +71,52 @@ void GRDBassMaulAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer,
     if (numChannels == 0 || numSamples == 0)
         return;
 
-    auto get = [this](const char* id)
-    {
-        if (auto* param = apvts.getRawParameterValue (id))
-            return param->load();
-        return 0.0f;
-    };
-
-    const bool bypassed    = get ("ui_bypass") > 0.5f;
-    if (bypassed)
-        return;
+    const bool bypassed    = params.isOn (Param::bypass);
 
-    const float drive       = juce::jlimit (0.0f, 1.0f, get ("drive"));
-    const float subBoostDb  = juce::jlimit (0.0f, 12.0f, get ("sub_boost"));
-    const float tightnessHz = juce::jlimit (20.0f, 220.0f, get ("tightness"));
-    const float blend       = juce::jlimit (0.0f, 1.0f, get ("blend"));
-    const float trimDb      = juce::jlimit (-12.0f, 12.0f, get ("output_trim"));
-    const float inputTrimDb = juce::jlimit (-24.0f, 24.0f, get ("input_trim"));
+    const float drive       = juce::jlimit (0.0f, 1.0f, params[Param::drive]);
+    const float subBoostDb  = juce::jlimit (0.0f, 12.0f, params[Param::subBoost]);
+    const float tightnessHz = juce::jlimit (20.0f, 220.0f, params[Param::tightness]);
 
     const float driveGain = 1.0f + drive * 7.0f;
     const float subGain   = juce::Decibels::decibelsToGain (subBoostDb);
-    const float trimGain  = juce::Decibels::decibelsToGain (trimDb);
-    const float inputGain = juce::Decibels::decibelsToGain (inputTrimDb);
 
     lastBlockSize = (juce::uint32) juce::jmax (1, numSamples);
     ensureChannelState (numChannels);
-    updateFilterCoefficients (tightnessHz, 120.0f);
+    updateOversampling();
+    updateFilterCoefficients (tightnessHz, 120.0f, currentSampleRate * oversampler.getFactor());
 
-    buffer.applyGain (inputGain);
+    for (auto* smoother : { &inputTrimGain, &blendAmount, &outputTrimGain })
+        smoother->update();
 
-    for (int ch = 0; ch < numChannels; ++ch)
+    inputTrimGain.applyGain (buffer, numSamples);
+
+    if (! bypass.begin (buffer, numSamples, bypassed))
+        return;
+
+    oversampler.process (buffer, [&] (juce::dsp::AudioBlock<float>& block)
     {
-        auto* data = buffer.getWritePointer (ch);
-        auto& state = channelStates[ch];
+        const auto* blends = blendAmount.advance ((int) block.getNumSamples());
+        const float blend = blendAmount.getCurrentValue();
 
-        for (int i = 0; i < numSamples; ++i)
+        for (size_t ch = 0; ch < block.getNumChannels(); ++ch)
         {
-            const float input = data[i];
-            float tight = state.tightHighpass.processSample (input);
-            float shaped = std::tanh (tight * driveGain);
-            const float subComponent = state.subLowpass.processSample (input) * subGain;
-            const float processed = shaped + subComponent;
-            data[i] = juce::jmap (blend, input, processed) * trimGain;
+            auto* data = block.getChannelPointer (ch);
+            auto& state = channelStates[ch];
+
+            for (size_t i = 0; i < block.getNumSamples(); ++i)
+            {
+                const float input = data[i];
+                float tight = state.tightHighpass.processSample (input);
+                float shaped = std::tanh (tight * driveGain);
+                const float subComponent = state.subLowpass.processSample (input) * subGain;
+                const float processed = shaped + subComponent;
+                data[i] = juce::jmap (blends != nullptr ? blends[i] : blend, input, processed);
+            }
         }
-    }
+    });
+
+    outputTrimGain.applyGain (buffer, numSamples);
+    bypass.end (buffer, numSamples);
 }
 
 void GRDBassMaulAudioProcessor::getStateInformation (juce::MemoryBlock& destData)
@@ -97,20 +136,8 @@ juce::AudioProcessorValueTreeState::ParameterLayout
 GRDBassMaulAudioProcessor::createParameterLayout()
 {
     std::vector<std::unique_ptr<juce::RangedAudioParameter>> params;
-
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("drive", "Drive",
-                                                                   juce::NormalisableRange<float> (0.0f, 1.0f, 0.001f), 0.5f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("sub_boost", "Sub Boost",
-                                                                   juce::NormalisableRange<float> (0.0f, 12.0f, 0.01f), 6.0f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("tightness", "Tightness",
-                                                                   juce::NormalisableRange<float> (20.0f, 220.0f, 0.01f, 0.3f), 90.0f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("blend", "Blend",
-                                                                   juce::NormalisableRange<float> (0.0f, 1.0f, 0.001f), 0.7f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("output_trim", "Output Trim",
-                                                                   juce::NormalisableRange<float> (-12.0f, 12.0f, 0.01f), 0.0f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("input_trim", "Input Trim",
-                                                                   juce::NormalisableRange<float> (-24.0f, 24.0f, 0.01f), 0.0f));
-    params.push_back (std::make_unique<juce::AudioParameterBool> ("ui_bypass", "Soft Bypass", false));
+    gls::addParameters (params, parameterTable);
+    gls::dsp::Oversampler<float>::addParameters (params);
 
     return { params.begin(), params.end() };
 }
@@ -142,23 +169,30 @@ void GRDBassMaulAudioProcessor::ensureChannelState (int numChannels)
     }
 }
 
-void GRDBassMaulAudioProcessor::updateFilterCoefficients (float tightnessHz, float subSplitHz)
+void GRDBassMaulAudioProcessor::updateFilterCoefficients (float tightnessHz, float subSplitHz, double processingRate)
 {
-    if (currentSampleRate <= 0.0)
+    if (processingRate <= 0.0)
         return;
 
-    auto hp = juce::dsp::IIR::Coefficients<float>::makeHighPass (currentSampleRate,
-                                                                 juce::jlimit (20.0f, 400.0f, tightnessHz), 0.9f);
-    auto lp = juce::dsp::IIR::Coefficients<float>::makeLowPass (currentSampleRate,
-                                                                juce::jlimit (40.0f, 250.0f, subSplitHz), 0.8f);
+    const auto tightFreq = juce::jlimit (20.0f, 400.0f, tightnessHz);
+    const auto subFreq   = juce::jlimit (40.0f, 250.0f, subSplitHz);
 
     for (auto& state : channelStates)
     {
-        state.tightHighpass.coefficients = hp;
-        state.subLowpass.coefficients = lp;
+        state.tightHighpass.setHighPass (processingRate, tightFreq, 0.9f);
+        state.subLowpass.setLowPass (processingRate, subFreq, 0.8f);
     }
 }
 
+void GRDBassMaulAudioProcessor::updateOversampling()
+{
+    oversampler.update (isNonRealtime(), currentSampleRate, { &blendAmount });
+
+    latency.setStage (0, oversampler.getLatencySamples(), oversampler.getLatencySamples());
+    latency.update();
+    bypass.setLatency (oversampler.getLatencySamples());
+}
+
 class BassMaulVisual : public juce::Component, private juce::Timer
 {
 public:
@@ -233,7 +267,8 @@ GRDBassMaulAudioProcessorEditor::GRDBassMaulAudioProcessorEditor (GRDBassMaulAud
       processorRef (p),
       accentColour (gls::ui::accentForFamily ("GRD")),
       headerComponent ("GRD.BassMaul", "Bass Maul"),
-      footerComponent()
+      footerComponent(),
+      oversamplingSelector (p.getValueTreeState())
 {
     lookAndFeel.setAccentColour (accentColour);
     headerComponent.setAccentColour (accentColour);
@@ -257,6 +292,7 @@ GRDBassMaulAudioProcessorEditor::GRDBassMaulAudioProcessorEditor (GRDBassMaulAud
     bypassButton.setLookAndFeel (&lookAndFeel);
     bypassButton.setClickingTogglesState (true);
     addAndMakeVisible (bypassButton);
+    addAndMakeVisible (oversamplingSelector);
 
     auto& state = processorRef.getValueTreeState();
     auto attachSlider = [this, &state](const char* paramID, juce::Slider& slider)
@@ -353,7 +389,7 @@ void GRDBassMaulAudioProcessorEditor::resized()
     trimSlider.setBounds (right.removeFromTop (microHeight).reduced (8));
 
     auto footerArea = footerBounds.reduced (32, 8);
-    auto slotWidth = footerArea.getWidth() / 3;
+    auto slotWidth = footerArea.getWidth() / 4;
 
     auto slot = footerArea.removeFromLeft (slotWidth).reduced (8);
     inputTrimSlider.setBounds (slot);
@@ -361,7 +397,8 @@ void GRDBassMaulAudioProcessorEditor::resized()
     slot = footerArea.removeFromLeft (slotWidth).reduced (8);
     blendSlider.setBounds (slot);
 
-    slot = footerArea.removeFromLeft (slotWidth).reduced (8);
+    slot = footerArea.reduced (8);
+    oversamplingSelector.setBounds (slot.removeFromRight (260).withSizeKeepingCentre (260, 28));
     bypassButton.setBounds (slot);
 
     layoutLabels();
@@ -1,18 +1,31 @@
 #pragma once
 
 #include <JuceHeader.h>
+#include <array>
 #include "../../DualPrecisionAudioProcessor.h"
+#include "../../ParameterTable.h"
+#include "../../SmoothedParameter.h"
+#include "../../dsp/Biquad.h"
 #include "../../ui/GoodluckLookAndFeel.h"
+#include "../../dsp/LatencyReporter.h"
+#include "../../dsp/Oversampler.h"
+#include "../../dsp/SoftBypass.h"
+#include "../../ui/OversamplingSelector.h"
 
 class GRDBassMaulAudioProcessor : public DualPrecisionAudioProcessor
 {
 public:
+    enum class Param
+    {
+        drive, subBoost, tightness, blend, outputTrim, inputTrim, bypass,
+        count
+    };
+
     GRDBassMaulAudioProcessor();
     ~GRDBassMaulAudioProcessor() override = default;
 
     void prepareToPlay (double sampleRate, int samplesPerBlock) override;
     void releaseResources() override;
-    void processBlock (juce::AudioBuffer<float>&, juce::MidiBuffer&) override;
 
     juce::AudioProcessorEditor* createEditor() override;
     bool hasEditor() const override { return true; }
@@ -21,7 +34,6 @@ public:
     bool acceptsMidi() const override { return false; }
     bool producesMidi() const override { return false; }
     bool isMidiEffect() const override { return false; }
-    double getTailLengthSeconds() const override { return 0.0; }
 
     int getNumPrograms() override { return 1; }
     int getCurrentProgram() override { return 0; }
@@ -35,22 +47,34 @@ public:
     juce::AudioProcessorValueTreeState& getValueTreeState() { return apvts; }
     static juce::AudioProcessorValueTreeState::ParameterLayout createParameterLayout();
 
+protected:
+    void processFloat (juce::AudioBuffer<float>&, juce::MidiBuffer&) override;
+
 private:
     struct ChannelState
     {
-        juce::dsp::IIR::Filter<float> tightHighpass;
-        juce::dsp::IIR::Filter<float> subLowpass;
+        gls::dsp::Biquad tightHighpass;
+        gls::dsp::Biquad subLowpass;
     };
 
     juce::AudioProcessorValueTreeState apvts;
+
+    gls::ParameterHandles<Param> params;
+    gls::SmoothedParameter inputTrimGain  { params, Param::inputTrim,   gls::SmoothedParameter::Mapping::decibels };
+    gls::SmoothedParameter blendAmount    { params, Param::blend };
+    gls::SmoothedParameter outputTrimGain { params, Param::outputTrim,  gls::SmoothedParameter::Mapping::decibels };
+    gls::dsp::SoftBypass bypass;
     std::vector<ChannelState> channelStates;
+    gls::dsp::Oversampler<float> oversampler;
+    gls::dsp::LatencyReporter latency { *this };
     double currentSampleRate = 44100.0;
     juce::uint32 lastBlockSize = 512;
     double filterSpecSampleRate = 0.0;
     juce::uint32 filterSpecBlockSize = 0;
 
     void ensureChannelState (int numChannels);
-    void updateFilterCoefficients (float tightnessHz, float subSplitHz);
+    void updateFilterCoefficients (float tightnessHz, float subSplitHz, double processingRate);
+    void updateOversampling();
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (GRDBassMaulAudioProcessor)
 };
@@ -83,6 +107,7 @@ private:
     juce::Slider inputTrimSlider;
 
     juce::ToggleButton bypassButton;
+    gls::ui::OversamplingSelector oversamplingSelector;
 
     using SliderAttachment = juce::AudioProcessorValueTreeState::SliderAttachment;
     using ButtonAttachment = juce::AudioProcessorValueTreeState::ButtonAttachment;
@@ -6,6 +6,21 @@ constexpr auto kStateId     = "BIT_SPEAR";
 constexpr auto kParamBypass = "ui_bypass";
 constexpr auto kParamInput  = "input_trim";
 constexpr auto kParamOutput = "output_trim";
+
+using Param = GRDBitSpearAudioProcessor::Param;
+using Spec = gls::ParameterSpec;
+
+constexpr std::array<Spec, (size_t) Param::count> parameterTable {{
+    Spec::range  ("bits",       "Bits",        4.0f,   16.0f, 0.01f,  10.0f),
+    Spec::range  ("downsample", "Downsample",  1.0f,   16.0f, 1.0f,   4.0f),
+    Spec::range  ("drive",      "Drive",       0.0f,   1.0f,  0.001f, 0.5f),
+    Spec::range  ("mix",        "Mix",         0.0f,   1.0f,  0.001f, 0.75f),
+    Spec::range  (kParamOutput, "Output Trim", -18.0f, 18.0f, 0.01f,  0.0f),
+    Spec::range  (kParamInput,  "Input Trim",  -18.0f, 18.0f, 0.1f,   0.0f),
+    Spec::toggle (kParamBypass, "Soft Bypass", false)
+}};
+
+static_assert (gls::hasUniqueIds (parameterTable));
 }
 
 const std::array<GRDBitSpearAudioProcessor::Preset, 3> GRDBitSpearAudioProcessor::presetBank {{
@@ -42,24 +57,43 @@ GRDBitSpearAudioProcessor::GRDBitSpearAudioProcessor()
     : DualPrecisionAudioProcessor (BusesProperties()
                         .withInput  ("Input", juce::AudioChannelSet::stereo(), true)
                         .withOutput ("Output", juce::AudioChannelSet::stereo(), true)),
-      apvts (*this, nullptr, kStateId, createParameterLayout())
+      apvts (*this, nullptr, kStateId, createParameterLayout()),
+      params (apvts, parameterTable)
 {
+    oversampler.attach (apvts);
+    bypass.snapOnResume ({ &mixAmount, &outputTrimGain });
 }
 
 void GRDBitSpearAudioProcessor::prepareToPlay (double sampleRate, int samplesPerBlock)
 {
+    DualPrecisionAudioProcessor::prepareToPlay (sampleRate, samplesPerBlock);
+
     currentSampleRate = sampleRate > 0.0 ? sampleRate : 44100.0;
     lastBlockSize = (juce::uint32) juce::jmax (1, samplesPerBlock);
     ensureStateSize (juce::jmax (1, getTotalNumOutputChannels()));
+
+    oversampler.prepare (juce::jmax (1, getTotalNumOutputChannels()), samplesPerBlock);
+    bypass.prepare (currentSampleRate, juce::jmax (getTotalNumInputChannels(), getTotalNumOutputChannels()), samplesPerBlock,
+                    oversampler.getMaximumLatencySamples());
+    mixAmount.prepare (currentSampleRate * oversampler.getFactor(), samplesPerBlock << gls::dsp::Oversampler<float>::maxFactorLog2);
+
+    for (auto* smoother : { &inputTrimGain, &outputTrimGain })
+        smoother->prepare (currentSampleRate, samplesPerBlock);
+
+    latency.invalidate();
+    updateOversampling();
 }
 
 void GRDBitSpearAudioProcessor::releaseResources()
 {
 }
 
-void GRDBitSpearAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer,
-                                              juce::MidiBuffer&)
+void GRDBitSpearAudioProcessor::processFloat (juce::AudioBuffer<float>& buffer,
+                                              juce::MidiBuffer& midi)
 {
+    if (renderInPreparedChunks (buffer, midi))
+        return;
+
     juce::ScopedNoDenormals noDenormals;
 
     const auto totalIn  = getTotalNumInputChannels();
@@ -72,49 +106,59 @@ void GRDBitSpearAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer,
     if (numChannels == 0 || numSamples == 0)
         return;
 
-    auto get = [this](const char* id) { return apvts.getRawParameterValue (id)->load(); };
-
-    const float bitsParam     = juce::jlimit (4.0f, 16.0f, get ("bits"));
-    const int downsampleSteps = juce::jlimit (1, 16, (int) std::round (get ("downsample")));
-    const float drive         = juce::jlimit (0.0f, 1.0f, get ("drive"));
-    const float mix           = juce::jlimit (0.0f, 1.0f, get ("mix"));
-    const float inputGain     = juce::Decibels::decibelsToGain (juce::jlimit (-18.0f, 18.0f, get (kParamInput)));
-    const float trimGain      = juce::Decibels::decibelsToGain (juce::jlimit (-18.0f, 18.0f, get (kParamOutput)));
-    const bool bypassed       = get (kParamBypass) > 0.5f;
+    const float bitsParam     = juce::jlimit (4.0f, 16.0f, params[Param::bits]);
+    const int downsampleSteps = juce::jlimit (1, 16, (int) std::round (params[Param::downsample]));
+    const float drive         = juce::jlimit (0.0f, 1.0f, params[Param::drive]);
+    const bool bypassed       = params.isOn (Param::bypass);
 
     ensureStateSize (numChannels);
-    dryBuffer.setSize (numChannels, numSamples, false, false, true);
-    dryBuffer.makeCopyOf (buffer, true);
-
-    buffer.applyGain (inputGain);
-    if (bypassed)
-        return;
+    updateOversampling();
 
+    // The sample-and-hold period is counted at the oversampled rate.
+    const int holdSamples = (downsampleSteps + 1) * oversampler.getFactor() - 1;
     const float maxCode = std::pow (2.0f, bitsParam - 1.0f) - 1.0f;
     const float invStep = maxCode > 0.0f ? 1.0f / maxCode : 1.0f;
     const float crushScale = 1.0f + drive * 7.0f;
 
-    for (int ch = 0; ch < numChannels; ++ch)
+    for (auto* smoother : { &inputTrimGain, &mixAmount, &outputTrimGain })
+        smoother->update();
+
+    // The dry signal is taken after the input trim, like the rest of the suite.
+    inputTrimGain.applyGain (buffer, numSamples);
+
+    if (! bypass.begin (buffer, numSamples, bypassed))
+        return;
+
+    oversampler.process (buffer, [&] (juce::dsp::AudioBlock<float>& block)
     {
-        auto* data = buffer.getWritePointer (ch);
-        auto& state = channelState[ch];
+        const auto blockSamples = (int) block.getNumSamples();
+        const auto* mixes = mixAmount.advance (blockSamples);
+        const float mix = mixAmount.getCurrentValue();
 
-        for (int i = 0; i < numSamples; ++i)
+        for (size_t ch = 0; ch < block.getNumChannels(); ++ch)
         {
-            const float input = data[i];
+            auto* data = block.getChannelPointer (ch);
+            auto& state = channelState[ch];
 
-            if (state.downsampleCounter++ >= downsampleSteps)
+            for (int i = 0; i < blockSamples; ++i)
             {
-                state.downsampleCounter = 0;
-                state.heldSample = input;
-            }
+                const float input = data[i];
 
-            const float crushed = std::round (juce::jlimit (-1.0f, 1.0f, state.heldSample) * maxCode) * invStep;
-            const float driven = juce::jlimit (-1.0f, 1.0f, std::tanh (crushed * crushScale));
-            const float blended = juce::jmap (mix, dryBuffer.getReadPointer (ch)[i], driven);
-            data[i] = blended * trimGain;
+                if (state.downsampleCounter++ >= holdSamples)
+                {
+                    state.downsampleCounter = 0;
+                    state.heldSample = input;
+                }
+
+                const float crushed = std::round (juce::jlimit (-1.0f, 1.0f, state.heldSample) * maxCode) * invStep;
+                const float driven = juce::jlimit (-1.0f, 1.0f, std::tanh (crushed * crushScale));
+                data[i] = juce::jmap (mixes != nullptr ? mixes[i] : mix, input, driven);
+            }
         }
-    }
+    });
+
+    outputTrimGain.applyGain (buffer, numSamples);
+    bypass.end (buffer, numSamples);
 }
 
 void GRDBitSpearAudioProcessor::getStateInformation (juce::MemoryBlock& destData)
@@ -134,20 +178,8 @@ juce::AudioProcessorValueTreeState::ParameterLayout
 GRDBitSpearAudioProcessor::createParameterLayout()
 {
     std::vector<std::unique_ptr<juce::RangedAudioParameter>> params;
-
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("bits", "Bits",
-                                                                   juce::NormalisableRange<float> (4.0f, 16.0f, 0.01f), 10.0f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("downsample", "Downsample",
-                                                                   juce::NormalisableRange<float> (1.0f, 16.0f, 1.0f), 4.0f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("drive", "Drive",
-                                                                   juce::NormalisableRange<float> (0.0f, 1.0f, 0.001f), 0.5f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("mix", "Mix",
-                                                                   juce::NormalisableRange<float> (0.0f, 1.0f, 0.001f), 0.75f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("output_trim", "Output Trim",
-                                                                   juce::NormalisableRange<float> (-18.0f, 18.0f, 0.01f), 0.0f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> (kParamInput,  "Input Trim",
-                                                                   juce::NormalisableRange<float> (-18.0f, 18.0f, 0.1f), 0.0f));
-    params.push_back (std::make_unique<juce::AudioParameterBool>  (kParamBypass, "Soft Bypass", false));
+    gls::addParameters (params, parameterTable);
+    gls::dsp::Oversampler<float>::addParameters (params);
 
     return { params.begin(), params.end() };
 }
@@ -157,7 +189,6 @@ void GRDBitSpearAudioProcessor::ensureStateSize (int numChannels)
     if (numChannels <= 0)
     {
         channelState.clear();
-        dryBuffer.setSize (0, 0);
         return;
     }
 
@@ -165,6 +196,15 @@ void GRDBitSpearAudioProcessor::ensureStateSize (int numChannels)
         channelState.resize ((size_t) numChannels);
 }
 
+void GRDBitSpearAudioProcessor::updateOversampling()
+{
+    oversampler.update (isNonRealtime(), currentSampleRate, { &mixAmount });
+
+    latency.setStage (0, oversampler.getLatencySamples(), oversampler.getLatencySamples());
+    latency.update();
+    bypass.setLatency (oversampler.getLatencySamples());
+}
+
 int GRDBitSpearAudioProcessor::getNumPrograms()
 {
     return (int) presetBank.size();
@@ -206,7 +246,8 @@ void GRDBitSpearAudioProcessor::applyPreset (int index)
 GRDBitSpearAudioProcessorEditor::GRDBitSpearAudioProcessorEditor (GRDBitSpearAudioProcessor& processor)
     : juce::AudioProcessorEditor (&processor), processorRef (processor),
       accentColour (gls::ui::accentForFamily ("GRD")),
-      headerComponent ("GRD.BitSpear", "Bit Spear")
+      headerComponent ("GRD.BitSpear", "Bit Spear"),
+      oversamplingSelector (processor.getValueTreeState())
 {
     lookAndFeel.setAccentColour (accentColour);
     setLookAndFeel (&lookAndFeel);
@@ -236,6 +277,7 @@ GRDBitSpearAudioProcessorEditor::GRDBitSpearAudioProcessorEditor (GRDBitSpearAud
     for (int i = 0; i < ids.size(); ++i)
         attachments.push_back (std::make_unique<SliderAttachment> (state, ids[i], *sliders[i]));
     buttonAttachments.push_back (std::make_unique<ButtonAttachment> (state, kParamBypass, bypassButton));
+    addAndMakeVisible (oversamplingSelector);
 
     setSize (720, 420);
 }
@@ -302,7 +344,9 @@ void GRDBitSpearAudioProcessorEditor::resized()
     inputTrimSlider .setBounds (bottom.removeFromLeft (bottomWidth).reduced (8));
     outputTrimSlider.setBounds (bottom.removeFromLeft (bottomWidth).reduced (8));
 
-    bypassButton.setBounds (footerComponent.getBounds().reduced (24, 12));
+    auto footer = footerComponent.getBounds().reduced (24, 12);
+    oversamplingSelector.setBounds (footer.removeFromRight (300));
+    bypassButton.setBounds (footer);
     layoutLabels();
 }
 
@@ -3,17 +3,28 @@
 #include <JuceHeader.h>
 #include <array>
 #include "../../DualPrecisionAudioProcessor.h"
+#include "../../ParameterTable.h"
+#include "../../SmoothedParameter.h"
 #include "../../ui/GoodluckLookAndFeel.h"
+#include "../../dsp/LatencyReporter.h"
+#include "../../dsp/Oversampler.h"
+#include "../../dsp/SoftBypass.h"
+#include "../../ui/OversamplingSelector.h"
 
 class GRDBitSpearAudioProcessor : public DualPrecisionAudioProcessor
 {
 public:
+    enum class Param
+    {
+        bits, downsample, drive, mix, outputTrim, inputTrim, bypass,
+        count
+    };
+
     GRDBitSpearAudioProcessor();
     ~GRDBitSpearAudioProcessor() override = default;
 
     void prepareToPlay (double sampleRate, int samplesPerBlock) override;
     void releaseResources() override;
-    void processBlock (juce::AudioBuffer<float>&, juce::MidiBuffer&) override;
 
     juce::AudioProcessorEditor* createEditor() override;
     bool hasEditor() const override { return true; }
@@ -22,7 +33,6 @@ public:
     bool acceptsMidi() const override { return false; }
     bool producesMidi() const override { return false; }
     bool isMidiEffect() const override { return false; }
-    double getTailLengthSeconds() const override { return 0.0; }
 
     int getNumPrograms() override;
     int getCurrentProgram() override { return currentPreset; }
@@ -36,6 +46,9 @@ public:
     juce::AudioProcessorValueTreeState& getValueTreeState() { return apvts; }
     static juce::AudioProcessorValueTreeState::ParameterLayout createParameterLayout();
 
+protected:
+    void processFloat (juce::AudioBuffer<float>&, juce::MidiBuffer&) override;
+
 private:
     struct ChannelState
     {
@@ -44,8 +57,15 @@ private:
     };
 
     juce::AudioProcessorValueTreeState apvts;
+
+    gls::ParameterHandles<Param> params;
+    gls::SmoothedParameter inputTrimGain  { params, Param::inputTrim,   gls::SmoothedParameter::Mapping::decibels };
+    gls::SmoothedParameter mixAmount      { params, Param::mix };
+    gls::SmoothedParameter outputTrimGain { params, Param::outputTrim,  gls::SmoothedParameter::Mapping::decibels };
+    gls::dsp::SoftBypass bypass;
     std::vector<ChannelState> channelState;
-    juce::AudioBuffer<float> dryBuffer;
+    gls::dsp::Oversampler<float> oversampler;
+    gls::dsp::LatencyReporter latency { *this };
     double currentSampleRate = 44100.0;
     juce::uint32 lastBlockSize = 512;
     int currentPreset = 0;
@@ -59,6 +79,7 @@ private:
     static const std::array<Preset, 3> presetBank;
 
     void ensureStateSize (int numChannels);
+    void updateOversampling();
     void applyPreset (int index);
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (GRDBitSpearAudioProcessor)
@@ -88,6 +109,7 @@ private:
     juce::Slider inputTrimSlider;
     juce::Slider outputTrimSlider;
     juce::ToggleButton bypassButton { "Soft Bypass" };
+    gls::ui::OversamplingSelector oversamplingSelector;
 
     using SliderAttachment = juce::AudioProcessorValueTreeState::SliderAttachment;
     using ButtonAttachment = juce::AudioProcessorValueTreeState::ButtonAttachment;
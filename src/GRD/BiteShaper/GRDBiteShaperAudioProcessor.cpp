@@ -1,27 +1,62 @@
 #include "GRDBiteShaperAudioProcessor.h"
 
+namespace
+{
+using Param = GRDBiteShaperAudioProcessor::Param;
+using Spec = gls::ParameterSpec;
+
+constexpr std::array<Spec, (size_t) Param::count> parameterTable {{
+    Spec::range ("bite",        "Bite",        0.0f,   1.0f,     0.001f, 0.7f),
+    Spec::range ("fold",        "Fold",        0.0f,   1.0f,     0.001f, 0.4f),
+    Spec::range ("tone",        "Tone",        400.0f, 12000.0f, 0.01f,  3600.0f, 0.4f),
+    Spec::range ("mix",         "Mix",         0.0f,   1.0f,     0.001f, 0.65f),
+    Spec::range ("output_trim", "Output Trim", -12.0f, 12.0f,    0.01f,  0.0f)
+}};
+
+static_assert (gls::hasUniqueIds (parameterTable));
+} // namespace
+
 GRDBiteShaperAudioProcessor::GRDBiteShaperAudioProcessor()
     : DualPrecisionAudioProcessor (BusesProperties()
                         .withInput  ("Input", juce::AudioChannelSet::stereo(), true)
                         .withOutput ("Output", juce::AudioChannelSet::stereo(), true)),
-      apvts (*this, nullptr, "BITE_SHAPER", createParameterLayout())
+      apvts (*this, nullptr, "BITE_SHAPER", createParameterLayout()),
+      params (apvts, parameterTable),
+      adaaOrder (*apvts.getRawParameterValue (gls::dsp::AntiderivativeWaveshaper::orderParameterId))
 {
+    oversampler.attach (apvts);
 }
 
 void GRDBiteShaperAudioProcessor::prepareToPlay (double sampleRate, int samplesPerBlock)
 {
+    DualPrecisionAudioProcessor::prepareToPlay (sampleRate, samplesPerBlock);
+
     currentSampleRate = sampleRate > 0.0 ? sampleRate : 44100.0;
     lastBlockSize = (juce::uint32) juce::jmax (1, samplesPerBlock);
     ensureStateSize (juce::jmax (1, getTotalNumOutputChannels()));
+
+    oversampler.prepare (juce::jmax (1, getTotalNumOutputChannels()), samplesPerBlock);
+    mixAmount.prepare (currentSampleRate * oversampler.getFactor(), samplesPerBlock << gls::dsp::Oversampler<float>::maxFactorLog2);
+    outputTrimGain.prepare (currentSampleRate, samplesPerBlock);
+    folder.prepare (juce::jmax (1, getTotalNumOutputChannels()));
+    folder.setCurve (gls::dsp::AntiderivativeWaveshaper::Curve::fold);
+    saturator.prepare (juce::jmax (1, getTotalNumOutputChannels()));
+    saturator.setCurve (gls::dsp::AntiderivativeWaveshaper::Curve::tanh);
+    dryDelay.prepare (juce::jmax (1, getTotalNumOutputChannels()));
+    latency.invalidate();
+    updateOversampling();
 }
 
 void GRDBiteShaperAudioProcessor::releaseResources()
 {
 }
 
-void GRDBiteShaperAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer,
-                                                juce::MidiBuffer&)
+void GRDBiteShaperAudioProcessor::processFloat (juce::AudioBuffer<float>& buffer,
+                                                juce::MidiBuffer& midi)
 {
+    if (renderInPreparedChunks (buffer, midi))
+        return;
+
     juce::ScopedNoDenormals noDenormals;
 
     const auto totalIn  = getTotalNumInputChannels();
@@ -34,36 +69,65 @@ void GRDBiteShaperAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer
     if (numChannels == 0 || numSamples == 0)
         return;
 
-    auto get = [this](const char* id) { return apvts.getRawParameterValue (id)->load(); };
+    const float bite   = juce::jlimit (0.0f, 1.0f, params[Param::bite]);
+    const float fold   = juce::jlimit (0.0f, 1.0f, params[Param::fold]);
+    const float tone   = juce::jlimit (400.0f, 12000.0f, params[Param::tone]);
 
-    const float bite   = juce::jlimit (0.0f, 1.0f, get ("bite"));
-    const float fold   = juce::jlimit (0.0f, 1.0f, get ("fold"));
-    const float tone   = juce::jlimit (400.0f, 12000.0f, get ("tone"));
-    const float mix    = juce::jlimit (0.0f, 1.0f, get ("mix"));
-    const float trimDb = juce::jlimit (-12.0f, 12.0f, get ("output_trim"));
+    updateOversampling();
+    updateToneFilters (tone, currentSampleRate * oversampler.getFactor());
 
-    const float trimGain = juce::Decibels::decibelsToGain (trimDb);
-    updateToneFilters (tone);
+    using Shaper = gls::dsp::AntiderivativeWaveshaper;
+    using Lanes = Shaper::Lanes;
+    constexpr int lanes = Shaper::lanesPerGroup;
 
-    for (int ch = 0; ch < numChannels; ++ch)
-    {
-        auto* data = buffer.getWritePointer (ch);
-        auto& state = channelState[ch];
+    // Fold blend and tanh are two anti-aliased stages; the dry path matches both.
+    const auto order = Shaper::getOrder (adaaOrder);
+    folder.setOrder (order);
+    folder.setCurveAmount (fold);
+    saturator.setOrder (order);
+    dryDelay.setOrder (order, 2);
 
-        for (int i = 0; i < numSamples; ++i)
-        {
-            const float input = data[i];
-            const float pre = input * (1.0f + bite * 6.0f);
+    const auto preGain = 1.0 + bite * 6.0;
 
-            float shaped = pre;
-            const float folded = pre - 2.0f * std::floor ((pre + juce::MathConstants<float>::pi) / (2.0f * juce::MathConstants<float>::pi)) * juce::MathConstants<float>::pi;
-            shaped = shaped * (1.0f - fold) + std::sin (folded) * fold;
-            shaped = juce::jlimit (-1.0f, 1.0f, std::tanh (shaped));
-            shaped = state.toneFilter.processSample (shaped);
+    mixAmount.update();
+    outputTrimGain.update();
 
-            data[i] = juce::jmap (mix, input, shaped) * trimGain;
+    oversampler.process (buffer, [&] (juce::dsp::AudioBlock<float>& block)
+    {
+        const auto blockSamples = (int) block.getNumSamples();
+        const auto* mixes = mixAmount.advance (blockSamples);
+        const float mix = mixAmount.getCurrentValue();
+        const auto blockChannels = juce::jmin ((int) block.getNumChannels(), saturator.getNumGroups() * lanes);
+        const auto numGroups = (blockChannels + lanes - 1) / lanes;
+
+        for (int i = 0; i < blockSamples; ++i)
+        {
+            for (int group = 0; group < numGroups; ++group)
+            {
+                const int firstChannel = group * lanes;
+                const int groupChannels = juce::jmin (lanes, blockChannels - firstChannel);
+
+                alignas (Lanes::SIMDRegisterSize) double frame[(size_t) lanes] {};
+                for (int l = 0; l < groupChannels; ++l)
+                    frame[l] = block.getSample (firstChannel + l, i);
+
+                const auto input = Lanes::fromRawArray (frame);
+                const auto dry = dryDelay.processSample (group, input);
+                saturator.processSample (group, folder.processSample (group, input * preGain)).copyToRawArray (frame);
+
+                alignas (Lanes::SIMDRegisterSize) double shaped[(size_t) lanes] {};
+                for (int l = 0; l < groupChannels; ++l)
+                    shaped[l] = channelState[(size_t) (firstChannel + l)].toneFilter.processSample ((float) frame[l]);
+
+                (dry + (Lanes::fromRawArray (shaped) - dry) * (double) (mixes != nullptr ? mixes[i] : mix)).copyToRawArray (frame);
+                for (int l = 0; l < groupChannels; ++l)
+                    block.setSample (firstChannel + l, i, (float) frame[l]);
+            }
         }
-    }
+    });
+
+    // The trim is linear, so it runs at the host rate after the oversampler.
+    outputTrimGain.applyGain (buffer, numSamples);
 }
 
 void GRDBiteShaperAudioProcessor::getStateInformation (juce::MemoryBlock& destData)
@@ -83,17 +147,9 @@ juce::AudioProcessorValueTreeState::ParameterLayout
 GRDBiteShaperAudioProcessor::createParameterLayout()
 {
     std::vector<std::unique_ptr<juce::RangedAudioParameter>> params;
-
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("bite", "Bite",
-                                                                   juce::NormalisableRange<float> (0.0f, 1.0f, 0.001f), 0.7f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("fold", "Fold",
-                                                                   juce::NormalisableRange<float> (0.0f, 1.0f, 0.001f), 0.4f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("tone", "Tone",
-                                                                   juce::NormalisableRange<float> (400.0f, 12000.0f, 0.01f, 0.4f), 3600.0f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("mix", "Mix",
-                                                                   juce::NormalisableRange<float> (0.0f, 1.0f, 0.001f), 0.65f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("output_trim", "Output Trim",
-                                                                   juce::NormalisableRange<float> (-12.0f, 12.0f, 0.01f), 0.0f));
+    gls::addParameters (params, parameterTable);
+    gls::dsp::Oversampler<float>::addParameters (params);
+    gls::dsp::AntiderivativeWaveshaper::addParameters (params);
 
     return { params.begin(), params.end() };
 }
@@ -120,19 +176,27 @@ void GRDBiteShaperAudioProcessor::ensureStateSize (int numChannels)
     }
 }
 
-void GRDBiteShaperAudioProcessor::updateToneFilters (float toneHz)
+void GRDBiteShaperAudioProcessor::updateToneFilters (float toneHz, double processingRate)
 {
-    if (currentSampleRate <= 0.0)
+    if (processingRate <= 0.0)
         return;
 
-    auto coeffs = juce::dsp::IIR::Coefficients<float>::makeLowPass (currentSampleRate,
-                                                                    juce::jlimit (200.0f, (float) (currentSampleRate * 0.49f), toneHz), 0.7f);
+    const auto freq = juce::jlimit (200.0f, (float) (currentSampleRate * 0.49f), toneHz);
     for (auto& state : channelState)
-        state.toneFilter.coefficients = coeffs;
+        state.toneFilter.setLowPass (processingRate, freq, 0.7f);
+}
+
+void GRDBiteShaperAudioProcessor::updateOversampling()
+{
+    oversampler.update (isNonRealtime(), currentSampleRate, { &mixAmount });
+
+    latency.setStage (0, oversampler.getLatencySamples(), oversampler.getLatencySamples());
+    latency.update();
 }
 
 GRDBiteShaperAudioProcessorEditor::GRDBiteShaperAudioProcessorEditor (GRDBiteShaperAudioProcessor& processor)
-    : juce::AudioProcessorEditor (&processor), processorRef (processor)
+    : juce::AudioProcessorEditor (&processor), processorRef (processor),
+      oversamplingSelector (processor.getValueTreeState())
 {
     auto make = [this](juce::Slider& slider, const juce::String& label) { initSlider (slider, label); };
     make (biteSlider, "Bite");
@@ -148,7 +212,8 @@ GRDBiteShaperAudioProcessorEditor::GRDBiteShaperAudioProcessorEditor (GRDBiteSha
     for (int i = 0; i < ids.size(); ++i)
         attachments.push_back (std::make_unique<SliderAttachment> (state, ids[i], *sliders[i]));
 
-    setSize (640, 260);
+    addAndMakeVisible (oversamplingSelector);
+    setSize (640, 290);
 }
 
 void GRDBiteShaperAudioProcessorEditor::initSlider (juce::Slider& slider, const juce::String& label)
@@ -170,6 +235,7 @@ void GRDBiteShaperAudioProcessorEditor::paint (juce::Graphics& g)
 void GRDBiteShaperAudioProcessorEditor::resized()
 {
     auto area = getLocalBounds().reduced (10);
+    oversamplingSelector.setBounds (area.removeFromBottom (28).removeFromRight (400));
     auto width = area.getWidth() / 5;
 
     biteSlider.setBounds (area.removeFromLeft (width).reduced (8));
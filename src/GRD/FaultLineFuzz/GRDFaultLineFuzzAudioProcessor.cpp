@@ -10,6 +10,21 @@ constexpr auto paramTone      = "tone";
 constexpr auto paramOutput    = "output_trim";
 constexpr auto paramBypass    = "ui_bypass";
 constexpr auto kStateId       = "FAULT_LINE_FUZZ";
+
+using Param = GRDFaultLineFuzzAudioProcessor::Param;
+using Spec = gls::ParameterSpec;
+
+constexpr std::array<Spec, (size_t) Param::count> parameterTable {{
+    Spec::range  (paramInputTrim, "Input Trim",  -24.0f, 24.0f,    0.1f,    0.0f),
+    Spec::range  (paramFuzz,      "Fuzz",        0.0f,   1.0f,     0.0001f, 0.7f),
+    Spec::range  (paramBias,      "Bias",        -1.0f,  1.0f,     0.0001f, 0.0f),
+    Spec::range  (paramGate,      "Gate",        0.0f,   1.0f,     0.0001f, 0.3f),
+    Spec::range  (paramTone,      "Tone",        400.0f, 12000.0f, 1.0f,    4500.0f, 0.45f),
+    Spec::range  (paramOutput,    "Output Trim", -24.0f, 24.0f,    0.1f,    0.0f),
+    Spec::toggle (paramBypass,    "Soft Bypass", false)
+}};
+
+static_assert (gls::hasUniqueIds (parameterTable));
 }
 
 const std::array<GRDFaultLineFuzzAudioProcessor::Preset, 3> GRDFaultLineFuzzAudioProcessor::presetBank {{
@@ -46,25 +61,43 @@ GRDFaultLineFuzzAudioProcessor::GRDFaultLineFuzzAudioProcessor()
     : DualPrecisionAudioProcessor (BusesProperties()
                         .withInput  ("Input", juce::AudioChannelSet::stereo(), true)
                         .withOutput ("Output", juce::AudioChannelSet::stereo(), true)),
-      apvts (*this, nullptr, kStateId, createParameterLayout())
+      apvts (*this, nullptr, kStateId, createParameterLayout()),
+      params (apvts, parameterTable)
 {
+    oversampler.attach (apvts);
+    bypass.snapOnResume ({ &outputTrimGain });
 }
 
-void GRDFaultLineFuzzAudioProcessor::prepareToPlay (double sampleRate, int /*samplesPerBlock*/)
+void GRDFaultLineFuzzAudioProcessor::prepareToPlay (double sampleRate, int samplesPerBlock)
 {
+    DualPrecisionAudioProcessor::prepareToPlay (sampleRate, samplesPerBlock);
+
     currentSampleRate = juce::jmax (44100.0, sampleRate);
-    processingBuffer.setSize (getTotalNumOutputChannels(), 0);
     toneFilters.clear();
     gateState.assign ((size_t) getTotalNumOutputChannels(), 0.0f);
+    ensureStateSize (juce::jmax (1, getTotalNumInputChannels(), getTotalNumOutputChannels()));
+
+    oversampler.prepare (juce::jmax (1, getTotalNumOutputChannels()), samplesPerBlock);
+    bypass.prepare (currentSampleRate, juce::jmax (getTotalNumInputChannels(), getTotalNumOutputChannels()), samplesPerBlock,
+                    oversampler.getMaximumLatencySamples());
+
+    for (auto* smoother : { &inputTrimGain, &outputTrimGain })
+        smoother->prepare (currentSampleRate, samplesPerBlock);
+
+    latency.invalidate();
+    updateOversampling();
 }
 
 void GRDFaultLineFuzzAudioProcessor::releaseResources()
 {
 }
 
-void GRDFaultLineFuzzAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer,
-                                                   juce::MidiBuffer&)
+void GRDFaultLineFuzzAudioProcessor::processFloat (juce::AudioBuffer<float>& buffer,
+                                                   juce::MidiBuffer& midi)
 {
+    if (renderInPreparedChunks (buffer, midi))
+        return;
+
     juce::ScopedNoDenormals noDenormals;
 
     const auto totalIn  = getTotalNumInputChannels();
@@ -72,58 +105,63 @@ void GRDFaultLineFuzzAudioProcessor::processBlock (juce::AudioBuffer<float>& buf
     for (int ch = totalIn; ch < totalOut; ++ch)
         buffer.clear (ch, 0, buffer.getNumSamples());
 
-    ensureStateSize (buffer.getNumChannels(), buffer.getNumSamples());
-    processingBuffer.makeCopyOf (buffer, true);
+    ensureStateSize (buffer.getNumChannels());
+
+    const auto fuzz      = juce::jlimit (0.0f, 1.0f, params[Param::fuzz]);
+    const auto bias      = juce::jlimit (-1.0f, 1.0f, params[Param::bias]);
+    const auto gate      = juce::jlimit (0.0f, 1.0f, params[Param::gate]);
+    const auto toneHz    = params[Param::tone];
+    const bool bypassed  = params.isOn (Param::bypass);
 
-    const auto inputDb   = apvts.getRawParameterValue (paramInputTrim)->load();
-    const auto fuzz      = juce::jlimit (0.0f, 1.0f, apvts.getRawParameterValue (paramFuzz)->load());
-    const auto bias      = juce::jlimit (-1.0f, 1.0f, apvts.getRawParameterValue (paramBias)->load());
-    const auto gate      = juce::jlimit (0.0f, 1.0f, apvts.getRawParameterValue (paramGate)->load());
-    const auto toneHz    = apvts.getRawParameterValue (paramTone)->load();
-    const auto outputDb  = apvts.getRawParameterValue (paramOutput)->load();
-    const bool bypassed  = apvts.getRawParameterValue (paramBypass)->load() > 0.5f;
+    updateOversampling();
+    const auto factor = oversampler.getFactor();
 
-    const auto inGain  = juce::Decibels::decibelsToGain (inputDb);
-    const auto outGain = juce::Decibels::decibelsToGain (outputDb);
+    // The gate release is a per-sample coefficient, so it is stretched to keep its time at any factor.
     const float gateThreshold = juce::jmap (gate, 0.02f, 0.3f);
-    const float gateRelease   = juce::jmap (gate, 0.1f, 0.6f);
+    const float gateRelease   = std::pow (juce::jmap (gate, 0.1f, 0.6f), 1.0f / (float) factor);
 
-    auto toneCoeffs = juce::dsp::IIR::Coefficients<float>::makeLowPass (currentSampleRate,
-                                                                        juce::jlimit (400.0f, 12000.0f, toneHz),
-                                                                        0.707f);
+    const auto toneFreq = juce::jlimit (400.0f, 12000.0f, toneHz);
     for (auto& filter : toneFilters)
-        filter.coefficients = toneCoeffs;
+        filter.setLowPass (currentSampleRate * factor, toneFreq, 0.707f);
 
     const float fuzzDrive = juce::jmap (fuzz, 2.0f, 40.0f);
 
-    if (bypassed)
-    {
-        buffer.applyGain (outGain);
+    const int numSamples = buffer.getNumSamples();
+    inputTrimGain.update();
+    outputTrimGain.update();
+
+    inputTrimGain.applyGain (buffer, numSamples);
+
+    if (! bypass.begin (buffer, numSamples, bypassed))
         return;
-    }
 
-    for (int ch = 0; ch < buffer.getNumChannels(); ++ch)
+    oversampler.process (buffer, [&] (juce::dsp::AudioBlock<float>& block)
     {
-        auto* writePtr = buffer.getWritePointer (ch);
-        auto* procPtr  = processingBuffer.getWritePointer (ch);
-        float& gateEnv = gateState[(size_t) ch];
-        auto& toneFilter = toneFilters[(size_t) ch];
-
-        for (int sample = 0; sample < buffer.getNumSamples(); ++sample)
+        for (size_t ch = 0; ch < block.getNumChannels(); ++ch)
         {
-            float x = procPtr[sample] * inGain;
-            const float biased = x + bias * 0.5f;
-            const float fuzzed = juce::dsp::FastMathApproximations::tanh (biased * fuzzDrive);
-
-            const float level = std::abs (fuzzed);
-            gateEnv = level > gateEnv ? level : gateEnv * gateRelease + level * (1.0f - gateRelease);
-            const float gateGain = (gateEnv < gateThreshold) ? juce::jmap (gateEnv / gateThreshold, 0.0f, 1.0f, 0.0f, 1.0f)
-                                                             : 1.0f;
-
-            float toned = toneFilter.processSample (fuzzed * gateGain);
-            writePtr[sample] = toned * outGain;
+            auto* writePtr = block.getChannelPointer (ch);
+            float& gateEnv = gateState[ch];
+            auto& toneFilter = toneFilters[ch];
+
+            for (size_t sample = 0; sample < block.getNumSamples(); ++sample)
+            {
+                float x = writePtr[sample];
+                const float biased = x + bias * 0.5f;
+                const float fuzzed = juce::dsp::FastMathApproximations::tanh (biased * fuzzDrive);
+
+                const float level = std::abs (fuzzed);
+                gateEnv = level > gateEnv ? level : gateEnv * gateRelease + level * (1.0f - gateRelease);
+                const float gateGain = (gateEnv < gateThreshold) ? juce::jmap (gateEnv / gateThreshold, 0.0f, 1.0f, 0.0f, 1.0f)
+                                                                 : 1.0f;
+
+                float toned = toneFilter.processSample (fuzzed * gateGain);
+                writePtr[sample] = toned;
+            }
         }
-    }
+    });
+
+    outputTrimGain.applyGain (buffer, numSamples);
+    bypass.end (buffer, numSamples);
 }
 
 void GRDFaultLineFuzzAudioProcessor::getStateInformation (juce::MemoryBlock& destData)
@@ -143,42 +181,14 @@ juce::AudioProcessorValueTreeState::ParameterLayout
 GRDFaultLineFuzzAudioProcessor::createParameterLayout()
 {
     std::vector<std::unique_ptr<juce::RangedAudioParameter>> params;
-
-    params.push_back (std::make_unique<juce::AudioParameterFloat> (
-        paramInputTrim, "Input Trim",
-        juce::NormalisableRange<float> (-24.0f, 24.0f, 0.1f), 0.0f));
-
-    params.push_back (std::make_unique<juce::AudioParameterFloat> (
-        paramFuzz, "Fuzz",
-        juce::NormalisableRange<float> (0.0f, 1.0f, 0.0001f), 0.7f));
-
-    params.push_back (std::make_unique<juce::AudioParameterFloat> (
-        paramBias, "Bias",
-        juce::NormalisableRange<float> (-1.0f, 1.0f, 0.0001f), 0.0f));
-
-    params.push_back (std::make_unique<juce::AudioParameterFloat> (
-        paramGate, "Gate",
-        juce::NormalisableRange<float> (0.0f, 1.0f, 0.0001f), 0.3f));
-
-    params.push_back (std::make_unique<juce::AudioParameterFloat> (
-        paramTone, "Tone",
-        juce::NormalisableRange<float> (400.0f, 12000.0f, 1.0f, 0.45f), 4500.0f));
-
-    params.push_back (std::make_unique<juce::AudioParameterFloat> (
-        paramOutput, "Output Trim",
-        juce::NormalisableRange<float> (-24.0f, 24.0f, 0.1f), 0.0f));
-    params.push_back (std::make_unique<juce::AudioParameterBool> (
-        paramBypass, "Soft Bypass", false));
+    gls::addParameters (params, parameterTable);
+    gls::dsp::Oversampler<float>::addParameters (params);
 
     return { params.begin(), params.end() };
 }
 
-void GRDFaultLineFuzzAudioProcessor::ensureStateSize (int numChannels, int numSamples)
+void GRDFaultLineFuzzAudioProcessor::ensureStateSize (int numChannels)
 {
-    if ((int) processingBuffer.getNumChannels() != numChannels
-        || processingBuffer.getNumSamples() != numSamples)
-        processingBuffer.setSize (numChannels, numSamples, false, false, true);
-
     if ((int) gateState.size() < numChannels)
         gateState.resize ((size_t) numChannels, 0.0f);
 
@@ -190,6 +200,14 @@ void GRDFaultLineFuzzAudioProcessor::ensureStateSize (int numChannels, int numSa
     }
 }
 
+void GRDFaultLineFuzzAudioProcessor::updateOversampling()
+{
+    oversampler.update (isNonRealtime());
+    latency.setStage (0, oversampler.getLatencySamples(), oversampler.getLatencySamples());
+    latency.update();
+    bypass.setLatency (oversampler.getLatencySamples());
+}
+
 juce::AudioProcessorEditor* GRDFaultLineFuzzAudioProcessor::createEditor()
 {
     return new GRDFaultLineFuzzAudioProcessorEditor (*this);
@@ -199,7 +217,8 @@ juce::AudioProcessorEditor* GRDFaultLineFuzzAudioProcessor::createEditor()
 GRDFaultLineFuzzAudioProcessorEditor::GRDFaultLineFuzzAudioProcessorEditor (GRDFaultLineFuzzAudioProcessor& p)
     : juce::AudioProcessorEditor (&p), processorRef (p),
       accentColour (gls::ui::accentForFamily ("GRD")),
-      headerComponent ("GRD.FaultLineFuzz", "Fault Line Fuzz")
+      headerComponent ("GRD.FaultLineFuzz", "Fault Line Fuzz"),
+      oversamplingSelector (p.getValueTreeState())
 {
     lookAndFeel.setAccentColour (accentColour);
     setLookAndFeel (&lookAndFeel);
@@ -225,6 +244,7 @@ GRDFaultLineFuzzAudioProcessorEditor::GRDFaultLineFuzzAudioProcessorEditor (GRDF
     attachments.push_back (std::make_unique<SliderAttachment> (state, paramTone, toneSlider));
     attachments.push_back (std::make_unique<SliderAttachment> (state, paramOutput, outputTrimSlider));
     bypassAttachment = std::make_unique<juce::AudioProcessorValueTreeState::ButtonAttachment> (state, paramBypass, bypassButton);
+    addAndMakeVisible (oversamplingSelector);
 
     setSize (740, 420);
 }
@@ -257,7 +277,9 @@ void GRDFaultLineFuzzAudioProcessorEditor::resized()
     toneSlider      .setBounds (bottom.removeFromLeft (bottomWidth).reduced (8));
     outputTrimSlider.setBounds (bottom.removeFromLeft (bottomWidth).reduced (8));
 
-    bypassButton.setBounds (footerComponent.getBounds().reduced (24, 12));
+    auto footer = footerComponent.getBounds().reduced (24, 12);
+    oversamplingSelector.setBounds (footer.removeFromRight (300));
+    bypassButton.setBounds (footer);
     layoutLabels();
 }
 
@@ -3,17 +3,29 @@
 #include <JuceHeader.h>
 #include <array>
 #include "../../DualPrecisionAudioProcessor.h"
+#include "../../ParameterTable.h"
+#include "../../SmoothedParameter.h"
+#include "../../dsp/Biquad.h"
+#include "../../dsp/LatencyReporter.h"
+#include "../../dsp/Oversampler.h"
+#include "../../dsp/SoftBypass.h"
 #include "../../ui/GoodluckLookAndFeel.h"
+#include "../../ui/OversamplingSelector.h"
 
 class GRDFaultLineFuzzAudioProcessor : public DualPrecisionAudioProcessor
 {
 public:
+    enum class Param
+    {
+        inputTrim, fuzz, bias, gate, tone, outputTrim, bypass,
+        count
+    };
+
     GRDFaultLineFuzzAudioProcessor();
     ~GRDFaultLineFuzzAudioProcessor() override = default;
 
     void prepareToPlay (double sampleRate, int samplesPerBlock) override;
     void releaseResources() override;
-    void processBlock (juce::AudioBuffer<float>&, juce::MidiBuffer&) override;
 
     juce::AudioProcessorEditor* createEditor() override;
     bool hasEditor() const override { return true; }
@@ -22,7 +34,6 @@ public:
     bool acceptsMidi() const override { return false; }
     bool producesMidi() const override { return false; }
     bool isMidiEffect() const override { return false; }
-    double getTailLengthSeconds() const override { return 0.0; }
 
     int getNumPrograms() override;
     int getCurrentProgram() override { return currentPreset; }
@@ -36,12 +47,20 @@ public:
     juce::AudioProcessorValueTreeState& getValueTreeState() { return apvts; }
     static juce::AudioProcessorValueTreeState::ParameterLayout createParameterLayout();
 
+protected:
+    void processFloat (juce::AudioBuffer<float>&, juce::MidiBuffer&) override;
+
 private:
     juce::AudioProcessorValueTreeState apvts;
+    gls::ParameterHandles<Param> params;
+    gls::SmoothedParameter inputTrimGain  { params, Param::inputTrim,   gls::SmoothedParameter::Mapping::decibels };
+    gls::SmoothedParameter outputTrimGain { params, Param::outputTrim,  gls::SmoothedParameter::Mapping::decibels };
+    gls::dsp::SoftBypass bypass;
     double currentSampleRate = 44100.0;
-    juce::AudioBuffer<float> processingBuffer;
-    std::vector<juce::dsp::IIR::Filter<float>> toneFilters;
+    std::vector<gls::dsp::Biquad> toneFilters;
     std::vector<float> gateState;
+    gls::dsp::Oversampler<float> oversampler;
+    gls::dsp::LatencyReporter latency { *this };
     int currentPreset = 0;
 
     struct Preset
@@ -52,8 +71,9 @@ private:
 
     static const std::array<Preset, 3> presetBank;
 
-    void ensureStateSize (int numChannels, int numSamples);
+    void ensureStateSize (int numChannels);
     void applyPreset (int index);
+    void updateOversampling();
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (GRDFaultLineFuzzAudioProcessor)
 };
@@ -82,6 +102,7 @@ private:
     juce::Slider toneSlider;
     juce::Slider outputTrimSlider;
     juce::ToggleButton bypassButton { "Soft Bypass" };
+    gls::ui::OversamplingSelector oversamplingSelector;
 
     using SliderAttachment = juce::AudioProcessorValueTreeState::SliderAttachment;
     std::vector<std::unique_ptr<SliderAttachment>> attachments;
@@ -1,27 +1,57 @@
 #include "GRDIronBusAudioProcessor.h"
 
+namespace
+{
+using Param = GRDIronBusAudioProcessor::Param;
+using Spec = gls::ParameterSpec;
+
+constexpr std::array<Spec, (size_t) Param::count> parameterTable {{
+    Spec::range ("drive",       "Drive",       0.0f,   1.0f,   0.001f, 0.6f),
+    Spec::range ("glue",        "Glue",        0.0f,   1.0f,   0.001f, 0.5f),
+    Spec::range ("hpf",         "High-Pass",   20.0f,  200.0f, 0.01f,  70.0f, 0.4f),
+    Spec::range ("tilt",        "Tilt",        -1.0f,  1.0f,   0.001f, 0.0f),
+    Spec::range ("mix",         "Mix",         0.0f,   1.0f,   0.001f, 0.65f),
+    Spec::range ("output_trim", "Output Trim", -12.0f, 12.0f,  0.01f,  0.0f)
+}};
+
+static_assert (gls::hasUniqueIds (parameterTable));
+} // namespace
+
 GRDIronBusAudioProcessor::GRDIronBusAudioProcessor()
     : DualPrecisionAudioProcessor (BusesProperties()
                         .withInput  ("Input", juce::AudioChannelSet::stereo(), true)
                         .withOutput ("Output", juce::AudioChannelSet::stereo(), true)),
-      apvts (*this, nullptr, "IRON_BUS", createParameterLayout())
+      apvts (*this, nullptr, "IRON_BUS", createParameterLayout()),
+      params (apvts, parameterTable)
 {
+    oversampler.attach (apvts);
 }
 
 void GRDIronBusAudioProcessor::prepareToPlay (double sampleRate, int samplesPerBlock)
 {
+    DualPrecisionAudioProcessor::prepareToPlay (sampleRate, samplesPerBlock);
+
     currentSampleRate = sampleRate > 0.0 ? sampleRate : 44100.0;
     lastBlockSize = (juce::uint32) juce::jmax (1, samplesPerBlock);
     ensureStateSize (juce::jmax (1, getTotalNumOutputChannels()));
+
+    oversampler.prepare (juce::jmax (1, getTotalNumOutputChannels()), samplesPerBlock);
+    mixAmount.prepare (currentSampleRate * oversampler.getFactor(), samplesPerBlock << gls::dsp::Oversampler<float>::maxFactorLog2);
+    outputTrimGain.prepare (currentSampleRate, samplesPerBlock);
+    latency.invalidate();
+    updateOversampling();
 }
 
 void GRDIronBusAudioProcessor::releaseResources()
 {
 }
 
-void GRDIronBusAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer,
-                                             juce::MidiBuffer&)
+void GRDIronBusAudioProcessor::processFloat (juce::AudioBuffer<float>& buffer,
+                                             juce::MidiBuffer& midi)
 {
+    if (renderInPreparedChunks (buffer, midi))
+        return;
+
     juce::ScopedNoDenormals noDenormals;
 
     const auto totalIn  = getTotalNumInputChannels();
@@ -34,40 +64,47 @@ void GRDIronBusAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer,
     if (numChannels == 0 || numSamples == 0)
         return;
 
-    auto get = [this](const char* id) { return apvts.getRawParameterValue (id)->load(); };
-
-    const float drive   = juce::jlimit (0.0f, 1.0f, get ("drive"));
-    const float glue    = juce::jlimit (0.0f, 1.0f, get ("glue"));
-    const float hpf     = juce::jlimit (20.0f, 200.0f, get ("hpf"));
-    const float tilt    = juce::jlimit (-1.0f, 1.0f, get ("tilt"));
-    const float mix     = juce::jlimit (0.0f, 1.0f, get ("mix"));
-    const float trimDb  = juce::jlimit (-12.0f, 12.0f, get ("output_trim"));
-    const float trimGain= juce::Decibels::decibelsToGain (trimDb);
+    const float drive   = juce::jlimit (0.0f, 1.0f, params[Param::drive]);
+    const float glue    = juce::jlimit (0.0f, 1.0f, params[Param::glue]);
+    const float hpf     = juce::jlimit (20.0f, 200.0f, params[Param::hpf]);
+    const float tilt    = juce::jlimit (-1.0f, 1.0f, params[Param::tilt]);
 
     ensureStateSize (numChannels);
-    updateFilters (hpf, tilt);
+    updateOversampling();
+    updateFilters (hpf, tilt, currentSampleRate * oversampler.getFactor());
 
     const float driveGain = 1.0f + drive * 8.0f;
 
-    juce::AudioBuffer<float> dry;
-    dry.makeCopyOf (buffer, true);
+    mixAmount.update();
+    outputTrimGain.update();
 
-    for (int ch = 0; ch < numChannels; ++ch)
+    oversampler.process (buffer, [&] (juce::dsp::AudioBlock<float>& block)
     {
-        auto* data = buffer.getWritePointer (ch);
-        auto& state = channelState[ch];
+        const auto blockSamples = (int) block.getNumSamples();
+        const auto* mixes = mixAmount.advance (blockSamples);
+        const float mix = mixAmount.getCurrentValue();
 
-        for (int i = 0; i < numSamples; ++i)
+        for (size_t ch = 0; ch < block.getNumChannels(); ++ch)
         {
-            float sample = data[i];
-            sample = state.hpFilter.processSample (sample);
-            sample = state.tiltFilter.processSample (sample);
-
-            const float clipped = std::tanh (sample * driveGain);
-            const float blended = juce::jmap (glue, sample, clipped);
-            data[i] = juce::jmap (mix, dry.getSample (ch, i), blended) * trimGain;
+            auto* data = block.getChannelPointer (ch);
+            auto& state = channelState[ch];
+
+            for (int i = 0; i < blockSamples; ++i)
+            {
+                const float input = data[i];
+                float sample = input;
+                sample = state.hpFilter.processSample (sample);
+                sample = state.tiltFilter.processSample (sample);
+
+                const float clipped = std::tanh (sample * driveGain);
+                const float blended = juce::jmap (glue, sample, clipped);
+                data[i] = juce::jmap (mixes != nullptr ? mixes[i] : mix, input, blended);
+            }
         }
-    }
+    });
+
+    // The trim is linear, so it runs at the host rate after the oversampler.
+    outputTrimGain.applyGain (buffer, numSamples);
 }
 
 void GRDIronBusAudioProcessor::getStateInformation (juce::MemoryBlock& destData)
@@ -87,19 +124,8 @@ juce::AudioProcessorValueTreeState::ParameterLayout
 GRDIronBusAudioProcessor::createParameterLayout()
 {
     std::vector<std::unique_ptr<juce::RangedAudioParameter>> params;
-
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("drive", "Drive",
-                                                                   juce::NormalisableRange<float> (0.0f, 1.0f, 0.001f), 0.6f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("glue", "Glue",
-                                                                   juce::NormalisableRange<float> (0.0f, 1.0f, 0.001f), 0.5f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("hpf", "High-Pass",
-                                                                   juce::NormalisableRange<float> (20.0f, 200.0f, 0.01f, 0.4f), 70.0f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("tilt", "Tilt",
-                                                                   juce::NormalisableRange<float> (-1.0f, 1.0f, 0.001f), 0.0f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("mix", "Mix",
-                                                                   juce::NormalisableRange<float> (0.0f, 1.0f, 0.001f), 0.65f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("output_trim", "Output Trim",
-                                                                   juce::NormalisableRange<float> (-12.0f, 12.0f, 0.01f), 0.0f));
+    gls::addParameters (params, parameterTable);
+    gls::dsp::Oversampler<float>::addParameters (params);
 
     return { params.begin(), params.end() };
 }
@@ -128,26 +154,33 @@ void GRDIronBusAudioProcessor::ensureStateSize (int numChannels)
     }
 }
 
-void GRDIronBusAudioProcessor::updateFilters (float hpfHz, float tilt)
+void GRDIronBusAudioProcessor::updateFilters (float hpfHz, float tilt, double processingRate)
 {
-    if (currentSampleRate <= 0.0)
+    if (processingRate <= 0.0)
         return;
 
-    auto hp = juce::dsp::IIR::Coefficients<float>::makeHighPass (currentSampleRate,
-                                                                 juce::jlimit (20.0f, 250.0f, hpfHz), 0.7f);
     const float tiltFreq = juce::jmap (tilt, -1.0f, 1.0f, 600.0f, 6000.0f);
-    auto tiltCoeffs = juce::dsp::IIR::Coefficients<float>::makeLowPass (currentSampleRate,
-                                                                        juce::jlimit (200.0f, (float) (currentSampleRate * 0.49f), tiltFreq), 0.5f);
+    const float hpFreq = juce::jlimit (20.0f, 250.0f, hpfHz);
+    const float lpFreq = juce::jlimit (200.0f, (float) (currentSampleRate * 0.49f), tiltFreq);
 
     for (auto& state : channelState)
     {
-        state.hpFilter.coefficients = hp;
-        state.tiltFilter.coefficients = tiltCoeffs;
+        state.hpFilter.setHighPass (processingRate, hpFreq, 0.7f);
+        state.tiltFilter.setLowPass (processingRate, lpFreq, 0.5f);
     }
 }
 
+void GRDIronBusAudioProcessor::updateOversampling()
+{
+    oversampler.update (isNonRealtime(), currentSampleRate, { &mixAmount });
+
+    latency.setStage (0, oversampler.getLatencySamples(), oversampler.getLatencySamples());
+    latency.update();
+}
+
 GRDIronBusAudioProcessorEditor::GRDIronBusAudioProcessorEditor (GRDIronBusAudioProcessor& processor)
-    : juce::AudioProcessorEditor (&processor), processorRef (processor)
+    : juce::AudioProcessorEditor (&processor), processorRef (processor),
+      oversamplingSelector (processor.getValueTreeState())
 {
     auto make = [this](juce::Slider& slider, const juce::String& label) { initSlider (slider, label); };
     make (driveSlider, "Drive");
@@ -164,7 +197,8 @@ GRDIronBusAudioProcessorEditor::GRDIronBusAudioProcessorEditor (GRDIronBusAudioP
     for (int i = 0; i < ids.size(); ++i)
         attachments.push_back (std::make_unique<SliderAttachment> (state, ids[i], *sliders[i]));
 
-    setSize (720, 280);
+    addAndMakeVisible (oversamplingSelector);
+    setSize (720, 310);
 }
 
 void GRDIronBusAudioProcessorEditor::initSlider (juce::Slider& slider, const juce::String& label)
@@ -186,6 +220,7 @@ void GRDIronBusAudioProcessorEditor::paint (juce::Graphics& g)
 void GRDIronBusAudioProcessorEditor::resized()
 {
     auto area = getLocalBounds().reduced (10);
+    oversamplingSelector.setBounds (area.removeFromBottom (28).removeFromRight (300));
     auto width = area.getWidth() / 6;
 
     driveSlider.setBounds (area.removeFromLeft (width).reduced (8));
@@ -1,17 +1,29 @@
 #pragma once
 
 #include <JuceHeader.h>
+#include <array>
 #include "../../DualPrecisionAudioProcessor.h"
+#include "../../ParameterTable.h"
+#include "../../SmoothedParameter.h"
+#include "../../dsp/Biquad.h"
+#include "../../dsp/LatencyReporter.h"
+#include "../../dsp/Oversampler.h"
+#include "../../ui/OversamplingSelector.h"
 
 class GRDIronBusAudioProcessor : public DualPrecisionAudioProcessor
 {
 public:
+    enum class Param
+    {
+        drive, glue, hpf, tilt, mix, outputTrim,
+        count
+    };
+
     GRDIronBusAudioProcessor();
     ~GRDIronBusAudioProcessor() override = default;
 
     void prepareToPlay (double sampleRate, int samplesPerBlock) override;
     void releaseResources() override;
-    void processBlock (juce::AudioBuffer<float>&, juce::MidiBuffer&) override;
 
     juce::AudioProcessorEditor* createEditor() override;
     bool hasEditor() const override { return true; }
@@ -20,7 +32,6 @@ public:
     bool acceptsMidi() const override { return false; }
     bool producesMidi() const override { return false; }
     bool isMidiEffect() const override { return false; }
-    double getTailLengthSeconds() const override { return 0.0; }
 
     int getNumPrograms() override { return 1; }
     int getCurrentProgram() override { return 0; }
@@ -34,22 +45,32 @@ public:
     juce::AudioProcessorValueTreeState& getValueTreeState() { return apvts; }
     static juce::AudioProcessorValueTreeState::ParameterLayout createParameterLayout();
 
+protected:
+    void processFloat (juce::AudioBuffer<float>&, juce::MidiBuffer&) override;
+
 private:
     struct ChannelState
     {
-        juce::dsp::IIR::Filter<float> hpFilter;
-        juce::dsp::IIR::Filter<float> tiltFilter;
+        gls::dsp::Biquad hpFilter;
+        gls::dsp::Biquad tiltFilter;
     };
 
     juce::AudioProcessorValueTreeState apvts;
+
+    gls::ParameterHandles<Param> params;
+    gls::SmoothedParameter mixAmount      { params, Param::mix };
+    gls::SmoothedParameter outputTrimGain { params, Param::outputTrim,  gls::SmoothedParameter::Mapping::decibels };
     std::vector<ChannelState> channelState;
+    gls::dsp::Oversampler<float> oversampler;
+    gls::dsp::LatencyReporter latency { *this };
     double currentSampleRate = 44100.0;
     juce::uint32 lastBlockSize = 512;
     double filterSpecSampleRate = 0.0;
     juce::uint32 filterSpecBlockSize = 0;
 
     void ensureStateSize (int numChannels);
-    void updateFilters (float hpfHz, float tilt);
+    void updateFilters (float hpfHz, float tilt, double processingRate);
+    void updateOversampling();
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (GRDIronBusAudioProcessor)
 };
@@ -72,6 +93,7 @@ private:
     juce::Slider tiltSlider;
     juce::Slider mixSlider;
     juce::Slider trimSlider;
+    gls::ui::OversamplingSelector oversamplingSelector;
 
     using SliderAttachment = juce::AudioProcessorValueTreeState::SliderAttachment;
     std::vector<std::unique_ptr<SliderAttachment>> attachments;
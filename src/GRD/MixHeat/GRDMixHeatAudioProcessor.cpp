@@ -10,6 +10,21 @@ constexpr auto paramMix    = "mix";
 constexpr auto paramInput  = "input_trim";
 constexpr auto paramOutput = "output_trim";
 constexpr auto paramBypass = "ui_bypass";
+
+using Param = GRDMixHeatAudioProcessor::Param;
+using Spec = gls::ParameterSpec;
+
+constexpr std::array<Spec, (size_t) Param::count> parameterTable {{
+    Spec::choice (paramMode,   "Mode",        "Clean|Tape|Triode", 0),
+    Spec::range  (paramDrive,  "Drive",       0.0f,   1.0f,  0.001f, 0.5f),
+    Spec::range  (paramTone,   "Tone",        -1.0f,  1.0f,  0.001f, 0.0f),
+    Spec::range  (paramMix,    "Mix",         0.0f,   1.0f,  0.001f, 0.5f),
+    Spec::range  (paramInput,  "Input Trim",  -18.0f, 18.0f, 0.1f,   0.0f),
+    Spec::range  (paramOutput, "Output Trim", -18.0f, 18.0f, 0.1f,   0.0f),
+    Spec::toggle (paramBypass, "Soft Bypass", false)
+}};
+
+static_assert (gls::hasUniqueIds (parameterTable));
 }
 
 const std::array<GRDMixHeatAudioProcessor::Preset, 3> GRDMixHeatAudioProcessor::presetBank {{
@@ -46,23 +61,42 @@ GRDMixHeatAudioProcessor::GRDMixHeatAudioProcessor()
     : DualPrecisionAudioProcessor (BusesProperties()
                         .withInput  ("Input", juce::AudioChannelSet::stereo(), true)
                         .withOutput ("Output", juce::AudioChannelSet::stereo(), true)),
-      apvts (*this, nullptr, kStateId, createParameterLayout())
+      apvts (*this, nullptr, kStateId, createParameterLayout()),
+      params (apvts, parameterTable)
 {
+    oversampler.attach (apvts);
+    bypass.snapOnResume ({ &mixAmount, &outputTrimGain });
 }
 
-void GRDMixHeatAudioProcessor::prepareToPlay (double sampleRate, int /*samplesPerBlock*/)
+void GRDMixHeatAudioProcessor::prepareToPlay (double sampleRate, int samplesPerBlock)
 {
+    DualPrecisionAudioProcessor::prepareToPlay (sampleRate, samplesPerBlock);
+
     currentSampleRate = juce::jmax (sampleRate, 44100.0);
     toneFilter.reset();
+
+    oversampler.prepare (juce::jmax (1, getTotalNumOutputChannels()), samplesPerBlock);
+    bypass.prepare (currentSampleRate, juce::jmax (getTotalNumInputChannels(), getTotalNumOutputChannels()), samplesPerBlock,
+                    oversampler.getMaximumLatencySamples());
+    mixAmount.prepare (currentSampleRate * oversampler.getFactor(), samplesPerBlock << gls::dsp::Oversampler<float>::maxFactorLog2);
+
+    for (auto* smoother : { &inputTrimGain, &outputTrimGain })
+        smoother->prepare (currentSampleRate, samplesPerBlock);
+
+    latency.invalidate();
+    updateOversampling();
 }
 
 void GRDMixHeatAudioProcessor::releaseResources()
 {
 }
 
-void GRDMixHeatAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer,
-                                             juce::MidiBuffer&)
+void GRDMixHeatAudioProcessor::processFloat (juce::AudioBuffer<float>& buffer,
+                                             juce::MidiBuffer& midi)
 {
+    if (renderInPreparedChunks (buffer, midi))
+        return;
+
     juce::ScopedNoDenormals noDenormals;
 
     auto totalIn  = getTotalNumInputChannels();
@@ -70,40 +104,48 @@ void GRDMixHeatAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer,
     for (int ch = totalIn; ch < totalOut; ++ch)
         buffer.clear (ch, 0, buffer.getNumSamples());
 
-    auto get = [this](const char* id) { return apvts.getRawParameterValue (id)->load(); };
+    const int mode      = params.getIndex (Param::mode);
+    const float drive   = juce::jlimit (0.0f, 1.0f, params[Param::drive]);
+    const float tone    = juce::jlimit (-1.0f, 1.0f, params[Param::tone]);
+    const bool bypassed = params.isOn (Param::bypass);
 
-    const int mode      = (int) std::round (apvts.getRawParameterValue (paramMode)->load());
-    const float drive   = juce::jlimit (0.0f, 1.0f, get (paramDrive));
-    const float tone    = juce::jlimit (-1.0f, 1.0f, get (paramTone));
-    const float mix     = juce::jlimit (0.0f, 1.0f, get (paramMix));
-    const float inputGain  = juce::Decibels::decibelsToGain (get (paramInput));
-    const float outputGain = juce::Decibels::decibelsToGain (get (paramOutput));
-    const bool bypassed    = apvts.getRawParameterValue (paramBypass)->load() > 0.5f;
+    updateOversampling();
 
     const float toneFreq = juce::jmap (tone, -1.0f, 1.0f, 800.0f, 8000.0f);
-    auto coeffs = juce::dsp::IIR::Coefficients<float>::makeLowPass (currentSampleRate, toneFreq, 0.8f);
-    toneFilter.coefficients = coeffs;
+    toneFilter.setLowPass (currentSampleRate * oversampler.getFactor(), toneFreq, 0.8f);
 
     const float driveGain = driveToGain (drive);
+    const int numSamples = buffer.getNumSamples();
 
-    buffer.applyGain (inputGain);
-    if (bypassed)
-    {
-        buffer.applyGain (outputGain);
+    for (auto* smoother : { &inputTrimGain, &mixAmount, &outputTrimGain })
+        smoother->update();
+
+    inputTrimGain.applyGain (buffer, numSamples);
+
+    if (! bypass.begin (buffer, numSamples, bypassed))
         return;
-    }
 
-    for (int ch = 0; ch < buffer.getNumChannels(); ++ch)
+    oversampler.process (buffer, [&] (juce::dsp::AudioBlock<float>& block)
     {
-        auto* data = buffer.getWritePointer (ch);
-        for (int i = 0; i < buffer.getNumSamples(); ++i)
+        const auto* mixes = mixAmount.advance ((int) block.getNumSamples());
+        const float mix = mixAmount.getCurrentValue();
+
+        for (size_t ch = 0; ch < block.getNumChannels(); ++ch)
         {
-            const float dry = data[i];
-            float wet = applySaturation (dry * driveGain, drive, mode);
-            wet = toneFilter.processSample (wet);
-            data[i] = (wet * mix + dry * (1.0f - mix)) * outputGain;
+            auto* data = block.getChannelPointer (ch);
+            for (size_t i = 0; i < block.getNumSamples(); ++i)
+            {
+                const float dry = data[i];
+                float wet = applySaturation (dry * driveGain, drive, mode);
+                wet = toneFilter.processSample (wet);
+                const float amount = mixes != nullptr ? mixes[i] : mix;
+                data[i] = wet * amount + dry * (1.0f - amount);
+            }
         }
-    }
+    });
+
+    outputTrimGain.applyGain (buffer, numSamples);
+    bypass.end (buffer, numSamples);
 }
 
 void GRDMixHeatAudioProcessor::getStateInformation (juce::MemoryBlock& destData)
@@ -128,20 +170,8 @@ juce::AudioProcessorValueTreeState::ParameterLayout
 GRDMixHeatAudioProcessor::createParameterLayout()
 {
     std::vector<std::unique_ptr<juce::RangedAudioParameter>> params;
-
-    params.push_back (std::make_unique<juce::AudioParameterChoice>(paramMode, "Mode",
-                                                                   juce::StringArray { "Clean", "Tape", "Triode" }, 0));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> (paramDrive,  "Drive",
-                                                                   juce::NormalisableRange<float> (0.0f, 1.0f, 0.001f), 0.5f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> (paramTone,   "Tone",
-                                                                   juce::NormalisableRange<float> (-1.0f, 1.0f, 0.001f), 0.0f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> (paramMix,    "Mix",
-                                                                   juce::NormalisableRange<float> (0.0f, 1.0f, 0.001f), 0.5f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> (paramInput,  "Input Trim",
-                                                                   juce::NormalisableRange<float> (-18.0f, 18.0f, 0.1f), 0.0f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> (paramOutput, "Output Trim",
-                                                                   juce::NormalisableRange<float> (-18.0f, 18.0f, 0.1f), 0.0f));
-    params.push_back (std::make_unique<juce::AudioParameterBool>  (paramBypass, "Soft Bypass", false));
+    gls::addParameters (params, parameterTable);
+    gls::dsp::Oversampler<float>::addParameters (params);
 
     return { params.begin(), params.end() };
 }
@@ -184,11 +214,21 @@ void GRDMixHeatAudioProcessor::applyPreset (int index)
     }
 }
 
+void GRDMixHeatAudioProcessor::updateOversampling()
+{
+    oversampler.update (isNonRealtime(), currentSampleRate, { &mixAmount });
+
+    latency.setStage (0, oversampler.getLatencySamples(), oversampler.getLatencySamples());
+    latency.update();
+    bypass.setLatency (oversampler.getLatencySamples());
+}
+
 //==============================================================================
 GRDMixHeatAudioProcessorEditor::GRDMixHeatAudioProcessorEditor (GRDMixHeatAudioProcessor& p)
     : juce::AudioProcessorEditor (&p), processorRef (p),
       accentColour (gls::ui::accentForFamily ("GRD")),
-      headerComponent ("GRD.MixHeat", "Mix Heat")
+      headerComponent ("GRD.MixHeat", "Mix Heat"),
+      oversamplingSelector (p.getValueTreeState())
 {
     lookAndFeel.setAccentColour (accentColour);
     setLookAndFeel (&lookAndFeel);
@@ -217,6 +257,7 @@ GRDMixHeatAudioProcessorEditor::GRDMixHeatAudioProcessorEditor (GRDMixHeatAudioP
     sliderAttachments.push_back (std::make_unique<SliderAttachment> (state, paramOutput, outputTrimSlider));
     modeAttachment = std::make_unique<ComboAttachment> (state, paramMode, modeBox);
     bypassAttachment = std::make_unique<juce::AudioProcessorValueTreeState::ButtonAttachment> (state, paramBypass, bypassButton);
+    addAndMakeVisible (oversamplingSelector);
 
     setSize (720, 400);
 }
@@ -250,7 +291,9 @@ void GRDMixHeatAudioProcessorEditor::resized()
     inputTrimSlider .setBounds (bottom.removeFromLeft (bottomWidth).reduced (8));
     outputTrimSlider.setBounds (bottom.removeFromLeft (bottomWidth).reduced (8));
 
-    bypassButton.setBounds (footerComponent.getBounds().reduced (24, 12));
+    auto footer = footerComponent.getBounds().reduced (24, 12);
+    oversamplingSelector.setBounds (footer.removeFromRight (300));
+    bypassButton.setBounds (footer);
 }
 
 void GRDMixHeatAudioProcessorEditor::initSlider (juce::Slider& slider, const juce::String& label, bool macro)
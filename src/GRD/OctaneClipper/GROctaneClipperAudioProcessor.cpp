@@ -1,27 +1,59 @@
 #include "GROctaneClipperAudioProcessor.h"
 
+namespace
+{
+using Param = GROctaneClipperAudioProcessor::Param;
+using Spec = gls::ParameterSpec;
+
+constexpr std::array<Spec, (size_t) Param::count> parameterTable {{
+    Spec::range ("drive",       "Drive",       0.0f,   1.0f,   0.001f, 0.6f),
+    Spec::range ("clip_type",   "Clip Type",   0.0f,   2.0f,   0.01f,  1.0f),
+    Spec::range ("hp",          "High-Pass",   20.0f,  200.0f, 0.01f,  60.0f, 0.4f),
+    Spec::range ("mix",         "Mix",         0.0f,   1.0f,   0.001f, 0.7f),
+    Spec::range ("output_trim", "Output Trim", -12.0f, 12.0f,  0.01f,  0.0f)
+}};
+
+static_assert (gls::hasUniqueIds (parameterTable));
+} // namespace
+
 GROctaneClipperAudioProcessor::GROctaneClipperAudioProcessor()
     : DualPrecisionAudioProcessor (BusesProperties()
                         .withInput  ("Input", juce::AudioChannelSet::stereo(), true)
                         .withOutput ("Output", juce::AudioChannelSet::stereo(), true)),
-      apvts (*this, nullptr, "OCTANE_CLIPPER", createParameterLayout())
+      apvts (*this, nullptr, "OCTANE_CLIPPER", createParameterLayout()),
+      params (apvts, parameterTable),
+      adaaOrder (*apvts.getRawParameterValue (gls::dsp::AntiderivativeWaveshaper::orderParameterId))
 {
+    oversampler.attach (apvts);
 }
 
 void GROctaneClipperAudioProcessor::prepareToPlay (double sampleRate, int samplesPerBlock)
 {
+    DualPrecisionAudioProcessor::prepareToPlay (sampleRate, samplesPerBlock);
+
     currentSampleRate = sampleRate > 0.0 ? sampleRate : 44100.0;
     lastBlockSize = (juce::uint32) juce::jmax (1, samplesPerBlock);
     ensureStateSize (juce::jmax (1, getTotalNumOutputChannels()));
+
+    oversampler.prepare (juce::jmax (1, getTotalNumOutputChannels()), samplesPerBlock);
+    mixAmount.prepare (currentSampleRate * oversampler.getFactor(), samplesPerBlock << gls::dsp::Oversampler<float>::maxFactorLog2);
+    outputTrimGain.prepare (currentSampleRate, samplesPerBlock);
+    shaper.prepare (juce::jmax (1, getTotalNumOutputChannels()));
+    dryDelay.prepare (juce::jmax (1, getTotalNumOutputChannels()));
+    latency.invalidate();
+    updateOversampling();
 }
 
 void GROctaneClipperAudioProcessor::releaseResources()
 {
 }
 
-void GROctaneClipperAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer,
-                                                  juce::MidiBuffer&)
+void GROctaneClipperAudioProcessor::processFloat (juce::AudioBuffer<float>& buffer,
+                                                  juce::MidiBuffer& midi)
 {
+    if (renderInPreparedChunks (buffer, midi))
+        return;
+
     juce::ScopedNoDenormals noDenormals;
 
     const auto totalIn  = getTotalNumInputChannels();
@@ -34,44 +66,66 @@ void GROctaneClipperAudioProcessor::processBlock (juce::AudioBuffer<float>& buff
     if (numChannels == 0 || numSamples == 0)
         return;
 
-    auto get = [this](const char* id) { return apvts.getRawParameterValue (id)->load(); };
-
-    const float drive   = juce::jlimit (0.0f, 1.0f, get ("drive"));
-    const float clipSel = juce::jlimit (0.0f, 2.0f, get ("clip_type"));
-    const float hpCut   = juce::jlimit (20.0f, 200.0f, get ("hp"));
-    const float mix     = juce::jlimit (0.0f, 1.0f, get ("mix"));
-    const float trimDb  = juce::jlimit (-12.0f, 12.0f, get ("output_trim"));
-    const float trimGain= juce::Decibels::decibelsToGain (trimDb);
+    const float drive   = juce::jlimit (0.0f, 1.0f, params[Param::drive]);
+    const float clipSel = juce::jlimit (0.0f, 2.0f, params[Param::clipType]);
+    const float hpCut   = juce::jlimit (20.0f, 200.0f, params[Param::hp]);
 
     ensureStateSize (numChannels);
-    updateFilters (hpCut);
+    updateOversampling();
+    updateFilters (hpCut, currentSampleRate * oversampler.getFactor());
 
     const float driveGain = 1.0f + drive * 12.0f;
 
-    for (int ch = 0; ch < numChannels; ++ch)
+    using Shaper = gls::dsp::AntiderivativeWaveshaper;
+    using Lanes = Shaper::Lanes;
+    constexpr int lanes = Shaper::lanesPerGroup;
+
+    const auto order = Shaper::getOrder (adaaOrder);
+    shaper.setOrder (order);
+    shaper.setCurve (clipSel < 1.0f ? Shaper::Curve::hard
+                                    : clipSel < 2.0f ? Shaper::Curve::tanh : Shaper::Curve::expo);
+    dryDelay.setOrder (order);
+
+    mixAmount.update();
+    outputTrimGain.update();
+
+    oversampler.process (buffer, [&] (juce::dsp::AudioBlock<float>& block)
     {
-        auto* data = buffer.getWritePointer (ch);
-        auto& state = channelState[ch];
+        const auto blockSamples = (int) block.getNumSamples();
+        const auto* mixes = mixAmount.advance (blockSamples);
+        const float mix = mixAmount.getCurrentValue();
+        const auto blockChannels = juce::jmin ((int) block.getNumChannels(), shaper.getNumGroups() * lanes);
+        const auto numGroups = (blockChannels + lanes - 1) / lanes;
 
-        for (int i = 0; i < numSamples; ++i)
+        for (int i = 0; i < blockSamples; ++i)
         {
-            const float input = data[i];
-            float sample = state.hpFilter.processSample (input) * driveGain;
-            float clipped = 0.0f;
-
-            if (clipSel < 1.0f)
-                clipped = juce::jlimit (-1.0f, 1.0f, sample);
-            else if (clipSel < 2.0f)
-                clipped = std::tanh (sample);
-            else
+            for (int group = 0; group < numGroups; ++group)
             {
-                const float sign = sample >= 0.0f ? 1.0f : -1.0f;
-                clipped = sign * (1.0f - std::exp (-std::abs (sample)));
-            }
+                const int firstChannel = group * lanes;
+                const int groupChannels = juce::jmin (lanes, blockChannels - firstChannel);
+
+                alignas (Lanes::SIMDRegisterSize) double dryFrame[(size_t) lanes] {};
+                alignas (Lanes::SIMDRegisterSize) double driveFrame[(size_t) lanes] {};
+
+                for (int l = 0; l < groupChannels; ++l)
+                {
+                    const auto input = block.getSample (firstChannel + l, i);
+                    dryFrame[l] = input;
+                    driveFrame[l] = channelState[(size_t) (firstChannel + l)].hpFilter.processSample (input) * driveGain;
+                }
 
-            data[i] = juce::jmap (mix, input, clipped) * trimGain;
+                const auto clipped = shaper.processSample (group, Lanes::fromRawArray (driveFrame));
+                const auto dry = dryDelay.processSample (group, Lanes::fromRawArray (dryFrame));
+                (dry + (clipped - dry) * (double) (mixes != nullptr ? mixes[i] : mix)).copyToRawArray (dryFrame);
+
+                for (int l = 0; l < groupChannels; ++l)
+                    block.setSample (firstChannel + l, i, (float) dryFrame[l]);
+            }
         }
-    }
+    });
+
+    // The trim is linear, so it runs at the host rate after the oversampler.
+    outputTrimGain.applyGain (buffer, numSamples);
 }
 
 void GROctaneClipperAudioProcessor::getStateInformation (juce::MemoryBlock& destData)
@@ -91,17 +145,9 @@ juce::AudioProcessorValueTreeState::ParameterLayout
 GROctaneClipperAudioProcessor::createParameterLayout()
 {
     std::vector<std::unique_ptr<juce::RangedAudioParameter>> params;
-
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("drive", "Drive",
-                                                                   juce::NormalisableRange<float> (0.0f, 1.0f, 0.001f), 0.6f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("clip_type", "Clip Type",
-                                                                   juce::NormalisableRange<float> (0.0f, 2.0f, 0.01f), 1.0f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("hp", "High-Pass",
-                                                                   juce::NormalisableRange<float> (20.0f, 200.0f, 0.01f, 0.4f), 60.0f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("mix", "Mix",
-                                                                   juce::NormalisableRange<float> (0.0f, 1.0f, 0.001f), 0.7f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("output_trim", "Output Trim",
-                                                                   juce::NormalisableRange<float> (-12.0f, 12.0f, 0.01f), 0.0f));
+    gls::addParameters (params, parameterTable);
+    gls::dsp::Oversampler<float>::addParameters (params);
+    gls::dsp::AntiderivativeWaveshaper::addParameters (params);
 
     return { params.begin(), params.end() };
 }
@@ -128,19 +174,27 @@ void GROctaneClipperAudioProcessor::ensureStateSize (int numChannels)
     }
 }
 
-void GROctaneClipperAudioProcessor::updateFilters (float cutoff)
+void GROctaneClipperAudioProcessor::updateFilters (float cutoff, double processingRate)
 {
-    if (currentSampleRate <= 0.0)
+    if (processingRate <= 0.0)
         return;
 
-    auto coeffs = juce::dsp::IIR::Coefficients<float>::makeHighPass (currentSampleRate,
-                                                                     juce::jlimit (20.0f, 400.0f, cutoff), 0.7f);
+    const auto freq = juce::jlimit (20.0f, 400.0f, cutoff);
     for (auto& state : channelState)
-        state.hpFilter.coefficients = coeffs;
+        state.hpFilter.setHighPass (processingRate, freq, 0.7f);
+}
+
+void GROctaneClipperAudioProcessor::updateOversampling()
+{
+    oversampler.update (isNonRealtime(), currentSampleRate, { &mixAmount });
+
+    latency.setStage (0, oversampler.getLatencySamples(), oversampler.getLatencySamples());
+    latency.update();
 }
 
 GROctaneClipperAudioProcessorEditor::GROctaneClipperAudioProcessorEditor (GROctaneClipperAudioProcessor& processor)
-    : juce::AudioProcessorEditor (&processor), processorRef (processor)
+    : juce::AudioProcessorEditor (&processor), processorRef (processor),
+      oversamplingSelector (processor.getValueTreeState())
 {
     auto make = [this](juce::Slider& slider, const juce::String& label) { initSlider (slider, label); };
     make (driveSlider,     "Drive");
@@ -156,7 +210,8 @@ GROctaneClipperAudioProcessorEditor::GROctaneClipperAudioProcessorEditor (GROcta
     for (int i = 0; i < ids.size(); ++i)
         attachments.push_back (std::make_unique<SliderAttachment> (state, ids[i], *sliders[i]));
 
-    setSize (660, 260);
+    addAndMakeVisible (oversamplingSelector);
+    setSize (660, 290);
 }
 
 void GROctaneClipperAudioProcessorEditor::initSlider (juce::Slider& slider, const juce::String& label)
@@ -178,6 +233,7 @@ void GROctaneClipperAudioProcessorEditor::paint (juce::Graphics& g)
 void GROctaneClipperAudioProcessorEditor::resized()
 {
     auto area = getLocalBounds().reduced (10);
+    oversamplingSelector.setBounds (area.removeFromBottom (28).removeFromRight (400));
     auto width = area.getWidth() / 5;
 
     driveSlider   .setBounds (area.removeFromLeft (width).reduced (8));
@@ -1,17 +1,30 @@
 #pragma once
 
 #include <JuceHeader.h>
+#include <array>
 #include "../../DualPrecisionAudioProcessor.h"
+#include "../../ParameterTable.h"
+#include "../../SmoothedParameter.h"
+#include "../../dsp/Biquad.h"
+#include "../../dsp/LatencyReporter.h"
+#include "../../dsp/Oversampler.h"
+#include "../../dsp/Waveshaper.h"
+#include "../../ui/OversamplingSelector.h"
 
 class GROctaneClipperAudioProcessor : public DualPrecisionAudioProcessor
 {
 public:
+    enum class Param
+    {
+        drive, clipType, hp, mix, outputTrim,
+        count
+    };
+
     GROctaneClipperAudioProcessor();
     ~GROctaneClipperAudioProcessor() override = default;
 
     void prepareToPlay (double sampleRate, int samplesPerBlock) override;
     void releaseResources() override;
-    void processBlock (juce::AudioBuffer<float>&, juce::MidiBuffer&) override;
 
     juce::AudioProcessorEditor* createEditor() override;
     bool hasEditor() const override { return true; }
@@ -20,7 +33,6 @@ public:
     bool acceptsMidi() const override { return false; }
     bool producesMidi() const override { return false; }
     bool isMidiEffect() const override { return false; }
-    double getTailLengthSeconds() const override { return 0.0; }
 
     int getNumPrograms() override { return 1; }
     int getCurrentProgram() override { return 0; }
@@ -34,22 +46,34 @@ public:
     juce::AudioProcessorValueTreeState& getValueTreeState() { return apvts; }
     static juce::AudioProcessorValueTreeState::ParameterLayout createParameterLayout();
 
+protected:
+    void processFloat (juce::AudioBuffer<float>&, juce::MidiBuffer&) override;
+
 private:
     struct ChannelState
     {
-        juce::dsp::IIR::Filter<float> hpFilter;
-        float lastSample = 0.0f;
+        gls::dsp::Biquad hpFilter;
     };
 
     juce::AudioProcessorValueTreeState apvts;
+
+    gls::ParameterHandles<Param> params;
+    gls::SmoothedParameter mixAmount      { params, Param::mix };
+    gls::SmoothedParameter outputTrimGain { params, Param::outputTrim,  gls::SmoothedParameter::Mapping::decibels };
+    std::atomic<float>& adaaOrder;
     std::vector<ChannelState> channelState;
+    gls::dsp::Oversampler<float> oversampler;
+    gls::dsp::AntiderivativeWaveshaper shaper;
+    gls::dsp::AntiderivativeDelayMatch dryDelay;
+    gls::dsp::LatencyReporter latency { *this };
     double currentSampleRate = 44100.0;
     juce::uint32 lastBlockSize = 512;
     double filterSpecSampleRate = 0.0;
     juce::uint32 filterSpecBlockSize = 0;
 
     void ensureStateSize (int numChannels);
-    void updateFilters (float cutoff);
+    void updateFilters (float cutoff, double processingRate);
+    void updateOversampling();
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (GROctaneClipperAudioProcessor)
 };
@@ -71,6 +95,7 @@ private:
     juce::Slider hpSlider;
     juce::Slider mixSlider;
     juce::Slider trimSlider;
+    gls::ui::OversamplingSelector oversamplingSelector;
 
     using SliderAttachment = juce::AudioProcessorValueTreeState::SliderAttachment;
     std::vector<std::unique_ptr<SliderAttachment>> attachments;
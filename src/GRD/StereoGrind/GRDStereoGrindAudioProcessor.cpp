@@ -10,6 +10,21 @@ constexpr auto paramMix     = "mix";
 constexpr auto paramInput   = "input_trim";
 constexpr auto paramOutput  = "output_trim";
 constexpr auto paramBypass  = "ui_bypass";
+
+using Param = GRDStereoGrindAudioProcessor::Param;
+using Spec = gls::ParameterSpec;
+
+constexpr std::array<Spec, (size_t) Param::count> parameterTable {{
+    Spec::range  (paramGrit,   "Grit",        0.0f,   1.0f,  0.001f, 0.5f),
+    Spec::range  (paramStereo, "Stereo",      0.0f,   1.5f,  0.001f, 1.0f),
+    Spec::range  (paramDrive,  "Drive",       0.0f,   1.0f,  0.001f, 0.4f),
+    Spec::range  (paramMix,    "Mix",         0.0f,   1.0f,  0.001f, 0.6f),
+    Spec::range  (paramInput,  "Input Trim",  -18.0f, 18.0f, 0.1f,   0.0f),
+    Spec::range  (paramOutput, "Output Trim", -18.0f, 18.0f, 0.1f,   0.0f),
+    Spec::toggle (paramBypass, "Soft Bypass", false)
+}};
+
+static_assert (gls::hasUniqueIds (parameterTable));
 }
 
 const std::array<GRDStereoGrindAudioProcessor::Preset, 3> GRDStereoGrindAudioProcessor::presetBank {{
@@ -46,25 +61,42 @@ GRDStereoGrindAudioProcessor::GRDStereoGrindAudioProcessor()
     : DualPrecisionAudioProcessor (BusesProperties()
                         .withInput  ("Input", juce::AudioChannelSet::stereo(), true)
                         .withOutput ("Output", juce::AudioChannelSet::stereo(), true)),
-      apvts (*this, nullptr, kStateId, createParameterLayout())
+      apvts (*this, nullptr, kStateId, createParameterLayout()),
+      params (apvts, parameterTable)
 {
+    oversampler.attach (apvts);
+    bypass.snapOnResume ({ &mixAmount, &outputTrimGain });
 }
 
 void GRDStereoGrindAudioProcessor::prepareToPlay (double sampleRate, int samplesPerBlock)
 {
+    DualPrecisionAudioProcessor::prepareToPlay (sampleRate, samplesPerBlock);
+
     currentSampleRate = sampleRate > 0.0 ? sampleRate : 44100.0;
     lastBlockSize = (juce::uint32) juce::jmax (1, samplesPerBlock);
-    const int channels = juce::jmax (1, getTotalNumOutputChannels());
-    dryBuffer.setSize (channels, (int) lastBlockSize);
+
+    oversampler.prepare (juce::jmax (1, getTotalNumOutputChannels()), samplesPerBlock);
+    bypass.prepare (currentSampleRate, juce::jmax (getTotalNumInputChannels(), getTotalNumOutputChannels()), samplesPerBlock,
+                    oversampler.getMaximumLatencySamples());
+    mixAmount.prepare (currentSampleRate * oversampler.getFactor(), samplesPerBlock << gls::dsp::Oversampler<float>::maxFactorLog2);
+
+    for (auto* smoother : { &inputTrimGain, &outputTrimGain })
+        smoother->prepare (currentSampleRate, samplesPerBlock);
+
+    latency.invalidate();
+    updateOversampling();
 }
 
 void GRDStereoGrindAudioProcessor::releaseResources()
 {
 }
 
-void GRDStereoGrindAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer,
-                                                 juce::MidiBuffer&)
+void GRDStereoGrindAudioProcessor::processFloat (juce::AudioBuffer<float>& buffer,
+                                                 juce::MidiBuffer& midi)
 {
+    if (renderInPreparedChunks (buffer, midi))
+        return;
+
     juce::ScopedNoDenormals noDenormals;
 
     const auto totalIn  = getTotalNumInputChannels();
@@ -77,73 +109,58 @@ void GRDStereoGrindAudioProcessor::processBlock (juce::AudioBuffer<float>& buffe
     if (numChannels == 0 || numSamples == 0)
         return;
 
-    auto get = [this](const char* id) { return apvts.getRawParameterValue (id)->load(); };
-
-    const float grit    = juce::jlimit (0.0f, 1.0f, get (paramGrit));
-    const float stereo  = juce::jlimit (0.0f, 1.5f, get (paramStereo));
-    const float drive   = juce::jlimit (0.0f, 1.0f, get (paramDrive));
-    const float mix     = juce::jlimit (0.0f, 1.0f, get (paramMix));
-    const float inputGain  = juce::Decibels::decibelsToGain (juce::jlimit (-18.0f, 18.0f, get (paramInput)));
-    const float outputGain = juce::Decibels::decibelsToGain (juce::jlimit (-18.0f, 18.0f, get (paramOutput)));
-    const bool bypassed = get (paramBypass) > 0.5f;
+    const float grit    = juce::jlimit (0.0f, 1.0f, params[Param::grit]);
+    const float stereo  = juce::jlimit (0.0f, 1.5f, params[Param::stereo]);
+    const float drive   = juce::jlimit (0.0f, 1.0f, params[Param::drive]);
+    const bool bypassed = params.isOn (Param::bypass);
 
     lastBlockSize = (juce::uint32) juce::jmax (1, numSamples);
-    dryBuffer.setSize (numChannels, numSamples, false, false, true);
-    dryBuffer.makeCopyOf (buffer, true);
+    updateOversampling();
 
-    buffer.applyGain (inputGain);
-    if (bypassed)
-    {
-        buffer.applyGain (outputGain);
-        return;
-    }
+    for (auto* smoother : { &inputTrimGain, &mixAmount, &outputTrimGain })
+        smoother->update();
 
-    juce::AudioBuffer<float> midSide (2, numSamples);
-    midSide.clear();
+    inputTrimGain.applyGain (buffer, numSamples);
 
-    if (numChannels >= 2)
-    {
-        for (int i = 0; i < numSamples; ++i)
-        {
-            const float left  = dryBuffer.getSample (0, i);
-            const float right = dryBuffer.getSample (1, i);
-            midSide.setSample (0, i, 0.5f * (left + right));
-            midSide.setSample (1, i, 0.5f * (left - right));
-        }
-    }
-    else
-    {
-        midSide.copyFrom (0, 0, dryBuffer, 0, 0, numSamples);
-        midSide.clear (1, 0, numSamples);
-    }
+    if (! bypass.begin (buffer, numSamples, bypassed))
+        return;
 
-    for (int i = 0; i < numSamples; ++i)
+    // Mid/side split, grit and the dry blend all run per sample at the oversampled rate.
+    oversampler.process (buffer, [&] (juce::dsp::AudioBlock<float>& block)
     {
-        float mid  = midSide.getSample (0, i);
-        float side = midSide.getSample (1, i);
+        const auto blockSamples = (int) block.getNumSamples();
+        const auto* mixes = mixAmount.advance (blockSamples);
+        const float mix = mixAmount.getCurrentValue();
+        const auto blockChannels = block.getNumChannels();
+        auto* leftData = block.getChannelPointer (0);
 
-        const float gritSample   = juce::dsp::FastMathApproximations::tanh (mid * (1.0f + drive * 4.0f));
-        const float stereoSample = juce::dsp::FastMathApproximations::tanh (side * (1.0f + grit * 3.0f));
+        for (int i = 0; i < blockSamples; ++i)
+        {
+            const float dryLeft = leftData[i];
+            const float dryRight = blockChannels >= 2 ? block.getChannelPointer (1)[i] : 0.0f;
 
-        midSide.setSample (0, i, juce::jmap (grit, mid, gritSample));
-        midSide.setSample (1, i, juce::jmap (stereo, side, stereoSample));
-    }
+            float mid  = blockChannels >= 2 ? 0.5f * (dryLeft + dryRight) : dryLeft;
+            float side = blockChannels >= 2 ? 0.5f * (dryLeft - dryRight) : 0.0f;
 
-    for (int i = 0; i < numSamples; ++i)
-    {
-        const float mid  = midSide.getSample (0, i);
-        const float side = midSide.getSample (1, i) * stereo;
+            const float gritSample   = juce::dsp::FastMathApproximations::tanh (mid * (1.0f + drive * 4.0f));
+            const float stereoSample = juce::dsp::FastMathApproximations::tanh (side * (1.0f + grit * 3.0f));
 
-        const float left  = mid + side;
-        const float right = mid - side;
+            mid  = juce::jmap (grit, mid, gritSample);
+            side = juce::jmap (stereo, side, stereoSample) * stereo;
 
-        for (int ch = 0; ch < numChannels; ++ch)
-        {
-            const float dry = dryBuffer.getSample (ch, i);
-            const float wet = (ch == 0 ? left : right) * outputGain;
-            buffer.setSample (ch, i, juce::jmap (mix, dry, wet));
+            const float amount = mixes != nullptr ? mixes[i] : mix;
+            leftData[i] = juce::jmap (amount, dryLeft, mid + side);
+
+            for (size_t ch = 1; ch < blockChannels; ++ch)
+            {
+                auto* data = block.getChannelPointer (ch);
+                data[i] = juce::jmap (amount, data[i], mid - side);
+            }
         }
-    }
+    });
+
+    outputTrimGain.applyGain (buffer, numSamples);
+    bypass.end (buffer, numSamples);
 }
 
 void GRDStereoGrindAudioProcessor::getStateInformation (juce::MemoryBlock& destData)
@@ -163,24 +180,21 @@ juce::AudioProcessorValueTreeState::ParameterLayout
 GRDStereoGrindAudioProcessor::createParameterLayout()
 {
     std::vector<std::unique_ptr<juce::RangedAudioParameter>> params;
-
-    params.push_back (std::make_unique<juce::AudioParameterFloat> (paramGrit, "Grit",
-                                                                   juce::NormalisableRange<float> (0.0f, 1.0f, 0.001f), 0.5f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> (paramStereo, "Stereo",
-                                                                   juce::NormalisableRange<float> (0.0f, 1.5f, 0.001f), 1.0f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> (paramDrive, "Drive",
-                                                                   juce::NormalisableRange<float> (0.0f, 1.0f, 0.001f), 0.4f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> (paramMix, "Mix",
-                                                                   juce::NormalisableRange<float> (0.0f, 1.0f, 0.001f), 0.6f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> (paramInput, "Input Trim",
-                                                                   juce::NormalisableRange<float> (-18.0f, 18.0f, 0.1f), 0.0f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> (paramOutput, "Output Trim",
-                                                                   juce::NormalisableRange<float> (-18.0f, 18.0f, 0.1f), 0.0f));
-    params.push_back (std::make_unique<juce::AudioParameterBool>  (paramBypass, "Soft Bypass", false));
+    gls::addParameters (params, parameterTable);
+    gls::dsp::Oversampler<float>::addParameters (params);
 
     return { params.begin(), params.end() };
 }
 
+void GRDStereoGrindAudioProcessor::updateOversampling()
+{
+    oversampler.update (isNonRealtime(), currentSampleRate, { &mixAmount });
+
+    latency.setStage (0, oversampler.getLatencySamples(), oversampler.getLatencySamples());
+    latency.update();
+    bypass.setLatency (oversampler.getLatencySamples());
+}
+
 int GRDStereoGrindAudioProcessor::getNumPrograms()
 {
     return (int) presetBank.size();
@@ -228,7 +242,8 @@ juce::AudioProcessorEditor* GRDStereoGrindAudioProcessor::createEditor()
 GRDStereoGrindAudioProcessorEditor::GRDStereoGrindAudioProcessorEditor (GRDStereoGrindAudioProcessor& processor)
     : juce::AudioProcessorEditor (&processor), processorRef (processor),
       accentColour (gls::ui::accentForFamily ("GRD")),
-      headerComponent ("GRD.StereoGrind", "Stereo Grind")
+      headerComponent ("GRD.StereoGrind", "Stereo Grind"),
+      oversamplingSelector (processor.getValueTreeState())
 {
     lookAndFeel.setAccentColour (accentColour);
     setLookAndFeel (&lookAndFeel);
@@ -255,6 +270,7 @@ GRDStereoGrindAudioProcessorEditor::GRDStereoGrindAudioProcessorEditor (GRDStere
     attachments.push_back (std::make_unique<SliderAttachment> (state, paramInput, inputTrimSlider));
     attachments.push_back (std::make_unique<SliderAttachment> (state, paramOutput, outputTrimSlider));
     bypassAttachment = std::make_unique<juce::AudioProcessorValueTreeState::ButtonAttachment> (state, paramBypass, bypassButton);
+    addAndMakeVisible (oversamplingSelector);
 
     setSize (760, 420);
 }
@@ -321,7 +337,9 @@ void GRDStereoGrindAudioProcessorEditor::resized()
     inputTrimSlider  .setBounds (bottom.removeFromLeft (bottomWidth).reduced (8));
     outputTrimSlider .setBounds (bottom.removeFromLeft (bottomWidth).reduced (8));
 
-    bypassButton.setBounds (footerComponent.getBounds().reduced (24, 12));
+    auto footer = footerComponent.getBounds().reduced (24, 12);
+    oversamplingSelector.setBounds (footer.removeFromRight (300));
+    bypassButton.setBounds (footer);
     layoutLabels();
 }
 
@@ -1,27 +1,52 @@
 #include "GRDSubHarmForgeAudioProcessor.h"
 
+namespace
+{
+using Param = GRDSubHarmForgeAudioProcessor::Param;
+using Spec = gls::ParameterSpec;
+
+constexpr std::array<Spec, (size_t) Param::count> parameterTable {{
+    Spec::range ("depth",       "Depth",       0.0f,   1.0f,   0.001f, 0.7f),
+    Spec::range ("crossover",   "Crossover",   40.0f,  140.0f, 0.01f,  80.0f, 0.4f),
+    Spec::range ("drive",       "Drive",       0.0f,   1.0f,   0.001f, 0.4f),
+    Spec::range ("blend",       "Blend",       0.0f,   1.0f,   0.001f, 0.65f),
+    Spec::range ("output_trim", "Output Trim", -12.0f, 12.0f,  0.01f,  0.0f)
+}};
+
+static_assert (gls::hasUniqueIds (parameterTable));
+} // namespace
+
 GRDSubHarmForgeAudioProcessor::GRDSubHarmForgeAudioProcessor()
     : DualPrecisionAudioProcessor (BusesProperties()
                         .withInput  ("Input", juce::AudioChannelSet::stereo(), true)
                         .withOutput ("Output", juce::AudioChannelSet::stereo(), true)),
-      apvts (*this, nullptr, "SUB_HARM_FORGE", createParameterLayout())
+      apvts (*this, nullptr, "SUB_HARM_FORGE", createParameterLayout()),
+      params (apvts, parameterTable)
 {
 }
 
 void GRDSubHarmForgeAudioProcessor::prepareToPlay (double sampleRate, int samplesPerBlock)
 {
+    DualPrecisionAudioProcessor::prepareToPlay (sampleRate, samplesPerBlock);
+
     currentSampleRate = sampleRate > 0.0 ? sampleRate : 44100.0;
     lastBlockSize = (juce::uint32) juce::jmax (1, samplesPerBlock);
-    ensureStateSize (juce::jmax (1, getTotalNumOutputChannels()));
+    ensureStateSize (juce::jmax (1, getTotalNumInputChannels(), getTotalNumOutputChannels()));
+
+    for (auto* smoother : { &blendAmount, &outputTrimGain })
+        smoother->prepare (currentSampleRate, samplesPerBlock);
 }
 
 void GRDSubHarmForgeAudioProcessor::releaseResources()
 {
 }
 
-void GRDSubHarmForgeAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer,
-                                                  juce::MidiBuffer&)
+void GRDSubHarmForgeAudioProcessor::processFloat (juce::AudioBuffer<float>& buffer,
+                                                  juce::MidiBuffer& midi)
 {
+    if (renderInPreparedChunks (buffer, midi))
+        return;
+
     juce::ScopedNoDenormals noDenormals;
 
     const auto totalIn  = getTotalNumInputChannels();
@@ -30,28 +55,26 @@ void GRDSubHarmForgeAudioProcessor::processBlock (juce::AudioBuffer<float>& buff
     for (int ch = totalIn; ch < totalOut; ++ch)
         buffer.clear (ch, 0, numSamples);
 
-    const int numChannels = buffer.getNumChannels();
+    const int numChannels = juce::jmin (buffer.getNumChannels(), (int) channelState.size());
     if (numChannels == 0 || numSamples == 0)
         return;
 
-    auto get = [this](const char* id) { return apvts.getRawParameterValue (id)->load(); };
-
-    const float depth     = juce::jlimit (0.0f, 1.0f, get ("depth"));
-    const float crossover = juce::jlimit (40.0f, 140.0f, get ("crossover"));
-    const float drive     = juce::jlimit (0.0f, 1.0f, get ("drive"));
-    const float blend     = juce::jlimit (0.0f, 1.0f, get ("blend"));
-    const float trimDb    = juce::jlimit (-12.0f, 12.0f, get ("output_trim"));
-    const float trimGain  = juce::Decibels::decibelsToGain (trimDb);
+    const float depth     = juce::jlimit (0.0f, 1.0f, params[Param::depth]);
+    const float crossover = juce::jlimit (40.0f, 140.0f, params[Param::crossover]);
+    const float drive     = juce::jlimit (0.0f, 1.0f, params[Param::drive]);
 
-    ensureStateSize (numChannels);
     updateFilters (crossover);
 
-    juce::AudioBuffer<float> dry;
-    dry.makeCopyOf (buffer, true);
-
     const float subGain = depth * 0.8f;
     const float driveGain = 1.0f + drive * 6.0f;
 
+    blendAmount.update();
+    outputTrimGain.update();
+    const auto* blends = blendAmount.advance (numSamples);
+    const auto* trims = outputTrimGain.advance (numSamples);
+    const float blend = blendAmount.getCurrentValue();
+    const float trimGain = outputTrimGain.getCurrentValue();
+
     for (int ch = 0; ch < numChannels; ++ch)
     {
         auto* data = buffer.getWritePointer (ch);
@@ -59,14 +82,15 @@ void GRDSubHarmForgeAudioProcessor::processBlock (juce::AudioBuffer<float>& buff
 
         for (int i = 0; i < numSamples; ++i)
         {
-            const float input = dry.getSample (ch, i);
+            const float input = data[i];
             const float low = state.lowFilter.processSample (input);
             const float sub = state.subFilter.processSample (input);
             const float rectified = std::abs (sub);
             const float synth = std::sin (subPhase) * rectified;
 
             const float forged = std::tanh ((low + synth * subGain) * driveGain);
-            data[i] = juce::jmap (blend, input, forged) * trimGain;
+            data[i] = juce::jmap (blends != nullptr ? blends[i] : blend, input, forged)
+                        * (trims != nullptr ? trims[i] : trimGain);
 
             subPhase += (float) (juce::MathConstants<double>::twoPi * (currentSampleRate > 0.0 ? crossover / currentSampleRate : 0.0));
             if (subPhase > juce::MathConstants<float>::twoPi)
@@ -91,20 +115,7 @@ void GRDSubHarmForgeAudioProcessor::setStateInformation (const void* data, int s
 juce::AudioProcessorValueTreeState::ParameterLayout
 GRDSubHarmForgeAudioProcessor::createParameterLayout()
 {
-    std::vector<std::unique_ptr<juce::RangedAudioParameter>> params;
-
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("depth", "Depth",
-                                                                   juce::NormalisableRange<float> (0.0f, 1.0f, 0.001f), 0.7f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("crossover", "Crossover",
-                                                                   juce::NormalisableRange<float> (40.0f, 140.0f, 0.01f, 0.4f), 80.0f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("drive", "Drive",
-                                                                   juce::NormalisableRange<float> (0.0f, 1.0f, 0.001f), 0.4f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("blend", "Blend",
-                                                                   juce::NormalisableRange<float> (0.0f, 1.0f, 0.001f), 0.65f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("output_trim", "Output Trim",
-                                                                   juce::NormalisableRange<float> (-12.0f, 12.0f, 0.01f), 0.0f));
-
-    return { params.begin(), params.end() };
+    return gls::createParameterLayout (parameterTable);
 }
 
 void GRDSubHarmForgeAudioProcessor::ensureStateSize (int numChannels)
@@ -136,14 +147,13 @@ void GRDSubHarmForgeAudioProcessor::updateFilters (float crossoverHz)
     if (currentSampleRate <= 0.0)
         return;
 
-    auto low = juce::dsp::IIR::Coefficients<float>::makeLowPass (currentSampleRate,
-                                                                 juce::jlimit (40.0f, 180.0f, crossoverHz), 0.7f);
-    auto sub = juce::dsp::IIR::Coefficients<float>::makeLowPass (currentSampleRate,
-                                                                 juce::jlimit (30.0f, 100.0f, crossoverHz * 0.5f), 0.8f);
+    const auto lowFreq = juce::jlimit (40.0f, 180.0f, crossoverHz);
+    const auto subFreq = juce::jlimit (30.0f, 100.0f, crossoverHz * 0.5f);
+
     for (auto& state : channelState)
     {
-        state.lowFilter.coefficients = low;
-        state.subFilter.coefficients = sub;
+        state.lowFilter.setLowPass (currentSampleRate, lowFreq, 0.7f);
+        state.subFilter.setLowPass (currentSampleRate, subFreq, 0.8f);
     }
 }
 
@@ -1,28 +1,54 @@
 #include "GRDTapeCrushAudioProcessor.h"
 
+namespace
+{
+using Param = GRDTapeCrushAudioProcessor::Param;
+using Spec = gls::ParameterSpec;
+
+constexpr std::array<Spec, (size_t) Param::count> parameterTable {{
+    Spec::range ("drive",       "Drive",       0.0f,   1.0f,    0.001f, 0.5f),
+    Spec::range ("wow",         "Wow",         0.0f,   1.0f,    0.001f, 0.3f),
+    Spec::range ("flutter",     "Flutter",     0.0f,   1.0f,    0.001f, 0.2f),
+    Spec::range ("hiss",        "Hiss",        0.0f,   1.0f,    0.001f, 0.15f),
+    Spec::range ("tone",        "Tone",        800.0f, 9000.0f, 0.01f,  3500.0f, 0.4f),
+    Spec::range ("mix",         "Mix",         0.0f,   1.0f,    0.001f, 0.6f),
+    Spec::range ("output_trim", "Output Trim", -12.0f, 12.0f,   0.01f,  0.0f)
+}};
+
+static_assert (gls::hasUniqueIds (parameterTable));
+} // namespace
+
 GRDTapeCrushAudioProcessor::GRDTapeCrushAudioProcessor()
     : DualPrecisionAudioProcessor (BusesProperties()
                         .withInput  ("Input", juce::AudioChannelSet::stereo(), true)
                         .withOutput ("Output", juce::AudioChannelSet::stereo(), true)),
-      apvts (*this, nullptr, "TAPE_CRUSH", createParameterLayout())
+      apvts (*this, nullptr, "TAPE_CRUSH", createParameterLayout()),
+      params (apvts, parameterTable)
 {
 }
 
 void GRDTapeCrushAudioProcessor::prepareToPlay (double sampleRate, int samplesPerBlock)
 {
+    DualPrecisionAudioProcessor::prepareToPlay (sampleRate, samplesPerBlock);
+
     currentSampleRate = sampleRate > 0.0 ? sampleRate : 44100.0;
     lastBlockSize = (juce::uint32) juce::jmax (1, samplesPerBlock);
     ensureStateSize (juce::jmax (1, getTotalNumOutputChannels()));
-    dryBuffer.setSize (getTotalNumOutputChannels(), (int) lastBlockSize);
+
+    for (auto* smoother : { &mixAmount, &outputTrimGain })
+        smoother->prepare (currentSampleRate, samplesPerBlock);
 }
 
 void GRDTapeCrushAudioProcessor::releaseResources()
 {
 }
 
-void GRDTapeCrushAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer,
-                                               juce::MidiBuffer&)
+void GRDTapeCrushAudioProcessor::processFloat (juce::AudioBuffer<float>& buffer,
+                                               juce::MidiBuffer& midi)
 {
+    if (renderInPreparedChunks (buffer, midi))
+        return;
+
     juce::ScopedNoDenormals noDenormals;
 
     const auto totalIn  = getTotalNumInputChannels();
@@ -35,26 +61,27 @@ void GRDTapeCrushAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer,
     if (numChannels == 0 || numSamples == 0)
         return;
 
-    auto get = [this](const char* id) { return apvts.getRawParameterValue (id)->load(); };
-
-    const float drive   = juce::jlimit (0.0f, 1.0f, get ("drive"));
-    const float wow     = juce::jlimit (0.0f, 1.0f, get ("wow"));
-    const float flutter = juce::jlimit (0.0f, 1.0f, get ("flutter"));
-    const float hiss    = juce::jlimit (0.0f, 1.0f, get ("hiss"));
-    const float tone    = juce::jlimit (800.0f, 9000.0f, get ("tone"));
-    const float mix     = juce::jlimit (0.0f, 1.0f, get ("mix"));
-    const float trim    = juce::Decibels::decibelsToGain (juce::jlimit (-12.0f, 12.0f, get ("output_trim")));
+    const float drive   = juce::jlimit (0.0f, 1.0f, params[Param::drive]);
+    const float wow     = juce::jlimit (0.0f, 1.0f, params[Param::wow]);
+    const float flutter = juce::jlimit (0.0f, 1.0f, params[Param::flutter]);
+    const float hiss    = juce::jlimit (0.0f, 1.0f, params[Param::hiss]);
+    const float tone    = juce::jlimit (800.0f, 9000.0f, params[Param::tone]);
 
     lastBlockSize = (juce::uint32) juce::jmax (1, numSamples);
     ensureStateSize (numChannels);
-    dryBuffer.setSize (numChannels, numSamples, false, false, true);
-    dryBuffer.makeCopyOf (buffer, true);
     updateToneFilters (tone);
 
     juce::Random random;
     const float wowRate = juce::jmap (wow, 0.1f, 0.5f);
     const float flutterRate = juce::jmap (flutter, 3.0f, 10.0f);
 
+    mixAmount.update();
+    outputTrimGain.update();
+    const auto* mixes = mixAmount.advance (numSamples);
+    const auto* trims = outputTrimGain.advance (numSamples);
+    const float mix = mixAmount.getCurrentValue();
+    const float trim = outputTrimGain.getCurrentValue();
+
     for (int ch = 0; ch < numChannels; ++ch)
     {
         auto* data = buffer.getWritePointer (ch);
@@ -63,7 +90,7 @@ void GRDTapeCrushAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer,
 
         for (int i = 0; i < numSamples; ++i)
         {
-            const float drySample = dryBuffer.getSample (ch, i);
+            const float drySample = data[i];
 
             const float wowMod = std::sin (state.wowPhase) * wow * 8.0f;
             const float flutterMod = std::sin (state.flutterPhase) * flutter * 2.0f;
@@ -79,7 +106,8 @@ void GRDTapeCrushAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer,
 
             state.delay.pushSample (0, drySample + saturated * 0.4f);
 
-            data[i] = juce::jmap (mix, drySample, saturated) * trim;
+            data[i] = juce::jmap (mixes != nullptr ? mixes[i] : mix, drySample, saturated)
+                        * (trims != nullptr ? trims[i] : trim);
 
             state.wowPhase += wowRate / (float) currentSampleRate * juce::MathConstants<float>::twoPi;
             state.flutterPhase += flutterRate / (float) currentSampleRate * juce::MathConstants<float>::twoPi;
@@ -89,6 +117,21 @@ void GRDTapeCrushAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer,
     }
 }
 
+void GRDTapeCrushAudioProcessor::updateTail()
+{
+    // Hiss is injected into the tape loop with or without input. Without it, the loop
+    // recirculates through the saturator's small-signal gain.
+    if (params[Param::hiss] > 0.0f)
+    {
+        tail.setTail (std::numeric_limits<double>::infinity());
+        return;
+    }
+
+    const auto loopSeconds = 200.0 / currentSampleRate;
+    const auto loopGain = 0.4 * (1.0 + 5.0 * params[Param::drive]);
+    tail.setTail (loopSeconds, gls::dsp::TailTracker::getFeedbackRT60 (loopSeconds, loopGain));
+}
+
 void GRDTapeCrushAudioProcessor::getStateInformation (juce::MemoryBlock& destData)
 {
     auto state = apvts.copyState();
@@ -105,24 +148,7 @@ void GRDTapeCrushAudioProcessor::setStateInformation (const void* data, int size
 juce::AudioProcessorValueTreeState::ParameterLayout
 GRDTapeCrushAudioProcessor::createParameterLayout()
 {
-    std::vector<std::unique_ptr<juce::RangedAudioParameter>> params;
-
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("drive", "Drive",
-                                                                   juce::NormalisableRange<float> (0.0f, 1.0f, 0.001f), 0.5f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("wow", "Wow",
-                                                                   juce::NormalisableRange<float> (0.0f, 1.0f, 0.001f), 0.3f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("flutter", "Flutter",
-                                                                   juce::NormalisableRange<float> (0.0f, 1.0f, 0.001f), 0.2f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("hiss", "Hiss",
-                                                                   juce::NormalisableRange<float> (0.0f, 1.0f, 0.001f), 0.15f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("tone", "Tone",
-                                                                   juce::NormalisableRange<float> (800.0f, 9000.0f, 0.01f, 0.4f), 3500.0f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("mix", "Mix",
-                                                                   juce::NormalisableRange<float> (0.0f, 1.0f, 0.001f), 0.6f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("output_trim", "Output Trim",
-                                                                   juce::NormalisableRange<float> (-12.0f, 12.0f, 0.01f), 0.0f));
-
-    return { params.begin(), params.end() };
+    return gls::createParameterLayout (parameterTable);
 }
 
 void GRDTapeCrushAudioProcessor::ensureStateSize (int numChannels)
@@ -154,10 +180,9 @@ void GRDTapeCrushAudioProcessor::updateToneFilters (float tone)
     if (currentSampleRate <= 0.0)
         return;
 
-    auto coeffs = juce::dsp::IIR::Coefficients<float>::makeLowPass (currentSampleRate,
-                                                                    juce::jlimit (500.0f, (float) (currentSampleRate * 0.45f), tone), 0.7f);
+    const auto freq = juce::jlimit (500.0f, (float) (currentSampleRate * 0.45f), tone);
     for (auto& state : channelState)
-        state.toneFilter.coefficients = coeffs;
+        state.toneFilter.setLowPass (currentSampleRate, freq, 0.7f);
 }
 
 GRDTapeCrushAudioProcessorEditor::GRDTapeCrushAudioProcessorEditor (GRDTapeCrushAudioProcessor& processor)
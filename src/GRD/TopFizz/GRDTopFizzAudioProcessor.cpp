@@ -11,6 +11,22 @@ constexpr auto paramInputId         = "input_trim";
 constexpr auto paramOutputId        = "output_trim";
 constexpr auto paramBypassId        = "ui_bypass";
 constexpr auto kStateId             = "TOP_FIZZ";
+
+using Param = GRDTopFizzAudioProcessor::Param;
+using Spec = gls::ParameterSpec;
+
+constexpr std::array<Spec, (size_t) Param::count> parameterTable {{
+    Spec::range  (paramFreqId,         "Freq",        2000.0f, 16000.0f, 1.0f,    8000.0f, 0.45f),
+    Spec::range  (paramAmountId,       "Amount",      0.0f,    1.0f,     0.0001f, 0.5f),
+    Spec::range  (paramOddEvenBlendId, "Odd/Even",    0.0f,    1.0f,     0.0001f, 0.5f),
+    Spec::range  (paramDeHarshId,      "DeHarsh",     0.0f,    1.0f,     0.0001f, 0.5f),
+    Spec::range  (paramMixId,          "Mix",         0.0f,    1.0f,     0.0001f, 0.5f),
+    Spec::range  (paramInputId,        "Input Trim",  -18.0f,  18.0f,    0.1f,    0.0f),
+    Spec::range  (paramOutputId,       "Output Trim", -18.0f,  18.0f,    0.1f,    0.0f),
+    Spec::toggle (paramBypassId,       "Soft Bypass", false)
+}};
+
+static_assert (gls::hasUniqueIds (parameterTable));
 }
 
 const std::array<GRDTopFizzAudioProcessor::Preset, 3> GRDTopFizzAudioProcessor::presetBank {{
@@ -50,26 +66,45 @@ GRDTopFizzAudioProcessor::GRDTopFizzAudioProcessor()
     : DualPrecisionAudioProcessor (BusesProperties()
                         .withInput  ("Input", juce::AudioChannelSet::stereo(), true)
                         .withOutput ("Output", juce::AudioChannelSet::stereo(), true)),
-      apvts (*this, nullptr, kStateId, createParameterLayout())
+      apvts (*this, nullptr, kStateId, createParameterLayout()),
+      params (apvts, parameterTable)
 {
+    oversampler.attach (apvts);
+    bypass.snapOnResume ({ &mixAmount, &outputTrimGain });
 }
 
-void GRDTopFizzAudioProcessor::prepareToPlay (double sampleRate, int /*samplesPerBlock*/)
+void GRDTopFizzAudioProcessor::prepareToPlay (double sampleRate, int samplesPerBlock)
 {
+    DualPrecisionAudioProcessor::prepareToPlay (sampleRate, samplesPerBlock);
+
     currentSampleRate = juce::jmax (sampleRate, 44100.0);
     highBandFilters.clear();
     smoothingFilters.clear();
-    dryBuffer.setSize (getTotalNumOutputChannels(), 0);
-    lastBlockSize = 0;
+    lastBlockSize = (juce::uint32) juce::jmax (1, samplesPerBlock);
+    ensureStateSize (juce::jmax (1, getTotalNumInputChannels(), getTotalNumOutputChannels()));
+
+    oversampler.prepare (juce::jmax (1, getTotalNumOutputChannels()), samplesPerBlock);
+    bypass.prepare (currentSampleRate, juce::jmax (getTotalNumInputChannels(), getTotalNumOutputChannels()), samplesPerBlock,
+                    oversampler.getMaximumLatencySamples());
+    mixAmount.prepare (currentSampleRate * oversampler.getFactor(), samplesPerBlock << gls::dsp::Oversampler<float>::maxFactorLog2);
+
+    for (auto* smoother : { &inputTrimGain, &outputTrimGain })
+        smoother->prepare (currentSampleRate, samplesPerBlock);
+
+    latency.invalidate();
+    updateOversampling();
 }
 
 void GRDTopFizzAudioProcessor::releaseResources()
 {
 }
 
-void GRDTopFizzAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer,
-                                             juce::MidiBuffer&)
+void GRDTopFizzAudioProcessor::processFloat (juce::AudioBuffer<float>& buffer,
+                                             juce::MidiBuffer& midi)
 {
+    if (renderInPreparedChunks (buffer, midi))
+        return;
+
     juce::ScopedNoDenormals noDenormals;
 
     auto totalNumInputChannels  = getTotalNumInputChannels();
@@ -77,46 +112,56 @@ void GRDTopFizzAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer,
     for (auto ch = totalNumInputChannels; ch < totalNumOutputChannels; ++ch)
         buffer.clear (ch, 0, buffer.getNumSamples());
 
-    ensureStateSize (buffer.getNumChannels(), buffer.getNumSamples());
-    dryBuffer.makeCopyOf (buffer, true);
+    ensureStateSize (buffer.getNumChannels());
 
     const auto bandFreq = juce::jlimit (2000.0f, 16000.0f,
-                                        apvts.getRawParameterValue (paramFreqId)->load());
+                                        params[Param::freq]);
     const auto amount   = juce::jlimit (0.0f, 1.0f,
-                                        apvts.getRawParameterValue (paramAmountId)->load());
+                                        params[Param::amount]);
     const auto blend    = juce::jlimit (0.0f, 1.0f,
-                                        apvts.getRawParameterValue (paramOddEvenBlendId)->load());
+                                        params[Param::oddEvenBlend]);
     const auto deHarsh  = juce::jlimit (0.0f, 1.0f,
-                                        apvts.getRawParameterValue (paramDeHarshId)->load());
-    const auto mix      = juce::jlimit (0.0f, 1.0f,
-                                        apvts.getRawParameterValue (paramMixId)->load());
-    const auto inputGain  = juce::Decibels::decibelsToGain (apvts.getRawParameterValue (paramInputId)->load());
-    const auto outputGain = juce::Decibels::decibelsToGain (apvts.getRawParameterValue (paramOutputId)->load());
-    const bool bypassed   = apvts.getRawParameterValue (paramBypassId)->load() > 0.5f;
+                                        params[Param::deharsh]);
+    const bool bypassed   = params.isOn (Param::bypass);
 
     const auto smoothFreq = juce::jmap (deHarsh, 4000.0f, 18000.0f);
-    updateFilters (bandFreq, smoothFreq);
+    updateOversampling();
+    updateFilters (bandFreq, smoothFreq, currentSampleRate * oversampler.getFactor());
+
+    const int numSamples = buffer.getNumSamples();
+    for (auto* smoother : { &inputTrimGain, &mixAmount, &outputTrimGain })
+        smoother->update();
+
+    inputTrimGain.applyGain (buffer, numSamples);
 
-    buffer.applyGain (inputGain);
-    if (bypassed)
+    if (! bypass.begin (buffer, numSamples, bypassed))
         return;
 
-    for (int ch = 0; ch < buffer.getNumChannels(); ++ch)
+    oversampler.process (buffer, [&] (juce::dsp::AudioBlock<float>& block)
     {
-        auto* writePtr = buffer.getWritePointer (ch);
-        auto* dryPtr   = dryBuffer.getReadPointer (ch);
-        auto& hpFilter = highBandFilters[ch];
-        auto& lpFilter = smoothingFilters[ch];
+        const auto* mixes = mixAmount.advance ((int) block.getNumSamples());
+        const float mix = mixAmount.getCurrentValue();
 
-        for (int sample = 0; sample < buffer.getNumSamples(); ++sample)
+        for (size_t ch = 0; ch < block.getNumChannels(); ++ch)
         {
-            const float drySample  = dryPtr[sample];
-            const float highBand   = hpFilter.processSample (drySample);
-            const float harmonics  = lpFilter.processSample (generateHarmonics (highBand, amount, blend));
-            const float wetSample  = drySample + harmonics;
-            writePtr[sample] = (wetSample * mix + drySample * (1.0f - mix)) * outputGain;
+            auto* writePtr = block.getChannelPointer (ch);
+            auto& hpFilter = highBandFilters[ch];
+            auto& lpFilter = smoothingFilters[ch];
+
+            for (size_t sample = 0; sample < block.getNumSamples(); ++sample)
+            {
+                const float drySample  = writePtr[sample];
+                const float highBand   = hpFilter.processSample (drySample);
+                const float harmonics  = lpFilter.processSample (generateHarmonics (highBand, amount, blend));
+                const float wetSample  = drySample + harmonics;
+                const float wetAmount  = mixes != nullptr ? mixes[sample] : mix;
+                writePtr[sample] = wetSample * wetAmount + drySample * (1.0f - wetAmount);
+            }
         }
-    }
+    });
+
+    outputTrimGain.applyGain (buffer, numSamples);
+    bypass.end (buffer, numSamples);
 }
 
 void GRDTopFizzAudioProcessor::getStateInformation (juce::MemoryBlock& destData)
@@ -136,39 +181,13 @@ juce::AudioProcessorValueTreeState::ParameterLayout
 GRDTopFizzAudioProcessor::createParameterLayout()
 {
     std::vector<std::unique_ptr<juce::RangedAudioParameter>> params;
-
-    params.push_back (std::make_unique<juce::AudioParameterFloat> (
-        paramFreqId, "Freq",
-        juce::NormalisableRange<float> (2000.0f, 16000.0f, 1.0f, 0.45f), 8000.0f));
-
-    params.push_back (std::make_unique<juce::AudioParameterFloat> (
-        paramAmountId, "Amount",
-        juce::NormalisableRange<float> (0.0f, 1.0f, 0.0001f), 0.5f));
-
-    params.push_back (std::make_unique<juce::AudioParameterFloat> (
-        paramOddEvenBlendId, "Odd/Even",
-        juce::NormalisableRange<float> (0.0f, 1.0f, 0.0001f), 0.5f));
-
-    params.push_back (std::make_unique<juce::AudioParameterFloat> (
-        paramDeHarshId, "DeHarsh",
-        juce::NormalisableRange<float> (0.0f, 1.0f, 0.0001f), 0.5f));
-
-    params.push_back (std::make_unique<juce::AudioParameterFloat> (
-        paramMixId, "Mix",
-        juce::NormalisableRange<float> (0.0f, 1.0f, 0.0001f), 0.5f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> (
-        paramInputId, "Input Trim",
-        juce::NormalisableRange<float> (-18.0f, 18.0f, 0.1f), 0.0f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> (
-        paramOutputId, "Output Trim",
-        juce::NormalisableRange<float> (-18.0f, 18.0f, 0.1f), 0.0f));
-    params.push_back (std::make_unique<juce::AudioParameterBool> (
-        paramBypassId, "Soft Bypass", false));
+    gls::addParameters (params, parameterTable);
+    gls::dsp::Oversampler<float>::addParameters (params);
 
     return { params.begin(), params.end() };
 }
 
-void GRDTopFizzAudioProcessor::ensureStateSize (int numChannels, int numSamples)
+void GRDTopFizzAudioProcessor::ensureStateSize (int numChannels)
 {
     if ((int) highBandFilters.size() < numChannels)
     {
@@ -180,24 +199,25 @@ void GRDTopFizzAudioProcessor::ensureStateSize (int numChannels, int numSamples)
             smoothingFilters[i].reset();
         }
     }
-
-    if ((int) dryBuffer.getNumChannels() != numChannels || (int) lastBlockSize != numSamples)
-    {
-        dryBuffer.setSize (numChannels, numSamples, false, false, true);
-        lastBlockSize = static_cast<juce::uint32> (numSamples);
-    }
 }
 
-void GRDTopFizzAudioProcessor::updateFilters (float bandFreq, float smoothFreq)
+void GRDTopFizzAudioProcessor::updateFilters (float bandFreq, float smoothFreq, double processingRate)
 {
-    auto hpCoeffs = juce::dsp::IIR::Coefficients<float>::makeHighPass (currentSampleRate, bandFreq, 0.707f);
-    auto lpCoeffs = juce::dsp::IIR::Coefficients<float>::makeLowPass (currentSampleRate, smoothFreq, 0.707f);
 
     for (auto& filter : highBandFilters)
-        filter.coefficients = hpCoeffs;
+        filter.setHighPass (processingRate, bandFreq, 0.707f);
 
     for (auto& filter : smoothingFilters)
-        filter.coefficients = lpCoeffs;
+        filter.setLowPass (processingRate, smoothFreq, 0.707f);
+}
+
+void GRDTopFizzAudioProcessor::updateOversampling()
+{
+    oversampler.update (isNonRealtime(), currentSampleRate, { &mixAmount });
+
+    latency.setStage (0, oversampler.getLatencySamples(), oversampler.getLatencySamples());
+    latency.update();
+    bypass.setLatency (oversampler.getLatencySamples());
 }
 
 float GRDTopFizzAudioProcessor::generateHarmonics (float input, float amount, float blend) const
@@ -220,7 +240,8 @@ juce::AudioProcessorEditor* GRDTopFizzAudioProcessor::createEditor()
 GRDTopFizzAudioProcessorEditor::GRDTopFizzAudioProcessorEditor (GRDTopFizzAudioProcessor& p)
     : juce::AudioProcessorEditor (&p), processorRef (p),
       accentColour (gls::ui::accentForFamily ("GRD")),
-      headerComponent ("GRD.TopFizz", "Top Fizz")
+      headerComponent ("GRD.TopFizz", "Top Fizz"),
+      oversamplingSelector (p.getValueTreeState())
 {
     lookAndFeel.setAccentColour (accentColour);
     setLookAndFeel (&lookAndFeel);
@@ -249,6 +270,7 @@ GRDTopFizzAudioProcessorEditor::GRDTopFizzAudioProcessorEditor (GRDTopFizzAudioP
     attachments.push_back (std::make_unique<SliderAttachment> (state, paramInputId, inputTrimSlider));
     attachments.push_back (std::make_unique<SliderAttachment> (state, paramOutputId, outputTrimSlider));
     buttonAttachments.push_back (std::make_unique<juce::AudioProcessorValueTreeState::ButtonAttachment> (state, paramBypassId, bypassButton));
+    addAndMakeVisible (oversamplingSelector);
 
     setSize (760, 420);
 }
@@ -282,7 +304,9 @@ void GRDTopFizzAudioProcessorEditor::resized()
     inputTrimSlider .setBounds (bottom.removeFromLeft (bottomWidth).reduced (8));
     outputTrimSlider.setBounds (bottom.removeFromLeft (bottomWidth).reduced (8));
 
-    bypassButton.setBounds (footerComponent.getBounds().reduced (24, 12));
+    auto footer = footerComponent.getBounds().reduced (24, 12);
+    oversamplingSelector.setBounds (footer.removeFromRight (300));
+    bypassButton.setBounds (footer);
     layoutLabels();
 }
 
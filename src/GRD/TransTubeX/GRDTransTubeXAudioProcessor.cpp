@@ -11,6 +11,22 @@ constexpr auto paramInput      = "input_trim";
 constexpr auto paramOutput     = "output_trim";
 constexpr auto paramBypass     = "ui_bypass";
 constexpr auto kStateId        = "TRANS_TUBE_X";
+
+using Param = GRDTransTubeXAudioProcessor::Param;
+using Spec = gls::ParameterSpec;
+
+constexpr std::array<Spec, (size_t) Param::count> parameterTable {{
+    Spec::range  (paramDrive,      "Drive",       0.0f,   1.0f,     0.0001f, 0.6f),
+    Spec::range  (paramTransSens,  "Trans Sens",  0.0f,   1.0f,     0.0001f, 0.5f),
+    Spec::range  (paramAttackBias, "Attack Bias", 0.0f,   1.0f,     0.0001f, 0.5f),
+    Spec::range  (paramTone,       "Tone",        500.0f, 12000.0f, 1.0f,    6000.0f, 0.4f),
+    Spec::range  (paramMix,        "Mix",         0.0f,   1.0f,     0.0001f, 0.5f),
+    Spec::range  (paramInput,      "Input Trim",  -18.0f, 18.0f,    0.1f,    0.0f),
+    Spec::range  (paramOutput,     "Output Trim", -18.0f, 18.0f,    0.1f,    0.0f),
+    Spec::toggle (paramBypass,     "Soft Bypass", false)
+}};
+
+static_assert (gls::hasUniqueIds (parameterTable));
 }
 
 const std::array<GRDTransTubeXAudioProcessor::Preset, 3> GRDTransTubeXAudioProcessor::presetBank {{
@@ -50,25 +66,44 @@ GRDTransTubeXAudioProcessor::GRDTransTubeXAudioProcessor()
     : DualPrecisionAudioProcessor (BusesProperties()
                         .withInput  ("Input", juce::AudioChannelSet::stereo(), true)
                         .withOutput ("Output", juce::AudioChannelSet::stereo(), true)),
-      apvts (*this, nullptr, kStateId, createParameterLayout())
+      apvts (*this, nullptr, kStateId, createParameterLayout()),
+      params (apvts, parameterTable)
 {
+    oversampler.attach (apvts);
+    bypass.snapOnResume ({ &mixAmount, &outputTrimGain });
 }
 
-void GRDTransTubeXAudioProcessor::prepareToPlay (double sampleRate, int /*samplesPerBlock*/)
+void GRDTransTubeXAudioProcessor::prepareToPlay (double sampleRate, int samplesPerBlock)
 {
+    DualPrecisionAudioProcessor::prepareToPlay (sampleRate, samplesPerBlock);
+
     currentSampleRate = juce::jmax (44100.0, sampleRate);
     trackers.clear();
     toneFilters.clear();
-    dryBuffer.setSize (getTotalNumOutputChannels(), 0);
+    ensureStateSize (juce::jmax (1, getTotalNumInputChannels(), getTotalNumOutputChannels()));
+
+    oversampler.prepare (juce::jmax (1, getTotalNumOutputChannels()), samplesPerBlock);
+    bypass.prepare (currentSampleRate, juce::jmax (getTotalNumInputChannels(), getTotalNumOutputChannels()), samplesPerBlock,
+                    oversampler.getMaximumLatencySamples());
+    mixAmount.prepare (currentSampleRate * oversampler.getFactor(), samplesPerBlock << gls::dsp::Oversampler<float>::maxFactorLog2);
+
+    for (auto* smoother : { &inputTrimGain, &outputTrimGain })
+        smoother->prepare (currentSampleRate, samplesPerBlock);
+
+    latency.invalidate();
+    updateOversampling();
 }
 
 void GRDTransTubeXAudioProcessor::releaseResources()
 {
 }
 
-void GRDTransTubeXAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer,
-                                                juce::MidiBuffer&)
+void GRDTransTubeXAudioProcessor::processFloat (juce::AudioBuffer<float>& buffer,
+                                                juce::MidiBuffer& midi)
 {
+    if (renderInPreparedChunks (buffer, midi))
+        return;
+
     juce::ScopedNoDenormals noDenormals;
 
     const auto totalIn  = getTotalNumInputChannels();
@@ -76,52 +111,72 @@ void GRDTransTubeXAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer
     for (int ch = totalIn; ch < totalOut; ++ch)
         buffer.clear (ch, 0, buffer.getNumSamples());
 
-    ensureStateSize (buffer.getNumChannels(), buffer.getNumSamples());
-    dryBuffer.makeCopyOf (buffer, true);
+    ensureStateSize (buffer.getNumChannels());
 
-    const auto drive     = juce::jlimit (0.0f, 1.0f, apvts.getRawParameterValue (paramDrive)->load());
-    const auto sens      = juce::jlimit (0.0f, 1.0f, apvts.getRawParameterValue (paramTransSens)->load());
-    const auto attack    = juce::jlimit (0.0f, 1.0f, apvts.getRawParameterValue (paramAttackBias)->load());
-    const auto toneHz    = juce::jlimit (500.0f, 12000.0f, apvts.getRawParameterValue (paramTone)->load());
-    const auto mix       = juce::jlimit (0.0f, 1.0f, apvts.getRawParameterValue (paramMix)->load());
-    const auto inputGain = juce::Decibels::decibelsToGain (apvts.getRawParameterValue (paramInput)->load());
-    const auto outputGain= juce::Decibels::decibelsToGain (apvts.getRawParameterValue (paramOutput)->load());
-    const bool bypassed  = apvts.getRawParameterValue (paramBypass)->load() > 0.5f;
-
-    buffer.applyGain (inputGain);
-    if (bypassed)
-        return;
+    const auto drive     = juce::jlimit (0.0f, 1.0f, params[Param::drive]);
+    const auto sens      = juce::jlimit (0.0f, 1.0f, params[Param::transSens]);
+    const auto attack    = juce::jlimit (0.0f, 1.0f, params[Param::attackBias]);
+    const auto toneHz    = juce::jlimit (500.0f, 12000.0f, params[Param::tone]);
+    const bool bypassed  = params.isOn (Param::bypass);
 
     const float driveGain = juce::jmap (drive, 1.0f, 18.0f);
     const float transientScale = juce::jmap (sens, 0.0f, 1.0f, 0.0f, 4.0f);
     const float attackBlend = juce::jmap (attack, 0.0f, 1.0f, 0.2f, 0.95f);
 
-    auto coeffs = juce::dsp::IIR::Coefficients<float>::makeLowPass (currentSampleRate, toneHz, 0.707f);
+    updateOversampling();
+    const auto processingRate = currentSampleRate * oversampler.getFactor();
+
+    // Envelope times are in ms, so the trackers follow the oversampled rate.
+    if (! juce::approximatelyEqual (trackerSampleRate, processingRate))
+    {
+        for (auto& tracker : trackers)
+            tracker.setSampleRate (processingRate);
+        trackerSampleRate = processingRate;
+    }
+
     for (auto& filter : toneFilters)
-        filter.coefficients = coeffs;
+        filter.setLowPass (processingRate, toneHz, 0.707f);
+
+    const int numSamples = buffer.getNumSamples();
+    for (auto* smoother : { &inputTrimGain, &mixAmount, &outputTrimGain })
+        smoother->update();
 
-    for (int ch = 0; ch < buffer.getNumChannels(); ++ch)
+    inputTrimGain.applyGain (buffer, numSamples);
+
+    if (! bypass.begin (buffer, numSamples, bypassed))
+        return;
+
+    oversampler.process (buffer, [&] (juce::dsp::AudioBlock<float>& block)
     {
-        auto* writePtr = buffer.getWritePointer (ch);
-        auto* dryPtr   = dryBuffer.getReadPointer (ch);
-        auto& tracker  = trackers[(size_t) ch];
-        auto& toneFilter = toneFilters[(size_t) ch];
+        const auto* mixes = mixAmount.advance ((int) block.getNumSamples());
+        const float mix = mixAmount.getCurrentValue();
 
-        for (int sample = 0; sample < buffer.getNumSamples(); ++sample)
+        for (size_t ch = 0; ch < block.getNumChannels(); ++ch)
         {
-            const float drySample = dryPtr[sample];
-            const float transient = tracker.process (drySample) * transientScale;
+            auto* writePtr = block.getChannelPointer (ch);
+            auto& tracker  = trackers[ch];
+            auto& toneFilter = toneFilters[ch];
 
-            const float driveMod = 1.0f + transient * attackBlend;
-            const float attacked = drySample * (1.0f + transient * (1.0f - attackBlend));
-            const float tubeIn   = attacked * driveGain * driveMod;
+            for (size_t sample = 0; sample < block.getNumSamples(); ++sample)
+            {
+                const float drySample = writePtr[sample];
+                const float transient = tracker.process (drySample) * transientScale;
 
-            float shaped = juce::dsp::FastMathApproximations::tanh (tubeIn);
-            shaped = toneFilter.processSample (shaped);
+                const float driveMod = 1.0f + transient * attackBlend;
+                const float attacked = drySample * (1.0f + transient * (1.0f - attackBlend));
+                const float tubeIn   = attacked * driveGain * driveMod;
 
-            writePtr[sample] = (shaped * mix + drySample * (1.0f - mix)) * outputGain;
+                float shaped = juce::dsp::FastMathApproximations::tanh (tubeIn);
+                shaped = toneFilter.processSample (shaped);
+
+                const float amount = mixes != nullptr ? mixes[sample] : mix;
+                writePtr[sample] = shaped * amount + drySample * (1.0f - amount);
+            }
         }
-    }
+    });
+
+    outputTrimGain.applyGain (buffer, numSamples);
+    bypass.end (buffer, numSamples);
 }
 
 void GRDTransTubeXAudioProcessor::getStateInformation (juce::MemoryBlock& destData)
@@ -141,42 +196,13 @@ juce::AudioProcessorValueTreeState::ParameterLayout
 GRDTransTubeXAudioProcessor::createParameterLayout()
 {
     std::vector<std::unique_ptr<juce::RangedAudioParameter>> params;
-
-    params.push_back (std::make_unique<juce::AudioParameterFloat> (
-        paramDrive, "Drive",
-        juce::NormalisableRange<float> (0.0f, 1.0f, 0.0001f), 0.6f));
-
-    params.push_back (std::make_unique<juce::AudioParameterFloat> (
-        paramTransSens, "Trans Sens",
-        juce::NormalisableRange<float> (0.0f, 1.0f, 0.0001f), 0.5f));
-
-    params.push_back (std::make_unique<juce::AudioParameterFloat> (
-        paramAttackBias, "Attack Bias",
-        juce::NormalisableRange<float> (0.0f, 1.0f, 0.0001f), 0.5f));
-
-    params.push_back (std::make_unique<juce::AudioParameterFloat> (
-        paramTone, "Tone",
-        juce::NormalisableRange<float> (500.0f, 12000.0f, 1.0f, 0.4f), 6000.0f));
-
-    params.push_back (std::make_unique<juce::AudioParameterFloat> (
-        paramMix, "Mix",
-        juce::NormalisableRange<float> (0.0f, 1.0f, 0.0001f), 0.5f));
-
-    params.push_back (std::make_unique<juce::AudioParameterFloat> (
-        paramInput, "Input Trim",
-        juce::NormalisableRange<float> (-18.0f, 18.0f, 0.1f), 0.0f));
-
-    params.push_back (std::make_unique<juce::AudioParameterFloat> (
-        paramOutput, "Output Trim",
-        juce::NormalisableRange<float> (-18.0f, 18.0f, 0.1f), 0.0f));
-
-    params.push_back (std::make_unique<juce::AudioParameterBool> (
-        paramBypass, "Soft Bypass", false));
+    gls::addParameters (params, parameterTable);
+    gls::dsp::Oversampler<float>::addParameters (params);
 
     return { params.begin(), params.end() };
 }
 
-void GRDTransTubeXAudioProcessor::ensureStateSize (int numChannels, int numSamples)
+void GRDTransTubeXAudioProcessor::ensureStateSize (int numChannels)
 {
     if ((int) trackers.size() < numChannels)
     {
@@ -187,6 +213,7 @@ void GRDTransTubeXAudioProcessor::ensureStateSize (int numChannels, int numSampl
             tracker.setTimes (2.0f, 40.0f);
             tracker.reset();
         }
+        trackerSampleRate = currentSampleRate;
     }
 
     if ((int) toneFilters.size() < numChannels)
@@ -195,10 +222,15 @@ void GRDTransTubeXAudioProcessor::ensureStateSize (int numChannels, int numSampl
         for (auto& filter : toneFilters)
             filter.reset();
     }
+}
+
+void GRDTransTubeXAudioProcessor::updateOversampling()
+{
+    oversampler.update (isNonRealtime(), currentSampleRate, { &mixAmount });
 
-    if ((int) dryBuffer.getNumChannels() != numChannels
-        || dryBuffer.getNumSamples() != numSamples)
-        dryBuffer.setSize (numChannels, numSamples, false, false, true);
+    latency.setStage (0, oversampler.getLatencySamples(), oversampler.getLatencySamples());
+    latency.update();
+    bypass.setLatency (oversampler.getLatencySamples());
 }
 
 juce::AudioProcessorEditor* GRDTransTubeXAudioProcessor::createEditor()
@@ -210,7 +242,8 @@ juce::AudioProcessorEditor* GRDTransTubeXAudioProcessor::createEditor()
 GRDTransTubeXAudioProcessorEditor::GRDTransTubeXAudioProcessorEditor (GRDTransTubeXAudioProcessor& p)
     : juce::AudioProcessorEditor (&p), processorRef (p),
       accentColour (gls::ui::accentForFamily ("GRD")),
-      headerComponent ("GRD.TransTubeX", "Trans Tube X")
+      headerComponent ("GRD.TransTubeX", "Trans Tube X"),
+      oversamplingSelector (p.getValueTreeState())
 {
     lookAndFeel.setAccentColour (accentColour);
     setLookAndFeel (&lookAndFeel);
@@ -238,6 +271,7 @@ GRDTransTubeXAudioProcessorEditor::GRDTransTubeXAudioProcessorEditor (GRDTransTu
     attachments.push_back (std::make_unique<SliderAttachment> (state, paramInput, inputTrimSlider));
     attachments.push_back (std::make_unique<SliderAttachment> (state, paramOutput, outputTrimSlider));
     bypassAttachment = std::make_unique<juce::AudioProcessorValueTreeState::ButtonAttachment> (state, paramBypass, bypassButton);
+    addAndMakeVisible (oversamplingSelector);
 
     setSize (760, 420);
 }
@@ -271,7 +305,9 @@ void GRDTransTubeXAudioProcessorEditor::resized()
     inputTrimSlider  .setBounds (bottom.removeFromLeft (bottomWidth).reduced (8));
     outputTrimSlider .setBounds (bottom.removeFromLeft (bottomWidth).reduced (8));
 
-    bypassButton.setBounds (footerComponent.getBounds().reduced (24, 12));
+    auto footer = footerComponent.getBounds().reduced (24, 12);
+    oversamplingSelector.setBounds (footer.removeFromRight (300));
+    bypassButton.setBounds (footer);
     layoutLabels();
 }
 
@@ -1,26 +1,71 @@
 #include "GRDTubeLineAudioProcessor.h"
 
+namespace
+{
+using Param = GRDTubeLineAudioProcessor::Param;
+using Spec = gls::ParameterSpec;
+
+constexpr std::array<Spec, (size_t) Param::count> parameterTable {{
+    Spec::range ("input_trim",  "Input Trim",  -12.0f, 12.0f, 0.01f,  0.0f),
+    Spec::range ("bias",        "Bias",        0.0f,   1.0f,  0.001f, 0.5f),
+    Spec::range ("character",   "Character",   0.0f,   1.0f,  0.001f, 0.4f),
+    Spec::range ("mix",         "Mix",         0.0f,   1.0f,  0.001f, 0.7f),
+    Spec::range ("output_trim", "Output Trim", -12.0f, 12.0f, 0.01f,  0.0f)
+}};
+
+static_assert (gls::hasUniqueIds (parameterTable));
+} // namespace
+
 GRDTubeLineAudioProcessor::GRDTubeLineAudioProcessor()
-    : DualPrecisionAudioProcessor (BusesProperties()
+    : NativePrecisionAudioProcessor (BusesProperties()
                         .withInput  ("Input", juce::AudioChannelSet::stereo(), true)
                         .withOutput ("Output", juce::AudioChannelSet::stereo(), true)),
-      apvts (*this, nullptr, "TUBE_LINE", createParameterLayout())
+      apvts (*this, nullptr, "TUBE_LINE", createParameterLayout()),
+      params (apvts, parameterTable)
 {
+    floatOversampler.attach (apvts);
+    doubleOversampler.attach (apvts);
 }
 
 void GRDTubeLineAudioProcessor::prepareToPlay (double sampleRate, int samplesPerBlock)
 {
+    DualPrecisionAudioProcessor::prepareToPlay (sampleRate, samplesPerBlock);
+
     currentSampleRate = sampleRate > 0.0 ? sampleRate : 44100.0;
     lastBlockSize = (juce::uint32) juce::jmax (1, samplesPerBlock);
+
+    // Only the stage matching the host's precision is built; the other stays empty.
+    const auto numChannels = juce::jmax (1, getTotalNumOutputChannels());
+    latency.invalidate();
+
+    if (isUsingDoublePrecision())
+    {
+        doubleOversampler.prepare (numChannels, samplesPerBlock);
+        updateOversampling<double>();
+    }
+    else
+    {
+        floatOversampler.prepare (numChannels, samplesPerBlock);
+        updateOversampling<float>();
+    }
+
+    // The gains ramp inside the oversampled callback, at whichever rate it runs.
+    const auto factor = isUsingDoublePrecision() ? doubleOversampler.getFactor() : floatOversampler.getFactor();
+    for (auto* smoother : { &inputTrimGain, &mixAmount, &outputTrimGain })
+        smoother->prepare (currentSampleRate * factor, samplesPerBlock << gls::dsp::Oversampler<float>::maxFactorLog2);
 }
 
 void GRDTubeLineAudioProcessor::releaseResources()
 {
 }
 
-void GRDTubeLineAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer,
-                                              juce::MidiBuffer&)
+template <typename SampleType>
+void GRDTubeLineAudioProcessor::processSamples (juce::AudioBuffer<SampleType>& buffer,
+                                                juce::MidiBuffer& midi)
 {
+    if (renderInPreparedChunks (buffer, midi))
+        return;
+
     juce::ScopedNoDenormals noDenormals;
 
     const auto totalIn  = getTotalNumInputChannels();
@@ -33,31 +78,58 @@ void GRDTubeLineAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer,
     if (numChannels == 0 || numSamples == 0)
         return;
 
-    auto get = [this](const char* id) { return apvts.getRawParameterValue (id)->load(); };
+    const auto one        = (SampleType) 1;
+    const auto bias       = juce::jlimit ((SampleType) 0, one, (SampleType) params[Param::bias]);
+    const auto character  = juce::jlimit ((SampleType) 0, one, (SampleType) params[Param::character]);
 
-    const float inputTrim = juce::Decibels::decibelsToGain (juce::jlimit (-12.0f, 12.0f, get ("input_trim")));
-    const float bias      = juce::jlimit (0.0f, 1.0f, get ("bias"));
-    const float character = juce::jlimit (0.0f, 1.0f, get ("character"));
-    const float mix       = juce::jlimit (0.0f, 1.0f, get ("mix"));
-    const float outputTrim= juce::Decibels::decibelsToGain (juce::jlimit (-12.0f, 12.0f, get ("output_trim")));
+    updateOversampling<SampleType>();
 
-    juce::AudioBuffer<float> dry;
-    dry.makeCopyOf (buffer, true);
+    for (auto* smoother : { &inputTrimGain, &mixAmount, &outputTrimGain })
+        smoother->update();
 
-    for (int ch = 0; ch < numChannels; ++ch)
+    // The shaper is memoryless, so the dry sample is read in place instead of from a copy;
+    // both run at the oversampled rate, which keeps them aligned through the resampling filters.
+    getOversampler<SampleType>().process (buffer, [&] (juce::dsp::AudioBlock<SampleType>& block)
     {
-        auto* data = buffer.getWritePointer (ch);
-
-        for (int i = 0; i < numSamples; ++i)
+        const auto blockSamples = (int) block.getNumSamples();
+        const auto* inputTrims  = inputTrimGain.advance (blockSamples);
+        const auto* mixes       = mixAmount.advance (blockSamples);
+        const auto* outputTrims = outputTrimGain.advance (blockSamples);
+        const auto inputTrim    = (SampleType) inputTrimGain.getCurrentValue();
+        const auto mix          = (SampleType) mixAmount.getCurrentValue();
+        const auto outputTrim   = (SampleType) outputTrimGain.getCurrentValue();
+
+        for (size_t ch = 0; ch < block.getNumChannels(); ++ch)
         {
-            const float input = dry.getSample (ch, i) * inputTrim;
-            const float asym  = input + bias * 0.5f;
-            float soft = std::tanh (asym * (1.0f + character * 4.0f));
-            float hard = juce::jlimit (-1.0f, 1.0f, asym * (1.0f + character * 8.0f));
-            const float shaped = juce::jmap (character, soft, hard);
-            data[i] = juce::jmap (mix, dry.getSample (ch, i), shaped) * outputTrim;
+            auto* data = block.getChannelPointer (ch);
+
+            for (int i = 0; i < blockSamples; ++i)
+            {
+                const auto dry    = data[i];
+                const auto input  = dry * (inputTrims != nullptr ? (SampleType) inputTrims[i] : inputTrim);
+                const auto asym   = input + bias * (SampleType) 0.5;
+                const auto soft   = std::tanh (asym * (one + character * (SampleType) 4));
+                const auto hard   = juce::jlimit (-one, one, asym * (one + character * (SampleType) 8));
+                const auto shaped = juce::jmap (character, soft, hard);
+                const auto amount = mixes != nullptr ? (SampleType) mixes[i] : mix;
+                data[i] = juce::jmap (amount, dry, shaped) * (outputTrims != nullptr ? (SampleType) outputTrims[i] : outputTrim);
+            }
         }
-    }
+    });
+}
+
+template void GRDTubeLineAudioProcessor::processSamples<float>  (juce::AudioBuffer<float>&,  juce::MidiBuffer&);
+template void GRDTubeLineAudioProcessor::processSamples<double> (juce::AudioBuffer<double>&, juce::MidiBuffer&);
+
+template <typename SampleType>
+void GRDTubeLineAudioProcessor::updateOversampling()
+{
+    auto& oversampler = getOversampler<SampleType>();
+
+    oversampler.update (isNonRealtime(), currentSampleRate, { &inputTrimGain, &mixAmount, &outputTrimGain });
+
+    latency.setStage (0, oversampler.getLatencySamples(), oversampler.getLatencySamples());
+    latency.update();
 }
 
 void GRDTubeLineAudioProcessor::getStateInformation (juce::MemoryBlock& destData)
@@ -77,23 +149,15 @@ juce::AudioProcessorValueTreeState::ParameterLayout
 GRDTubeLineAudioProcessor::createParameterLayout()
 {
     std::vector<std::unique_ptr<juce::RangedAudioParameter>> params;
-
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("input_trim", "Input Trim",
-                                                                   juce::NormalisableRange<float> (-12.0f, 12.0f, 0.01f), 0.0f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("bias", "Bias",
-                                                                   juce::NormalisableRange<float> (0.0f, 1.0f, 0.001f), 0.5f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("character", "Character",
-                                                                   juce::NormalisableRange<float> (0.0f, 1.0f, 0.001f), 0.4f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("mix", "Mix",
-                                                                   juce::NormalisableRange<float> (0.0f, 1.0f, 0.001f), 0.7f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("output_trim", "Output Trim",
-                                                                   juce::NormalisableRange<float> (-12.0f, 12.0f, 0.01f), 0.0f));
+    gls::addParameters (params, parameterTable);
+    gls::dsp::Oversampler<float>::addParameters (params);
 
     return { params.begin(), params.end() };
 }
 
 GRDTubeLineAudioProcessorEditor::GRDTubeLineAudioProcessorEditor (GRDTubeLineAudioProcessor& processor)
-    : juce::AudioProcessorEditor (&processor), processorRef (processor)
+    : juce::AudioProcessorEditor (&processor), processorRef (processor),
+      oversamplingSelector (processor.getValueTreeState())
 {
     auto make = [this](juce::Slider& slider, const juce::String& label) { initSlider (slider, label); };
     make (inputTrimSlider,   "Input Trim");
@@ -109,7 +173,8 @@ GRDTubeLineAudioProcessorEditor::GRDTubeLineAudioProcessorEditor (GRDTubeLineAud
     for (int i = 0; i < ids.size(); ++i)
         attachments.push_back (std::make_unique<SliderAttachment> (state, ids[i], *sliders[i]));
 
-    setSize (640, 260);
+    addAndMakeVisible (oversamplingSelector);
+    setSize (640, 290);
 }
 
 void GRDTubeLineAudioProcessorEditor::initSlider (juce::Slider& slider, const juce::String& label)
@@ -131,6 +196,7 @@ void GRDTubeLineAudioProcessorEditor::paint (juce::Graphics& g)
 void GRDTubeLineAudioProcessorEditor::resized()
 {
     auto area = getLocalBounds().reduced (10);
+    oversamplingSelector.setBounds (area.removeFromBottom (28).removeFromRight (300));
     auto width = area.getWidth() / 5;
 
     inputTrimSlider .setBounds (area.removeFromLeft (width).reduced (8));
@@ -1,17 +1,31 @@
 #pragma once
 
 #include <JuceHeader.h>
+#include <array>
 #include "../../DualPrecisionAudioProcessor.h"
+#include "../../ParameterTable.h"
+#include "../../SmoothedParameter.h"
+#include "../../dsp/LatencyReporter.h"
+#include "../../dsp/Oversampler.h"
+#include "../../ui/OversamplingSelector.h"
 
-class GRDTubeLineAudioProcessor : public DualPrecisionAudioProcessor
+class GRDTubeLineAudioProcessor : public NativePrecisionAudioProcessor<GRDTubeLineAudioProcessor>
 {
 public:
+    enum class Param
+    {
+        inputTrim, bias, character, mix, outputTrim,
+        count
+    };
+
     GRDTubeLineAudioProcessor();
     ~GRDTubeLineAudioProcessor() override = default;
 
     void prepareToPlay (double sampleRate, int samplesPerBlock) override;
     void releaseResources() override;
-    void processBlock (juce::AudioBuffer<float>&, juce::MidiBuffer&) override;
+
+    template <typename SampleType>
+    void processSamples (juce::AudioBuffer<SampleType>&, juce::MidiBuffer&);
 
     juce::AudioProcessorEditor* createEditor() override;
     bool hasEditor() const override { return true; }
@@ -20,7 +34,6 @@ public:
     bool acceptsMidi() const override { return false; }
     bool producesMidi() const override { return false; }
     bool isMidiEffect() const override { return false; }
-    double getTailLengthSeconds() const override { return 0.0; }
 
     int getNumPrograms() override { return 1; }
     int getCurrentProgram() override { return 0; }
@@ -36,9 +49,28 @@ public:
 
 private:
     juce::AudioProcessorValueTreeState apvts;
+    gls::ParameterHandles<Param> params;
+    gls::SmoothedParameter inputTrimGain  { params, Param::inputTrim,   gls::SmoothedParameter::Mapping::decibels };
+    gls::SmoothedParameter mixAmount      { params, Param::mix };
+    gls::SmoothedParameter outputTrimGain { params, Param::outputTrim,  gls::SmoothedParameter::Mapping::decibels };
+    gls::dsp::Oversampler<float> floatOversampler;
+    gls::dsp::Oversampler<double> doubleOversampler;
+    gls::dsp::LatencyReporter latency { *this };
     double currentSampleRate = 44100.0;
     juce::uint32 lastBlockSize = 512;
 
+    template <typename SampleType>
+    gls::dsp::Oversampler<SampleType>& getOversampler() noexcept
+    {
+        if constexpr (std::is_same_v<SampleType, double>)
+            return doubleOversampler;
+        else
+            return floatOversampler;
+    }
+
+    template <typename SampleType>
+    void updateOversampling();
+
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (GRDTubeLineAudioProcessor)
 };
 
@@ -59,6 +91,7 @@ private:
     juce::Slider characterSlider;
     juce::Slider mixSlider;
     juce::Slider outputTrimSlider;
+    gls::ui::OversamplingSelector oversamplingSelector;
 
     using SliderAttachment = juce::AudioProcessorValueTreeState::SliderAttachment;
     std::vector<std::unique_ptr<SliderAttachment>> attachments;
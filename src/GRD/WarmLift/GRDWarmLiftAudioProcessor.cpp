@@ -6,6 +6,22 @@ constexpr auto kStateId     = "WARM_LIFT";
 constexpr auto kParamInput  = "input_trim";
 constexpr auto kParamOutput = "output_trim";
 constexpr auto kParamBypass = "ui_bypass";
+
+using Param = GRDWarmLiftAudioProcessor::Param;
+using Spec = gls::ParameterSpec;
+
+constexpr std::array<Spec, (size_t) Param::count> parameterTable {{
+    Spec::range  ("warmth",     "Warmth",      -12.0f, 12.0f,  0.01f,  4.0f),
+    Spec::range  ("shine",      "Shine",       -12.0f, 12.0f,  0.01f,  2.0f),
+    Spec::range  ("drive",      "Drive",       0.0f,   1.0f,   0.001f, 0.5f),
+    Spec::range  ("tighten",    "Tighten",     20.0f,  220.0f, 0.01f,  80.0f, 0.35f),
+    Spec::range  ("mix",        "Mix",         0.0f,   1.0f,   0.001f, 0.7f),
+    Spec::range  (kParamInput,  "Input Trim",  -18.0f, 18.0f,  0.1f,   0.0f),
+    Spec::range  (kParamOutput, "Output Trim", -18.0f, 18.0f,  0.1f,   0.0f),
+    Spec::toggle (kParamBypass, "Soft Bypass", false)
+}};
+
+static_assert (gls::hasUniqueIds (parameterTable));
 }
 
 const std::array<GRDWarmLiftAudioProcessor::Preset, 3> GRDWarmLiftAudioProcessor::presetBank {{
@@ -45,24 +61,43 @@ GRDWarmLiftAudioProcessor::GRDWarmLiftAudioProcessor()
     : DualPrecisionAudioProcessor (BusesProperties()
                         .withInput  ("Input", juce::AudioChannelSet::stereo(), true)
                         .withOutput ("Output", juce::AudioChannelSet::stereo(), true)),
-      apvts (*this, nullptr, kStateId, createParameterLayout())
+      apvts (*this, nullptr, kStateId, createParameterLayout()),
+      params (apvts, parameterTable)
 {
+    oversampler.attach (apvts);
+    bypass.snapOnResume ({ &mixAmount, &outputTrimGain });
 }
 
 void GRDWarmLiftAudioProcessor::prepareToPlay (double sampleRate, int samplesPerBlock)
 {
+    DualPrecisionAudioProcessor::prepareToPlay (sampleRate, samplesPerBlock);
+
     currentSampleRate = sampleRate > 0.0 ? sampleRate : 44100.0;
     lastBlockSize = (juce::uint32) juce::jmax (1, samplesPerBlock);
     ensureStateSize (juce::jmax (1, getTotalNumOutputChannels()));
+
+    oversampler.prepare (juce::jmax (1, getTotalNumOutputChannels()), samplesPerBlock);
+    bypass.prepare (currentSampleRate, juce::jmax (getTotalNumInputChannels(), getTotalNumOutputChannels()), samplesPerBlock,
+                    oversampler.getMaximumLatencySamples());
+    mixAmount.prepare (currentSampleRate * oversampler.getFactor(), samplesPerBlock << gls::dsp::Oversampler<float>::maxFactorLog2);
+
+    for (auto* smoother : { &inputTrimGain, &outputTrimGain })
+        smoother->prepare (currentSampleRate, samplesPerBlock);
+
+    latency.invalidate();
+    updateOversampling();
 }
 
 void GRDWarmLiftAudioProcessor::releaseResources()
 {
 }
 
-void GRDWarmLiftAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer,
-                                              juce::MidiBuffer&)
+void GRDWarmLiftAudioProcessor::processFloat (juce::AudioBuffer<float>& buffer,
+                                              juce::MidiBuffer& midi)
 {
+    if (renderInPreparedChunks (buffer, midi))
+        return;
+
     juce::ScopedNoDenormals noDenormals;
 
     const auto totalIn  = getTotalNumInputChannels();
@@ -75,47 +110,51 @@ void GRDWarmLiftAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer,
     if (numChannels == 0 || numSamples == 0)
         return;
 
-    auto get = [this](const char* id) { return apvts.getRawParameterValue (id)->load(); };
-
-    const float warmth  = juce::jlimit (-12.0f, 12.0f, get ("warmth"));
-    const float shine   = juce::jlimit (-12.0f, 12.0f, get ("shine"));
-    const float drive   = juce::jlimit (0.0f, 1.0f, get ("drive"));
-    const float tighten = juce::jlimit (20.0f, 220.0f, get ("tighten"));
-    const float mix     = juce::jlimit (0.0f, 1.0f, get ("mix"));
-    const float inputGain  = juce::Decibels::decibelsToGain (juce::jlimit (-18.0f, 18.0f, get (kParamInput)));
-    const float trim    = juce::Decibels::decibelsToGain (juce::jlimit (-18.0f, 18.0f, get (kParamOutput)));
-    const bool bypassed = get (kParamBypass) > 0.5f;
+    const float warmth  = juce::jlimit (-12.0f, 12.0f, params[Param::warmth]);
+    const float shine   = juce::jlimit (-12.0f, 12.0f, params[Param::shine]);
+    const float drive   = juce::jlimit (0.0f, 1.0f, params[Param::drive]);
+    const float tighten = juce::jlimit (20.0f, 220.0f, params[Param::tighten]);
+    const bool bypassed = params.isOn (Param::bypass);
 
     ensureStateSize (numChannels);
-    updateFilters (warmth, shine, tighten);
+    updateOversampling();
+    updateFilters (warmth, shine, tighten, currentSampleRate * oversampler.getFactor());
 
-    juce::AudioBuffer<float> dry;
-    dry.makeCopyOf (buffer, true);
+    const float driveGain = 1.0f + drive * 6.0f;
 
-    buffer.applyGain (inputGain);
-    if (bypassed)
-    {
-        buffer.applyGain (trim);
-        return;
-    }
+    for (auto* smoother : { &inputTrimGain, &mixAmount, &outputTrimGain })
+        smoother->update();
 
-    const float driveGain = 1.0f + drive * 6.0f;
+    inputTrimGain.applyGain (buffer, numSamples);
 
-    for (int ch = 0; ch < numChannels; ++ch)
+    if (! bypass.begin (buffer, numSamples, bypassed))
+        return;
+
+    oversampler.process (buffer, [&] (juce::dsp::AudioBlock<float>& block)
     {
-        auto* data = buffer.getWritePointer (ch);
-        auto& state = channelState[ch];
+        const auto blockSamples = (int) block.getNumSamples();
+        const auto* mixes = mixAmount.advance (blockSamples);
+        const float mix = mixAmount.getCurrentValue();
 
-        for (int i = 0; i < numSamples; ++i)
+        for (size_t ch = 0; ch < block.getNumChannels(); ++ch)
         {
-            const float input = dry.getSample (ch, i);
-            float sample = state.tightenFilter.processSample (input);
-            sample = state.warmthShelf.processSample (sample);
-            sample = state.shineShelf.processSample (sample);
-            const float shaped = std::tanh (sample * driveGain);
-            data[i] = juce::jmap (mix, input, shaped) * trim;
+            auto* data = block.getChannelPointer (ch);
+            auto& state = channelState[ch];
+
+            for (int i = 0; i < blockSamples; ++i)
+            {
+                const float input = data[i];
+                float sample = state.tightenFilter.processSample (input);
+                sample = state.warmthShelf.processSample (sample);
+                sample = state.shineShelf.processSample (sample);
+                const float shaped = std::tanh (sample * driveGain);
+                data[i] = juce::jmap (mixes != nullptr ? mixes[i] : mix, input, shaped);
+            }
         }
-    }
+    });
+
+    outputTrimGain.applyGain (buffer, numSamples);
+    bypass.end (buffer, numSamples);
 }
 
 void GRDWarmLiftAudioProcessor::getStateInformation (juce::MemoryBlock& destData)
@@ -135,22 +174,8 @@ juce::AudioProcessorValueTreeState::ParameterLayout
 GRDWarmLiftAudioProcessor::createParameterLayout()
 {
     std::vector<std::unique_ptr<juce::RangedAudioParameter>> params;
-
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("warmth", "Warmth",
-                                                                   juce::NormalisableRange<float> (-12.0f, 12.0f, 0.01f), 4.0f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("shine", "Shine",
-                                                                   juce::NormalisableRange<float> (-12.0f, 12.0f, 0.01f), 2.0f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("drive", "Drive",
-                                                                   juce::NormalisableRange<float> (0.0f, 1.0f, 0.001f), 0.5f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("tighten", "Tighten",
-                                                                   juce::NormalisableRange<float> (20.0f, 220.0f, 0.01f, 0.35f), 80.0f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("mix", "Mix",
-                                                                   juce::NormalisableRange<float> (0.0f, 1.0f, 0.001f), 0.7f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> (kParamInput, "Input Trim",
-                                                                   juce::NormalisableRange<float> (-18.0f, 18.0f, 0.1f), 0.0f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> (kParamOutput, "Output Trim",
-                                                                   juce::NormalisableRange<float> (-18.0f, 18.0f, 0.1f), 0.0f));
-    params.push_back (std::make_unique<juce::AudioParameterBool>  (kParamBypass, "Soft Bypass", false));
+    gls::addParameters (params, parameterTable);
+    gls::dsp::Oversampler<float>::addParameters (params);
 
     return { params.begin(), params.end() };
 }
@@ -181,32 +206,32 @@ void GRDWarmLiftAudioProcessor::ensureStateSize (int numChannels)
     }
 }
 
-void GRDWarmLiftAudioProcessor::updateFilters (float warmth, float shine, float tighten)
+void GRDWarmLiftAudioProcessor::updateFilters (float warmth, float shine, float tighten, double processingRate)
 {
-    if (currentSampleRate <= 0.0)
+    if (processingRate <= 0.0)
         return;
 
     const float warmthGain = juce::Decibels::decibelsToGain (warmth);
     const float shineGain  = juce::Decibels::decibelsToGain (shine);
-    auto warmthCoeffs = juce::dsp::IIR::Coefficients<float>::makeLowShelf (currentSampleRate,
-                                                                           180.0f,
-                                                                           0.7f,
-                                                                           warmthGain);
-    auto shineCoeffs  = juce::dsp::IIR::Coefficients<float>::makeHighShelf (currentSampleRate,
-                                                                            4800.0f,
-                                                                            0.8f,
-                                                                            shineGain);
-    auto tightenCoeffs = juce::dsp::IIR::Coefficients<float>::makeHighPass (currentSampleRate,
-                                                                            juce::jlimit (20.0f, 300.0f, tighten), 0.7f);
+    const float tightenFreq = juce::jlimit (20.0f, 300.0f, tighten);
 
     for (auto& state : channelState)
     {
-        state.warmthShelf.coefficients = warmthCoeffs;
-        state.shineShelf.coefficients  = shineCoeffs;
-        state.tightenFilter.coefficients = tightenCoeffs;
+        state.warmthShelf.setLowShelf (processingRate, 180.0f, 0.7f, warmthGain);
+        state.shineShelf.setHighShelf (processingRate, 4800.0f, 0.8f, shineGain);
+        state.tightenFilter.setHighPass (processingRate, tightenFreq, 0.7f);
     }
 }
 
+void GRDWarmLiftAudioProcessor::updateOversampling()
+{
+    oversampler.update (isNonRealtime(), currentSampleRate, { &mixAmount });
+
+    latency.setStage (0, oversampler.getLatencySamples(), oversampler.getLatencySamples());
+    latency.update();
+    bypass.setLatency (oversampler.getLatencySamples());
+}
+
 int GRDWarmLiftAudioProcessor::getNumPrograms()
 {
     return (int) presetBank.size();
@@ -254,7 +279,8 @@ juce::AudioProcessorEditor* GRDWarmLiftAudioProcessor::createEditor()
 GRDWarmLiftAudioProcessorEditor::GRDWarmLiftAudioProcessorEditor (GRDWarmLiftAudioProcessor& processor)
     : juce::AudioProcessorEditor (&processor), processorRef (processor),
       accentColour (gls::ui::accentForFamily ("GRD")),
-      headerComponent ("GRD.WarmLift", "Warm Lift")
+      headerComponent ("GRD.WarmLift", "Warm Lift"),
+      oversamplingSelector (processor.getValueTreeState())
 {
     lookAndFeel.setAccentColour (accentColour);
     setLookAndFeel (&lookAndFeel);
@@ -281,6 +307,7 @@ GRDWarmLiftAudioProcessorEditor::GRDWarmLiftAudioProcessorEditor (GRDWarmLiftAud
     for (int i = 0; i < ids.size(); ++i)
         attachments.push_back (std::make_unique<SliderAttachment> (state, ids[i], *sliders[i]));
     bypassAttachment = std::make_unique<juce::AudioProcessorValueTreeState::ButtonAttachment> (state, kParamBypass, bypassButton);
+    addAndMakeVisible (oversamplingSelector);
 
     setSize (780, 420);
 }
@@ -348,7 +375,9 @@ void GRDWarmLiftAudioProcessorEditor::resized()
     inputTrimSlider .setBounds (bottom.removeFromLeft (bottomWidth).reduced (8));
     outputTrimSlider.setBounds (bottom.removeFromLeft (bottomWidth).reduced (8));
 
-    bypassButton.setBounds (footerComponent.getBounds().reduced (24, 12));
+    auto footer = footerComponent.getBounds().reduced (24, 12);
+    oversamplingSelector.setBounds (footer.removeFromRight (300));
+    bypassButton.setBounds (footer);
     layoutLabels();
 }
 
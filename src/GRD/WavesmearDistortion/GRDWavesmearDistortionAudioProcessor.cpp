@@ -11,6 +11,22 @@ constexpr auto paramMix        = "mix";
 constexpr auto paramInputTrim  = "input_trim";
 constexpr auto paramOutputTrim = "output_trim";
 constexpr auto paramBypass     = "ui_bypass";
+
+using Param = GRDWavesmearDistortionAudioProcessor::Param;
+using Spec = gls::ParameterSpec;
+
+constexpr std::array<Spec, (size_t) Param::count> parameterTable {{
+    Spec::range  (paramPreFilter,  "Pre Filter",  60.0f,  5000.0f,  1.0f,    300.0f,  0.5f),
+    Spec::range  (paramSmear,      "Smear",       0.0f,   1.0f,     0.0001f, 0.35f),
+    Spec::range  (paramDrive,      "Drive",       0.0f,   1.0f,     0.0001f, 0.6f),
+    Spec::range  (paramTone,       "Tone",        800.0f, 12000.0f, 1.0f,    6400.0f, 0.4f),
+    Spec::range  (paramMix,        "Mix",         0.0f,   1.0f,     0.0001f, 0.5f),
+    Spec::range  (paramInputTrim,  "Input Trim",  -18.0f, 18.0f,    0.1f,    0.0f),
+    Spec::range  (paramOutputTrim, "Output Trim", -18.0f, 18.0f,    0.1f,    0.0f),
+    Spec::toggle (paramBypass,     "Soft Bypass", false)
+}};
+
+static_assert (gls::hasUniqueIds (parameterTable));
 } // namespace
 
 const std::array<GRDWavesmearDistortionAudioProcessor::Preset, 3>
@@ -51,27 +67,50 @@ GRDWavesmearDistortionAudioProcessor::GRDWavesmearDistortionAudioProcessor()
     : DualPrecisionAudioProcessor (BusesProperties()
                         .withInput  ("Input", juce::AudioChannelSet::stereo(), true)
                         .withOutput ("Output", juce::AudioChannelSet::stereo(), true)),
-      apvts (*this, nullptr, kStateId, createParameterLayout())
+      apvts (*this, nullptr, kStateId, createParameterLayout()),
+      params (apvts, parameterTable),
+      adaaOrder (*apvts.getRawParameterValue (gls::dsp::AntiderivativeWaveshaper::orderParameterId))
 {
+    oversampler.attach (apvts);
+    bypass.snapOnResume ({ &mixAmount, &outputTrimGain });
 }
 
-void GRDWavesmearDistortionAudioProcessor::prepareToPlay (double sampleRate, int /*samplesPerBlock*/)
+void GRDWavesmearDistortionAudioProcessor::prepareToPlay (double sampleRate, int samplesPerBlock)
 {
+    DualPrecisionAudioProcessor::prepareToPlay (sampleRate, samplesPerBlock);
+
     currentSampleRate = juce::jmax (sampleRate, 44100.0);
     preFilters.clear();
     toneFilters.clear();
     smearMemory.clear();
-    dryBuffer.setSize (getTotalNumOutputChannels(), 0);
-    lastBlockSize = 0;
+    lastBlockSize = (juce::uint32) juce::jmax (1, samplesPerBlock);
+    ensureStateSize (juce::jmax (1, getTotalNumInputChannels(), getTotalNumOutputChannels()));
+
+    oversampler.prepare (juce::jmax (1, getTotalNumOutputChannels()), samplesPerBlock);
+    bypass.prepare (currentSampleRate, juce::jmax (getTotalNumInputChannels(), getTotalNumOutputChannels()), samplesPerBlock,
+                    oversampler.getMaximumLatencySamples());
+    mixAmount.prepare (currentSampleRate * oversampler.getFactor(), samplesPerBlock << gls::dsp::Oversampler<float>::maxFactorLog2);
+
+    for (auto* smoother : { &inputTrimGain, &outputTrimGain })
+        smoother->prepare (currentSampleRate, samplesPerBlock);
+
+    saturator.prepare (juce::jmax (1, getTotalNumOutputChannels()));
+    saturator.setCurve (gls::dsp::AntiderivativeWaveshaper::Curve::tanh);
+    dryDelay.prepare (juce::jmax (1, getTotalNumOutputChannels()));
+    latency.invalidate();
+    updateOversampling();
 }
 
 void GRDWavesmearDistortionAudioProcessor::releaseResources()
 {
 }
 
-void GRDWavesmearDistortionAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer,
-                                                         juce::MidiBuffer&)
+void GRDWavesmearDistortionAudioProcessor::processFloat (juce::AudioBuffer<float>& buffer,
+                                                         juce::MidiBuffer& midi)
 {
+    if (renderInPreparedChunks (buffer, midi))
+        return;
+
     juce::ScopedNoDenormals noDenormals;
 
     const auto totalNumInputChannels  = getTotalNumInputChannels();
@@ -79,55 +118,86 @@ void GRDWavesmearDistortionAudioProcessor::processBlock (juce::AudioBuffer<float
     for (auto ch = totalNumInputChannels; ch < totalNumOutputChannels; ++ch)
         buffer.clear (ch, 0, buffer.getNumSamples());
 
-    ensureStateSize (buffer.getNumChannels(), buffer.getNumSamples());
+    ensureStateSize (buffer.getNumChannels());
 
-    auto get = [this](const char* id) { return apvts.getRawParameterValue (id)->load(); };
+    const float preFreq   = juce::jlimit (60.0f, 5000.0f, params[Param::preFilter]);
+    const float smear     = juce::jlimit (0.0f, 1.0f,   params[Param::smearAmount]);
+    const float drive     = juce::jlimit (0.0f, 1.0f,   params[Param::drive]);
+    const float tone      = juce::jlimit (800.0f, 12000.0f, params[Param::tone]);
+    const bool bypassed   = params.isOn (Param::bypass);
 
-    const float preFreq   = juce::jlimit (60.0f, 5000.0f, get (paramPreFilter));
-    const float smear     = juce::jlimit (0.0f, 1.0f,   get (paramSmear));
-    const float drive     = juce::jlimit (0.0f, 1.0f,   get (paramDrive));
-    const float tone      = juce::jlimit (800.0f, 12000.0f, get (paramTone));
-    const float mix       = juce::jlimit (0.0f, 1.0f,   get (paramMix));
-    const float inputGain = juce::Decibels::decibelsToGain (get (paramInputTrim));
-    const float outputGain= juce::Decibels::decibelsToGain (get (paramOutputTrim));
-    const bool bypassed   = get (paramBypass) > 0.5f;
-
-    updateFilters (preFreq, tone);
+    updateOversampling();
+    const auto factor = oversampler.getFactor();
+    updateFilters (preFreq, tone, currentSampleRate * factor);
     const float driveGain = juce::jmap (drive, 1.0f, 18.0f);
 
-    buffer.applyGain (inputGain);
-    dryBuffer.makeCopyOf (buffer, true);
+    // The smear is a one-pole; re-derive its coefficient so the corner stays put when oversampled.
+    const float smearCoeff = factor > 1 ? std::pow (smear, 1.0f / (float) factor) : smear;
 
-    if (bypassed)
-    {
-        buffer.applyGain (outputGain);
+    using Shaper = gls::dsp::AntiderivativeWaveshaper;
+    using Lanes = Shaper::Lanes;
+    constexpr int lanes = Shaper::lanesPerGroup;
+
+    const auto order = Shaper::getOrder (adaaOrder);
+    saturator.setOrder (order);
+    dryDelay.setOrder (order);
+
+    const int numSamples = buffer.getNumSamples();
+    for (auto* smoother : { &inputTrimGain, &mixAmount, &outputTrimGain })
+        smoother->update();
+
+    inputTrimGain.applyGain (buffer, numSamples);
+
+    if (! bypass.begin (buffer, numSamples, bypassed))
         return;
-    }
 
-    for (int ch = 0; ch < buffer.getNumChannels(); ++ch)
+    oversampler.process (buffer, [&] (juce::dsp::AudioBlock<float>& block)
     {
-        auto* writePtr  = buffer.getWritePointer (ch);
-        auto* dryPtr    = dryBuffer.getReadPointer (ch);
-        auto& preFilter = preFilters[(size_t) ch];
-        auto& toneFilter = toneFilters[(size_t) ch];
-        auto& smearState = smearMemory[(size_t) ch];
+        const auto blockSamples = (int) block.getNumSamples();
+        const auto* mixes = mixAmount.advance (blockSamples);
+        const float mix = mixAmount.getCurrentValue();
+        const auto blockChannels = juce::jmin ((int) block.getNumChannels(), saturator.getNumGroups() * lanes);
+        const auto numGroups = (blockChannels + lanes - 1) / lanes;
 
-        for (int sample = 0; sample < buffer.getNumSamples(); ++sample)
+        for (int i = 0; i < blockSamples; ++i)
         {
-            const float drySample = dryPtr[sample];
-            const float preSample = preFilter.processSample (drySample);
+            for (int group = 0; group < numGroups; ++group)
+            {
+                const int firstChannel = group * lanes;
+                const int groupChannels = juce::jmin (lanes, blockChannels - firstChannel);
+
+                alignas (Lanes::SIMDRegisterSize) double dryFrame[(size_t) lanes] {};
+                alignas (Lanes::SIMDRegisterSize) double frame[(size_t) lanes] {};
+
+                for (int l = 0; l < groupChannels; ++l)
+                {
+                    const auto ch = (size_t) (firstChannel + l);
+                    const float drySample = block.getSample ((int) ch, i);
+                    const float preSample = preFilters[ch].processSample (drySample);
+
+                    auto& smearState = smearMemory[ch];
+                    smearState = preSample * (1.0f - smearCoeff) + smearState * smearCoeff;
+
+                    dryFrame[l] = drySample;
+                    frame[l] = smearState * driveGain;
+                }
+
+                saturator.processSample (group, Lanes::fromRawArray (frame)).copyToRawArray (frame);
 
-            const float smearSample = preSample * (1.0f - smear) + smearState * smear;
-            smearState = smearSample;
+                for (int l = 0; l < groupChannels; ++l)
+                    frame[l] = toneFilters[(size_t) (firstChannel + l)].processSample ((float) frame[l]);
 
-            const float saturated = juce::dsp::FastMathApproximations::tanh (smearSample * driveGain);
-            const float toned = toneFilter.processSample (saturated);
+                const auto dry = dryDelay.processSample (group, Lanes::fromRawArray (dryFrame));
+                (dry + (Lanes::fromRawArray (frame) - dry) * (double) (mixes != nullptr ? mixes[i] : mix)).copyToRawArray (frame);
 
-            writePtr[sample] = (toned * mix) + (drySample * (1.0f - mix));
+                for (int l = 0; l < groupChannels; ++l)
+                    block.setSample (firstChannel + l, i, (float) frame[l]);
+            }
         }
-    }
+    });
 
-    buffer.applyGain (outputGain);
+    outputTrimGain.applyGain (buffer, numSamples);
+    bypass.end (buffer, numSamples);
 }
 
 void GRDWavesmearDistortionAudioProcessor::getStateInformation (juce::MemoryBlock& destData)
@@ -147,37 +217,9 @@ juce::AudioProcessorValueTreeState::ParameterLayout
 GRDWavesmearDistortionAudioProcessor::createParameterLayout()
 {
     std::vector<std::unique_ptr<juce::RangedAudioParameter>> params;
-
-    params.push_back (std::make_unique<juce::AudioParameterFloat> (
-        paramPreFilter, "Pre Filter",
-        juce::NormalisableRange<float> (60.0f, 5000.0f, 1.0f, 0.5f), 300.0f));
-
-    params.push_back (std::make_unique<juce::AudioParameterFloat> (
-        paramSmear, "Smear",
-        juce::NormalisableRange<float> (0.0f, 1.0f, 0.0001f), 0.35f));
-
-    params.push_back (std::make_unique<juce::AudioParameterFloat> (
-        paramDrive, "Drive",
-        juce::NormalisableRange<float> (0.0f, 1.0f, 0.0001f), 0.6f));
-
-    params.push_back (std::make_unique<juce::AudioParameterFloat> (
-        paramTone, "Tone",
-        juce::NormalisableRange<float> (800.0f, 12000.0f, 1.0f, 0.4f), 6400.0f));
-
-    params.push_back (std::make_unique<juce::AudioParameterFloat> (
-        paramMix, "Mix",
-        juce::NormalisableRange<float> (0.0f, 1.0f, 0.0001f), 0.5f));
-
-    params.push_back (std::make_unique<juce::AudioParameterFloat> (
-        paramInputTrim, "Input Trim",
-        juce::NormalisableRange<float> (-18.0f, 18.0f, 0.1f), 0.0f));
-
-    params.push_back (std::make_unique<juce::AudioParameterFloat> (
-        paramOutputTrim, "Output Trim",
-        juce::NormalisableRange<float> (-18.0f, 18.0f, 0.1f), 0.0f));
-
-    params.push_back (std::make_unique<juce::AudioParameterBool> (
-        paramBypass, "Soft Bypass", false));
+    gls::addParameters (params, parameterTable);
+    gls::dsp::Oversampler<float>::addParameters (params);
+    gls::dsp::AntiderivativeWaveshaper::addParameters (params);
 
     return { params.begin(), params.end() };
 }
@@ -220,7 +262,7 @@ void GRDWavesmearDistortionAudioProcessor::applyPreset (int index)
     }
 }
 
-void GRDWavesmearDistortionAudioProcessor::ensureStateSize (int numChannels, int numSamples)
+void GRDWavesmearDistortionAudioProcessor::ensureStateSize (int numChannels)
 {
     if ((int) preFilters.size() < numChannels)
     {
@@ -235,24 +277,25 @@ void GRDWavesmearDistortionAudioProcessor::ensureStateSize (int numChannels, int
             toneFilters[(size_t) i].reset();
         }
     }
-
-    if ((int) dryBuffer.getNumChannels() != numChannels || (int) lastBlockSize != numSamples)
-    {
-        dryBuffer.setSize (numChannels, numSamples, false, false, true);
-        lastBlockSize = static_cast<juce::uint32> (numSamples);
-    }
 }
 
-void GRDWavesmearDistortionAudioProcessor::updateFilters (float preFreq, float toneFreq)
+void GRDWavesmearDistortionAudioProcessor::updateFilters (float preFreq, float toneFreq, double processingRate)
 {
-    auto hpCoeffs = juce::dsp::IIR::Coefficients<float>::makeHighPass (currentSampleRate, preFreq, 0.707f);
-    auto toneCoeffs = juce::dsp::IIR::Coefficients<float>::makeLowPass (currentSampleRate, toneFreq, 0.707f);
 
     for (auto& filter : preFilters)
-        filter.coefficients = hpCoeffs;
+        filter.setHighPass (processingRate, preFreq, 0.707f);
 
     for (auto& filter : toneFilters)
-        filter.coefficients = toneCoeffs;
+        filter.setLowPass (processingRate, toneFreq, 0.707f);
+}
+
+void GRDWavesmearDistortionAudioProcessor::updateOversampling()
+{
+    oversampler.update (isNonRealtime(), currentSampleRate, { &mixAmount });
+
+    latency.setStage (0, oversampler.getLatencySamples(), oversampler.getLatencySamples());
+    latency.update();
+    bypass.setLatency (oversampler.getLatencySamples());
 }
 
 juce::AudioProcessorEditor* GRDWavesmearDistortionAudioProcessor::createEditor()
@@ -264,7 +307,8 @@ juce::AudioProcessorEditor* GRDWavesmearDistortionAudioProcessor::createEditor()
 GRDWavesmearDistortionAudioProcessorEditor::GRDWavesmearDistortionAudioProcessorEditor (GRDWavesmearDistortionAudioProcessor& p)
     : juce::AudioProcessorEditor (&p), processorRef (p),
       accentColour (gls::ui::accentForFamily ("GRD")),
-      headerComponent ("GRD.WavesmearDistortion", "Wavesmear Distortion")
+      headerComponent ("GRD.WavesmearDistortion", "Wavesmear Distortion"),
+      oversamplingSelector (p.getValueTreeState())
 {
     lookAndFeel.setAccentColour (accentColour);
     setLookAndFeel (&lookAndFeel);
@@ -292,6 +336,7 @@ GRDWavesmearDistortionAudioProcessorEditor::GRDWavesmearDistortionAudioProcessor
     attachments.push_back (std::make_unique<SliderAttachment> (state, paramInputTrim, inputTrimSlider));
     attachments.push_back (std::make_unique<SliderAttachment> (state, paramOutputTrim, outputTrimSlider));
     bypassAttachment = std::make_unique<juce::AudioProcessorValueTreeState::ButtonAttachment> (state, paramBypass, bypassButton);
+    addAndMakeVisible (oversamplingSelector);
 
     setSize (760, 420);
 }
@@ -325,7 +370,9 @@ void GRDWavesmearDistortionAudioProcessorEditor::resized()
     inputTrimSlider .setBounds (bottomRow.removeFromLeft (bottomWidth).reduced (10));
     outputTrimSlider.setBounds (bottomRow.removeFromLeft (bottomWidth).reduced (10));
 
-    bypassButton.setBounds (footerComponent.getBounds().reduced (24, 12));
+    auto footer = footerComponent.getBounds().reduced (24, 12);
+    oversamplingSelector.setBounds (footer.removeFromRight (400));
+    bypassButton.setBounds (footer);
     layoutLabels();
 }
 
@@ -3,17 +3,30 @@
 #include <JuceHeader.h>
 #include <array>
 #include "../../DualPrecisionAudioProcessor.h"
+#include "../../ParameterTable.h"
+#include "../../SmoothedParameter.h"
+#include "../../dsp/Biquad.h"
+#include "../../dsp/LatencyReporter.h"
+#include "../../dsp/Oversampler.h"
+#include "../../dsp/SoftBypass.h"
+#include "../../dsp/Waveshaper.h"
 #include "../../ui/GoodluckLookAndFeel.h"
+#include "../../ui/OversamplingSelector.h"
 
 class GRDWavesmearDistortionAudioProcessor : public DualPrecisionAudioProcessor
 {
 public:
+    enum class Param
+    {
+        preFilter, smearAmount, drive, tone, mix, inputTrim, outputTrim, bypass,
+        count
+    };
+
     GRDWavesmearDistortionAudioProcessor();
     ~GRDWavesmearDistortionAudioProcessor() override = default;
 
     void prepareToPlay (double sampleRate, int samplesPerBlock) override;
     void releaseResources() override;
-    void processBlock (juce::AudioBuffer<float>&, juce::MidiBuffer&) override;
 
     juce::AudioProcessorEditor* createEditor() override;
     bool hasEditor() const override { return true; }
@@ -22,7 +35,6 @@ public:
     bool acceptsMidi() const override { return false; }
     bool producesMidi() const override { return false; }
     bool isMidiEffect() const override { return false; }
-    double getTailLengthSeconds() const override { return 0.0; }
 
     int getNumPrograms() override;
     int getCurrentProgram() override { return currentPreset; }
@@ -36,12 +48,24 @@ public:
     juce::AudioProcessorValueTreeState& getValueTreeState() { return apvts; }
     static juce::AudioProcessorValueTreeState::ParameterLayout createParameterLayout();
 
+protected:
+    void processFloat (juce::AudioBuffer<float>&, juce::MidiBuffer&) override;
+
 private:
     juce::AudioProcessorValueTreeState apvts;
-    std::vector<juce::dsp::IIR::Filter<float>> preFilters;
-    std::vector<juce::dsp::IIR::Filter<float>> toneFilters;
+    gls::ParameterHandles<Param> params;
+    gls::SmoothedParameter inputTrimGain  { params, Param::inputTrim,   gls::SmoothedParameter::Mapping::decibels };
+    gls::SmoothedParameter mixAmount      { params, Param::mix };
+    gls::SmoothedParameter outputTrimGain { params, Param::outputTrim,  gls::SmoothedParameter::Mapping::decibels };
+    gls::dsp::SoftBypass bypass;
+    std::atomic<float>& adaaOrder;
+    std::vector<gls::dsp::Biquad> preFilters;
+    std::vector<gls::dsp::Biquad> toneFilters;
     std::vector<float> smearMemory;
-    juce::AudioBuffer<float> dryBuffer;
+    gls::dsp::Oversampler<float> oversampler;
+    gls::dsp::AntiderivativeWaveshaper saturator;
+    gls::dsp::AntiderivativeDelayMatch dryDelay;
+    gls::dsp::LatencyReporter latency { *this };
     juce::uint32 lastBlockSize = 0;
     double currentSampleRate = 44100.0;
     int currentPreset = 0;
@@ -54,9 +78,10 @@ private:
 
     static const std::array<Preset, 3> presetBank;
 
-    void ensureStateSize (int numChannels, int numSamples);
-    void updateFilters (float preFreq, float toneFreq);
+    void ensureStateSize (int numChannels);
+    void updateFilters (float preFreq, float toneFreq, double processingRate);
     void applyPreset (int index);
+    void updateOversampling();
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (GRDWavesmearDistortionAudioProcessor)
 };
@@ -86,6 +111,7 @@ private:
     juce::Slider inputTrimSlider;
     juce::Slider outputTrimSlider;
     juce::ToggleButton bypassButton { "Soft Bypass" };
+    gls::ui::OversamplingSelector oversamplingSelector;
 
     using SliderAttachment = juce::AudioProcessorValueTreeState::SliderAttachment;
     std::vector<std::unique_ptr<SliderAttachment>> attachments;
@@ -1,20 +1,38 @@
 #include "MDLChopperTremAudioProcessor.h"
 
+namespace
+{
+using Param = MDLChopperTremAudioProcessor::Param;
+using Spec = gls::ParameterSpec;
+
+constexpr std::array<Spec, (size_t) Param::count> parameterTable {{
+    Spec::range  ("depth",   "Depth",   0.0f,  1.0f,    0.001f, 1.0f),
+    Spec::range  ("rate",    "Rate",    0.25f, 32.0f,   0.001f, 4.0f,   0.4f),
+    Spec::range  ("smooth",  "Smooth",  0.0f,  1.0f,    0.001f, 0.3f),
+    Spec::range  ("hpf",     "HPF",     20.0f, 2000.0f, 0.01f,  120.0f, 0.35f),
+    Spec::range  ("mix",     "Mix",     0.0f,  1.0f,    0.001f, 0.5f),
+    Spec::choice ("pattern", "Pattern", "Straight|Triplet|Gate", 0)
+}};
+
+static_assert (gls::hasUniqueIds (parameterTable));
+} // namespace
+
 MDLChopperTremAudioProcessor::MDLChopperTremAudioProcessor()
     : DualPrecisionAudioProcessor (BusesProperties()
                         .withInput  ("Input", juce::AudioChannelSet::stereo(), true)
                         .withOutput ("Output", juce::AudioChannelSet::stereo(), true)),
-      apvts (*this, nullptr, "CHOPPER_TREM", createParameterLayout())
+      apvts (*this, nullptr, "CHOPPER_TREM", createParameterLayout()),
+      params (apvts, parameterTable)
 {
     pattern.fill (1.0f);
 }
 
 void MDLChopperTremAudioProcessor::prepareToPlay (double sampleRate, int samplesPerBlock)
 {
+    DualPrecisionAudioProcessor::prepareToPlay (sampleRate, samplesPerBlock);
+
     currentSampleRate = sampleRate > 0.0 ? sampleRate : 44100.0;
-    const auto totalChannels = juce::jmax (1, getTotalNumOutputChannels());
-    const auto blockSize = juce::jmax (1, samplesPerBlock);
-    dryBuffer.setSize (totalChannels, blockSize);
+    mixAmount.prepare (currentSampleRate, samplesPerBlock);
     refreshTempoFromHost();
     rebuildPattern();
 }
@@ -23,9 +41,12 @@ void MDLChopperTremAudioProcessor::releaseResources()
 {
 }
 
-void MDLChopperTremAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer,
-                                                 juce::MidiBuffer&)
+void MDLChopperTremAudioProcessor::processFloat (juce::AudioBuffer<float>& buffer,
+                                                 juce::MidiBuffer& midi)
 {
+    if (renderInPreparedChunks (buffer, midi))
+        return;
+
     juce::ScopedNoDenormals noDenormals;
 
     auto totalIn  = getTotalNumInputChannels();
@@ -33,32 +54,29 @@ void MDLChopperTremAudioProcessor::processBlock (juce::AudioBuffer<float>& buffe
     for (int ch = totalIn; ch < totalOut; ++ch)
         buffer.clear (ch, 0, buffer.getNumSamples());
 
-    auto get = [this](const char* id) { return apvts.getRawParameterValue (id)->load(); };
-
-    const float depth   = juce::jlimit (0.0f, 1.0f, get ("depth"));
-    const float rateVal = juce::jlimit (0.25f, 32.0f, get ("rate"));
-    const float smooth  = juce::jlimit (0.0f, 1.0f, get ("smooth"));
-    const float hpf     = juce::jlimit (20.0f, 2000.0f, get ("hpf"));
-    const float mix     = juce::jlimit (0.0f, 1.0f, get ("mix"));
+    const float depth   = juce::jlimit (0.0f, 1.0f, params[Param::depth]);
+    const float rateVal = juce::jlimit (0.25f, 32.0f, params[Param::rate]);
+    const float smooth  = juce::jlimit (0.0f, 1.0f, params[Param::smooth]);
+    const float hpf     = juce::jlimit (20.0f, 2000.0f, params[Param::hpf]);
 
     const int numChannels = buffer.getNumChannels();
     const int numSamples  = buffer.getNumSamples();
 
-    dryBuffer.setSize (numChannels, numSamples, false, false, true);
-    dryBuffer.makeCopyOf (buffer, true);
     refreshTempoFromHost();
 
     const float stepRate = rateVal / 4.0f; // steps per quarter note
     const float samplesPerStep = (float) currentSampleRate * 60.0f / (float) (bpm * stepRate);
 
-    juce::dsp::IIR::Filter<float> hpfFilter;
-    auto coeffs = juce::dsp::IIR::Coefficients<float>::makeHighPass (currentSampleRate, hpf);
-    hpfFilter.coefficients = coeffs;
+    gls::dsp::Biquad hpfFilter;
+    hpfFilter.setHighPass (currentSampleRate, hpf);
+
+    mixAmount.update();
+    const auto* mixes = mixAmount.advance (numSamples);
+    const float mix = mixAmount.getCurrentValue();
 
     for (int ch = 0; ch < numChannels; ++ch)
     {
         auto* wet = buffer.getWritePointer (ch);
-        const auto* dry = dryBuffer.getReadPointer (ch);
 
         float env = 0.0f;
         for (int i = 0; i < numSamples; ++i)
@@ -67,10 +85,12 @@ void MDLChopperTremAudioProcessor::processBlock (juce::AudioBuffer<float>& buffe
             const float stepValue = pattern[stepIndex];
             env = smooth * env + (1.0f - smooth) * stepValue;
 
-            float modulated = dry[i] * (1.0f - depth + depth * env);
+            const float drySample = wet[i];
+            float modulated = drySample * (1.0f - depth + depth * env);
             modulated = hpfFilter.processSample (modulated);
 
-            wet[i] = modulated * mix + dry[i] * (1.0f - mix);
+            const float amount = mixes != nullptr ? mixes[i] : mix;
+            wet[i] = modulated * amount + drySample * (1.0f - amount);
 
             phase += juce::MathConstants<float>::twoPi / samplesPerStep;
             if (phase > juce::MathConstants<float>::twoPi)
@@ -96,7 +116,7 @@ void MDLChopperTremAudioProcessor::rebuildPattern()
 {
     pattern.fill (1.0f);
 
-    const auto choice = static_cast<int> (apvts.getRawParameterValue ("pattern")->load());
+    const auto choice = params.getIndex (Param::pattern);
 
     if (choice == 1) // Triplet-style emphasis
     {
@@ -118,22 +138,7 @@ juce::AudioProcessorEditor* MDLChopperTremAudioProcessor::createEditor()
 juce::AudioProcessorValueTreeState::ParameterLayout
 MDLChopperTremAudioProcessor::createParameterLayout()
 {
-    std::vector<std::unique_ptr<juce::RangedAudioParameter>> params;
-
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("depth",  "Depth",
-                                                                   juce::NormalisableRange<float> (0.0f, 1.0f, 0.001f), 1.0f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("rate",   "Rate",
-                                                                   juce::NormalisableRange<float> (0.25f, 32.0f, 0.001f, 0.4f), 4.0f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("smooth", "Smooth",
-                                                                   juce::NormalisableRange<float> (0.0f, 1.0f, 0.001f), 0.3f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("hpf",    "HPF",
-                                                                   juce::NormalisableRange<float> (20.0f, 2000.0f, 0.01f, 0.35f), 120.0f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("mix",    "Mix",
-                                                                   juce::NormalisableRange<float> (0.0f, 1.0f, 0.001f), 0.5f));
-    params.push_back (std::make_unique<juce::AudioParameterChoice>("pattern","Pattern",
-                                                                   juce::StringArray { "Straight", "Triplet", "Gate" }, 0));
-
-    return { params.begin(), params.end() };
+    return gls::createParameterLayout (parameterTable);
 }
 
 MDLChopperTremAudioProcessorEditor::MDLChopperTremAudioProcessorEditor (MDLChopperTremAudioProcessor& p)
@@ -1,29 +1,63 @@
 #include "MDLChorusIXAudioProcessor.h"
 
+namespace
+{
+using Param = MDLChorusIXAudioProcessor::Param;
+using Spec = gls::ParameterSpec;
+
+constexpr std::array<Spec, (size_t) Param::count> parameterTable {{
+    Spec::integer ("voices", "Voices", 1, 8, 4),
+    Spec::range   ("rate",   "Rate",   0.05f, 5.0f, 0.001f, 0.6f, 0.4f),
+    Spec::range   ("depth",  "Depth",  0.0f,  1.0f, 0.001f, 0.65f),
+    Spec::range   ("spread", "Spread", 0.0f,  1.0f, 0.001f, 0.75f),
+    Spec::range   ("tone",   "Tone",   -1.0f, 1.0f, 0.001f, 0.0f),
+    Spec::range   ("mix",    "Mix",    0.0f,  1.0f, 0.001f, 0.5f)
+}};
+
+static_assert (gls::hasUniqueIds (parameterTable));
+} // namespace
+
 MDLChorusIXAudioProcessor::MDLChorusIXAudioProcessor()
     : DualPrecisionAudioProcessor(BusesProperties()
                         .withInput  ("Input", juce::AudioChannelSet::stereo(), true)
                         .withOutput ("Output", juce::AudioChannelSet::stereo(), true)),
-      apvts (*this, nullptr, "CHORUS_IX", createParameterLayout())
+      apvts (*this, nullptr, "CHORUS_IX", createParameterLayout()),
+      params (apvts, parameterTable)
 {
 }
 
 void MDLChorusIXAudioProcessor::prepareToPlay (double sampleRate, int samplesPerBlock)
 {
+    DualPrecisionAudioProcessor::prepareToPlay (sampleRate, samplesPerBlock);
+
     currentSampleRate = sampleRate > 0.0 ? sampleRate : 44100.0;
-    lastBlockSize = (juce::uint32) juce::jmax (1, samplesPerBlock);
-    const auto channels = juce::jmax (1, getTotalNumOutputChannels());
-    dryBuffer.setSize (channels, (int) lastBlockSize);
+    maxBlockSize = juce::jmax (1, samplesPerBlock);
+    const auto channels = juce::jmax (1, getTotalNumInputChannels(), getTotalNumOutputChannels());
+
+    channelState.resize ((size_t) channels);
+    auto& random = juce::Random::getSystemRandom();
+
+    for (auto& state : channelState)
+    {
+        state.delay.prepare (currentSampleRate, 0.05, maxBlockSize);
 
-    ensureVoiceState (channels,
-                      (int) std::round (apvts.getRawParameterValue ("voices")->load()));
+        for (auto& phase : state.phase)
+            phase = random.nextFloat() * juce::MathConstants<float>::twoPi;
+    }
+
+    modulationBuffer.setSize (maxVoices, maxBlockSize);
+    chorusBuffer.setSize (2, maxBlockSize);
+    mixAmount.prepare (currentSampleRate, maxBlockSize);
+
+    for (auto& filter : toneFilters)
+        filter.reset();
 }
 
 void MDLChorusIXAudioProcessor::releaseResources()
 {
 }
 
-void MDLChorusIXAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer,
+void MDLChorusIXAudioProcessor::processFloat (juce::AudioBuffer<float>& buffer,
                                               juce::MidiBuffer&)
 {
     juce::ScopedNoDenormals noDenormals;
@@ -33,63 +67,101 @@ void MDLChorusIXAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer,
     for (int ch = totalIn; ch < totalOut; ++ch)
         buffer.clear (ch, 0, buffer.getNumSamples());
 
-    auto get = [this](const char* id) { return apvts.getRawParameterValue (id)->load(); };
-
-    const int voices   = juce::jlimit (1, 8, (int) std::round (get ("voices")));
-    const float rate   = juce::jlimit (0.05f, 5.0f, get ("rate"));
-    const float depth  = juce::jlimit (0.0f, 1.0f, get ("depth"));
-    const float spread = juce::jlimit (0.0f, 1.0f, get ("spread"));
-    const float tone   = juce::jlimit (-1.0f, 1.0f, get ("tone"));
-    const float mix    = juce::jlimit (0.0f, 1.0f, get ("mix"));
+    const int voices   = juce::jlimit (1, maxVoices, params.getIndex (Param::voices));
+    const float rate   = juce::jlimit (0.05f, 5.0f, params[Param::rate]);
+    const float depth  = juce::jlimit (0.0f, 1.0f, params[Param::depth]);
+    const float spread = juce::jlimit (0.0f, 1.0f, params[Param::spread]);
+    const float tone   = juce::jlimit (-1.0f, 1.0f, params[Param::tone]);
 
-    const int numChannels = buffer.getNumChannels();
+    const int numChannels = juce::jmin (buffer.getNumChannels(), (int) channelState.size());
     const int numSamples  = buffer.getNumSamples();
 
-    ensureVoiceState (numChannels, voices);
-    dryBuffer.setSize (numChannels, numSamples, false, false, true);
-    dryBuffer.makeCopyOf (buffer, true);
     updateToneFilter (tone);
+    mixAmount.update();
 
-    const float baseDelaySamples = currentSampleRate * 0.015f; // 15 ms
-    const float depthSamples     = depth * currentSampleRate * 0.01f;
-
-    for (int ch = 0; ch < numChannels; ++ch)
+    // Every channel of a chunk shares the mix ramp.
+    for (int start = 0; start < numSamples; start += maxBlockSize)
     {
-        auto* wet = buffer.getWritePointer (ch);
-        const auto* dry = dryBuffer.getReadPointer (ch);
-        auto& voiceArray = channelVoices[ch];
+        const auto length = juce::jmin (maxBlockSize, numSamples - start);
+        const auto* mixes = mixAmount.advance (length);
+        const auto mix = mixAmount.getCurrentValue();
 
-        for (int i = 0; i < numSamples; ++i)
+        for (int ch = 0; ch < numChannels; ++ch)
         {
-            float chorusSample = 0.0f;
-            for (int v = 0; v < voices; ++v)
-            {
-                auto& voice = voiceArray[v];
-                const float lfo = std::sin (voice.phase + v * juce::MathConstants<float>::twoPi / (float) voices);
-                const float modDelay = baseDelaySamples + depthSamples * lfo;
-                voice.delay.setDelay (juce::jlimit (1.0f, (float) (currentSampleRate * 0.05f), modDelay));
+            const float pan = spread > 0.0f ? (ch == 0 ? -(spread) : spread) : 0.0f;
+            const float panAngle = (pan + 1.0f) * juce::MathConstants<float>::pi * 0.25f;
+            const float wetScale = std::cos (panAngle) / (float) voices;
 
-                const float delayed = voice.delay.popSample (0);
-                voice.delay.pushSample (0, dry[i]);
+            renderChannel (ch, buffer.getWritePointer (ch, start), length, voices, rate, depth, wetScale, mixes, mix);
+        }
+    }
+}
 
-                chorusSample += delayed;
+void MDLChorusIXAudioProcessor::updateTail()
+{
+    // The longest voice reads 15 ms plus the full depth behind the input.
+    tail.setTail ((15.0 + 10.0 * juce::jlimit (0.0f, 1.0f, params[Param::depth])) * 0.001);
+}
 
-                const float voiceRate = rate * (1.0f + 0.1f * (float) v);
-                voice.phase += voiceRate / (float) currentSampleRate * juce::MathConstants<float>::twoPi;
-                if (voice.phase > juce::MathConstants<float>::twoPi)
-                    voice.phase -= juce::MathConstants<float>::twoPi;
-            }
+void MDLChorusIXAudioProcessor::renderChannel (int channel, float* data, int numSamples, int numVoices,
+                                               float rate, float depth, float wetScale, const float* mixes, float mix)
+{
+    auto& state = channelState[(size_t) channel];
+    state.delay.write (data, numSamples);
 
-            chorusSample /= (float) voices;
-            float processed = toneFilters[ch % 2].processSample (chorusSample);
+    // Each voice's LFO is a rotating phasor seeded from its phase at the start of the
+    // chunk, so the per-sample update is a 2x2 multiply across all voice lanes.
+    const auto twoPi = juce::MathConstants<float>::twoPi;
+    const auto spacing = twoPi / (float) numVoices;
+    std::array<float, maxVoices> sinLfo {}, cosLfo {}, sinStep {}, cosStep {};
 
-            const float pan = spread > 0.0f ? (ch == 0 ? -(spread) : spread) : 0.0f;
-            const float panAngle = (pan + 1.0f) * juce::MathConstants<float>::pi * 0.25f;
-            processed *= std::cos (panAngle);
+    for (int v = 0; v < numVoices; ++v)
+    {
+        const auto increment = rate * (1.0f + 0.1f * (float) v) / (float) currentSampleRate * twoPi;
+        sinLfo[(size_t) v]  = std::sin (state.phase[(size_t) v] + (float) v * spacing);
+        cosLfo[(size_t) v]  = std::cos (state.phase[(size_t) v] + (float) v * spacing);
+        sinStep[(size_t) v] = std::sin (increment);
+        cosStep[(size_t) v] = std::cos (increment);
+        state.phase[(size_t) v] = std::fmod (state.phase[(size_t) v] + increment * (float) numSamples, twoPi);
+    }
+
+    const float baseDelaySamples = (float) currentSampleRate * 0.015f; // 15 ms
+    const float depthSamples     = depth * (float) currentSampleRate * 0.01f;
+    auto* const* modulation = modulationBuffer.getArrayOfWritePointers();
 
-            wet[i] = processed * mix + dry[i] * (1.0f - mix);
+    for (int i = 0; i < numSamples; ++i)
+    {
+        for (size_t v = 0; v < (size_t) maxVoices; ++v)
+        {
+            modulation[v][i] = baseDelaySamples + depthSamples * sinLfo[v];
+
+            const auto s = sinLfo[v] * cosStep[v] + cosLfo[v] * sinStep[v];
+            cosLfo[v] = cosLfo[v] * cosStep[v] - sinLfo[v] * sinStep[v];
+            sinLfo[v] = s;
         }
     }
+
+    auto* chorus = chorusBuffer.getWritePointer (0);
+    auto* tap = chorusBuffer.getWritePointer (1);
+    state.delay.read (chorus, numSamples, modulation[0]);
+
+    for (int v = 1; v < numVoices; ++v)
+    {
+        state.delay.read (tap, numSamples, modulation[v]);
+        juce::FloatVectorOperations::add (chorus, tap, numSamples);
+    }
+
+    toneFilters[channel % 2].processBlock (chorus, numSamples);
+
+    if (mixes == nullptr)
+    {
+        juce::FloatVectorOperations::multiply (data, 1.0f - mix, numSamples);
+        juce::FloatVectorOperations::addWithMultiply (data, chorus, mix * wetScale, numSamples);
+        return;
+    }
+
+    for (int i = 0; i < numSamples; ++i)
+        data[i] = data[i] * (1.0f - mixes[i]) + chorus[i] * (mixes[i] * wetScale);
 }
 
 void MDLChorusIXAudioProcessor::getStateInformation (juce::MemoryBlock& destData)
@@ -108,21 +180,7 @@ void MDLChorusIXAudioProcessor::setStateInformation (const void* data, int sizeI
 juce::AudioProcessorValueTreeState::ParameterLayout
 MDLChorusIXAudioProcessor::createParameterLayout()
 {
-    std::vector<std::unique_ptr<juce::RangedAudioParameter>> params;
-
-    params.push_back (std::make_unique<juce::AudioParameterInt>   ("voices", "Voices", 1, 8, 4));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("rate",   "Rate",
-                                                                   juce::NormalisableRange<float> (0.05f, 5.0f, 0.001f, 0.4f), 0.6f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("depth",  "Depth",
-                                                                   juce::NormalisableRange<float> (0.0f, 1.0f, 0.001f), 0.65f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("spread", "Spread",
-                                                                   juce::NormalisableRange<float> (0.0f, 1.0f, 0.001f), 0.75f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("tone",   "Tone",
-                                                                   juce::NormalisableRange<float> (-1.0f, 1.0f, 0.001f), 0.0f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("mix",    "Mix",
-                                                                   juce::NormalisableRange<float> (0.0f, 1.0f, 0.001f), 0.5f));
-
-    return { params.begin(), params.end() };
+    return gls::createParameterLayout (parameterTable);
 }
 
 MDLChorusIXAudioProcessorEditor::MDLChorusIXAudioProcessorEditor (MDLChorusIXAudioProcessor& p)
@@ -176,67 +234,15 @@ void MDLChorusIXAudioProcessorEditor::resized()
     mixSlider   .setBounds (area.removeFromLeft (width).reduced (8));
 }
 
-void MDLChorusIXAudioProcessor::ensureVoiceState (int numChannels, int numVoices)
-{
-    if (numChannels <= 0 || numVoices <= 0)
-        return;
-
-    if ((int) channelVoices.size() < numChannels)
-        channelVoices.resize (numChannels);
-
-    const auto targetBlockSize = lastBlockSize > 0 ? lastBlockSize : 512u;
-    const bool specChanged = ! juce::approximatelyEqual (voiceSpecSampleRate, currentSampleRate)
-                             || voiceSpecBlockSize != targetBlockSize;
-
-    for (auto& voiceArray : channelVoices)
-    {
-        const auto previous = (int) voiceArray.size();
-        if (previous != numVoices)
-        {
-            voiceArray.resize (numVoices);
-            if (numVoices > previous)
-            {
-                for (int v = previous; v < numVoices; ++v)
-                    voiceArray[v].phase = juce::Random::getSystemRandom().nextFloat() * juce::MathConstants<float>::twoPi;
-            }
-        }
-
-        if (specChanged || numVoices != previous)
-        {
-            juce::dsp::ProcessSpec spec { currentSampleRate,
-                                          targetBlockSize,
-                                          1 };
-
-            for (auto& voice : voiceArray)
-            {
-                voice.delay.setMaximumDelayInSamples ((int) (currentSampleRate * 0.05f));
-                voice.delay.prepare (spec);
-                voice.delay.reset();
-            }
-        }
-    }
-
-    if (specChanged)
-    {
-        voiceSpecSampleRate = currentSampleRate;
-        voiceSpecBlockSize = targetBlockSize;
-    }
-}
-
 void MDLChorusIXAudioProcessor::updateToneFilter (float tone)
 {
     if (currentSampleRate <= 0.0)
         return;
 
-    const float freq = juce::jmap (tone, -1.0f, 1.0f, 1500.0f, 9000.0f);
-    auto coeffs = juce::dsp::IIR::Coefficients<float>::makeLowPass (currentSampleRate,
-                                                                    juce::jlimit (500.0f, (float) (currentSampleRate * 0.49f), freq),
-                                                                    0.8f);
+    const float freq = juce::jlimit (500.0f, (float) (currentSampleRate * 0.49f),
+                                     juce::jmap (tone, -1.0f, 1.0f, 1500.0f, 9000.0f));
     for (auto& filter : toneFilters)
-    {
-        filter.coefficients = coeffs;
-        filter.reset();
-    }
+        filter.setLowPass (currentSampleRate, freq, 0.8f);
 }
 
 juce::AudioProcessor* JUCE_CALLTYPE createPluginFilter()
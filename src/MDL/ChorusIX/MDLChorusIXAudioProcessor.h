@@ -2,16 +2,26 @@
 
 #include <JuceHeader.h>
 #include "../../DualPrecisionAudioProcessor.h"
+#include "../../ParameterTable.h"
+#include "../../SmoothedParameter.h"
+#include "../../dsp/Biquad.h"
+#include "../../dsp/DelayLine.h"
+#include <array>
 
 class MDLChorusIXAudioProcessor : public DualPrecisionAudioProcessor
 {
 public:
+    enum class Param
+    {
+        voices, rate, depth, spread, tone, mix,
+        count
+    };
+
     MDLChorusIXAudioProcessor();
     ~MDLChorusIXAudioProcessor() override = default;
 
     void prepareToPlay (double sampleRate, int samplesPerBlock) override;
     void releaseResources() override;
-    void processBlock (juce::AudioBuffer<float>&, juce::MidiBuffer&) override;
 
     juce::AudioProcessorEditor* createEditor() override;
     bool hasEditor() const override { return true; }
@@ -20,7 +30,6 @@ public:
     bool acceptsMidi() const override { return false; }
     bool producesMidi() const override { return false; }
     bool isMidiEffect() const override { return false; }
-    double getTailLengthSeconds() const override { return 1.5; }
 
     int getNumPrograms() override { return 1; }
     int getCurrentProgram() override { return 0; }
@@ -34,26 +43,36 @@ public:
     juce::AudioProcessorValueTreeState& getValueTreeState() { return apvts; }
     static juce::AudioProcessorValueTreeState::ParameterLayout createParameterLayout();
 
+protected:
+    void processFloat (juce::AudioBuffer<float>&, juce::MidiBuffer&) override;
+    void updateTail() override;
+
 private:
     juce::AudioProcessorValueTreeState apvts;
+    gls::ParameterHandles<Param> params;
+    gls::SmoothedParameter mixAmount { params, Param::mix };
+
+    static constexpr int maxVoices = 8;
 
-    struct ChorusVoice
+    // Every voice reads the same input, so each channel has one write head and the
+    // voices are interpolated taps on it.
+    struct ChannelState
     {
-        juce::dsp::DelayLine<float, juce::dsp::DelayLineInterpolationTypes::Linear> delay { 48000 };
-        float phase = 0.0f;
+        gls::dsp::DelayLine<float> delay;
+        std::array<float, maxVoices> phase {};
     };
 
-    std::vector<std::vector<ChorusVoice>> channelVoices;
-    juce::AudioBuffer<float> dryBuffer;
+    std::vector<ChannelState> channelState;
+    juce::AudioBuffer<float> modulationBuffer;
+    juce::AudioBuffer<float> chorusBuffer;
     double currentSampleRate = 44100.0;
-    juce::uint32 lastBlockSize = 512;
-    double voiceSpecSampleRate = 0.0;
-    juce::uint32 voiceSpecBlockSize = 0;
+    int maxBlockSize = 512;
 
-    void ensureVoiceState (int numChannels, int numVoices);
+    void renderChannel (int channel, float* data, int numSamples, int numVoices,
+                        float rate, float depth, float wetScale, const float* mixes, float mix);
     void updateToneFilter (float tone);
 
-    juce::dsp::IIR::Filter<float> toneFilters[2];
+    gls::dsp::Biquad toneFilters[2];
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (MDLChorusIXAudioProcessor)
 };
@@ -1,29 +1,49 @@
 #include "MDLDualTapAudioProcessor.h"
 
+namespace
+{
+using Param = MDLDualTapAudioProcessor::Param;
+using Spec = gls::ParameterSpec;
+
+constexpr std::array<Spec, (size_t) Param::count> parameterTable {{
+    Spec::range ("time_a",   "Time A",   10.0f,   2000.0f,  0.01f,  350.0f,  0.4f),
+    Spec::range ("time_b",   "Time B",   10.0f,   2000.0f,  0.01f,  500.0f,  0.4f),
+    Spec::range ("feedback", "Feedback", 0.0f,    0.95f,    0.001f, 0.4f),
+    Spec::range ("pan_a",    "Pan A",    -1.0f,   1.0f,     0.001f, -0.5f),
+    Spec::range ("pan_b",    "Pan B",    -1.0f,   1.0f,     0.001f, 0.5f),
+    Spec::range ("hpf",      "HPF",      20.0f,   2000.0f,  0.01f,  120.0f,  0.35f),
+    Spec::range ("lpf",      "LPF",      1000.0f, 20000.0f, 0.01f,  8000.0f, 0.35f),
+    Spec::range ("mix",      "Mix",      0.0f,    1.0f,     0.001f, 0.5f)
+}};
+
+static_assert (gls::hasUniqueIds (parameterTable));
+} // namespace
+
 MDLDualTapAudioProcessor::MDLDualTapAudioProcessor()
     : DualPrecisionAudioProcessor(BusesProperties()
                         .withInput  ("Input", juce::AudioChannelSet::stereo(), true)
                         .withOutput ("Output", juce::AudioChannelSet::stereo(), true)),
-      apvts (*this, nullptr, "DUAL_TAP", createParameterLayout())
+      apvts (*this, nullptr, "DUAL_TAP", createParameterLayout()),
+      params (apvts, parameterTable)
 {
 }
 
 void MDLDualTapAudioProcessor::prepareToPlay (double sampleRate, int samplesPerBlock)
 {
+    DualPrecisionAudioProcessor::prepareToPlay (sampleRate, samplesPerBlock);
+
     currentSampleRate = sampleRate > 0.0 ? sampleRate : 44100.0;
     lastBlockSize = (juce::uint32) juce::jmax (1, samplesPerBlock);
     const auto channels = juce::jmax (1, getTotalNumOutputChannels());
-    dryBuffer.setSize (channels, (int) lastBlockSize);
     ensureStateSize (channels);
+    mixAmount.prepare (currentSampleRate, samplesPerBlock);
 
     juce::dsp::ProcessSpec spec { currentSampleRate, lastBlockSize, 1 };
     auto prepareTap = [&](auto& taps)
     {
         for (auto& tap : taps)
         {
-            tap.delay.setMaximumDelayInSamples ((int) (currentSampleRate * 2.5));
-            tap.delay.prepare (spec);
-            tap.delay.reset();
+            tap.delay.prepare (currentSampleRate, 2.0);
             tap.hpf.prepare (spec);
             tap.hpf.reset();
             tap.lpf.prepare (spec);
@@ -33,15 +53,19 @@ void MDLDualTapAudioProcessor::prepareToPlay (double sampleRate, int samplesPerB
 
     prepareTap (tapA);
     prepareTap (tapB);
+    updateTail();
 }
 
 void MDLDualTapAudioProcessor::releaseResources()
 {
 }
 
-void MDLDualTapAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer,
-                                             juce::MidiBuffer&)
+void MDLDualTapAudioProcessor::processFloat (juce::AudioBuffer<float>& buffer,
+                                             juce::MidiBuffer& midi)
 {
+    if (renderInPreparedChunks (buffer, midi))
+        return;
+
     juce::ScopedNoDenormals noDenormals;
 
     auto totalIn  = getTotalNumInputChannels();
@@ -49,16 +73,13 @@ void MDLDualTapAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer,
     for (int ch = totalIn; ch < totalOut; ++ch)
         buffer.clear (ch, 0, buffer.getNumSamples());
 
-    auto get = [this](const char* id) { return apvts.getRawParameterValue (id)->load(); };
-
-    const auto timeAms = get ("time_a");
-    const auto timeBms = get ("time_b");
-    const auto feedback = juce::jlimit (0.0f, 0.95f, get ("feedback"));
-    const auto panA = juce::jlimit (-1.0f, 1.0f, get ("pan_a"));
-    const auto panB = juce::jlimit (-1.0f, 1.0f, get ("pan_b"));
-    const auto hpf = get ("hpf");
-    const auto lpf = get ("lpf");
-    const auto mix = juce::jlimit (0.0f, 1.0f, get ("mix"));
+    const auto timeAms = params[Param::timeA];
+    const auto timeBms = params[Param::timeB];
+    const auto feedback = juce::jlimit (0.0f, 0.95f, params[Param::feedback]);
+    const auto panA = juce::jlimit (-1.0f, 1.0f, params[Param::panA]);
+    const auto panB = juce::jlimit (-1.0f, 1.0f, params[Param::panB]);
+    const auto hpf = params[Param::hpf];
+    const auto lpf = params[Param::lpf];
 
     const float delaySamplesA = juce::jlimit (1.0f, (float) (currentSampleRate * 2.0f), timeAms * 0.001f * (float) currentSampleRate);
     const float delaySamplesB = juce::jlimit (1.0f, (float) (currentSampleRate * 2.0f), timeBms * 0.001f * (float) currentSampleRate);
@@ -68,9 +89,6 @@ void MDLDualTapAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer,
 
     lastBlockSize = (juce::uint32) juce::jmax (1, numSamples);
     ensureStateSize (numChannels);
-    dryBuffer.setSize (numChannels, numSamples, false, false, true);
-    dryBuffer.makeCopyOf (buffer, true);
-
     updateFilters (hpf, lpf);
 
     auto calcPan = [](float pan)
@@ -82,22 +100,22 @@ void MDLDualTapAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer,
     const auto panGainsA = calcPan (panA);
     const auto panGainsB = calcPan (panB);
 
+    mixAmount.update();
+    const auto* mixes = mixAmount.advance (numSamples);
+    const auto mix = mixAmount.getCurrentValue();
+
     for (int ch = 0; ch < numChannels; ++ch)
     {
         auto* wetData = buffer.getWritePointer (ch);
-        const auto* dryData = dryBuffer.getReadPointer (ch);
         auto& tapStateA = tapA[ch];
         auto& tapStateB = tapB[ch];
 
-        tapStateA.delay.setDelay (delaySamplesA);
-        tapStateB.delay.setDelay (delaySamplesB);
-
         for (int i = 0; i < numSamples; ++i)
         {
-            const float drySample = dryData[i];
+            const float drySample = wetData[i];
 
-            float delayedA = tapStateA.delay.popSample (0);
-            float delayedB = tapStateB.delay.popSample (0);
+            float delayedA = tapStateA.delay.read (delaySamplesA);
+            float delayedB = tapStateB.delay.read (delaySamplesB);
 
             delayedA = tapStateA.hpf.processSample (delayedA);
             delayedA = tapStateA.lpf.processSample (delayedA);
@@ -105,8 +123,8 @@ void MDLDualTapAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer,
             delayedB = tapStateB.hpf.processSample (delayedB);
             delayedB = tapStateB.lpf.processSample (delayedB);
 
-            tapStateA.delay.pushSample (0, drySample + delayedA * feedback);
-            tapStateB.delay.pushSample (0, drySample + delayedB * feedback);
+            tapStateA.delay.push (drySample + delayedA * feedback);
+            tapStateB.delay.push (drySample + delayedB * feedback);
 
             float tapOut = 0.0f;
             const bool isLeft = (ch % 2) == 0;
@@ -115,11 +133,20 @@ void MDLDualTapAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer,
             else
                 tapOut = delayedA * panGainsA.second + delayedB * panGainsB.second;
 
-            wetData[i] = drySample * (1.0f - mix) + tapOut * mix;
+            const float amount = mixes != nullptr ? mixes[i] : mix;
+            wetData[i] = drySample * (1.0f - amount) + tapOut * amount;
         }
     }
 }
 
+void MDLDualTapAudioProcessor::updateTail()
+{
+    const auto longestSeconds = juce::jlimit (1.0 / currentSampleRate, 2.0,
+                                              juce::jmax (params[Param::timeA],
+                                                          params[Param::timeB]) * 0.001);
+    tail.setTail (longestSeconds, gls::dsp::TailTracker::getFeedbackRT60 (longestSeconds, params[Param::feedback]));
+}
+
 void MDLDualTapAudioProcessor::getStateInformation (juce::MemoryBlock& destData)
 {
     auto state = apvts.copyState();
@@ -136,26 +163,7 @@ void MDLDualTapAudioProcessor::setStateInformation (const void* data, int sizeIn
 juce::AudioProcessorValueTreeState::ParameterLayout
 MDLDualTapAudioProcessor::createParameterLayout()
 {
-    std::vector<std::unique_ptr<juce::RangedAudioParameter>> params;
-
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("time_a",   "Time A",
-                                                                   juce::NormalisableRange<float> (10.0f, 2000.0f, 0.01f, 0.4f), 350.0f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("time_b",   "Time B",
-                                                                   juce::NormalisableRange<float> (10.0f, 2000.0f, 0.01f, 0.4f), 500.0f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("feedback", "Feedback",
-                                                                   juce::NormalisableRange<float> (0.0f, 0.95f, 0.001f), 0.4f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("pan_a",   "Pan A",
-                                                                   juce::NormalisableRange<float> (-1.0f, 1.0f, 0.001f), -0.5f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("pan_b",   "Pan B",
-                                                                   juce::NormalisableRange<float> (-1.0f, 1.0f, 0.001f), 0.5f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("hpf",     "HPF",
-                                                                   juce::NormalisableRange<float> (20.0f, 2000.0f, 0.01f, 0.35f), 120.0f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("lpf",     "LPF",
-                                                                   juce::NormalisableRange<float> (1000.0f, 20000.0f, 0.01f, 0.35f), 8000.0f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("mix",     "Mix",
-                                                                   juce::NormalisableRange<float> (0.0f, 1.0f, 0.001f), 0.5f));
-
-    return { params.begin(), params.end() };
+    return gls::createParameterLayout (parameterTable);
 }
 
 MDLDualTapAudioProcessorEditor::MDLDualTapAudioProcessorEditor (MDLDualTapAudioProcessor& p)
@@ -240,9 +248,7 @@ void MDLDualTapAudioProcessor::ensureStateSize (int numChannels)
         {
             for (auto& tap : taps)
             {
-                tap.delay.setMaximumDelayInSamples ((int) (currentSampleRate * 2.5));
-                tap.delay.prepare (spec);
-                tap.delay.reset();
+                tap.delay.prepare (currentSampleRate, 2.0);
                 tap.hpf.prepare (spec);
                 tap.hpf.reset();
                 tap.lpf.prepare (spec);
@@ -262,21 +268,18 @@ void MDLDualTapAudioProcessor::updateFilters (float hpf, float lpf)
     if (currentSampleRate <= 0.0)
         return;
 
-    auto hpCoeffs = juce::dsp::IIR::Coefficients<float>::makeHighPass (currentSampleRate,
-                                                                       juce::jlimit (20.0f, 5000.0f, hpf),
-                                                                       0.707f);
-    auto lpCoeffs = juce::dsp::IIR::Coefficients<float>::makeLowPass (currentSampleRate,
-                                                                      juce::jlimit (1000.0f, (float) (currentSampleRate * 0.49f), lpf),
-                                                                      0.707f);
+    const auto hpFreq = juce::jlimit (20.0f, 5000.0f, hpf);
+    const auto lpFreq = juce::jlimit (1000.0f, (float) (currentSampleRate * 0.49f), lpf);
+
     for (auto& tap : tapA)
     {
-        tap.hpf.coefficients = hpCoeffs;
-        tap.lpf.coefficients = lpCoeffs;
+        tap.hpf.setHighPass (currentSampleRate, hpFreq, 0.707f);
+        tap.lpf.setLowPass (currentSampleRate, lpFreq, 0.707f);
     }
     for (auto& tap : tapB)
     {
-        tap.hpf.coefficients = hpCoeffs;
-        tap.lpf.coefficients = lpCoeffs;
+        tap.hpf.setHighPass (currentSampleRate, hpFreq, 0.707f);
+        tap.lpf.setLowPass (currentSampleRate, lpFreq, 0.707f);
     }
 }
 
@@ -1,17 +1,27 @@
 #pragma once
 
 #include <JuceHeader.h>
+#include <array>
 #include "../../DualPrecisionAudioProcessor.h"
+#include "../../ParameterTable.h"
+#include "../../SmoothedParameter.h"
+#include "../../dsp/Biquad.h"
+#include "../../dsp/DelayLine.h"
 
 class MDLDualTapAudioProcessor : public DualPrecisionAudioProcessor
 {
 public:
+    enum class Param
+    {
+        timeA, timeB, feedback, panA, panB, hpf, lpf, mix,
+        count
+    };
+
     MDLDualTapAudioProcessor();
     ~MDLDualTapAudioProcessor() override = default;
 
     void prepareToPlay (double sampleRate, int samplesPerBlock) override;
     void releaseResources() override;
-    void processBlock (juce::AudioBuffer<float>&, juce::MidiBuffer&) override;
 
     juce::AudioProcessorEditor* createEditor() override;
     bool hasEditor() const override { return true; }
@@ -20,7 +30,6 @@ public:
     bool acceptsMidi() const override { return false; }
     bool producesMidi() const override { return false; }
     bool isMidiEffect() const override { return false; }
-    double getTailLengthSeconds() const override { return 0.0; }
 
     int getNumPrograms() override { return 1; }
     int getCurrentProgram() override { return 0; }
@@ -34,16 +43,21 @@ public:
     juce::AudioProcessorValueTreeState& getValueTreeState() { return apvts; }
     static juce::AudioProcessorValueTreeState::ParameterLayout createParameterLayout();
 
+protected:
+    void processFloat (juce::AudioBuffer<float>&, juce::MidiBuffer&) override;
+    void updateTail() override;
+
 private:
     juce::AudioProcessorValueTreeState apvts;
+    gls::ParameterHandles<Param> params;
+    gls::SmoothedParameter mixAmount { params, Param::mix };
     struct TapState
     {
-        juce::dsp::DelayLine<float, juce::dsp::DelayLineInterpolationTypes::Linear> delay { 48000 };
-        juce::dsp::IIR::Filter<float> hpf, lpf;
+        gls::dsp::DelayLine<float> delay;
+        gls::dsp::Biquad hpf, lpf;
     };
 
     std::vector<TapState> tapA, tapB;
-    juce::AudioBuffer<float> dryBuffer;
     double currentSampleRate = 44100.0;
     juce::uint32 lastBlockSize = 512;
     double tapSpecSampleRate = 0.0;
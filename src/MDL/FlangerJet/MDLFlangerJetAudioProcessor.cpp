@@ -1,30 +1,52 @@
 #include "MDLFlangerJetAudioProcessor.h"
 
+namespace
+{
+using Param = MDLFlangerJetAudioProcessor::Param;
+using Spec = gls::ParameterSpec;
+
+constexpr std::array<Spec, (size_t) Param::count> parameterTable {{
+    Spec::range ("delay_base", "Delay Base", 0.1f,   10.0f, 0.001f, 1.2f,  0.4f),
+    Spec::range ("depth",      "Depth",      0.0f,   1.0f,  0.001f, 0.8f),
+    Spec::range ("rate",       "Rate",       0.01f,  5.0f,  0.001f, 0.35f, 0.4f),
+    Spec::range ("feedback",   "Feedback",   -0.95f, 0.95f, 0.001f, 0.4f),
+    Spec::range ("manual",     "Manual",     -1.0f,  1.0f,  0.001f, 0.0f),
+    Spec::range ("mix",        "Mix",        0.0f,   1.0f,  0.001f, 0.5f)
+}};
+
+static_assert (gls::hasUniqueIds (parameterTable));
+} // namespace
+
 MDLFlangerJetAudioProcessor::MDLFlangerJetAudioProcessor()
     : DualPrecisionAudioProcessor(BusesProperties()
                         .withInput  ("Input", juce::AudioChannelSet::stereo(), true)
                         .withOutput ("Output", juce::AudioChannelSet::stereo(), true)),
-      apvts (*this, nullptr, "FLANGER_JET", createParameterLayout())
+      apvts (*this, nullptr, "FLANGER_JET", createParameterLayout()),
+      params (apvts, parameterTable)
 {
 }
 
 void MDLFlangerJetAudioProcessor::prepareToPlay (double sampleRate, int samplesPerBlock)
 {
+    DualPrecisionAudioProcessor::prepareToPlay (sampleRate, samplesPerBlock);
+
     currentSampleRate = sampleRate > 0.0 ? sampleRate : 44100.0;
     lastBlockSize = (juce::uint32) juce::jmax (1, samplesPerBlock);
     const auto channels = juce::jmax (1, getTotalNumOutputChannels());
-    dryBuffer.setSize (channels, (int) lastBlockSize);
     ensureStateSize (channels);
-    updateDelayBounds();
+    mixAmount.prepare (currentSampleRate, samplesPerBlock);
 }
 
 void MDLFlangerJetAudioProcessor::releaseResources()
 {
 }
 
-void MDLFlangerJetAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer,
-                                                juce::MidiBuffer&)
+void MDLFlangerJetAudioProcessor::processFloat (juce::AudioBuffer<float>& buffer,
+                                                juce::MidiBuffer& midi)
 {
+    if (renderInPreparedChunks (buffer, midi))
+        return;
+
     juce::ScopedNoDenormals noDenormals;
 
     const auto totalIn  = getTotalNumInputChannels();
@@ -32,43 +54,40 @@ void MDLFlangerJetAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer
     for (int ch = totalIn; ch < totalOut; ++ch)
         buffer.clear (ch, 0, buffer.getNumSamples());
 
-    auto get = [this](const char* id) { return apvts.getRawParameterValue (id)->load(); };
-
-    const float delayBase = juce::jlimit (0.1f, 10.0f, get ("delay_base"));
-    const float depth     = juce::jlimit (0.0f, 1.0f, get ("depth"));
-    const float rate      = juce::jlimit (0.01f, 5.0f, get ("rate"));
-    const float feedback  = juce::jlimit (-0.95f, 0.95f, get ("feedback"));
-    const float manual    = juce::jlimit (-1.0f, 1.0f, get ("manual"));
-    const float mix       = juce::jlimit (0.0f, 1.0f, get ("mix"));
+    const float delayBase = juce::jlimit (0.1f, 10.0f, params[Param::delayBase]);
+    const float depth     = juce::jlimit (0.0f, 1.0f, params[Param::depth]);
+    const float rate      = juce::jlimit (0.01f, 5.0f, params[Param::rate]);
+    const float feedback  = juce::jlimit (-0.95f, 0.95f, params[Param::feedback]);
+    const float manual    = juce::jlimit (-1.0f, 1.0f, params[Param::manual]);
 
     const int numChannels = buffer.getNumChannels();
     const int numSamples  = buffer.getNumSamples();
 
     ensureStateSize (numChannels);
-    dryBuffer.setSize (numChannels, numSamples, false, false, true);
-    dryBuffer.makeCopyOf (buffer, true);
-    updateDelayBounds();
 
     const float baseSamples = delayBase * 0.001f * (float) currentSampleRate;
     const float depthSamples = depth * currentSampleRate * 0.002f;
 
+    mixAmount.update();
+    const auto* mixes = mixAmount.advance (numSamples);
+    const float mix = mixAmount.getCurrentValue();
+
     for (int ch = 0; ch < numChannels; ++ch)
     {
         auto* wet = buffer.getWritePointer (ch);
-        const auto* dry = dryBuffer.getReadPointer (ch);
         auto& line = lines[ch];
 
         for (int i = 0; i < numSamples; ++i)
         {
+            const float drySample = wet[i];
             const float lfo = std::sin (line.lfoPhase) + manual;
             const float modDelay = baseSamples + depthSamples * lfo;
-            line.delay.setDelay (juce::jlimit (1.0f, (float) (currentSampleRate * 0.02f), modDelay));
+            const float delayed = line.delay.read (juce::jlimit (1.0f, (float) (currentSampleRate * 0.02f), modDelay));
+            const float feed = delayed * feedback + drySample;
+            line.delay.push (feed);
 
-            const float delayed = line.delay.popSample (0);
-            const float feed = delayed * feedback + dry[i];
-            line.delay.pushSample (0, feed);
-
-            wet[i] = delayed * mix + dry[i] * (1.0f - mix);
+            const float amount = mixes != nullptr ? mixes[i] : mix;
+            wet[i] = delayed * amount + drySample * (1.0f - amount);
 
             line.lfoPhase += rate / (float) currentSampleRate * juce::MathConstants<float>::twoPi;
             if (line.lfoPhase > juce::MathConstants<float>::twoPi)
@@ -77,6 +96,14 @@ void MDLFlangerJetAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer
     }
 }
 
+void MDLFlangerJetAudioProcessor::updateTail()
+{
+    // The loop is longest at the top of the sweep.
+    const auto depthMs = 2.0 * params[Param::depth] * (1.0 + std::abs (params[Param::manual]));
+    const auto loopSeconds = juce::jlimit (1.0 / currentSampleRate, 0.02, (params[Param::delayBase] + depthMs) * 0.001);
+    tail.setTail (loopSeconds, gls::dsp::TailTracker::getFeedbackRT60 (loopSeconds, params[Param::feedback]));
+}
+
 void MDLFlangerJetAudioProcessor::getStateInformation (juce::MemoryBlock& destData)
 {
     auto state = apvts.copyState();
@@ -93,22 +120,7 @@ void MDLFlangerJetAudioProcessor::setStateInformation (const void* data, int siz
 juce::AudioProcessorValueTreeState::ParameterLayout
 MDLFlangerJetAudioProcessor::createParameterLayout()
 {
-    std::vector<std::unique_ptr<juce::RangedAudioParameter>> params;
-
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("delay_base", "Delay Base",
-                                                                   juce::NormalisableRange<float> (0.1f, 10.0f, 0.001f, 0.4f), 1.2f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("depth",      "Depth",
-                                                                   juce::NormalisableRange<float> (0.0f, 1.0f, 0.001f), 0.8f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("rate",       "Rate",
-                                                                   juce::NormalisableRange<float> (0.01f, 5.0f, 0.001f, 0.4f), 0.35f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("feedback",   "Feedback",
-                                                                   juce::NormalisableRange<float> (-0.95f, 0.95f, 0.001f), 0.4f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("manual",     "Manual",
-                                                                   juce::NormalisableRange<float> (-1.0f, 1.0f, 0.001f), 0.0f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("mix",        "Mix",
-                                                                   juce::NormalisableRange<float> (0.0f, 1.0f, 0.001f), 0.5f));
-
-    return { params.begin(), params.end() };
+    return gls::createParameterLayout (parameterTable);
 }
 
 MDLFlangerJetAudioProcessorEditor::MDLFlangerJetAudioProcessorEditor (MDLFlangerJetAudioProcessor& p)
@@ -186,25 +198,14 @@ void MDLFlangerJetAudioProcessor::ensureStateSize (int numChannels)
 
     if (specChanged)
     {
-        juce::dsp::ProcessSpec spec { currentSampleRate, targetBlock, 1 };
         for (auto& line : lines)
-        {
-            line.delay.prepare (spec);
-            line.delay.reset();
-        }
+            line.delay.prepare (currentSampleRate, 0.02);
 
         delaySpecSampleRate = currentSampleRate;
         delaySpecBlockSize = targetBlock;
     }
 }
 
-void MDLFlangerJetAudioProcessor::updateDelayBounds()
-{
-    const int maxSamples = (int) juce::jlimit (1.0, (double) currentSampleRate * 0.1, (double) currentSampleRate * 0.1);
-    for (auto& line : lines)
-        line.delay.setMaximumDelayInSamples (maxSamples);
-}
-
 
 juce::AudioProcessor* JUCE_CALLTYPE createPluginFilter()
 {
@@ -1,29 +1,53 @@
 #include "MDLGhostEchoAudioProcessor.h"
 
+namespace
+{
+using Param = MDLGhostEchoAudioProcessor::Param;
+using Spec = gls::ParameterSpec;
+
+constexpr std::array<Spec, (size_t) Param::count> parameterTable {{
+    Spec::range ("time",     "Time",     40.0f, 2000.0f, 0.01f,  480.0f, 0.4f),
+    Spec::range ("feedback", "Feedback", 0.0f,  0.95f,   0.001f, 0.55f),
+    Spec::range ("blur",     "Blur",     0.0f,  1.0f,    0.001f, 0.4f),
+    Spec::range ("damping",  "Damping",  0.0f,  1.0f,    0.001f, 0.5f),
+    Spec::range ("width",    "Width",    0.0f,  2.0f,    0.001f, 1.2f),
+    Spec::range ("mix",      "Mix",      0.0f,  1.0f,    0.001f, 0.5f)
+}};
+
+static_assert (gls::hasUniqueIds (parameterTable));
+} // namespace
+
 MDLGhostEchoAudioProcessor::MDLGhostEchoAudioProcessor()
     : DualPrecisionAudioProcessor(BusesProperties()
                         .withInput  ("Input", juce::AudioChannelSet::stereo(), true)
                         .withOutput ("Output", juce::AudioChannelSet::stereo(), true)),
-      apvts (*this, nullptr, "GHOST_ECHO", createParameterLayout())
+      apvts (*this, nullptr, "GHOST_ECHO", createParameterLayout()),
+      params (apvts, parameterTable)
 {
 }
 
 void MDLGhostEchoAudioProcessor::prepareToPlay (double sampleRate, int samplesPerBlock)
 {
+    DualPrecisionAudioProcessor::prepareToPlay (sampleRate, samplesPerBlock);
+
     currentSampleRate = sampleRate > 0.0 ? sampleRate : 44100.0;
     lastBlockSize = (juce::uint32) juce::jmax (1, samplesPerBlock);
     const auto channels = juce::jmax (1, getTotalNumOutputChannels());
-    dryBuffer.setSize (channels, (int) lastBlockSize);
     ensureStateSize (channels);
+    mixAmount.prepare (currentSampleRate, samplesPerBlock);
+    updateTail();
 }
 
 void MDLGhostEchoAudioProcessor::releaseResources()
 {
 }
 
-void MDLGhostEchoAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer,
-                                               juce::MidiBuffer&)
+void MDLGhostEchoAudioProcessor::processFloat (juce::AudioBuffer<float>& buffer,
+                                               juce::MidiBuffer& midi)
 {
+    if (renderInPreparedChunks (buffer, midi))
+        return;
+
     juce::ScopedNoDenormals noDenormals;
 
     const auto totalIn  = getTotalNumInputChannels();
@@ -31,47 +55,45 @@ void MDLGhostEchoAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer,
     for (int ch = totalIn; ch < totalOut; ++ch)
         buffer.clear (ch, 0, buffer.getNumSamples());
 
-    auto get = [this](const char* id) { return apvts.getRawParameterValue (id)->load(); };
-
-    const auto timeMs  = get ("time");
-    const auto feedback = juce::jlimit (0.0f, 0.95f, get ("feedback"));
-    const auto blur     = juce::jlimit (0.0f, 1.0f, get ("blur"));
-    const auto damping  = juce::jlimit (0.0f, 1.0f, get ("damping"));
-    const auto width    = juce::jlimit (0.0f, 2.0f, get ("width"));
-    const auto mix      = juce::jlimit (0.0f, 1.0f, get ("mix"));
+    const auto timeMs  = params[Param::time];
+    const auto feedback = juce::jlimit (0.0f, 0.95f, params[Param::feedback]);
+    const auto blur     = juce::jlimit (0.0f, 1.0f, params[Param::blur]);
+    const auto damping  = juce::jlimit (0.0f, 1.0f, params[Param::damping]);
+    const auto width    = juce::jlimit (0.0f, 2.0f, params[Param::width]);
 
     const int numChannels = buffer.getNumChannels();
     const int numSamples  = buffer.getNumSamples();
 
     lastBlockSize = (juce::uint32) juce::jmax (1, numSamples);
     ensureStateSize (numChannels);
-    dryBuffer.setSize (numChannels, numSamples, false, false, true);
-    dryBuffer.makeCopyOf (buffer, true);
-
     setTapDelayTimes (timeMs);
     updateTapFilters (damping);
 
+    mixAmount.update();
+    const auto* mixes = mixAmount.advance (numSamples);
+    const auto mix = mixAmount.getCurrentValue();
+
     juce::Random random;
 
     for (int ch = 0; ch < numChannels; ++ch)
     {
         auto* wet = buffer.getWritePointer (ch);
-        const auto* dry = dryBuffer.getReadPointer (ch);
         auto& tap = taps[ch];
 
         for (int i = 0; i < numSamples; ++i)
         {
-            const float drySample = dry[i];
-            float delayed = tap.delay.popSample (0);
+            const float drySample = wet[i];
+            float delayed = tap.delay.read (tap.delaySamples);
             delayed = tap.dampingFilter.processSample (delayed);
 
             const float blurNoise = (random.nextFloat() * 2.0f - 1.0f) * blur * 0.02f;
             delayed = juce::jlimit (-1.0f, 1.0f, delayed + blurNoise);
 
             const float feedbackInput = drySample + delayed * feedback;
-            tap.delay.pushSample (0, feedbackInput);
+            tap.delay.push (feedbackInput);
 
-            wet[i] = delayed * mix + drySample * (1.0f - mix);
+            const float amount = mixes != nullptr ? mixes[i] : mix;
+            wet[i] = delayed * amount + drySample * (1.0f - amount);
         }
     }
 
@@ -89,6 +111,14 @@ void MDLGhostEchoAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer,
     }
 }
 
+void MDLGhostEchoAudioProcessor::updateTail()
+{
+    // The longest tap (the last channel's scatter) recirculates at the feedback gain.
+    const auto timeSeconds = juce::jlimit (10.0 / currentSampleRate, 4.0, params[Param::time] * 0.001);
+    const auto loopSeconds = timeSeconds * (1.0 + 0.05 * (double) juce::jmax (0, (int) taps.size() - 1));
+    tail.setTail (loopSeconds, gls::dsp::TailTracker::getFeedbackRT60 (loopSeconds, params[Param::feedback]));
+}
+
 void MDLGhostEchoAudioProcessor::getStateInformation (juce::MemoryBlock& destData)
 {
     auto state = apvts.copyState();
@@ -105,22 +135,7 @@ void MDLGhostEchoAudioProcessor::setStateInformation (const void* data, int size
 juce::AudioProcessorValueTreeState::ParameterLayout
 MDLGhostEchoAudioProcessor::createParameterLayout()
 {
-    std::vector<std::unique_ptr<juce::RangedAudioParameter>> params;
-
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("time",     "Time",
-                                                                   juce::NormalisableRange<float> (40.0f, 2000.0f, 0.01f, 0.4f), 480.0f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("feedback", "Feedback",
-                                                                   juce::NormalisableRange<float> (0.0f, 0.95f, 0.001f), 0.55f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("blur",     "Blur",
-                                                                   juce::NormalisableRange<float> (0.0f, 1.0f, 0.001f), 0.4f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("damping",  "Damping",
-                                                                   juce::NormalisableRange<float> (0.0f, 1.0f, 0.001f), 0.5f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("width",    "Width",
-                                                                   juce::NormalisableRange<float> (0.0f, 2.0f, 0.001f), 1.2f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("mix",      "Mix",
-                                                                   juce::NormalisableRange<float> (0.0f, 1.0f, 0.001f), 0.5f));
-
-    return { params.begin(), params.end() };
+    return gls::createParameterLayout (parameterTable);
 }
 
 MDLGhostEchoAudioProcessorEditor::MDLGhostEchoAudioProcessorEditor (MDLGhostEchoAudioProcessor& p)
@@ -203,9 +218,7 @@ void MDLGhostEchoAudioProcessor::ensureStateSize (int numChannels)
                                       1 };
         for (auto& tap : taps)
         {
-            tap.delay.setMaximumDelayInSamples ((int) (currentSampleRate * 4.5f));
-            tap.delay.prepare (spec);
-            tap.delay.reset();
+            tap.delay.prepare (currentSampleRate, 4.5);
             tap.dampingFilter.prepare (spec);
             tap.dampingFilter.reset();
         }
@@ -225,7 +238,7 @@ void MDLGhostEchoAudioProcessor::setTapDelayTimes (float baseTimeMs)
     {
         auto& tap = taps[ch];
         const float scatter = 1.0f + 0.05f * (float) ch;
-        tap.delay.setDelay (baseSamples * scatter);
+        tap.delaySamples = baseSamples * scatter;
     }
 }
 
@@ -234,12 +247,10 @@ void MDLGhostEchoAudioProcessor::updateTapFilters (float damping)
     if (currentSampleRate <= 0.0)
         return;
 
-    const float freq = juce::jmap (damping, 0.0f, 1.0f, 18000.0f, 2000.0f);
-    auto coeffs = juce::dsp::IIR::Coefficients<float>::makeLowPass (currentSampleRate,
-                                                                    juce::jlimit (2000.0f, (float) (currentSampleRate * 0.45f), freq),
-                                                                    0.7f);
+    const float freq = juce::jlimit (2000.0f, (float) (currentSampleRate * 0.45f),
+                                     juce::jmap (damping, 0.0f, 1.0f, 18000.0f, 2000.0f));
     for (auto& tap : taps)
-        tap.dampingFilter.coefficients = coeffs;
+        tap.dampingFilter.setLowPass (currentSampleRate, freq, 0.7f);
 }
 
 
@@ -1,30 +1,53 @@
 #include "MDLPhaseGridAudioProcessor.h"
 
+namespace
+{
+using Param = MDLPhaseGridAudioProcessor::Param;
+using Spec = gls::ParameterSpec;
+
+constexpr std::array<Spec, (size_t) Param::count> parameterTable {{
+    Spec::integer ("stages",      "Stages",      2, 12, 6),
+    Spec::range   ("center_freq", "Center Freq", 200.0f, 8000.0f, 0.01f,  600.0f, 0.4f),
+    Spec::range   ("rate",        "Rate",        0.01f,  5.0f,    0.001f, 0.4f,   0.4f),
+    Spec::range   ("depth",       "Depth",       0.0f,   1.0f,    0.001f, 0.7f),
+    Spec::range   ("feedback",    "Feedback",    -0.95f, 0.95f,   0.001f, 0.3f),
+    Spec::range   ("mix",         "Mix",         0.0f,   1.0f,    0.001f, 0.5f)
+}};
+
+static_assert (gls::hasUniqueIds (parameterTable));
+} // namespace
+
 MDLPhaseGridAudioProcessor::MDLPhaseGridAudioProcessor()
     : DualPrecisionAudioProcessor(BusesProperties()
                         .withInput  ("Input", juce::AudioChannelSet::stereo(), true)
                         .withOutput ("Output", juce::AudioChannelSet::stereo(), true)),
-      apvts (*this, nullptr, "PHASE_GRID", createParameterLayout())
+      apvts (*this, nullptr, "PHASE_GRID", createParameterLayout()),
+      params (apvts, parameterTable)
 {
 }
 
 void MDLPhaseGridAudioProcessor::prepareToPlay (double sampleRate, int samplesPerBlock)
 {
+    DualPrecisionAudioProcessor::prepareToPlay (sampleRate, samplesPerBlock);
+
     currentSampleRate = sampleRate > 0.0 ? sampleRate : 44100.0;
-    lastBlockSize = (juce::uint32) juce::jmax (1, samplesPerBlock);
-    const auto channels = juce::jmax (1, getTotalNumOutputChannels());
-    const auto stageValue = apvts.getRawParameterValue ("stages");
-    const auto targetStages = stageValue != nullptr ? (int) stageValue->load() : 6;
-    ensureStageState (channels, juce::jlimit (2, 12, targetStages));
+    const auto channels = juce::jmax (1, getTotalNumInputChannels(), getTotalNumOutputChannels());
+    cascade.prepare (currentSampleRate, channels);
+    mixAmount.prepare (currentSampleRate, samplesPerBlock);
+    feedbackState.assign ((size_t) cascade.getNumGroups(), gls::dsp::ModulatedAllPassCascade::Lanes (0.0f));
+    lfoPhase = 0.0f;
 }
 
 void MDLPhaseGridAudioProcessor::releaseResources()
 {
 }
 
-void MDLPhaseGridAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer,
-                                               juce::MidiBuffer&)
+void MDLPhaseGridAudioProcessor::processFloat (juce::AudioBuffer<float>& buffer,
+                                               juce::MidiBuffer& midi)
 {
+    if (renderInPreparedChunks (buffer, midi))
+        return;
+
     juce::ScopedNoDenormals noDenormals;
 
     const auto totalIn  = getTotalNumInputChannels();
@@ -32,50 +55,76 @@ void MDLPhaseGridAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer,
     for (int ch = totalIn; ch < totalOut; ++ch)
         buffer.clear (ch, 0, buffer.getNumSamples());
 
-    auto get = [this](const char* id) { return apvts.getRawParameterValue (id)->load(); };
+    const int stages   = juce::jlimit (2, 12, params.getIndex (Param::stages));
+    const float centre = juce::jlimit (200.0f, 8000.0f, params[Param::centerFreq]);
+    const float rate   = juce::jlimit (0.01f, 5.0f, params[Param::rate]);
+    const float depth  = juce::jlimit (0.0f, 1.0f, params[Param::depth]);
+    const float feedback = juce::jlimit (-0.95f, 0.95f, params[Param::feedback]);
 
-    const int stages   = juce::jlimit (2, 12, (int) std::round (get ("stages")));
-    const float centre = juce::jlimit (200.0f, 8000.0f, get ("center_freq"));
-    const float rate   = juce::jlimit (0.01f, 5.0f, get ("rate"));
-    const float depth  = juce::jlimit (0.0f, 1.0f, get ("depth"));
-    const float feedback = juce::jlimit (-0.95f, 0.95f, get ("feedback"));
-    const float mix = juce::jlimit (0.0f, 1.0f, get ("mix"));
+    using Cascade = gls::dsp::ModulatedAllPassCascade;
+    using Lanes = Cascade::Lanes;
+    constexpr int lanes = Cascade::lanesPerGroup;
 
-    const int numChannels = buffer.getNumChannels();
     const int numSamples  = buffer.getNumSamples();
+    const int numChannels = juce::jmin (buffer.getNumChannels(), cascade.getNumGroups() * lanes);
+    const int numGroups   = (numChannels + lanes - 1) / lanes;
+    auto* const* channels = buffer.getArrayOfWritePointers();
 
-    ensureStageState (numChannels, stages);
-    updateStageCoefficients (centre, depth, rate);
+    // The LFO advances per sample; stage targets are refreshed every control
+    // interval and the cascade ramps towards them, independent of block size.
+    const float intervalPhase = rate / (float) currentSampleRate * juce::MathConstants<float>::twoPi
+                                * (float) Cascade::controlInterval;
+    cascade.setNumStages (stages);
 
-    if ((int) lfoPhase.size() < numChannels)
-        lfoPhase.resize (numChannels, 0.0f);
+    mixAmount.update();
+    const auto* mixes = mixAmount.advance (numSamples);
+    const float mix = mixAmount.getCurrentValue();
 
-    for (int ch = 0; ch < numChannels; ++ch)
+    for (int i = 0; i < numSamples; ++i)
     {
-        auto* wet = buffer.getWritePointer (ch);
+        if (cascade.needsTargets())
+        {
+            lfoPhase += intervalPhase;
+            if (lfoPhase > juce::MathConstants<float>::twoPi)
+                lfoPhase -= juce::MathConstants<float>::twoPi;
 
-        float& phase = lfoPhase[ch];
-        auto& stageChain = channelStages[ch];
-        float fbSample = 0.0f;
+            updateStageTargets (centre, depth);
+        }
 
-        for (int i = 0; i < numSamples; ++i)
+        for (int group = 0; group < numGroups; ++group)
         {
-            float sample = wet[i] + fbSample * feedback;
+            const int firstChannel = group * lanes;
+            const int groupChannels = juce::jmin (lanes, numChannels - firstChannel);
 
-            for (int s = 0; s < stages; ++s)
-                sample = stageChain[s].filter.processSample (sample);
+            alignas (Lanes::SIMDRegisterSize) float frame[(size_t) lanes] {};
+            for (int l = 0; l < groupChannels; ++l)
+                frame[l] = channels[firstChannel + l][i];
 
-            fbSample = sample;
+            const auto dry = Lanes::fromRawArray (frame);
+            auto& fb = feedbackState[(size_t) group];
+            fb = cascade.processSample (group, dry + fb * feedback);
 
-            wet[i] = sample * mix + buffer.getReadPointer (ch)[i] * (1.0f - mix);
-
-            phase += rate / (float) currentSampleRate * juce::MathConstants<float>::twoPi;
-            if (phase > juce::MathConstants<float>::twoPi)
-                phase -= juce::MathConstants<float>::twoPi;
+            const float amount = mixes != nullptr ? mixes[i] : mix;
+            (fb * amount + dry * (1.0f - amount)).copyToRawArray (frame);
+            for (int l = 0; l < groupChannels; ++l)
+                channels[firstChannel + l][i] = frame[l];
         }
+
+        cascade.advance();
     }
 }
 
+void MDLPhaseGridAudioProcessor::updateTail()
+{
+    // Each second-order stage delays by about 2Q / (pi * f) around its corner, most at
+    // the lowest swept one; the feedback recirculates through the whole cascade.
+    const auto centre = juce::jlimit (50.0, currentSampleRate * 0.45, (double) params[Param::centerFreq]);
+    const auto lowest = juce::jmax (30.0, centre * (1.0 - 0.5 * params[Param::depth]));
+    const auto stageSeconds = 2.0 * stageQ / (juce::MathConstants<double>::pi * lowest);
+    const auto loopSeconds = juce::jlimit (2, 12, params.getIndex (Param::stages)) * stageSeconds;
+    tail.setTail (loopSeconds, gls::dsp::TailTracker::getFeedbackRT60 (loopSeconds, params[Param::feedback]));
+}
+
 void MDLPhaseGridAudioProcessor::getStateInformation (juce::MemoryBlock& destData)
 {
     auto state = apvts.copyState();
@@ -92,21 +141,7 @@ void MDLPhaseGridAudioProcessor::setStateInformation (const void* data, int size
 juce::AudioProcessorValueTreeState::ParameterLayout
 MDLPhaseGridAudioProcessor::createParameterLayout()
 {
-    std::vector<std::unique_ptr<juce::RangedAudioParameter>> params;
-
-    params.push_back (std::make_unique<juce::AudioParameterInt>   ("stages", "Stages", 2, 12, 6));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("center_freq", "Center Freq",
-                                                                   juce::NormalisableRange<float> (200.0f, 8000.0f, 0.01f, 0.4f), 600.0f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("rate", "Rate",
-                                                                   juce::NormalisableRange<float> (0.01f, 5.0f, 0.001f, 0.4f), 0.4f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("depth", "Depth",
-                                                                   juce::NormalisableRange<float> (0.0f, 1.0f, 0.001f), 0.7f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("feedback", "Feedback",
-                                                                   juce::NormalisableRange<float> (-0.95f, 0.95f, 0.001f), 0.3f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("mix", "Mix",
-                                                                   juce::NormalisableRange<float> (0.0f, 1.0f, 0.001f), 0.5f));
-
-    return { params.begin(), params.end() };
+    return gls::createParameterLayout (parameterTable);
 }
 
 MDLPhaseGridAudioProcessorEditor::MDLPhaseGridAudioProcessorEditor (MDLPhaseGridAudioProcessor& p)
@@ -160,68 +195,20 @@ void MDLPhaseGridAudioProcessorEditor::resized()
     mixSlider     .setBounds (area.removeFromLeft (width).reduced (8));
 }
 
-void MDLPhaseGridAudioProcessor::ensureStageState (int numChannels, int numStages)
+void MDLPhaseGridAudioProcessor::updateStageTargets (float centreFreq, float depth)
 {
-    if (numChannels <= 0 || numStages <= 0)
-        return;
-
-    if ((int) channelStages.size() < numChannels)
-        channelStages.resize (numChannels);
-
-    for (auto& stageVector : channelStages)
-    {
-        if ((int) stageVector.size() < numStages)
-        {
-            const auto previous = (int) stageVector.size();
-            stageVector.resize (numStages);
-        }
-    }
-
-    const auto targetBlock = lastBlockSize > 0 ? lastBlockSize : 512u;
-    const bool specChanged = ! juce::approximatelyEqual (stageSpecSampleRate, currentSampleRate)
-                             || stageSpecBlockSize != targetBlock;
-
-    if (specChanged)
-    {
-        juce::dsp::ProcessSpec spec { currentSampleRate, targetBlock, 1 };
-        for (auto& stageVector : channelStages)
-            for (auto& stage : stageVector)
-            {
-                stage.filter.prepare (spec);
-                stage.filter.reset();
-            }
-
-        stageSpecSampleRate = currentSampleRate;
-        stageSpecBlockSize = targetBlock;
-    }
-}
-
-void MDLPhaseGridAudioProcessor::updateStageCoefficients (float centreFreq, float depth, float rate)
-{
-    if (currentSampleRate <= 0.0)
-        return;
-
     const float baseFreq = juce::jlimit (50.0f, (float) (currentSampleRate * 0.45f), centreFreq);
     const float modDepth = depth * baseFreq * 0.5f;
+    const float maxFreq  = (float) (currentSampleRate * 0.49f);
 
-    for (int ch = 0; ch < (int) channelStages.size(); ++ch)
+    std::array<float, gls::dsp::ModulatedAllPassCascade::maxStages> freqs {};
+    for (int s = 0; s < cascade.getNumStages(); ++s)
     {
-        auto& stages = channelStages[ch];
-        float phase = (ch < (int) lfoPhase.size()) ? lfoPhase[ch] : 0.0f;
-        for (int s = 0; s < (int) stages.size(); ++s)
-        {
-            const float modAmount = std::sin (phase + s * 0.6f) * modDepth;
-            const float freq = juce::jlimit (30.0f, (float) (currentSampleRate * 0.49f), baseFreq + modAmount);
-            auto coeffs = juce::dsp::IIR::Coefficients<float>::makeAllPass (currentSampleRate, freq, 1.0f);
-            stages[s].filter.coefficients = coeffs;
-        }
-        if ((int) lfoPhase.size() > ch)
-        {
-            lfoPhase[ch] += rate / (float) currentSampleRate * juce::MathConstants<float>::twoPi;
-            if (lfoPhase[ch] > juce::MathConstants<float>::twoPi)
-                lfoPhase[ch] -= juce::MathConstants<float>::twoPi;
-        }
+        const float modAmount = std::sin (lfoPhase + (float) s * 0.6f) * modDepth;
+        freqs[(size_t) s] = juce::jlimit (30.0f, maxFreq, baseFreq + modAmount);
     }
+
+    cascade.setTargets (freqs.data(), stageQ);
 }
 
 juce::AudioProcessorEditor* MDLPhaseGridAudioProcessor::createEditor()
@@ -1,17 +1,26 @@
 #pragma once
 
 #include <JuceHeader.h>
+#include <array>
 #include "../../DualPrecisionAudioProcessor.h"
+#include "../../ParameterTable.h"
+#include "../../SmoothedParameter.h"
+#include "../../dsp/ModulatedAllPass.h"
 
 class MDLPhaseGridAudioProcessor : public DualPrecisionAudioProcessor
 {
 public:
+    enum class Param
+    {
+        stages, centerFreq, rate, depth, feedback, mix,
+        count
+    };
+
     MDLPhaseGridAudioProcessor();
     ~MDLPhaseGridAudioProcessor() override = default;
 
     void prepareToPlay (double sampleRate, int samplesPerBlock) override;
     void releaseResources() override;
-    void processBlock (juce::AudioBuffer<float>&, juce::MidiBuffer&) override;
 
     juce::AudioProcessorEditor* createEditor() override;
     bool hasEditor() const override { return true; }
@@ -20,7 +29,6 @@ public:
     bool acceptsMidi() const override { return false; }
     bool producesMidi() const override { return false; }
     bool isMidiEffect() const override { return false; }
-    double getTailLengthSeconds() const override { return 1.0; }
 
     int getNumPrograms() override { return 1; }
     int getCurrentProgram() override { return 0; }
@@ -34,23 +42,23 @@ public:
     juce::AudioProcessorValueTreeState& getValueTreeState() { return apvts; }
     static juce::AudioProcessorValueTreeState::ParameterLayout createParameterLayout();
 
+protected:
+    void processFloat (juce::AudioBuffer<float>&, juce::MidiBuffer&) override;
+    void updateTail() override;
+
 private:
-    juce::AudioProcessorValueTreeState apvts;
+    static constexpr float stageQ = 1.0f;
 
-    struct AllPassStage
-    {
-        juce::dsp::IIR::Filter<float> filter;
-    };
+    juce::AudioProcessorValueTreeState apvts;
+    gls::ParameterHandles<Param> params;
+    gls::SmoothedParameter mixAmount { params, Param::mix };
 
-    std::vector<std::vector<AllPassStage>> channelStages;
+    gls::dsp::ModulatedAllPassCascade cascade;
+    std::vector<gls::dsp::ModulatedAllPassCascade::Lanes> feedbackState;
     double currentSampleRate = 44100.0;
-    juce::uint32 lastBlockSize = 512;
-    std::vector<float> lfoPhase;
-    double stageSpecSampleRate = 0.0;
-    juce::uint32 stageSpecBlockSize = 0;
+    float lfoPhase = 0.0f;
 
-    void ensureStageState (int numChannels, int numStages);
-    void updateStageCoefficients (float centreFreq, float depth, float rate);
+    void updateStageTargets (float centreFreq, float depth);
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (MDLPhaseGridAudioProcessor)
 };
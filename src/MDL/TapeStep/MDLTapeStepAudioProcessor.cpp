@@ -1,29 +1,54 @@
 #include "MDLTapeStepAudioProcessor.h"
 
+namespace
+{
+using Param = MDLTapeStepAudioProcessor::Param;
+using Spec = gls::ParameterSpec;
+
+constexpr std::array<Spec, (size_t) Param::count> parameterTable {{
+    Spec::range ("time",     "Time",     20.0f, 2000.0f, 0.01f,  450.0f, 0.4f),
+    Spec::range ("feedback", "Feedback", 0.0f,  0.95f,   0.001f, 0.4f),
+    Spec::range ("drive",    "Drive",    0.0f,  1.0f,    0.001f, 0.5f),
+    Spec::range ("wow",      "Wow",      0.0f,  1.0f,    0.001f, 0.2f),
+    Spec::range ("flutter",  "Flutter",  0.0f,  1.0f,    0.001f, 0.3f),
+    Spec::range ("tone",     "Tone",     -1.0f, 1.0f,    0.001f, 0.0f),
+    Spec::range ("mix",      "Mix",      0.0f,  1.0f,    0.001f, 0.5f)
+}};
+
+static_assert (gls::hasUniqueIds (parameterTable));
+} // namespace
+
 MDLTapeStepAudioProcessor::MDLTapeStepAudioProcessor()
     : DualPrecisionAudioProcessor(BusesProperties()
                         .withInput  ("Input", juce::AudioChannelSet::stereo(), true)
                         .withOutput ("Output", juce::AudioChannelSet::stereo(), true)),
-      apvts (*this, nullptr, "TAPE_STEP", createParameterLayout())
+      apvts (*this, nullptr, "TAPE_STEP", createParameterLayout()),
+      params (apvts, parameterTable)
 {
 }
 
 void MDLTapeStepAudioProcessor::prepareToPlay (double sampleRate, int samplesPerBlock)
 {
+    DualPrecisionAudioProcessor::prepareToPlay (sampleRate, samplesPerBlock);
+
     currentSampleRate = sampleRate > 0.0 ? sampleRate : 44100.0;
     lastBlockSize = (juce::uint32) juce::jmax (1, samplesPerBlock);
     const auto channels = juce::jmax (1, getTotalNumOutputChannels());
-    dryBuffer.setSize (channels, (int) lastBlockSize);
     ensureStateSize (channels);
+    mixAmount.prepare (currentSampleRate, samplesPerBlock);
+    updateTail();
 }
 
 void MDLTapeStepAudioProcessor::releaseResources()
 {
 }
 
-void MDLTapeStepAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer,
-                                              juce::MidiBuffer&)
+void MDLTapeStepAudioProcessor::processFloat (juce::AudioBuffer<float>& buffer,
+                                              juce::MidiBuffer& midi)
 {
+    if (renderInPreparedChunks (buffer, midi))
+        return;
+
     juce::ScopedNoDenormals noDenormals;
 
     const auto totalIn  = getTotalNumInputChannels();
@@ -31,15 +56,12 @@ void MDLTapeStepAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer,
     for (int ch = totalIn; ch < totalOut; ++ch)
         buffer.clear (ch, 0, buffer.getNumSamples());
 
-    auto get = [this](const char* id) { return apvts.getRawParameterValue (id)->load(); };
-
-    const auto timeMs   = get ("time");
-    const auto feedback = juce::jlimit (0.0f, 0.95f, get ("feedback"));
-    const auto drive    = juce::jlimit (0.0f, 1.0f, get ("drive"));
-    const auto wow      = juce::jlimit (0.0f, 1.0f, get ("wow"));
-    const auto flutter  = juce::jlimit (0.0f, 1.0f, get ("flutter"));
-    const auto tone     = juce::jlimit (-1.0f, 1.0f, get ("tone"));
-    const auto mix      = juce::jlimit (0.0f, 1.0f, get ("mix"));
+    const auto timeMs   = params[Param::time];
+    const auto feedback = juce::jlimit (0.0f, 0.95f, params[Param::feedback]);
+    const auto drive    = juce::jlimit (0.0f, 1.0f, params[Param::drive]);
+    const auto wow      = juce::jlimit (0.0f, 1.0f, params[Param::wow]);
+    const auto flutter  = juce::jlimit (0.0f, 1.0f, params[Param::flutter]);
+    const auto tone     = juce::jlimit (-1.0f, 1.0f, params[Param::tone]);
 
     const float delaySamples = juce::jlimit (10.0f,
                                              (float) (currentSampleRate * 2.5f),
@@ -48,43 +70,40 @@ void MDLTapeStepAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer,
     const int numChannels = buffer.getNumChannels();
     const int numSamples  = buffer.getNumSamples();
     ensureStateSize (numChannels);
-    dryBuffer.setSize (numChannels, numSamples, false, false, true);
-    dryBuffer.makeCopyOf (buffer, true);
-
     updateToneFilters (tone);
 
     const float wowRate = juce::jmap (wow, 0.05f, 0.3f);
     const float flutterRate = juce::jmap (flutter, 1.0f, 6.0f);
 
+    mixAmount.update();
+    const auto* mixes = mixAmount.advance (numSamples);
+    const auto mix = mixAmount.getCurrentValue();
+
     for (int ch = 0; ch < numChannels; ++ch)
     {
         auto* data = buffer.getWritePointer (ch);
-        auto* dry  = dryBuffer.getReadPointer (ch);
         auto& line = tapeLines[ch];
 
-        line.delay.setDelay (delaySamples);
-
         for (int i = 0; i < numSamples; ++i)
         {
-            const float drySample = dry[i];
+            const float drySample = data[i];
 
             // wow/flutter modulation
             const float wowMod = std::sin (line.wowPhase) * wow * 3.0f;
             const float flutterMod = std::sin (line.flutterPhase) * flutter * 0.8f;
             const float modulatedDelay = delaySamples + wowMod + flutterMod;
-            line.delay.setDelay (juce::jlimit (1.0f, (float) (currentSampleRate * 2.5f), modulatedDelay));
-
-            float delayed = line.delay.popSample (0);
+            float delayed = line.delay.read (juce::jlimit (1.0f, (float) (currentSampleRate * 2.5f), modulatedDelay));
             delayed = line.toneFilter.processSample (delayed);
 
             const float saturation = std::tanh ((delayed + drySample * 0.2f) * (1.0f + drive * 4.0f));
             const float tapeSample = juce::jlimit (-1.0f, 1.0f, saturation);
 
             const float feedbackInput = drySample + tapeSample * feedback;
-            line.delay.pushSample (0, feedbackInput);
+            line.delay.push (feedbackInput);
             line.feedbackSample = tapeSample;
 
-            data[i] = tapeSample * mix + drySample * (1.0f - mix);
+            const float amount = mixes != nullptr ? mixes[i] : mix;
+            data[i] = tapeSample * amount + drySample * (1.0f - amount);
 
             line.wowPhase += wowRate / (float) currentSampleRate * juce::MathConstants<float>::twoPi;
             line.flutterPhase += flutterRate / (float) currentSampleRate * juce::MathConstants<float>::twoPi;
@@ -94,6 +113,15 @@ void MDLTapeStepAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer,
     }
 }
 
+void MDLTapeStepAudioProcessor::updateTail()
+{
+    // Small signals see the saturator's drive gain on every pass, so a hot drive can
+    // keep the loop above unity and ring indefinitely.
+    const auto timeSeconds = juce::jlimit (10.0 / currentSampleRate, 2.5, params[Param::time] * 0.001);
+    const auto loopGain = params[Param::feedback] * (1.0 + 4.0 * params[Param::drive]);
+    tail.setTail (timeSeconds, gls::dsp::TailTracker::getFeedbackRT60 (timeSeconds, loopGain));
+}
+
 void MDLTapeStepAudioProcessor::getStateInformation (juce::MemoryBlock& destData)
 {
     auto state = apvts.copyState();
@@ -110,24 +138,7 @@ void MDLTapeStepAudioProcessor::setStateInformation (const void* data, int sizeI
 juce::AudioProcessorValueTreeState::ParameterLayout
 MDLTapeStepAudioProcessor::createParameterLayout()
 {
-    std::vector<std::unique_ptr<juce::RangedAudioParameter>> params;
-
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("time",     "Time",
-                                                                   juce::NormalisableRange<float> (20.0f, 2000.0f, 0.01f, 0.4f), 450.0f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("feedback", "Feedback",
-                                                                   juce::NormalisableRange<float> (0.0f, 0.95f, 0.001f), 0.4f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("drive",    "Drive",
-                                                                   juce::NormalisableRange<float> (0.0f, 1.0f, 0.001f), 0.5f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("wow",      "Wow",
-                                                                   juce::NormalisableRange<float> (0.0f, 1.0f, 0.001f), 0.2f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("flutter",  "Flutter",
-                                                                   juce::NormalisableRange<float> (0.0f, 1.0f, 0.001f), 0.3f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("tone",     "Tone",
-                                                                   juce::NormalisableRange<float> (-1.0f, 1.0f, 0.001f), 0.0f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("mix",      "Mix",
-                                                                   juce::NormalisableRange<float> (0.0f, 1.0f, 0.001f), 0.5f));
-
-    return { params.begin(), params.end() };
+    return gls::createParameterLayout (parameterTable);
 }
 
 MDLTapeStepAudioProcessorEditor::MDLTapeStepAudioProcessorEditor (MDLTapeStepAudioProcessor& p)
@@ -207,9 +218,7 @@ void MDLTapeStepAudioProcessor::ensureStateSize (int numChannels)
                                       1 };
         for (auto& line : tapeLines)
         {
-            line.delay.setMaximumDelayInSamples ((int) (currentSampleRate * 3.0f));
-            line.delay.prepare (spec);
-            line.delay.reset();
+            line.delay.prepare (currentSampleRate, 2.5);
             line.toneFilter.prepare (spec);
             line.toneFilter.reset();
         }
@@ -225,10 +234,9 @@ void MDLTapeStepAudioProcessor::updateToneFilters (float tone)
         return;
 
     const float baseFreq = juce::jmap (tone, -1.0f, 1.0f, 800.0f, 6000.0f);
-    auto coeffs = juce::dsp::IIR::Coefficients<float>::makeLowPass (currentSampleRate, baseFreq, 0.8f);
 
     for (auto& line : tapeLines)
-        line.toneFilter.coefficients = coeffs;
+        line.toneFilter.setLowPass (currentSampleRate, baseFreq, 0.8f);
 }
 
 juce::AudioProcessor* JUCE_CALLTYPE createPluginFilter()
@@ -1,17 +1,27 @@
 #pragma once
 
 #include <JuceHeader.h>
+#include <array>
 #include "../../DualPrecisionAudioProcessor.h"
+#include "../../ParameterTable.h"
+#include "../../SmoothedParameter.h"
+#include "../../dsp/Biquad.h"
+#include "../../dsp/DelayLine.h"
 
 class MDLTapeStepAudioProcessor : public DualPrecisionAudioProcessor
 {
 public:
+    enum class Param
+    {
+        time, feedback, drive, wow, flutter, tone, mix,
+        count
+    };
+
     MDLTapeStepAudioProcessor();
     ~MDLTapeStepAudioProcessor() override = default;
 
     void prepareToPlay (double sampleRate, int samplesPerBlock) override;
     void releaseResources() override;
-    void processBlock (juce::AudioBuffer<float>&, juce::MidiBuffer&) override;
 
     juce::AudioProcessorEditor* createEditor() override;
     bool hasEditor() const override { return true; }
@@ -20,7 +30,6 @@ public:
     bool acceptsMidi() const override { return false; }
     bool producesMidi() const override { return false; }
     bool isMidiEffect() const override { return false; }
-    double getTailLengthSeconds() const override { return 2.0; }
 
     int getNumPrograms() override { return 1; }
     int getCurrentProgram() override { return 0; }
@@ -34,20 +43,25 @@ public:
     juce::AudioProcessorValueTreeState& getValueTreeState() { return apvts; }
     static juce::AudioProcessorValueTreeState::ParameterLayout createParameterLayout();
 
+protected:
+    void processFloat (juce::AudioBuffer<float>&, juce::MidiBuffer&) override;
+    void updateTail() override;
+
 private:
     juce::AudioProcessorValueTreeState apvts;
+    gls::ParameterHandles<Param> params;
+    gls::SmoothedParameter mixAmount { params, Param::mix };
 
     struct TapeLine
     {
-        juce::dsp::DelayLine<float, juce::dsp::DelayLineInterpolationTypes::Linear> delay { 192000 };
-        juce::dsp::IIR::Filter<float> toneFilter;
+        gls::dsp::DelayLine<float> delay;
+        gls::dsp::Biquad toneFilter;
         float wowPhase = 0.0f;
         float flutterPhase = 0.0f;
         float feedbackSample = 0.0f;
     };
 
     std::vector<TapeLine> tapeLines;
-    juce::AudioBuffer<float> dryBuffer;
 
     double currentSampleRate = 44100.0;
     juce::uint32 lastBlockSize = 512;
@@ -1,15 +1,34 @@
 #include "MDLTempoLFOAudioProcessor.h"
 
+namespace
+{
+using Param = MDLTempoLFOAudioProcessor::Param;
+using Spec = gls::ParameterSpec;
+
+constexpr std::array<Spec, (size_t) Param::count> parameterTable {{
+    Spec::range  ("depth",     "Depth",     0.0f,  1.0f, 0.001f, 1.0f),
+    Spec::range  ("offset",    "Offset",    -1.0f, 1.0f, 0.001f, 0.0f),
+    Spec::range  ("smoothing", "Smoothing", 0.0f,  1.0f, 0.001f, 0.2f),
+    Spec::choice ("shape",     "Shape",     "Sine|Triangle|Square", 0),
+    Spec::choice ("sync",      "Sync",      "1/1|1/2|1/4|1/8",      2)
+}};
+
+static_assert (gls::hasUniqueIds (parameterTable));
+} // namespace
+
 MDLTempoLFOAudioProcessor::MDLTempoLFOAudioProcessor()
-    : DualPrecisionAudioProcessor(BusesProperties()
+    : NativePrecisionAudioProcessor (BusesProperties()
                         .withInput  ("Input", juce::AudioChannelSet::stereo(), true)
                         .withOutput ("Output", juce::AudioChannelSet::stereo(), true)),
-      apvts (*this, nullptr, "TEMPO_LFO", createParameterLayout())
+      apvts (*this, nullptr, "TEMPO_LFO", createParameterLayout()),
+      params (apvts, parameterTable)
 {
 }
 
-void MDLTempoLFOAudioProcessor::prepareToPlay (double sampleRate, int /*samplesPerBlock*/)
+void MDLTempoLFOAudioProcessor::prepareToPlay (double sampleRate, int samplesPerBlock)
 {
+    DualPrecisionAudioProcessor::prepareToPlay (sampleRate, samplesPerBlock);
+
     currentSampleRate = sampleRate > 0.0 ? sampleRate : 44100.0;
     lfoPhase = 0.0f;
     smoothedValue = 0.0f;
@@ -20,8 +39,9 @@ void MDLTempoLFOAudioProcessor::releaseResources()
 {
 }
 
-void MDLTempoLFOAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer,
-                                              juce::MidiBuffer&)
+template <typename SampleType>
+void MDLTempoLFOAudioProcessor::processSamples (juce::AudioBuffer<SampleType>& buffer,
+                                                juce::MidiBuffer&)
 {
     juce::ScopedNoDenormals noDenormals;
 
@@ -30,12 +50,10 @@ void MDLTempoLFOAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer,
     for (int ch = totalIn; ch < totalOut; ++ch)
         buffer.clear (ch, 0, buffer.getNumSamples());
 
-    auto get = [this](const char* id) { return apvts.getRawParameterValue (id)->load(); };
-
-    const float depth    = juce::jlimit (0.0f, 1.0f, get ("depth"));
-    const float offset   = juce::jlimit (-1.0f, 1.0f, get ("offset"));
-    const float smoothing= juce::jlimit (0.0f, 1.0f, get ("smoothing"));
-    const int shape      = (int) std::round (apvts.getRawParameterValue ("shape")->load());
+    const float depth    = juce::jlimit (0.0f, 1.0f, params[Param::depth]);
+    const float offset   = juce::jlimit (-1.0f, 1.0f, params[Param::offset]);
+    const float smoothing= juce::jlimit (0.0f, 1.0f, params[Param::smoothing]);
+    const int shape      = params.getIndex (Param::shape);
 
     const int numSamples = buffer.getNumSamples();
     const int numChannels = buffer.getNumChannels();
@@ -45,6 +63,7 @@ void MDLTempoLFOAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer,
     const float phaseIncrement = getSyncRate();
     const float smoothCoeff = std::exp (-juce::MathConstants<float>::twoPi * smoothing / (float) currentSampleRate);
 
+    // The LFO itself runs in float for either host precision; only the gain is applied at SampleType.
     float phase = lfoPhase;
     float modValue = smoothedValue;
 
@@ -54,7 +73,7 @@ void MDLTempoLFOAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer,
         modValue = smoothCoeff * modValue + (1.0f - smoothCoeff) * target;
 
         const float wet = juce::jlimit (-1.0f, 1.0f, offset + depth * modValue);
-        const float gain = juce::jlimit (0.0f, 2.0f, 1.0f + wet);
+        const auto gain = (SampleType) juce::jlimit (0.0f, 2.0f, 1.0f + wet);
 
         for (int ch = 0; ch < numChannels; ++ch)
             buffer.setSample (ch, i, buffer.getSample (ch, i) * gain);
@@ -68,6 +87,9 @@ void MDLTempoLFOAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer,
     smoothedValue = modValue;
 }
 
+template void MDLTempoLFOAudioProcessor::processSamples<float>  (juce::AudioBuffer<float>&,  juce::MidiBuffer&);
+template void MDLTempoLFOAudioProcessor::processSamples<double> (juce::AudioBuffer<double>&, juce::MidiBuffer&);
+
 void MDLTempoLFOAudioProcessor::getStateInformation (juce::MemoryBlock& destData)
 {
     auto state = apvts.copyState();
@@ -84,20 +106,7 @@ void MDLTempoLFOAudioProcessor::setStateInformation (const void* data, int sizeI
 juce::AudioProcessorValueTreeState::ParameterLayout
 MDLTempoLFOAudioProcessor::createParameterLayout()
 {
-    std::vector<std::unique_ptr<juce::RangedAudioParameter>> params;
-
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("depth",  "Depth",
-                                                                   juce::NormalisableRange<float> (0.0f, 1.0f, 0.001f), 1.0f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("offset", "Offset",
-                                                                   juce::NormalisableRange<float> (-1.0f, 1.0f, 0.001f), 0.0f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("smoothing", "Smoothing",
-                                                                   juce::NormalisableRange<float> (0.0f, 1.0f, 0.001f), 0.2f));
-    params.push_back (std::make_unique<juce::AudioParameterChoice>("shape", "Shape",
-                                                                   juce::StringArray { "Sine", "Triangle", "Square" }, 0));
-    params.push_back (std::make_unique<juce::AudioParameterChoice>("sync",  "Sync",
-                                                                   juce::StringArray { "1/1", "1/2", "1/4", "1/8" }, 2));
-
-    return { params.begin(), params.end() };
+    return gls::createParameterLayout (parameterTable);
 }
 
 MDLTempoLFOAudioProcessorEditor::MDLTempoLFOAudioProcessorEditor (MDLTempoLFOAudioProcessor& p)
@@ -160,7 +169,7 @@ juce::AudioProcessorEditor* MDLTempoLFOAudioProcessor::createEditor()
 
 float MDLTempoLFOAudioProcessor::getSyncRate() const
 {
-    const int syncIndex = (int) std::round (apvts.getRawParameterValue ("sync")->load());
+    const int syncIndex = params.getIndex (Param::sync);
     const float noteLength = (syncIndex == 0 ? 1.0f :
                               syncIndex == 1 ? 0.5f :
                               syncIndex == 2 ? 0.25f : 0.125f);
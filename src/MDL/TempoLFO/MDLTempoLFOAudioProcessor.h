@@ -1,17 +1,27 @@
 #pragma once
 
 #include <JuceHeader.h>
+#include <array>
 #include "../../DualPrecisionAudioProcessor.h"
+#include "../../ParameterTable.h"
 
-class MDLTempoLFOAudioProcessor : public DualPrecisionAudioProcessor
+class MDLTempoLFOAudioProcessor : public NativePrecisionAudioProcessor<MDLTempoLFOAudioProcessor>
 {
 public:
+    enum class Param
+    {
+        depth, offset, smoothing, shape, sync,
+        count
+    };
+
     MDLTempoLFOAudioProcessor();
     ~MDLTempoLFOAudioProcessor() override = default;
 
     void prepareToPlay (double sampleRate, int samplesPerBlock) override;
     void releaseResources() override;
-    void processBlock (juce::AudioBuffer<float>&, juce::MidiBuffer&) override;
+
+    template <typename SampleType>
+    void processSamples (juce::AudioBuffer<SampleType>&, juce::MidiBuffer&);
 
     juce::AudioProcessorEditor* createEditor() override;
     bool hasEditor() const override { return true; }
@@ -20,7 +30,6 @@ public:
     bool acceptsMidi() const override { return false; }
     bool producesMidi() const override { return false; }
     bool isMidiEffect() const override { return false; }
-    double getTailLengthSeconds() const override { return 0.0; }
 
     int getNumPrograms() override { return 1; }
     int getCurrentProgram() override { return 0; }
@@ -36,6 +45,7 @@ public:
 
 private:
     juce::AudioProcessorValueTreeState apvts;
+    gls::ParameterHandles<Param> params;
 
     float lfoPhase = 0.0f;
     float smoothedValue = 0.0f;
@@ -1,31 +1,51 @@
 #include "MDLVibeMorphAudioProcessor.h"
 
+namespace
+{
+using Param = MDLVibeMorphAudioProcessor::Param;
+using Spec = gls::ParameterSpec;
+
+constexpr std::array<Spec, (size_t) Param::count> parameterTable {{
+    Spec::range  ("rate",  "Rate",  0.05f, 10.0f, 0.001f, 1.2f, 0.4f),
+    Spec::range  ("depth", "Depth", 0.0f,  1.0f,  0.001f, 0.8f),
+    Spec::range  ("throb", "Throb", 0.0f,  1.0f,  0.001f, 0.4f),
+    Spec::choice ("mode",  "Mode",  "Vibe|Chorus", 0),
+    Spec::range  ("mix",   "Mix",   0.0f,  1.0f,  0.001f, 0.5f)
+}};
+
+static_assert (gls::hasUniqueIds (parameterTable));
+} // namespace
+
 MDLVibeMorphAudioProcessor::MDLVibeMorphAudioProcessor()
     : DualPrecisionAudioProcessor(BusesProperties()
                         .withInput  ("Input", juce::AudioChannelSet::stereo(), true)
                         .withOutput ("Output", juce::AudioChannelSet::stereo(), true)),
-      apvts (*this, nullptr, "VIBE_MORPH", createParameterLayout())
+      apvts (*this, nullptr, "VIBE_MORPH", createParameterLayout()),
+      params (apvts, parameterTable)
 {
 }
 
 void MDLVibeMorphAudioProcessor::prepareToPlay (double sampleRate, int samplesPerBlock)
 {
+    DualPrecisionAudioProcessor::prepareToPlay (sampleRate, samplesPerBlock);
+
     currentSampleRate = sampleRate > 0.0 ? sampleRate : 44100.0;
-    lastBlockSize = (juce::uint32) juce::jmax (1, samplesPerBlock);
-    const auto channels = juce::jmax (1, getTotalNumOutputChannels());
-    dryBuffer.setSize (channels, (int) lastBlockSize);
-    const int mode = (int) std::round (apvts.getRawParameterValue ("mode")->load());
-    ensureStageState (channels, mode == 0 ? 4 : 6);
-    lfoPhase.assign ((size_t) channels, 0.0f);
+    const auto channels = juce::jmax (1, getTotalNumInputChannels(), getTotalNumOutputChannels());
+    cascade.prepare (currentSampleRate, channels);
+    mixAmount.prepare (currentSampleRate, samplesPerBlock);
+    lfoPhase = 0.0f;
 }
 
 void MDLVibeMorphAudioProcessor::releaseResources()
 {
 }
 
-void MDLVibeMorphAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer,
-                                               juce::MidiBuffer&)
+void MDLVibeMorphAudioProcessor::processFloat (juce::AudioBuffer<float>& buffer,
+                                               juce::MidiBuffer& midi)
 {
+    if (renderInPreparedChunks (buffer, midi))
+        return;
+
     juce::ScopedNoDenormals noDenormals;
 
     const auto totalIn  = getTotalNumInputChannels();
@@ -33,43 +53,72 @@ void MDLVibeMorphAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer,
     for (int ch = totalIn; ch < totalOut; ++ch)
         buffer.clear (ch, 0, buffer.getNumSamples());
 
-    auto get = [this](const char* id) { return apvts.getRawParameterValue (id)->load(); };
+    const float rate  = juce::jlimit (0.05f, 10.0f, params[Param::rate]);
+    const float depth = juce::jlimit (0.0f, 1.0f, params[Param::depth]);
+    const float throb = juce::jlimit (0.0f, 1.0f, params[Param::throb]);
+    const int mode    = params.getIndex (Param::mode);
 
-    const float rate  = juce::jlimit (0.05f, 10.0f, get ("rate"));
-    const float depth = juce::jlimit (0.0f, 1.0f, get ("depth"));
-    const float throb = juce::jlimit (0.0f, 1.0f, get ("throb"));
-    const int mode    = (int) std::round (apvts.getRawParameterValue ("mode")->load());
-    const float mix   = juce::jlimit (0.0f, 1.0f, get ("mix"));
+    using Cascade = gls::dsp::ModulatedAllPassCascade;
+    using Lanes = Cascade::Lanes;
+    constexpr int lanes = Cascade::lanesPerGroup;
 
-    const int numChannels = buffer.getNumChannels();
     const int numSamples  = buffer.getNumSamples();
+    const int numChannels = juce::jmin (buffer.getNumChannels(), cascade.getNumGroups() * lanes);
+    const int numGroups   = (numChannels + lanes - 1) / lanes;
+    auto* const* channels = buffer.getArrayOfWritePointers();
 
-    lastBlockSize = (juce::uint32) juce::jmax (1, numSamples);
-    ensureStageState (numChannels, mode == 0 ? 4 : 6);
-    if ((int) lfoPhase.size() < numChannels)
-        lfoPhase.resize ((size_t) numChannels, 0.0f);
-    dryBuffer.setSize (numChannels, numSamples, false, false, true);
-    dryBuffer.makeCopyOf (buffer, true);
+    const float intervalPhase = rate / (float) currentSampleRate * juce::MathConstants<float>::twoPi
+                                * (float) Cascade::controlInterval;
+    cascade.setNumStages (mode == 0 ? 4 : 6);
 
-    updateStageCoefficients (rate, depth, throb, mode);
+    mixAmount.update();
+    const auto* mixes = mixAmount.advance (numSamples);
+    const float mix = mixAmount.getCurrentValue();
 
-    for (int ch = 0; ch < numChannels; ++ch)
+    for (int i = 0; i < numSamples; ++i)
     {
-        auto* wet = buffer.getWritePointer (ch);
-        const auto* dry = dryBuffer.getReadPointer (ch);
-        auto& stages = channelStages[ch];
+        if (cascade.needsTargets())
+        {
+            lfoPhase += intervalPhase;
+            if (lfoPhase > juce::MathConstants<float>::twoPi)
+                lfoPhase -= juce::MathConstants<float>::twoPi;
+
+            updateStageTargets (depth, throb, mode);
+        }
 
-        for (int i = 0; i < numSamples; ++i)
+        for (int group = 0; group < numGroups; ++group)
         {
-            float sample = dry[i];
-            for (auto& stage : stages)
-                sample = stage.filter.processSample (sample);
+            const int firstChannel = group * lanes;
+            const int groupChannels = juce::jmin (lanes, numChannels - firstChannel);
 
-            wet[i] = sample * mix + dry[i] * (1.0f - mix);
+            alignas (Lanes::SIMDRegisterSize) float frame[(size_t) lanes] {};
+            for (int l = 0; l < groupChannels; ++l)
+                frame[l] = channels[firstChannel + l][i];
+
+            const auto dry = Lanes::fromRawArray (frame);
+            const auto wet = cascade.processSample (group, dry);
+
+            const float amount = mixes != nullptr ? mixes[i] : mix;
+            (wet * amount + dry * (1.0f - amount)).copyToRawArray (frame);
+            for (int l = 0; l < groupChannels; ++l)
+                channels[firstChannel + l][i] = frame[l];
         }
+
+        cascade.advance();
     }
 }
 
+void MDLVibeMorphAudioProcessor::updateTail()
+{
+    // Each second-order stage delays by about 2Q / (pi * f) around its corner, most at
+    // the lowest swept one.
+    const auto base = params.getIndex (Param::mode) == 0 ? 350.0 : 900.0;
+    const auto stages = params.getIndex (Param::mode) == 0 ? 4 : 6;
+    const auto lowest = juce::jmax (20.0, base * (1.0 - params[Param::depth]));
+    const auto q = (double) stageQ (juce::jlimit (0.0f, 1.0f, params[Param::throb]));
+    tail.setTail (stages * 2.0 * q / (juce::MathConstants<double>::pi * lowest));
+}
+
 void MDLVibeMorphAudioProcessor::getStateInformation (juce::MemoryBlock& destData)
 {
     auto state = apvts.copyState();
@@ -86,20 +135,7 @@ void MDLVibeMorphAudioProcessor::setStateInformation (const void* data, int size
 juce::AudioProcessorValueTreeState::ParameterLayout
 MDLVibeMorphAudioProcessor::createParameterLayout()
 {
-    std::vector<std::unique_ptr<juce::RangedAudioParameter>> params;
-
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("rate",  "Rate",
-                                                                   juce::NormalisableRange<float> (0.05f, 10.0f, 0.001f, 0.4f), 1.2f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("depth", "Depth",
-                                                                   juce::NormalisableRange<float> (0.0f, 1.0f, 0.001f), 0.8f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("throb", "Throb",
-                                                                   juce::NormalisableRange<float> (0.0f, 1.0f, 0.001f), 0.4f));
-    params.push_back (std::make_unique<juce::AudioParameterChoice>("mode",  "Mode",
-                                                                   juce::StringArray { "Vibe", "Chorus" }, 0));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("mix",   "Mix",
-                                                                   juce::NormalisableRange<float> (0.0f, 1.0f, 0.001f), 0.5f));
-
-    return { params.begin(), params.end() };
+    return gls::createParameterLayout (parameterTable);
 }
 
 MDLVibeMorphAudioProcessorEditor::MDLVibeMorphAudioProcessorEditor (MDLVibeMorphAudioProcessor& p)
@@ -161,72 +197,19 @@ juce::AudioProcessorEditor* MDLVibeMorphAudioProcessor::createEditor()
     return new MDLVibeMorphAudioProcessorEditor (*this);
 }
 
-void MDLVibeMorphAudioProcessor::ensureStageState (int numChannels, int numStages)
+void MDLVibeMorphAudioProcessor::updateStageTargets (float depth, float throb, int mode)
 {
-    if (numChannels <= 0 || numStages <= 0)
-        return;
-
-    if ((int) channelStages.size() < numChannels)
-        channelStages.resize (numChannels);
-
-    for (auto& stages : channelStages)
-    {
-        if ((int) stages.size() < numStages)
-        {
-            const int previous = (int) stages.size();
-            stages.resize (numStages);
-        }
-    }
-
-    const auto targetBlock = lastBlockSize > 0 ? lastBlockSize : 512u;
-    const bool specChanged = ! juce::approximatelyEqual (stageSpecSampleRate, currentSampleRate)
-                             || stageSpecBlockSize != targetBlock;
-
-    if (specChanged)
-    {
-        juce::dsp::ProcessSpec spec { currentSampleRate,
-                                      targetBlock,
-                                      1 };
-
-        for (auto& stages : channelStages)
-            for (auto& stage : stages)
-            {
-                stage.filter.prepare (spec);
-                stage.filter.reset();
-            }
-
-        stageSpecSampleRate = currentSampleRate;
-        stageSpecBlockSize  = targetBlock;
-    }
-}
-
-void MDLVibeMorphAudioProcessor::updateStageCoefficients (float rate, float depth, float throb, int mode)
-{
-    if (currentSampleRate <= 0.0)
-        return;
-
     const float baseFreq = mode == 0 ? 350.0f : 900.0f;
-    if ((int) lfoPhase.size() < (int) channelStages.size())
-        lfoPhase.resize (channelStages.size(), 0.0f);
+    const float maxFreq  = (float) (currentSampleRate * 0.45f);
 
-    for (int ch = 0; ch < (int) channelStages.size(); ++ch)
+    std::array<float, gls::dsp::ModulatedAllPassCascade::maxStages> freqs {};
+    for (int s = 0; s < cascade.getNumStages(); ++s)
     {
-        auto& stages = channelStages[ch];
-        float& phase = lfoPhase[ch];
-
-        for (int s = 0; s < (int) stages.size(); ++s)
-        {
-            const float mod = std::sin (phase + s * 0.3f) * depth;
-            const float freq = juce::jlimit (20.0f, (float) (currentSampleRate * 0.45f), baseFreq + mod * baseFreq);
-            auto coeffs = juce::dsp::IIR::Coefficients<float>::makeAllPass (currentSampleRate, freq,
-                                                                            1.0f + throb * 0.5f);
-            stages[s].filter.coefficients = coeffs;
-        }
-
-        phase += rate / (float) currentSampleRate * juce::MathConstants<float>::twoPi;
-        if (phase > juce::MathConstants<float>::twoPi)
-            phase -= juce::MathConstants<float>::twoPi;
+        const float mod = std::sin (lfoPhase + (float) s * 0.3f) * depth;
+        freqs[(size_t) s] = juce::jlimit (20.0f, maxFreq, baseFreq + mod * baseFreq);
     }
+
+    cascade.setTargets (freqs.data(), stageQ (throb));
 }
 
 juce::AudioProcessor* JUCE_CALLTYPE createPluginFilter()
@@ -1,17 +1,26 @@
 #pragma once
 
 #include <JuceHeader.h>
+#include <array>
 #include "../../DualPrecisionAudioProcessor.h"
+#include "../../ParameterTable.h"
+#include "../../SmoothedParameter.h"
+#include "../../dsp/ModulatedAllPass.h"
 
 class MDLVibeMorphAudioProcessor : public DualPrecisionAudioProcessor
 {
 public:
+    enum class Param
+    {
+        rate, depth, throb, mode, mix,
+        count
+    };
+
     MDLVibeMorphAudioProcessor();
     ~MDLVibeMorphAudioProcessor() override = default;
 
     void prepareToPlay (double sampleRate, int samplesPerBlock) override;
     void releaseResources() override;
-    void processBlock (juce::AudioBuffer<float>&, juce::MidiBuffer&) override;
 
     juce::AudioProcessorEditor* createEditor() override;
     bool hasEditor() const override { return true; }
@@ -20,7 +29,6 @@ public:
     bool acceptsMidi() const override { return false; }
     bool producesMidi() const override { return false; }
     bool isMidiEffect() const override { return false; }
-    double getTailLengthSeconds() const override { return 1.0; }
 
     int getNumPrograms() override { return 1; }
     int getCurrentProgram() override { return 0; }
@@ -34,24 +42,21 @@ public:
     juce::AudioProcessorValueTreeState& getValueTreeState() { return apvts; }
     static juce::AudioProcessorValueTreeState::ParameterLayout createParameterLayout();
 
+protected:
+    void processFloat (juce::AudioBuffer<float>&, juce::MidiBuffer&) override;
+    void updateTail() override;
+
 private:
     juce::AudioProcessorValueTreeState apvts;
+    gls::ParameterHandles<Param> params;
+    gls::SmoothedParameter mixAmount { params, Param::mix };
 
-    struct Stage
-    {
-        juce::dsp::IIR::Filter<float> filter;
-    };
-
-    std::vector<std::vector<Stage>> channelStages;
-    juce::AudioBuffer<float> dryBuffer;
+    gls::dsp::ModulatedAllPassCascade cascade;
     double currentSampleRate = 44100.0;
-    juce::uint32 lastBlockSize = 512;
-    double stageSpecSampleRate = 0.0;
-    juce::uint32 stageSpecBlockSize = 0;
-    std::vector<float> lfoPhase;
+    float lfoPhase = 0.0f;
 
-    void ensureStageState (int numChannels, int numStages);
-    void updateStageCoefficients (float rate, float depth, float throb, int mode);
+    void updateStageTargets (float depth, float throb, int mode);
+    static float stageQ (float throb) noexcept { return 1.0f + throb * 0.5f; }
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (MDLVibeMorphAudioProcessor)
 };
@@ -1,37 +1,51 @@
 #include "MDLWideTrackAudioProcessor.h"
 
+namespace
+{
+using Param = MDLWideTrackAudioProcessor::Param;
+using Spec = gls::ParameterSpec;
+
+constexpr std::array<Spec, (size_t) Param::count> parameterTable {{
+    Spec::range ("width",        "Width",        0.0f,   2.0f,  0.001f, 1.2f),
+    Spec::range ("delay_spread", "Delay Spread", 0.0f,   5.0f,  0.001f, 1.5f),
+    Spec::range ("hf_preserve",  "HF Preserve",  0.0f,   1.0f,  0.001f, 0.8f),
+    Spec::range ("mono_safe",    "Mono Safe",    0.0f,   1.0f,  0.001f, 0.5f),
+    Spec::range ("output_trim",  "Output Trim",  -18.0f, 18.0f, 0.01f,  0.0f)
+}};
+
+static_assert (gls::hasUniqueIds (parameterTable));
+} // namespace
+
 MDLWideTrackAudioProcessor::MDLWideTrackAudioProcessor()
     : DualPrecisionAudioProcessor (BusesProperties()
                         .withInput  ("Input", juce::AudioChannelSet::stereo(), true)
                         .withOutput ("Output", juce::AudioChannelSet::stereo(), true)),
-      apvts (*this, nullptr, "WIDE_TRACK", createParameterLayout())
+      apvts (*this, nullptr, "WIDE_TRACK", createParameterLayout()),
+      params (apvts, parameterTable)
 {
 }
 
 void MDLWideTrackAudioProcessor::prepareToPlay (double sampleRate, int samplesPerBlock)
 {
+    DualPrecisionAudioProcessor::prepareToPlay (sampleRate, samplesPerBlock);
+
     currentSampleRate = sampleRate > 0.0 ? sampleRate : 44100.0;
     lastBlockSize = (juce::uint32) juce::jmax (1, samplesPerBlock);
-    const auto channels = juce::jmax (1, getTotalNumOutputChannels());
-    dryBuffer.setSize (channels, (int) lastBlockSize);
-    sumDiffBuffer.setSize (2, (int) lastBlockSize);
-
-    const int maxDelay = (int) std::ceil (currentSampleRate * 0.02);
-    sideDelay.setMaximumDelayInSamples (juce::jmax (1, maxDelay));
-    juce::dsp::ProcessSpec spec { currentSampleRate, lastBlockSize, 1 };
-    sideDelay.prepare (spec);
-    sideDelay.reset();
-    delaySpecSampleRate = currentSampleRate;
-    delaySpecBlockSize = lastBlockSize;
+    outputTrimGain.prepare (currentSampleRate, (int) lastBlockSize);
+
+    sideDelay.prepare (currentSampleRate, 0.02);
 }
 
 void MDLWideTrackAudioProcessor::releaseResources()
 {
 }
 
-void MDLWideTrackAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer,
-                                               juce::MidiBuffer&)
+void MDLWideTrackAudioProcessor::processFloat (juce::AudioBuffer<float>& buffer,
+                                               juce::MidiBuffer& midi)
 {
+    if (renderInPreparedChunks (buffer, midi))
+        return;
+
     juce::ScopedNoDenormals noDenormals;
 
     const auto totalIn  = getTotalNumInputChannels();
@@ -44,69 +58,55 @@ void MDLWideTrackAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer,
     if (numChannels == 0 || numSamples == 0)
         return;
 
-    const auto getParam = [this](const char* id) { return apvts.getRawParameterValue (id)->load(); };
-
-    float width     = juce::jlimit (0.0f, 2.0f, getParam ("width"));
-    const float spreadMs  = juce::jlimit (0.0f, 5.0f, getParam ("delay_spread"));
-    const float hfPreserve= juce::jlimit (0.0f, 1.0f, getParam ("hf_preserve"));
-    const float monoSafeVal = juce::jlimit (0.0f, 1.0f, getParam ("mono_safe"));
-    const float outputTrim  = getParam ("output_trim");
+    float width     = juce::jlimit (0.0f, 2.0f, params[Param::width]);
+    const float spreadMs  = juce::jlimit (0.0f, 5.0f, params[Param::delaySpread]);
+    const float hfPreserve= juce::jlimit (0.0f, 1.0f, params[Param::hfPreserve]);
+    const float monoSafeVal = juce::jlimit (0.0f, 1.0f, params[Param::monoSafe]);
     const bool monoSafe   = monoSafeVal > 0.5f;
 
     if (monoSafe)
         width = juce::jlimit (0.0f, 1.0f, width);
 
-    const float trimGain = juce::Decibels::decibelsToGain (outputTrim);
-
-    lastBlockSize = (juce::uint32) juce::jmax (1, numSamples);
-    dryBuffer.setSize (numChannels, numSamples, false, false, true);
-    dryBuffer.makeCopyOf (buffer, true);
-    sumDiffBuffer.setSize (2, numSamples, false, false, true);
+    // The trim rides in the same pass as the width matrix; it only renders per-sample
+    // gains while it moves.
+    outputTrimGain.update();
+    const auto* trims = outputTrimGain.advance (numSamples);
+    const auto trimGain = outputTrimGain.getCurrentValue();
 
     if ((int) numChannels >= 2)
     {
-        for (int i = 0; i < numSamples; ++i)
-        {
-            const float left  = dryBuffer.getSample (0, i);
-            const float right = dryBuffer.getSample (1, i);
-            const float mid   = 0.5f * (left + right);
-            const float side  = 0.5f * (left - right);
-            sumDiffBuffer.setSample (0, i, mid);
-            sumDiffBuffer.setSample (1, i, side);
-        }
-
         const float delaySamples = juce::jlimit (0.0f, 0.02f * (float) currentSampleRate,
                                                  spreadMs * 0.001f * (float) currentSampleRate);
-        if (! juce::approximatelyEqual (delaySpecSampleRate, currentSampleRate)
-            || delaySpecBlockSize != lastBlockSize)
-        {
-            juce::dsp::ProcessSpec spec { currentSampleRate, lastBlockSize, 1 };
-            sideDelay.setMaximumDelayInSamples ((int) std::ceil (currentSampleRate * 0.02));
-            sideDelay.prepare (spec);
-            sideDelay.reset();
-            delaySpecSampleRate = currentSampleRate;
-            delaySpecBlockSize  = lastBlockSize;
-        }
-        sideDelay.setDelay (delaySamples);
+
+        auto* left  = buffer.getWritePointer (0);
+        auto* right = buffer.getWritePointer (1);
 
         for (int i = 0; i < numSamples; ++i)
         {
-            const float mid  = sumDiffBuffer.getSample (0, i);
-            float side       = sumDiffBuffer.getSample (1, i) * width;
+            const float mid  = 0.5f * (left[i] + right[i]);
+            float side       = 0.5f * (left[i] - right[i]) * width;
 
-            const float delayedSide = sideDelay.popSample (0);
-            sideDelay.pushSample (0, side);
+            const float delayedSide = sideDelay.process (side, delaySamples);
             side = delayedSide * (1.0f - hfPreserve) + side * hfPreserve;
 
-            buffer.setSample (0, i, (mid + side) * trimGain);
-            buffer.setSample (1, i, (mid - side) * trimGain);
+            const float gain = trims != nullptr ? trims[i] : trimGain;
+            left[i]  = (mid + side) * gain;
+            right[i] = (mid - side) * gain;
         }
     }
-    else
+    else if (trims != nullptr)
     {
-        for (int i = 0; i < numSamples; ++i)
-            buffer.setSample (0, i, dryBuffer.getSample (0, i) * trimGain);
+        juce::FloatVectorOperations::multiply (buffer.getWritePointer (0), trims, numSamples);
     }
+    else if (trimGain != 1.0f)
+    {
+        buffer.applyGain (0, 0, numSamples, trimGain);
+    }
+}
+
+void MDLWideTrackAudioProcessor::updateTail()
+{
+    tail.setTail (juce::jlimit (0.0f, 5.0f, params[Param::delaySpread]) * 0.001);
 }
 
 void MDLWideTrackAudioProcessor::getStateInformation (juce::MemoryBlock& destData)
@@ -125,20 +125,7 @@ void MDLWideTrackAudioProcessor::setStateInformation (const void* data, int size
 juce::AudioProcessorValueTreeState::ParameterLayout
 MDLWideTrackAudioProcessor::createParameterLayout()
 {
-    std::vector<std::unique_ptr<juce::RangedAudioParameter>> params;
-
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("width",       "Width",
-                                                                   juce::NormalisableRange<float> (0.0f, 2.0f, 0.001f), 1.2f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("delay_spread","Delay Spread",
-                                                                   juce::NormalisableRange<float> (0.0f, 5.0f, 0.001f), 1.5f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("hf_preserve", "HF Preserve",
-                                                                   juce::NormalisableRange<float> (0.0f, 1.0f, 0.001f), 0.8f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("mono_safe",   "Mono Safe",
-                                                                   juce::NormalisableRange<float> (0.0f, 1.0f, 0.001f), 0.5f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("output_trim", "Output Trim",
-                                                                   juce::NormalisableRange<float> (-18.0f, 18.0f, 0.01f), 0.0f));
-
-    return { params.begin(), params.end() };
+    return gls::createParameterLayout (parameterTable);
 }
 
 MDLWideTrackAudioProcessorEditor::MDLWideTrackAudioProcessorEditor (MDLWideTrackAudioProcessor& p)
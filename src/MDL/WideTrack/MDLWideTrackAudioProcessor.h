@@ -1,17 +1,26 @@
 #pragma once
 
 #include <JuceHeader.h>
+#include <array>
 #include "../../DualPrecisionAudioProcessor.h"
+#include "../../ParameterTable.h"
+#include "../../SmoothedParameter.h"
+#include "../../dsp/DelayLine.h"
 
 class MDLWideTrackAudioProcessor : public DualPrecisionAudioProcessor
 {
 public:
+    enum class Param
+    {
+        width, delaySpread, hfPreserve, monoSafe, outputTrim,
+        count
+    };
+
     MDLWideTrackAudioProcessor();
     ~MDLWideTrackAudioProcessor() override = default;
 
     void prepareToPlay (double sampleRate, int samplesPerBlock) override;
     void releaseResources() override;
-    void processBlock (juce::AudioBuffer<float>&, juce::MidiBuffer&) override;
 
     juce::AudioProcessorEditor* createEditor() override;
     bool hasEditor() const override { return true; }
@@ -20,7 +29,6 @@ public:
     bool acceptsMidi() const override { return false; }
     bool producesMidi() const override { return false; }
     bool isMidiEffect() const override { return false; }
-    double getTailLengthSeconds() const override { return 0.0; }
 
     int getNumPrograms() override { return 1; }
     int getCurrentProgram() override { return 0; }
@@ -34,16 +42,18 @@ public:
     juce::AudioProcessorValueTreeState& getValueTreeState() { return apvts; }
     static juce::AudioProcessorValueTreeState::ParameterLayout createParameterLayout();
 
+protected:
+    void processFloat (juce::AudioBuffer<float>&, juce::MidiBuffer&) override;
+    void updateTail() override;
+
 private:
     juce::AudioProcessorValueTreeState apvts;
+    gls::ParameterHandles<Param> params;
+    gls::SmoothedParameter outputTrimGain { params, Param::outputTrim, gls::SmoothedParameter::Mapping::decibels };
 
-    juce::AudioBuffer<float> dryBuffer;
-    juce::AudioBuffer<float> sumDiffBuffer;
     double currentSampleRate = 44100.0;
     juce::uint32 lastBlockSize = 512;
-    juce::dsp::DelayLine<float, juce::dsp::DelayLineInterpolationTypes::Linear> sideDelay { 48000 };
-    double delaySpecSampleRate = 0.0;
-    juce::uint32 delaySpecBlockSize = 0;
+    gls::dsp::DelayLine<float> sideDelay;
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (MDLWideTrackAudioProcessor)
 };
@@ -9,39 +9,63 @@ constexpr auto paramSpread = "spread";
 constexpr auto paramHPF    = "hpf";
 constexpr auto paramLPF    = "lpf";
 constexpr auto paramMix    = "mix";
+
+using Param = PITDoubleStrikeAudioProcessor::Param;
+using Spec = gls::ParameterSpec;
+
+constexpr std::array<Spec, (size_t) Param::count> parameterTable {{
+    Spec::range (paramVoiceA, "Voice A Pitch", -12.0f,  12.0f,    0.01f,   7.0f),
+    Spec::range (paramVoiceB, "Voice B Pitch", -12.0f,  12.0f,    0.01f,   -5.0f),
+    Spec::range (paramDetune, "Detune",        -20.0f,  20.0f,    0.01f,   0.0f),
+    Spec::range (paramSpread, "Spread",        0.0f,    1.0f,     0.0001f, 0.5f),
+    Spec::range (paramHPF,    "HPF",           20.0f,   2000.0f,  0.01f,   120.0f,   0.45f),
+    Spec::range (paramLPF,    "LPF",           1000.0f, 20000.0f, 0.01f,   14000.0f, 0.45f),
+    Spec::range (paramMix,    "Mix",           0.0f,    1.0f,     0.0001f, 0.7f)
+}};
+
+static_assert (gls::hasUniqueIds (parameterTable));
 }
 
 PITDoubleStrikeAudioProcessor::PITDoubleStrikeAudioProcessor()
     : DualPrecisionAudioProcessor (BusesProperties()
                         .withInput  ("Input", juce::AudioChannelSet::stereo(), true)
                         .withOutput ("Output", juce::AudioChannelSet::stereo(), true)),
-      apvts (*this, nullptr, "PIT_DOUBLE_STRIKE", createParameterLayout())
+      apvts (*this, nullptr, "PIT_DOUBLE_STRIKE", createParameterLayout()),
+      params (apvts, parameterTable)
 {
+    voiceAShifter.attach (apvts);
+    voiceBShifter.attach (apvts);
 }
 
 void PITDoubleStrikeAudioProcessor::prepareToPlay (double sampleRate, int samplesPerBlock)
 {
+    DualPrecisionAudioProcessor::prepareToPlay (sampleRate, samplesPerBlock);
+
     currentSampleRate = sampleRate > 0.0 ? sampleRate : 44100.0;
-    const auto totalChannels = juce::jmax (2, getTotalNumOutputChannels());
+    const auto totalChannels = juce::jmax (2, getTotalNumInputChannels(), getTotalNumOutputChannels());
     const auto blockSize = juce::jmax (1, samplesPerBlock);
 
-    dryBuffer.setSize (totalChannels, blockSize);
-    wetBuffer.setSize (totalChannels, blockSize);
     voiceABuffer.setSize (totalChannels, blockSize);
     voiceBBuffer.setSize (totalChannels, blockSize);
+    mixAmount.prepare (currentSampleRate, blockSize);
 
     voiceAShifter.prepare (currentSampleRate, totalChannels);
     voiceBShifter.prepare (currentSampleRate, totalChannels);
-    voiceAShifter.reset();
-    voiceBShifter.reset();
+    dryWet.prepare (currentSampleRate, totalChannels, blockSize, voiceAShifter.getMaximumLatencySamples());
+    latency.invalidate();
+    updatePitchEngines();
 
     hpfFilters.clear();
     lpfFilters.clear();
+    ensureState (totalChannels, blockSize);
 }
 
-void PITDoubleStrikeAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer,
-                                                  juce::MidiBuffer&)
+void PITDoubleStrikeAudioProcessor::processFloat (juce::AudioBuffer<float>& buffer,
+                                                  juce::MidiBuffer& midi)
 {
+    if (renderInPreparedChunks (buffer, midi))
+        return;
+
     juce::ScopedNoDenormals noDenormals;
 
     const auto totalIn  = getTotalNumInputChannels();
@@ -50,18 +74,17 @@ void PITDoubleStrikeAudioProcessor::processBlock (juce::AudioBuffer<float>& buff
         buffer.clear (ch, 0, buffer.getNumSamples());
 
     ensureState (buffer.getNumChannels(), buffer.getNumSamples());
-    dryBuffer.makeCopyOf (buffer, true);
     voiceABuffer.makeCopyOf (buffer, true);
     voiceBBuffer.makeCopyOf (buffer, true);
-    wetBuffer.clear();
+    updatePitchEngines();
+    dryWet.begin (buffer, buffer.getNumSamples(), mixAmount);
 
-    const auto voiceA = apvts.getRawParameterValue (paramVoiceA)->load();
-    const auto voiceB = apvts.getRawParameterValue (paramVoiceB)->load();
-    const auto detune = apvts.getRawParameterValue (paramDetune)->load();
-    const auto hpf    = apvts.getRawParameterValue (paramHPF)->load();
-    const auto lpf    = apvts.getRawParameterValue (paramLPF)->load();
-    const auto spread = apvts.getRawParameterValue (paramSpread)->load();
-    const auto mix    = juce::jlimit (0.0f, 1.0f, apvts.getRawParameterValue (paramMix)->load());
+    const auto voiceA = params[Param::voiceAPitch];
+    const auto voiceB = params[Param::voiceBPitch];
+    const auto detune = params[Param::detune];
+    const auto hpf    = params[Param::hpf];
+    const auto lpf    = params[Param::lpf];
+    const auto spread = params[Param::spread];
 
     updateFilters (hpf, lpf);
 
@@ -90,41 +113,25 @@ void PITDoubleStrikeAudioProcessor::processBlock (juce::AudioBuffer<float>& buff
                                                   ? voiceBBuffer.getSample (1, i)
                                                   : voiceBBuffer.getSample (0, i)));
 
-        const float wetL = voiceASample * voiceAL + voiceBSample * voiceBL;
-        const float wetR = voiceASample * voiceAR + voiceBSample * voiceBR;
-        wetBuffer.setSample (0, i, wetL);
-        if (wetBuffer.getNumChannels() > 1)
-            wetBuffer.setSample (1, i, wetR);
+        buffer.setSample (0, i, voiceASample * voiceAL + voiceBSample * voiceBL);
+        if (buffer.getNumChannels() > 1)
+            buffer.setSample (1, i, voiceASample * voiceAR + voiceBSample * voiceBR);
     }
 
     for (int ch = 0; ch < buffer.getNumChannels(); ++ch)
     {
-        auto* data = wetBuffer.getWritePointer (ch);
+        auto* data = buffer.getWritePointer (ch);
         auto& hp = hpfFilters[(size_t) ch];
         auto& lp = lpfFilters[(size_t) ch];
-        for (int i = 0; i < wetBuffer.getNumSamples(); ++i)
+        for (int i = 0; i < buffer.getNumSamples(); ++i)
             data[i] = lp.processSample (hp.processSample (data[i]));
     }
 
-    for (int i = 0; i < buffer.getNumSamples(); ++i)
-    {
-        const float wetL = wetBuffer.getSample (0, i);
-        const float wetR = wetBuffer.getNumChannels() > 1 ? wetBuffer.getSample (1, i) : wetL;
-        const float dryL = dryBuffer.getSample (0, i);
-        const float dryR = dryBuffer.getNumChannels() > 1 ? dryBuffer.getSample (1, i) : dryL;
-
-        buffer.setSample (0, i, wetL * mix + dryL * (1.0f - mix));
-        if (buffer.getNumChannels() > 1)
-            buffer.setSample (1, i, wetR * mix + dryR * (1.0f - mix));
-    }
+    dryWet.end (buffer, buffer.getNumSamples(), mixAmount);
 }
 
 void PITDoubleStrikeAudioProcessor::ensureState (int numChannels, int numSamples)
 {
-    if (dryBuffer.getNumChannels() != numChannels || dryBuffer.getNumSamples() != numSamples)
-        dryBuffer.setSize (numChannels, numSamples, false, false, true);
-    if (wetBuffer.getNumChannels() != numChannels || wetBuffer.getNumSamples() != numSamples)
-        wetBuffer.setSize (numChannels, numSamples, false, false, true);
     if (voiceABuffer.getNumChannels() != numChannels || voiceABuffer.getNumSamples() != numSamples)
         voiceABuffer.setSize (numChannels, numSamples, false, false, true);
     if (voiceBBuffer.getNumChannels() != numChannels || voiceBBuffer.getNumSamples() != numSamples)
@@ -146,17 +153,23 @@ void PITDoubleStrikeAudioProcessor::ensureState (int numChannels, int numSamples
 
 void PITDoubleStrikeAudioProcessor::updateFilters (float hpf, float lpf)
 {
-    auto hpCoeffs = juce::dsp::IIR::Coefficients<float>::makeHighPass (currentSampleRate,
-                                                                        juce::jlimit (20.0f, 2000.0f, hpf),
-                                                                        0.707f);
-    auto lpCoeffs = juce::dsp::IIR::Coefficients<float>::makeLowPass (currentSampleRate,
-                                                                      juce::jlimit (1000.0f, 20000.0f, lpf),
-                                                                      0.707f);
+    const auto hpFreq = juce::jlimit (20.0f, 2000.0f, hpf);
+    const auto lpFreq = juce::jlimit (1000.0f, 20000.0f, lpf);
 
     for (auto& f : hpfFilters)
-        f.coefficients = hpCoeffs;
+        f.setHighPass (currentSampleRate, hpFreq, 0.707f);
     for (auto& f : lpfFilters)
-        f.coefficients = lpCoeffs;
+        f.setLowPass (currentSampleRate, lpFreq, 0.707f);
+}
+
+void PITDoubleStrikeAudioProcessor::updatePitchEngines()
+{
+    // Both voices follow the one engine parameter, so they share a latency stage.
+    voiceAShifter.update();
+    voiceBShifter.update();
+    latency.setStage (0, voiceAShifter.getLatencySamples(), voiceAShifter.getLatencySamples());
+    latency.update();
+    dryWet.setLatency (voiceAShifter.getLatencySamples());
 }
 
 std::pair<float, float> PITDoubleStrikeAudioProcessor::panToGains (float pan) const
@@ -188,28 +201,16 @@ juce::AudioProcessorValueTreeState::ParameterLayout
 PITDoubleStrikeAudioProcessor::createParameterLayout()
 {
     std::vector<std::unique_ptr<juce::RangedAudioParameter>> params;
-
-    params.push_back (std::make_unique<juce::AudioParameterFloat> (
-        paramVoiceA, "Voice A Pitch", juce::NormalisableRange<float> (-12.0f, 12.0f, 0.01f), 7.0f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> (
-        paramVoiceB, "Voice B Pitch", juce::NormalisableRange<float> (-12.0f, 12.0f, 0.01f), -5.0f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> (
-        paramDetune, "Detune", juce::NormalisableRange<float> (-20.0f, 20.0f, 0.01f), 0.0f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> (
-        paramSpread, "Spread", juce::NormalisableRange<float> (0.0f, 1.0f, 0.0001f), 0.5f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> (
-        paramHPF, "HPF", juce::NormalisableRange<float> (20.0f, 2000.0f, 0.01f, 0.45f), 120.0f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> (
-        paramLPF, "LPF", juce::NormalisableRange<float> (1000.0f, 20000.0f, 0.01f, 0.45f), 14000.0f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> (
-        paramMix, "Mix", juce::NormalisableRange<float> (0.0f, 1.0f, 0.0001f), 0.7f));
+    gls::addParameters (params, parameterTable);
+    pit::PitchEngine::addParameters (params);
 
     return { params.begin(), params.end() };
 }
 
 //==============================================================================
 PITDoubleStrikeAudioProcessorEditor::PITDoubleStrikeAudioProcessorEditor (PITDoubleStrikeAudioProcessor& p)
-    : juce::AudioProcessorEditor (&p), processorRef (p)
+    : juce::AudioProcessorEditor (&p), processorRef (p),
+      engineSelector (p.getValueTreeState())
 {
     initSlider (voiceASlider, "Voice A");
     initSlider (voiceBSlider, "Voice B");
@@ -227,8 +228,9 @@ PITDoubleStrikeAudioProcessorEditor::PITDoubleStrikeAudioProcessorEditor (PITDou
     attachments.push_back (std::make_unique<SliderAttachment> (state, paramHPF, hpfSlider));
     attachments.push_back (std::make_unique<SliderAttachment> (state, paramLPF, lpfSlider));
     attachments.push_back (std::make_unique<SliderAttachment> (state, paramMix, mixSlider));
+    addAndMakeVisible (engineSelector);
 
-    setSize (720, 280);
+    setSize (720, 310);
 }
 
 void PITDoubleStrikeAudioProcessorEditor::paint (juce::Graphics& g)
@@ -244,6 +246,7 @@ void PITDoubleStrikeAudioProcessorEditor::resized()
 {
     auto area = getLocalBounds().reduced (12);
     area.removeFromTop (30);
+    engineSelector.setBounds (area.removeFromBottom (28).removeFromRight (260));
 
     auto row1 = area.removeFromTop (120);
     auto row2 = area;
@@ -1,18 +1,30 @@
 ﻿#pragma once
 
 #include <JuceHeader.h>
+#include <array>
 #include "../../DualPrecisionAudioProcessor.h"
-#include "../common/SimplePitchShifter.h"
+#include "../../ParameterTable.h"
+#include "../../SmoothedParameter.h"
+#include "../../dsp/Biquad.h"
+#include "../../dsp/DryWetStage.h"
+#include "../../dsp/LatencyReporter.h"
+#include "../common/PitchEngine.h"
+#include "../common/PitchEngineSelector.h"
 
 class PITDoubleStrikeAudioProcessor : public DualPrecisionAudioProcessor
 {
 public:
+    enum class Param
+    {
+        voiceAPitch, voiceBPitch, detune, spread, hpf, lpf, mix,
+        count
+    };
+
     PITDoubleStrikeAudioProcessor();
     ~PITDoubleStrikeAudioProcessor() override = default;
 
     void prepareToPlay (double sampleRate, int samplesPerBlock) override;
     void releaseResources() override {}
-    void processBlock (juce::AudioBuffer<float>&, juce::MidiBuffer&) override;
 
     juce::AudioProcessorEditor* createEditor() override;
     bool hasEditor() const override { return true; }
@@ -21,7 +33,6 @@ public:
     bool acceptsMidi() const override { return false; }
     bool producesMidi() const override { return false; }
     bool isMidiEffect() const override { return false; }
-    double getTailLengthSeconds() const override { return 0.0; }
 
     int getNumPrograms() override { return 1; }
     int getCurrentProgram() override { return 0; }
@@ -38,21 +49,27 @@ public:
     juce::AudioProcessorValueTreeState& getValueTreeState() { return apvts; }
     static juce::AudioProcessorValueTreeState::ParameterLayout createParameterLayout();
 
+protected:
+    void processFloat (juce::AudioBuffer<float>&, juce::MidiBuffer&) override;
+
 private:
     juce::AudioProcessorValueTreeState apvts;
+    gls::ParameterHandles<Param> params;
+    gls::SmoothedParameter mixAmount { params, Param::mix };
     double currentSampleRate = 44100.0;
 
-    juce::AudioBuffer<float> dryBuffer;
-    juce::AudioBuffer<float> wetBuffer;
     juce::AudioBuffer<float> voiceABuffer;
     juce::AudioBuffer<float> voiceBBuffer;
-    pit::SimplePitchShifter voiceAShifter;
-    pit::SimplePitchShifter voiceBShifter;
-    std::vector<juce::dsp::IIR::Filter<float>> hpfFilters;
-    std::vector<juce::dsp::IIR::Filter<float>> lpfFilters;
+    pit::PitchEngine voiceAShifter;
+    pit::PitchEngine voiceBShifter;
+    gls::dsp::LatencyReporter latency { *this };
+    gls::dsp::DryWetStage dryWet;
+    std::vector<gls::dsp::Biquad> hpfFilters;
+    std::vector<gls::dsp::Biquad> lpfFilters;
 
     void ensureState (int numChannels, int numSamples);
     void updateFilters (float hpf, float lpf);
+    void updatePitchEngines();
     std::pair<float, float> panToGains (float pan) const;
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (PITDoubleStrikeAudioProcessor)
@@ -77,6 +94,7 @@ private:
     juce::Slider hpfSlider;
     juce::Slider lpfSlider;
     juce::Slider mixSlider;
+    pit::PitchEngineSelector engineSelector;
 
     using SliderAttachment = juce::AudioProcessorValueTreeState::SliderAttachment;
     std::vector<std::unique_ptr<SliderAttachment>> attachments;
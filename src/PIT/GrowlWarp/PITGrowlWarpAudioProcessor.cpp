@@ -7,31 +7,49 @@ constexpr auto kParamGrowl         = "growl";
 constexpr auto kParamFormant       = "formant";
 constexpr auto kParamDrive         = "drive";
 constexpr auto kParamMix           = "mix";
+
+using Param = PITGrowlWarpAudioProcessor::Param;
+using Spec = gls::ParameterSpec;
+
+constexpr std::array<Spec, (size_t) Param::count> parameterTable {{
+    Spec::range (kParamSemitonesDown, "Semitones Down", -24.0f, 0.0f,  0.01f,  -7.0f),
+    Spec::range (kParamGrowl,         "Growl",          0.0f,   1.0f,  0.001f, 0.5f),
+    Spec::range (kParamFormant,       "Formant",        -12.0f, 12.0f, 0.01f,  0.0f),
+    Spec::range (kParamDrive,         "Drive",          0.0f,   1.0f,  0.001f, 0.4f),
+    Spec::range (kParamMix,           "Mix",            0.0f,   1.0f,  0.001f, 0.5f)
+}};
+
+static_assert (gls::hasUniqueIds (parameterTable));
 } // namespace
 
 PITGrowlWarpAudioProcessor::PITGrowlWarpAudioProcessor()
     : DualPrecisionAudioProcessor (BusesProperties().withInput  ("Input",  juce::AudioChannelSet::stereo(), true)
                                                    .withOutput ("Output", juce::AudioChannelSet::stereo(), true)),
-      apvts (*this, nullptr, "Parameters", createParameterLayout())
+      apvts (*this, nullptr, "Parameters", createParameterLayout()),
+      params (apvts, parameterTable)
 {
+    pitchEngine.attach (apvts);
 }
 
 void PITGrowlWarpAudioProcessor::prepareToPlay (double sampleRate, int samplesPerBlock)
 {
+    DualPrecisionAudioProcessor::prepareToPlay (sampleRate, samplesPerBlock);
+
     currentSampleRate = sampleRate > 0.0 ? sampleRate : 44100.0;
     const auto totalChannels = juce::jmax (2, getTotalNumInputChannels());
     const auto blockSize = juce::jmax (1, samplesPerBlock);
 
-    dryBuffer.setSize (totalChannels, blockSize);
-    wetBuffer.setSize (totalChannels, blockSize);
-    pitchShifter.prepare (currentSampleRate, totalChannels);
-    pitchShifter.reset();
+    mixAmount.prepare (currentSampleRate, blockSize);
+    pitchEngine.prepare (currentSampleRate, totalChannels);
+    dryWet.prepare (currentSampleRate, totalChannels, blockSize, pitchEngine.getMaximumLatencySamples());
+    latency.invalidate();
+    updatePitchEngine();
     formantFilters.clear();
+    formantFilters.resize ((size_t) totalChannels);
 }
 
 void PITGrowlWarpAudioProcessor::releaseResources()
 {
-    dryBuffer.setSize (0, 0);
 }
 
 bool PITGrowlWarpAudioProcessor::isBusesLayoutSupported (const BusesLayout& layouts) const
@@ -46,8 +64,11 @@ bool PITGrowlWarpAudioProcessor::isBusesLayoutSupported (const BusesLayout& layo
     return true;
 }
 
-void PITGrowlWarpAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer, juce::MidiBuffer&)
+void PITGrowlWarpAudioProcessor::processFloat (juce::AudioBuffer<float>& buffer, juce::MidiBuffer& midi)
 {
+    if (renderInPreparedChunks (buffer, midi))
+        return;
+
     juce::ScopedNoDenormals noDenormals;
 
     const auto numInputChannels  = getTotalNumInputChannels();
@@ -57,21 +78,23 @@ void PITGrowlWarpAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer,
     for (auto ch = numInputChannels; ch < numOutputChannels; ++ch)
         buffer.clear (ch, 0, numSamples);
 
-    const auto channelCount = juce::jmax (1, buffer.getNumChannels());
-    const auto samples = juce::jmax (1, numSamples);
-    dryBuffer.setSize (channelCount, samples, false, false, true);
-    wetBuffer.setSize (channelCount, samples, false, false, true);
-    dryBuffer.makeCopyOf (buffer, true);
-    wetBuffer.makeCopyOf (buffer, true);
+    updatePitchEngine();
+
+    const auto semitonesDown = params[Param::semitonesDown];
+    const auto growl         = params[Param::growl];
+    const auto formant       = params[Param::formant];
+    const auto drive         = params[Param::drive];
 
-    const auto semitonesDown = apvts.getRawParameterValue (kParamSemitonesDown)->load();
-    const auto growl         = apvts.getRawParameterValue (kParamGrowl)->load();
-    const auto formant       = apvts.getRawParameterValue (kParamFormant)->load();
-    const auto drive         = apvts.getRawParameterValue (kParamDrive)->load();
-    const auto mix           = apvts.getRawParameterValue (kParamMix)->load();
+    // The shifter runs in place; the stage keeps a latency-aligned dry copy only
+    // while it is heard.
+    dryWet.begin (buffer, numSamples, mixAmount);
 
+    // With formants preserved the knob shifts the envelope in semitones and the
+    // band-pass stands aside.
     const float ratio = std::pow (2.0f, semitonesDown / 12.0f);
-    pitchShifter.process (wetBuffer, ratio);
+    const auto preserveFormants = pitchEngine.isPreservingFormants();
+    pitchEngine.setFormantShift (std::pow (2.0f, formant / 12.0f));
+    pitchEngine.process (buffer, ratio);
 
     auto ensureFilters = [this, channels = buffer.getNumChannels()]()
     {
@@ -85,18 +108,17 @@ void PITGrowlWarpAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer,
     ensureFilters();
 
     const float formantFreq = juce::jmap (formant, -12.0f, 12.0f, 200.0f, 3200.0f);
-    auto formantCoeffs = juce::dsp::IIR::Coefficients<float>::makeBandPass (currentSampleRate, formantFreq, 1.2f);
     for (auto& filter : formantFilters)
-        filter.coefficients = formantCoeffs;
+        filter.setBandPass (currentSampleRate, formantFreq, 1.2f);
 
-    for (int ch = 0; ch < wetBuffer.getNumChannels(); ++ch)
+    for (int ch = 0; ch < buffer.getNumChannels(); ++ch)
     {
-        auto* data = wetBuffer.getWritePointer (ch);
+        auto* data = buffer.getWritePointer (ch);
         auto& formantFilter = formantFilters[(size_t) ch];
 
         for (int i = 0; i < numSamples; ++i)
         {
-            float sample = formantFilter.processSample (data[i]);
+            float sample = preserveFormants ? data[i] : formantFilter.processSample (data[i]);
             const float growlShape = juce::dsp::FastMathApproximations::tanh (sample * juce::jmap (growl, 0.0f, 1.0f, 1.0f, 4.0f));
             sample = juce::jmap (growl, 0.0f, 1.0f, sample, growlShape);
             const float driveGain = juce::jmap (drive, 0.0f, 1.0f, 1.0f, 6.0f);
@@ -105,14 +127,15 @@ void PITGrowlWarpAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer,
         }
     }
 
-    for (int ch = 0; ch < buffer.getNumChannels(); ++ch)
-    {
-        auto* dry = dryBuffer.getReadPointer (ch);
-        auto* wet = wetBuffer.getReadPointer (ch);
-        auto* out = buffer.getWritePointer (ch);
-        for (int i = 0; i < numSamples; ++i)
-            out[i] = wet[i] * mix + dry[i] * (1.0f - mix);
-    }
+    dryWet.end (buffer, numSamples, mixAmount);
+}
+
+void PITGrowlWarpAudioProcessor::updatePitchEngine()
+{
+    pitchEngine.update();
+    latency.setStage (0, pitchEngine.getLatencySamples(), pitchEngine.getLatencySamples());
+    latency.update();
+    dryWet.setLatency (pitchEngine.getLatencySamples());
 }
 
 juce::AudioProcessorEditor* PITGrowlWarpAudioProcessor::createEditor()
@@ -136,26 +159,20 @@ void PITGrowlWarpAudioProcessor::setStateInformation (const void* data, int size
 juce::AudioProcessorValueTreeState::ParameterLayout PITGrowlWarpAudioProcessor::createParameterLayout()
 {
     std::vector<std::unique_ptr<juce::RangedAudioParameter>> params;
-
-    params.emplace_back (std::make_unique<juce::AudioParameterFloat> (kParamSemitonesDown, "Semitones Down",
-                                                                      juce::NormalisableRange<float> (-24.0f, 0.0f, 0.01f), -7.0f));
-    params.emplace_back (std::make_unique<juce::AudioParameterFloat> (kParamGrowl, "Growl",
-                                                                      juce::NormalisableRange<float> (0.0f, 1.0f, 0.001f), 0.5f));
-    params.emplace_back (std::make_unique<juce::AudioParameterFloat> (kParamFormant, "Formant",
-                                                                      juce::NormalisableRange<float> (-12.0f, 12.0f, 0.01f), 0.0f));
-    params.emplace_back (std::make_unique<juce::AudioParameterFloat> (kParamDrive, "Drive",
-                                                                      juce::NormalisableRange<float> (0.0f, 1.0f, 0.001f), 0.4f));
-    params.emplace_back (std::make_unique<juce::AudioParameterFloat> (kParamMix, "Mix",
-                                                                      juce::NormalisableRange<float> (0.0f, 1.0f, 0.001f), 0.5f));
+    gls::addParameters (params, parameterTable);
+    pit::PitchEngine::addParameters (params);
+    pit::PitchEngine::addFormantParameter (params, false);
 
     return { params.begin(), params.end() };
 }
 
 //==============================================================================
 PITGrowlWarpAudioProcessorEditor::PITGrowlWarpAudioProcessorEditor (PITGrowlWarpAudioProcessor& processor)
-    : juce::AudioProcessorEditor (&processor), processorRef (processor)
+    : juce::AudioProcessorEditor (&processor), processorRef (processor),
+      engineSelector (processor.getValueTreeState())
 {
-    setSize (480, 300);
+    addAndMakeVisible (engineSelector);
+    setSize (480, 330);
 
     initSlider (semitonesDownSlider, "Semitones");
     initSlider (growlSlider,         "Growl");
@@ -182,6 +199,7 @@ void PITGrowlWarpAudioProcessorEditor::paint (juce::Graphics& g)
 void PITGrowlWarpAudioProcessorEditor::resized()
 {
     auto area = getLocalBounds().reduced (20);
+    engineSelector.setBounds (area.removeFromBottom (28));
     auto upper = area.removeFromTop (area.getHeight() / 2);
 
     semitonesDownSlider.setBounds (upper.removeFromLeft (area.getWidth() / 3));
@@ -1,19 +1,31 @@
 #pragma once
 
 #include <JuceHeader.h>
+#include <array>
 #include "../../DualPrecisionAudioProcessor.h"
-#include "../common/SimplePitchShifter.h"
+#include "../../ParameterTable.h"
+#include "../../SmoothedParameter.h"
+#include "../../dsp/Biquad.h"
+#include "../../dsp/DryWetStage.h"
+#include "../../dsp/LatencyReporter.h"
+#include "../common/PitchEngine.h"
+#include "../common/PitchEngineSelector.h"
 
 class PITGrowlWarpAudioProcessor : public DualPrecisionAudioProcessor
 {
 public:
+    enum class Param
+    {
+        semitonesDown, growl, formant, drive, mix,
+        count
+    };
+
     PITGrowlWarpAudioProcessor();
     ~PITGrowlWarpAudioProcessor() override = default;
 
     void prepareToPlay (double sampleRate, int samplesPerBlock) override;
     void releaseResources() override;
     bool isBusesLayoutSupported (const BusesLayout& layouts) const override;
-    void processBlock (juce::AudioBuffer<float>&, juce::MidiBuffer&) override;
 
     juce::AudioProcessorEditor* createEditor() override;
     bool hasEditor() const override { return true; }
@@ -22,7 +34,6 @@ public:
     bool acceptsMidi() const override { return false; }
     bool producesMidi() const override { return false; }
     bool isMidiEffect() const override { return false; }
-    double getTailLengthSeconds() const override { return 0.0; }
 
     int getNumPrograms() override { return 1; }
     int getCurrentProgram() override { return 0; }
@@ -39,15 +50,22 @@ public:
     juce::AudioProcessorValueTreeState& getValueTreeState() { return apvts; }
     static juce::AudioProcessorValueTreeState::ParameterLayout createParameterLayout();
 
+protected:
+    void processFloat (juce::AudioBuffer<float>&, juce::MidiBuffer&) override;
+
 private:
     juce::AudioProcessorValueTreeState apvts;
+    gls::ParameterHandles<Param> params;
+    gls::SmoothedParameter mixAmount { params, Param::mix };
 
-    juce::AudioBuffer<float> dryBuffer;
-    juce::AudioBuffer<float> wetBuffer;
-    pit::SimplePitchShifter pitchShifter;
-    std::vector<juce::dsp::IIR::Filter<float>> formantFilters;
+    gls::dsp::DryWetStage dryWet;
+    pit::PitchEngine pitchEngine;
+    gls::dsp::LatencyReporter latency { *this };
+    std::vector<gls::dsp::Biquad> formantFilters;
     double currentSampleRate = 44100.0;
 
+    void updatePitchEngine();
+
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (PITGrowlWarpAudioProcessor)
 };
 
@@ -69,6 +87,7 @@ private:
     juce::Slider formantSlider;
     juce::Slider driveSlider;
     juce::Slider mixSlider;
+    pit::PitchEngineSelector engineSelector;
 
     using SliderAttachment = juce::AudioProcessorValueTreeState::SliderAttachment;
     std::vector<std::unique_ptr<SliderAttachment>> attachments;
@@ -9,24 +9,42 @@ constexpr auto kDelayRId  = "delay_r";
 constexpr auto kWidthId   = "width";
 constexpr auto kHpfId     = "hpf";
 constexpr auto kMixId     = "mix";
+
+using Param = PITMicroShiftAudioProcessor::Param;
+using Spec = gls::ParameterSpec;
+
+constexpr std::array<Spec, (size_t) Param::count> parameterTable {{
+    Spec::range (kDetuneLId, "Detune L",     -20.0f, 20.0f,   0.01f,  -6.0f),
+    Spec::range (kDetuneRId, "Detune R",     -20.0f, 20.0f,   0.01f,  6.0f),
+    Spec::range (kDelayLId,  "Delay L (ms)", 0.0f,   30.0f,   0.01f,  8.0f),
+    Spec::range (kDelayRId,  "Delay R (ms)", 0.0f,   30.0f,   0.01f,  12.0f),
+    Spec::range (kWidthId,   "Width",        0.0f,   1.0f,    0.001f, 1.0f),
+    Spec::range (kHpfId,     "HPF",          20.0f,  1000.0f, 0.01f,  120.0f, 0.35f),
+    Spec::range (kMixId,     "Mix",          0.0f,   1.0f,    0.001f, 0.5f)
+}};
+
+static_assert (gls::hasUniqueIds (parameterTable));
 } // namespace
 
 PITMicroShiftAudioProcessor::PITMicroShiftAudioProcessor()
     : DualPrecisionAudioProcessor (BusesProperties()
                         .withInput  ("Input",  juce::AudioChannelSet::stereo(), true)
                         .withOutput ("Output", juce::AudioChannelSet::stereo(), true)),
-      apvts (*this, nullptr, "PIT_MICRO_SHIFT", createParameterLayout())
+      apvts (*this, nullptr, "PIT_MICRO_SHIFT", createParameterLayout()),
+      params (apvts, parameterTable)
 {
 }
 
 void PITMicroShiftAudioProcessor::prepareToPlay (double sampleRate, int samplesPerBlock)
 {
+    DualPrecisionAudioProcessor::prepareToPlay (sampleRate, samplesPerBlock);
+
     currentSampleRate = sampleRate > 0.0 ? sampleRate : 44100.0;
     const auto totalChannels = juce::jmax (2, getTotalNumOutputChannels());
     const auto blockSize = juce::jmax (1, samplesPerBlock);
 
-    dryBuffer.setSize (totalChannels, blockSize);
-    wetBuffer.setSize (totalChannels, blockSize);
+    mixAmount.prepare (currentSampleRate, blockSize);
+    dryWet.prepare (currentSampleRate, totalChannels, blockSize);
 
     juce::dsp::ProcessSpec chorusSpec { currentSampleRate, static_cast<juce::uint32> (blockSize), 1 };
     for (auto& chorus : chorusProcessors)
@@ -47,8 +65,6 @@ void PITMicroShiftAudioProcessor::prepareToPlay (double sampleRate, int samplesP
 
 void PITMicroShiftAudioProcessor::releaseResources()
 {
-    dryBuffer.setSize (0, 0);
-    wetBuffer.setSize (0, 0);
 }
 
 bool PITMicroShiftAudioProcessor::isBusesLayoutSupported (const BusesLayout& layouts) const
@@ -65,8 +81,11 @@ bool PITMicroShiftAudioProcessor::isBusesLayoutSupported (const BusesLayout& lay
     return true;
 }
 
-void PITMicroShiftAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer, juce::MidiBuffer&)
+void PITMicroShiftAudioProcessor::processFloat (juce::AudioBuffer<float>& buffer, juce::MidiBuffer& midi)
 {
+    if (renderInPreparedChunks (buffer, midi))
+        return;
+
     juce::ScopedNoDenormals noDenormals;
 
     const auto numInputChannels  = getTotalNumInputChannels();
@@ -76,20 +95,12 @@ void PITMicroShiftAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer
     for (auto ch = numInputChannels; ch < numOutputChannels; ++ch)
         buffer.clear (ch, 0, numSamples);
 
-    const auto channelCount = juce::jmax (1, buffer.getNumChannels());
-    const auto samples = juce::jmax (1, numSamples);
-    dryBuffer.setSize (channelCount, samples, false, false, true);
-    wetBuffer.setSize (channelCount, samples, false, false, true);
-    dryBuffer.makeCopyOf (buffer, true);
-    wetBuffer.makeCopyOf (buffer, true);
-
-    const auto detuneL = apvts.getRawParameterValue (kDetuneLId)->load();
-    const auto detuneR = apvts.getRawParameterValue (kDetuneRId)->load();
-    const auto delayL  = apvts.getRawParameterValue (kDelayLId)->load();
-    const auto delayR  = apvts.getRawParameterValue (kDelayRId)->load();
-    const auto width   = apvts.getRawParameterValue (kWidthId)->load();
-    const auto hpf     = apvts.getRawParameterValue (kHpfId)->load();
-    const auto mix     = juce::jlimit (0.0f, 1.0f, apvts.getRawParameterValue (kMixId)->load());
+    const auto detuneL = params[Param::detuneL];
+    const auto detuneR = params[Param::detuneR];
+    const auto delayL  = params[Param::delayL];
+    const auto delayR  = params[Param::delayR];
+    const auto width   = params[Param::width];
+    const auto hpf     = params[Param::hpf];
 
     const auto configureChorus = [] (juce::dsp::Chorus<float>& chorus, float detune, float delayMs)
     {
@@ -101,15 +112,18 @@ void PITMicroShiftAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer
         chorus.setCentreDelay (juce::jlimit (1.0f, 40.0f, delayMs));
     };
 
-    juce::dsp::AudioBlock<float> wetBlock (wetBuffer);
-    if (wetBuffer.getNumChannels() > 0)
+    // The wet path runs in place; the stage keeps the dry copy only while it is heard.
+    dryWet.begin (buffer, numSamples, mixAmount);
+
+    juce::dsp::AudioBlock<float> wetBlock (buffer);
+    if (buffer.getNumChannels() > 0)
     {
         configureChorus (chorusProcessors[0], detuneL, delayL);
         auto leftBlock = wetBlock.getSingleChannelBlock (0);
         chorusProcessors[0].process (juce::dsp::ProcessContextReplacing<float> (leftBlock));
     }
 
-    if (wetBuffer.getNumChannels() > 1)
+    if (buffer.getNumChannels() > 1)
     {
         configureChorus (chorusProcessors[1], detuneR, delayR);
         auto rightBlock = wetBlock.getSingleChannelBlock (1);
@@ -120,14 +134,16 @@ void PITMicroShiftAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer
     juce::dsp::ProcessContextReplacing<float> filterCtx (wetBlock);
     hpfProcessor.process (filterCtx);
 
-    processStereoWidth (width, numSamples);
+    processStereoWidth (buffer, width, numSamples);
 
-    for (int ch = 0; ch < buffer.getNumChannels(); ++ch)
-    {
-        buffer.copyFrom (ch, 0, dryBuffer, ch, 0, numSamples);
-        buffer.applyGain (ch, 0, numSamples, 1.0f - mix);
-        buffer.addFrom (ch, 0, wetBuffer, ch, 0, numSamples, mix);
-    }
+    dryWet.end (buffer, numSamples, mixAmount);
+}
+
+void PITMicroShiftAudioProcessor::updateTail()
+{
+    // The chorus modulates up to 20 ms around the longer centre delay.
+    const auto centreMs = juce::jlimit (1.0f, 40.0f, juce::jmax (params[Param::delayL], params[Param::delayR]));
+    tail.setTail ((centreMs + 20.0) * 0.001);
 }
 
 juce::AudioProcessorEditor* PITMicroShiftAudioProcessor::createEditor()
@@ -150,24 +166,7 @@ void PITMicroShiftAudioProcessor::setStateInformation (const void* data, int siz
 
 juce::AudioProcessorValueTreeState::ParameterLayout PITMicroShiftAudioProcessor::createParameterLayout()
 {
-    std::vector<std::unique_ptr<juce::RangedAudioParameter>> params;
-
-    params.push_back (std::make_unique<juce::AudioParameterFloat> (kDetuneLId, "Detune L",
-                                                                   juce::NormalisableRange<float> (-20.0f, 20.0f, 0.01f), -6.0f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> (kDetuneRId, "Detune R",
-                                                                   juce::NormalisableRange<float> (-20.0f, 20.0f, 0.01f), 6.0f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> (kDelayLId, "Delay L (ms)",
-                                                                   juce::NormalisableRange<float> (0.0f, 30.0f, 0.01f), 8.0f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> (kDelayRId, "Delay R (ms)",
-                                                                   juce::NormalisableRange<float> (0.0f, 30.0f, 0.01f), 12.0f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> (kWidthId, "Width",
-                                                                   juce::NormalisableRange<float> (0.0f, 1.0f, 0.001f), 1.0f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> (kHpfId, "HPF",
-                                                                   juce::NormalisableRange<float> (20.0f, 1000.0f, 0.01f, 0.35f), 120.0f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> (kMixId, "Mix",
-                                                                   juce::NormalisableRange<float> (0.0f, 1.0f, 0.001f), 0.5f));
-
-    return { params.begin(), params.end() };
+    return gls::createParameterLayout (parameterTable);
 }
 
 //==============================================================================
@@ -240,22 +239,18 @@ void PITMicroShiftAudioProcessor::updateHighPass (float cutoffHz)
     if (currentSampleRate <= 0.0)
         return;
 
-    if (hpfProcessor.state != nullptr
-        && std::abs (limitedCutoff - lastHpfCutoff) < 1.0f)
-        return;
-
-    *hpfProcessor.state = *juce::dsp::IIR::Coefficients<float>::makeHighPass (currentSampleRate, limitedCutoff);
+    hpfProcessor.setDesign (gls::dsp::BiquadType::highPass, currentSampleRate, limitedCutoff);
     lastHpfCutoff = limitedCutoff;
 }
 
-void PITMicroShiftAudioProcessor::processStereoWidth (float widthValue, int numSamples)
+void PITMicroShiftAudioProcessor::processStereoWidth (juce::AudioBuffer<float>& buffer, float widthValue, int numSamples)
 {
-    if (wetBuffer.getNumChannels() < 2)
+    if (buffer.getNumChannels() < 2)
         return;
 
     const auto width = juce::jlimit (0.0f, 1.0f, widthValue);
-    auto* left  = wetBuffer.getWritePointer (0);
-    auto* right = wetBuffer.getWritePointer (1);
+    auto* left  = buffer.getWritePointer (0);
+    auto* right = buffer.getWritePointer (1);
 
     for (int i = 0; i < numSamples; ++i)
     {
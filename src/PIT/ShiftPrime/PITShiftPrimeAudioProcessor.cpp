@@ -9,39 +9,63 @@ constexpr auto paramHPF       = "hpf";
 constexpr auto paramLPF       = "lpf";
 constexpr auto paramMode      = "mode";
 constexpr auto paramMix       = "mix";
+
+using Param = PITShiftPrimeAudioProcessor::Param;
+using Spec = gls::ParameterSpec;
+
+constexpr std::array<Spec, (size_t) Param::count> parameterTable {{
+    Spec::range  (paramSemitones, "Semitones", -12.0f,  12.0f,    0.01f,   0.0f),
+    Spec::range  (paramCents,     "Cents",     -100.0f, 100.0f,   0.01f,   0.0f),
+    Spec::range  (paramFormant,   "Formant",   0.0f,    1.0f,     0.0001f, 0.5f),
+    Spec::range  (paramHPF,       "HPF",       20.0f,   2000.0f,  0.01f,   80.0f,    0.45f),
+    Spec::range  (paramLPF,       "LPF",       1000.0f, 18000.0f, 0.01f,   14000.0f, 0.45f),
+    Spec::choice (paramMode,      "Mode",      "Clean|Dirty", 0),
+    Spec::range  (paramMix,       "Mix",       0.0f,    1.0f,     0.0001f, 0.5f)
+}};
+
+static_assert (gls::hasUniqueIds (parameterTable));
 }
 
 PITShiftPrimeAudioProcessor::PITShiftPrimeAudioProcessor()
     : DualPrecisionAudioProcessor (BusesProperties()
                         .withInput  ("Input",  juce::AudioChannelSet::stereo(), true)
                         .withOutput ("Output", juce::AudioChannelSet::stereo(), true)),
-      apvts (*this, nullptr, "PIT_SHIFT_PRIME", createParameterLayout())
+      apvts (*this, nullptr, "PIT_SHIFT_PRIME", createParameterLayout()),
+      params (apvts, parameterTable)
 {
+    pitchEngine.attach (apvts);
 }
 
 void PITShiftPrimeAudioProcessor::prepareToPlay (double sampleRate, int samplesPerBlock)
 {
+    DualPrecisionAudioProcessor::prepareToPlay (sampleRate, samplesPerBlock);
+
     currentSampleRate = sampleRate > 0.0 ? sampleRate : 44100.0;
-    const auto totalChannels = juce::jmax (2, getTotalNumOutputChannels());
+    const auto totalChannels = juce::jmax (2, getTotalNumInputChannels(), getTotalNumOutputChannels());
     const auto blockSize = juce::jmax (1, samplesPerBlock);
 
     hpfFilters.clear();
     lpfFilters.clear();
     formantFilters.clear();
-    dryBuffer.setSize (totalChannels, blockSize);
-    wetBuffer.setSize (totalChannels, blockSize);
+    ensureStateSize (totalChannels);
+    mixAmount.prepare (currentSampleRate, blockSize);
 
-    pitchShifter.prepare (currentSampleRate, totalChannels);
-    pitchShifter.reset();
+    pitchEngine.prepare (currentSampleRate, totalChannels);
+    dryWet.prepare (currentSampleRate, totalChannels, blockSize, pitchEngine.getMaximumLatencySamples());
+    latency.invalidate();
+    updatePitchEngine();
 }
 
 void PITShiftPrimeAudioProcessor::releaseResources()
 {
 }
 
-void PITShiftPrimeAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer,
-                                                juce::MidiBuffer&)
+void PITShiftPrimeAudioProcessor::processFloat (juce::AudioBuffer<float>& buffer,
+                                                juce::MidiBuffer& midi)
 {
+    if (renderInPreparedChunks (buffer, midi))
+        return;
+
     juce::ScopedNoDenormals noDenormals;
 
     const auto totalIn  = getTotalNumInputChannels();
@@ -49,38 +73,46 @@ void PITShiftPrimeAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer
     for (auto ch = totalIn; ch < totalOut; ++ch)
         buffer.clear (ch, 0, buffer.getNumSamples());
 
-    ensureStateSize (buffer.getNumChannels(), buffer.getNumSamples());
-    dryBuffer.makeCopyOf (buffer, true);
-    wetBuffer.makeCopyOf (buffer, true);
+    ensureStateSize (buffer.getNumChannels());
+    updatePitchEngine();
 
-    const auto semitones = apvts.getRawParameterValue (paramSemitones)->load();
-    const auto cents     = apvts.getRawParameterValue (paramCents)->load();
-    const auto formant   = apvts.getRawParameterValue (paramFormant)->load();
-    const auto hpfFreq   = apvts.getRawParameterValue (paramHPF)->load();
-    const auto lpfFreq   = apvts.getRawParameterValue (paramLPF)->load();
-    const auto mode      = (int) std::round (apvts.getRawParameterValue (paramMode)->load());
-    const auto mix       = juce::jlimit (0.0f, 1.0f, apvts.getRawParameterValue (paramMix)->load());
+    const auto semitones = params[Param::semitones];
+    const auto cents     = params[Param::cents];
+    const auto formant   = params[Param::formant];
+    const auto hpfFreq   = params[Param::hpf];
+    const auto lpfFreq   = params[Param::lpf];
+    const auto mode      = params.getIndex (Param::mode);
+    const auto numSamples = buffer.getNumSamples();
 
     updateFilters (hpfFreq, lpfFreq, formant);
 
     const float ratio = std::pow (2.0f, (semitones + cents / 100.0f) / 12.0f);
     const float drive = mode == 1 ? juce::jmap (std::abs (semitones), 0.0f, 12.0f, 1.0f, 2.5f) : 1.0f;
 
-    pitchShifter.process (wetBuffer, ratio);
+    // The shifter runs in place; the stage keeps a latency-aligned dry copy only
+    // while it is heard.
+    dryWet.begin (buffer, numSamples, mixAmount);
+
+    // With formants preserved the knob moves the envelope by up to an octave instead
+    // of driving the peak filter.
+    const auto preserveFormants = pitchEngine.isPreservingFormants();
+    pitchEngine.setFormantShift (std::pow (2.0f, (formant - 0.5f) * 2.0f));
+    pitchEngine.process (buffer, ratio);
 
-    for (int ch = 0; ch < wetBuffer.getNumChannels(); ++ch)
+    for (int ch = 0; ch < buffer.getNumChannels(); ++ch)
     {
-        auto* data = wetBuffer.getWritePointer (ch);
+        auto* data = buffer.getWritePointer (ch);
         auto& hpf  = hpfFilters[(size_t) ch];
         auto& lpf  = lpfFilters[(size_t) ch];
         auto& form = formantFilters[(size_t) ch];
 
-        for (int i = 0; i < wetBuffer.getNumSamples(); ++i)
+        for (int i = 0; i < numSamples; ++i)
         {
             float sample = data[i];
             sample = hpf.processSample (sample);
             sample = lpf.processSample (sample);
-            sample = form.processSample (sample);
+            if (! preserveFormants)
+                sample = form.processSample (sample);
 
             if (mode == 1)
                 sample = juce::dsp::FastMathApproximations::tanh (sample * drive);
@@ -89,24 +121,11 @@ void PITShiftPrimeAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer
         }
     }
 
-    for (int ch = 0; ch < buffer.getNumChannels(); ++ch)
-    {
-        auto* dry = dryBuffer.getReadPointer (ch);
-        auto* wet = wetBuffer.getReadPointer (ch);
-        auto* out = buffer.getWritePointer (ch);
-        for (int i = 0; i < buffer.getNumSamples(); ++i)
-            out[i] = wet[i] * mix + dry[i] * (1.0f - mix);
-    }
+    dryWet.end (buffer, numSamples, mixAmount);
 }
 
-void PITShiftPrimeAudioProcessor::ensureStateSize (int numChannels, int numSamples)
+void PITShiftPrimeAudioProcessor::ensureStateSize (int numChannels)
 {
-    if (dryBuffer.getNumChannels() != numChannels || dryBuffer.getNumSamples() != numSamples)
-        dryBuffer.setSize (numChannels, numSamples, false, false, true);
-
-    if (wetBuffer.getNumChannels() != numChannels || wetBuffer.getNumSamples() != numSamples)
-        wetBuffer.setSize (numChannels, numSamples, false, false, true);
-
     auto ensureFilter = [numChannels](auto& filters)
     {
         if ((int) filters.size() < numChannels)
@@ -124,23 +143,24 @@ void PITShiftPrimeAudioProcessor::ensureStateSize (int numChannels, int numSampl
 
 void PITShiftPrimeAudioProcessor::updateFilters (float hpf, float lpf, float formant)
 {
-    auto hpCoeffs = juce::dsp::IIR::Coefficients<float>::makeHighPass (currentSampleRate,
-                                                                        juce::jlimit (20.0f, 2000.0f, hpf),
-                                                                        0.707f);
-    auto lpCoeffs = juce::dsp::IIR::Coefficients<float>::makeLowPass (currentSampleRate,
-                                                                      juce::jlimit (500.0f, 20000.0f, lpf),
-                                                                      0.707f);
-    auto formantCoeffs = juce::dsp::IIR::Coefficients<float>::makePeakFilter (currentSampleRate,
-                                                                              juce::jmap (formant, 500.0f, 5000.0f),
-                                                                              1.0f,
-                                                                              1.5f);
+    const auto hpFreq = juce::jlimit (20.0f, 2000.0f, hpf);
+    const auto lpFreq = juce::jlimit (500.0f, 20000.0f, lpf);
+    const auto formantFreq = juce::jmap (formant, 500.0f, 5000.0f);
 
     for (auto& f : hpfFilters)
-        f.coefficients = hpCoeffs;
+        f.setHighPass (currentSampleRate, hpFreq, 0.707f);
     for (auto& f : lpfFilters)
-        f.coefficients = lpCoeffs;
+        f.setLowPass (currentSampleRate, lpFreq, 0.707f);
     for (auto& f : formantFilters)
-        f.coefficients = formantCoeffs;
+        f.setPeak (currentSampleRate, formantFreq, 1.0f, 1.5f);
+}
+
+void PITShiftPrimeAudioProcessor::updatePitchEngine()
+{
+    pitchEngine.update();
+    latency.setStage (0, pitchEngine.getLatencySamples(), pitchEngine.getLatencySamples());
+    latency.update();
+    dryWet.setLatency (pitchEngine.getLatencySamples());
 }
 
 void PITShiftPrimeAudioProcessor::getStateInformation (juce::MemoryBlock& destData)
@@ -160,33 +180,9 @@ juce::AudioProcessorValueTreeState::ParameterLayout
 PITShiftPrimeAudioProcessor::createParameterLayout()
 {
     std::vector<std::unique_ptr<juce::RangedAudioParameter>> params;
-
-    params.push_back (std::make_unique<juce::AudioParameterFloat> (
-        paramSemitones, "Semitones",
-        juce::NormalisableRange<float> (-12.0f, 12.0f, 0.01f), 0.0f));
-
-    params.push_back (std::make_unique<juce::AudioParameterFloat> (
-        paramCents, "Cents",
-        juce::NormalisableRange<float> (-100.0f, 100.0f, 0.01f), 0.0f));
-
-    params.push_back (std::make_unique<juce::AudioParameterFloat> (
-        paramFormant, "Formant",
-        juce::NormalisableRange<float> (0.0f, 1.0f, 0.0001f), 0.5f));
-
-    params.push_back (std::make_unique<juce::AudioParameterFloat> (
-        paramHPF, "HPF",
-        juce::NormalisableRange<float> (20.0f, 2000.0f, 0.01f, 0.45f), 80.0f));
-
-    params.push_back (std::make_unique<juce::AudioParameterFloat> (
-        paramLPF, "LPF",
-        juce::NormalisableRange<float> (1000.0f, 18000.0f, 0.01f, 0.45f), 14000.0f));
-
-    params.push_back (std::make_unique<juce::AudioParameterChoice> (
-        paramMode, "Mode", juce::StringArray { "Clean", "Dirty" }, 0));
-
-    params.push_back (std::make_unique<juce::AudioParameterFloat> (
-        paramMix, "Mix",
-        juce::NormalisableRange<float> (0.0f, 1.0f, 0.0001f), 0.5f));
+    gls::addParameters (params, parameterTable);
+    pit::PitchEngine::addParameters (params);
+    pit::PitchEngine::addFormantParameter (params, false);
 
     return { params.begin(), params.end() };
 }
@@ -198,7 +194,8 @@ juce::AudioProcessorEditor* PITShiftPrimeAudioProcessor::createEditor()
 
 //==============================================================================
 PITShiftPrimeAudioProcessorEditor::PITShiftPrimeAudioProcessorEditor (PITShiftPrimeAudioProcessor& p)
-    : juce::AudioProcessorEditor (&p), processorRef (p)
+    : juce::AudioProcessorEditor (&p), processorRef (p),
+      engineSelector (p.getValueTreeState())
 {
     initSlider (semitoneSlider, "Semitones");
     initSlider (centsSlider,    "Cents");
@@ -217,8 +214,9 @@ PITShiftPrimeAudioProcessorEditor::PITShiftPrimeAudioProcessorEditor (PITShiftPr
     sliderAttachments.push_back (std::make_unique<SliderAttachment> (processorRef.getValueTreeState(), paramLPF,       lpfSlider));
     sliderAttachments.push_back (std::make_unique<SliderAttachment> (processorRef.getValueTreeState(), paramMix,       mixSlider));
     modeAttachment = std::make_unique<ComboAttachment> (processorRef.getValueTreeState(), paramMode, modeBox);
+    addAndMakeVisible (engineSelector);
 
-    setSize (720, 320);
+    setSize (720, 350);
 }
 
 void PITShiftPrimeAudioProcessorEditor::paint (juce::Graphics& g)
@@ -235,6 +233,7 @@ void PITShiftPrimeAudioProcessorEditor::resized()
     auto area = getLocalBounds().reduced (12);
     area.removeFromTop (30);
     modeBox.setBounds (area.removeFromTop (30).reduced (6));
+    engineSelector.setBounds (area.removeFromBottom (28).removeFromRight (420));
 
     auto row1 = area.removeFromTop (120);
     auto row2 = area.removeFromTop (120);
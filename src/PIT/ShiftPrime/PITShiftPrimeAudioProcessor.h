@@ -1,18 +1,30 @@
 #pragma once
 
 #include <JuceHeader.h>
+#include <array>
 #include "../../DualPrecisionAudioProcessor.h"
-#include "../common/SimplePitchShifter.h"
+#include "../../ParameterTable.h"
+#include "../../SmoothedParameter.h"
+#include "../../dsp/Biquad.h"
+#include "../../dsp/DryWetStage.h"
+#include "../../dsp/LatencyReporter.h"
+#include "../common/PitchEngine.h"
+#include "../common/PitchEngineSelector.h"
 
 class PITShiftPrimeAudioProcessor : public DualPrecisionAudioProcessor
 {
 public:
+    enum class Param
+    {
+        semitones, cents, formant, hpf, lpf, mode, mix,
+        count
+    };
+
     PITShiftPrimeAudioProcessor();
     ~PITShiftPrimeAudioProcessor() override = default;
 
     void prepareToPlay (double sampleRate, int samplesPerBlock) override;
     void releaseResources() override;
-    void processBlock (juce::AudioBuffer<float>&, juce::MidiBuffer&) override;
 
     juce::AudioProcessorEditor* createEditor() override;
     bool hasEditor() const override { return true; }
@@ -21,7 +33,6 @@ public:
     bool acceptsMidi() const override { return false; }
     bool producesMidi() const override { return false; }
     bool isMidiEffect() const override { return false; }
-    double getTailLengthSeconds() const override { return 0.0; }
 
     int getNumPrograms() override { return 1; }
     int getCurrentProgram() override { return 0; }
@@ -38,20 +49,26 @@ public:
     juce::AudioProcessorValueTreeState& getValueTreeState() { return apvts; }
     static juce::AudioProcessorValueTreeState::ParameterLayout createParameterLayout();
 
+protected:
+    void processFloat (juce::AudioBuffer<float>&, juce::MidiBuffer&) override;
+
 private:
     juce::AudioProcessorValueTreeState apvts;
+    gls::ParameterHandles<Param> params;
+    gls::SmoothedParameter mixAmount { params, Param::mix };
     double currentSampleRate = 44100.0;
 
-    std::vector<juce::dsp::IIR::Filter<float>> hpfFilters;
-    std::vector<juce::dsp::IIR::Filter<float>> lpfFilters;
-    std::vector<juce::dsp::IIR::Filter<float>> formantFilters;
+    std::vector<gls::dsp::Biquad> hpfFilters;
+    std::vector<gls::dsp::Biquad> lpfFilters;
+    std::vector<gls::dsp::Biquad> formantFilters;
 
-    juce::AudioBuffer<float> dryBuffer;
-    juce::AudioBuffer<float> wetBuffer;
-    pit::SimplePitchShifter pitchShifter;
+    gls::dsp::DryWetStage dryWet;
+    pit::PitchEngine pitchEngine;
+    gls::dsp::LatencyReporter latency { *this };
 
-    void ensureStateSize (int numChannels, int numSamples);
+    void ensureStateSize (int numChannels);
     void updateFilters (float hpf, float lpf, float formant);
+    void updatePitchEngine();
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (PITShiftPrimeAudioProcessor)
 };
@@ -75,6 +92,7 @@ private:
     juce::Slider lpfSlider;
     juce::ComboBox modeBox;
     juce::Slider mixSlider;
+    pit::PitchEngineSelector engineSelector;
 
     using SliderAttachment = juce::AudioProcessorValueTreeState::SliderAttachment;
     using ComboAttachment  = juce::AudioProcessorValueTreeState::ComboBoxAttachment;
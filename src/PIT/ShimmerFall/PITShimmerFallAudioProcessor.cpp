@@ -7,39 +7,56 @@ constexpr auto kParamFeedback      = "feedback";
 constexpr auto kParamDamping       = "damping";
 constexpr auto kParamTime          = "time";
 constexpr auto kParamMix           = "mix";
+
+using Param = PITShimmerFallAudioProcessor::Param;
+using Spec = gls::ParameterSpec;
+
+constexpr std::array<Spec, (size_t) Param::count> parameterTable {{
+    Spec::range (kParamPitchInterval, "Pitch Interval", -12.0f, 12.0f, 0.01f,  7.0f),
+    Spec::range (kParamFeedback,      "Feedback",       0.0f,   0.98f, 0.001f, 0.6f),
+    Spec::range (kParamDamping,       "Damping",        0.0f,   1.0f,  0.001f, 0.5f),
+    Spec::range (kParamTime,          "Time",           0.1f,   20.0f, 0.01f,  4.0f),
+    Spec::range (kParamMix,           "Mix",            0.0f,   1.0f,  0.001f, 0.5f)
+}};
+
+static_assert (gls::hasUniqueIds (parameterTable));
 } // namespace
 
 //==============================================================================
 PITShimmerFallAudioProcessor::PITShimmerFallAudioProcessor()
     : DualPrecisionAudioProcessor (BusesProperties().withInput  ("Input",  juce::AudioChannelSet::stereo(), true)
                                                    .withOutput ("Output", juce::AudioChannelSet::stereo(), true)),
-      apvts (*this, nullptr, "Parameters", createParameterLayout())
+      apvts (*this, nullptr, "Parameters", createParameterLayout()),
+      params (apvts, parameterTable)
 {
+    shimmerShifter.attach (apvts);
 }
 
 //==============================================================================
 //==============================================================================
 void PITShimmerFallAudioProcessor::prepareToPlay (double sampleRate, int samplesPerBlock)
 {
+    DualPrecisionAudioProcessor::prepareToPlay (sampleRate, samplesPerBlock);
+
     const auto safeRate = sampleRate > 0.0 ? sampleRate : 44100.0;
     const auto totalChannels = juce::jmax (2, getTotalNumInputChannels());
     const auto blockSize = juce::jmax (1, samplesPerBlock);
 
     currentSpec = { safeRate, static_cast<juce::uint32> (blockSize), static_cast<juce::uint32> (totalChannels) };
     reverb.prepare (currentSpec);
-    shimmerBuffer.setSize (totalChannels, blockSize);
-    wetBuffer.setSize (totalChannels, blockSize);
+    mixAmount.prepare (safeRate, blockSize);
     shimmerShifter.prepare (safeRate, totalChannels);
-    shimmerShifter.reset();
+    dryWet.prepare (safeRate, totalChannels, blockSize, shimmerShifter.getMaximumLatencySamples());
+    latency.invalidate();
+    updatePitchEngine();
     feedbackMemory.assign ((size_t) totalChannels, 0.0f);
     updateReverbParams();
+    updateTail();
 }
 
 void PITShimmerFallAudioProcessor::releaseResources()
 {
     reverb.reset();
-    shimmerBuffer.setSize (0, 0);
-    wetBuffer.setSize (0, 0);
     feedbackMemory.clear();
 }
 
@@ -55,8 +72,11 @@ bool PITShimmerFallAudioProcessor::isBusesLayoutSupported (const BusesLayout& la
     return true;
 }
 
-void PITShimmerFallAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer, juce::MidiBuffer&)
+void PITShimmerFallAudioProcessor::processFloat (juce::AudioBuffer<float>& buffer, juce::MidiBuffer& midi)
 {
+    if (renderInPreparedChunks (buffer, midi))
+        return;
+
     juce::ScopedNoDenormals noDenormals;
 
     const auto numInputChannels  = getTotalNumInputChannels();
@@ -67,31 +87,28 @@ void PITShimmerFallAudioProcessor::processBlock (juce::AudioBuffer<float>& buffe
         buffer.clear (ch, 0, numSamples);
 
     // Cache parameter values for this block.
-    const auto pitchInterval = apvts.getRawParameterValue (kParamPitchInterval)->load();
-    const auto feedback      = apvts.getRawParameterValue (kParamFeedback)->load();
-    const auto damping       = apvts.getRawParameterValue (kParamDamping)->load();
-    const auto timeSeconds   = apvts.getRawParameterValue (kParamTime)->load();
-    const auto mix           = apvts.getRawParameterValue (kParamMix)->load();
+    const auto pitchInterval = params[Param::pitchInterval];
+    const auto feedback      = params[Param::feedback];
+    const auto damping       = params[Param::damping];
+    const auto timeSeconds   = params[Param::time];
 
     updateReverbParams();
+    updatePitchEngine();
 
-    shimmerBuffer.setSize (buffer.getNumChannels(), juce::jmax (1, numSamples), false, false, true);
-    wetBuffer.setSize (buffer.getNumChannels(), juce::jmax (1, numSamples), false, false, true);
-    shimmerBuffer.makeCopyOf (buffer, true); // dry copy
-    wetBuffer.makeCopyOf (buffer, true);
+    dryWet.begin (buffer, numSamples, mixAmount);
 
-    juce::dsp::AudioBlock<float> wetBlock (wetBuffer);
+    juce::dsp::AudioBlock<float> wetBlock (buffer);
     reverb.process (juce::dsp::ProcessContextReplacing<float> (wetBlock));
 
     const float pitchRatio = std::pow (2.0f, pitchInterval / 12.0f);
-    shimmerShifter.process (wetBuffer, pitchRatio);
+    shimmerShifter.process (buffer, pitchRatio);
 
     if ((int) feedbackMemory.size() < buffer.getNumChannels())
         feedbackMemory.assign ((size_t) buffer.getNumChannels(), 0.0f);
 
-    for (int ch = 0; ch < wetBuffer.getNumChannels(); ++ch)
+    for (int ch = 0; ch < buffer.getNumChannels(); ++ch)
     {
-        auto* data = wetBuffer.getWritePointer (ch);
+        auto* data = buffer.getWritePointer (ch);
         float& state = feedbackMemory[(size_t) ch];
 
         for (int i = 0; i < numSamples; ++i)
@@ -103,14 +120,7 @@ void PITShimmerFallAudioProcessor::processBlock (juce::AudioBuffer<float>& buffe
         }
     }
 
-    for (int ch = 0; ch < buffer.getNumChannels(); ++ch)
-    {
-        auto* dry = shimmerBuffer.getReadPointer (ch);
-        auto* wet = wetBuffer.getReadPointer (ch);
-        auto* out = buffer.getWritePointer (ch);
-        for (int i = 0; i < numSamples; ++i)
-            out[i] = wet[i] * mix + dry[i] * (1.0f - mix);
-    }
+    dryWet.end (buffer, numSamples, mixAmount);
 }
 
 juce::AudioProcessorEditor* PITShimmerFallAudioProcessor::createEditor()
@@ -136,38 +146,53 @@ void PITShimmerFallAudioProcessor::setStateInformation (const void* data, int si
 juce::AudioProcessorValueTreeState::ParameterLayout PITShimmerFallAudioProcessor::createParameterLayout()
 {
     std::vector<std::unique_ptr<juce::RangedAudioParameter>> params;
-
-    params.emplace_back (std::make_unique<juce::AudioParameterFloat> (kParamPitchInterval, "Pitch Interval",
-                                                                      juce::NormalisableRange<float> (-12.0f, 12.0f, 0.01f), 7.0f));
-    params.emplace_back (std::make_unique<juce::AudioParameterFloat> (kParamFeedback, "Feedback",
-                                                                      juce::NormalisableRange<float> (0.0f, 0.98f, 0.001f), 0.6f));
-    params.emplace_back (std::make_unique<juce::AudioParameterFloat> (kParamDamping, "Damping",
-                                                                      juce::NormalisableRange<float> (0.0f, 1.0f, 0.001f), 0.5f));
-    params.emplace_back (std::make_unique<juce::AudioParameterFloat> (kParamTime, "Time",
-                                                                      juce::NormalisableRange<float> (0.1f, 20.0f, 0.01f), 4.0f));
-    params.emplace_back (std::make_unique<juce::AudioParameterFloat> (kParamMix, "Mix",
-                                                                      juce::NormalisableRange<float> (0.0f, 1.0f, 0.001f), 0.5f));
+    gls::addParameters (params, parameterTable);
+    pit::PitchEngine::addParameters (params);
 
     return { params.begin(), params.end() };
 }
 
+void PITShimmerFallAudioProcessor::updatePitchEngine()
+{
+    shimmerShifter.update();
+    latency.setStage (0, shimmerShifter.getLatencySamples(), shimmerShifter.getLatencySamples());
+    latency.update();
+    dryWet.setLatency (shimmerShifter.getLatencySamples());
+}
+
 void PITShimmerFallAudioProcessor::updateReverbParams()
 {
     juce::dsp::Reverb::Parameters reverbParams;
-    reverbParams.damping      = apvts.getRawParameterValue (kParamDamping)->load();
-    reverbParams.roomSize     = juce::jlimit (0.0f, 1.0f, apvts.getRawParameterValue (kParamTime)->load() / 20.0f);
-    reverbParams.wetLevel     = apvts.getRawParameterValue (kParamMix)->load();
+    reverbParams.damping      = params[Param::damping];
+    reverbParams.roomSize     = juce::jlimit (0.0f, 1.0f, params[Param::time] / 20.0f);
+    reverbParams.wetLevel     = params[Param::mix];
     reverbParams.dryLevel     = 1.0f - reverbParams.wetLevel;
     reverbParams.freezeMode   = 0.0f;
     reverbParams.width        = 1.0f;
     reverb.setParameters (reverbParams);
 }
 
+void PITShimmerFallAudioProcessor::updateTail()
+{
+    // juce::dsp::Reverb's combs feed back by roomSize * 0.28 + 0.7 around at most 1617
+    // samples at 44.1 kHz, the same time at any rate. The shimmer feedback is a one-pole
+    // loop on top; the pitch engine's latency is added by the base.
+    const auto roomSize = juce::jlimit (0.0, 1.0, params[Param::time] / 20.0);
+    const auto reverbRT60 = gls::dsp::TailTracker::getFeedbackRT60 (1617.0 / 44100.0, roomSize * 0.28 + 0.7);
+    const auto feedbackRT60 = gls::dsp::TailTracker::getFeedbackRT60 (1.0 / currentSpec.sampleRate,
+                                                                      params[Param::feedback]
+                                                                          * params[Param::damping]);
+
+    tail.setTail (0.0, reverbRT60 + feedbackRT60);
+}
+
 //==============================================================================
 PITShimmerFallAudioProcessorEditor::PITShimmerFallAudioProcessorEditor (PITShimmerFallAudioProcessor& processor)
-    : juce::AudioProcessorEditor (&processor), processorRef (processor)
+    : juce::AudioProcessorEditor (&processor), processorRef (processor),
+      engineSelector (processor.getValueTreeState())
 {
-    setSize (480, 300);
+    addAndMakeVisible (engineSelector);
+    setSize (480, 330);
 
     initSlider (pitchIntervalSlider, "Pitch Interval");
     initSlider (feedbackSlider,      "Feedback");
@@ -194,6 +219,7 @@ void PITShimmerFallAudioProcessorEditor::paint (juce::Graphics& g)
 void PITShimmerFallAudioProcessorEditor::resized()
 {
     auto area = getLocalBounds().reduced (20);
+    engineSelector.setBounds (area.removeFromBottom (28).removeFromRight (260));
     auto row  = area.removeFromTop (area.getHeight() / 2);
 
     pitchIntervalSlider.setBounds (row.removeFromLeft (area.getWidth() / 3));
@@ -1,12 +1,24 @@
 #pragma once
 
 #include <JuceHeader.h>
+#include <array>
 #include "../../DualPrecisionAudioProcessor.h"
-#include "../common/SimplePitchShifter.h"
+#include "../../ParameterTable.h"
+#include "../../SmoothedParameter.h"
+#include "../../dsp/DryWetStage.h"
+#include "../../dsp/LatencyReporter.h"
+#include "../common/PitchEngine.h"
+#include "../common/PitchEngineSelector.h"
 
 class PITShimmerFallAudioProcessor : public DualPrecisionAudioProcessor
 {
 public:
+    enum class Param
+    {
+        pitchInterval, feedback, damping, time, mix,
+        count
+    };
+
     PITShimmerFallAudioProcessor();
     ~PITShimmerFallAudioProcessor() override = default;
 
@@ -14,7 +26,6 @@ public:
     void prepareToPlay (double sampleRate, int samplesPerBlock) override;
     void releaseResources() override;
     bool isBusesLayoutSupported (const BusesLayout& layouts) const override;
-    void processBlock (juce::AudioBuffer<float>&, juce::MidiBuffer&) override;
 
     //==============================================================================
     juce::AudioProcessorEditor* createEditor() override;
@@ -25,7 +36,6 @@ public:
     bool acceptsMidi() const override { return false; }
     bool producesMidi() const override { return false; }
     bool isMidiEffect() const override { return false; }
-    double getTailLengthSeconds() const override { return 0.0; }
 
     //==============================================================================
     int getNumPrograms() override { return 1; }
@@ -44,17 +54,24 @@ public:
     juce::AudioProcessorValueTreeState& getValueTreeState() { return apvts; }
     static juce::AudioProcessorValueTreeState::ParameterLayout createParameterLayout();
 
+protected:
+    void processFloat (juce::AudioBuffer<float>&, juce::MidiBuffer&) override;
+    void updateTail() override;
+
 private:
     juce::AudioProcessorValueTreeState apvts;
+    gls::ParameterHandles<Param> params;
+    gls::SmoothedParameter mixAmount { params, Param::mix };
 
     juce::dsp::Reverb reverb;
     juce::dsp::ProcessSpec currentSpec { 44100.0, 512, 2 };
-    juce::AudioBuffer<float> shimmerBuffer;
-    juce::AudioBuffer<float> wetBuffer;
-    pit::SimplePitchShifter shimmerShifter;
+    pit::PitchEngine shimmerShifter;
+    gls::dsp::LatencyReporter latency { *this };
+    gls::dsp::DryWetStage dryWet;
     std::vector<float> feedbackMemory;
 
     void updateReverbParams();
+    void updatePitchEngine();
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (PITShimmerFallAudioProcessor)
 };
@@ -77,6 +94,7 @@ private:
     juce::Slider dampingSlider;
     juce::Slider timeSlider;
     juce::Slider mixSlider;
+    pit::PitchEngineSelector engineSelector;
 
     using SliderAttachment = juce::AudioProcessorValueTreeState::SliderAttachment;
     std::vector<std::unique_ptr<SliderAttachment>> attachments;
@@ -9,6 +9,30 @@ constexpr auto kHpfId        = "hpf";
 constexpr auto kLpfId        = "lpf";
 constexpr auto kSwingId      = "swing";
 constexpr auto kMixId        = "mix";
+
+using Param = PITTimeStackAudioProcessor::Param;
+using Spec = gls::ParameterSpec;
+
+constexpr std::array<Spec, (size_t) Param::count> parameterTable {{
+    Spec::range (kTapTimeIds[0],  "Tap Time 1",  10.0f,   2000.0f,  0.1f,   250.0f,   0.4f),
+    Spec::range (kTapTimeIds[1],  "Tap Time 2",  10.0f,   2000.0f,  0.1f,   250.0f,   0.4f),
+    Spec::range (kTapTimeIds[2],  "Tap Time 3",  10.0f,   2000.0f,  0.1f,   250.0f,   0.4f),
+    Spec::range (kTapTimeIds[3],  "Tap Time 4",  10.0f,   2000.0f,  0.1f,   250.0f,   0.4f),
+    Spec::range (kTapLevelIds[0], "Tap Level 1", 0.0f,    1.0f,     0.001f, 0.7f),
+    Spec::range (kTapLevelIds[1], "Tap Level 2", 0.0f,    1.0f,     0.001f, 0.7f),
+    Spec::range (kTapLevelIds[2], "Tap Level 3", 0.0f,    1.0f,     0.001f, 0.7f),
+    Spec::range (kTapLevelIds[3], "Tap Level 4", 0.0f,    1.0f,     0.001f, 0.7f),
+    Spec::range (kTapPanIds[0],   "Tap Pan 1",   -1.0f,   1.0f,     0.001f, 0.0f),
+    Spec::range (kTapPanIds[1],   "Tap Pan 2",   -1.0f,   1.0f,     0.001f, 0.0f),
+    Spec::range (kTapPanIds[2],   "Tap Pan 3",   -1.0f,   1.0f,     0.001f, 0.0f),
+    Spec::range (kTapPanIds[3],   "Tap Pan 4",   -1.0f,   1.0f,     0.001f, 0.0f),
+    Spec::range (kHpfId,          "HPF",         20.0f,   2000.0f,  0.01f,  120.0f,   0.35f),
+    Spec::range (kLpfId,          "LPF",         2000.0f, 20000.0f, 0.01f,  15000.0f, 0.35f),
+    Spec::range (kSwingId,        "Swing",       0.0f,    1.0f,     0.001f, 0.0f),
+    Spec::range (kMixId,          "Mix",         0.0f,    1.0f,     0.001f, 0.5f)
+}};
+
+static_assert (gls::hasUniqueIds (parameterTable));
 } // namespace
 
 //==============================================================================
@@ -16,30 +40,26 @@ PITTimeStackAudioProcessor::PITTimeStackAudioProcessor()
     : DualPrecisionAudioProcessor (BusesProperties()
                         .withInput  ("Input",  juce::AudioChannelSet::stereo(), true)
                         .withOutput ("Output", juce::AudioChannelSet::stereo(), true)),
-      apvts (*this, nullptr, "PIT_TIME_STACK", createParameterLayout())
+      apvts (*this, nullptr, "PIT_TIME_STACK", createParameterLayout()),
+      params (apvts, parameterTable)
 {
 }
 
 void PITTimeStackAudioProcessor::prepareToPlay (double sampleRate, int samplesPerBlock)
 {
+    DualPrecisionAudioProcessor::prepareToPlay (sampleRate, samplesPerBlock);
+
     currentSampleRate = sampleRate > 0.0 ? sampleRate : 44100.0;
     const auto totalChannels = juce::jmax (2, getTotalNumOutputChannels());
     const auto blockSize = juce::jmax (1, samplesPerBlock);
 
-    dryBuffer.setSize (totalChannels, blockSize);
     monoBuffer.setSize (1, blockSize);
     tapScratchBuffer.setSize (1, blockSize);
-    wetBuffer.setSize (totalChannels, blockSize);
-
-    const auto maxDelaySamples = juce::jmax (1, (int) std::ceil (currentSampleRate * 3.0));
-    juce::dsp::ProcessSpec monoSpec { currentSampleRate, static_cast<juce::uint32> (blockSize), 1 };
+    mixAmount.prepare (currentSampleRate, blockSize);
+    dryWet.prepare (currentSampleRate, totalChannels, blockSize);
 
-    for (auto& line : tapDelayLines)
-    {
-        line.prepare (monoSpec);
-        line.setMaximumDelayInSamples (maxDelaySamples);
-        line.reset();
-    }
+    // All four taps read the same mono feed, so one line serves them.
+    tapDelay.prepare (currentSampleRate, 3.0, blockSize);
 
     juce::dsp::ProcessSpec stereoSpec { currentSampleRate,
                                         static_cast<juce::uint32> (blockSize),
@@ -53,10 +73,8 @@ void PITTimeStackAudioProcessor::prepareToPlay (double sampleRate, int samplesPe
 
 void PITTimeStackAudioProcessor::releaseResources()
 {
-    dryBuffer.setSize (0, 0);
     monoBuffer.setSize (0, 0);
     tapScratchBuffer.setSize (0, 0);
-    wetBuffer.setSize (0, 0);
 }
 
 bool PITTimeStackAudioProcessor::isBusesLayoutSupported (const BusesLayout& layouts) const
@@ -73,8 +91,11 @@ bool PITTimeStackAudioProcessor::isBusesLayoutSupported (const BusesLayout& layo
     return true;
 }
 
-void PITTimeStackAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer, juce::MidiBuffer&)
+void PITTimeStackAudioProcessor::processFloat (juce::AudioBuffer<float>& buffer, juce::MidiBuffer& midi)
 {
+    if (renderInPreparedChunks (buffer, midi))
+        return;
+
     juce::ScopedNoDenormals noDenormals;
 
     const auto numInputChannels  = getTotalNumInputChannels();
@@ -84,8 +105,6 @@ void PITTimeStackAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer,
     for (auto ch = numInputChannels; ch < numOutputChannels; ++ch)
         buffer.clear (ch, 0, numSamples);
 
-    ensureBuffers (buffer.getNumChannels(), numSamples);
-    dryBuffer.makeCopyOf (buffer, true);
     monoBuffer.clear();
 
     const auto inputGain = buffer.getNumChannels() > 0
@@ -101,69 +120,74 @@ void PITTimeStackAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer,
 
     for (size_t i = 0; i < kNumTaps; ++i)
     {
-        tapTimes[i]  = apvts.getRawParameterValue (kTapTimeIds[i])->load();
-        tapLevels[i] = apvts.getRawParameterValue (kTapLevelIds[i])->load();
-        tapPans[i]   = apvts.getRawParameterValue (kTapPanIds[i])->load();
+        tapTimes[i]  = params[(Param) ((size_t) Param::tap1Time + i)];
+        tapLevels[i] = params[(Param) ((size_t) Param::tap1Level + i)];
+        tapPans[i]   = params[(Param) ((size_t) Param::tap1Pan + i)];
     }
 
-    const auto hpf   = apvts.getRawParameterValue (kHpfId)->load();
-    const auto lpf   = apvts.getRawParameterValue (kLpfId)->load();
-    const auto swing = apvts.getRawParameterValue (kSwingId)->load();
-    const auto mix   = juce::jlimit (0.0f, 1.0f, apvts.getRawParameterValue (kMixId)->load());
-
-    wetBuffer.clear();
+    const auto hpf   = params[Param::hpf];
+    const auto lpf   = params[Param::lpf];
+    const auto swing = params[Param::swing];
 
-    juce::dsp::AudioBlock<const float> monoBlock (monoBuffer);
-    juce::dsp::AudioBlock<float> tapBlock (tapScratchBuffer);
-    auto monoChannelBlock = monoBlock.getSingleChannelBlock (0);
-    auto tapChannelBlock  = tapBlock.getSingleChannelBlock (0);
+    std::array<float, kNumTaps> tapDelaySamples {};
+    std::array<float, kNumTaps> leftGains {};
+    std::array<float, kNumTaps> rightGains {};
 
     for (size_t tapIdx = 0; tapIdx < kNumTaps; ++tapIdx)
     {
-        tapScratchBuffer.clear();
-
         auto swingDirection = (tapIdx % 2 == 0 ? -1.0f : 1.0f);
         const auto swingOffset = 1.0f + swingDirection * swing * 0.35f;
         auto timeMs = tapTimes[tapIdx] * swingOffset;
         timeMs = juce::jlimit (10.0f, 2000.0f, timeMs);
-        auto delaySamples = timeMs * 0.001f * static_cast<float> (currentSampleRate);
-        const auto maxDelay = static_cast<float> (tapDelayLines[tapIdx].getMaximumDelayInSamples() - 2);
-        delaySamples = juce::jlimit (1.0f, maxDelay, delaySamples);
-
-        tapDelayLines[tapIdx].setDelay (delaySamples);
-        auto tapContext = juce::dsp::ProcessContextNonReplacing<float> (monoChannelBlock, tapChannelBlock);
-        tapDelayLines[tapIdx].process (tapContext);
+        tapDelaySamples[tapIdx] = timeMs * 0.001f * static_cast<float> (currentSampleRate);
 
         auto gain = juce::jlimit (0.0f, 1.0f, tapLevels[tapIdx]);
-        tapScratchBuffer.applyGain (gain);
-
         const auto pan   = juce::jlimit (-1.0f, 1.0f, tapPans[tapIdx]);
         const auto angle = juce::jmap (pan, -1.0f, 1.0f,
                                        0.0f,
                                        juce::MathConstants<float>::halfPi);
-        const auto leftGain  = std::cos (angle);
-        const auto rightGain = std::sin (angle);
+        leftGains[tapIdx]  = gain * std::cos (angle);
+        rightGains[tapIdx] = gain * std::sin (angle);
+    }
+
+    // The taps replace the input in place; the stage keeps the dry copy only while it
+    // is heard. Blocks never exceed the prepared size, so the line takes them whole.
+    dryWet.begin (buffer, numSamples, mixAmount);
+    buffer.clear();
+
+    const auto* mono = monoBuffer.getReadPointer (0);
+    auto* tap = tapScratchBuffer.getWritePointer (0);
+    tapDelay.write (mono, numSamples);
+
+    for (size_t tapIdx = 0; tapIdx < kNumTaps; ++tapIdx)
+    {
+        tapDelay.read (tap, numSamples, tapDelaySamples[tapIdx]);
 
-        if (wetBuffer.getNumChannels() > 0)
-            wetBuffer.addFrom (0, 0, tapScratchBuffer, 0, 0, numSamples, leftGain);
+        if (buffer.getNumChannels() > 0)
+            buffer.addFrom (0, 0, tap, numSamples, leftGains[tapIdx]);
 
-        if (wetBuffer.getNumChannels() > 1)
-            wetBuffer.addFrom (1, 0, tapScratchBuffer, 0, 0, numSamples, rightGain);
+        if (buffer.getNumChannels() > 1)
+            buffer.addFrom (1, 0, tap, numSamples, rightGains[tapIdx]);
     }
 
     updateFilters (hpf, lpf);
-    juce::dsp::AudioBlock<float> wetBlock (wetBuffer);
+    juce::dsp::AudioBlock<float> wetBlock (buffer);
     auto wetCtx = juce::dsp::ProcessContextReplacing<float> (wetBlock);
     hpfProcessor.process (wetCtx);
     lpfProcessor.process (wetCtx);
 
-    for (int ch = 0; ch < buffer.getNumChannels(); ++ch)
-    {
-        buffer.copyFrom (ch, 0, dryBuffer, ch, 0, numSamples);
-        buffer.applyGain (ch, 0, numSamples, 1.0f - mix);
-        buffer.addFrom (ch, 0, wetBuffer, juce::jmin (ch, wetBuffer.getNumChannels() - 1),
-                        0, numSamples, mix);
-    }
+    dryWet.end (buffer, numSamples, mixAmount);
+}
+
+void PITTimeStackAudioProcessor::updateTail()
+{
+    // The last tap, with swing stretching it by up to 35 %.
+    const auto stretch = 1.0f + 0.35f * params[Param::swing];
+    float longestMs = 0.0f;
+    for (size_t i = 0; i < kNumTaps; ++i)
+        longestMs = juce::jmax (longestMs, juce::jlimit (10.0f, 2000.0f, params[(Param) ((size_t) Param::tap1Time + i)] * stretch));
+
+    tail.setTail (longestMs * 0.001);
 }
 
 //==============================================================================
@@ -187,37 +211,7 @@ void PITTimeStackAudioProcessor::setStateInformation (const void* data, int size
 
 juce::AudioProcessorValueTreeState::ParameterLayout PITTimeStackAudioProcessor::createParameterLayout()
 {
-    std::vector<std::unique_ptr<juce::RangedAudioParameter>> params;
-
-    auto addTapParams = [&params](const std::array<const char*, 4>& ids,
-                                  const juce::String& prefix,
-                                  const juce::NormalisableRange<float>& range,
-                                  float defaultValue)
-    {
-        for (size_t i = 0; i < ids.size(); ++i)
-        {
-            params.push_back (std::make_unique<juce::AudioParameterFloat> (
-                ids[i],
-                prefix + juce::String ((int) i + 1),
-                range,
-                defaultValue));
-        }
-    };
-
-    addTapParams (kTapTimeIds,  "Tap Time ",  juce::NormalisableRange<float> (10.0f, 2000.0f, 0.1f, 0.4f), 250.0f);
-    addTapParams (kTapLevelIds, "Tap Level ", juce::NormalisableRange<float> (0.0f, 1.0f, 0.001f), 0.7f);
-    addTapParams (kTapPanIds,   "Tap Pan ",   juce::NormalisableRange<float> (-1.0f, 1.0f, 0.001f), 0.0f);
-
-    params.push_back (std::make_unique<juce::AudioParameterFloat> (kHpfId, "HPF",
-                                                                   juce::NormalisableRange<float> (20.0f, 2000.0f, 0.01f, 0.35f), 120.0f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> (kLpfId, "LPF",
-                                                                   juce::NormalisableRange<float> (2000.0f, 20000.0f, 0.01f, 0.35f), 15000.0f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> (kSwingId, "Swing",
-                                                                   juce::NormalisableRange<float> (0.0f, 1.0f, 0.001f), 0.0f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> (kMixId, "Mix",
-                                                                   juce::NormalisableRange<float> (0.0f, 1.0f, 0.001f), 0.5f));
-
-    return { params.begin(), params.end() };
+    return gls::createParameterLayout (parameterTable);
 }
 
 //==============================================================================
@@ -307,25 +301,8 @@ void PITTimeStackAudioProcessor::updateFilters (float hpf, float lpf)
     const auto hpfCutoff = juce::jlimit (20.0f, 2000.0f, hpf);
     const auto lpfCutoff = juce::jlimit (500.0f, 20000.0f, lpf);
 
-    if (hpfProcessor.state != nullptr)
-    {
-        *hpfProcessor.state = *juce::dsp::IIR::Coefficients<float>::makeHighPass (currentSampleRate, hpfCutoff);
-        lastHpfCutoff = hpfCutoff;
-    }
-
-    if (lpfProcessor.state != nullptr)
-    {
-        *lpfProcessor.state = *juce::dsp::IIR::Coefficients<float>::makeLowPass (currentSampleRate, lpfCutoff);
-        lastLpfCutoff = lpfCutoff;
-    }
-}
-
-void PITTimeStackAudioProcessor::ensureBuffers (int numChannels, int numSamples)
-{
-    const auto channelCount = juce::jmax (2, numChannels);
-    const auto samples = juce::jmax (1, numSamples);
-    dryBuffer.setSize (channelCount, samples, false, false, true);
-    wetBuffer.setSize (channelCount, samples, false, false, true);
-    monoBuffer.setSize (1, samples, false, false, true);
-    tapScratchBuffer.setSize (1, samples, false, false, true);
+    hpfProcessor.setDesign (gls::dsp::BiquadType::highPass, currentSampleRate, hpfCutoff);
+    lpfProcessor.setDesign (gls::dsp::BiquadType::lowPass, currentSampleRate, lpfCutoff);
+    lastHpfCutoff = hpfCutoff;
+    lastLpfCutoff = lpfCutoff;
 }
@@ -1,11 +1,24 @@
 #pragma once
 
 #include <JuceHeader.h>
+#include <array>
 #include "../../DualPrecisionAudioProcessor.h"
+#include "../../ParameterTable.h"
+#include "../../SmoothedParameter.h"
+#include "../../dsp/Biquad.h"
+#include "../../dsp/DelayLine.h"
+#include "../../dsp/DryWetStage.h"
 
 class PITTimeStackAudioProcessor : public DualPrecisionAudioProcessor
 {
 public:
+    enum class Param
+    {
+        tap1Time, tap2Time, tap3Time, tap4Time, tap1Level, tap2Level, tap3Level,
+        tap4Level, tap1Pan, tap2Pan, tap3Pan, tap4Pan, hpf, lpf, swing, mix,
+        count
+    };
+
     PITTimeStackAudioProcessor();
     ~PITTimeStackAudioProcessor() override = default;
 
@@ -13,7 +26,6 @@ public:
     void prepareToPlay (double sampleRate, int samplesPerBlock) override;
     void releaseResources() override;
     bool isBusesLayoutSupported (const BusesLayout& layouts) const override;
-    void processBlock (juce::AudioBuffer<float>&, juce::MidiBuffer&) override;
 
     //==============================================================================
     juce::AudioProcessorEditor* createEditor() override;
@@ -24,7 +36,6 @@ public:
     bool acceptsMidi() const override { return false; }
     bool producesMidi() const override { return false; }
     bool isMidiEffect() const override { return false; }
-    double getTailLengthSeconds() const override { return 0.0; }
 
     //==============================================================================
     int getNumPrograms() override { return 1; }
@@ -43,26 +54,27 @@ public:
     juce::AudioProcessorValueTreeState& getValueTreeState() { return apvts; }
     static juce::AudioProcessorValueTreeState::ParameterLayout createParameterLayout();
 
+protected:
+    void processFloat (juce::AudioBuffer<float>&, juce::MidiBuffer&) override;
+    void updateTail() override;
+
 private:
     juce::AudioProcessorValueTreeState apvts;
-    juce::AudioBuffer<float> dryBuffer;
+    gls::ParameterHandles<Param> params;
+    gls::SmoothedParameter mixAmount { params, Param::mix };
     double currentSampleRate = 44100.0;
     juce::AudioBuffer<float> monoBuffer;
     juce::AudioBuffer<float> tapScratchBuffer;
-    juce::AudioBuffer<float> wetBuffer;
+    gls::dsp::DryWetStage dryWet;
 
     static constexpr size_t kNumTaps = 4;
-    using DelayLine = juce::dsp::DelayLine<float, juce::dsp::DelayLineInterpolationTypes::Linear>;
-    std::array<DelayLine, kNumTaps> tapDelayLines;
-    juce::dsp::ProcessorDuplicator<juce::dsp::IIR::Filter<float>,
-                                   juce::dsp::IIR::Coefficients<float>> hpfProcessor;
-    juce::dsp::ProcessorDuplicator<juce::dsp::IIR::Filter<float>,
-                                   juce::dsp::IIR::Coefficients<float>> lpfProcessor;
+    gls::dsp::DelayLine<float> tapDelay;
+    gls::dsp::MultiChannelBiquad hpfProcessor;
+    gls::dsp::MultiChannelBiquad lpfProcessor;
     float lastHpfCutoff = 120.0f;
     float lastLpfCutoff = 15000.0f;
 
     void updateFilters (float hpf, float lpf);
-    void ensureBuffers (int numChannels, int numSamples);
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (PITTimeStackAudioProcessor)
 };
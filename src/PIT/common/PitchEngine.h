@@ -0,0 +1,149 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include "../../dsp/PhaseVocoder.h"
+#include "SimplePitchShifter.h"
+#include <array>
+#include <atomic>
+
+namespace pit
+{
+/** Pitch stage shared by the PIT shifters: the original two-grain delay shifter, or the
+    phase vocoder at one of three frame sizes, chosen by the "pitch_engine" parameter.
+
+    All engines are built in prepare(), so switching from the audio thread never
+    allocates. The vocoder delays its output by one frame; processors report
+    getLatencySamples() to the host and to their gls::dsp::DryWetStage, so the mix
+    stays phase-aligned. The grain engine reports no latency, as before.
+
+    Processors that add the "formant_preserve" parameter get the vocoder's envelope
+    re-imposition; the grain engine has no spectrum to work on and ignores it. */
+class PitchEngine
+{
+public:
+    enum class Engine
+    {
+        grain,
+        lowLatency,
+        balanced,
+        highQuality
+    };
+
+    static constexpr const char* parameterId = "pitch_engine";
+    static constexpr const char* formantParameterId = "formant_preserve";
+
+    /** Defaults to the grain engine, so sessions saved before the vocoder existed reload
+        with the same sound and no added latency. */
+    static void addParameters (std::vector<std::unique_ptr<juce::RangedAudioParameter>>& params,
+                               Engine defaultEngine = Engine::grain)
+    {
+        params.push_back (std::make_unique<juce::AudioParameterChoice> (parameterId, "Pitch Engine",
+                                                                        juce::StringArray { "Grain", "Low Latency", "Balanced", "High Quality" },
+                                                                        (int) defaultEngine));
+    }
+
+    static void addFormantParameter (std::vector<std::unique_ptr<juce::RangedAudioParameter>>& params,
+                                     bool defaultPreserve)
+    {
+        params.push_back (std::make_unique<juce::AudioParameterBool> (formantParameterId, "Preserve Formants", defaultPreserve));
+    }
+
+    void prepare (double sampleRate, int maxChannels)
+    {
+        channels = juce::jmax (1, maxChannels);
+
+        grain.prepare (sampleRate, channels);
+
+        for (size_t i = 0; i < vocoders.size(); ++i)
+            vocoders[i].prepare (sampleRate, channels, (gls::dsp::PhaseVocoderPitchShifter::Quality) i);
+
+        reset();
+    }
+
+    void reset() noexcept
+    {
+        grain.reset();
+
+        for (auto& vocoder : vocoders)
+            vocoder.reset();
+    }
+
+    /** Resolves the parameters once, from the processor's constructor; the formant
+        parameter is optional. */
+    void attach (juce::AudioProcessorValueTreeState& state)
+    {
+        engineParameter = state.getRawParameterValue (parameterId);
+        formantParameter = state.getRawParameterValue (formantParameterId);
+        jassert (engineParameter != nullptr);
+    }
+
+    /** Reads the parameters and selects the engine. Returns true if it changed, in which
+        case the caller should re-report latency. */
+    bool update() noexcept
+    {
+        if (formantParameter != nullptr)
+            preserveFormants = formantParameter->load (std::memory_order_relaxed) > 0.5f;
+
+        const auto newEngine = (Engine) juce::jlimit (0, 3, (int) engineParameter->load (std::memory_order_relaxed));
+
+        if (newEngine == engine)
+            return false;
+
+        engine = newEngine;
+        reset();
+        return true;
+    }
+
+    Engine getEngine() const noexcept                   { return engine; }
+
+    /** True when the current engine is re-imposing the input's formants, in which case
+        a processor's own formant filter should stand aside. */
+    bool isPreservingFormants() const noexcept          { return preserveFormants && engine != Engine::grain; }
+
+    /** Moves the preserved envelope by this ratio (1 = leave formants where they are). */
+    void setFormantShift (float ratio) noexcept         { formantRatio = ratio; }
+
+    int getLatencySamples() const noexcept
+    {
+        if (auto* vocoder = getCurrentVocoder())
+            return vocoder->getLatencySamples();
+
+        return 0;
+    }
+
+    /** The latency of the slowest engine, for sizing latency-matched dry paths. */
+    int getMaximumLatencySamples() const noexcept       { return vocoders.back().getLatencySamples(); }
+
+    void process (juce::AudioBuffer<float>& buffer, float ratio)
+    {
+        if (auto* vocoder = getCurrentVocoder())
+        {
+            vocoder->setFormantPreservation (preserveFormants, formantRatio);
+            vocoder->process (buffer, ratio);
+        }
+        else
+            grain.process (buffer, ratio);
+    }
+
+private:
+    const gls::dsp::PhaseVocoderPitchShifter* getCurrentVocoder() const noexcept
+    {
+        return engine == Engine::grain ? nullptr : &vocoders[(size_t) engine - 1];
+    }
+
+    gls::dsp::PhaseVocoderPitchShifter* getCurrentVocoder() noexcept
+    {
+        return engine == Engine::grain ? nullptr : &vocoders[(size_t) engine - 1];
+    }
+
+    std::atomic<float>* engineParameter = nullptr;
+    std::atomic<float>* formantParameter = nullptr;
+
+    SimplePitchShifter grain;
+    std::array<gls::dsp::PhaseVocoderPitchShifter, 3> vocoders;
+    int channels = 2;
+    Engine engine = Engine::grain;
+    bool preserveFormants = false;
+    float formantRatio = 1.0f;
+};
+} // namespace pit
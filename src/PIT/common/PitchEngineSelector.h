@@ -0,0 +1,54 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include "PitchEngine.h"
+
+namespace pit
+{
+/** Labelled box for the PitchEngine choice, laid out like gls::ui::OversamplingSelector,
+    plus a formant toggle when the processor exposes one. */
+class PitchEngineSelector : public juce::Component
+{
+public:
+    explicit PitchEngineSelector (juce::AudioProcessorValueTreeState& state)
+    {
+        if (auto* choice = dynamic_cast<juce::AudioParameterChoice*> (state.getParameter (PitchEngine::parameterId)))
+            engineBox.addItemList (choice->choices, 1);
+
+        addAndMakeVisible (engineBox);
+        attachment = std::make_unique<Attachment> (state, PitchEngine::parameterId, engineBox);
+
+        if (state.getParameter (PitchEngine::formantParameterId) != nullptr)
+        {
+            formantButton.setButtonText ("Preserve Formants");
+            addAndMakeVisible (formantButton);
+            formantAttachment = std::make_unique<ButtonAttachment> (state, PitchEngine::formantParameterId, formantButton);
+        }
+
+        label.setText ("Engine", juce::dontSendNotification);
+        label.setJustificationType (juce::Justification::centredRight);
+        addAndMakeVisible (label);
+    }
+
+    void resized() override
+    {
+        auto area = getLocalBounds();
+        engineBox.setBounds (area.removeFromRight (juce::jmin (130, area.getWidth() / 2)).reduced (2));
+
+        if (formantAttachment != nullptr)
+            formantButton.setBounds (area.removeFromLeft (juce::jmin (150, area.getWidth() / 2)).reduced (2));
+
+        label.setBounds (area);
+    }
+
+private:
+    using Attachment = juce::AudioProcessorValueTreeState::ComboBoxAttachment;
+    using ButtonAttachment = juce::AudioProcessorValueTreeState::ButtonAttachment;
+
+    juce::Label label;
+    juce::ComboBox engineBox;
+    juce::ToggleButton formantButton;
+    std::unique_ptr<Attachment> attachment;
+    std::unique_ptr<ButtonAttachment> formantAttachment;
+};
+} // namespace pit
@@ -0,0 +1,137 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include <array>
+#include <atomic>
+#include <type_traits>
+
+namespace gls
+{
+/** One row of a plugin's constexpr parameter table. A plugin lists its parameters once,
+    in host order, as `parameterTable` in its .cpp, and indexes them by the public
+    `Param` enum class in its processor header: one enumerator per row, in the same
+    order, with `count` last. The same table builds the APVTS layout and resolves a
+    ParameterHandles, so processBlock reads cached atomics by index instead of looking
+    up string IDs. */
+struct ParameterSpec
+{
+    enum class Type
+    {
+        continuous,
+        toggle,
+        choice,
+        integer
+    };
+
+    const char* id = "";
+    const char* name = "";
+    Type type = Type::continuous;
+    float minimum = 0.0f, maximum = 1.0f, interval = 0.0f, skew = 1.0f, defaultValue = 0.0f;
+    const char* choices = "";           // '|'-separated, choice parameters only
+
+    static constexpr ParameterSpec range (const char* id, const char* name, float minimum, float maximum,
+                                          float interval, float defaultValue, float skew = 1.0f) noexcept
+    {
+        return { id, name, Type::continuous, minimum, maximum, interval, skew, defaultValue, "" };
+    }
+
+    static constexpr ParameterSpec toggle (const char* id, const char* name, bool defaultValue) noexcept
+    {
+        return { id, name, Type::toggle, 0.0f, 1.0f, 1.0f, 1.0f, defaultValue ? 1.0f : 0.0f, "" };
+    }
+
+    static constexpr ParameterSpec choice (const char* id, const char* name, const char* choices, int defaultIndex) noexcept
+    {
+        return { id, name, Type::choice, 0.0f, 0.0f, 1.0f, 1.0f, (float) defaultIndex, choices };
+    }
+
+    static constexpr ParameterSpec integer (const char* id, const char* name, int minimum, int maximum, int defaultValue) noexcept
+    {
+        return { id, name, Type::integer, (float) minimum, (float) maximum, 1.0f, 1.0f, (float) defaultValue, "" };
+    }
+
+    std::unique_ptr<juce::RangedAudioParameter> create() const
+    {
+        switch (type)
+        {
+            case Type::toggle:
+                return std::make_unique<juce::AudioParameterBool> (id, name, defaultValue > 0.5f);
+
+            case Type::choice:
+                return std::make_unique<juce::AudioParameterChoice> (id, name, juce::StringArray::fromTokens (choices, "|", ""),
+                                                                     (int) defaultValue);
+
+            case Type::integer:
+                return std::make_unique<juce::AudioParameterInt> (id, name, (int) minimum, (int) maximum, (int) defaultValue);
+
+            case Type::continuous:
+            default:
+                return std::make_unique<juce::AudioParameterFloat> (id, name, juce::NormalisableRange<float> (minimum, maximum, interval, skew),
+                                                                    defaultValue);
+        }
+    }
+};
+
+/** True when no two rows share an ID; use it in a static_assert next to the table. */
+template <size_t N>
+constexpr bool hasUniqueIds (const std::array<ParameterSpec, N>& table) noexcept
+{
+    auto equal = [] (const char* a, const char* b)
+    {
+        for (; *a != 0 && *a == *b; ++a, ++b) {}
+        return *a == *b;
+    };
+
+    for (size_t i = 0; i < N; ++i)
+        for (size_t j = i + 1; j < N; ++j)
+            if (equal (table[i].id, table[j].id))
+                return false;
+
+    return true;
+}
+
+template <size_t N>
+void addParameters (std::vector<std::unique_ptr<juce::RangedAudioParameter>>& params,
+                    const std::array<ParameterSpec, N>& table)
+{
+    for (const auto& spec : table)
+        params.push_back (spec.create());
+}
+
+template <size_t N>
+juce::AudioProcessorValueTreeState::ParameterLayout createParameterLayout (const std::array<ParameterSpec, N>& table)
+{
+    std::vector<std::unique_ptr<juce::RangedAudioParameter>> params;
+    addParameters (params, table);
+    return { params.begin(), params.end() };
+}
+
+/** The raw-value atomics for every row of a table, resolved once after the APVTS is
+    built. Index with the same enum class the table is ordered by. */
+template <typename Index>
+class ParameterHandles
+{
+public:
+    static constexpr size_t size = (size_t) Index::count;
+
+    ParameterHandles (juce::AudioProcessorValueTreeState& state, const std::array<ParameterSpec, size>& table)
+    {
+        for (size_t i = 0; i < size; ++i)
+        {
+            handles[i] = state.getRawParameterValue (table[i].id);
+            jassert (handles[i] != nullptr);
+        }
+    }
+
+    float operator[] (Index index) const noexcept       { return handles[(size_t) index]->load (std::memory_order_relaxed); }
+    bool isOn (Index index) const noexcept              { return (*this)[index] > 0.5f; }
+    int getIndex (Index index) const noexcept           { return juce::roundToInt ((*this)[index]); }
+
+    std::atomic<float>& get (Index index) const noexcept { return *handles[(size_t) index]; }
+
+private:
+    static_assert (std::is_enum_v<Index>, "ParameterHandles is indexed by the table's enum class");
+
+    std::array<std::atomic<float>*, size> handles {};
+};
+} // namespace gls
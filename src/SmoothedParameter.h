@@ -0,0 +1,164 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include "ParameterTable.h"
+#include <atomic>
+#include <vector>
+
+namespace gls
+{
+/** A juce::SmoothedValue fed from one cached parameter handle. Call update() once per
+    block; it reads the handle and retargets the ramp.
+
+    While the value is settled, advance() returns nullptr. Callers then use
+    getCurrentValue() as a block constant on their vectorised path, so static parameters
+    cost nothing extra. Only while the value moves does it render per-sample values,
+    which every channel shares. The ramp length is fixed in seconds, so results no longer
+    depend on the host block size. */
+class SmoothedParameter
+{
+public:
+    enum class Mapping
+    {
+        linear,
+        decibels        // the parameter is in dB, the smoothed value is linear gain
+    };
+
+    static constexpr double defaultRampSeconds = 0.02;
+
+    template <typename Index>
+    SmoothedParameter (const ParameterHandles<Index>& handles, Index index, Mapping newMapping = Mapping::linear)
+        : SmoothedParameter (handles.get (index), newMapping)
+    {
+    }
+
+    explicit SmoothedParameter (std::atomic<float>& handle, Mapping newMapping = Mapping::linear)
+        : source (handle), mapping (newMapping)
+    {
+    }
+
+    /** Sizes the ramp for blocks of up to maximumBlockSize and snaps to the parameter. */
+    void prepare (double sampleRate, int maximumBlockSize, double rampSeconds = defaultRampSeconds)
+    {
+        rampLength = rampSeconds;
+        value.reset (sampleRate, rampLength);
+        ramp.assign ((size_t) juce::jmax (1, maximumBlockSize), 0.0f);
+        snap();
+    }
+
+    /** Keeps the ramp length in seconds at a new rate, e.g. when an oversampling factor
+        changes; the value settles at its target. Never allocates. */
+    void setSampleRate (double sampleRate) noexcept     { value.reset (sampleRate, rampLength); }
+
+    /** Jumps straight to the parameter, e.g. when processing resumes after a bypass. */
+    void snap() noexcept                                { value.setCurrentAndTargetValue (read()); }
+
+    /** Block start: picks up the parameter. Returns true while the value is moving. */
+    bool update() noexcept
+    {
+        value.setTargetValue (read());
+        return value.isSmoothing();
+    }
+
+    bool isSmoothing() const noexcept                   { return value.isSmoothing(); }
+    float getCurrentValue() const noexcept              { return value.getCurrentValue(); }
+    float getTargetValue() const noexcept               { return value.getTargetValue(); }
+    int getMaximumBlockSize() const noexcept            { return (int) ramp.size(); }
+
+    /** Moves the ramp on by numSamples without rendering it and returns where it ends
+        up, for callers that ramp block to block themselves. */
+    float skip (int numSamples) noexcept                { return value.skip (numSamples); }
+
+    /** Moves the ramp on by numSamples, which must not exceed getMaximumBlockSize().
+        Returns the per-sample values while it is moving, or nullptr once it is settled. */
+    const float* advance (int numSamples) noexcept
+    {
+        if (! value.isSmoothing())
+            return nullptr;
+
+        jassert (numSamples <= (int) ramp.size());
+        const auto length = juce::jmin (numSamples, (int) ramp.size());
+
+        for (int i = 0; i < length; ++i)
+            ramp[(size_t) i] = value.getNextValue();
+
+        value.skip (numSamples - length);
+        return ramp.data();
+    }
+
+    /** Multiplies every channel by the value: a single vectorised gain when settled. */
+    void applyGain (juce::AudioBuffer<float>& buffer, int numSamples) noexcept
+    {
+        for (int start = 0; start < numSamples;)
+        {
+            if (! value.isSmoothing())
+            {
+                if (value.getCurrentValue() != 1.0f)
+                    buffer.applyGain (start, numSamples - start, value.getCurrentValue());
+
+                return;
+            }
+
+            const auto length = juce::jmin (numSamples - start, (int) ramp.size());
+            const auto* gains = advance (length);
+
+            for (int ch = 0; ch < buffer.getNumChannels(); ++ch)
+                juce::FloatVectorOperations::multiply (buffer.getWritePointer (ch, start), gains, length);
+
+            start += length;
+        }
+    }
+
+    /** wet = dry + (wet - dry) * value, for a 0..1 mix. Leaves wet alone at a settled 1. */
+    void applyMix (juce::AudioBuffer<float>& wet, const juce::AudioBuffer<float>& dry, int numSamples) noexcept
+    {
+        const auto numChannels = juce::jmin (wet.getNumChannels(), dry.getNumChannels());
+
+        for (int start = 0; start < numSamples;)
+        {
+            if (! value.isSmoothing())
+            {
+                const auto amount = value.getCurrentValue();
+                if (amount >= 1.0f)
+                    return;
+
+                for (int ch = 0; ch < numChannels; ++ch)
+                {
+                    auto* out = wet.getWritePointer (ch, start);
+                    juce::FloatVectorOperations::multiply (out, amount, numSamples - start);
+                    juce::FloatVectorOperations::addWithMultiply (out, dry.getReadPointer (ch, start), 1.0f - amount, numSamples - start);
+                }
+
+                return;
+            }
+
+            const auto length = juce::jmin (numSamples - start, (int) ramp.size());
+            const auto* amounts = advance (length);
+
+            for (int ch = 0; ch < numChannels; ++ch)
+            {
+                auto* out = wet.getWritePointer (ch, start);
+                const auto* in = dry.getReadPointer (ch, start);
+
+                for (int i = 0; i < length; ++i)
+                    out[i] = in[i] + (out[i] - in[i]) * amounts[i];
+            }
+
+            start += length;
+        }
+    }
+
+private:
+    float read() const noexcept
+    {
+        const auto raw = source.load (std::memory_order_relaxed);
+        return mapping == Mapping::decibels ? juce::Decibels::decibelsToGain (raw) : raw;
+    }
+
+    std::atomic<float>& source;
+    Mapping mapping;
+    juce::SmoothedValue<float> value;
+    double rampLength = defaultRampSeconds;
+    std::vector<float> ramp = std::vector<float> (1, 0.0f);
+};
+} // namespace gls
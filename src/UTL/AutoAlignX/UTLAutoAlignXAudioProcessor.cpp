@@ -1,25 +1,63 @@
 #include "UTLAutoAlignXAudioProcessor.h"
 
+namespace
+{
+using Param = UTLAutoAlignXAudioProcessor::Param;
+using Spec = gls::ParameterSpec;
+
+constexpr std::array<Spec, (size_t) Param::count> parameterTable {{
+    Spec::range  ("delay_left",   "Delay Left (ms)",  0.0f, UTLAutoAlignXAudioProcessor::maxManualDelayMs, 0.01f, 0.0f),
+    Spec::range  ("delay_right",  "Delay Right (ms)", 0.0f, UTLAutoAlignXAudioProcessor::maxManualDelayMs, 0.01f, 0.0f),
+    Spec::toggle ("invert_left",  "Invert Left",      false),
+    Spec::toggle ("invert_right", "Invert Right",     false),
+    Spec::toggle ("analyze",      "Analyze",          false),
+    Spec::toggle ("auto_align",   "Auto Align",       false)
+}};
+
+static_assert (gls::hasUniqueIds (parameterTable));
+} // namespace
+
 UTLAutoAlignXAudioProcessor::UTLAutoAlignXAudioProcessor()
     : DualPrecisionAudioProcessor (BusesProperties()
                         .withInput  ("Input", juce::AudioChannelSet::stereo(), true)
                         .withOutput ("Output", juce::AudioChannelSet::stereo(), true)),
-      apvts (*this, nullptr, "AUTO_ALIGN_X", createParameterLayout())
+      apvts (*this, nullptr, "AUTO_ALIGN_X", createParameterLayout()),
+      params (apvts, parameterTable)
 {
 }
 
 void UTLAutoAlignXAudioProcessor::prepareToPlay (double sampleRate, int samplesPerBlock)
 {
+    DualPrecisionAudioProcessor::prepareToPlay (sampleRate, samplesPerBlock);
+
     currentSampleRate = sampleRate > 0.0 ? sampleRate : 44100.0;
-    lastBlockSize = (juce::uint32) juce::jmax (1, samplesPerBlock);
-    ensureDelayState (juce::jmax (1, getTotalNumOutputChannels()));
+
+    // Both channels run centringDelay samples late so even sub-sample offsets get a
+    // centred Lagrange kernel; that constant is the plugin's only latency.
+    const auto maxDelaySamples = (int) std::ceil ((maxManualDelayMs + maxMeasuredDelayMs) * 0.001 * currentSampleRate)
+                                 + gls::dsp::FractionalDelayLine::centringDelay;
+
+    channelDelays.resize ((size_t) juce::jmax (1, getTotalNumInputChannels(), getTotalNumOutputChannels()));
+    for (auto& state : channelDelays)
+    {
+        state.delay.prepare (maxDelaySamples);
+        state.delaySamples.reset (currentSampleRate, 0.05);
+        state.polarity.reset (currentSampleRate, 0.01);
+    }
+
+    snapSmoothing = true;
+    setLatencySamples (gls::dsp::FractionalDelayLine::centringDelay);
+
+    estimator.prepare (currentSampleRate, maxMeasuredDelayMs);
+    wasAnalysing = false;
 }
 
 void UTLAutoAlignXAudioProcessor::releaseResources()
 {
+    estimator.stop();
 }
 
-void UTLAutoAlignXAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer,
+void UTLAutoAlignXAudioProcessor::processFloat (juce::AudioBuffer<float>& buffer,
                                                 juce::MidiBuffer&)
 {
     juce::ScopedNoDenormals noDenormals;
@@ -30,88 +68,100 @@ void UTLAutoAlignXAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer
     for (int ch = totalIn; ch < totalOut; ++ch)
         buffer.clear (ch, 0, numSamples);
 
-    const int numChannels = buffer.getNumChannels();
+    const int numChannels = juce::jmin (buffer.getNumChannels(), (int) channelDelays.size());
     if (numChannels == 0 || numSamples == 0)
         return;
 
-    auto get = [this](const char* id) { return apvts.getRawParameterValue (id)->load(); };
+    const float delayLeftMs  = juce::jlimit (0.0f, maxManualDelayMs, params[Param::delayLeft]);
+    const float delayRightMs = juce::jlimit (0.0f, maxManualDelayMs, params[Param::delayRight]);
+    const bool invertLeft    = params.isOn (Param::invertLeft);
+    const bool invertRight   = params.isOn (Param::invertRight);
+    const bool analyse       = params.isOn (Param::analyze) && numChannels >= 2;
+    const bool autoAlign     = params.isOn (Param::autoAlign);
+
+    // The analysis sees the raw inputs, so the measurement does not depend on the
+    // delays currently applied. Only the copy into the estimator's FIFO happens here.
+    if (analyse)
+    {
+        if (! wasAnalysing)
+            estimator.requestReset();
+
+        estimator.push (buffer.getReadPointer (0), buffer.getReadPointer (1), numSamples);
 
-    const float delayLeftMs  = juce::jlimit (0.0f, 20.0f, get ("delay_left"));
-    const float delayRightMs = juce::jlimit (0.0f, 20.0f, get ("delay_right"));
-    const bool invertLeft    = apvts.getRawParameterValue ("invert_left")->load() > 0.5f;
-    const bool invertRight   = apvts.getRawParameterValue ("invert_right")->load() > 0.5f;
+        if (const auto count = estimator.getEstimateCount(); count != lastEstimateCount)
+        {
+            lastEstimateCount = count;
+            measuredDelayMs = estimator.getDelaySamples() * 1000.0f / (float) currentSampleRate;
+            measuredInvert = estimator.isInverted();
+        }
+    }
 
-    ensureDelayState (numChannels);
+    wasAnalysing = analyse;
 
-    const float delayLeftSamples  = delayLeftMs * 0.001f * (float) currentSampleRate;
-    const float delayRightSamples = delayRightMs * 0.001f * (float) currentSampleRate;
+    // A late right channel is matched by delaying the left one, and vice versa.
+    const float measuredSamples = autoAlign ? measuredDelayMs.load() * 0.001f * (float) currentSampleRate : 0.0f;
+    const bool measuredFlip = autoAlign && measuredInvert.load();
+
+    const float baseDelay = (float) gls::dsp::FractionalDelayLine::centringDelay;
+    const float delayLeftSamples  = baseDelay + delayLeftMs * 0.001f * (float) currentSampleRate + juce::jmax (0.0f, measuredSamples);
+    const float delayRightSamples = baseDelay + delayRightMs * 0.001f * (float) currentSampleRate + juce::jmax (0.0f, -measuredSamples);
 
     for (int ch = 0; ch < numChannels; ++ch)
     {
-        auto& delay = channelDelays[ch].delay;
-        const bool invert = (ch == 0 ? invertLeft : invertRight);
+        auto& state = channelDelays[(size_t) ch];
+        const bool invert = (ch == 0 ? invertLeft : (invertRight != measuredFlip));
         const float delaySamples = (ch == 0 ? delayLeftSamples : delayRightSamples);
-        delay.setDelay (delaySamples);
 
-        auto* data = buffer.getWritePointer (ch);
-        for (int i = 0; i < numSamples; ++i)
+        if (snapSmoothing)
         {
-            const float drySample = data[i];
-            const float delayed = delay.popSample (0);
-            delay.pushSample (0, drySample);
-            data[i] = (invert ? -delayed : delayed);
+            state.delaySamples.setCurrentAndTargetValue (delaySamples);
+            state.polarity.setCurrentAndTargetValue (invert ? -1.0f : 1.0f);
         }
+        else
+        {
+            state.delaySamples.setTargetValue (delaySamples);
+            state.polarity.setTargetValue (invert ? -1.0f : 1.0f);
+        }
+
+        auto* data = buffer.getWritePointer (ch);
+        for (int i = 0; i < numSamples; ++i)
+            data[i] = state.delay.process (data[i], state.delaySamples.getNextValue()) * state.polarity.getNextValue();
     }
+
+    snapSmoothing = false;
+}
+
+void UTLAutoAlignXAudioProcessor::updateTail()
+{
+    // The applied offsets beyond the centring delay, which is reported as latency.
+    const auto measuredMs = params.isOn (Param::autoAlign) ? std::abs (measuredDelayMs.load()) : 0.0f;
+    tail.setTail ((juce::jmax (params[Param::delayLeft], params[Param::delayRight]) + measuredMs) * 0.001);
 }
 
 void UTLAutoAlignXAudioProcessor::getStateInformation (juce::MemoryBlock& destData)
 {
     auto state = apvts.copyState();
-        juce::MemoryOutputStream stream (destData, false);
-        state.writeToStream (stream);
+    state.setProperty ("measured_delay_ms", measuredDelayMs.load(), nullptr);
+    state.setProperty ("measured_invert", measuredInvert.load(), nullptr);
+
+    juce::MemoryOutputStream stream (destData, false);
+    state.writeToStream (stream);
 }
 
 void UTLAutoAlignXAudioProcessor::setStateInformation (const void* data, int sizeInBytes)
 {
     if (auto tree = juce::ValueTree::readFromData (data, sizeInBytes); tree.isValid())
+    {
+        measuredDelayMs = juce::jlimit (-maxMeasuredDelayMs, maxMeasuredDelayMs, (float) tree.getProperty ("measured_delay_ms", 0.0f));
+        measuredInvert = (bool) tree.getProperty ("measured_invert", false);
         apvts.replaceState (tree);
+    }
 }
 
 juce::AudioProcessorValueTreeState::ParameterLayout
 UTLAutoAlignXAudioProcessor::createParameterLayout()
 {
-    std::vector<std::unique_ptr<juce::RangedAudioParameter>> params;
-
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("delay_left", "Delay Left (ms)",
-                                                                   juce::NormalisableRange<float> (0.0f, 20.0f, 0.01f), 0.0f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> ("delay_right", "Delay Right (ms)",
-                                                                   juce::NormalisableRange<float> (0.0f, 20.0f, 0.01f), 0.0f));
-    params.push_back (std::make_unique<juce::AudioParameterBool> ("invert_left", "Invert Left", false));
-    params.push_back (std::make_unique<juce::AudioParameterBool> ("invert_right", "Invert Right", false));
-
-    return { params.begin(), params.end() };
-}
-
-void UTLAutoAlignXAudioProcessor::ensureDelayState (int numChannels)
-{
-    if ((int) channelDelays.size() < numChannels)
-        channelDelays.resize ((size_t) numChannels);
-
-    const auto targetBlock = lastBlockSize > 0 ? lastBlockSize : 512u;
-    const bool specChanged = ! juce::approximatelyEqual (delaySpecSampleRate, currentSampleRate)
-                             || delaySpecBlockSize != targetBlock;
-
-    if (specChanged)
-    {
-        juce::dsp::ProcessSpec spec { currentSampleRate, targetBlock, 1 };
-        for (auto& state : channelDelays)
-        {
-            state.delay.prepare (spec);
-            state.delay.reset();
-        }
-        delaySpecSampleRate = currentSampleRate;
-        delaySpecBlockSize  = targetBlock;
-    }
+    return gls::createParameterLayout (parameterTable);
 }
 
 UTLAutoAlignXAudioProcessorEditor::UTLAutoAlignXAudioProcessorEditor (UTLAutoAlignXAudioProcessor& processor)
@@ -121,16 +171,41 @@ UTLAutoAlignXAudioProcessorEditor::UTLAutoAlignXAudioProcessorEditor (UTLAutoAli
     initSlider (delayRightSlider, "Delay R (ms)");
     addAndMakeVisible (invertLeftButton);
     addAndMakeVisible (invertRightButton);
+    addAndMakeVisible (analyzeButton);
+    addAndMakeVisible (autoAlignButton);
     invertLeftButton.setButtonText ("Invert L");
     invertRightButton.setButtonText ("Invert R");
+    analyzeButton.setButtonText ("Analyze");
+    autoAlignButton.setButtonText ("Auto Align");
+
+    measurementLabel.setColour (juce::Label::textColourId, juce::Colours::white);
+    measurementLabel.setJustificationType (juce::Justification::centred);
+    addAndMakeVisible (measurementLabel);
 
     auto& state = processorRef.getValueTreeState();
     sliderAttachments.push_back (std::make_unique<SliderAttachment> (state, "delay_left", delayLeftSlider));
     sliderAttachments.push_back (std::make_unique<SliderAttachment> (state, "delay_right", delayRightSlider));
     buttonAttachments.push_back (std::make_unique<ButtonAttachment> (state, "invert_left", invertLeftButton));
     buttonAttachments.push_back (std::make_unique<ButtonAttachment> (state, "invert_right", invertRightButton));
+    buttonAttachments.push_back (std::make_unique<ButtonAttachment> (state, "analyze", analyzeButton));
+    buttonAttachments.push_back (std::make_unique<ButtonAttachment> (state, "auto_align", autoAlignButton));
+
+    timerCallback();
+    startTimerHz (10);
+    setSize (520, 260);
+}
+
+void UTLAutoAlignXAudioProcessorEditor::timerCallback()
+{
+    const auto delayMs = processorRef.getMeasuredDelayMs();
+    juce::String text ("Measured: R ");
+    text << (delayMs >= 0.0f ? "+" : "") << juce::String (delayMs, 3) << " ms vs L"
+         << (processorRef.isMeasuredInverted() ? ", polarity inverted" : ", polarity matched");
 
-    setSize (520, 200);
+    if (analyzeButton.getToggleState())
+        text << "  (confidence " << juce::roundToInt (processorRef.getAnalysisConfidence() * 100.0f) << "%)";
+
+    measurementLabel.setText (text, juce::dontSendNotification);
 }
 
 void UTLAutoAlignXAudioProcessorEditor::initSlider (juce::Slider& slider, const juce::String& label)
@@ -157,8 +232,15 @@ void UTLAutoAlignXAudioProcessorEditor::resized()
     delayLeftSlider .setBounds (top.removeFromLeft (top.getWidth() / 2).reduced (10));
     delayRightSlider.setBounds (top.reduced (10));
 
-    invertLeftButton .setBounds (area.removeFromLeft (area.getWidth() / 2).reduced (10, 0).removeFromTop (30));
-    invertRightButton.setBounds (area.removeFromTop (30).reduced (10, 0));
+    auto invertRow = area.removeFromTop (30);
+    invertLeftButton .setBounds (invertRow.removeFromLeft (invertRow.getWidth() / 2).reduced (10, 0));
+    invertRightButton.setBounds (invertRow.reduced (10, 0));
+
+    auto analysisRow = area.removeFromTop (30);
+    analyzeButton  .setBounds (analysisRow.removeFromLeft (analysisRow.getWidth() / 2).reduced (10, 0));
+    autoAlignButton.setBounds (analysisRow.reduced (10, 0));
+
+    measurementLabel.setBounds (area.removeFromTop (30));
 }
 
 juce::AudioProcessorEditor* UTLAutoAlignXAudioProcessor::createEditor()
@@ -1,17 +1,29 @@
 #pragma once
 
 #include <JuceHeader.h>
+#include <array>
 #include "../../DualPrecisionAudioProcessor.h"
+#include "../../ParameterTable.h"
+#include "../../dsp/DelayEstimator.h"
+#include "../../dsp/FractionalDelayLine.h"
+#include <atomic>
 
 class UTLAutoAlignXAudioProcessor : public DualPrecisionAudioProcessor
 {
 public:
+    enum class Param
+    {
+        delayLeft, delayRight, invertLeft, invertRight, analyze, autoAlign,
+        count
+    };
+
+    static constexpr float maxManualDelayMs = 20.0f;
+
     UTLAutoAlignXAudioProcessor();
     ~UTLAutoAlignXAudioProcessor() override = default;
 
     void prepareToPlay (double sampleRate, int samplesPerBlock) override;
     void releaseResources() override;
-    void processBlock (juce::AudioBuffer<float>&, juce::MidiBuffer&) override;
 
     juce::AudioProcessorEditor* createEditor() override;
     bool hasEditor() const override { return true; }
@@ -20,12 +32,11 @@ public:
     bool acceptsMidi() const override { return false; }
     bool producesMidi() const override { return false; }
     bool isMidiEffect() const override { return false; }
-    double getTailLengthSeconds() const override { return 0.0; }
 
     int getNumPrograms() override { return 1; }
     int getCurrentProgram() override { return 0; }
     void setCurrentProgram (int) override {}
-    const juce::String getProgramName (int index) override { return index == 0 ? juce::String (JucePlugin_Name \" 01\") : juce::String(); }
+    const juce::String getProgramName (int index) override { return index == 0 ? juce::String (JucePlugin_Name " 01") : juce::String(); }
     void changeProgramName (int, const juce::String&) override {}
 
     void getStateInformation (juce::MemoryBlock& destData) override;
@@ -34,25 +45,42 @@ public:
     juce::AudioProcessorValueTreeState& getValueTreeState() { return apvts; }
     static juce::AudioProcessorValueTreeState::ParameterLayout createParameterLayout();
 
+    /** Latest measured offset: positive when the right channel arrives after the left. */
+    float getMeasuredDelayMs() const noexcept           { return measuredDelayMs.load(); }
+    bool isMeasuredInverted() const noexcept            { return measuredInvert.load(); }
+    float getAnalysisConfidence() const noexcept        { return estimator.getConfidence(); }
+
+protected:
+    void processFloat (juce::AudioBuffer<float>&, juce::MidiBuffer&) override;
+    void updateTail() override;
+
 private:
+    static constexpr float maxMeasuredDelayMs = 20.0f;
+
     struct ChannelDelay
     {
-        juce::dsp::DelayLine<float, juce::dsp::DelayLineInterpolationTypes::Linear> delay { 48000 };
+        gls::dsp::FractionalDelayLine delay;
+        juce::SmoothedValue<float> delaySamples, polarity;
     };
 
     juce::AudioProcessorValueTreeState apvts;
+
+    gls::ParameterHandles<Param> params;
     std::vector<ChannelDelay> channelDelays;
     double currentSampleRate = 44100.0;
-    juce::uint32 lastBlockSize = 512;
-    double delaySpecSampleRate = 0.0;
-    juce::uint32 delaySpecBlockSize = 0;
+    bool snapSmoothing = true;
 
-    void ensureDelayState (int numChannels);
+    gls::dsp::BackgroundDelayEstimator estimator;
+    std::atomic<float> measuredDelayMs { 0.0f };
+    std::atomic<bool> measuredInvert { false };
+    int lastEstimateCount = 0;
+    bool wasAnalysing = false;
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (UTLAutoAlignXAudioProcessor)
 };
 
-class UTLAutoAlignXAudioProcessorEditor : public juce::AudioProcessorEditor
+class UTLAutoAlignXAudioProcessorEditor : public juce::AudioProcessorEditor,
+                                          private juce::Timer
 {
 public:
     explicit UTLAutoAlignXAudioProcessorEditor (UTLAutoAlignXAudioProcessor&);
@@ -62,12 +90,17 @@ public:
     void resized() override;
 
 private:
+    void timerCallback() override;
+
     UTLAutoAlignXAudioProcessor& processorRef;
 
     juce::Slider delayLeftSlider;
     juce::Slider delayRightSlider;
     juce::ToggleButton invertLeftButton;
     juce::ToggleButton invertRightButton;
+    juce::ToggleButton analyzeButton;
+    juce::ToggleButton autoAlignButton;
+    juce::Label measurementLabel;
 
     using SliderAttachment = juce::AudioProcessorValueTreeState::SliderAttachment;
     using ButtonAttachment = juce::AudioProcessorValueTreeState::ButtonAttachment;
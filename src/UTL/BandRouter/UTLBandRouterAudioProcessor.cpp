@@ -19,15 +19,46 @@ constexpr auto kParamInputTrim   = "input_trim";
 constexpr auto kParamOutputTrim  = "output_trim";
 constexpr auto kParamBypass      = "ui_bypass";
 
+using Param = UTLBandRouterAudioProcessor::Param;
+using Spec = gls::ParameterSpec;
+
+constexpr std::array<Spec, (size_t) Param::count> parameterTable {{
+    Spec::range  (kParamLowSplit,   "Low Split",   80.0f,  400.0f,  0.01f,  150.0f,  0.45f),
+    Spec::range  (kParamHighSplit,  "High Split",  600.0f, 6000.0f, 0.01f,  2500.0f, 0.45f),
+    Spec::range  (kParamLowLevel,   "Low Level",   -24.0f, 12.0f,   0.1f,   0.0f),
+    Spec::range  (kParamMidLevel,   "Mid Level",   -24.0f, 12.0f,   0.1f,   0.0f),
+    Spec::range  (kParamHighLevel,  "High Level",  -24.0f, 12.0f,   0.1f,   0.0f),
+    Spec::range  (kParamLowPan,     "Low Pan",     -1.0f,  1.0f,    0.001f, 0.0f),
+    Spec::range  (kParamMidPan,     "Mid Pan",     -1.0f,  1.0f,    0.001f, 0.0f),
+    Spec::range  (kParamHighPan,    "High Pan",    -1.0f,  1.0f,    0.001f, 0.0f),
+    Spec::toggle (kParamSoloLow,    "Solo Low",    false),
+    Spec::toggle (kParamSoloMid,    "Solo Mid",    false),
+    Spec::toggle (kParamSoloHigh,   "Solo High",   false),
+    Spec::range  (kParamMix,        "Mix",         0.0f,   1.0f,    0.001f, 1.0f),
+    Spec::range  (kParamInputTrim,  "Input Trim",  -24.0f, 24.0f,   0.1f,   0.0f),
+    Spec::range  (kParamOutputTrim, "Output Trim", -24.0f, 24.0f,   0.1f,   0.0f),
+    Spec::toggle (kParamBypass,     "Soft Bypass", false)
+}};
+
+static_assert (gls::hasUniqueIds (parameterTable));
+
 class BandEnergyVisualizer : public juce::Component, private juce::Timer
 {
 public:
     BandEnergyVisualizer (UTLBandRouterAudioProcessor& proc, juce::Colour accentColour)
-        : processor (proc), accent (accentColour)
+        : processor (proc), accent (accentColour),
+          spectrum (proc.getSpectrumAnalyser(), accentColour)
     {
+        addAndMakeVisible (spectrum);
         startTimerHz (30);
     }
 
+    void resized() override
+    {
+        auto content = getContentArea();
+        spectrum.setBounds (getSpectrumArea (content).toNearestInt());
+    }
+
     void paint (juce::Graphics& g) override
     {
         auto bounds = getLocalBounds().toFloat().reduced (8.0f);
@@ -36,7 +67,10 @@ public:
         g.setColour (gls::ui::Colours::outline());
         g.drawRoundedRectangle (bounds, 12.0f, 1.5f);
 
-        auto content = bounds.reduced (20.0f);
+        auto content = getContentArea();
+        g.setColour (gls::ui::Colours::grid());
+        g.drawRoundedRectangle (getSpectrumArea (content), 6.0f, 1.4f);
+
         const float totalWidth = content.getWidth();
         const float gap = 12.0f;
         const float barWidth = (totalWidth - (gap * 2.0f)) / 3.0f;
@@ -76,6 +110,18 @@ public:
 private:
     UTLBandRouterAudioProcessor& processor;
     juce::Colour accent;
+    gls::ui::SpectrumView spectrum;
+
+    juce::Rectangle<float> getContentArea() const
+    {
+        return getLocalBounds().toFloat().reduced (28.0f);
+    }
+
+    /** Takes the top of the content area for the output spectrum; the band bars keep the rest. */
+    static juce::Rectangle<float> getSpectrumArea (juce::Rectangle<float>& content)
+    {
+        return content.removeFromTop (content.getHeight() * 0.4f).withTrimmedBottom (12.0f);
+    }
 };
 } // namespace
 
@@ -137,12 +183,16 @@ UTLBandRouterAudioProcessor::UTLBandRouterAudioProcessor()
     : DualPrecisionAudioProcessor (BusesProperties()
                         .withInput  ("Input", juce::AudioChannelSet::stereo(), true)
                         .withOutput ("Output", juce::AudioChannelSet::stereo(), true)),
-      apvts (*this, nullptr, kStateId, createParameterLayout())
+      apvts (*this, nullptr, kStateId, createParameterLayout()),
+      params (apvts, parameterTable)
 {
+    bypass.snapOnResume (dryWet);
 }
 
 void UTLBandRouterAudioProcessor::prepareToPlay (double sampleRate, int samplesPerBlock)
 {
+    DualPrecisionAudioProcessor::prepareToPlay (sampleRate, samplesPerBlock);
+
     currentSampleRate = sampleRate > 0.0 ? sampleRate : 44100.0;
     juce::dsp::ProcessSpec spec { currentSampleRate,
                                   (juce::uint32) juce::jmax (1, samplesPerBlock),
@@ -155,17 +205,26 @@ void UTLBandRouterAudioProcessor::prepareToPlay (double sampleRate, int samplesP
             filter.prepare (spec);
         }
 
-    updateFilters (apvts.getRawParameterValue (kParamLowSplit)->load(),
-                   apvts.getRawParameterValue (kParamHighSplit)->load());
+    for (auto* smoother : { &inputTrimGain, &mixAmount, &outputTrimGain })
+        smoother->prepare (currentSampleRate, samplesPerBlock);
+
+    dryWet.prepare (currentSampleRate, juce::jmax (1, getTotalNumOutputChannels()), samplesPerBlock);
+    bypass.prepare (currentSampleRate, juce::jmax (getTotalNumInputChannels(), getTotalNumOutputChannels()), samplesPerBlock);
+
+    updateFilters (params[Param::lowSplit], params[Param::highSplit]);
+    spectrumAnalyser.prepare (currentSampleRate);
 }
 
 void UTLBandRouterAudioProcessor::releaseResources()
 {
 }
 
-void UTLBandRouterAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer,
-                                                juce::MidiBuffer&)
+void UTLBandRouterAudioProcessor::processFloat (juce::AudioBuffer<float>& buffer,
+                                                juce::MidiBuffer& midi)
 {
+    if (renderInPreparedChunks (buffer, midi))
+        return;
+
     juce::ScopedNoDenormals noDenormals;
 
     const auto totalIn  = getTotalNumInputChannels();
@@ -174,40 +233,30 @@ void UTLBandRouterAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer
     for (int ch = totalIn; ch < totalOut; ++ch)
         buffer.clear (ch, 0, numSamples);
 
-    if (apvts.getRawParameterValue (kParamBypass)->load() > 0.5f)
+    if (! bypass.begin (buffer, numSamples, params.isOn (Param::bypass)))
         return;
 
     const int numChannels = buffer.getNumChannels();
     if (numChannels == 0 || numSamples == 0)
         return;
 
-    auto read = [this](const char* paramId)
-    {
-        return apvts.getRawParameterValue (paramId)->load();
-    };
-
-    const float lowSplit  = read (kParamLowSplit);
-    const float highSplit = read (kParamHighSplit);
+    const float lowSplit  = params[Param::lowSplit];
+    const float highSplit = params[Param::highSplit];
     updateFilters (lowSplit, highSplit);
 
     const auto dbToGain = [](float db) { return juce::Decibels::decibelsToGain (db); };
-    const float lowGain   = dbToGain (read (kParamLowLevel));
-    const float midGain   = dbToGain (read (kParamMidLevel));
-    const float highGain  = dbToGain (read (kParamHighLevel));
-    const float lowPan    = juce::jlimit (-1.0f, 1.0f, read (kParamLowPan));
-    const float midPan    = juce::jlimit (-1.0f, 1.0f, read (kParamMidPan));
-    const float highPan   = juce::jlimit (-1.0f, 1.0f, read (kParamHighPan));
-    const bool soloLow    = read (kParamSoloLow)  > 0.5f;
-    const bool soloMid    = read (kParamSoloMid)  > 0.5f;
-    const bool soloHigh   = read (kParamSoloHigh) > 0.5f;
+    const float lowGain   = dbToGain (params[Param::lowLevel]);
+    const float midGain   = dbToGain (params[Param::midLevel]);
+    const float highGain  = dbToGain (params[Param::highLevel]);
+    const float lowPan    = juce::jlimit (-1.0f, 1.0f, params[Param::lowPan]);
+    const float midPan    = juce::jlimit (-1.0f, 1.0f, params[Param::midPan]);
+    const float highPan   = juce::jlimit (-1.0f, 1.0f, params[Param::highPan]);
+    const bool soloLow    = params.isOn (Param::soloLow);
+    const bool soloMid    = params.isOn (Param::soloMid);
+    const bool soloHigh   = params.isOn (Param::soloHigh);
     const bool anySolo    = soloLow || soloMid || soloHigh;
-    const float mix       = juce::jlimit (0.0f, 1.0f, read (kParamMix));
-    const float inputTrim = dbToGain (read (kParamInputTrim));
-    const float outputTrim= dbToGain (read (kParamOutputTrim));
 
-    buffer.applyGain (inputTrim);
-    dryBuffer.setSize (numChannels, numSamples, false, false, true);
-    dryBuffer.makeCopyOf (buffer, true);
+    dryWet.begin (buffer, numSamples, inputTrimGain, mixAmount);
 
     auto applyPan = [](float pan, float& left, float& right)
     {
@@ -289,18 +338,15 @@ void UTLBandRouterAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer
     smoothMeter (bandMeters[1], juce::jlimit (0.0f, 1.0f, midPeak));
     smoothMeter (bandMeters[2], juce::jlimit (0.0f, 1.0f, highPeak));
 
-    if (mix < 0.999f)
-    {
-        for (int ch = 0; ch < numChannels; ++ch)
-        {
-            auto* wet = buffer.getWritePointer (ch);
-            const auto* dry = dryBuffer.getReadPointer (ch);
-            for (int i = 0; i < numSamples; ++i)
-                wet[i] = wet[i] * mix + dry[i] * (1.0f - mix);
-        }
-    }
+    dryWet.end (buffer, numSamples, mixAmount, outputTrimGain);
+    bypass.end (buffer, numSamples);
+    spectrumAnalyser.push (buffer, numSamples);
+}
 
-    buffer.applyGain (outputTrim);
+void UTLBandRouterAudioProcessor::updateTail()
+{
+    // The band meters blend 15 % of each block's peak, so they fall to the floor over blocks.
+    tail.setTail (0.0, gls::dsp::TailTracker::getEnvelopeRT60 (-getBlockSize() / (std::log (0.85) * currentSampleRate)));
 }
 
 float UTLBandRouterAudioProcessor::getBandMeter (int bandIndex) const noexcept
@@ -328,36 +374,7 @@ void UTLBandRouterAudioProcessor::setStateInformation (const void* data, int siz
 juce::AudioProcessorValueTreeState::ParameterLayout
 UTLBandRouterAudioProcessor::createParameterLayout()
 {
-    std::vector<std::unique_ptr<juce::RangedAudioParameter>> params;
-
-    params.push_back (std::make_unique<juce::AudioParameterFloat> (kParamLowSplit, "Low Split",
-                                                                   juce::NormalisableRange<float> (80.0f, 400.0f, 0.01f, 0.45f), 150.0f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> (kParamHighSplit, "High Split",
-                                                                   juce::NormalisableRange<float> (600.0f, 6000.0f, 0.01f, 0.45f), 2500.0f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> (kParamLowLevel, "Low Level",
-                                                                   juce::NormalisableRange<float> (-24.0f, 12.0f, 0.1f), 0.0f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> (kParamMidLevel, "Mid Level",
-                                                                   juce::NormalisableRange<float> (-24.0f, 12.0f, 0.1f), 0.0f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> (kParamHighLevel, "High Level",
-                                                                   juce::NormalisableRange<float> (-24.0f, 12.0f, 0.1f), 0.0f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> (kParamLowPan, "Low Pan",
-                                                                   juce::NormalisableRange<float> (-1.0f, 1.0f, 0.001f), 0.0f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> (kParamMidPan, "Mid Pan",
-                                                                   juce::NormalisableRange<float> (-1.0f, 1.0f, 0.001f), 0.0f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> (kParamHighPan, "High Pan",
-                                                                   juce::NormalisableRange<float> (-1.0f, 1.0f, 0.001f), 0.0f));
-    params.push_back (std::make_unique<juce::AudioParameterBool>  (kParamSoloLow,  "Solo Low",  false));
-    params.push_back (std::make_unique<juce::AudioParameterBool>  (kParamSoloMid,  "Solo Mid",  false));
-    params.push_back (std::make_unique<juce::AudioParameterBool>  (kParamSoloHigh, "Solo High", false));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> (kParamMix, "Mix",
-                                                                   juce::NormalisableRange<float> (0.0f, 1.0f, 0.001f), 1.0f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> (kParamInputTrim, "Input Trim",
-                                                                   juce::NormalisableRange<float> (-24.0f, 24.0f, 0.1f), 0.0f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> (kParamOutputTrim, "Output Trim",
-                                                                   juce::NormalisableRange<float> (-24.0f, 24.0f, 0.1f), 0.0f));
-    params.push_back (std::make_unique<juce::AudioParameterBool>  (kParamBypass, "Soft Bypass", false));
-
-    return { params.begin(), params.end() };
+    return gls::createParameterLayout (parameterTable);
 }
 
 void UTLBandRouterAudioProcessor::updateFilters (float lowHz, float highHz)
@@ -373,13 +390,10 @@ void UTLBandRouterAudioProcessor::updateFilters (float lowHz, float highHz)
         && juce::approximatelyEqual (safeHigh, currentHighSplit))
         return;
 
-    auto lowCoeffs  = juce::dsp::IIR::Coefficients<float>::makeLowPass (currentSampleRate, safeLow, 0.707f);
-    auto highCoeffs = juce::dsp::IIR::Coefficients<float>::makeHighPass (currentSampleRate, safeHigh, 0.707f);
-
     for (auto& filter : lowFilters)
-        filter.coefficients = lowCoeffs;
+        filter.setLowPass (currentSampleRate, safeLow, 0.707f);
     for (auto& filter : highFilters)
-        filter.coefficients = highCoeffs;
+        filter.setHighPass (currentSampleRate, safeHigh, 0.707f);
 
     currentLowSplit  = safeLow;
     currentHighSplit = safeHigh;
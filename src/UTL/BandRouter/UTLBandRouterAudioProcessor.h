@@ -4,17 +4,30 @@
 #include <array>
 #include <atomic>
 #include "../../DualPrecisionAudioProcessor.h"
+#include "../../ParameterTable.h"
+#include "../../SmoothedParameter.h"
+#include "../../dsp/Biquad.h"
+#include "../../dsp/DryWetStage.h"
+#include "../../dsp/SoftBypass.h"
+#include "../../dsp/SpectrumAnalyser.h"
 #include "../../ui/GoodluckLookAndFeel.h"
+#include "../../ui/SpectrumView.h"
 
 class UTLBandRouterAudioProcessor : public DualPrecisionAudioProcessor
 {
 public:
+    enum class Param
+    {
+        lowSplit, highSplit, lowLevel, midLevel, highLevel, lowPan, midPan, highPan,
+        soloLow, soloMid, soloHigh, mix, inputTrim, outputTrim, bypass,
+        count
+    };
+
     UTLBandRouterAudioProcessor();
     ~UTLBandRouterAudioProcessor() override = default;
 
     void prepareToPlay (double sampleRate, int samplesPerBlock) override;
     void releaseResources() override;
-    void processBlock (juce::AudioBuffer<float>&, juce::MidiBuffer&) override;
 
     juce::AudioProcessorEditor* createEditor() override;
     bool hasEditor() const override { return true; }
@@ -23,7 +36,6 @@ public:
     bool acceptsMidi() const override { return false; }
     bool producesMidi() const override { return false; }
     bool isMidiEffect() const override { return false; }
-    double getTailLengthSeconds() const override { return 0.0; }
 
     int getNumPrograms() override;
     int getCurrentProgram() override { return currentPreset; }
@@ -37,12 +49,23 @@ public:
     juce::AudioProcessorValueTreeState& getValueTreeState() { return apvts; }
     static juce::AudioProcessorValueTreeState::ParameterLayout createParameterLayout();
     float getBandMeter (int bandIndex) const noexcept;
+    gls::dsp::SpectrumAnalyser& getSpectrumAnalyser() noexcept { return spectrumAnalyser; }
+
+protected:
+    void processFloat (juce::AudioBuffer<float>&, juce::MidiBuffer&) override;
+    void updateTail() override;
 
 private:
     juce::AudioProcessorValueTreeState apvts;
-    juce::AudioBuffer<float> dryBuffer;
-    std::array<juce::dsp::IIR::Filter<float>, 2> lowFilters;
-    std::array<juce::dsp::IIR::Filter<float>, 2> highFilters;
+    gls::ParameterHandles<Param> params;
+    gls::SmoothedParameter inputTrimGain  { params, Param::inputTrim,  gls::SmoothedParameter::Mapping::decibels };
+    gls::SmoothedParameter mixAmount      { params, Param::mix };
+    gls::SmoothedParameter outputTrimGain { params, Param::outputTrim, gls::SmoothedParameter::Mapping::decibels };
+    gls::dsp::SpectrumAnalyser spectrumAnalyser;
+    gls::dsp::SoftBypass bypass;
+    gls::dsp::DryWetStage dryWet;
+    std::array<gls::dsp::Biquad, 2> lowFilters;
+    std::array<gls::dsp::Biquad, 2> highFilters;
     double currentSampleRate = 44100.0;
     float currentLowSplit = 150.0f;
     float currentHighSplit = 2500.0f;
@@ -11,6 +11,22 @@ constexpr auto kParamInputTrim    = "input_trim";
 constexpr auto kParamOutputTrim   = "output_trim";
 constexpr auto kParamBypass       = "ui_bypass";
 
+using Param = UTLLatencyLabAudioProcessor::Param;
+using Spec = gls::ParameterSpec;
+
+constexpr std::array<Spec, (size_t) Param::count> parameterTable {{
+    Spec::range  (kParamLatency,      "Latency (ms)",  0.0f,   500.0f,  0.01f,  10.0f,   0.45f),
+    Spec::toggle (kParamPingEnable,   "Ping Enabled",  false),
+    Spec::range  (kParamPingInterval, "Ping Interval", 100.0f, 4000.0f, 0.01f,  1000.0f, 0.45f),
+    Spec::range  (kParamPingLevel,    "Ping Level",    -48.0f, 0.0f,    0.1f,   -12.0f),
+    Spec::range  (kParamMix,          "Mix",           0.0f,   1.0f,    0.001f, 1.0f),
+    Spec::range  (kParamInputTrim,    "Input Trim",    -24.0f, 24.0f,   0.1f,   0.0f),
+    Spec::range  (kParamOutputTrim,   "Output Trim",   -24.0f, 24.0f,   0.1f,   0.0f),
+    Spec::toggle (kParamBypass,       "Soft Bypass",   false)
+}};
+
+static_assert (gls::hasUniqueIds (parameterTable));
+
 class LatencyVisualComponent : public juce::Component, private juce::Timer
 {
 public:
@@ -83,30 +99,47 @@ UTLLatencyLabAudioProcessor::UTLLatencyLabAudioProcessor()
     : DualPrecisionAudioProcessor (BusesProperties()
                         .withInput  ("Input", juce::AudioChannelSet::stereo(), true)
                         .withOutput ("Output", juce::AudioChannelSet::stereo(), true)),
-      apvts (*this, nullptr, "LATENCY_LAB", createParameterLayout())
+      apvts (*this, nullptr, "LATENCY_LAB", createParameterLayout()),
+      params (apvts, parameterTable)
 {
+    bypass.snapOnResume (dryWet);
 }
 
 void UTLLatencyLabAudioProcessor::prepareToPlay (double sampleRate, int samplesPerBlock)
 {
+    DualPrecisionAudioProcessor::prepareToPlay (sampleRate, samplesPerBlock);
+
     currentSampleRate = sampleRate > 0.0 ? sampleRate : 44100.0;
     lastBlockSize = (juce::uint32) juce::jmax (1, samplesPerBlock);
     ensureStateSize (juce::jmax (1, getTotalNumOutputChannels()));
     updateLatency();
 
-    const int defaultInterval = (int) std::round (apvts.getRawParameterValue (kParamPingInterval)->load()
+    const int defaultInterval = (int) std::round (params[Param::pingInterval]
                                                   * 0.001f * currentSampleRate);
     pingIntervalSamples = juce::jmax (1, defaultInterval);
     pingCounterSamples  = pingIntervalSamples;
+
+    const auto numChannels = juce::jmax (getTotalNumInputChannels(), getTotalNumOutputChannels());
+    const auto maximumLatency = (int) std::ceil (maxLatencyMs * 0.001 * currentSampleRate);
+    bypass.prepare (currentSampleRate, numChannels, (int) lastBlockSize, maximumLatency);
+    bypass.setLatency (lastLatencySamples);
+    dryWet.prepare (currentSampleRate, numChannels, (int) lastBlockSize, maximumLatency);
+    dryWet.setLatency (lastLatencySamples);
+
+    for (auto* smoother : { &inputTrimGain, &mixAmount, &outputTrimGain })
+        smoother->prepare (currentSampleRate, (int) lastBlockSize);
 }
 
 void UTLLatencyLabAudioProcessor::releaseResources()
 {
 }
 
-void UTLLatencyLabAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer,
-                                                juce::MidiBuffer&)
+void UTLLatencyLabAudioProcessor::processFloat (juce::AudioBuffer<float>& buffer,
+                                                juce::MidiBuffer& midi)
 {
+    if (renderInPreparedChunks (buffer, midi))
+        return;
+
     juce::ScopedNoDenormals noDenormals;
 
     const auto totalIn  = getTotalNumInputChannels();
@@ -119,22 +152,11 @@ void UTLLatencyLabAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer
     if (numChannels == 0 || numSamples == 0)
         return;
 
-    if (apvts.getRawParameterValue (kParamBypass)->load() > 0.5f)
-        return;
-
     ensureStateSize (numChannels);
 
-    auto read = [this](const char* paramId)
-    {
-        return apvts.getRawParameterValue (paramId)->load();
-    };
-
-    const float latencyMs       = read (kParamLatency);
-    const float mix             = juce::jlimit (0.0f, 1.0f, read (kParamMix));
-    const float inputTrimGain   = juce::Decibels::decibelsToGain (read (kParamInputTrim));
-    const float outputTrimGain  = juce::Decibels::decibelsToGain (read (kParamOutputTrim));
-    const bool pingEnabled      = read (kParamPingEnable) > 0.5f;
-    const float pingIntervalMs  = read (kParamPingInterval);
+    const float latencyMs       = params[Param::latencyMs];
+    const bool pingEnabled      = params.isOn (Param::pingEnable);
+    const float pingIntervalMs  = params[Param::pingInterval];
     pingEnabledFlag.store (pingEnabled);
 
     const int latencySamples = (int) std::round (latencyMs * 0.001f * currentSampleRate);
@@ -143,12 +165,14 @@ void UTLLatencyLabAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer
         lastLatencySamples = latencySamples;
         setLatencySamples (latencySamples);
         for (auto& state : channelDelays)
-        {
             state.delay.reset();
-            state.delay.setDelay ((float) latencySamples);
-        }
     }
 
+    bypass.setLatency (lastLatencySamples);
+    dryWet.setLatency (lastLatencySamples);
+    if (! bypass.begin (buffer, numSamples, params.isOn (Param::bypass)))
+        return;
+
     const int desiredPingSamples = juce::jmax (1, (int) std::round (pingIntervalMs * 0.001f * currentSampleRate));
     if (desiredPingSamples != pingIntervalSamples)
     {
@@ -156,11 +180,9 @@ void UTLLatencyLabAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer
         pingCounterSamples = juce::jmin (pingCounterSamples, pingIntervalSamples);
     }
 
-    pingLevelLinear = juce::Decibels::decibelsToGain (read (kParamPingLevel));
+    pingLevelLinear = juce::Decibels::decibelsToGain (params[Param::pingLevel]);
 
-    buffer.applyGain (inputTrimGain);
-    dryBuffer.setSize (numChannels, numSamples, false, false, true);
-    dryBuffer.makeCopyOf (buffer, true);
+    dryWet.begin (buffer, numSamples, inputTrimGain, mixAmount);
 
     bool pingTriggered = false;
 
@@ -194,30 +216,25 @@ void UTLLatencyLabAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer
         for (int ch = 0; ch < numChannels; ++ch)
         {
             auto& delay = channelDelays[(size_t) ch].delay;
-            const float drySample = dryBuffer.getReadPointer (ch)[sample] + pingSample;
-            const float delayed = delay.popSample (0);
-            delay.pushSample (0, drySample);
-            buffer.getWritePointer (ch)[sample] = delayed;
-        }
-    }
-
-    if (mix < 0.999f)
-    {
-        for (int ch = 0; ch < numChannels; ++ch)
-        {
-            auto* wet = buffer.getWritePointer (ch);
-            const auto* dry = dryBuffer.getReadPointer (ch);
-            for (int i = 0; i < numSamples; ++i)
-                wet[i] = wet[i] * mix + dry[i] * (1.0f - mix);
+            auto* data = buffer.getWritePointer (ch);
+            data[sample] = delay.process (data[sample] + pingSample, (float) lastLatencySamples);
         }
     }
 
-    buffer.applyGain (outputTrimGain);
+    dryWet.end (buffer, numSamples, mixAmount, outputTrimGain);
+    bypass.end (buffer, numSamples);
 
     auto activity = pingActivity.load();
     pingActivity.store (pingTriggered ? 1.0f : activity * 0.92f);
 }
 
+void UTLLatencyLabAudioProcessor::updateTail()
+{
+    // The ping sounds with or without input.
+    const auto pinging = params.isOn (Param::pingEnable) && ! params.isOn (Param::bypass);
+    tail.setTail (pinging ? std::numeric_limits<double>::infinity() : 0.0);
+}
+
 void UTLLatencyLabAudioProcessor::getStateInformation (juce::MemoryBlock& destData)
 {
     auto state = apvts.copyState();
@@ -234,24 +251,7 @@ void UTLLatencyLabAudioProcessor::setStateInformation (const void* data, int siz
 juce::AudioProcessorValueTreeState::ParameterLayout
 UTLLatencyLabAudioProcessor::createParameterLayout()
 {
-    std::vector<std::unique_ptr<juce::RangedAudioParameter>> params;
-
-    params.push_back (std::make_unique<juce::AudioParameterFloat> (kParamLatency, "Latency (ms)",
-                                                                   juce::NormalisableRange<float> (0.0f, 500.0f, 0.01f, 0.45f), 10.0f));
-    params.push_back (std::make_unique<juce::AudioParameterBool>  (kParamPingEnable, "Ping Enabled", false));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> (kParamPingInterval, "Ping Interval",
-                                                                   juce::NormalisableRange<float> (100.0f, 4000.0f, 0.01f, 0.45f), 1000.0f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> (kParamPingLevel, "Ping Level",
-                                                                   juce::NormalisableRange<float> (-48.0f, 0.0f, 0.1f), -12.0f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> (kParamMix, "Mix",
-                                                                   juce::NormalisableRange<float> (0.0f, 1.0f, 0.001f), 1.0f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> (kParamInputTrim, "Input Trim",
-                                                                   juce::NormalisableRange<float> (-24.0f, 24.0f, 0.1f), 0.0f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> (kParamOutputTrim, "Output Trim",
-                                                                   juce::NormalisableRange<float> (-24.0f, 24.0f, 0.1f), 0.0f));
-    params.push_back (std::make_unique<juce::AudioParameterBool>  (kParamBypass, "Soft Bypass", false));
-
-    return { params.begin(), params.end() };
+    return gls::createParameterLayout (parameterTable);
 }
 
 void UTLLatencyLabAudioProcessor::ensureStateSize (int numChannels)
@@ -265,14 +265,8 @@ void UTLLatencyLabAudioProcessor::ensureStateSize (int numChannels)
 
     if (specChanged)
     {
-        juce::dsp::ProcessSpec spec { currentSampleRate,
-                                      targetBlock > 0 ? targetBlock : 512u,
-                                      1 };
         for (auto& state : channelDelays)
-        {
-            state.delay.prepare (spec);
-            state.delay.reset();
-        }
+            state.delay.prepare (currentSampleRate, maxLatencyMs * 0.001);
         delaySpecSampleRate = currentSampleRate;
         delaySpecBlockSize  = targetBlock;
     }
@@ -280,7 +274,7 @@ void UTLLatencyLabAudioProcessor::ensureStateSize (int numChannels)
 
 void UTLLatencyLabAudioProcessor::updateLatency()
 {
-    const float latencyMs = apvts.getRawParameterValue (kParamLatency)->load();
+    const float latencyMs = params[Param::latencyMs];
     lastLatencySamples = (int) std::round (latencyMs * 0.001f * (float) currentSampleRate);
     setLatencySamples (lastLatencySamples);
 }
@@ -15,6 +15,26 @@ constexpr auto kParamInputTrim   = "input_trim";
 constexpr auto kParamOutputTrim  = "output_trim";
 constexpr auto kParamBypass      = "ui_bypass";
 
+using Param = UTLMSMatrixAudioProcessor::Param;
+using Spec = gls::ParameterSpec;
+
+constexpr std::array<Spec, (size_t) Param::count> parameterTable {{
+    Spec::range  (kParamMidGain,    "Mid Gain",    -24.0f,  12.0f,    0.1f,   0.0f),
+    Spec::range  (kParamSideGain,   "Side Gain",   -24.0f,  12.0f,    0.1f,   0.0f),
+    Spec::range  (kParamWidth,      "Width %",     0.0f,    200.0f,   0.01f,  100.0f),
+    Spec::range  (kParamMonoFold,   "Mono Fold",   0.0f,    1.0f,     0.001f, 0.0f),
+    Spec::range  (kParamSideHpf,    "Side HPF",    20.0f,   800.0f,   0.01f,  120.0f,   0.4f),
+    Spec::range  (kParamSideLpf,    "Side LPF",    2000.0f, 20000.0f, 0.01f,  12000.0f, 0.4f),
+    Spec::toggle (kParamPhaseMid,   "Phase Mid",   false),
+    Spec::toggle (kParamPhaseSide,  "Phase Side",  false),
+    Spec::range  (kParamMix,        "Mix",         0.0f,    1.0f,     0.001f, 1.0f),
+    Spec::range  (kParamInputTrim,  "Input Trim",  -24.0f,  24.0f,    0.1f,   0.0f),
+    Spec::range  (kParamOutputTrim, "Output Trim", -24.0f,  24.0f,    0.1f,   0.0f),
+    Spec::toggle (kParamBypass,     "Soft Bypass", false)
+}};
+
+static_assert (gls::hasUniqueIds (parameterTable));
+
 class WidthVisualizer : public juce::Component, private juce::Timer
 {
 public:
@@ -83,12 +103,16 @@ UTLMSMatrixAudioProcessor::UTLMSMatrixAudioProcessor()
     : DualPrecisionAudioProcessor (BusesProperties()
                         .withInput  ("Input", juce::AudioChannelSet::stereo(), true)
                         .withOutput ("Output", juce::AudioChannelSet::stereo(), true)),
-      apvts (*this, nullptr, "MS_MATRIX", createParameterLayout())
+      apvts (*this, nullptr, "MS_MATRIX", createParameterLayout()),
+      params (apvts, parameterTable)
 {
+    bypass.snapOnResume (dryWet);
 }
 
 void UTLMSMatrixAudioProcessor::prepareToPlay (double sampleRate, int samplesPerBlock)
 {
+    DualPrecisionAudioProcessor::prepareToPlay (sampleRate, samplesPerBlock);
+
     currentSampleRate = sampleRate > 0.0 ? sampleRate : 44100.0;
     juce::dsp::ProcessSpec spec { currentSampleRate,
                                   (juce::uint32) juce::jmax (1, samplesPerBlock),
@@ -97,17 +121,25 @@ void UTLMSMatrixAudioProcessor::prepareToPlay (double sampleRate, int samplesPer
     sideLowPass.reset();
     sideHighPass.prepare (spec);
     sideLowPass.prepare (spec);
-    updateFilters (apvts.getRawParameterValue (kParamSideHpf)->load(),
-                   apvts.getRawParameterValue (kParamSideLpf)->load());
+    updateFilters (params[Param::sideHpf], params[Param::sideLpf]);
+
+    for (auto* smoother : { &inputTrimGain, &mixAmount, &outputTrimGain })
+        smoother->prepare (sampleRate, samplesPerBlock);
+
+    dryWet.prepare (sampleRate, juce::jmax (getTotalNumInputChannels(), getTotalNumOutputChannels()), samplesPerBlock);
+    bypass.prepare (sampleRate, juce::jmax (getTotalNumInputChannels(), getTotalNumOutputChannels()), samplesPerBlock);
 }
 
 void UTLMSMatrixAudioProcessor::releaseResources()
 {
 }
 
-void UTLMSMatrixAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer,
-                                              juce::MidiBuffer&)
+void UTLMSMatrixAudioProcessor::processFloat (juce::AudioBuffer<float>& buffer,
+                                              juce::MidiBuffer& midi)
 {
+    if (renderInPreparedChunks (buffer, midi))
+        return;
+
     juce::ScopedNoDenormals noDenormals;
 
     const auto totalIn  = getTotalNumInputChannels();
@@ -116,30 +148,23 @@ void UTLMSMatrixAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer,
     for (int ch = totalIn; ch < totalOut; ++ch)
         buffer.clear (ch, 0, numSamples);
 
-    if (apvts.getRawParameterValue (kParamBypass)->load() > 0.5f)
+    if (! bypass.begin (buffer, numSamples, params.isOn (Param::bypass)))
         return;
 
     const int numChannels = buffer.getNumChannels();
     if (numChannels == 0 || numSamples == 0)
         return;
 
-    auto read = [this](const char* id) { return apvts.getRawParameterValue (id)->load(); };
-
-    const float midGain   = juce::Decibels::decibelsToGain (read (kParamMidGain));
-    const float sideGain  = juce::Decibels::decibelsToGain (read (kParamSideGain));
-    const float width     = juce::jlimit (0.0f, 200.0f, read (kParamWidth)) * 0.01f;
-    const float monoFold  = juce::jlimit (0.0f, 1.0f, read (kParamMonoFold));
-    const bool phaseMid   = read (kParamPhaseMid)  > 0.5f;
-    const bool phaseSide  = read (kParamPhaseSide) > 0.5f;
-    const float mix       = juce::jlimit (0.0f, 1.0f, read (kParamMix));
-    const float inputTrim = juce::Decibels::decibelsToGain (read (kParamInputTrim));
-    const float outputTrim= juce::Decibels::decibelsToGain (read (kParamOutputTrim));
+    const float midGain   = juce::Decibels::decibelsToGain (params[Param::midGain]);
+    const float sideGain  = juce::Decibels::decibelsToGain (params[Param::sideGain]);
+    const float width     = juce::jlimit (0.0f, 200.0f, params[Param::widthPct]) * 0.01f;
+    const float monoFold  = juce::jlimit (0.0f, 1.0f, params[Param::monoFold]);
+    const bool phaseMid   = params.isOn (Param::phaseMid);
+    const bool phaseSide  = params.isOn (Param::phaseSide);
 
-    updateFilters (read (kParamSideHpf), read (kParamSideLpf));
+    updateFilters (params[Param::sideHpf], params[Param::sideLpf]);
 
-    buffer.applyGain (inputTrim);
-    dryBuffer.setSize (numChannels, numSamples, false, false, true);
-    dryBuffer.makeCopyOf (buffer, true);
+    dryWet.begin (buffer, numSamples, inputTrimGain, mixAmount);
 
     auto* left  = buffer.getWritePointer (0);
     auto* right = numChannels > 1 ? buffer.getWritePointer (1) : nullptr;
@@ -194,18 +219,15 @@ void UTLMSMatrixAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer,
     smooth (sideMeter, juce::jlimit (0.0f, 1.0f, sidePeak));
     smooth (widthMeter, widthPeak);
 
-    if (mix < 0.999f)
-    {
-        for (int ch = 0; ch < numChannels; ++ch)
-        {
-            auto* wet = buffer.getWritePointer (ch);
-            const auto* dry = dryBuffer.getReadPointer (ch);
-            for (int sample = 0; sample < numSamples; ++sample)
-                wet[sample] = wet[sample] * mix + dry[sample] * (1.0f - mix);
-        }
-    }
+    dryWet.end (buffer, numSamples, mixAmount, outputTrimGain);
 
-    buffer.applyGain (outputTrim);
+    bypass.end (buffer, numSamples);
+}
+
+void UTLMSMatrixAudioProcessor::updateTail()
+{
+    // The meters blend 15 % of each block's peak, so they fall to the floor over blocks.
+    tail.setTail (0.0, gls::dsp::TailTracker::getEnvelopeRT60 (-getBlockSize() / (std::log (0.85) * currentSampleRate)));
 }
 
 float UTLMSMatrixAudioProcessor::getMidMeter() const noexcept  { return midMeter.load(); }
@@ -228,31 +250,7 @@ void UTLMSMatrixAudioProcessor::setStateInformation (const void* data, int sizeI
 juce::AudioProcessorValueTreeState::ParameterLayout
 UTLMSMatrixAudioProcessor::createParameterLayout()
 {
-    std::vector<std::unique_ptr<juce::RangedAudioParameter>> params;
-
-    params.push_back (std::make_unique<juce::AudioParameterFloat> (kParamMidGain, "Mid Gain",
-                                                                   juce::NormalisableRange<float> (-24.0f, 12.0f, 0.1f), 0.0f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> (kParamSideGain, "Side Gain",
-                                                                   juce::NormalisableRange<float> (-24.0f, 12.0f, 0.1f), 0.0f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> (kParamWidth, "Width %",
-                                                                   juce::NormalisableRange<float> (0.0f, 200.0f, 0.01f), 100.0f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> (kParamMonoFold, "Mono Fold",
-                                                                   juce::NormalisableRange<float> (0.0f, 1.0f, 0.001f), 0.0f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> (kParamSideHpf, "Side HPF",
-                                                                   juce::NormalisableRange<float> (20.0f, 800.0f, 0.01f, 0.4f), 120.0f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> (kParamSideLpf, "Side LPF",
-                                                                   juce::NormalisableRange<float> (2000.0f, 20000.0f, 0.01f, 0.4f), 12000.0f));
-    params.push_back (std::make_unique<juce::AudioParameterBool>  (kParamPhaseMid,  "Phase Mid",  false));
-    params.push_back (std::make_unique<juce::AudioParameterBool>  (kParamPhaseSide, "Phase Side", false));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> (kParamMix, "Mix",
-                                                                   juce::NormalisableRange<float> (0.0f, 1.0f, 0.001f), 1.0f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> (kParamInputTrim, "Input Trim",
-                                                                   juce::NormalisableRange<float> (-24.0f, 24.0f, 0.1f), 0.0f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> (kParamOutputTrim, "Output Trim",
-                                                                   juce::NormalisableRange<float> (-24.0f, 24.0f, 0.1f), 0.0f));
-    params.push_back (std::make_unique<juce::AudioParameterBool>  (kParamBypass, "Soft Bypass", false));
-
-    return { params.begin(), params.end() };
+    return gls::createParameterLayout (parameterTable);
 }
 
 void UTLMSMatrixAudioProcessor::updateFilters (float hpf, float lpf)
@@ -266,10 +264,8 @@ void UTLMSMatrixAudioProcessor::updateFilters (float hpf, float lpf)
         && juce::approximatelyEqual (safeLpf, cachedLpf))
         return;
 
-    auto hpfCoeffs = juce::dsp::IIR::Coefficients<float>::makeHighPass (currentSampleRate, safeHpf, 0.707f);
-    auto lpfCoeffs = juce::dsp::IIR::Coefficients<float>::makeLowPass  (currentSampleRate, safeLpf, 0.707f);
-    sideHighPass.coefficients = hpfCoeffs;
-    sideLowPass.coefficients  = lpfCoeffs;
+    sideHighPass.setHighPass (currentSampleRate, safeHpf, 0.707f);
+    sideLowPass.setLowPass (currentSampleRate, safeLpf, 0.707f);
     cachedHpf = safeHpf;
     cachedLpf = safeLpf;
 }
@@ -14,11 +14,19 @@ class MeterGridVisualComponent : public juce::Component, private juce::Timer
 {
 public:
     MeterGridVisualComponent (UTLMeterGridAudioProcessor& processorRef, juce::Colour accentColour)
-        : processor (processorRef), accent (accentColour)
+        : processor (processorRef), accent (accentColour),
+          spectrum (processorRef.getSpectrumAnalyser(), accentColour)
     {
+        addAndMakeVisible (spectrum);
         startTimerHz (30);
     }
 
+    void resized() override
+    {
+        auto meterArea = getMeterArea();
+        spectrum.setBounds (getSpectrumArea (meterArea).toNearestInt());
+    }
+
     void paint (juce::Graphics& g) override
     {
         auto bounds = getLocalBounds().toFloat().reduced (8.0f);
@@ -37,8 +45,9 @@ public:
             return juce::jlimit (0.0f, 1.0f, (clamped - floorDb) / (0.0f - floorDb));
         };
 
-        auto meterArea = bounds.reduced (24.0f);
-        meterArea.setHeight (meterArea.getHeight() - 40.0f);
+        auto meterArea = getMeterArea();
+        g.setColour (gls::ui::Colours::grid());
+        g.drawRoundedRectangle (getSpectrumArea (meterArea), 6.0f, 1.4f);
 
         const juce::String labels[] { "RMS L", "RMS R", "Peak L", "Peak R" };
         const float values[] { snapshot.rmsLeft, snapshot.rmsRight, snapshot.peakLeft, snapshot.peakRight };
@@ -85,12 +94,41 @@ public:
 private:
     UTLMeterGridAudioProcessor& processor;
     juce::Colour accent;
+    gls::ui::SpectrumView spectrum;
+
+    juce::Rectangle<float> getMeterArea() const
+    {
+        auto area = getLocalBounds().toFloat().reduced (32.0f);
+        area.setHeight (area.getHeight() - 40.0f);
+        return area;
+    }
+
+    /** Takes the right-hand share of the meter area for the output spectrum. */
+    static juce::Rectangle<float> getSpectrumArea (juce::Rectangle<float>& meterArea)
+    {
+        return meterArea.removeFromRight (meterArea.getWidth() * 0.45f).withTrimmedLeft (16.0f);
+    }
 };
 } // namespace
 
 namespace
 {
 constexpr auto kStateId = "METER_GRID";
+
+using Param = UTLMeterGridAudioProcessor::Param;
+using Spec = gls::ParameterSpec;
+
+constexpr std::array<Spec, (size_t) Param::count> parameterTable {{
+    Spec::range  (kParamIntegration, "Integration", 10.0f,  1000.0f, 0.01f, 300.0f,  0.4f),
+    Spec::range  (kParamPeakHold,    "Peak Hold",   50.0f,  4000.0f, 0.01f, 1000.0f, 0.4f),
+    Spec::choice (kParamScalePreset, "Scale",       "Full Scale|K-12|K-14|K-20", 0),
+    Spec::range  (kParamInputTrim,   "Input Trim",  -24.0f, 24.0f,   0.1f,  0.0f),
+    Spec::range  (kParamOutputTrim,  "Output Trim", -24.0f, 24.0f,   0.1f,  0.0f),
+    Spec::toggle (kParamFreeze,      "Freeze",      false),
+    Spec::toggle (kParamBypass,      "Soft Bypass", false)
+}};
+
+static_assert (gls::hasUniqueIds (parameterTable));
 }
 
 const std::array<UTLMeterGridAudioProcessor::Preset, 3> UTLMeterGridAudioProcessor::presetBank {{
@@ -130,24 +168,34 @@ UTLMeterGridAudioProcessor::UTLMeterGridAudioProcessor()
     : DualPrecisionAudioProcessor (BusesProperties()
                         .withInput  ("Input", juce::AudioChannelSet::stereo(), true)
                         .withOutput ("Output", juce::AudioChannelSet::stereo(), true)),
-      apvts (*this, nullptr, kStateId, createParameterLayout())
+      apvts (*this, nullptr, kStateId, createParameterLayout()),
+      params (apvts, parameterTable)
 {
     for (auto& value : meterValues)
         value.store (-60.0f);
     updateScalePreset (0);
+
+    bypass.snapOnResume ({ &inputTrimGain, &outputTrimGain });
 }
 
 void UTLMeterGridAudioProcessor::prepareToPlay (double sampleRate, int samplesPerBlock)
 {
-    juce::ignoreUnused (samplesPerBlock);
+    DualPrecisionAudioProcessor::prepareToPlay (sampleRate, samplesPerBlock);
+
     currentSampleRate = sampleRate > 0.0 ? sampleRate : 44100.0;
+    spectrumAnalyser.prepare (currentSampleRate);
+
+    bypass.prepare (sampleRate, juce::jmax (getTotalNumInputChannels(), getTotalNumOutputChannels()), samplesPerBlock);
+
+    for (auto* smoother : { &inputTrimGain, &outputTrimGain })
+        smoother->prepare (currentSampleRate, samplesPerBlock);
 }
 
 void UTLMeterGridAudioProcessor::releaseResources()
 {
 }
 
-void UTLMeterGridAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer,
+void UTLMeterGridAudioProcessor::processFloat (juce::AudioBuffer<float>& buffer,
                                                juce::MidiBuffer&)
 {
     juce::ScopedNoDenormals noDenormals;
@@ -162,28 +210,24 @@ void UTLMeterGridAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer,
     if (numChannels == 0 || numSamples == 0)
         return;
 
-    const bool bypassed = apvts.getRawParameterValue (kParamBypass)->load() > 0.5f;
-    if (bypassed)
+    const bool bypassed = params.isOn (Param::bypass);
+    if (! bypass.begin (buffer, numSamples, bypassed))
         return;
 
-    auto read = [this](const char* paramId)
-    {
-        return apvts.getRawParameterValue (paramId)->load();
-    };
-
-    const float integrationMs = juce::jlimit (5.0f, 2000.0f, read (kParamIntegration));
-    const float peakHoldMs    = juce::jlimit (20.0f, 4000.0f, read (kParamPeakHold));
-    const int scaleChoice     = (int) std::round (apvts.getRawParameterValue (kParamScalePreset)->load());
-    const bool freezeMeters   = read (kParamFreeze) > 0.5f;
-    const float inputGain     = juce::Decibels::decibelsToGain (read (kParamInputTrim));
-    const float outputGain    = juce::Decibels::decibelsToGain (read (kParamOutputTrim));
+    const float integrationMs = juce::jlimit (5.0f, 2000.0f, params[Param::integrationMs]);
+    const float peakHoldMs    = juce::jlimit (20.0f, 4000.0f, params[Param::peakHoldMs]);
+    const int scaleChoice     = params.getIndex (Param::scalePreset);
+    const bool freezeMeters   = params.isOn (Param::freeze);
 
     updateScalePreset (scaleChoice);
 
     const float integrationCoeff = std::exp (-1.0f / (integrationMs * 0.001f * currentSampleRate));
     const int holdSamples = juce::jmax (1, (int) std::round (peakHoldMs * 0.001f * currentSampleRate));
 
-    buffer.applyGain (inputGain);
+    for (auto* smoother : { &inputTrimGain, &outputTrimGain })
+        smoother->update();
+
+    inputTrimGain.applyGain (buffer, numSamples);
 
     std::array<float, 2> peakInstant { 0.0f, 0.0f };
 
@@ -218,7 +262,10 @@ void UTLMeterGridAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer,
         }
     }
 
-    buffer.applyGain (outputGain);
+    outputTrimGain.applyGain (buffer, numSamples);
+
+    if (! freezeMeters)
+        spectrumAnalyser.push (buffer, numSamples);
 
     auto storeMeter = [this, freezeMeters](int index, float value)
     {
@@ -245,6 +292,19 @@ void UTLMeterGridAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer,
                                                         / (avgRms + 1.0e-6f));
     if (! freezeMeters)
         crestValue.store (crest);
+
+    bypass.end (buffer, numSamples);
+}
+
+void UTLMeterGridAudioProcessor::updateTail()
+{
+    // Let the meters fall to the floor: the peak holds, then decays by 0.995 a sample,
+    // and the RMS integrates power, so its level falls at half the power's rate.
+    const auto holdSeconds = juce::jlimit (20.0f, 4000.0f, params[Param::peakHoldMs]) * 0.001;
+    const auto integrationSeconds = juce::jlimit (5.0f, 2000.0f, params[Param::integrationMs]) * 0.001;
+    const auto peakDecaySeconds = -1.0 / (std::log (0.995) * currentSampleRate);
+    tail.setTail (holdSeconds, juce::jmax (gls::dsp::TailTracker::getEnvelopeRT60 (peakDecaySeconds),
+                                           gls::dsp::TailTracker::getEnvelopeRT60 (2.0 * integrationSeconds)));
 }
 
 void UTLMeterGridAudioProcessor::getStateInformation (juce::MemoryBlock& destData)
@@ -265,22 +325,7 @@ void UTLMeterGridAudioProcessor::setStateInformation (const void* data, int size
 juce::AudioProcessorValueTreeState::ParameterLayout
 UTLMeterGridAudioProcessor::createParameterLayout()
 {
-    std::vector<std::unique_ptr<juce::RangedAudioParameter>> params;
-
-    params.push_back (std::make_unique<juce::AudioParameterFloat> (kParamIntegration, "Integration",
-                                                                   juce::NormalisableRange<float> (10.0f, 1000.0f, 0.01f, 0.4f), 300.0f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> (kParamPeakHold, "Peak Hold",
-                                                                   juce::NormalisableRange<float> (50.0f, 4000.0f, 0.01f, 0.4f), 1000.0f));
-    params.push_back (std::make_unique<juce::AudioParameterChoice> (kParamScalePreset, "Scale",
-                                                                    juce::StringArray { "Full Scale", "K-12", "K-14", "K-20" }, 0));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> (kParamInputTrim, "Input Trim",
-                                                                   juce::NormalisableRange<float> (-24.0f, 24.0f, 0.1f), 0.0f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> (kParamOutputTrim, "Output Trim",
-                                                                   juce::NormalisableRange<float> (-24.0f, 24.0f, 0.1f), 0.0f));
-    params.push_back (std::make_unique<juce::AudioParameterBool>  (kParamFreeze, "Freeze", false));
-    params.push_back (std::make_unique<juce::AudioParameterBool>  (kParamBypass, "Soft Bypass", false));
-
-    return { params.begin(), params.end() };
+    return gls::createParameterLayout (parameterTable);
 }
 
 UTLMeterGridAudioProcessor::MeterSnapshot UTLMeterGridAudioProcessor::getMeterSnapshot() const noexcept
@@ -4,17 +4,27 @@
 #include <array>
 #include <atomic>
 #include "../../DualPrecisionAudioProcessor.h"
+#include "../../ParameterTable.h"
+#include "../../SmoothedParameter.h"
+#include "../../dsp/SoftBypass.h"
+#include "../../dsp/SpectrumAnalyser.h"
 #include "../../ui/GoodluckLookAndFeel.h"
+#include "../../ui/SpectrumView.h"
 
 class UTLMeterGridAudioProcessor : public DualPrecisionAudioProcessor
 {
 public:
+    enum class Param
+    {
+        integrationMs, peakHoldMs, scalePreset, inputTrim, outputTrim, freeze, bypass,
+        count
+    };
+
     UTLMeterGridAudioProcessor();
     ~UTLMeterGridAudioProcessor() override = default;
 
     void prepareToPlay (double sampleRate, int samplesPerBlock) override;
     void releaseResources() override;
-    void processBlock (juce::AudioBuffer<float>&, juce::MidiBuffer&) override;
 
     juce::AudioProcessorEditor* createEditor() override;
     bool hasEditor() const override { return true; }
@@ -23,7 +33,6 @@ public:
     bool acceptsMidi() const override { return false; }
     bool producesMidi() const override { return false; }
     bool isMidiEffect() const override { return false; }
-    double getTailLengthSeconds() const override { return 0.0; }
 
     int getNumPrograms() override;
     int getCurrentProgram() override { return currentPreset; }
@@ -51,9 +60,19 @@ public:
     MeterSnapshot getMeterSnapshot() const noexcept;
     float getDisplayCeilingDb() const noexcept;
     int getScalePresetIndex() const noexcept;
+    gls::dsp::SpectrumAnalyser& getSpectrumAnalyser() noexcept { return spectrumAnalyser; }
+
+protected:
+    void processFloat (juce::AudioBuffer<float>&, juce::MidiBuffer&) override;
+    void updateTail() override;
 
 private:
     juce::AudioProcessorValueTreeState apvts;
+    gls::ParameterHandles<Param> params;
+    gls::SmoothedParameter inputTrimGain  { params, Param::inputTrim,   gls::SmoothedParameter::Mapping::decibels };
+    gls::SmoothedParameter outputTrimGain { params, Param::outputTrim,  gls::SmoothedParameter::Mapping::decibels };
+    gls::dsp::SoftBypass bypass;
+    gls::dsp::SpectrumAnalyser spectrumAnalyser;
 
     std::array<float, 2> rmsState { 0.0f, 0.0f };
     std::array<float, 2> peakHoldValue { 0.0f, 0.0f };
@@ -14,6 +14,24 @@ constexpr auto kParamInputTrim = "input_trim";
 constexpr auto kParamOutputTrim= "output_trim";
 constexpr auto kParamBypass    = "ui_bypass";
 
+using Param = UTLNoiseGenLabAudioProcessor::Param;
+using Spec = gls::ParameterSpec;
+
+constexpr std::array<Spec, (size_t) Param::count> parameterTable {{
+    Spec::choice (kParamColour,     "Noise Color",     "White|Pink|Brown", 0),
+    Spec::range  (kParamLevel,      "Noise Level",     -60.0f,  6.0f,     0.01f,  -24.0f),
+    Spec::range  (kParamMix,        "Mix",             0.0f,    1.0f,     0.001f, 0.5f),
+    Spec::range  (kParamDensity,    "Density",         0.0f,    1.0f,     0.001f, 0.5f),
+    Spec::range  (kParamLowCut,     "Low Cut",         20.0f,   4000.0f,  0.01f,  120.0f,   0.4f),
+    Spec::range  (kParamHighCut,    "High Cut",        1000.0f, 20000.0f, 0.01f,  12000.0f, 0.4f),
+    Spec::range  (kParamStereoVar,  "Stereo Variance", 0.0f,    1.0f,     0.001f, 0.35f),
+    Spec::range  (kParamInputTrim,  "Input Trim",      -24.0f,  24.0f,    0.1f,   0.0f),
+    Spec::range  (kParamOutputTrim, "Output Trim",     -24.0f,  24.0f,    0.1f,   0.0f),
+    Spec::toggle (kParamBypass,     "Soft Bypass",     false)
+}};
+
+static_assert (gls::hasUniqueIds (parameterTable));
+
 inline int normalisedSamples (double sampleRate, float seconds)
 {
     return juce::jmax (8, (int) std::round (seconds * sampleRate));
@@ -73,7 +91,8 @@ UTLNoiseGenLabAudioProcessor::UTLNoiseGenLabAudioProcessor()
     : DualPrecisionAudioProcessor (BusesProperties()
                         .withInput  ("Input", juce::AudioChannelSet::stereo(), true)
                         .withOutput ("Output", juce::AudioChannelSet::stereo(), true)),
-      apvts (*this, nullptr, kStateId, createParameterLayout())
+      apvts (*this, nullptr, kStateId, createParameterLayout()),
+      params (apvts, parameterTable)
 {
     for (auto& env : burstEnvelopes)
     {
@@ -83,10 +102,14 @@ UTLNoiseGenLabAudioProcessor::UTLNoiseGenLabAudioProcessor()
 
     for (auto& counter : burstCounters)
         counter = 1;
+
+    bypass.snapOnResume ({ &inputTrimGain, &mixAmount, &outputTrimGain });
 }
 
 void UTLNoiseGenLabAudioProcessor::prepareToPlay (double sampleRate, int samplesPerBlock)
 {
+    DualPrecisionAudioProcessor::prepareToPlay (sampleRate, samplesPerBlock);
+
     currentSampleRate = sampleRate > 0.0 ? sampleRate : 44100.0;
     lastBlockSize = (juce::uint32) juce::jmax (1, samplesPerBlock);
 
@@ -108,17 +131,24 @@ void UTLNoiseGenLabAudioProcessor::prepareToPlay (double sampleRate, int samples
     for (auto& counter : burstCounters)
         counter = 1;
 
-    updateFilters (apvts.getRawParameterValue (kParamLowCut)->load(),
-                   apvts.getRawParameterValue (kParamHighCut)->load());
+    updateFilters (params[Param::lowCut], params[Param::highCut]);
+
+    bypass.prepare (sampleRate, juce::jmax (getTotalNumInputChannels(), getTotalNumOutputChannels()), samplesPerBlock);
+
+    for (auto* smoother : { &inputTrimGain, &mixAmount, &outputTrimGain })
+        smoother->prepare (currentSampleRate, (int) lastBlockSize);
 }
 
 void UTLNoiseGenLabAudioProcessor::releaseResources()
 {
 }
 
-void UTLNoiseGenLabAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer,
-                                                 juce::MidiBuffer&)
+void UTLNoiseGenLabAudioProcessor::processFloat (juce::AudioBuffer<float>& buffer,
+                                                 juce::MidiBuffer& midi)
 {
+    if (renderInPreparedChunks (buffer, midi))
+        return;
+
     juce::ScopedNoDenormals noDenormals;
 
     const int totalIn  = getTotalNumInputChannels();
@@ -131,31 +161,31 @@ void UTLNoiseGenLabAudioProcessor::processBlock (juce::AudioBuffer<float>& buffe
     if (numChannels == 0 || numSamples == 0)
         return;
 
-    if (apvts.getRawParameterValue (kParamBypass)->load() > 0.5f)
+    if (! bypass.begin (buffer, numSamples, params.isOn (Param::bypass)))
         return;
 
-    auto get = [this](const char* id) { return apvts.getRawParameterValue (id)->load(); };
-
-    const float noiseLevelDb = get (kParamLevel);
-    const float mix          = juce::jlimit (0.0f, 1.0f, get (kParamMix));
-    const float density      = juce::jlimit (0.0f, 1.0f, get (kParamDensity));
-    const float stereoVar    = juce::jlimit (0.0f, 1.0f, get (kParamStereoVar));
-    const int noiseMode      = (int) std::round (get (kParamColour));
-    const float lowCut       = get (kParamLowCut);
-    const float highCut      = get (kParamHighCut);
-    const float inputTrim    = juce::Decibels::decibelsToGain (get (kParamInputTrim));
-    const float outputTrim   = juce::Decibels::decibelsToGain (get (kParamOutputTrim));
+    const float noiseLevelDb = params[Param::noiseLevel];
+    const float density      = juce::jlimit (0.0f, 1.0f, params[Param::density]);
+    const float stereoVar    = juce::jlimit (0.0f, 1.0f, params[Param::stereoVar]);
+    const int noiseMode      = params.getIndex (Param::noiseColor);
+    const float lowCut       = params[Param::lowCut];
+    const float highCut      = params[Param::highCut];
 
     if (std::abs (lowCut - lastLowCut) > 0.5f || std::abs (highCut - lastHighCut) > 0.5f)
         updateFilters (lowCut, highCut);
 
-    buffer.applyGain (inputTrim);
-    dryBuffer.setSize (numChannels, numSamples, false, false, true);
-    dryBuffer.makeCopyOf (buffer, true);
-
+    // dry * (1 - mix) + (dry + noise) * mix is just dry + noise * mix, so the buffer is
+    // its own dry copy and both trims fold into the one write per sample.
     const float noiseGain = juce::Decibels::decibelsToGain (noiseLevelDb);
-    const float dryGain = 1.0f - mix;
-    const float wetGain = mix;
+    for (auto* smoother : { &inputTrimGain, &mixAmount, &outputTrimGain })
+        smoother->update();
+
+    const auto* inputTrims  = inputTrimGain.advance (numSamples);
+    const auto* mixes       = mixAmount.advance (numSamples);
+    const auto* outputTrims = outputTrimGain.advance (numSamples);
+    const auto moving = inputTrims != nullptr || mixes != nullptr || outputTrims != nullptr;
+    float dryGain = inputTrimGain.getCurrentValue() * outputTrimGain.getCurrentValue();
+    float wetGain = mixAmount.getCurrentValue() * outputTrimGain.getCurrentValue();
 
     float runningEnergy = 0.0f;
 
@@ -163,12 +193,19 @@ void UTLNoiseGenLabAudioProcessor::processBlock (juce::AudioBuffer<float>& buffe
     {
         refreshBurstTargets (density, stereoVar);
 
+        if (moving)
+        {
+            const auto outputTrim = outputTrims != nullptr ? outputTrims[sample] : outputTrimGain.getCurrentValue();
+            dryGain = (inputTrims != nullptr ? inputTrims[sample] : inputTrimGain.getCurrentValue()) * outputTrim;
+            wetGain = (mixes != nullptr ? mixes[sample] : mixAmount.getCurrentValue()) * outputTrim;
+        }
+
         for (int ch = 0; ch < numChannels; ++ch)
         {
             const int filterIndex = juce::jlimit (0, (int) lowPassFilters.size() - 1, ch);
             const int envIndex = juce::jlimit (0, (int) burstEnvelopes.size() - 1, ch);
 
-            const float dry = dryBuffer.getSample (ch, sample);
+            const float dry = buffer.getSample (ch, sample);
             float noise = generateNoise (filterIndex, noiseMode, stereoVar);
 
             noise = highPassFilters[(size_t) filterIndex].processSample (noise);
@@ -176,18 +213,24 @@ void UTLNoiseGenLabAudioProcessor::processBlock (juce::AudioBuffer<float>& buffe
 
             const float env = burstEnvelopes[(size_t) envIndex].getNextValue();
             const float injected = noise * env * noiseGain;
-            const float wet = dry + injected;
 
-            buffer.setSample (ch, sample, dryGain * dry + wetGain * wet);
+            buffer.setSample (ch, sample, dryGain * dry + wetGain * injected);
             runningEnergy += std::abs (injected);
         }
     }
 
-    buffer.applyGain (outputTrim);
-
     const float averageEnergy = runningEnergy / (float) (numSamples * juce::jmax (1, numChannels));
     const float smoothed = noiseMeter.load() * 0.85f + juce::jlimit (0.0f, 1.0f, averageEnergy) * 0.15f;
     noiseMeter.store (smoothed);
+
+    bypass.end (buffer, numSamples);
+}
+
+void UTLNoiseGenLabAudioProcessor::updateTail()
+{
+    // The noise is injected with or without input.
+    const auto generating = params[Param::mix] > 0.0f && ! params.isOn (Param::bypass);
+    tail.setTail (generating ? std::numeric_limits<double>::infinity() : 0.0);
 }
 
 void UTLNoiseGenLabAudioProcessor::updateFilters (float lowCutHz, float highCutHz)
@@ -198,14 +241,11 @@ void UTLNoiseGenLabAudioProcessor::updateFilters (float lowCutHz, float highCutH
     if (currentSampleRate <= 0.0)
         return;
 
-    auto hp = juce::dsp::IIR::Coefficients<float>::makeHighPass (currentSampleRate, lastLowCut, 0.707f);
-    auto lp = juce::dsp::IIR::Coefficients<float>::makeLowPass (currentSampleRate, lastHighCut, 0.707f);
-
     for (auto& filter : highPassFilters)
-        filter.coefficients = hp;
+        filter.setHighPass (currentSampleRate, lastLowCut, 0.707f);
 
     for (auto& filter : lowPassFilters)
-        filter.coefficients = lp;
+        filter.setLowPass (currentSampleRate, lastHighCut, 0.707f);
 }
 
 float UTLNoiseGenLabAudioProcessor::generateNoise (int channel, int noiseMode, float stereoVariance)
@@ -259,29 +299,7 @@ void UTLNoiseGenLabAudioProcessor::refreshBurstTargets (float density, float ste
 juce::AudioProcessorValueTreeState::ParameterLayout
 UTLNoiseGenLabAudioProcessor::createParameterLayout()
 {
-    std::vector<std::unique_ptr<juce::RangedAudioParameter>> params;
-
-    params.push_back (std::make_unique<juce::AudioParameterChoice> (kParamColour, "Noise Color",
-                                                                    juce::StringArray { "White", "Pink", "Brown" }, 0));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> (kParamLevel, "Noise Level",
-                                                                   juce::NormalisableRange<float> (-60.0f, 6.0f, 0.01f), -24.0f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> (kParamMix, "Mix",
-                                                                   juce::NormalisableRange<float> (0.0f, 1.0f, 0.001f), 0.5f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> (kParamDensity, "Density",
-                                                                   juce::NormalisableRange<float> (0.0f, 1.0f, 0.001f), 0.5f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> (kParamLowCut, "Low Cut",
-                                                                   juce::NormalisableRange<float> (20.0f, 4000.0f, 0.01f, 0.4f), 120.0f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> (kParamHighCut, "High Cut",
-                                                                   juce::NormalisableRange<float> (1000.0f, 20000.0f, 0.01f, 0.4f), 12000.0f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> (kParamStereoVar, "Stereo Variance",
-                                                                   juce::NormalisableRange<float> (0.0f, 1.0f, 0.001f), 0.35f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> (kParamInputTrim, "Input Trim",
-                                                                   juce::NormalisableRange<float> (-24.0f, 24.0f, 0.1f), 0.0f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> (kParamOutputTrim, "Output Trim",
-                                                                   juce::NormalisableRange<float> (-24.0f, 24.0f, 0.1f), 0.0f));
-    params.push_back (std::make_unique<juce::AudioParameterBool>  (kParamBypass, "Soft Bypass", false));
-
-    return { params.begin(), params.end() };
+    return gls::createParameterLayout (parameterTable);
 }
 
 UTLNoiseGenLabAudioProcessorEditor::UTLNoiseGenLabAudioProcessorEditor (UTLNoiseGenLabAudioProcessor& processor)
@@ -4,23 +4,32 @@
 #include <array>
 #include <atomic>
 #include "../../DualPrecisionAudioProcessor.h"
+#include "../../ParameterTable.h"
+#include "../../SmoothedParameter.h"
+#include "../../dsp/Biquad.h"
+#include "../../dsp/SoftBypass.h"
 #include "../../ui/GoodluckLookAndFeel.h"
 
 class UTLNoiseGenLabAudioProcessor : public DualPrecisionAudioProcessor
 {
 public:
+    enum class Param
+    {
+        noiseColor, noiseLevel, mix, density, lowCut, highCut, stereoVar, inputTrim,
+        outputTrim, bypass,
+        count
+    };
+
     UTLNoiseGenLabAudioProcessor();
     ~UTLNoiseGenLabAudioProcessor() override = default;
 
     void prepareToPlay (double sampleRate, int samplesPerBlock) override;
     void releaseResources() override;
-    void processBlock (juce::AudioBuffer<float>&, juce::MidiBuffer&) override;
 
     const juce::String getName() const override { return "UTLNoiseGenLab"; }
     bool acceptsMidi() const override { return false; }
     bool producesMidi() const override { return false; }
     bool isMidiEffect() const override { return false; }
-    double getTailLengthSeconds() const override { return 0.0; }
 
     int getNumPrograms() override { return 1; }
     int getCurrentProgram() override { return 0; }
@@ -38,9 +47,17 @@ public:
     static juce::AudioProcessorValueTreeState::ParameterLayout createParameterLayout();
     float getNoiseMeter() const noexcept { return noiseMeter.load(); }
 
+protected:
+    void processFloat (juce::AudioBuffer<float>&, juce::MidiBuffer&) override;
+    void updateTail() override;
+
 private:
     juce::AudioProcessorValueTreeState apvts;
-    juce::AudioBuffer<float> dryBuffer;
+    gls::ParameterHandles<Param> params;
+    gls::SmoothedParameter inputTrimGain  { params, Param::inputTrim,   gls::SmoothedParameter::Mapping::decibels };
+    gls::SmoothedParameter mixAmount      { params, Param::mix };
+    gls::SmoothedParameter outputTrimGain { params, Param::outputTrim,  gls::SmoothedParameter::Mapping::decibels };
+    gls::dsp::SoftBypass bypass;
 
     struct NoiseState
     {
@@ -49,8 +66,8 @@ private:
     };
 
     std::array<NoiseState, 2> noiseStates{};
-    std::array<juce::dsp::IIR::Filter<float>, 2> lowPassFilters;
-    std::array<juce::dsp::IIR::Filter<float>, 2> highPassFilters;
+    std::array<gls::dsp::Biquad, 2> lowPassFilters;
+    std::array<gls::dsp::Biquad, 2> highPassFilters;
     std::array<juce::LinearSmoothedValue<float>, 2> burstEnvelopes;
     std::array<int, 2> burstCounters{};
 
@@ -14,6 +14,24 @@ constexpr auto kParamInputTrim= "input_trim";
 constexpr auto kParamOutputTrim= "output_trim";
 constexpr auto kParamBypass   = "ui_bypass";
 
+using Param = UTLPhaseOrbAudioProcessor::Param;
+using Spec = gls::ParameterSpec;
+
+constexpr std::array<Spec, (size_t) Param::count> parameterTable {{
+    Spec::range  (kParamWidth,      "Width",       0.0f,    2.5f,   0.001f, 1.0f),
+    Spec::range  (kParamPhase,      "Phase Shift", -180.0f, 180.0f, 0.1f,   0.0f),
+    Spec::range  (kParamRate,       "Orb Rate",    0.05f,   5.0f,   0.001f, 0.35f, 0.4f),
+    Spec::range  (kParamDepth,      "Orb Depth",   0.0f,    1.0f,   0.001f, 0.45f),
+    Spec::range  (kParamTilt,       "Tilt",        -12.0f,  12.0f,  0.1f,   0.0f),
+    Spec::range  (kParamMix,        "Mix",         0.0f,    1.0f,   0.001f, 0.85f),
+    Spec::range  (kParamOutput,     "Output Gain", -12.0f,  6.0f,   0.01f,  0.0f),
+    Spec::range  (kParamInputTrim,  "Input Trim",  -24.0f,  24.0f,  0.1f,   0.0f),
+    Spec::range  (kParamOutputTrim, "Output Trim", -24.0f,  24.0f,  0.1f,   0.0f),
+    Spec::toggle (kParamBypass,     "Soft Bypass", false)
+}};
+
+static_assert (gls::hasUniqueIds (parameterTable));
+
 inline float degreesToRadians (float degrees)
 {
     return degrees * juce::MathConstants<float>::pi / 180.0f;
@@ -72,24 +90,36 @@ UTLPhaseOrbAudioProcessor::UTLPhaseOrbAudioProcessor()
     : DualPrecisionAudioProcessor (BusesProperties()
                         .withInput  ("Input", juce::AudioChannelSet::stereo(), true)
                         .withOutput ("Output", juce::AudioChannelSet::stereo(), true)),
-      apvts (*this, nullptr, kStateId, createParameterLayout())
+      apvts (*this, nullptr, kStateId, createParameterLayout()),
+      params (apvts, parameterTable)
 {
+    bypass.snapOnResume ({ &inputTrimGain, &mixAmount, &wetOutputGain, &outputTrimGain });
 }
 
 void UTLPhaseOrbAudioProcessor::prepareToPlay (double sampleRate, int samplesPerBlock)
 {
+    DualPrecisionAudioProcessor::prepareToPlay (sampleRate, samplesPerBlock);
+
     currentSampleRate = sampleRate > 0.0 ? sampleRate : 44100.0;
     lastBlockSize = (juce::uint32) juce::jmax (1, samplesPerBlock);
     lfoPhase = 0.0;
+
+    bypass.prepare (sampleRate, juce::jmax (getTotalNumInputChannels(), getTotalNumOutputChannels()), samplesPerBlock);
+
+    for (auto* smoother : { &inputTrimGain, &mixAmount, &wetOutputGain, &outputTrimGain })
+        smoother->prepare (currentSampleRate, (int) lastBlockSize);
 }
 
 void UTLPhaseOrbAudioProcessor::releaseResources()
 {
 }
 
-void UTLPhaseOrbAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer,
-                                              juce::MidiBuffer&)
+void UTLPhaseOrbAudioProcessor::processFloat (juce::AudioBuffer<float>& buffer,
+                                              juce::MidiBuffer& midi)
 {
+    if (renderInPreparedChunks (buffer, midi))
+        return;
+
     juce::ScopedNoDenormals noDenormals;
 
     const int totalIn  = getTotalNumInputChannels();
@@ -102,22 +132,21 @@ void UTLPhaseOrbAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer,
     if (numChannels == 0 || numSamples == 0)
         return;
 
-    if (apvts.getRawParameterValue (kParamBypass)->load() > 0.5f)
+    if (! bypass.begin (buffer, numSamples, params.isOn (Param::bypass)))
         return;
 
-    auto get = [this](const char* id) { return apvts.getRawParameterValue (id)->load(); };
+    const float width      = juce::jlimit (0.0f, 2.5f, params[Param::width]);
+    const float tiltDb     = juce::jlimit (-12.0f, 12.0f, params[Param::tilt]);
+    const float basePhase  = degreesToRadians (juce::jlimit (-180.0f, 180.0f, params[Param::phaseShift]));
+    const float orbRate    = juce::jlimit (0.05f, 5.0f, params[Param::orbRate]);
+    const float orbDepth   = juce::jlimit (0.0f, 1.0f, params[Param::orbDepth]);
 
-    const float width      = juce::jlimit (0.0f, 2.5f, get (kParamWidth));
-    const float mix        = juce::jlimit (0.0f, 1.0f, get (kParamMix));
-    const float tiltDb     = juce::jlimit (-12.0f, 12.0f, get (kParamTilt));
-    const float basePhase  = degreesToRadians (juce::jlimit (-180.0f, 180.0f, get (kParamPhase)));
-    const float orbRate    = juce::jlimit (0.05f, 5.0f, get (kParamRate));
-    const float orbDepth   = juce::jlimit (0.0f, 1.0f, get (kParamDepth));
-    const float outputGain = juce::Decibels::decibelsToGain (juce::jlimit (-12.0f, 6.0f, get (kParamOutput)));
-    const float inputTrim  = juce::Decibels::decibelsToGain (get (kParamInputTrim));
-    const float outputTrim = juce::Decibels::decibelsToGain (get (kParamOutputTrim));
+    for (auto* smoother : { &inputTrimGain, &mixAmount, &wetOutputGain, &outputTrimGain })
+        smoother->update();
 
-    buffer.applyGain (inputTrim);
+    inputTrimGain.applyGain (buffer, numSamples);
+    const auto* mixes = mixAmount.advance (numSamples);
+    const auto* outputGains = wetOutputGain.advance (numSamples);
 
     const double depthRadians = orbDepth * juce::MathConstants<double>::pi * 0.95;
     const double twoPi = juce::MathConstants<double>::twoPi;
@@ -125,7 +154,6 @@ void UTLPhaseOrbAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer,
 
     const float sideGain = juce::Decibels::decibelsToGain (tiltDb * 0.5f) * width;
     const float midGain  = juce::Decibels::decibelsToGain (-tiltDb * 0.5f);
-    const float dryGain  = 1.0f - mix;
 
     const bool hasStereo = numChannels > 1;
 
@@ -151,6 +179,10 @@ void UTLPhaseOrbAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer,
         const float rotatedMid  = mid * cosPhase - side * sinPhase;
         const float rotatedSide = mid * sinPhase + side * cosPhase;
 
+        const float mix = mixes != nullptr ? mixes[sample] : mixAmount.getCurrentValue();
+        const float outputGain = outputGains != nullptr ? outputGains[sample] : wetOutputGain.getCurrentValue();
+        const float dryGain = 1.0f - mix;
+
         const float wetLeft  = (rotatedMid + rotatedSide) * outputGain;
         const float wetRight = (rotatedMid - rotatedSide) * outputGain;
 
@@ -160,35 +192,15 @@ void UTLPhaseOrbAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer,
             buffer.setSample (1, sample, dryGain * rightIn + mix * wetRight);
     }
 
-    buffer.applyGain (outputTrim);
+    outputTrimGain.applyGain (buffer, numSamples);
+
+    bypass.end (buffer, numSamples);
 }
 
 juce::AudioProcessorValueTreeState::ParameterLayout
 UTLPhaseOrbAudioProcessor::createParameterLayout()
 {
-    std::vector<std::unique_ptr<juce::RangedAudioParameter>> params;
-
-    params.push_back (std::make_unique<juce::AudioParameterFloat> (kParamWidth, "Width",
-                                                                   juce::NormalisableRange<float> (0.0f, 2.5f, 0.001f), 1.0f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> (kParamPhase, "Phase Shift",
-                                                                   juce::NormalisableRange<float> (-180.0f, 180.0f, 0.1f), 0.0f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> (kParamRate, "Orb Rate",
-                                                                   juce::NormalisableRange<float> (0.05f, 5.0f, 0.001f, 0.4f), 0.35f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> (kParamDepth, "Orb Depth",
-                                                                   juce::NormalisableRange<float> (0.0f, 1.0f, 0.001f), 0.45f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> (kParamTilt, "Tilt",
-                                                                   juce::NormalisableRange<float> (-12.0f, 12.0f, 0.1f), 0.0f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> (kParamMix, "Mix",
-                                                                   juce::NormalisableRange<float> (0.0f, 1.0f, 0.001f), 0.85f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> (kParamOutput, "Output Gain",
-                                                                   juce::NormalisableRange<float> (-12.0f, 6.0f, 0.01f), 0.0f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> (kParamInputTrim, "Input Trim",
-                                                                   juce::NormalisableRange<float> (-24.0f, 24.0f, 0.1f), 0.0f));
-    params.push_back (std::make_unique<juce::AudioParameterFloat> (kParamOutputTrim, "Output Trim",
-                                                                   juce::NormalisableRange<float> (-24.0f, 24.0f, 0.1f), 0.0f));
-    params.push_back (std::make_unique<juce::AudioParameterBool>  (kParamBypass, "Soft Bypass", false));
-
-    return { params.begin(), params.end() };
+    return gls::createParameterLayout (parameterTable);
 }
 
 UTLPhaseOrbAudioProcessorEditor::UTLPhaseOrbAudioProcessorEditor (UTLPhaseOrbAudioProcessor& processor)
@@ -12,33 +12,62 @@ constexpr auto kParamOutputTrim  = "output_trim";
 constexpr auto kParamBypass      = "ui_bypass";
 constexpr const char* kTapLabelProps[]  = { "tap_label_0", "tap_label_1", "tap_label_2", "tap_label_3" };
 constexpr const char* kTapPresetProps[] = { "tap_preset_0", "tap_preset_1", "tap_preset_2" };
+
+using Param = UTLSignalTracerAudioProcessor::Param;
+using Spec = gls::ParameterSpec;
+
+constexpr std::array<Spec, (size_t) Param::count> parameterTable {{
+    Spec::choice (kParamTapSelect,   "Tap Select",      "Input|Pre|Post|Side",               0),
+    Spec::choice (kParamPhaseView,   "Phase View",      "Lissajous|Correlation|Vectorscope", 0),
+    Spec::toggle (kParamPeakHold,    "Peak Hold",       false),
+    Spec::range  (kParamRmsWindow,   "RMS Window (ms)", 5.0f,   500.0f, 0.1f, 50.0f, 0.4f),
+    Spec::choice (kParamRoutingMode, "Routing Mode",    "Stereo|Mid/Side|Solo Tap",          0),
+    Spec::range  (kParamInputTrim,   "Input Trim",      -24.0f, 24.0f,  0.1f, 0.0f),
+    Spec::range  (kParamOutputTrim,  "Output Trim",     -24.0f, 24.0f,  0.1f, 0.0f),
+    Spec::toggle (kParamBypass,      "Soft Bypass",     false)
+}};
+
+static_assert (gls::hasUniqueIds (parameterTable));
 } // namespace
 
 UTLSignalTracerAudioProcessor::UTLSignalTracerAudioProcessor()
     : DualPrecisionAudioProcessor (BusesProperties().withInput  ("Input",  juce::AudioChannelSet::stereo(), true)
                                                    .withOutput ("Output", juce::AudioChannelSet::stereo(), true)),
-      apvts (*this, nullptr, "Parameters", createParameterLayout())
+      apvts (*this, nullptr, "Parameters", createParameterLayout()),
+      params (apvts, parameterTable)
 {
     updateTapLabelsFromState();
+    bypass.snapOnResume ({ &inputTrimGain, &outputTrimGain });
 }
 
-void UTLSignalTracerAudioProcessor::prepareToPlay (double, int samplesPerBlock)
+void UTLSignalTracerAudioProcessor::prepareToPlay (double sampleRate, int samplesPerBlock)
 {
+    DualPrecisionAudioProcessor::prepareToPlay (sampleRate, samplesPerBlock);
+
     const auto channels = juce::jmax (1, getTotalNumInputChannels());
     inputSnapshot.setSize (channels, samplesPerBlock, false, false, true);
     sideSnapshot.setSize (2, samplesPerBlock, false, false, true);
-    postSnapshot.setSize (juce::jmax (1, getTotalNumOutputChannels()), samplesPerBlock, false, false, true);
-    for (auto& metric : tapMetrics)
-        metric = {};
     rmsAverages.fill (0.0f);
     peakHoldValues.fill (0.0f);
+
+    metricsTransport.getWriteBuffer() = {};
+    metricsTransport.publish();
+
+    const auto samplesPerFrame = juce::roundToInt (sampleRate * scopeSeconds / (double) scopeFrames);
+    for (auto& fifo : scopeFifos)
+        fifo.prepare (samplesPerFrame);
+
+    spectrumAnalyser.prepare (sampleRate);
+    bypass.prepare (sampleRate, juce::jmax (getTotalNumInputChannels(), getTotalNumOutputChannels()), samplesPerBlock);
+
+    for (auto* smoother : { &inputTrimGain, &outputTrimGain })
+        smoother->prepare (sampleRate, samplesPerBlock);
 }
 
 void UTLSignalTracerAudioProcessor::releaseResources()
 {
     inputSnapshot.setSize (0, 0);
     sideSnapshot.setSize (0, 0);
-    postSnapshot.setSize (0, 0);
 }
 
 bool UTLSignalTracerAudioProcessor::isBusesLayoutSupported (const BusesLayout& layouts) const
@@ -50,7 +79,7 @@ bool UTLSignalTracerAudioProcessor::isBusesLayoutSupported (const BusesLayout& l
         || layouts.getMainInputChannelSet() == juce::AudioChannelSet::stereo();
 }
 
-void UTLSignalTracerAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer, juce::MidiBuffer&)
+void UTLSignalTracerAudioProcessor::processFloat (juce::AudioBuffer<float>& buffer, juce::MidiBuffer&)
 {
     juce::ScopedNoDenormals noDenormals;
 
@@ -62,19 +91,20 @@ void UTLSignalTracerAudioProcessor::processBlock (juce::AudioBuffer<float>& buff
     for (auto ch = numInputChannels; ch < numOutputChannels; ++ch)
         buffer.clear (ch, 0, numSamples);
 
-    const auto tapSelect   = apvts.getRawParameterValue (kParamTapSelect)->load();
-    const auto phaseView   = apvts.getRawParameterValue (kParamPhaseView)->load();
-    const auto peakHold    = apvts.getRawParameterValue (kParamPeakHold)->load();
-    const auto rmsWindowMs = apvts.getRawParameterValue (kParamRmsWindow)->load();
-    const auto routingMode = apvts.getRawParameterValue (kParamRoutingMode)->load();
-    const auto inputTrim   = juce::Decibels::decibelsToGain (apvts.getRawParameterValue (kParamInputTrim)->load());
-    const auto outputTrim  = juce::Decibels::decibelsToGain (apvts.getRawParameterValue (kParamOutputTrim)->load());
-    const bool bypassed    = apvts.getRawParameterValue (kParamBypass)->load() > 0.5f;
+    const auto tapSelect   = params[Param::tapSelect];
+    const auto phaseView   = params[Param::phaseView];
+    const auto peakHold    = params[Param::peakHold];
+    const auto rmsWindowMs = params[Param::rmsWindow];
+    const auto routingMode = params[Param::routingMode];
+    const bool bypassed    = params.isOn (Param::bypass);
 
-    if (bypassed)
+    if (! bypass.begin (buffer, numSamples, bypassed))
         return;
 
-    buffer.applyGain (inputTrim);
+    for (auto* smoother : { &inputTrimGain, &outputTrimGain })
+        smoother->update();
+
+    inputTrimGain.applyGain (buffer, numSamples);
 
     if (inputSnapshot.getNumChannels() < buffer.getNumChannels()
         || inputSnapshot.getNumSamples() < numSamples)
@@ -85,11 +115,6 @@ void UTLSignalTracerAudioProcessor::processBlock (juce::AudioBuffer<float>& buff
     if (sideSnapshot.getNumSamples() < numSamples)
         sideSnapshot.setSize (2, numSamples, false, false, true);
 
-    if (postSnapshot.getNumChannels() < buffer.getNumChannels()
-        || postSnapshot.getNumSamples() < numSamples)
-        postSnapshot.setSize (buffer.getNumChannels(), numSamples, false, false, true);
-    postSnapshot.makeCopyOf (buffer, true);
-
     if (buffer.getNumChannels() >= 2)
     {
         auto* left  = inputSnapshot.getReadPointer (0);
@@ -128,7 +153,7 @@ void UTLSignalTracerAudioProcessor::processBlock (juce::AudioBuffer<float>& buff
     }
     else if (routingMode == 2) // Solo tap
     {
-        const juce::AudioBuffer<float>* source = &getTapBufferForCopy (tapIndex);
+        const juce::AudioBuffer<float>* source = &getTapSource (tapIndex);
         const auto srcChannels = source->getNumChannels();
         for (int ch = 0; ch < buffer.getNumChannels(); ++ch)
         {
@@ -158,9 +183,28 @@ void UTLSignalTracerAudioProcessor::processBlock (juce::AudioBuffer<float>& buff
     computeTapMetrics (1, inputSnapshot, smoothingCoeff, holdPeaks);
     computeTapMetrics (2, buffer, smoothingCoeff, holdPeaks);
     computeTapMetrics (3, sideSnapshot, smoothingCoeff, holdPeaks);
+    metricsTransport.publish();
     updatePhaseCorrelation (buffer);
 
-    buffer.applyGain (outputTrim);
+    const juce::AudioBuffer<float>* scopeSources[] = { &inputSnapshot, &inputSnapshot, &buffer, &sideSnapshot };
+    for (int tap = 0; tap < numTaps; ++tap)
+        scopeFifos[(size_t) tap].push (scopeSources[tap]->getReadPointer (0), numSamples);
+
+    spectrumAnalyser.push (*scopeSources[tapIndex], numSamples);
+
+    outputTrimGain.applyGain (buffer, numSamples);
+    bypass.end (buffer, numSamples);
+}
+
+void UTLSignalTracerAudioProcessor::updateTail()
+{
+    // Let the tap meters fall to the floor: the RMS averages over its window, and held
+    // peaks decay by 0.95 a block.
+    const auto sampleRate = juce::jmax (1.0, getSampleRate());
+    const auto windowSeconds = juce::jmax (0.005f, params[Param::rmsWindow]) * 0.001;
+    const auto peakDecaySeconds = params[Param::peakHold] > 0.5f ? -getBlockSize() / (std::log (0.95) * sampleRate) : 0.0;
+    tail.setTail (0.0, juce::jmax (gls::dsp::TailTracker::getEnvelopeRT60 (windowSeconds),
+                                   gls::dsp::TailTracker::getEnvelopeRT60 (peakDecaySeconds)));
 }
 
 juce::AudioProcessorEditor* UTLSignalTracerAudioProcessor::createEditor()
@@ -186,24 +230,7 @@ void UTLSignalTracerAudioProcessor::setStateInformation (const void* data, int s
 
 juce::AudioProcessorValueTreeState::ParameterLayout UTLSignalTracerAudioProcessor::createParameterLayout()
 {
-    std::vector<std::unique_ptr<juce::RangedAudioParameter>> params;
-
-    params.emplace_back (std::make_unique<juce::AudioParameterChoice> (kParamTapSelect, "Tap Select",
-                                                                       juce::StringArray { "Input", "Pre", "Post", "Side" }, 0));
-    params.emplace_back (std::make_unique<juce::AudioParameterChoice> (kParamPhaseView, "Phase View",
-                                                                       juce::StringArray { "Lissajous", "Correlation", "Vectorscope" }, 0));
-    params.emplace_back (std::make_unique<juce::AudioParameterBool> (kParamPeakHold, "Peak Hold", false));
-    params.emplace_back (std::make_unique<juce::AudioParameterFloat> (kParamRmsWindow, "RMS Window (ms)",
-                                                                      juce::NormalisableRange<float> (5.0f, 500.0f, 0.1f, 0.4f), 50.0f));
-    params.emplace_back (std::make_unique<juce::AudioParameterChoice> (kParamRoutingMode, "Routing Mode",
-                                                                       juce::StringArray { "Stereo", "Mid/Side", "Solo Tap" }, 0));
-    params.emplace_back (std::make_unique<juce::AudioParameterFloat> (kParamInputTrim, "Input Trim",
-                                                                      juce::NormalisableRange<float> (-24.0f, 24.0f, 0.1f), 0.0f));
-    params.emplace_back (std::make_unique<juce::AudioParameterFloat> (kParamOutputTrim, "Output Trim",
-                                                                      juce::NormalisableRange<float> (-24.0f, 24.0f, 0.1f), 0.0f));
-    params.emplace_back (std::make_unique<juce::AudioParameterBool> (kParamBypass, "Soft Bypass", false));
-
-    return { params.begin(), params.end() };
+    return gls::createParameterLayout (parameterTable);
 }
 
 namespace
@@ -214,8 +241,15 @@ public:
     SignalTracerVisualComponent (UTLSignalTracerAudioProcessor& processorRef,
                                  juce::AudioProcessorValueTreeState& stateRef,
                                  juce::Colour accentColour)
-        : processor (processorRef), state (stateRef), accent (accentColour)
+        : processor (processorRef), state (stateRef), accent (accentColour),
+          spectrum (processorRef.getSpectrumAnalyser(), accentColour)
     {
+        addAndMakeVisible (spectrum);
+
+        for (auto& frames : scopeHistory)
+            frames.resize ((size_t) UTLSignalTracerAudioProcessor::scopeFrames);
+
+        incoming.resize ((size_t) UTLSignalTracerAudioProcessor::scopeFrames);
         startTimerHz (24);
     }
 
@@ -228,22 +262,40 @@ public:
         g.drawRoundedRectangle (bounds, 10.0f, 1.5f);
 
         auto waveformArea = bounds.removeFromTop (bounds.getHeight() * 0.65f).reduced (12.0f);
+        g.setColour (gls::ui::Colours::grid());
+        g.drawRect (getSpectrumArea (waveformArea));
         drawWaveform (g, waveformArea);
 
         auto metersArea = bounds.reduced (12.0f);
         drawMeters (g, metersArea);
     }
 
+    void resized() override
+    {
+        auto bounds = getLocalBounds().toFloat().reduced (8.0f);
+        auto waveformArea = bounds.removeFromTop (bounds.getHeight() * 0.65f).reduced (12.0f);
+        spectrum.setBounds (getSpectrumArea (waveformArea).toNearestInt());
+    }
+
 private:
     UTLSignalTracerAudioProcessor& processor;
     juce::AudioProcessorValueTreeState& state;
     juce::Colour accent;
-    juce::AudioBuffer<float> snapshot;
-    std::array<UTLSignalTracerAudioProcessor::TapMetrics, 4> metrics {};
+    std::array<std::vector<gls::dsp::PeakFrame>, UTLSignalTracerAudioProcessor::numTaps> scopeHistory;
+    std::array<int, UTLSignalTracerAudioProcessor::numTaps> scopePositions {};
+    std::vector<gls::dsp::PeakFrame> incoming;
+    std::array<UTLSignalTracerAudioProcessor::TapMetrics, UTLSignalTracerAudioProcessor::numTaps> metrics {};
     float phaseCorr = 0.0f;
     int lastTap = 0;
     int phaseMode = 0;
     juce::String tapName;
+    gls::ui::SpectrumView spectrum;
+
+    /** Right-hand share of the scope area, below its label, for the selected tap's spectrum. */
+    static juce::Rectangle<float> getSpectrumArea (juce::Rectangle<float>& waveformArea)
+    {
+        return waveformArea.removeFromRight (waveformArea.getWidth() * 0.4f).withTrimmedLeft (12.0f).withTrimmedTop (18.0f);
+    }
 
     void drawWaveform (juce::Graphics& g, juce::Rectangle<float> area)
     {
@@ -258,26 +310,37 @@ private:
         g.setColour (gls::ui::Colours::grid());
         g.drawRect (area);
 
-        if (snapshot.getNumSamples() == 0)
-            return;
-
-        juce::Path path;
-        const auto* data = snapshot.getReadPointer (0);
-        const int samples = snapshot.getNumSamples();
+        // Min/max envelope of the selected tap, oldest frame on the left.
+        const auto& frames = scopeHistory[(size_t) lastTap];
+        const int numFrames = (int) frames.size();
+        const int start = scopePositions[(size_t) lastTap];
         const float midY = area.getCentreY();
-        const float scaleX = area.getWidth() / (float) samples;
+        const float scaleX = area.getWidth() / (float) juce::jmax (1, numFrames - 1);
         const float scaleY = area.getHeight() * 0.45f;
 
-        path.startNewSubPath (area.getX(), midY);
-        for (int i = 0; i < samples; ++i)
+        juce::Path path;
+        for (int i = 0; i < numFrames; ++i)
+        {
+            const auto& frame = frames[(size_t) ((start + i) % numFrames)];
+            const juce::Point<float> point (area.getX() + (float) i * scaleX, midY - frame.maximum * scaleY);
+
+            if (i == 0)
+                path.startNewSubPath (point);
+            else
+                path.lineTo (point);
+        }
+
+        for (int i = numFrames; --i >= 0;)
         {
-            const float x = area.getX() + i * scaleX;
-            const float y = midY - data[i] * scaleY;
-            path.lineTo (x, y);
+            const auto& frame = frames[(size_t) ((start + i) % numFrames)];
+            path.lineTo (area.getX() + (float) i * scaleX, midY - frame.minimum * scaleY);
         }
 
+        path.closeSubPath();
+        g.setColour (accent.withAlpha (0.35f));
+        g.fillPath (path);
         g.setColour (accent);
-        g.strokePath (path, juce::PathStrokeType (2.0f));
+        g.strokePath (path, juce::PathStrokeType (1.5f));
     }
 
     void drawMeters (juce::Graphics& g, juce::Rectangle<float> area)
@@ -313,11 +376,30 @@ private:
         lastTap = juce::jlimit (0, 3, (int) std::round (state.getRawParameterValue (kParamTapSelect)->load()));
         phaseMode = juce::jlimit (0, 2, (int) std::round (state.getRawParameterValue (kParamPhaseView)->load()));
         tapName = processor.getTapLabel (lastTap);
-        processor.copyTapBuffer (lastTap, snapshot);
+        pullScopeFrames();
         processor.copyTapMetrics (metrics);
         phaseCorr = processor.getPhaseCorrelation();
         repaint();
     }
+
+    /** Drains every tap, not just the visible one, so switching taps shows current audio. */
+    void pullScopeFrames()
+    {
+        for (int tap = 0; tap < UTLSignalTracerAudioProcessor::numTaps; ++tap)
+        {
+            auto& frames = scopeHistory[(size_t) tap];
+            auto& position = scopePositions[(size_t) tap];
+
+            for (int count; (count = processor.pullScopeFrames (tap, incoming.data(), (int) incoming.size())) > 0;)
+            {
+                for (int i = 0; i < count; ++i)
+                {
+                    frames[(size_t) position] = incoming[(size_t) i];
+                    position = (position + 1) % (int) frames.size();
+                }
+            }
+        }
+    }
 };
 } // namespace
 
@@ -513,59 +595,58 @@ void UTLSignalTracerAudioProcessor::computeTapMetrics (int tapIndex,
                                                        float smoothingCoeff,
                                                        bool holdPeaks)
 {
+    if (tapIndex < 0 || tapIndex >= numTaps)
+        return;
+
     const int channels = source.getNumChannels();
     const int samples  = source.getNumSamples();
-    if (channels == 0 || samples == 0 || tapIndex < 0 || tapIndex >= (int) tapMetrics.size())
-        return;
 
-    double sumSquares = 0.0;
-    float peak = 0.0f;
-    for (int ch = 0; ch < channels; ++ch)
+    if (channels > 0 && samples > 0)
     {
-        const auto* data = source.getReadPointer (ch);
-        for (int i = 0; i < samples; ++i)
+        double sumSquares = 0.0;
+        float peak = 0.0f;
+        for (int ch = 0; ch < channels; ++ch)
         {
-            const float sample = data[i];
-            sumSquares += sample * sample;
-            peak = juce::jmax (peak, std::abs (sample));
+            const auto* data = source.getReadPointer (ch);
+            for (int i = 0; i < samples; ++i)
+            {
+                const float sample = data[i];
+                sumSquares += sample * sample;
+                peak = juce::jmax (peak, std::abs (sample));
+            }
         }
-    }
 
-    const float instantaneousRms = std::sqrt (static_cast<float> (sumSquares / (samples * channels)));
-    const float alpha = juce::jlimit (0.0f, 0.9999f, smoothingCoeff);
-    rmsAverages[tapIndex] = alpha * rmsAverages[tapIndex] + (1.0f - alpha) * instantaneousRms;
+        const float instantaneousRms = std::sqrt (static_cast<float> (sumSquares / (samples * channels)));
+        const float alpha = juce::jlimit (0.0f, 0.9999f, smoothingCoeff);
+        rmsAverages[tapIndex] = alpha * rmsAverages[tapIndex] + (1.0f - alpha) * instantaneousRms;
 
-    if (holdPeaks)
-        peakHoldValues[tapIndex] = juce::jmax (peakHoldValues[tapIndex] * 0.95f, peak);
-    else
-        peakHoldValues[tapIndex] = peak;
+        if (holdPeaks)
+            peakHoldValues[tapIndex] = juce::jmax (peakHoldValues[tapIndex] * 0.95f, peak);
+        else
+            peakHoldValues[tapIndex] = peak;
+    }
 
-    const std::scoped_lock lock (metricsMutex);
-    tapMetrics[tapIndex].rms  = rmsAverages[tapIndex];
-    tapMetrics[tapIndex].peak = peakHoldValues[tapIndex];
+    // The write slot holds whatever was published two blocks ago, so every tap is rewritten.
+    auto& metrics = metricsTransport.getWriteBuffer()[(size_t) tapIndex];
+    metrics.rms  = rmsAverages[tapIndex];
+    metrics.peak = peakHoldValues[tapIndex];
 }
 
-void UTLSignalTracerAudioProcessor::copyTapMetrics (std::array<TapMetrics, 4>& dest) const
+void UTLSignalTracerAudioProcessor::copyTapMetrics (std::array<TapMetrics, numTaps>& dest)
 {
-    const std::scoped_lock lock (metricsMutex);
-    dest = tapMetrics;
+    metricsTransport.fetch();
+    dest = metricsTransport.getReadBuffer();
 }
 
-const juce::AudioBuffer<float>& UTLSignalTracerAudioProcessor::getTapBufferForCopy (int tapIndex) const
+int UTLSignalTracerAudioProcessor::pullScopeFrames (int tapIndex, gls::dsp::PeakFrame* dest, int maxFrames)
 {
-    const int clamped = juce::jlimit (0, 3, tapIndex);
-    if (clamped == 2)
-        return postSnapshot;
-    if (clamped == 3)
-        return sideSnapshot;
-    return inputSnapshot;
+    return scopeFifos[(size_t) juce::jlimit (0, numTaps - 1, tapIndex)].pull (dest, maxFrames);
 }
 
-void UTLSignalTracerAudioProcessor::copyTapBuffer (int tapIndex, juce::AudioBuffer<float>& dest) const
+const juce::AudioBuffer<float>& UTLSignalTracerAudioProcessor::getTapSource (int tapIndex) const
 {
-    const auto& source = getTapBufferForCopy (tapIndex);
-    dest.setSize (source.getNumChannels(), source.getNumSamples(), false, false, true);
-    dest.makeCopyOf (source, true);
+    // Post is taken before routing, at which point it still equals the trimmed input.
+    return juce::jlimit (0, 3, tapIndex) == 3 ? sideSnapshot : inputSnapshot;
 }
 
 juce::String UTLSignalTracerAudioProcessor::getTapLabel (int index) const
@@ -1,13 +1,26 @@
 #pragma once
 
 #include <JuceHeader.h>
-#include <mutex>
+#include <array>
 #include "../../DualPrecisionAudioProcessor.h"
+#include "../../ParameterTable.h"
+#include "../../SmoothedParameter.h"
+#include "../../dsp/LockFreeTransport.h"
+#include "../../dsp/SoftBypass.h"
+#include "../../dsp/SpectrumAnalyser.h"
 #include "../../ui/GoodluckLookAndFeel.h"
+#include "../../ui/SpectrumView.h"
 
 class UTLSignalTracerAudioProcessor : public DualPrecisionAudioProcessor
 {
 public:
+    enum class Param
+    {
+        tapSelect, phaseView, peakHold, rmsWindow, routingMode, inputTrim, outputTrim,
+        bypass,
+        count
+    };
+
     struct TapMetrics
     {
         float peak = 0.0f;
@@ -15,13 +28,16 @@ public:
         float correlation = 0.0f;
     };
 
+    static constexpr int numTaps = 4;
+    static constexpr double scopeSeconds = 0.05;
+    static constexpr int scopeFrames = 512;
+
     UTLSignalTracerAudioProcessor();
     ~UTLSignalTracerAudioProcessor() override = default;
 
     void prepareToPlay (double sampleRate, int samplesPerBlock) override;
     void releaseResources() override;
     bool isBusesLayoutSupported (const BusesLayout& layouts) const override;
-    void processBlock (juce::AudioBuffer<float>&, juce::MidiBuffer&) override;
 
     juce::AudioProcessorEditor* createEditor() override;
     bool hasEditor() const override { return true; }
@@ -30,7 +46,6 @@ public:
     bool acceptsMidi() const override { return false; }
     bool producesMidi() const override { return false; }
     bool isMidiEffect() const override { return false; }
-    double getTailLengthSeconds() const override { return 0.0; }
 
     int getNumPrograms() override { return 1; }
     int getCurrentProgram() override { return 0; }
@@ -46,32 +61,44 @@ public:
 
     juce::AudioProcessorValueTreeState& getValueTreeState() { return apvts; }
     static juce::AudioProcessorValueTreeState::ParameterLayout createParameterLayout();
-    void copyTapMetrics (std::array<TapMetrics, 4>& dest) const;
-    void copyTapBuffer (int tapIndex, juce::AudioBuffer<float>& dest) const;
+
+    /** Editor side of the audio-thread transports; call from one thread only. */
+    void copyTapMetrics (std::array<TapMetrics, numTaps>& dest);
+    int pullScopeFrames (int tapIndex, gls::dsp::PeakFrame* dest, int maxFrames);
+    gls::dsp::SpectrumAnalyser& getSpectrumAnalyser() noexcept { return spectrumAnalyser; }
+
     float getPhaseCorrelation() const noexcept { return phaseCorrelation.load(); }
     juce::String getTapLabel (int index) const;
     void setTapLabel (int index, const juce::String& text);
     void storeTapPreset (int slot);
     void loadTapPreset (int slot);
 
+protected:
+    void processFloat (juce::AudioBuffer<float>&, juce::MidiBuffer&) override;
+    void updateTail() override;
+
 private:
     juce::AudioProcessorValueTreeState apvts;
+    gls::ParameterHandles<Param> params;
+    gls::SmoothedParameter inputTrimGain  { params, Param::inputTrim,   gls::SmoothedParameter::Mapping::decibels };
+    gls::SmoothedParameter outputTrimGain { params, Param::outputTrim,  gls::SmoothedParameter::Mapping::decibels };
     juce::AudioBuffer<float> inputSnapshot;
     juce::AudioBuffer<float> sideSnapshot;
-    juce::AudioBuffer<float> postSnapshot;
-    std::array<TapMetrics, 4> tapMetrics {};
+    gls::dsp::TripleBuffer<std::array<TapMetrics, numTaps>> metricsTransport;
+    std::array<gls::dsp::PeakFrameFifo, numTaps> scopeFifos;
+    gls::dsp::SpectrumAnalyser spectrumAnalyser;
+    gls::dsp::SoftBypass bypass;
     std::array<float, 4> rmsAverages {};
     std::array<float, 4> peakHoldValues {};
     std::array<juce::String, 4> tapLabels { "Input", "Pre", "Post", "Side" };
     std::array<std::array<juce::String, 4>, 3> tapLabelPresets {};
     std::atomic<float> phaseCorrelation { 0.0f };
-    mutable std::mutex metricsMutex;
 
     void computeTapMetrics (int tapIndex, const juce::AudioBuffer<float>& buffer,
                             float smoothingCoeff, bool holdPeaks);
     void updateTapLabelsFromState();
     void updatePhaseCorrelation (const juce::AudioBuffer<float>& buffer);
-    const juce::AudioBuffer<float>& getTapBufferForCopy (int tapIndex) const;
+    const juce::AudioBuffer<float>& getTapSource (int tapIndex) const;
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (UTLSignalTracerAudioProcessor)
 };
@@ -0,0 +1,55 @@
+# Offline benchmark harness: one console executable per plugin, linked against the
+# plugin's shared-code target so the exact processor that ships is measured.
+#
+#   cmake --build <build> --target GLSBenchmarks
+#   <build>/Benchmarks/GLSMixGuard_Benchmark --csv
+
+set(GLS_BENCHMARK_SOURCE "${CMAKE_CURRENT_LIST_DIR}/GLSBenchmark.cpp")
+
+if(NOT TARGET GLSBenchmarks)
+    add_custom_target(GLSBenchmarks)
+endif()
+
+function(gls_add_benchmark shared_code_target)
+    set(target_name ${shared_code_target}_Benchmark)
+
+    add_executable(${target_name} "${GLS_BENCHMARK_SOURCE}")
+
+    # Mirror the plugin wrapper setup: reuse the shared code's include dirs and
+    # definitions so JuceHeader.h and the module config match the linked library.
+    target_include_directories(${target_name} PRIVATE
+        $<TARGET_PROPERTY:${shared_code_target},INCLUDE_DIRECTORIES>)
+    target_compile_definitions(${target_name} PRIVATE
+        $<TARGET_GENEX_EVAL:${shared_code_target},$<TARGET_PROPERTY:${shared_code_target},COMPILE_DEFINITIONS>>)
+    target_compile_features(${target_name} PRIVATE cxx_std_17)
+
+    target_link_libraries(${target_name} PRIVATE
+        ${shared_code_target}
+        juce::juce_recommended_config_flags)
+
+    set_target_properties(${target_name} PROPERTIES
+        RUNTIME_OUTPUT_DIRECTORY "${CMAKE_BINARY_DIR}/Benchmarks")
+
+    add_dependencies(GLSBenchmarks ${target_name})
+endfunction()
+
+# Adds a benchmark for every juce_add_plugin target created by the given directories.
+function(gls_add_benchmarks_for_directories)
+    foreach(dir IN LISTS ARGN)
+        get_property(dir_targets DIRECTORY "${dir}" PROPERTY BUILDSYSTEM_TARGETS)
+
+        foreach(candidate IN LISTS dir_targets)
+            get_target_property(candidate_type ${candidate} TYPE)
+
+            if(NOT candidate_type STREQUAL "STATIC_LIBRARY")
+                continue()
+            endif()
+
+            get_target_property(plugin_targets ${candidate} JUCE_ACTIVE_PLUGIN_TARGETS)
+
+            if(plugin_targets)
+                gls_add_benchmark(${candidate})
+            endif()
+        endforeach()
+    endforeach()
+endfunction()
@@ -0,0 +1,345 @@
+#include <JuceHeader.h>
+#include "../AllocationTrap.h"
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <new>
+#include <type_traits>
+
+juce::AudioProcessor* JUCE_CALLTYPE createPluginFilter();
+
+//==============================================================================
+// Allocation counting. Only allocations made by the benchmark thread while it is
+// inside processBlock are counted, so prepareToPlay / editor / message-thread
+// work never pollutes the numbers. Warmup blocks count too: lazy first-block
+// setup is exactly what a host hits. Every processBlock also runs under a
+// gls::ScopedAllocationTrap, so debug builds stop on the offending call.
+namespace
+{
+thread_local bool countAllocations = false;
+std::atomic<juce::int64> allocationCount { 0 };
+
+void* countedAllocate (std::size_t size)
+{
+    gls::AllocationTrap::checkAllocation();
+
+    if (countAllocations)
+        allocationCount.fetch_add (1, std::memory_order_relaxed);
+
+    if (auto* ptr = std::malloc (size == 0 ? 1 : size))
+        return ptr;
+
+    throw std::bad_alloc();
+}
+
+void* countedAllocateNoThrow (std::size_t size) noexcept
+{
+    gls::AllocationTrap::checkAllocation();
+
+    if (countAllocations)
+        allocationCount.fetch_add (1, std::memory_order_relaxed);
+
+    return std::malloc (size == 0 ? 1 : size);
+}
+
+struct ScopedAllocationCounter
+{
+    ScopedAllocationCounter()  { countAllocations = true; }
+    ~ScopedAllocationCounter() { countAllocations = false; }
+};
+} // namespace
+
+void* operator new (std::size_t size)                                   { return countedAllocate (size); }
+void* operator new[] (std::size_t size)                                 { return countedAllocate (size); }
+void* operator new (std::size_t size, const std::nothrow_t&) noexcept   { return countedAllocateNoThrow (size); }
+void* operator new[] (std::size_t size, const std::nothrow_t&) noexcept { return countedAllocateNoThrow (size); }
+void  operator delete (void* ptr) noexcept                              { std::free (ptr); }
+void  operator delete[] (void* ptr) noexcept                            { std::free (ptr); }
+void  operator delete (void* ptr, std::size_t) noexcept                 { std::free (ptr); }
+void  operator delete[] (void* ptr, std::size_t) noexcept               { std::free (ptr); }
+void  operator delete (void* ptr, const std::nothrow_t&) noexcept       { std::free (ptr); }
+void  operator delete[] (void* ptr, const std::nothrow_t&) noexcept     { std::free (ptr); }
+
+//==============================================================================
+namespace
+{
+enum class SignalType
+{
+    sweep,
+    noise,
+    silence
+};
+
+const char* getSignalName (SignalType type)
+{
+    switch (type)
+    {
+        case SignalType::sweep:   return "sweep";
+        case SignalType::noise:   return "noise";
+        case SignalType::silence: return "silence";
+    }
+
+    return "";
+}
+
+/** Deterministic stimulus so that runs are comparable between builds and machines. */
+class TestSignal
+{
+public:
+    TestSignal (SignalType signalType, double sampleRate, double lengthSeconds)
+        : type (signalType), sr (sampleRate), length (juce::jmax (0.1, lengthSeconds))
+    {
+    }
+
+    template <typename SampleType>
+    void fill (juce::AudioBuffer<SampleType>& buffer, int numInputChannels)
+    {
+        const auto numSamples = buffer.getNumSamples();
+        buffer.clear();
+
+        for (int i = 0; i < numSamples; ++i)
+        {
+            float left = 0.0f;
+            float right = 0.0f;
+
+            if (type == SignalType::sweep)
+            {
+                // Exponential 20 Hz -> 20 kHz sweep, restarting every pass.
+                const auto t = std::fmod ((double) position / sr, length);
+                const auto k = std::log (1000.0) / length;
+                const auto phase = juce::MathConstants<double>::twoPi * 20.0 * (std::exp (k * t) - 1.0) / k;
+                left = 0.25f * (float) std::sin (phase);
+                right = 0.25f * (float) std::sin (phase + 0.3);
+            }
+            else if (type == SignalType::noise)
+            {
+                left = 0.125f * (random.nextFloat() * 2.0f - 1.0f);
+                right = 0.125f * (random.nextFloat() * 2.0f - 1.0f);
+            }
+
+            for (int ch = 0; ch < numInputChannels; ++ch)
+                buffer.setSample (ch, i, (SampleType) ((ch & 1) == 0 ? left : right));
+
+            ++position;
+        }
+    }
+
+private:
+    SignalType type;
+    double sr;
+    double length;
+    juce::int64 position = 0;
+    juce::Random random { 0x474c53 };
+};
+
+struct Options
+{
+    juce::Array<double> sampleRates { 44100.0, 48000.0, 96000.0 };
+    juce::Array<int> blockSizes { 64, 256, 1024 };
+    juce::Array<SignalType> signals { SignalType::sweep, SignalType::noise, SignalType::silence };
+    double seconds = 5.0;
+    bool csv = false;
+    bool failOnAllocation = false;
+    bool doublePrecision = false;
+};
+
+struct Result
+{
+    double nsPerSample = 0.0;
+    double realtimeFactor = 0.0;
+    double worstBlockLoad = 0.0;
+    juce::int64 allocations = 0;
+};
+
+template <typename SampleType>
+Result runCase (juce::AudioProcessor& processor, SignalType signal, double sampleRate, int blockSize, double seconds)
+{
+    const auto numIn  = processor.getTotalNumInputChannels();
+    const auto numOut = processor.getTotalNumOutputChannels();
+
+    processor.releaseResources();
+    processor.setProcessingPrecision (std::is_same_v<SampleType, double> ? juce::AudioProcessor::doublePrecision
+                                                                         : juce::AudioProcessor::singlePrecision);
+    processor.setPlayConfigDetails (numIn, numOut, sampleRate, blockSize);
+    processor.prepareToPlay (sampleRate, blockSize);
+    processor.reset();
+
+    juce::AudioBuffer<SampleType> buffer (juce::jmax (1, numIn, numOut), blockSize);
+    juce::MidiBuffer midi;
+    TestSignal generator (signal, sampleRate, seconds);
+
+    const auto warmupBlocks = juce::jmax (1, (int) (0.25 * sampleRate) / blockSize);
+    const auto measuredBlocks = juce::jmax (1, (int) (seconds * sampleRate) / blockSize);
+    const auto blockBudgetNs = 1.0e9 * (double) blockSize / sampleRate;
+
+    allocationCount = 0;
+
+    for (int block = 0; block < warmupBlocks; ++block)
+    {
+        generator.fill (buffer, numIn);
+        {
+            const gls::ScopedAllocationTrap trap;
+            ScopedAllocationCounter counter;
+            processor.processBlock (buffer, midi);
+        }
+        midi.clear();
+    }
+
+    using Clock = std::chrono::steady_clock;
+    Clock::duration total {};
+    Clock::duration worst {};
+
+    for (int block = 0; block < measuredBlocks; ++block)
+    {
+        generator.fill (buffer, numIn);
+
+        const auto start = Clock::now();
+        {
+            const gls::ScopedAllocationTrap trap;
+            ScopedAllocationCounter counter;
+            processor.processBlock (buffer, midi);
+        }
+        const auto elapsed = Clock::now() - start;
+
+        total += elapsed;
+        worst = juce::jmax (worst, elapsed);
+        midi.clear();
+    }
+
+    const auto totalNs = (double) std::chrono::duration_cast<std::chrono::nanoseconds> (total).count();
+    const auto worstNs = (double) std::chrono::duration_cast<std::chrono::nanoseconds> (worst).count();
+    const auto renderedSamples = (double) measuredBlocks * (double) blockSize;
+
+    Result result;
+    result.nsPerSample = totalNs / renderedSamples;
+    result.realtimeFactor = totalNs > 0.0 ? (renderedSamples / sampleRate) * 1.0e9 / totalNs : 0.0;
+    result.worstBlockLoad = worstNs / blockBudgetNs;
+    result.allocations = allocationCount.load();
+    return result;
+}
+
+Options parseOptions (const juce::ArgumentList& args)
+{
+    Options options;
+
+    auto parseList = [&args](const char* option, auto convert, auto& destination)
+    {
+        if (! args.containsOption (option))
+            return;
+
+        destination.clearQuick();
+        for (const auto& token : juce::StringArray::fromTokens (args.getValueForOption (option), ",", {}))
+            if (token.trim().isNotEmpty())
+                destination.add (convert (token.trim()));
+    };
+
+    parseList ("--rates",  [](const juce::String& s) { return s.getDoubleValue(); }, options.sampleRates);
+    parseList ("--blocks", [](const juce::String& s) { return juce::jmax (1, s.getIntValue()); }, options.blockSizes);
+    parseList ("--signals", [](const juce::String& s)
+    {
+        if (s == "noise")   return SignalType::noise;
+        if (s == "silence") return SignalType::silence;
+        return SignalType::sweep;
+    }, options.signals);
+
+    if (args.containsOption ("--seconds"))
+        options.seconds = juce::jmax (0.1, args.getValueForOption ("--seconds").getDoubleValue());
+
+    options.csv = args.containsOption ("--csv");
+    options.failOnAllocation = args.containsOption ("--fail-on-alloc");
+    options.doublePrecision = args.containsOption ("--double");
+    return options;
+}
+
+void printUsage (const juce::String& executable)
+{
+    std::cout << "Usage: " << executable << " [--rates=44100,48000,96000] [--blocks=64,256,1024]\n"
+              << "       [--signals=sweep,noise,silence] [--seconds=5] [--csv] [--fail-on-alloc] [--double]\n\n"
+              << "Renders the plugin offline through processBlock and reports ns/sample,\n"
+              << "realtime factor, worst-block load and audio-thread allocation counts\n"
+              << "(warmup blocks included).\n"
+              << "--double renders through the 64-bit processBlock instead of the 32-bit one.\n";
+}
+} // namespace
+
+int main (int argc, char* argv[])
+{
+    juce::ArgumentList args (argc, argv);
+
+    if (args.containsOption ("--help|-h"))
+    {
+        printUsage (args.executableName);
+        return 0;
+    }
+
+    juce::ScopedJuceInitialiser_GUI juceInitialiser;
+    const auto options = parseOptions (args);
+
+    std::unique_ptr<juce::AudioProcessor> processor (createPluginFilter());
+    if (processor == nullptr)
+    {
+        std::cerr << "createPluginFilter() returned nullptr\n";
+        return 1;
+    }
+
+   #if JUCE_DEBUG
+    if (! options.csv)
+        std::cout << "WARNING: debug build, timings are not representative\n";
+   #endif
+
+    if (options.doublePrecision && ! processor->supportsDoublePrecisionProcessing())
+    {
+        std::cerr << processor->getName() << " does not support double precision\n";
+        return 1;
+    }
+
+    const auto pluginName = processor->getName();
+    juce::int64 totalAllocations = 0;
+
+    if (options.csv)
+        std::cout << "plugin,signal,sample_rate,block_size,ns_per_sample,realtime_factor,worst_block_load,allocations\n";
+
+    for (auto signal : options.signals)
+    {
+        for (auto sampleRate : options.sampleRates)
+        {
+            for (auto blockSize : options.blockSizes)
+            {
+                const auto result = options.doublePrecision
+                                  ? runCase<double> (*processor, signal, sampleRate, blockSize, options.seconds)
+                                  : runCase<float>  (*processor, signal, sampleRate, blockSize, options.seconds);
+                totalAllocations += result.allocations;
+
+                if (options.csv)
+                {
+                    std::cout << pluginName << ',' << getSignalName (signal) << ',' << sampleRate << ',' << blockSize << ','
+                              << juce::String (result.nsPerSample, 3) << ',' << juce::String (result.realtimeFactor, 2) << ','
+                              << juce::String (result.worstBlockLoad, 4) << ',' << result.allocations << '\n';
+                }
+                else
+                {
+                    std::cout << pluginName.paddedRight (' ', 26)
+                              << juce::String (getSignalName (signal)).paddedRight (' ', 9)
+                              << juce::String (sampleRate, 0).paddedLeft (' ', 7) << " Hz"
+                              << juce::String (blockSize).paddedLeft (' ', 6) << " smp"
+                              << juce::String (result.nsPerSample, 2).paddedLeft (' ', 11) << " ns/smp"
+                              << juce::String (result.realtimeFactor, 1).paddedLeft (' ', 10) << "x RT"
+                              << juce::String (result.worstBlockLoad * 100.0, 2).paddedLeft (' ', 9) << "% worst"
+                              << juce::String (result.allocations).paddedLeft (' ', 8) << " allocs\n";
+                }
+            }
+        }
+    }
+
+    processor->releaseResources();
+    processor.reset();
+
+    if (options.failOnAllocation && totalAllocations > 0)
+    {
+        std::cerr << pluginName << ": " << totalAllocations << " allocation(s) inside processBlock\n";
+        return 2;
+    }
+
+    return 0;
+}
@@ -0,0 +1,235 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include <array>
+#include <vector>
+
+namespace gls::dsp
+{
+enum class BiquadType
+{
+    lowPass,
+    highPass,
+    bandPass,
+    notch,
+    allPass,
+    peak,
+    lowShelf,
+    highShelf
+};
+
+/** Second-order section normalised so that a0 == 1. Designed in place from the same
+    RBJ formulas as juce::dsp::IIR::Coefficients, but without the ref-counted heap object. */
+struct BiquadCoefficients
+{
+    float b0 = 1.0f, b1 = 0.0f, b2 = 0.0f, a1 = 0.0f, a2 = 0.0f;
+
+    static BiquadCoefficients design (BiquadType type, double sampleRate, float frequency,
+                                      float q = juce::MathConstants<float>::sqrt2 * 0.5f,
+                                      float gain = 1.0f) noexcept
+    {
+        using Design = juce::dsp::IIR::ArrayCoefficients<float>;
+
+        const auto sr = sampleRate > 0.0 ? sampleRate : 44100.0;
+        frequency = juce::jlimit (1.0f, (float) (sr * 0.499), frequency);
+        q = juce::jmax (1.0e-3f, q);
+        gain = juce::jmax (1.0e-6f, gain);
+
+        std::array<float, 6> raw {};
+        switch (type)
+        {
+            case BiquadType::lowPass:   raw = Design::makeLowPass   (sr, frequency, q); break;
+            case BiquadType::highPass:  raw = Design::makeHighPass  (sr, frequency, q); break;
+            case BiquadType::bandPass:  raw = Design::makeBandPass  (sr, frequency, q); break;
+            case BiquadType::notch:     raw = Design::makeNotch     (sr, frequency, q); break;
+            case BiquadType::allPass:   raw = Design::makeAllPass   (sr, frequency, q); break;
+            case BiquadType::peak:      raw = Design::makePeakFilter (sr, frequency, q, gain); break;
+            case BiquadType::lowShelf:  raw = Design::makeLowShelf  (sr, frequency, q, gain); break;
+            case BiquadType::highShelf: raw = Design::makeHighShelf (sr, frequency, q, gain); break;
+        }
+
+        const auto a0 = raw[3] != 0.0f ? 1.0f / raw[3] : 1.0f;
+        return { raw[0] * a0, raw[1] * a0, raw[2] * a0, raw[4] * a0, raw[5] * a0 };
+    }
+};
+
+/** Coefficients plus the parameters they were designed for. update() only recomputes
+    when one of the inputs moved, so static filters cost a handful of compares per block. */
+class BiquadDesign
+{
+public:
+    /** Returns true if the coefficients changed. */
+    bool update (BiquadType type, double sampleRate, float frequency, float q, float gain = 1.0f) noexcept
+    {
+        if (valid && type == lastType && sampleRate == lastSampleRate
+             && frequency == lastFrequency && q == lastQ && gain == lastGain)
+            return false;
+
+        coefficients = BiquadCoefficients::design (type, sampleRate, frequency, q, gain);
+        lastType = type;
+        lastSampleRate = sampleRate;
+        lastFrequency = frequency;
+        lastQ = q;
+        lastGain = gain;
+        valid = true;
+        return true;
+    }
+
+    void invalidate() noexcept                          { valid = false; }
+    const BiquadCoefficients& get() const noexcept      { return coefficients; }
+
+private:
+    BiquadCoefficients coefficients;
+    BiquadType lastType = BiquadType::lowPass;
+    double lastSampleRate = 0.0;
+    float lastFrequency = 0.0f, lastQ = 0.0f, lastGain = 0.0f;
+    bool valid = false;
+};
+
+/** Mono transposed direct form II biquad with a cached design. Mirrors the processing
+    API of juce::dsp::IIR::Filter<float> so processors can swap it in directly. */
+class Biquad
+{
+public:
+    static constexpr float defaultQ = 0.70710678f;
+
+    void prepare (const juce::dsp::ProcessSpec&) noexcept { reset(); }
+    void reset() noexcept                                 { s1 = s2 = 0.0f; }
+
+    void setCoefficients (const BiquadCoefficients& newCoefficients) noexcept
+    {
+        design.invalidate();
+        coeffs = newCoefficients;
+    }
+
+    const BiquadCoefficients& getCoefficients() const noexcept { return coeffs; }
+
+    /** Designs in place; a no-op when the parameters match the previous call. */
+    void setDesign (BiquadType type, double sampleRate, float frequency, float q = defaultQ, float gain = 1.0f) noexcept
+    {
+        if (design.update (type, sampleRate, frequency, q, gain))
+            coeffs = design.get();
+    }
+
+    void setLowPass   (double sr, float freq, float q = defaultQ) noexcept              { setDesign (BiquadType::lowPass,   sr, freq, q); }
+    void setHighPass  (double sr, float freq, float q = defaultQ) noexcept              { setDesign (BiquadType::highPass,  sr, freq, q); }
+    void setBandPass  (double sr, float freq, float q = defaultQ) noexcept              { setDesign (BiquadType::bandPass,  sr, freq, q); }
+    void setNotch     (double sr, float freq, float q = defaultQ) noexcept              { setDesign (BiquadType::notch,     sr, freq, q); }
+    void setAllPass   (double sr, float freq, float q = defaultQ) noexcept              { setDesign (BiquadType::allPass,   sr, freq, q); }
+    void setPeak      (double sr, float freq, float q, float gain) noexcept             { setDesign (BiquadType::peak,      sr, freq, q, gain); }
+    void setLowShelf  (double sr, float freq, float q, float gain) noexcept             { setDesign (BiquadType::lowShelf,  sr, freq, q, gain); }
+    void setHighShelf (double sr, float freq, float q, float gain) noexcept             { setDesign (BiquadType::highShelf, sr, freq, q, gain); }
+
+    float processSample (float x) noexcept
+    {
+        const auto y = coeffs.b0 * x + s1;
+        s1 = coeffs.b1 * x - coeffs.a1 * y + s2;
+        s2 = coeffs.b2 * x - coeffs.a2 * y;
+        return y;
+    }
+
+    void processBlock (float* data, int numSamples) noexcept
+    {
+        const auto c = coeffs;
+        auto z1 = s1, z2 = s2;
+
+        for (int i = 0; i < numSamples; ++i)
+        {
+            const auto x = data[i];
+            const auto y = c.b0 * x + z1;
+            z1 = c.b1 * x - c.a1 * y + z2;
+            z2 = c.b2 * x - c.a2 * y;
+            data[i] = y;
+        }
+
+        s1 = z1;
+        s2 = z2;
+        snapToZero();
+    }
+
+    /** Mono context, as with juce::dsp::IIR::Filter. */
+    template <typename ProcessContext>
+    void process (const ProcessContext& context) noexcept
+    {
+        auto& input  = context.getInputBlock();
+        auto& output = context.getOutputBlock();
+        jassert (input.getNumChannels() == 1 && output.getNumChannels() == 1);
+
+        const auto numSamples = (int) output.getNumSamples();
+        auto* out = output.getChannelPointer (0);
+
+        if (context.usesSeparateInputAndOutputBlocks())
+            juce::FloatVectorOperations::copy (out, input.getChannelPointer (0), numSamples);
+
+        if (context.isBypassed)
+            return;
+
+        processBlock (out, numSamples);
+    }
+
+    void snapToZero() noexcept
+    {
+        juce::dsp::util::snapToZero (s1);
+        juce::dsp::util::snapToZero (s2);
+    }
+
+private:
+    BiquadDesign design;
+    BiquadCoefficients coeffs;
+    float s1 = 0.0f, s2 = 0.0f;
+};
+
+/** One design shared by per-channel states; replaces ProcessorDuplicator<IIR::Filter, IIR::Coefficients>. */
+class MultiChannelBiquad
+{
+public:
+    void prepare (const juce::dsp::ProcessSpec& spec)
+    {
+        filters.resize (juce::jmax<size_t> (1, spec.numChannels));
+
+        // Channels added by the resize start at identity, and setDesign() skips an
+        // unchanged design, so hand them the current one here.
+        for (auto& filter : filters)
+            filter.setCoefficients (design.get());
+
+        reset();
+    }
+
+    void reset() noexcept
+    {
+        for (auto& filter : filters)
+            filter.reset();
+    }
+
+    void setDesign (BiquadType type, double sampleRate, float frequency, float q = Biquad::defaultQ, float gain = 1.0f) noexcept
+    {
+        if (design.update (type, sampleRate, frequency, q, gain))
+            for (auto& filter : filters)
+                filter.setCoefficients (design.get());
+    }
+
+    template <typename ProcessContext>
+    void process (const ProcessContext& context) noexcept
+    {
+        auto& input  = context.getInputBlock();
+        auto& output = context.getOutputBlock();
+        const auto numChannels = juce::jmin (output.getNumChannels(), filters.size());
+        const auto numSamples = (int) output.getNumSamples();
+
+        for (size_t ch = 0; ch < numChannels; ++ch)
+        {
+            auto* out = output.getChannelPointer (ch);
+
+            if (context.usesSeparateInputAndOutputBlocks())
+                juce::FloatVectorOperations::copy (out, input.getChannelPointer (ch), numSamples);
+
+            if (! context.isBypassed)
+                filters[ch].processBlock (out, numSamples);
+        }
+    }
+
+private:
+    BiquadDesign design;
+    std::vector<Biquad> filters;
+};
+} // namespace gls::dsp
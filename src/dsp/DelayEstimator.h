@@ -0,0 +1,283 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include "FFTEngine.h"
+#include <atomic>
+#include <complex>
+#include <vector>
+
+namespace gls::dsp
+{
+/** Time difference and polarity between two signals by generalised cross-correlation
+    with phase transform (GCC-PHAT).
+
+    Each frame is Hann-windowed and zero-padded to twice its length so the correlation
+    is linear rather than circular. Cross-spectra are averaged across frames before
+    whitening, which keeps the peak stable on program material. The peak is seeded by
+    parabolic interpolation and then refined with Newton steps on the band-limited
+    correlation itself, which removes the parabola's bias of up to a tenth of a sample.
+    A negative peak means one signal is a polarity-inverted copy of the other.
+    Everything is allocated in prepare(). */
+class GccPhatEstimator
+{
+public:
+    struct Estimate
+    {
+        float delaySamples = 0.0f;  // positive: b lags a
+        bool inverted = false;
+        float confidence = 0.0f;    // peak height of the whitened correlation, 0..1
+    };
+
+    void prepare (int fftOrder, int maximumLagSamples)
+    {
+        fft.prepare (fftOrder);
+        fftSize = fft.getSize();
+        maximumLag = juce::jlimit (1, fftSize / 2 - 2, maximumLagSamples);
+
+        window.resize ((size_t) getFrameLength());
+        juce::dsp::WindowingFunction<float>::fillWindowingTables (window.data(), window.size(),
+                                                                  juce::dsp::WindowingFunction<float>::hann, false);
+
+        spectrumA.assign ((size_t) fftSize * 2, 0.0f);
+        spectrumB.assign ((size_t) fftSize * 2, 0.0f);
+        average.assign ((size_t) fftSize / 2 + 1, {});
+        whitened.assign (average.size(), {});
+        reset();
+    }
+
+    void reset() noexcept
+    {
+        std::fill (average.begin(), average.end(), std::complex<float>());
+        averagedFrames = 0;
+    }
+
+    int getFrameLength() const noexcept                 { return fftSize / 2; }
+    int getMaximumLag() const noexcept                  { return maximumLag; }
+
+    /** Analyses getFrameLength() samples of each signal. Returns false, leaving result
+        untouched, when either frame is too quiet to say anything. */
+    bool process (const float* a, const float* b, Estimate& result) noexcept
+    {
+        const auto frameLength = getFrameLength();
+        float energyA = 0.0f, energyB = 0.0f;
+
+        for (int i = 0; i < frameLength; ++i)
+        {
+            spectrumA[(size_t) i] = a[i] * window[(size_t) i];
+            spectrumB[(size_t) i] = b[i] * window[(size_t) i];
+            energyA += spectrumA[(size_t) i] * spectrumA[(size_t) i];
+            energyB += spectrumB[(size_t) i] * spectrumB[(size_t) i];
+        }
+
+        const auto silence = silenceThreshold * (float) frameLength;
+        if (energyA < silence || energyB < silence)
+            return false;
+
+        std::fill (spectrumA.begin() + frameLength, spectrumA.end(), 0.0f);
+        std::fill (spectrumB.begin() + frameLength, spectrumB.end(), 0.0f);
+        fft->performRealOnlyForwardTransform (spectrumA.data(), true);
+        fft->performRealOnlyForwardTransform (spectrumB.data(), true);
+
+        // Normalise each frame's cross-spectrum by the frame energy so loud passages do
+        // not dominate the average, then whiten the average.
+        const auto weight = averagedFrames < averagingFrames ? 1.0f / (float) (averagedFrames + 1) : 1.0f / (float) averagingFrames;
+        const auto gain = 1.0f / std::sqrt (energyA * energyB);
+        auto* bins = reinterpret_cast<std::complex<float>*> (spectrumA.data());
+        const auto* binsB = reinterpret_cast<const std::complex<float>*> (spectrumB.data());
+
+        for (size_t k = 0; k < average.size(); ++k)
+        {
+            average[k] += weight * (std::conj (bins[k]) * binsB[k] * gain - average[k]);
+            const auto magnitude = std::abs (average[k]);
+            whitened[k] = magnitude > 1.0e-20f ? average[k] / magnitude : std::complex<float>();
+            bins[k] = whitened[k];
+        }
+
+        ++averagedFrames;
+        fft->performRealOnlyInverseTransform (spectrumA.data());
+
+        auto at = [this] (int lag) { return spectrumA[(size_t) (lag >= 0 ? lag : fftSize + lag)]; };
+
+        int peakLag = 0;
+        for (int lag = -maximumLag; lag <= maximumLag; ++lag)
+            if (std::abs (at (lag)) > std::abs (at (peakLag)))
+                peakLag = lag;
+
+        const auto peak = at (peakLag);
+        const auto sign = peak < 0.0f ? -1.0f : 1.0f;
+        const auto before = sign * at (peakLag - 1), centre = sign * peak, after = sign * at (peakLag + 1);
+        const auto curvature = before - 2.0f * centre + after;
+        const auto offset = curvature < 0.0f ? juce::jlimit (-0.5f, 0.5f, 0.5f * (before - after) / curvature) : 0.0f;
+
+        result.delaySamples = refinePeak ((float) peakLag + offset, sign);
+        result.inverted = peak < 0.0f;
+        result.confidence = juce::jlimit (0.0f, 1.0f, std::abs (peak));
+        return true;
+    }
+
+private:
+    /** Newton iterations on sign * r (lag), with r evaluated directly from the whitened
+        spectrum so the fractional part is not limited by the lag grid. */
+    float refinePeak (float seed, float sign) const noexcept
+    {
+        auto lag = (double) seed;
+        const auto binSpacing = juce::MathConstants<double>::twoPi / (double) fftSize;
+        const auto lastBin = whitened.size() - 1;
+
+        for (int iteration = 0; iteration < 3; ++iteration)
+        {
+            double slope = 0.0, curvature = 0.0;
+
+            for (size_t k = 1; k <= lastBin; ++k)
+            {
+                const auto omega = binSpacing * (double) k;
+                const auto weight = k == lastBin ? omega : 2.0 * omega;
+                const auto rotated = std::complex<double> (whitened[k]) * std::polar (1.0, omega * lag);
+                slope -= weight * rotated.imag();
+                curvature -= weight * omega * rotated.real();
+            }
+
+            slope *= sign;
+            curvature *= sign;
+
+            if (curvature >= 0.0)
+                break;
+
+            lag = juce::jlimit ((double) seed - 1.0, (double) seed + 1.0, lag - slope / curvature);
+        }
+
+        return (float) lag;
+    }
+
+    static constexpr int averagingFrames = 8;
+    static constexpr float silenceThreshold = 1.0e-8f;  // mean windowed power, about -80 dBFS
+
+    FFTEngine fft;
+    std::vector<float> window, spectrumA, spectrumB;
+    std::vector<std::complex<float>> average, whitened;
+    int fftSize = 0, maximumLag = 1, averagedFrames = 0;
+};
+
+/** Runs a GccPhatEstimator on a background thread over audio captured on the audio
+    thread. The audio thread only copies into a juce::AbstractFifo and reads atomics;
+    the FFT work, framing and averaging all happen on the analysis thread. */
+class BackgroundDelayEstimator : private juce::Thread
+{
+public:
+    BackgroundDelayEstimator() : juce::Thread ("GLS Delay Estimator") {}
+    ~BackgroundDelayEstimator() override                { stop(); }
+
+    /** Stops the thread, sizes every buffer for the new rate and restarts it. Not
+        concurrent with push(). */
+    void prepare (double sampleRate, float maximumLagMs)
+    {
+        stop();
+
+        // Roughly a third of a second per frame whatever the rate, and always at least
+        // four times the search range so the lag window sits well inside the frame.
+        const auto maximumLag = (int) std::ceil (maximumLagMs * 0.001 * sampleRate);
+        int fftOrder = 14;
+        while ((1 << (fftOrder - 1)) < juce::jmax (4 * maximumLag, juce::roundToInt (sampleRate / 3.0)) && fftOrder < 18)
+            ++fftOrder;
+
+        estimator.prepare (fftOrder, maximumLag);
+        frameLength = estimator.getFrameLength();
+        hopLength = frameLength / 2;
+        frameA.assign ((size_t) frameLength, 0.0f);
+        frameB.assign ((size_t) frameLength, 0.0f);
+
+        const auto capacity = 4 * frameLength;
+        fifo.setTotalSize (capacity);
+        captureA.assign ((size_t) capacity, 0.0f);
+        captureB.assign ((size_t) capacity, 0.0f);
+
+        resetRequested = true;
+        startThread (juce::Thread::Priority::low);
+    }
+
+    void stop()                                         { stopThread (2000); }
+
+    /** Audio thread: queues a block of both signals. Drops the block if the analysis
+        thread has fallen behind. */
+    void push (const float* a, const float* b, int numSamples) noexcept
+    {
+        if (fifo.getFreeSpace() < numSamples)
+            return;
+
+        const auto scope = fifo.write (numSamples);
+        std::copy (a, a + scope.blockSize1, captureA.data() + scope.startIndex1);
+        std::copy (b, b + scope.blockSize1, captureB.data() + scope.startIndex1);
+        std::copy (a + scope.blockSize1, a + numSamples, captureA.data() + scope.startIndex2);
+        std::copy (b + scope.blockSize1, b + numSamples, captureB.data() + scope.startIndex2);
+    }
+
+    /** Any thread: discards the averaged history so the next estimates describe only new audio. */
+    void requestReset() noexcept                        { resetRequested = true; }
+
+    /** Any thread. The count increases every time a confident estimate is published. */
+    int getEstimateCount() const noexcept               { return estimateCount.load (std::memory_order_acquire); }
+    float getDelaySamples() const noexcept              { return delaySamples.load (std::memory_order_relaxed); }
+    bool isInverted() const noexcept                    { return inverted.load (std::memory_order_relaxed); }
+    float getConfidence() const noexcept                { return confidence.load (std::memory_order_relaxed); }
+
+private:
+    static constexpr float minimumConfidence = 0.1f;
+
+    void run() override
+    {
+        int filled = 0, framesSeen = 0;
+
+        while (! threadShouldExit())
+        {
+            if (resetRequested.exchange (false))
+            {
+                estimator.reset();
+                filled = framesSeen = 0;
+                confidence = 0.0f;
+            }
+
+            // Each hop slides the frame along and appends the newest audio at the end.
+            const auto scope = fifo.read (juce::jmin (hopLength - filled, fifo.getNumReady()));
+            auto* tailA = frameA.data() + frameLength - hopLength + filled;
+            auto* tailB = frameB.data() + frameLength - hopLength + filled;
+            std::copy_n (captureA.data() + scope.startIndex1, scope.blockSize1, tailA);
+            std::copy_n (captureB.data() + scope.startIndex1, scope.blockSize1, tailB);
+            std::copy_n (captureA.data() + scope.startIndex2, scope.blockSize2, tailA + scope.blockSize1);
+            std::copy_n (captureB.data() + scope.startIndex2, scope.blockSize2, tailB + scope.blockSize1);
+            filled += scope.blockSize1 + scope.blockSize2;
+
+            if (filled < hopLength)
+            {
+                wait (20);
+                continue;
+            }
+
+            GccPhatEstimator::Estimate estimate;
+            if (++framesSeen * hopLength >= frameLength && estimator.process (frameA.data(), frameB.data(), estimate))
+            {
+                confidence.store (estimate.confidence, std::memory_order_relaxed);
+
+                if (estimate.confidence >= minimumConfidence)
+                {
+                    delaySamples.store (estimate.delaySamples, std::memory_order_relaxed);
+                    inverted.store (estimate.inverted, std::memory_order_relaxed);
+                    estimateCount.fetch_add (1, std::memory_order_release);
+                }
+            }
+
+            std::copy (frameA.begin() + hopLength, frameA.end(), frameA.begin());
+            std::copy (frameB.begin() + hopLength, frameB.end(), frameB.begin());
+            filled = 0;
+        }
+    }
+
+    GccPhatEstimator estimator;
+    juce::AbstractFifo fifo { 1 };
+    std::vector<float> captureA, captureB, frameA, frameB;
+    int frameLength = 0, hopLength = 0;
+
+    std::atomic<bool> resetRequested { true }, inverted { false };
+    std::atomic<float> delaySamples { 0.0f }, confidence { 0.0f };
+    std::atomic<int> estimateCount { 0 };
+};
+} // namespace gls::dsp
@@ -0,0 +1,132 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include <vector>
+
+namespace gls::dsp
+{
+/** Mono ring-buffer delay sized in prepare() from the longest delay the caller will
+    ask for at the actual sample rate, rounded up to a power of two so wraparound is
+    a mask rather than a modulo.
+
+    Per sample, read() then push() behaves like juce::dsp::DelayLine's popSample()
+    then pushSample(): read (d) returns the input from d samples before the one about
+    to be pushed, which is what a feedback loop wants. process() pushes first, so a
+    delay of 0 passes the input straight through. Whole blocks can be written with
+    write() and then read back with one delay or one delay per sample. Fractional
+    delays use linear interpolation. */
+template <typename SampleType>
+class DelayLine
+{
+public:
+    /** Allocates room for maximumDelaySeconds at sampleRate, plus one block of
+        maximumBlockSize for block reads. */
+    void prepare (double sampleRate, double maximumDelaySeconds, int maximumBlockSize = 1)
+    {
+        prepare ((int) std::ceil (sampleRate * maximumDelaySeconds), maximumBlockSize);
+    }
+
+    void prepare (int maximumDelaySamples, int maximumBlockSize = 1)
+    {
+        maximumDelay = juce::jmax (1, maximumDelaySamples);
+        maximumBlock = juce::jmax (1, maximumBlockSize);
+
+        // One extra slot for read()-before-push() and one for the interpolation partner.
+        buffer.assign ((size_t) juce::nextPowerOfTwo (maximumDelay + maximumBlock + 2), SampleType());
+        mask = (int) buffer.size() - 1;
+        writeIndex = 0;
+    }
+
+    void reset() noexcept
+    {
+        std::fill (buffer.begin(), buffer.end(), SampleType());
+        writeIndex = 0;
+    }
+
+    int getMaximumDelay() const noexcept                { return maximumDelay; }
+    int getMaximumBlockSize() const noexcept            { return maximumBlock; }
+
+    //==============================================================================
+    void push (SampleType input) noexcept
+    {
+        buffer[(size_t) writeIndex] = input;
+        writeIndex = (writeIndex + 1) & mask;
+    }
+
+    /** The input from delaySamples (clamped to 1..getMaximumDelay()) before the next push. */
+    SampleType read (SampleType delaySamples) const noexcept
+    {
+        return interpolate (writeIndex, juce::jlimit ((SampleType) 1, (SampleType) maximumDelay, delaySamples));
+    }
+
+    /** Pushes input and returns the input from delaySamples (0..getMaximumDelay()) ago. */
+    SampleType process (SampleType input, SampleType delaySamples) noexcept
+    {
+        push (input);
+        return interpolate (writeIndex - 1, juce::jlimit ((SampleType) 0, (SampleType) maximumDelay, delaySamples));
+    }
+
+    //==============================================================================
+    /** Appends a block of at most the prepared block size. */
+    void write (const SampleType* input, int numSamples) noexcept
+    {
+        jassert (numSamples <= maximumBlock);
+
+        const auto first = juce::jmin (numSamples, (int) buffer.size() - writeIndex);
+        std::copy (input, input + first, buffer.data() + writeIndex);
+        std::copy (input + first, input + numSamples, buffer.data());
+        writeIndex = (writeIndex + numSamples) & mask;
+    }
+
+    /** Reads the last numSamples written, each delayed by delaySamples (0..getMaximumDelay()). */
+    void read (SampleType* output, int numSamples, SampleType delaySamples) const noexcept
+    {
+        jassert (numSamples <= maximumBlock);
+
+        const auto delay = juce::jlimit ((SampleType) 0, (SampleType) maximumDelay, delaySamples);
+        const auto whole = (int) delay;
+        const auto start = writeIndex - numSamples - whole;
+
+        if (delay == (SampleType) whole)
+        {
+            for (int i = 0; i < numSamples; ++i)
+                output[i] = buffer[(size_t) ((start + i) & mask)];
+
+            return;
+        }
+
+        const auto fraction = delay - (SampleType) whole;
+        for (int i = 0; i < numSamples; ++i)
+        {
+            const auto newer = buffer[(size_t) ((start + i) & mask)];
+            const auto older = buffer[(size_t) ((start + i - 1) & mask)];
+            output[i] = newer + fraction * (older - newer);
+        }
+    }
+
+    /** As above with one delay per sample, for modulated taps. */
+    void read (SampleType* output, int numSamples, const SampleType* delaySamples) const noexcept
+    {
+        jassert (numSamples <= maximumBlock);
+
+        const auto first = writeIndex - numSamples;
+        for (int i = 0; i < numSamples; ++i)
+            output[i] = interpolate (first + i, juce::jlimit ((SampleType) 0, (SampleType) maximumDelay, delaySamples[i]));
+    }
+
+private:
+    /** Linear read delay samples behind the slot at position. */
+    SampleType interpolate (int position, SampleType delay) const noexcept
+    {
+        const auto whole = (int) delay;
+        const auto fraction = delay - (SampleType) whole;
+        const auto newer = buffer[(size_t) ((position - whole) & mask)];
+        const auto older = buffer[(size_t) ((position - whole - 1) & mask)];
+        return newer + fraction * (older - newer);
+    }
+
+    std::vector<SampleType> buffer;
+    int mask = 0, writeIndex = 0;
+    int maximumDelay = 1, maximumBlock = 1;
+};
+} // namespace gls::dsp
@@ -0,0 +1,280 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include "LatencyReporter.h"
+#include "../SmoothedParameter.h"
+#include <vector>
+
+namespace gls::dsp
+{
+/** The gain and dry/wet bookends of a processBlock, each done in one pass over the
+    buffer.
+
+    begin() applies the input trim and, only when the dry signal will be heard, takes
+    the dry copy in the same loop. end() forms wet * mix * makeup * trim + dry * (1 - mix)
+    * trim in place, so mix, output trim and any makeup gain cost one pass between them.
+    At a mix of 1 there is no dry copy at all, and a unity trim costs nothing.
+
+        dryWet.begin (buffer, numSamples, inputTrimGain, mixAmount);
+        // ... DSP, in place on buffer ...
+        dryWet.end (buffer, numSamples, mixAmount, outputTrimGain);
+
+    Processors without trims use the overloads that take only the mix. The trims and
+    mix are gls::SmoothedParameters, and begin()/end() update them, so every gain
+    follows the same fixed-time ramp whatever the host block size. The makeup gain is
+    computed by the processor; it gets a ramp of the same length here. While nothing
+    moves, both passes fall back to block constants.
+
+    Wet paths that report latency pass it to setLatency(); the dry copy then runs
+    through an IntegerDelayLine per channel so the two line up. Only a dry copy that
+    is actually heard is delayed. All storage is sized in prepare(): blocks longer
+    than the prepared size lose the dry signal rather than reallocating, so processors
+    render oversized host blocks in prepared-size chunks (see
+    DualPrecisionAudioProcessor). */
+class DryWetStage
+{
+public:
+    /** maximumLatency is the most the wet path will ever lag the dry, in samples. */
+    void prepare (double sampleRate, int numChannels, int maximumBlockSize, int maximumLatency = 0)
+    {
+        capacity = juce::jmax (1, maximumBlockSize);
+        maximumDelay = juce::jmax (0, maximumLatency);
+        latency = juce::jmin (latency, maximumDelay);
+        dry.setSize (juce::jmax (1, numChannels), capacity);
+        wetGains.assign ((size_t) capacity, 0.0f);
+        dryGains.assign ((size_t) capacity, 0.0f);
+        makeup.reset (sampleRate, SmoothedParameter::defaultRampSeconds);
+
+        dryLines.resize (maximumDelay > 0 ? (size_t) dry.getNumChannels() : 0);
+        for (auto& line : dryLines)
+        {
+            line.prepare (maximumDelay);
+            line.setDelay (latency);
+        }
+
+        reset();
+    }
+
+    /** Starts the next block from the current settings rather than ramping from the
+        last ones. SoftBypass::snapOnResume() calls it when processing resumes. */
+    void reset() noexcept
+    {
+        settlePending = true;
+        keepingDry = false;
+        linesPrimed = false;
+    }
+
+    /** The wet path's current latency; the dry copy is delayed to match. */
+    void setLatency (int samples) noexcept
+    {
+        latency = juce::jlimit (0, maximumDelay, samples);
+        for (auto& line : dryLines)
+            line.setDelay (latency);
+    }
+
+    /** The dry input of the current block; only valid between begin() and end() while
+        isKeepingDry() is true. */
+    const juce::AudioBuffer<float>& getDry() const noexcept { return dry; }
+    bool isKeepingDry() const noexcept                  { return keepingDry; }
+
+    /** Audio thread, before the DSP: applies inputGain and keeps the dry input while mix
+        is below 1 or still ramping away from it. needsDry forces the copy for processors
+        that read getDry() themselves. */
+    void begin (juce::AudioBuffer<float>& buffer, int numSamples, SmoothedParameter& inputGain,
+                SmoothedParameter& mix, bool needsDry = false) noexcept
+    {
+        beginBlock (buffer, numSamples, &inputGain, mix, needsDry);
+    }
+
+    void begin (juce::AudioBuffer<float>& buffer, int numSamples, SmoothedParameter& mix) noexcept
+    {
+        beginBlock (buffer, numSamples, nullptr, mix, false);
+    }
+
+    /** Audio thread, after the DSP: the usual mix, with makeup on the wet side only. */
+    void end (juce::AudioBuffer<float>& buffer, int numSamples, SmoothedParameter& mix,
+              SmoothedParameter& outputGain, float makeupGain = 1.0f) noexcept
+    {
+        endBlock (buffer, numSamples, mix, &outputGain, makeupGain);
+    }
+
+    void end (juce::AudioBuffer<float>& buffer, int numSamples, SmoothedParameter& mix) noexcept
+    {
+        endBlock (buffer, numSamples, mix, nullptr, 1.0f);
+    }
+
+private:
+    void beginBlock (juce::AudioBuffer<float>& buffer, int numSamples, SmoothedParameter* inputGain,
+                     SmoothedParameter& mix, bool needsDry) noexcept
+    {
+        mix.update();
+        if (inputGain != nullptr)
+            inputGain->update();
+
+        if (settlePending)
+        {
+            mix.snap();
+            if (inputGain != nullptr)
+                inputGain->snap();
+        }
+
+        keepingDry = needsDry || mix.getCurrentValue() < 1.0f || mix.getTargetValue() < 1.0f;
+
+        if (numSamples > capacity)
+        {
+            // Only reachable when prepareToPlay was skipped or the host broke its promise.
+            jassertfalse;
+            keepingDry = false;
+            linesPrimed = false;
+            if (inputGain != nullptr)
+                inputGain->applyGain (buffer, numSamples);
+            return;
+        }
+
+        const auto numChannels = buffer.getNumChannels();
+        const auto* gains = inputGain != nullptr ? inputGain->advance (numSamples) : nullptr;
+        const auto gain = inputGain != nullptr ? inputGain->getCurrentValue() : 1.0f;
+
+        for (int ch = 0; ch < numChannels; ++ch)
+        {
+            auto* data = buffer.getWritePointer (ch);
+            auto* copy = keepingDry && ch < dry.getNumChannels() ? dry.getWritePointer (ch) : nullptr;
+
+            if (gains != nullptr)
+            {
+                for (int i = 0; i < numSamples; ++i)
+                {
+                    data[i] *= gains[i];
+                    if (copy != nullptr)
+                        copy[i] = data[i];
+                }
+            }
+            else if (gain == 1.0f)
+            {
+                if (copy != nullptr)
+                    juce::FloatVectorOperations::copy (copy, data, numSamples);
+            }
+            else if (copy != nullptr)
+            {
+                for (int i = 0; i < numSamples; ++i)
+                    copy[i] = data[i] = data[i] * gain;
+            }
+            else
+            {
+                juce::FloatVectorOperations::multiply (data, gain, numSamples);
+            }
+        }
+
+        if (! keepingDry || latency == 0)
+        {
+            linesPrimed = false;
+            return;
+        }
+
+        // The lines missed everything while the copy was off. Start them from silence,
+        // which only ever meets a dry gain ramping up from 0.
+        if (! linesPrimed)
+            for (auto& line : dryLines)
+                line.reset();
+
+        linesPrimed = true;
+
+        for (int ch = 0; ch < juce::jmin (numChannels, (int) dryLines.size()); ++ch)
+            dryLines[(size_t) ch].process (dry.getWritePointer (ch), numSamples);
+    }
+
+    void endBlock (juce::AudioBuffer<float>& buffer, int numSamples, SmoothedParameter& mix,
+                   SmoothedParameter* outputGain, float makeupGain) noexcept
+    {
+        if (outputGain != nullptr)
+            outputGain->update();
+
+        if (settlePending)
+        {
+            settlePending = false;
+            makeup.setCurrentAndTargetValue (makeupGain);
+            if (outputGain != nullptr)
+                outputGain->snap();
+        }
+
+        makeup.setTargetValue (makeupGain);
+
+        if (numSamples > capacity)
+        {
+            jassertfalse;
+            mix.skip (numSamples);
+            makeup.skip (numSamples);
+            if (outputGain != nullptr)
+                outputGain->applyGain (buffer, numSamples);
+            return;
+        }
+
+        const auto* mixes = mix.advance (numSamples);
+        const auto* trims = outputGain != nullptr ? outputGain->advance (numSamples) : nullptr;
+        const auto trim = outputGain != nullptr ? outputGain->getCurrentValue() : 1.0f;
+        const auto makeupMoving = makeup.isSmoothing();
+
+        if (mixes == nullptr && trims == nullptr && ! makeupMoving)
+        {
+            const auto amount = mix.getCurrentValue();
+            mixWithGains (buffer, numSamples, amount * makeup.getCurrentValue() * trim, (1.0f - amount) * trim);
+            return;
+        }
+
+        for (int i = 0; i < numSamples; ++i)
+        {
+            const auto amount = mixes != nullptr ? mixes[i] : mix.getCurrentValue();
+            const auto gain = trims != nullptr ? trims[i] : trim;
+            const auto wetMakeup = makeupMoving ? makeup.getNextValue() : makeup.getCurrentValue();
+            wetGains[(size_t) i] = amount * wetMakeup * gain;
+            dryGains[(size_t) i] = keepingDry ? (1.0f - amount) * gain : 0.0f;
+        }
+
+        for (int ch = 0; ch < buffer.getNumChannels(); ++ch)
+        {
+            auto* out = buffer.getWritePointer (ch);
+
+            if (! keepingDry || ch >= dry.getNumChannels())
+            {
+                juce::FloatVectorOperations::multiply (out, wetGains.data(), numSamples);
+                continue;
+            }
+
+            const auto* in = dry.getReadPointer (ch);
+            for (int i = 0; i < numSamples; ++i)
+                out[i] = out[i] * wetGains[(size_t) i] + in[i] * dryGains[(size_t) i];
+        }
+    }
+
+    /** buffer = buffer * wetGain + dry * dryGain with settled gains. */
+    void mixWithGains (juce::AudioBuffer<float>& buffer, int numSamples, float wetGain, float dryGain) noexcept
+    {
+        if (! keepingDry)
+            dryGain = 0.0f;
+
+        for (int ch = 0; ch < buffer.getNumChannels(); ++ch)
+        {
+            auto* out = buffer.getWritePointer (ch);
+
+            if (! keepingDry || ch >= dry.getNumChannels())
+            {
+                if (wetGain != 1.0f)
+                    juce::FloatVectorOperations::multiply (out, wetGain, numSamples);
+
+                continue;
+            }
+
+            const auto* in = dry.getReadPointer (ch);
+            for (int i = 0; i < numSamples; ++i)
+                out[i] = out[i] * wetGain + in[i] * dryGain;
+        }
+    }
+
+    juce::AudioBuffer<float> dry;
+    std::vector<IntegerDelayLine> dryLines;
+    std::vector<float> wetGains, dryGains;
+    juce::SmoothedValue<float> makeup { 1.0f };
+    int capacity = 1, maximumDelay = 0, latency = 0;
+    bool settlePending = true, keepingDry = false, linesPrimed = false;
+};
+} // namespace gls::dsp
@@ -0,0 +1,326 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include <array>
+#include <vector>
+
+namespace gls::dsp
+{
+/** True-stereo feedback-delay-network reverb.
+
+    Both inputs are spread over eight channels and run through three diffusion steps:
+    each delays its channels by different amounts, flips half their polarities and mixes
+    them with an 8x8 Hadamard matrix. The diffused signal feeds eight modulated delay
+    lines whose outputs return through a Householder matrix (x - sum(x) / 4), which is
+    one horizontal sum per sample and stays orthogonal, so decay is set entirely by the
+    per-line gains. Those gains come from the RT60 in two bands, split by a one-pole
+    crossover in each line, so damping shortens the highs without touching the lows.
+
+    The tank's feedback path runs on SIMD lanes, one delay line per lane. Only the
+    delay-line reads and writes are scalar.
+
+    Left and right are taken from two orthogonal rows of the line outputs. The
+    diffuser's output is also available as a dense early-reflection cluster. */
+class FDNReverb
+{
+public:
+    using Lanes = juce::dsp::SIMDRegister<float>;
+
+    static constexpr int numLines = 8;
+    static constexpr int numRegisters = numLines / (int) Lanes::SIMDNumElements;
+    static_assert (numLines % (int) Lanes::SIMDNumElements == 0, "lines must fill whole SIMD registers");
+
+    struct Parameters
+    {
+        float size = 0.5f;              // 0.1..1, scales the tank delays
+        float decaySeconds = 4.0f;      // RT60 below the crossover
+        float damping = 0.5f;           // 0..1, shortens the RT60 above it
+        float density = 0.6f;           // 0..1, diffused vs. discrete tank input
+        float modDepth = 0.2f;          // 0..1, up to ~1 ms of delay modulation
+        float modRate = 0.7f;           // Hz
+    };
+
+    void prepare (double newSampleRate)
+    {
+        sampleRate = newSampleRate > 0.0 ? newSampleRate : 44100.0;
+
+        const auto maximumModulation = (int) std::ceil (sampleRate * 0.0012);
+        tank.prepare ((int) std::ceil (sampleRate * baseDelaysMs.back() * 0.001 * maxSizeScale) + maximumModulation + 2);
+
+        // Each diffusion step spreads its channels evenly over a span twice as long as the
+        // previous, with an offset per channel so no two share a delay.
+        for (size_t step = 0; step < diffusers.size(); ++step)
+        {
+            const auto spanSamples = sampleRate * 0.005 * std::pow (2.0, (double) step);
+            diffusers[step].prepare ((int) std::ceil (spanSamples) + 1);
+
+            for (size_t ch = 0; ch < (size_t) numLines; ++ch)
+            {
+                const auto fraction = ((double) ch + 0.5 + 0.37 * std::sin ((double) (ch * 7 + step * 3))) / numLines;
+                diffuserDelays[step][ch] = juce::jmax (1, (int) std::round (spanSamples * fraction));
+            }
+        }
+
+        for (size_t ch = 0; ch < (size_t) numLines; ++ch)
+            lengthSamples[ch] = (float) (baseDelaysMs[ch] * 0.001 * sampleRate);
+
+        crossover = (float) (1.0 - std::exp (-juce::MathConstants<double>::twoPi * 2500.0 / sampleRate));
+        reset();
+        setParameters (parameters);
+    }
+
+    void reset() noexcept
+    {
+        tank.reset();
+
+        for (auto& step : diffusers)
+            step.reset();
+
+        for (auto& lane : lowState)
+            lane = Lanes (0.0f);
+
+        modPhase = 0.0;
+        currentSize = -1.0f;
+    }
+
+    void setParameters (const Parameters& newParameters) noexcept
+    {
+        parameters = newParameters;
+        parameters.size = juce::jlimit (0.1f, 1.0f, parameters.size);
+        parameters.decaySeconds = juce::jmax (0.05f, parameters.decaySeconds);
+        parameters.damping = juce::jlimit (0.0f, 1.0f, parameters.damping);
+        parameters.density = juce::jlimit (0.0f, 1.0f, parameters.density);
+        parameters.modDepth = juce::jlimit (0.0f, 1.0f, parameters.modDepth);
+        parameters.modRate = juce::jlimit (0.05f, 10.0f, parameters.modRate);
+    }
+
+    /** Renders wet tank and early output for numSamples of stereo input. Inputs may alias
+        outputs; right pointers may equal left ones for mono. */
+    void process (const float* inLeft, const float* inRight,
+                  float* tankLeft, float* tankRight,
+                  float* earlyLeft, float* earlyRight, int numSamples) noexcept
+    {
+        updateBlockState (numSamples);
+
+        const auto density = Lanes (parameters.density);
+        const auto sizeStep = (targetSize - currentSize) / (float) juce::jmax (1, numSamples);
+        const auto depth = Lanes (modDepthSamples);
+        const auto gain = Lanes (inputGain);
+
+        alignas (Lanes::SIMDRegisterSize) float input[(size_t) numLines] {};
+        alignas (Lanes::SIMDRegisterSize) float diffused[(size_t) numLines] {};
+        alignas (Lanes::SIMDRegisterSize) float frame[(size_t) numLines] {};
+        alignas (Lanes::SIMDRegisterSize) float delays[(size_t) numLines] {};
+
+        for (int i = 0; i < numSamples; ++i)
+        {
+            // Diffusion: inputs alternate over the channels, then delay/flip/Hadamard per step.
+            for (size_t ch = 0; ch < (size_t) numLines; ++ch)
+                input[ch] = (ch & 1) == 0 ? inLeft[i] : inRight[i];
+
+            std::copy (input, input + numLines, diffused);
+
+            for (size_t step = 0; step < diffusers.size(); ++step)
+            {
+                auto& ring = diffusers[step];
+                const auto& stepDelays = diffuserDelays[step];
+                float delayed[(size_t) numLines];
+
+                for (size_t ch = 0; ch < (size_t) numLines; ++ch)
+                    delayed[ch] = ring.at (stepDelays[ch], ch);
+
+                ring.push (diffused);
+
+                for (size_t ch = 0; ch < (size_t) numLines; ++ch)
+                    diffused[ch] = (ch & 2) == 0 ? delayed[ch] : -delayed[ch];
+
+                hadamard (diffused);
+            }
+
+            earlyLeft[i]  = outputMix (diffused, leftRow) * earlyGain;
+            earlyRight[i] = outputMix (diffused, rightRow) * earlyGain;
+
+            // Tank: modulated lengths on lanes, then one interpolated read per line.
+            currentSize += sizeStep;
+            const auto size = Lanes (currentSize);
+            for (size_t r = 0; r < (size_t) numRegisters; ++r)
+                (length[r] * size + modSin[r] * depth).copyToRawArray (delays + r * Lanes::SIMDNumElements);
+
+            for (size_t ch = 0; ch < (size_t) numLines; ++ch)
+                frame[ch] = tank.read (delays[ch], ch);
+
+            tankLeft[i]  = outputMix (frame, leftRow) * tankGain;
+            tankRight[i] = outputMix (frame, rightRow) * tankGain;
+
+            // Two-band decay and Householder feedback, plus the input and the LFO step.
+            auto sum = Lanes (0.0f);
+            std::array<Lanes, (size_t) numRegisters> feedback;
+            for (size_t r = 0; r < feedback.size(); ++r)
+            {
+                const auto x = Lanes::fromRawArray (frame + r * Lanes::SIMDNumElements);
+                lowState[r] += (x - lowState[r]) * Lanes (crossover);
+                feedback[r] = x * highGain[r] + lowState[r] * bandGainDifference[r];
+                sum += feedback[r];
+            }
+
+            const auto householder = Lanes (sum.sum() * (2.0f / (float) numLines));
+            for (size_t r = 0; r < feedback.size(); ++r)
+            {
+                const auto offset = r * Lanes::SIMDNumElements;
+                const auto direct = Lanes::fromRawArray (input + offset);
+                const auto spread = Lanes::fromRawArray (diffused + offset);
+                (feedback[r] - householder + (direct + (spread - direct) * density) * gain).copyToRawArray (frame + offset);
+
+                const auto c = modCos[r], s = modSin[r];
+                modCos[r] = c * rotationCos[r] - s * rotationSin[r];
+                modSin[r] = s * rotationCos[r] + c * rotationSin[r];
+            }
+
+            tank.push (frame);
+        }
+    }
+
+private:
+    static constexpr std::array<double, (size_t) numLines> baseDelaysMs { 32.3, 38.1, 44.6, 51.2, 57.6, 64.8, 71.5, 78.4 };
+    static constexpr std::array<float, (size_t) numLines> leftRow  { 1.0f, -1.0f, 1.0f, -1.0f, 1.0f, -1.0f, 1.0f, -1.0f };
+    static constexpr std::array<float, (size_t) numLines> rightRow { 1.0f, 1.0f, -1.0f, -1.0f, 1.0f, 1.0f, -1.0f, -1.0f };
+    static constexpr double maxSizeScale = 1.5;
+    static constexpr float inputGain = 0.5f;
+    static constexpr float tankGain = 0.35355339f;      // 1 / sqrt (numLines)
+    static constexpr float earlyGain = 0.35355339f;
+
+    /** Interleaved ring of numLines channels sharing one write head, rounded up to a
+        power of two so wraparound is a mask. Reads are relative to the next push. */
+    struct Ring
+    {
+        void prepare (int maximumDelay)
+        {
+            const auto frames = juce::nextPowerOfTwo (juce::jmax (2, maximumDelay + 2));
+            buffer.assign ((size_t) (frames * numLines), 0.0f);
+            mask = frames - 1;
+            writeIndex = 0;
+        }
+
+        void reset() noexcept
+        {
+            std::fill (buffer.begin(), buffer.end(), 0.0f);
+            writeIndex = 0;
+        }
+
+        float at (int delay, size_t channel) const noexcept
+        {
+            return buffer[(size_t) ((writeIndex - delay) & mask) * numLines + channel];
+        }
+
+        float read (float delay, size_t channel) const noexcept
+        {
+            const auto whole = juce::jmax (1, (int) delay);
+            const auto fraction = juce::jlimit (0.0f, 1.0f, delay - (float) whole);
+            const auto newer = at (whole, channel);
+            return newer + fraction * (at (whole + 1, channel) - newer);
+        }
+
+        void push (const float* frame) noexcept
+        {
+            std::copy (frame, frame + numLines, buffer.data() + (size_t) writeIndex * numLines);
+            writeIndex = (writeIndex + 1) & mask;
+        }
+
+        std::vector<float> buffer;
+        int mask = 0, writeIndex = 0;
+    };
+
+    static float outputMix (const float* values, const std::array<float, (size_t) numLines>& row) noexcept
+    {
+        float sum = 0.0f;
+        for (size_t ch = 0; ch < row.size(); ++ch)
+            sum += values[ch] * row[ch];
+
+        return sum;
+    }
+
+    /** In-place orthonormal 8-point fast Walsh-Hadamard transform. */
+    static void hadamard (float* x) noexcept
+    {
+        for (int half = 1; half < numLines; half *= 2)
+            for (int start = 0; start < numLines; start += half * 2)
+                for (int k = start; k < start + half; ++k)
+                {
+                    const auto a = x[k], b = x[k + half];
+                    x[k] = a + b;
+                    x[k + half] = a - b;
+                }
+
+        for (int k = 0; k < numLines; ++k)
+            x[k] *= tankGain;
+    }
+
+    /** Per-block: delay lengths, band gains and the modulation phasors. */
+    void updateBlockState (int numSamples) noexcept
+    {
+        targetSize = 0.3f + 1.2f * parameters.size;
+        if (currentSize < 0.0f)
+            currentSize = targetSize;
+
+        const auto highDecaySeconds = parameters.decaySeconds * (1.0f - 0.85f * parameters.damping);
+
+        alignas (Lanes::SIMDRegisterSize) float high[(size_t) numLines] {};
+        alignas (Lanes::SIMDRegisterSize) float difference[(size_t) numLines] {};
+        alignas (Lanes::SIMDRegisterSize) float cosines[(size_t) numLines] {};
+        alignas (Lanes::SIMDRegisterSize) float sines[(size_t) numLines] {};
+        alignas (Lanes::SIMDRegisterSize) float rotationCosines[(size_t) numLines] {};
+        alignas (Lanes::SIMDRegisterSize) float rotationSines[(size_t) numLines] {};
+
+        for (size_t ch = 0; ch < (size_t) numLines; ++ch)
+        {
+            // RT60: the loop gain reaches -60 dB after decaySeconds.
+            const auto loopSeconds = lengthSamples[ch] * targetSize / (float) sampleRate;
+            const auto lowGain = std::pow (10.0f, -3.0f * loopSeconds / parameters.decaySeconds);
+            high[ch] = std::pow (10.0f, -3.0f * loopSeconds / highDecaySeconds);
+            difference[ch] = lowGain - high[ch];
+        }
+
+        // Phasors are reseeded from the running phase every block so rounding never accumulates.
+        modDepthSamples = parameters.modDepth * (float) (sampleRate * 0.001);
+        const auto increment = juce::MathConstants<double>::twoPi * parameters.modRate / sampleRate;
+        for (size_t ch = 0; ch < (size_t) numLines; ++ch)
+        {
+            const auto rate = increment * (1.0 + 0.13 * (double) ch);
+            const auto phase = modPhase * (1.0 + 0.13 * (double) ch) + 0.79 * (double) ch;
+            cosines[ch] = (float) std::cos (phase);
+            sines[ch] = (float) std::sin (phase);
+            rotationCosines[ch] = (float) std::cos (rate);
+            rotationSines[ch] = (float) std::sin (rate);
+        }
+
+        for (size_t r = 0; r < (size_t) numRegisters; ++r)
+        {
+            const auto offset = r * Lanes::SIMDNumElements;
+            highGain[r] = Lanes::fromRawArray (high + offset);
+            bandGainDifference[r] = Lanes::fromRawArray (difference + offset);
+            length[r] = Lanes::fromRawArray (lengthSamples.data() + offset);
+            modCos[r] = Lanes::fromRawArray (cosines + offset);
+            modSin[r] = Lanes::fromRawArray (sines + offset);
+            rotationCos[r] = Lanes::fromRawArray (rotationCosines + offset);
+            rotationSin[r] = Lanes::fromRawArray (rotationSines + offset);
+        }
+
+        modPhase = std::fmod (modPhase + increment * numSamples, juce::MathConstants<double>::twoPi * 100.0);
+    }
+
+    double sampleRate = 44100.0;
+    Parameters parameters;
+    float crossover = 0.3f;
+    float targetSize = 1.0f, currentSize = -1.0f;
+    float modDepthSamples = 0.0f;
+    double modPhase = 0.0;
+
+    Ring tank;
+    std::array<Ring, 3> diffusers;
+    std::array<std::array<int, (size_t) numLines>, 3> diffuserDelays {};
+
+    alignas (Lanes::SIMDRegisterSize) std::array<float, (size_t) numLines> lengthSamples {};
+    std::array<Lanes, (size_t) numRegisters> lowState {}, highGain {}, bandGainDifference {};
+    std::array<Lanes, (size_t) numRegisters> length {}, modCos {}, modSin {}, rotationCos {}, rotationSin {};
+};
+} // namespace gls::dsp
@@ -0,0 +1,40 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include <memory>
+
+namespace gls::dsp
+{
+/** A juce::dsp::FFT for one owner: one processor, or one worker thread.
+
+    Engines are never shared. JUCE's fallback engine serialises perform() on an internal
+    spin lock, so one transform shared between instances would have every audio thread
+    and analysis worker of that size waiting on the others. JUCE keeps its twiddle
+    tables inside the engine, so they cannot be shared separately either.
+
+    prepare() builds the engine, and rebuilds it only when the order changes; call it
+    off the audio thread. */
+class FFTEngine
+{
+public:
+    static constexpr int maxOrder = 18;
+
+    void prepare (int order)
+    {
+        jassert (juce::isPositiveAndNotGreaterThan (order, maxOrder));
+        order = juce::jlimit (0, maxOrder, order);
+
+        if (fft == nullptr || fft->getSize() != 1 << order)
+            fft = std::make_unique<juce::dsp::FFT> (order);
+    }
+
+    bool isPrepared() const noexcept                    { return fft != nullptr; }
+    int getSize() const noexcept                        { return fft != nullptr ? fft->getSize() : 0; }
+
+    const juce::dsp::FFT* operator->() const noexcept   { jassert (fft != nullptr); return fft.get(); }
+    const juce::dsp::FFT& operator*() const noexcept    { jassert (fft != nullptr); return *fft; }
+
+private:
+    std::unique_ptr<juce::dsp::FFT> fft;
+};
+} // namespace gls::dsp
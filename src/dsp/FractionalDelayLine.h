@@ -0,0 +1,73 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include <vector>
+
+namespace gls::dsp
+{
+/** Mono delay line with a fifth-order Lagrange (6-tap FIR) fractional read.
+
+    The taps are centred on the requested delay whenever there is room, which keeps the
+    magnitude within 0.5 dB up to a quarter of the sample rate, and integer delays come
+    out exact. Being FIR, the delay can move every sample (e.g. ramping to a new
+    alignment) without the state transients a Thiran all-pass would produce.
+
+    Below centringDelay the taps can only sit on one side and the top octave suffers;
+    callers that need the full response at any fraction add that much bulk latency. */
+class FractionalDelayLine
+{
+public:
+    static constexpr int order = 5;
+    static constexpr int centringDelay = (order - 1) / 2;
+
+    void prepare (int maximumDelaySamples)
+    {
+        const auto required = juce::jmax (1, maximumDelaySamples) + order + 1;
+        buffer.assign ((size_t) juce::nextPowerOfTwo (required), 0.0f);
+        mask = (int) buffer.size() - 1;
+        maximumDelay = (float) juce::jmax (1, maximumDelaySamples);
+        writeIndex = 0;
+    }
+
+    void reset() noexcept
+    {
+        std::fill (buffer.begin(), buffer.end(), 0.0f);
+        writeIndex = 0;
+    }
+
+    float getMaximumDelay() const noexcept              { return maximumDelay; }
+
+    /** Writes one sample and reads it back delaySamples later (0 = the input itself). */
+    float process (float input, float delaySamples) noexcept
+    {
+        buffer[(size_t) writeIndex] = input;
+
+        const auto delay = juce::jlimit (0.0f, maximumDelay, delaySamples);
+        const auto base = juce::jmax (0, (int) delay - (order - 1) / 2);
+        const auto t = delay - (float) base;
+
+        // w_k = prod_{j != k} (t - j) / (k - j), from prefix and suffix products of (t - j).
+        float prefix[order + 1], suffix[order + 1];
+        prefix[0] = suffix[order] = 1.0f;
+        for (int j = 1; j <= order; ++j)
+            prefix[j] = prefix[j - 1] * (t - (float) (j - 1));
+        for (int j = order; --j >= 0;)
+            suffix[j] = suffix[j + 1] * (t - (float) (j + 1));
+
+        static constexpr float inverseDenominators[order + 1] { -1.0f / 120.0f, 1.0f / 24.0f, -1.0f / 12.0f,
+                                                                1.0f / 12.0f, -1.0f / 24.0f, 1.0f / 120.0f };
+
+        float output = 0.0f;
+        for (int k = 0; k <= order; ++k)
+            output += buffer[(size_t) ((writeIndex - base - k) & mask)] * prefix[k] * suffix[k] * inverseDenominators[k];
+
+        writeIndex = (writeIndex + 1) & mask;
+        return output;
+    }
+
+private:
+    std::vector<float> buffer;
+    int mask = 0, writeIndex = 0;
+    float maximumDelay = 1.0f;
+};
+} // namespace gls::dsp
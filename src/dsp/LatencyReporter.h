@@ -0,0 +1,146 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include <algorithm>
+#include <array>
+#include <vector>
+
+namespace gls::dsp
+{
+/** Sums the delay of every latency-introducing stage of a processor and reports it
+    to the host, only when the total actually moves.
+
+    In tracking mode each stage contributes its current delay. In fixed mode each
+    stage contributes its maximum, so the host sees one constant figure and a
+    lookahead change never forces a PDC re-sync; the stage then runs its audio path
+    at getStageDelay() and holds its detector back by getStagePadding() samples. */
+class LatencyReporter
+{
+public:
+    enum class Mode
+    {
+        tracking,
+        fixed
+    };
+
+    static constexpr int maxStages = 4;
+
+    explicit LatencyReporter (juce::AudioProcessor& processorToReportFor) noexcept
+        : processor (processorToReportFor)
+    {
+    }
+
+    void setMode (Mode newMode) noexcept                { mode = newMode; }
+    Mode getMode() const noexcept                       { return mode; }
+    bool isFixed() const noexcept                       { return mode == Mode::fixed; }
+
+    /** Current and worst-case delay of one stage, in samples at the processing rate. */
+    void setStage (int index, int currentSamples, int maximumSamples) noexcept
+    {
+        jassert (juce::isPositiveAndBelow (index, maxStages));
+        auto& stage = stages[(size_t) index];
+        stage.maximum = juce::jmax (0, maximumSamples);
+        stage.current = juce::jlimit (0, stage.maximum, currentSamples);
+    }
+
+    /** The delay the audio path of a stage has to apply in the current mode. */
+    int getStageDelay (int index) const noexcept
+    {
+        const auto& stage = stages[(size_t) index];
+        return mode == Mode::fixed ? stage.maximum : stage.current;
+    }
+
+    /** How far the audio path runs behind the stage's nominal delay; zero in tracking mode. */
+    int getStagePadding (int index) const noexcept
+    {
+        return getStageDelay (index) - stages[(size_t) index].current;
+    }
+
+    int getTotalLatency() const noexcept
+    {
+        int total = 0;
+        for (int i = 0; i < maxStages; ++i)
+            total += getStageDelay (i);
+        return total;
+    }
+
+    /** Pushes the total to the host if it changed. Cheap enough to call every block. */
+    void update()
+    {
+        const auto total = getTotalLatency();
+        if (total == reportedLatency)
+            return;
+
+        reportedLatency = total;
+        processor.setLatencySamples (total);
+    }
+
+    /** Makes the next update() report unconditionally, e.g. from prepareToPlay. */
+    void invalidate() noexcept                          { reportedLatency = -1; }
+
+private:
+    struct Stage
+    {
+        int current = 0, maximum = 0;
+    };
+
+    juce::AudioProcessor& processor;
+    std::array<Stage, maxStages> stages {};
+    Mode mode = Mode::tracking;
+    int reportedLatency = -1;
+};
+
+/** Non-interpolating mono delay for whole-sample lookahead paths and control signals,
+    e.g. holding a shared gain back by LatencyReporter::getStagePadding() in fixed mode,
+    or a dry copy behind a latent wet path. A delay of 0 passes input straight through. */
+class IntegerDelayLine
+{
+public:
+    void prepare (int maximumDelaySamples, float initialValue = 0.0f)
+    {
+        buffer.assign ((size_t) juce::jmax (1, maximumDelaySamples + 1), initialValue);
+        writeIndex = 0;
+        delay = juce::jmin (delay, (int) buffer.size() - 1);
+    }
+
+    void reset (float value = 0.0f) noexcept
+    {
+        std::fill (buffer.begin(), buffer.end(), value);
+        writeIndex = 0;
+    }
+
+    void setDelay (int newDelaySamples) noexcept
+    {
+        delay = juce::jlimit (0, juce::jmax (0, (int) buffer.size() - 1), newDelaySamples);
+    }
+
+    int getDelay() const noexcept                       { return delay; }
+
+    float process (float input) noexcept
+    {
+        const auto size = (int) buffer.size();
+        buffer[(size_t) writeIndex] = input;
+
+        auto readIndex = writeIndex - delay;
+        if (readIndex < 0)
+            readIndex += size;
+
+        if (++writeIndex == size)
+            writeIndex = 0;
+
+        return buffer[(size_t) readIndex];
+    }
+
+    /** In place; same result as calling process() on every sample. */
+    void process (float* data, int numSamples) noexcept
+    {
+        for (int i = 0; i < numSamples; ++i)
+            data[i] = process (data[i]);
+    }
+
+private:
+    std::vector<float> buffer;
+    int writeIndex = 0;
+    int delay = 0;
+};
+} // namespace gls::dsp
@@ -0,0 +1,121 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include <array>
+#include <atomic>
+#include <vector>
+
+namespace gls::dsp
+{
+/** Latest-value exchange between one producer (the audio thread) and one consumer
+    (an editor timer). Neither side ever waits: the producer always owns a slot to
+    write, the consumer always owns a slot to read, and publish()/fetch() swap
+    through the third with a single atomic exchange. */
+template <typename Value>
+class TripleBuffer
+{
+public:
+    /** Producer: the slot to fill before publish(). Its contents are stale, so write every field. */
+    Value& getWriteBuffer() noexcept                    { return slots[(size_t) writeIndex]; }
+
+    void publish() noexcept
+    {
+        writeIndex = middle.exchange (writeIndex | dirtyFlag, std::memory_order_acq_rel) & indexMask;
+    }
+
+    /** Consumer: takes the newest published value, if any. Returns false when nothing new arrived. */
+    bool fetch() noexcept
+    {
+        if ((middle.load (std::memory_order_relaxed) & dirtyFlag) == 0)
+            return false;
+
+        readIndex = middle.exchange (readIndex, std::memory_order_acq_rel) & indexMask;
+        return true;
+    }
+
+    const Value& getReadBuffer() const noexcept         { return slots[(size_t) readIndex]; }
+
+private:
+    static constexpr int indexMask = 3;
+    static constexpr int dirtyFlag = 4;
+
+    std::array<Value, 3> slots {};
+    std::atomic<int> middle { 1 };
+    int writeIndex = 0, readIndex = 2;
+};
+
+/** Smallest and largest sample over one decimated stretch of a waveform. */
+struct PeakFrame
+{
+    float minimum = 0.0f, maximum = 0.0f;
+};
+
+/** Decimates a waveform into min/max PeakFrames and hands them to one reader through a
+    juce::AbstractFifo. Storage is fixed at construction so prepare() can run while an
+    editor is still reading; when the reader falls behind, new frames are dropped
+    rather than waited for. */
+class PeakFrameFifo
+{
+public:
+    explicit PeakFrameFifo (int capacityFrames = 4096)
+        : fifo (capacityFrames), frames ((size_t) capacityFrames)
+    {
+    }
+
+    /** Producer side; not concurrent with push(). */
+    void prepare (int newSamplesPerFrame) noexcept
+    {
+        samplesPerFrame = juce::jmax (1, newSamplesPerFrame);
+        pending = {};
+        pendingCount = 0;
+    }
+
+    /** Producer: accumulates samples and queues every completed frame. */
+    void push (const float* data, int numSamples) noexcept
+    {
+        for (int i = 0; i < numSamples; ++i)
+        {
+            const auto sample = data[i];
+
+            if (pendingCount == 0)
+            {
+                pending = { sample, sample };
+            }
+            else
+            {
+                pending.minimum = juce::jmin (pending.minimum, sample);
+                pending.maximum = juce::jmax (pending.maximum, sample);
+            }
+
+            if (++pendingCount == samplesPerFrame)
+            {
+                const auto scope = fifo.write (1);
+                if (scope.blockSize1 > 0)
+                    frames[(size_t) scope.startIndex1] = pending;
+
+                pendingCount = 0;
+            }
+        }
+    }
+
+    /** Consumer: moves up to maxFrames queued frames into dest, oldest first. */
+    int pull (PeakFrame* dest, int maxFrames) noexcept
+    {
+        const auto scope = fifo.read (juce::jmin (maxFrames, fifo.getNumReady()));
+
+        for (int i = 0; i < scope.blockSize1; ++i)
+            dest[i] = frames[(size_t) (scope.startIndex1 + i)];
+
+        for (int i = 0; i < scope.blockSize2; ++i)
+            dest[scope.blockSize1 + i] = frames[(size_t) (scope.startIndex2 + i)];
+
+        return scope.blockSize1 + scope.blockSize2;
+    }
+
+private:
+    juce::AbstractFifo fifo;
+    std::vector<PeakFrame> frames;
+    PeakFrame pending;
+    int samplesPerFrame = 1, pendingCount = 0;
+};
+} // namespace gls::dsp
@@ -0,0 +1,228 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include "Biquad.h"
+#include <array>
+#include <cmath>
+#include <vector>
+
+namespace gls::dsp
+{
+/** Streaming ITU-R BS.1770-4 / EBU R128 loudness: momentary (400 ms), short-term (3 s)
+    and gated integrated loudness, in LUFS.
+
+    K-weighted energy is collected into 100 ms sub-blocks. Momentary and short-term
+    windows are running sums over a ring of those, and every 400 ms gating block lands
+    in a 0.1 LU histogram, so the integrated value never needs the block history.
+    All channels are weighted 1.0, which is what BS.1770 prescribes for L/R/C. */
+class LoudnessMeter
+{
+public:
+    static constexpr float silenceLufs = -120.0f;
+    static constexpr float absoluteGateLufs = -70.0f;
+
+    void prepare (double sampleRate, int numChannels)
+    {
+        const auto sr = sampleRate > 0.0 ? sampleRate : 48000.0;
+        subBlockLength = juce::jmax (1, juce::roundToInt (sr * 0.1));
+
+        const auto coefficients = designKWeighting (sr);
+        filters.resize ((size_t) juce::jmax (1, numChannels));
+        for (auto& filter : filters)
+        {
+            filter.shelf.setCoefficients (coefficients.shelf);
+            filter.highPass.setCoefficients (coefficients.highPass);
+        }
+
+        reset();
+    }
+
+    void reset() noexcept
+    {
+        for (auto& filter : filters)
+        {
+            filter.shelf.reset();
+            filter.highPass.reset();
+        }
+
+        subBlocks.fill (0.0);
+        subBlockPosition = 0;
+        subBlocksSeen = 0;
+        subBlockEnergy = 0.0;
+        subBlockFill = 0;
+        shortTermSum = 0.0;
+        resetIntegrated();
+    }
+
+    void resetIntegrated() noexcept
+    {
+        histogramCounts.fill (0);
+        histogramEnergy.fill (0.0);
+        integrated = silenceLufs;
+    }
+
+    /** Accumulates one block. Returns true if at least one 100 ms sub-block completed. */
+    bool process (const float* const* channels, int numChannels, int numSamples) noexcept
+    {
+        numChannels = juce::jmin (numChannels, (int) filters.size());
+        bool updated = false;
+
+        for (int start = 0; start < numSamples;)
+        {
+            const auto count = juce::jmin (numSamples - start, subBlockLength - subBlockFill);
+
+            for (int ch = 0; ch < numChannels; ++ch)
+            {
+                auto& filter = filters[(size_t) ch];
+                const auto* data = channels[ch] + start;
+                float sum = 0.0f;
+
+                for (int i = 0; i < count; ++i)
+                {
+                    const auto y = filter.highPass.processSample (filter.shelf.processSample (data[i]));
+                    sum += y * y;
+                }
+
+                subBlockEnergy += (double) sum;
+                filter.shelf.snapToZero();
+                filter.highPass.snapToZero();
+            }
+
+            subBlockFill += count;
+            start += count;
+
+            if (subBlockFill == subBlockLength)
+            {
+                completeSubBlock();
+                updated = true;
+            }
+        }
+
+        return updated;
+    }
+
+    float getMomentaryLufs() const noexcept     { return momentary; }
+    float getShortTermLufs() const noexcept     { return shortTerm; }
+    float getIntegratedLufs() const noexcept    { return integrated; }
+
+private:
+    static constexpr int momentarySubBlocks = 4;
+    static constexpr int shortTermSubBlocks = 30;
+    static constexpr int histogramBins = 1000;       // -70 .. +30 LUFS in 0.1 LU steps
+    static constexpr float histogramStep = 0.1f;
+
+    struct KWeighting
+    {
+        BiquadCoefficients shelf, highPass;
+    };
+
+    struct ChannelFilter
+    {
+        Biquad shelf, highPass;
+    };
+
+    /** Pre-filter and RLB high-pass from BS.1770, re-derived for any rate (exact at 48 kHz). */
+    static KWeighting designKWeighting (double sampleRate) noexcept
+    {
+        KWeighting k;
+
+        {
+            constexpr double f0 = 1681.974450955533, gainDb = 3.999843853973347, q = 0.7071752369554196;
+            const auto kk = std::tan (juce::MathConstants<double>::pi * f0 / sampleRate);
+            const auto vh = std::pow (10.0, gainDb / 20.0);
+            const auto vb = std::pow (vh, 0.4996667741545416);
+            const auto a0 = 1.0 + kk / q + kk * kk;
+
+            k.shelf = { (float) ((vh + vb * kk / q + kk * kk) / a0),
+                        (float) (2.0 * (kk * kk - vh) / a0),
+                        (float) ((vh - vb * kk / q + kk * kk) / a0),
+                        (float) (2.0 * (kk * kk - 1.0) / a0),
+                        (float) ((1.0 - kk / q + kk * kk) / a0) };
+        }
+
+        {
+            constexpr double f0 = 38.13547087602444, q = 0.5003270373238773;
+            const auto kk = std::tan (juce::MathConstants<double>::pi * f0 / sampleRate);
+            const auto a0 = 1.0 + kk / q + kk * kk;
+
+            k.highPass = { 1.0f, -2.0f, 1.0f,
+                           (float) (2.0 * (kk * kk - 1.0) / a0),
+                           (float) ((1.0 - kk / q + kk * kk) / a0) };
+        }
+
+        return k;
+    }
+
+    static float energyToLufs (double meanSquare) noexcept
+    {
+        return meanSquare > 0.0 ? (float) (-0.691 + 10.0 * std::log10 (meanSquare)) : silenceLufs;
+    }
+
+    void completeSubBlock() noexcept
+    {
+        const auto energy = subBlockEnergy / (double) subBlockLength;
+        subBlockEnergy = 0.0;
+        subBlockFill = 0;
+
+        // Running short-term sum: add the new sub-block, drop the one falling out of the 3 s window.
+        shortTermSum += energy - subBlocks[(size_t) ((subBlockPosition + (int) subBlocks.size() - shortTermSubBlocks) % (int) subBlocks.size())];
+        subBlocks[(size_t) subBlockPosition] = energy;
+        subBlockPosition = (subBlockPosition + 1) % (int) subBlocks.size();
+        ++subBlocksSeen;
+
+        double momentarySum = 0.0;
+        for (int i = 1; i <= momentarySubBlocks; ++i)
+            momentarySum += subBlocks[(size_t) ((subBlockPosition - i + (int) subBlocks.size()) % (int) subBlocks.size())];
+
+        const auto momentaryEnergy = momentarySum / momentarySubBlocks;
+        momentary = energyToLufs (momentaryEnergy);
+        shortTerm = energyToLufs (juce::jmax (0.0, shortTermSum) / shortTermSubBlocks);
+
+        // Every 100 ms completes a 400 ms gating block with 75 % overlap.
+        if (subBlocksSeen >= momentarySubBlocks && momentary > absoluteGateLufs)
+        {
+            const auto bin = juce::jlimit (0, histogramBins - 1, (int) ((momentary - absoluteGateLufs) / histogramStep));
+            ++histogramCounts[(size_t) bin];
+            histogramEnergy[(size_t) bin] += momentaryEnergy;
+            updateIntegrated();
+        }
+    }
+
+    void updateIntegrated() noexcept
+    {
+        juce::int64 count = 0;
+        double energy = 0.0;
+
+        for (int i = 0; i < histogramBins; ++i)
+        {
+            count += histogramCounts[(size_t) i];
+            energy += histogramEnergy[(size_t) i];
+        }
+
+        if (count == 0)
+            return;
+
+        const auto relativeGate = energyToLufs (energy / (double) count) - 10.0f;
+        const auto firstBin = juce::jlimit (0, histogramBins, (int) std::ceil ((relativeGate - absoluteGateLufs) / histogramStep));
+
+        count = 0;
+        energy = 0.0;
+        for (int i = firstBin; i < histogramBins; ++i)
+        {
+            count += histogramCounts[(size_t) i];
+            energy += histogramEnergy[(size_t) i];
+        }
+
+        integrated = count > 0 ? energyToLufs (energy / (double) count) : silenceLufs;
+    }
+
+    std::vector<ChannelFilter> filters;
+    std::array<double, shortTermSubBlocks + 1> subBlocks {};
+    std::array<juce::int64, histogramBins> histogramCounts {};
+    std::array<double, histogramBins> histogramEnergy {};
+    double subBlockEnergy = 0.0, shortTermSum = 0.0;
+    juce::int64 subBlocksSeen = 0;
+    int subBlockLength = 4800, subBlockFill = 0, subBlockPosition = 0;
+    float momentary = silenceLufs, shortTerm = silenceLufs, integrated = silenceLufs;
+};
+} // namespace gls::dsp
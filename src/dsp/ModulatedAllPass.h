@@ -0,0 +1,172 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include <array>
+#include <vector>
+
+namespace gls::dsp
+{
+/** cos/sin of the normalised angular frequency on a fixed grid, so swept all-pass
+    coefficients can be re-derived at control rate without calling trig functions.
+    Linear interpolation over 1024 points keeps the error below 1e-6. */
+class AllPassCoefficientTable
+{
+public:
+    static constexpr int size = 1024;
+
+    static const AllPassCoefficientTable& get()
+    {
+        static const AllPassCoefficientTable table;
+        return table;
+    }
+
+    /** RBJ second-order all-pass at normalisedFrequency (f / fs). The section is
+        b = { c2, c1, 1 }, a = { 1, c1, c2 }, identical to IIR::ArrayCoefficients::makeAllPass. */
+    void lookup (float normalisedFrequency, float q, float& c1, float& c2) const noexcept
+    {
+        const auto position = juce::jlimit (0.0f, (float) size - 1.0e-3f, normalisedFrequency * 2.0f * (float) size);
+        const auto index = (int) position;
+        const auto frac = position - (float) index;
+
+        const auto cosW = cosTable[(size_t) index] + frac * (cosTable[(size_t) index + 1] - cosTable[(size_t) index]);
+        const auto sinW = sinTable[(size_t) index] + frac * (sinTable[(size_t) index + 1] - sinTable[(size_t) index]);
+        const auto alpha = sinW / (2.0f * juce::jmax (1.0e-3f, q));
+        const auto norm = 1.0f / (1.0f + alpha);
+
+        c1 = -2.0f * cosW * norm;
+        c2 = (1.0f - alpha) * norm;
+    }
+
+private:
+    AllPassCoefficientTable()
+    {
+        for (int i = 0; i <= size; ++i)
+        {
+            const auto w = juce::MathConstants<double>::pi * (double) i / (double) size;
+            cosTable[(size_t) i] = (float) std::cos (w);
+            sinTable[(size_t) i] = (float) std::sin (w);
+        }
+    }
+
+    std::array<float, size + 1> cosTable {}, sinTable {};
+};
+
+/** Cascade of up to 12 swept second-order all-pass sections.
+
+    Coefficients are shared by every channel and ramp linearly, sample by sample,
+    towards targets supplied once per control interval, so the sweep is smooth and
+    does not depend on the host block size. Channels are packed into SIMD lanes. */
+class ModulatedAllPassCascade
+{
+public:
+    using Lanes = juce::dsp::SIMDRegister<float>;
+
+    static constexpr int maxStages = 12;
+    static constexpr int controlInterval = 16;
+    static constexpr int lanesPerGroup = (int) Lanes::SIMDNumElements;
+
+    void prepare (double sampleRate, int numChannels)
+    {
+        invSampleRate = 1.0f / (float) (sampleRate > 0.0 ? sampleRate : 44100.0);
+        groups.resize ((size_t) ((juce::jmax (1, numChannels) + lanesPerGroup - 1) / lanesPerGroup));
+        AllPassCoefficientTable::get();
+        reset();
+    }
+
+    void reset() noexcept
+    {
+        for (auto& group : groups)
+            group = {};
+
+        countdown = 0;
+        hasCoefficients = false;
+    }
+
+    void setNumStages (int newNumStages) noexcept
+    {
+        newNumStages = juce::jlimit (1, maxStages, newNumStages);
+
+        // Stages coming back into the chain start from silence rather than stale state.
+        for (auto& group : groups)
+            for (int s = numStages; s < newNumStages; ++s)
+                group.s1[(size_t) s] = group.s2[(size_t) s] = Lanes (0.0f);
+
+        numStages = newNumStages;
+    }
+
+    int getNumStages() const noexcept     { return numStages; }
+    int getNumGroups() const noexcept     { return (int) groups.size(); }
+
+    /** True when the next sample starts a new control interval and setTargets() must be called. */
+    bool needsTargets() const noexcept    { return countdown == 0; }
+
+    /** Target frequency per stage (Hz) and a shared Q, reached at the end of this interval. */
+    void setTargets (const float* frequencies, float q) noexcept
+    {
+        const auto& table = AllPassCoefficientTable::get();
+        constexpr auto invInterval = 1.0f / (float) controlInterval;
+
+        for (int s = 0; s < numStages; ++s)
+        {
+            float t1, t2;
+            table.lookup (frequencies[s] * invSampleRate, q, t1, t2);
+
+            if (hasCoefficients)
+            {
+                d1[(size_t) s] = (t1 - c1[(size_t) s]) * invInterval;
+                d2[(size_t) s] = (t2 - c2[(size_t) s]) * invInterval;
+            }
+            else
+            {
+                c1[(size_t) s] = t1;
+                c2[(size_t) s] = t2;
+                d1[(size_t) s] = d2[(size_t) s] = 0.0f;
+            }
+        }
+
+        hasCoefficients = true;
+        countdown = controlInterval;
+    }
+
+    /** Runs one sample of lane group `group` (channels group * lanesPerGroup onwards) through the chain. */
+    Lanes processSample (int group, Lanes x) noexcept
+    {
+        auto& state = groups[(size_t) group];
+
+        for (int s = 0; s < numStages; ++s)
+        {
+            const auto y = x * c2[(size_t) s] + state.s1[(size_t) s];
+            state.s1[(size_t) s] = (x - y) * c1[(size_t) s] + state.s2[(size_t) s];
+            state.s2[(size_t) s] = x - y * c2[(size_t) s];
+            x = y;
+        }
+
+        return x;
+    }
+
+    /** Call once per sample after every group has been processed. */
+    void advance() noexcept
+    {
+        --countdown;
+
+        for (int s = 0; s < numStages; ++s)
+        {
+            c1[(size_t) s] += d1[(size_t) s];
+            c2[(size_t) s] += d2[(size_t) s];
+        }
+    }
+
+private:
+    struct GroupState
+    {
+        std::array<Lanes, maxStages> s1 {}, s2 {};
+    };
+
+    std::vector<GroupState> groups;
+    std::array<float, maxStages> c1 {}, c2 {}, d1 {}, d2 {};
+    float invSampleRate = 1.0f / 44100.0f;
+    int numStages = maxStages;
+    int countdown = 0;
+    bool hasCoefficients = false;
+};
+} // namespace gls::dsp
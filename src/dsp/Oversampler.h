@@ -0,0 +1,184 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include "../SmoothedParameter.h"
+#include <array>
+#include <atomic>
+#include <memory>
+#include <vector>
+
+namespace gls::dsp
+{
+/** Oversampling stage shared by the GRD saturators: 1x/2x/4x/8x, with half-band polyphase
+    IIR filters for live use and linear-phase equiripple FIR filters for high quality.
+
+    Every factor/filter combination is built in prepare(), so switching from the audio
+    thread never allocates. All stages run with integer latency so the figure can be
+    handed straight to LatencyReporter. Processors run their dry/wet mix inside the
+    oversampled callback, which keeps the dry path aligned in either filter mode. */
+template <typename SampleType>
+class Oversampler
+{
+public:
+    enum class Mode
+    {
+        live,           // polyphase IIR
+        highQuality,    // linear-phase FIR
+        automatic       // live in real time, high quality when the host renders offline
+    };
+
+    static constexpr int maxFactorLog2 = 3;
+
+    static constexpr const char* factorParameterId = "os_factor";
+    static constexpr const char* modeParameterId   = "os_mode";
+
+    /** The two parameters every oversampled processor exposes. The factor defaults to
+        1x, so sessions saved before oversampling existed reload with the same sound and
+        latency; users opt in. */
+    static void addParameters (std::vector<std::unique_ptr<juce::RangedAudioParameter>>& params,
+                               int defaultFactorLog2 = 0)
+    {
+        params.push_back (std::make_unique<juce::AudioParameterChoice> (factorParameterId, "Oversampling",
+                                                                        juce::StringArray { "1x", "2x", "4x", "8x" }, defaultFactorLog2));
+        params.push_back (std::make_unique<juce::AudioParameterChoice> (modeParameterId, "Oversampling Mode",
+                                                                        juce::StringArray { "Live", "High Quality", "Auto" }, 2));
+    }
+
+    void prepare (int numChannels, int maximumBlockSize)
+    {
+        channels = juce::jmax (1, numChannels);
+        blockSize = juce::jmax (1, maximumBlockSize);
+
+        for (int filter = 0; filter < 2; ++filter)
+        {
+            for (int order = 1; order <= maxFactorLog2; ++order)
+            {
+                const auto type = filter == 0 ? juce::dsp::Oversampling<SampleType>::filterHalfBandPolyphaseIIR
+                                              : juce::dsp::Oversampling<SampleType>::filterHalfBandFIREquiripple;
+
+                auto& stage = stages[(size_t) filter][(size_t) order - 1];
+                stage = std::make_unique<juce::dsp::Oversampling<SampleType>> ((size_t) channels, (size_t) order, type,
+                                                                               filter == 1, true);
+                stage->initProcessing ((size_t) blockSize);
+            }
+        }
+
+        reset();
+    }
+
+    void reset() noexcept
+    {
+        for (auto& filter : stages)
+            for (auto& stage : filter)
+                if (stage != nullptr)
+                    stage->reset();
+    }
+
+    /** Resolves both parameters once, from the processor's constructor, so update()
+        never looks them up by name on the audio thread. */
+    void attach (juce::AudioProcessorValueTreeState& state)
+    {
+        factorParameter = state.getRawParameterValue (factorParameterId);
+        modeParameter = state.getRawParameterValue (modeParameterId);
+        jassert (factorParameter != nullptr && modeParameter != nullptr);
+    }
+
+    /** Reads both parameters and selects the matching stage. Returns true if the
+        selection changed, in which case the caller should re-report latency. */
+    bool update (bool isNonRealtime) noexcept
+    {
+        const auto newFactor = juce::jlimit (0, maxFactorLog2, (int) factorParameter->load (std::memory_order_relaxed));
+        const auto mode = (Mode) juce::jlimit (0, 2, (int) modeParameter->load (std::memory_order_relaxed));
+        const auto useFir = mode == Mode::highQuality || (mode == Mode::automatic && isNonRealtime);
+
+        if (newFactor == factorLog2 && useFir == usingFir)
+            return false;
+
+        factorLog2 = newFactor;
+        usingFir = useFir;
+
+        if (auto* stage = getCurrentStage())
+            stage->reset();
+
+        return true;
+    }
+
+    /** update() for processors with smoothers inside the process() callback: on a change
+        they move to the new rate, so each ramp keeps its length in seconds. Linear gains
+        such as trims commute with the filters and are better applied at the host rate,
+        either side of process(), where they never need re-rating. */
+    bool update (bool isNonRealtime, double hostSampleRate,
+                 std::initializer_list<SmoothedParameter*> oversampledSmoothers) noexcept
+    {
+        if (! update (isNonRealtime))
+            return false;
+
+        for (auto* smoother : oversampledSmoothers)
+            smoother->setSampleRate (hostSampleRate * getFactor());
+
+        return true;
+    }
+
+    int getFactor() const noexcept                      { return getCurrentStage() != nullptr ? 1 << factorLog2 : 1; }
+    bool isHighQuality() const noexcept                 { return usingFir; }
+
+    int getLatencySamples() const noexcept
+    {
+        if (auto* stage = getCurrentStage())
+            return juce::roundToInt (stage->getLatencyInSamples());
+
+        return 0;
+    }
+
+    /** The most any factor and filter can report, for sizing latency-matched paths. */
+    int getMaximumLatencySamples() const noexcept
+    {
+        int maximum = 0;
+        for (auto& filter : stages)
+            for (auto& stage : filter)
+                if (stage != nullptr)
+                    maximum = juce::jmax (maximum, juce::roundToInt (stage->getLatencyInSamples()));
+
+        return maximum;
+    }
+
+    /** Runs processOversampled (juce::dsp::AudioBlock<SampleType>&) at getFactor() times the
+        host rate, in chunks no longer than the prepared block size. At 1x the callback
+        receives the host buffer directly. */
+    template <typename Callback>
+    void process (juce::AudioBuffer<SampleType>& buffer, Callback&& processOversampled)
+    {
+        juce::dsp::AudioBlock<SampleType> block (buffer);
+        block = block.getSubsetChannelBlock (0, juce::jmin ((size_t) channels, block.getNumChannels()));
+
+        auto* stage = getCurrentStage();
+        if (stage == nullptr)
+        {
+            processOversampled (block);
+            return;
+        }
+
+        const auto numSamples = block.getNumSamples();
+        for (size_t start = 0; start < numSamples; start += (size_t) blockSize)
+        {
+            auto chunk = block.getSubBlock (start, juce::jmin ((size_t) blockSize, numSamples - start));
+            auto oversampled = stage->processSamplesUp (chunk);
+            processOversampled (oversampled);
+            stage->processSamplesDown (chunk);
+        }
+    }
+
+private:
+    juce::dsp::Oversampling<SampleType>* getCurrentStage() const noexcept
+    {
+        return factorLog2 > 0 ? stages[usingFir ? 1 : 0][(size_t) factorLog2 - 1].get() : nullptr;
+    }
+
+    std::array<std::array<std::unique_ptr<juce::dsp::Oversampling<SampleType>>, maxFactorLog2>, 2> stages;
+    std::atomic<float>* factorParameter = nullptr;
+    std::atomic<float>* modeParameter = nullptr;
+    int channels = 2, blockSize = 512;
+    int factorLog2 = 0;
+    bool usingFir = false;
+};
+} // namespace gls::dsp
@@ -0,0 +1,733 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include "FFTEngine.h"
+#include <array>
+#include <atomic>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace gls::dsp
+{
+/** Zero-latency non-uniformly partitioned convolution for IRs of several seconds.
+
+    The first headSize taps run as a direct-form FIR, the next stretch up to largeOffset
+    in headSize partitions (FFT of 2 * headSize), and everything after in largeSize
+    partitions. The small level starts one partition into the IR, so its overlap-save
+    output is due as soon as a block completes. The large level starts two partitions
+    in, which leaves it a whole largeSize period of slack: its forward FFTs, partition
+    products and inverse FFTs are spread over the stepsPerLarge small blocks of each
+    period instead of landing on one audio callback.
+
+    The small input spectra are preallocated per channel. The large ones grow with the
+    IR, so they belong to it: createImpulseResponse() sizes an InputHistory for the IR
+    and whatever it may replace, and when the IR is taken the live spectra move over
+    by swapping frame vectors. With no IR loaded the large level costs nothing.
+
+    Both IR slots share the input spectra. A new IR is taken into the idle slot at a
+    large-partition boundary and renders unheard for one period, until its output
+    covers every partition, then crossfades in over fadeSeconds, so swaps are
+    seamless. IRs are handed over with setImpulseResponse(); replaced ones come back
+    through collectRetired() so no slot is ever freed on the audio thread. */
+class PartitionedConvolver
+{
+public:
+    static constexpr int headSize = 128;
+    static constexpr int largeSize = 2048;
+    static constexpr int largeOffset = largeSize * 2;
+    static constexpr int smallPartitions = largeOffset / headSize - 1;
+    static constexpr int stepsPerLarge = largeSize / headSize;
+    static constexpr double fadeSeconds = 0.05;
+
+    /** One block size of partitions per channel, as split real/imaginary spectra. */
+    struct Partitions
+    {
+        int count = 0, bins = 0;
+        std::vector<float> real, imag;      // count * bins
+
+        const float* getReal (int index) const noexcept { return real.data() + (size_t) (index * bins); }
+        const float* getImag (int index) const noexcept { return imag.data() + (size_t) (index * bins); }
+    };
+
+    /** Large-level input spectra, a ring of capacity frames per channel. Each frame is
+        its own vector, real bins then imaginary, so frames can change hands by swapping. */
+    struct InputHistory
+    {
+        int numChannels = 0, capacity = 0;
+        std::vector<std::vector<float>> frames;     // [channel * capacity + index]
+
+        float* getFrame (int channel, int index) noexcept { return frames[(size_t) (channel * capacity + index)].data(); }
+    };
+
+    struct ImpulseResponse
+    {
+        int numChannels = 0, length = 0;
+        std::vector<std::vector<float>> head;       // [channel][headSize]
+        std::vector<Partitions> small, large;       // [channel]
+        InputHistory history;                       // live while this is the newest IR taken
+
+        int getLargeCount() const noexcept          { return large.empty() ? 0 : large.front().count; }
+    };
+
+    ~PartitionedConvolver()
+    {
+        for (auto& slot : slots)
+            delete slot.ir;
+
+        delete pending.exchange (nullptr);
+        delete retired.exchange (nullptr);
+    }
+
+    /** Sizes the fixed buffers and drops any loaded IR. Not concurrent with process(). */
+    void prepare (double sampleRate, int maxChannels)
+    {
+        smallFFT.prepare (juce::roundToInt (std::log2 (2 * headSize)));
+        largeFFT.prepare (juce::roundToInt (std::log2 (2 * largeSize)));
+        fadeLength = juce::jmax (1, juce::roundToInt (sampleRate * fadeSeconds));
+
+        channels.resize ((size_t) juce::jmax (1, maxChannels));
+        for (auto& state : channels)
+        {
+            state.smallWindow.assign ((size_t) headSize * 2, 0.0f);
+            state.largeWindow.assign ((size_t) largeSize * 2, 0.0f);
+            state.smallSpectra.assign ((size_t) (smallPartitions * smallBins * 2), 0.0f);
+
+            for (auto& ring : state.output)
+                ring.assign ((size_t) ringSize, 0.0f);
+
+            for (auto& sum : state.largeSum)
+                sum.assign ((size_t) largeBins * 2, 0.0f);
+        }
+
+        fftData.assign ((size_t) largeSize * 4, 0.0f);
+        smallSum.assign ((size_t) smallBins * 2, 0.0f);
+        for (auto& scratch : slotScratch)
+            scratch.assign ((size_t) headSize, 0.0f);
+
+        for (auto& slot : slots)
+        {
+            delete slot.ir;
+            slot.ir = nullptr;
+        }
+
+        delete pending.exchange (nullptr);
+        history = nullptr;
+        historyChannels.store ((int) channels.size(), std::memory_order_relaxed);
+        liveLargeCount.store (0, std::memory_order_relaxed);
+        queuedLargeCount.store (0, std::memory_order_relaxed);
+        fadePosition = fadeLength;
+        priming = false;
+        reset();
+    }
+
+    void reset() noexcept
+    {
+        for (auto& state : channels)
+        {
+            std::fill (state.smallWindow.begin(), state.smallWindow.end(), 0.0f);
+            std::fill (state.largeWindow.begin(), state.largeWindow.end(), 0.0f);
+            std::fill (state.smallSpectra.begin(), state.smallSpectra.end(), 0.0f);
+
+            for (auto& ring : state.output)
+                std::fill (ring.begin(), ring.end(), 0.0f);
+
+            for (auto& sum : state.largeSum)
+                std::fill (sum.begin(), sum.end(), 0.0f);
+        }
+
+        // Partial products restart with the next full period.
+        for (auto& slot : slots)
+            slot.rendersLarge = false;
+
+        if (history != nullptr)
+            for (auto& frame : history->frames)
+                std::fill (frame.begin(), frame.end(), 0.0f);
+
+        smallPosition = largePosition = 0;
+        newestSmall = newestLarge = 0;
+        ringPosition = 0;
+    }
+
+    //==============================================================================
+    /** Any non-audio thread: partitions an IR of up to maximumLength samples and sizes
+        the input history it will run on. Allocates and runs FFTs. An empty buffer makes
+        an IR that outputs silence. */
+    std::unique_ptr<ImpulseResponse> createImpulseResponse (const juce::AudioBuffer<float>& source,
+                                                            int maximumLength) const
+    {
+        auto ir = std::make_unique<ImpulseResponse>();
+        ir->numChannels = juce::jmin (2, source.getNumChannels());
+        ir->length = juce::jmin (source.getNumSamples(), maximumLength);
+
+        const auto smallCount = juce::jlimit (0, smallPartitions, (ir->length - headSize + headSize - 1) / headSize);
+        const auto largeCount = juce::jmax (0, (ir->length - largeOffset + largeSize - 1) / largeSize);
+
+        ir->head.resize ((size_t) ir->numChannels);
+        ir->small.resize ((size_t) ir->numChannels);
+        ir->large.resize ((size_t) ir->numChannels);
+
+        for (int ch = 0; ch < ir->numChannels; ++ch)
+        {
+            const auto* data = source.getReadPointer (ch);
+            auto& head = ir->head[(size_t) ch];
+            head.assign ((size_t) headSize, 0.0f);
+            std::copy (data, data + juce::jmin (headSize, ir->length), head.begin());
+
+            partition (data, ir->length, headSize, headSize, smallCount, ir->small[(size_t) ch]);
+            partition (data, ir->length, largeOffset, largeSize, largeCount, ir->large[(size_t) ch]);
+        }
+
+        // The IR that is live, or queued ahead of this one, runs on this history while it
+        // fades out, so it must hold their partitions too. Should a race slip past both,
+        // the outgoing IR just loses its late tail for the fade.
+        auto& inputs = ir->history;
+        inputs.numChannels = historyChannels.load (std::memory_order_relaxed);
+        inputs.capacity = juce::jmax (largeCount,
+                                      liveLargeCount.load (std::memory_order_relaxed),
+                                      queuedLargeCount.load (std::memory_order_relaxed));
+        inputs.frames.assign ((size_t) (inputs.numChannels * inputs.capacity),
+                              std::vector<float> ((size_t) largeBins * 2, 0.0f));
+        return ir;
+    }
+
+    /** Any non-audio thread: queues an IR to crossfade to. An IR queued earlier that was
+        not yet picked up is returned to the caller to free. */
+    std::unique_ptr<ImpulseResponse> setImpulseResponse (std::unique_ptr<ImpulseResponse> ir) noexcept
+    {
+        queuedLargeCount.store (ir != nullptr ? ir->getLargeCount() : 0, std::memory_order_relaxed);
+        return std::unique_ptr<ImpulseResponse> (pending.exchange (ir.release(), std::memory_order_acq_rel));
+    }
+
+    /** Any non-audio thread: an IR the audio thread has finished with, if any. */
+    std::unique_ptr<ImpulseResponse> collectRetired() noexcept
+    {
+        return std::unique_ptr<ImpulseResponse> (retired.exchange (nullptr, std::memory_order_acq_rel));
+    }
+
+    /** True once an IR with audio has been taken into a slot, including while it fades in. */
+    bool hasImpulseResponse() const noexcept
+    {
+        const auto* ir = slots[(size_t) activeSlot].ir;
+        return ir != nullptr && ir->numChannels > 0;
+    }
+
+    /** Audio thread: the longest IR in either slot, in samples, including one fading out. */
+    int getImpulseResponseLength() const noexcept
+    {
+        int length = 0;
+        for (int slot = 0; slot < 2; ++slot)
+            if (const auto* ir = getSlotIR (slot))
+                length = juce::jmax (length, ir->length);
+
+        return length;
+    }
+
+    //==============================================================================
+    /** Convolves numSamples of input into output. Channels beyond the IR's reuse its last. */
+    void process (const juce::AudioBuffer<float>& input, juce::AudioBuffer<float>& output, int numSamples) noexcept
+    {
+        const auto numChannels = juce::jmin ((int) channels.size(), input.getNumChannels(), output.getNumChannels());
+
+        for (int start = 0; start < numSamples;)
+        {
+            const auto length = juce::jmin (numSamples - start, headSize - smallPosition);
+
+            for (int ch = 0; ch < numChannels; ++ch)
+                processSegment (ch, input.getReadPointer (ch, start), output.getWritePointer (ch, start), length);
+
+            smallPosition += length;
+            largePosition += length;
+            ringPosition = (ringPosition + length) & (ringSize - 1);
+            fadePosition = juce::jmin (fadeLength, fadePosition + length);
+            start += length;
+
+            if (smallPosition < headSize)
+                continue;
+
+            // Slots change before either level renders, so an incoming IR's first
+            // outputs already cover every partition.
+            if (largePosition == largeSize)
+            {
+                largePosition = 0;
+                updateSlots (numChannels);
+            }
+
+            smallPosition = 0;
+            newestSmall = (newestSmall + 1) % smallPartitions;
+
+            for (int ch = 0; ch < numChannels; ++ch)
+                processSmallBlock (channels[(size_t) ch], ch);
+
+            processLargeStep (numChannels, largePosition / headSize);
+        }
+    }
+
+private:
+    static constexpr int smallBins = headSize + 1, largeBins = largeSize + 1;
+    static constexpr int ringSize = largeSize * 2;
+
+    struct Slot
+    {
+        ImpulseResponse* ir = nullptr;
+        bool rendersLarge = false;      // fixed for the current large period
+    };
+
+    struct ChannelState
+    {
+        std::vector<float> smallWindow, largeWindow;    // previous block, then the current one
+        std::vector<float> smallSpectra;                // ring of frames, newest at newestSmall
+        std::array<std::vector<float>, 2> output;       // per slot, future partition output
+        std::array<std::vector<float>, 2> largeSum;     // per slot, the period's partial products
+    };
+
+    static void partition (const float* data, int length, int offset, int size, int count, Partitions& result)
+    {
+        FFTEngine fft;
+        fft.prepare (juce::roundToInt (std::log2 (2 * size)));
+        std::vector<float> buffer ((size_t) size * 4, 0.0f);
+
+        result.count = count;
+        result.bins = size + 1;
+        result.real.assign ((size_t) (count * result.bins), 0.0f);
+        result.imag.assign ((size_t) (count * result.bins), 0.0f);
+
+        for (int k = 0; k < count; ++k)
+        {
+            std::fill (buffer.begin(), buffer.end(), 0.0f);
+            const auto start = offset + k * size;
+            const auto available = juce::jlimit (0, size, length - start);
+            std::copy (data + start, data + start + available, buffer.begin());
+            fft->performRealOnlyForwardTransform (buffer.data(), true);
+
+            for (int bin = 0; bin < result.bins; ++bin)
+            {
+                result.real[(size_t) (k * result.bins + bin)] = buffer[(size_t) (2 * bin)];
+                result.imag[(size_t) (k * result.bins + bin)] = buffer[(size_t) (2 * bin + 1)];
+            }
+        }
+    }
+
+    const ImpulseResponse* getSlotIR (int slot) const noexcept
+    {
+        const auto* ir = slots[(size_t) slot].ir;
+        return ir != nullptr && ir->numChannels > 0 ? ir : nullptr;
+    }
+
+    bool isFading() const noexcept                      { return fadePosition < fadeLength; }
+    bool isRendering (int slot) const noexcept          { return slot == activeSlot || isFading() || priming; }
+
+    void processSegment (int channel, const float* in, float* out, int length) noexcept
+    {
+        auto& state = channels[(size_t) channel];
+        auto* current = state.smallWindow.data() + headSize + smallPosition;
+        std::copy (in, in + length, current);
+        std::copy (in, in + length, state.largeWindow.data() + largeSize + largePosition);
+
+        auto consumeRing = [&] (int slot, float* destination)
+        {
+            auto& ring = state.output[(size_t) slot];
+            const auto first = juce::jmin (length, ringSize - ringPosition);
+
+            if (destination != nullptr)
+            {
+                std::copy (ring.data() + ringPosition, ring.data() + ringPosition + first, destination);
+                std::copy (ring.data(), ring.data() + length - first, destination + first);
+            }
+
+            std::fill (ring.data() + ringPosition, ring.data() + ringPosition + first, 0.0f);
+            std::fill (ring.data(), ring.data() + length - first, 0.0f);
+        };
+
+        // Direct-form head plus whatever the partition levels have already placed here.
+        auto renderSlot = [&] (int slot, float* destination)
+        {
+            consumeRing (slot, destination);
+
+            if (const auto* ir = getSlotIR (slot))
+            {
+                const auto& head = ir->head[(size_t) juce::jmin (channel, ir->numChannels - 1)];
+                for (int k = 0; k < headSize; ++k)
+                    if (head[(size_t) k] != 0.0f)
+                        juce::FloatVectorOperations::addWithMultiply (destination, current - k, head[(size_t) k], length);
+            }
+        };
+
+        renderSlot (activeSlot, out);
+
+        // A priming IR is not heard yet; its ring only has to keep pace.
+        if (priming)
+            consumeRing (1 - activeSlot, nullptr);
+
+        if (! isFading())
+            return;
+
+        // Linear crossfade: both slots hear the same input, so their outputs are correlated.
+        auto* outgoing = slotScratch[0].data();
+        renderSlot (1 - activeSlot, outgoing);
+
+        const auto step = 1.0f / (float) fadeLength;
+        for (int i = 0; i < length; ++i)
+        {
+            const auto gain = juce::jmin (1.0f, (float) (fadePosition + i) * step);
+            out[i] = outgoing[i] + gain * (out[i] - outgoing[i]);
+        }
+    }
+
+    void processSmallBlock (ChannelState& state, int channel) noexcept
+    {
+        auto frameAt = [&state] (int index) -> const float* { return state.smallSpectra.data() + index * smallBins * 2; };
+        transformInput (*smallFFT, state.smallWindow.data(), headSize,
+                        state.smallSpectra.data() + newestSmall * smallBins * 2, smallBins);
+
+        for (int slot = 0; slot < 2; ++slot)
+        {
+            if (const auto* ir = getSlotIR (slot); ir != nullptr && isRendering (slot))
+            {
+                const auto& partitions = ir->small[(size_t) juce::jmin (channel, ir->numChannels - 1)];
+                if (partitions.count == 0)
+                    continue;
+
+                juce::FloatVectorOperations::clear (smallSum.data(), smallBins * 2);
+                accumulate (partitions, frameAt, newestSmall, smallPartitions, 0, partitions.count, smallSum.data(), smallBins);
+                addInverse (*smallFFT, smallSum.data(), smallBins, headSize, 0, state.output[(size_t) slot]);
+            }
+        }
+
+        std::copy (state.smallWindow.begin() + headSize, state.smallWindow.end(), state.smallWindow.begin());
+    }
+
+    /** One of the stepsPerLarge slices of the large level. The first transforms the
+        block that just completed, the middle ones work through the partitions, and the
+        last transforms back. The result was computed one period early, so it lands
+        headSize ahead of now, where the output from one period after the block starts. */
+    void processLargeStep (int numChannels, int step) noexcept
+    {
+        const auto tracked = history != nullptr && history->capacity > 0;
+
+        if (step == 0)
+        {
+            for (int slot = 0; slot < 2; ++slot)
+                slots[(size_t) slot].rendersLarge = tracked && getSlotIR (slot) != nullptr && isRendering (slot);
+
+            if (tracked)
+                newestLarge = (newestLarge + 1) % history->capacity;
+
+            for (int ch = 0; ch < numChannels; ++ch)
+            {
+                auto& state = channels[(size_t) ch];
+
+                if (tracked)
+                {
+                    transformInput (*largeFFT, state.largeWindow.data(), largeSize, history->getFrame (ch, newestLarge), largeBins);
+
+                    for (auto& sum : state.largeSum)
+                        std::fill (sum.begin(), sum.end(), 0.0f);
+                }
+
+                std::copy (state.largeWindow.begin() + largeSize, state.largeWindow.end(), state.largeWindow.begin());
+            }
+        }
+
+        if (! tracked)
+            return;
+
+        constexpr auto productSteps = stepsPerLarge - 1;
+
+        for (int ch = 0; ch < numChannels; ++ch)
+        {
+            auto& state = channels[(size_t) ch];
+            auto frameAt = [this, ch] (int index) -> const float* { return history->getFrame (ch, index); };
+
+            for (int slot = 0; slot < 2; ++slot)
+            {
+                if (! slots[(size_t) slot].rendersLarge)
+                    continue;
+
+                const auto* ir = slots[(size_t) slot].ir;
+                const auto& partitions = ir->large[(size_t) juce::jmin (ch, ir->numChannels - 1)];
+                const auto count = juce::jmin (partitions.count, history->capacity);
+                auto* sum = state.largeSum[(size_t) slot].data();
+
+                if (count == 0)
+                    continue;
+
+                if (step < productSteps)
+                    accumulate (partitions, frameAt, newestLarge, history->capacity,
+                                step * count / productSteps, (step + 1) * count / productSteps, sum, largeBins);
+                else
+                    addInverse (*largeFFT, sum, largeBins, largeSize, headSize, state.output[(size_t) slot]);
+            }
+        }
+    }
+
+    void transformInput (const juce::dsp::FFT& fft, const float* window, int size, float* frame, int bins) noexcept
+    {
+        std::copy (window, window + size * 2, fftData.begin());
+        fft.performRealOnlyForwardTransform (fftData.data(), true);
+
+        for (int bin = 0; bin < bins; ++bin)
+        {
+            frame[bin] = fftData[(size_t) (2 * bin)];
+            frame[bins + bin] = fftData[(size_t) (2 * bin + 1)];
+        }
+    }
+
+    /** Adds partitions [first, last) times the input frames into sum (real bins then
+        imaginary), the newest frame with the first partition. */
+    template <typename FrameAt>
+    static void accumulate (const Partitions& partitions, FrameAt frameAt, int newest, int capacity,
+                            int first, int last, float* sum, int bins) noexcept
+    {
+        using FVO = juce::FloatVectorOperations;
+        auto* sumReal = sum;
+        auto* sumImag = sum + bins;
+
+        for (int k = first; k < juce::jmin (last, capacity); ++k)
+        {
+            const auto* xr = frameAt ((newest - k + capacity) % capacity);
+            const auto* xi = xr + bins;
+            const auto* hr = partitions.getReal (k);
+            const auto* hi = partitions.getImag (k);
+
+            FVO::addWithMultiply (sumReal, xr, hr, bins);
+            FVO::subtractWithMultiply (sumReal, xi, hi, bins);
+            FVO::addWithMultiply (sumImag, xr, hi, bins);
+            FVO::addWithMultiply (sumImag, xi, hr, bins);
+        }
+    }
+
+    /** Transforms a summed spectrum back and adds its valid half to a slot's output ring,
+        offset samples from now. */
+    void addInverse (const juce::dsp::FFT& fft, const float* sum, int bins, int size, int offset,
+                     std::vector<float>& ring) noexcept
+    {
+        for (int bin = 0; bin < bins; ++bin)
+        {
+            fftData[(size_t) (2 * bin)] = sum[bin];
+            fftData[(size_t) (2 * bin + 1)] = sum[bins + bin];
+        }
+
+        fft.performRealOnlyInverseTransform (fftData.data());
+
+        const auto* valid = fftData.data() + size;
+        const auto position = (ringPosition + offset) & (ringSize - 1);
+        const auto first = juce::jmin (size, ringSize - position);
+        juce::FloatVectorOperations::add (ring.data() + position, valid, first);
+        juce::FloatVectorOperations::add (ring.data(), valid + first, size - first);
+    }
+
+    /** At a large boundary: bring a primed IR in, retire the slot a finished fade left
+        behind, or take a queued IR into the idle slot to prime. Waits while a fade runs
+        or the previous retiree is still uncollected. */
+    void updateSlots (int numChannels) noexcept
+    {
+        if (priming)
+        {
+            priming = false;
+            activeSlot = 1 - activeSlot;
+            fadePosition = 0;
+            return;
+        }
+
+        if (isFading() || retired.load (std::memory_order_acquire) != nullptr)
+            return;
+
+        auto& idle = slots[(size_t) (1 - activeSlot)];
+        if (idle.ir != nullptr)
+        {
+            retired.store (std::exchange (idle.ir, nullptr), std::memory_order_release);
+            return;
+        }
+
+        auto* incoming = pending.exchange (nullptr, std::memory_order_acq_rel);
+        if (incoming == nullptr)
+            return;
+
+        // Made for another channel count (prepare() ran after it was queued): drop it.
+        if (incoming->history.numChannels != (int) channels.size())
+        {
+            retired.store (incoming, std::memory_order_release);
+            return;
+        }
+
+        adoptHistory (incoming->history);
+        liveLargeCount.store (incoming->getLargeCount(), std::memory_order_relaxed);
+        idle.ir = incoming;
+        priming = true;
+
+        for (int ch = 0; ch < numChannels; ++ch)
+        {
+            auto& ring = channels[(size_t) ch].output[(size_t) (1 - activeSlot)];
+            std::fill (ring.begin(), ring.end(), 0.0f);
+        }
+    }
+
+    /** Moves the newest live input spectra into an incoming IR's history, newest at 0. */
+    void adoptHistory (InputHistory& next) noexcept
+    {
+        if (history != nullptr)
+        {
+            const auto kept = juce::jmin (history->capacity, next.capacity);
+
+            for (int ch = 0; ch < next.numChannels; ++ch)
+                for (int k = 0; k < kept; ++k)
+                    std::swap (next.frames[(size_t) (ch * next.capacity + (next.capacity - k) % next.capacity)],
+                               history->frames[(size_t) (ch * history->capacity + (newestLarge - k + history->capacity) % history->capacity)]);
+        }
+
+        history = &next;
+        newestLarge = 0;
+    }
+
+    FFTEngine smallFFT, largeFFT;
+    int smallPosition = 0, largePosition = 0, newestSmall = 0, newestLarge = 0, ringPosition = 0;
+    int fadeLength = 1, fadePosition = 0;
+    bool priming = false;
+
+    std::vector<ChannelState> channels;
+    std::vector<float> fftData, smallSum;
+    std::array<std::vector<float>, 1> slotScratch;
+
+    std::array<Slot, 2> slots;
+    int activeSlot = 0;
+    InputHistory* history = nullptr;                // owned by the newest IR taken
+    std::atomic<ImpulseResponse*> pending { nullptr }, retired { nullptr };
+    std::atomic<int> historyChannels { 1 }, liveLargeCount { 0 }, queuedLargeCount { 0 };
+};
+//==============================================================================
+/** Reads IR files for a PartitionedConvolver on its own thread: decodes, resamples to
+    the session rate, trims the silent tail, normalises to unit energy and partitions,
+    then queues the result. Also frees whatever the convolver hands back, so the audio
+    thread never allocates or deallocates. Requests made while one is in flight replace
+    it; only the newest is loaded. */
+class ImpulseResponseLoader : private juce::Thread
+{
+public:
+    explicit ImpulseResponseLoader (PartitionedConvolver& target)
+        : juce::Thread ("GLS IR Loader"), convolver (target)
+    {
+        formats.registerBasicFormats();
+        startThread (juce::Thread::Priority::low);
+    }
+
+    ~ImpulseResponseLoader() override                   { stopThread (2000); }
+
+    /** Any non-audio thread. An empty file queues a silent IR. */
+    void load (const juce::File& file, double sampleRate, int maximumLength)
+    {
+        {
+            const juce::ScopedLock sl (requestLock);
+            request = { file, sampleRate, maximumLength };
+        }
+
+        requested = true;
+        notify();
+    }
+
+    /** True once the last requested file failed to decode. */
+    bool hasFailed() const noexcept                     { return failed.load (std::memory_order_relaxed); }
+
+private:
+    struct Request
+    {
+        juce::File file;
+        double sampleRate = 44100.0;
+        int maximumLength = 0;
+    };
+
+    static constexpr float silenceThreshold = 1.0e-4f;  // -80 dB relative to the peak
+
+    void run() override
+    {
+        while (! threadShouldExit())
+        {
+            convolver.collectRetired();
+
+            if (requested.exchange (false))
+            {
+                Request next;
+                {
+                    const juce::ScopedLock sl (requestLock);
+                    next = request;
+                }
+
+                juce::AudioBuffer<float> ir;
+                const auto ok = next.file == juce::File() || read (next, ir);
+                failed = ! ok;
+
+                if (ok)
+                    convolver.setImpulseResponse (convolver.createImpulseResponse (ir, next.maximumLength));
+            }
+
+            wait (50);
+        }
+    }
+
+    bool read (const Request& next, juce::AudioBuffer<float>& ir)
+    {
+        std::unique_ptr<juce::AudioFormatReader> reader (formats.createReaderFor (next.file));
+        if (reader == nullptr || reader->lengthInSamples <= 0 || reader->sampleRate <= 0.0)
+            return false;
+
+        const auto ratio = reader->sampleRate / next.sampleRate;
+        const auto sourceLength = (int) juce::jmin (reader->lengthInSamples,
+                                                    (juce::int64) std::ceil ((next.maximumLength + 4) * ratio));
+        const auto numChannels = juce::jlimit (1, 2, (int) reader->numChannels);
+
+        juce::AudioBuffer<float> source (numChannels, sourceLength);
+        reader->read (&source, 0, sourceLength, 0, true, numChannels > 1);
+
+        const auto length = juce::jmin (next.maximumLength, (int) std::floor (sourceLength / ratio));
+        ir.setSize (numChannels, juce::jmax (0, length));
+
+        for (int ch = 0; ch < numChannels; ++ch)
+        {
+            if (juce::approximatelyEqual (ratio, 1.0))
+                ir.copyFrom (ch, 0, source, ch, 0, length);
+            else
+                juce::LagrangeInterpolator().process (ratio, source.getReadPointer (ch), ir.getWritePointer (ch), length);
+        }
+
+        // Trim the tail below the threshold, then scale the louder channel to unit energy.
+        const auto peak = ir.getMagnitude (0, ir.getNumSamples());
+        if (peak <= 0.0f)
+            return false;
+
+        auto end = ir.getNumSamples();
+        while (end > 0)
+        {
+            auto loudest = 0.0f;
+            for (int ch = 0; ch < numChannels; ++ch)
+                loudest = juce::jmax (loudest, std::abs (ir.getSample (ch, end - 1)));
+
+            if (loudest > peak * silenceThreshold)
+                break;
+
+            --end;
+        }
+
+        ir.setSize (numChannels, end, true);
+
+        auto energy = 0.0;
+        for (int ch = 0; ch < numChannels; ++ch)
+        {
+            const auto* data = ir.getReadPointer (ch);
+            auto sum = 0.0;
+            for (int i = 0; i < end; ++i)
+                sum += (double) data[i] * data[i];
+
+            energy = juce::jmax (energy, sum);
+        }
+
+        ir.applyGain ((float) (1.0 / std::sqrt (energy)));
+        return true;
+    }
+
+    PartitionedConvolver& convolver;
+    juce::AudioFormatManager formats;
+    juce::CriticalSection requestLock;
+    Request request;
+    std::atomic<bool> requested { false }, failed { false };
+};
+} // namespace gls::dsp
@@ -0,0 +1,300 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include "FFTEngine.h"
+#include <vector>
+
+namespace gls::dsp
+{
+/** Streaming phase-vocoder pitch shifter with identity phase locking (Laroche & Dolson).
+
+    Each hop, the spectrum is split into regions around its magnitude peaks. A region
+    is moved to its peak's shifted bin and rotated as a whole, so the partials keep their
+    shape and the phase of each peak advances at the shifted instantaneous frequency.
+    That costs one complex multiply per bin and a few atan2 calls per peak; no per-bin
+    phase unwrapping. Frames use a periodic Hann window at 75% overlap, and the output
+    is delayed by exactly one frame, getLatencySamples(). Each instance owns its FFTEngine.
+
+    With formant preservation on, each frame's spectral envelope is estimated by
+    cepstral smoothing and every moved bin is rescaled from the envelope at its source
+    to the envelope at its destination, optionally itself shifted, so the vocal tract
+    stays put while the partials move. That costs two more transforms per frame. */
+class PhaseVocoderPitchShifter
+{
+public:
+    enum class Quality
+    {
+        lowLatency,     // ~21 ms frame
+        balanced,       // ~43 ms
+        highQuality     // ~85 ms
+    };
+
+    static constexpr int overlap = 4;
+
+    /** Frame size for a quality setting, kept at the same duration at any sample rate. */
+    static int getOrder (Quality quality, double sampleRate) noexcept
+    {
+        const auto base = quality == Quality::lowLatency ? 10 : (quality == Quality::balanced ? 11 : 12);
+        const auto rateSteps = juce::roundToInt (std::log2 (juce::jmax (1.0, sampleRate / 48000.0)));
+        return juce::jlimit (8, 14, base + rateSteps);
+    }
+
+    void prepare (double sampleRate, int maxChannels, Quality quality)
+    {
+        const auto order = getOrder (quality, sampleRate);
+        // Quefrencies below ~1.5 ms carry the envelope; voices up to ~650 Hz keep
+        // their harmonics above the cut.
+        lifterLength = juce::jlimit (8, (1 << order) / 4, juce::roundToInt (sampleRate * 0.0015));
+        fft.prepare (order);
+        fftSize = 1 << order;
+        hopSize = fftSize / overlap;
+        numBins = fftSize / 2 + 1;
+
+        // Periodic Hann analysis and synthesis windows sum to 1.5 at 75% overlap.
+        window.resize ((size_t) fftSize);
+        for (int i = 0; i < fftSize; ++i)
+            window[(size_t) i] = 0.5f - 0.5f * std::cos (juce::MathConstants<float>::twoPi * (float) i / (float) fftSize);
+
+        synthesisGain = 1.0f / 1.5f;
+
+        fftData.assign ((size_t) fftSize * 2, 0.0f);
+        shifted.assign ((size_t) numBins * 2, 0.0f);
+        power.assign ((size_t) numBins, 0.0f);
+        cepstrum.assign ((size_t) fftSize * 2, 0.0f);
+        logEnvelope.assign ((size_t) numBins, 0.0f);
+        peaks.assign ((size_t) numBins, 0);
+
+        channels.resize ((size_t) juce::jmax (1, maxChannels));
+        for (auto& state : channels)
+        {
+            state.input.assign ((size_t) fftSize, 0.0f);
+            state.output.assign ((size_t) fftSize, 0.0f);
+            state.lastAnalysis.assign ((size_t) numBins * 2, 0.0f);
+            state.lastSynthesis.assign ((size_t) numBins * 2, 0.0f);
+        }
+
+        reset();
+    }
+
+    void reset() noexcept
+    {
+        for (auto& state : channels)
+        {
+            std::fill (state.input.begin(), state.input.end(), 0.0f);
+            std::fill (state.output.begin(), state.output.end(), 0.0f);
+            std::fill (state.lastAnalysis.begin(), state.lastAnalysis.end(), 0.0f);
+            std::fill (state.lastSynthesis.begin(), state.lastSynthesis.end(), 0.0f);
+        }
+
+        writePosition = 0;
+        hopPosition = 0;
+    }
+
+    int getLatencySamples() const noexcept              { return fftSize; }
+    int getFrameSize() const noexcept                   { return fftSize; }
+
+    /** Keeps the spectral envelope in place while shifting, scaled in frequency by
+        formantRatio (1 = preserve exactly). */
+    void setFormantPreservation (bool shouldPreserve, float formantRatio = 1.0f) noexcept
+    {
+        preserveFormants = shouldPreserve;
+        envelopeScale = 1.0f / juce::jlimit (0.25f, 4.0f, formantRatio);
+    }
+
+    /** Shifts up to the prepared number of channels in place by ratio (0.25..4). */
+    void process (juce::AudioBuffer<float>& buffer, float ratio) noexcept
+    {
+        if (! fft.isPrepared())
+            return;
+
+        ratio = juce::jlimit (0.25f, 4.0f, ratio);
+        const auto numChannels = juce::jmin ((int) channels.size(), buffer.getNumChannels());
+        const auto numSamples = buffer.getNumSamples();
+
+        // Segments end on hop boundaries, which are multiples of hopSize, so they never
+        // wrap around the frame-sized rings.
+        for (int start = 0; start < numSamples;)
+        {
+            const auto length = juce::jmin (numSamples - start, hopSize - hopPosition);
+
+            for (int ch = 0; ch < numChannels; ++ch)
+            {
+                auto& state = channels[(size_t) ch];
+                auto* data = buffer.getWritePointer (ch, start);
+                auto* output = state.output.data() + writePosition;
+
+                std::copy (data, data + length, state.input.data() + writePosition);
+                std::copy (output, output + length, data);
+                std::fill (output, output + length, 0.0f);
+            }
+
+            writePosition = (writePosition + length) & (fftSize - 1);
+            hopPosition += length;
+            start += length;
+
+            if (hopPosition == hopSize)
+            {
+                hopPosition = 0;
+
+                for (int ch = 0; ch < numChannels; ++ch)
+                    processFrame (channels[(size_t) ch], ratio);
+            }
+        }
+    }
+
+private:
+    struct ChannelState
+    {
+        std::vector<float> input, output;                   // frame-sized rings, oldest sample at writePosition
+        std::vector<float> lastAnalysis, lastSynthesis;     // previous hop's spectra, interleaved re/im
+    };
+
+    static float wrapPhase (float phase) noexcept
+    {
+        return phase - juce::MathConstants<float>::twoPi * std::round (phase / juce::MathConstants<float>::twoPi);
+    }
+
+    void processFrame (ChannelState& state, float ratio) noexcept
+    {
+        const auto mask = fftSize - 1;
+
+        for (int i = 0; i < fftSize; ++i)
+            fftData[(size_t) i] = state.input[(size_t) ((writePosition + i) & mask)] * window[(size_t) i];
+
+        std::fill (fftData.begin() + fftSize, fftData.end(), 0.0f);
+        fft->performRealOnlyForwardTransform (fftData.data(), true);
+
+        const auto* analysis = fftData.data();
+
+        const auto formantsMove = preserveFormants && std::abs (envelopeScale - 1.0f) > 1.0e-4f;
+
+        if (std::abs (ratio - 1.0f) < 1.0e-4f && ! formantsMove)
+            std::copy (analysis, analysis + numBins * 2, shifted.data());
+        else
+            shiftSpectrum (state, ratio);
+
+        std::copy (analysis, analysis + numBins * 2, state.lastAnalysis.data());
+        std::copy (shifted.begin(), shifted.end(), state.lastSynthesis.begin());
+
+        std::copy (shifted.begin(), shifted.end(), fftData.begin());
+        fft->performRealOnlyInverseTransform (fftData.data());
+
+        for (int i = 0; i < fftSize; ++i)
+            state.output[(size_t) ((writePosition + i) & mask)] += fftData[(size_t) i] * window[(size_t) i] * synthesisGain;
+    }
+
+    void shiftSpectrum (const ChannelState& state, float ratio) noexcept
+    {
+        const auto* analysis = fftData.data();
+        const auto lastBin = numBins - 1;
+
+        float maxPower = 0.0f;
+        for (int k = 0; k < numBins; ++k)
+        {
+            const auto re = analysis[2 * k], im = analysis[2 * k + 1];
+            power[(size_t) k] = re * re + im * im;
+            maxPower = juce::jmax (maxPower, power[(size_t) k]);
+        }
+
+        // Local maxima over +-2 bins and within 80 dB of the loudest.
+        const auto floor = juce::jmax (1.0e-20f, maxPower * 1.0e-8f);
+        int numPeaks = 0;
+        for (int k = 2; k < lastBin - 1; ++k)
+        {
+            const auto p = power[(size_t) k];
+            if (p > floor && p > power[(size_t) k - 1] && p >= power[(size_t) k + 1]
+                && p > power[(size_t) k - 2] && p >= power[(size_t) k + 2])
+                peaks[(size_t) numPeaks++] = k;
+        }
+
+        if (preserveFormants)
+            estimateEnvelope();
+
+        std::fill (shifted.begin(), shifted.end(), 0.0f);
+
+        const auto expectedAdvance = juce::MathConstants<float>::twoPi * (float) hopSize / (float) fftSize;
+        const auto* lastIn = state.lastAnalysis.data();
+        const auto* lastOut = state.lastSynthesis.data();
+
+        for (int p = 0; p < numPeaks; ++p)
+        {
+            const auto k = peaks[(size_t) p];
+            const auto re = analysis[2 * k], im = analysis[2 * k + 1];
+
+            // Instantaneous frequency from the phase step since the last hop, in bins.
+            const auto step = std::atan2 (im * lastIn[2 * k] - re * lastIn[2 * k + 1],
+                                          re * lastIn[2 * k] + im * lastIn[2 * k + 1]);
+            const auto trueBin = (float) k + wrapPhase (step - expectedAdvance * (float) k) / expectedAdvance;
+            const auto targetBin = trueBin * ratio;
+            const auto offset = juce::roundToInt (targetBin - trueBin);
+            const auto outBin = k + offset;
+
+            if (outBin < 1 || outBin >= lastBin)
+                continue;
+
+            // Continue the phase already at the destination bin, advanced at the new frequency.
+            const auto synthesisPhase = std::atan2 (lastOut[2 * outBin + 1], lastOut[2 * outBin]) + expectedAdvance * targetBin;
+            const auto rotation = synthesisPhase - std::atan2 (im, re);
+            const auto rotRe = std::cos (rotation), rotIm = std::sin (rotation);
+
+            const auto regionStart = p == 0 ? 0 : (peaks[(size_t) p - 1] + k) / 2 + 1;
+            const auto regionEnd = p == numPeaks - 1 ? lastBin : (k + peaks[(size_t) p + 1]) / 2;
+
+            for (int bin = juce::jmax (regionStart, -offset); bin <= juce::jmin (regionEnd, lastBin - offset); ++bin)
+            {
+                auto gain = 1.0f;
+                if (preserveFormants)
+                    gain = std::exp (juce::jlimit (-maxEnvelopeCorrection, maxEnvelopeCorrection,
+                                                   getLogEnvelope ((float) (bin + offset) * envelopeScale) - logEnvelope[(size_t) bin]));
+
+                const auto binRe = analysis[2 * bin] * gain, binIm = analysis[2 * bin + 1] * gain;
+                const auto dest = 2 * (bin + offset);
+                shifted[(size_t) dest]     += binRe * rotRe - binIm * rotIm;
+                shifted[(size_t) dest + 1] += binRe * rotIm + binIm * rotRe;
+            }
+        }
+
+        shifted[1] = 0.0f;
+        shifted[(size_t) (2 * lastBin + 1)] = 0.0f;
+    }
+
+    /** Natural-log magnitude envelope of power[] by cepstral liftering. */
+    void estimateEnvelope() noexcept
+    {
+        for (int k = 0; k < numBins; ++k)
+        {
+            cepstrum[(size_t) (2 * k)] = 0.5f * std::log (power[(size_t) k] + 1.0e-20f);
+            cepstrum[(size_t) (2 * k + 1)] = 0.0f;
+        }
+
+        fft->performRealOnlyInverseTransform (cepstrum.data());
+        std::fill (cepstrum.begin() + lifterLength, cepstrum.begin() + fftSize - lifterLength + 1, 0.0f);
+        std::fill (cepstrum.begin() + fftSize, cepstrum.end(), 0.0f);
+        fft->performRealOnlyForwardTransform (cepstrum.data(), true);
+
+        for (int k = 0; k < numBins; ++k)
+            logEnvelope[(size_t) k] = cepstrum[(size_t) (2 * k)];
+    }
+
+    float getLogEnvelope (float bin) const noexcept
+    {
+        const auto position = juce::jlimit (0.0f, (float) (numBins - 1), bin);
+        const auto index = juce::jmin ((int) position, numBins - 2);
+        const auto frac = position - (float) index;
+        return logEnvelope[(size_t) index] + frac * (logEnvelope[(size_t) index + 1] - logEnvelope[(size_t) index]);
+    }
+
+    static constexpr float maxEnvelopeCorrection = 3.5f;   // ~30 dB, in nepers
+
+    FFTEngine fft;
+    int fftSize = 0, hopSize = 0, numBins = 0, lifterLength = 64;
+    float synthesisGain = 1.0f;
+    bool preserveFormants = false;
+    float envelopeScale = 1.0f;
+
+    std::vector<float> window, fftData, shifted, power, cepstrum, logEnvelope;
+    std::vector<int> peaks;
+    std::vector<ChannelState> channels;
+    int writePosition = 0, hopPosition = 0;
+};
+} // namespace gls::dsp
@@ -0,0 +1,182 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include "DelayLine.h"
+#include "DryWetStage.h"
+#include <vector>
+
+namespace gls::dsp
+{
+/** Click-free bypass that costs next to nothing once it has settled.
+
+    Toggling crossfades between the processed signal and the dry input at equal power.
+    The dry input is delayed by the processor's reported latency, so the two line up
+    and the host's delay compensation holds in both states. Once fully bypassed the
+    processor skips its DSP, and the dry path is all that runs: a ring-buffer copy, or
+    nothing at all for processors without latency. On the way back the DSP runs
+    unheard for one latency period first, so lookahead lines hold fresh input before
+    the fade starts.
+
+    Smoothers and dry/wet stages registered with snapOnResume() are snapped to their
+    current settings on the first processed block after skipped ones, so nothing ramps
+    in from values that went stale while the DSP was off.
+
+        if (! bypass.begin (buffer, numSamples, params.isOn (Param::bypass)))
+            return;     // buffer now holds the latency-aligned dry input
+        // ... DSP ...
+        bypass.end (buffer, numSamples);
+
+    Blocks longer than the prepared size skip the rest of a fade instead of
+    reallocating; the DualPrecisionAudioProcessor double path never sends them. */
+class SoftBypass
+{
+public:
+    static constexpr double defaultFadeSeconds = 0.01;
+
+    /** maximumLatency is the most the processor will ever report, in samples. */
+    void prepare (double sampleRate, int numChannels, int maximumBlockSize, int maximumLatency = 0,
+                  double fadeSeconds = defaultFadeSeconds)
+    {
+        capacity = juce::jmax (1, maximumBlockSize);
+        maximumDelay = juce::jmax (0, maximumLatency);
+        latency = juce::jmin (latency, maximumDelay);
+        step = 1.0f / (float) juce::jmax (1, juce::roundToInt (fadeSeconds * sampleRate));
+
+        dryLines.resize ((size_t) juce::jmax (1, numChannels));
+        for (auto& line : dryLines)
+            line.prepare (juce::jmax (1, maximumDelay), capacity);
+
+        dryScratch.assign ((size_t) capacity, 0.0f);
+        wetGains.assign ((size_t) capacity, 1.0f);
+        dryGains.assign ((size_t) capacity, 0.0f);
+        settlePending = true;
+    }
+
+    /** Message thread, e.g. from the processor's constructor. */
+    void snapOnResume (std::initializer_list<SmoothedParameter*> smoothers)
+    {
+        resumeSmoothers.insert (resumeSmoothers.end(), smoothers.begin(), smoothers.end());
+    }
+
+    void snapOnResume (DryWetStage& stage) noexcept     { resumeStage = &stage; }
+
+    /** The latency the processor currently reports; the dry path is delayed to match. */
+    void setLatency (int samples) noexcept              { latency = juce::jlimit (0, maximumDelay, samples); }
+
+    bool isBypassed() const noexcept                    { return position >= 1.0f && bypassRequested; }
+
+    /** Audio thread, before the DSP. Returns false when the processor is fully
+        bypassed; the buffer then already holds the output. */
+    bool begin (juce::AudioBuffer<float>& buffer, int numSamples, bool shouldBypass) noexcept
+    {
+        if (settlePending)
+        {
+            // Start in whatever state the session loaded with, without a fade.
+            settlePending = false;
+            bypassRequested = shouldBypass;
+            position = shouldBypass ? 1.0f : 0.0f;
+            priming = 0;
+        }
+        else if (shouldBypass != bypassRequested)
+        {
+            bypassRequested = shouldBypass;
+            if (! shouldBypass && position >= 1.0f)
+                priming = latency;
+        }
+
+        fading = ! isSettled();
+        if (fading && numSamples > capacity)
+        {
+            position = bypassRequested ? 1.0f : 0.0f;
+            priming = 0;
+            fading = false;
+        }
+
+        const auto numChannels = juce::jmin (buffer.getNumChannels(), (int) dryLines.size());
+
+        if (isBypassed())
+        {
+            if (latency > 0)
+                for (int start = 0; start < numSamples; start += capacity)
+                    for (int ch = 0; ch < numChannels; ++ch)
+                    {
+                        const auto length = juce::jmin (capacity, numSamples - start);
+                        auto* data = buffer.getWritePointer (ch, start);
+                        dryLines[(size_t) ch].write (data, length);
+                        dryLines[(size_t) ch].read (data, length, (float) latency);
+                    }
+
+            resumePending = true;
+            return false;
+        }
+
+        if (resumePending)
+        {
+            resumePending = false;
+            for (auto* smoother : resumeSmoothers)
+                smoother->snap();
+
+            if (resumeStage != nullptr)
+                resumeStage->reset();
+        }
+
+        // Processing: the dry history is only needed for a fade, or ahead of one when it
+        // has to be delayed.
+        if (fading || latency > 0)
+            for (int start = 0; start < numSamples; start += capacity)
+                for (int ch = 0; ch < numChannels; ++ch)
+                    dryLines[(size_t) ch].write (buffer.getReadPointer (ch, start), juce::jmin (capacity, numSamples - start));
+
+        return true;
+    }
+
+    /** Audio thread, after the DSP: blends in the dry input while a fade is running. */
+    void end (juce::AudioBuffer<float>& buffer, int numSamples) noexcept
+    {
+        if (! fading)
+            return;
+
+        const auto target = bypassRequested ? 1.0f : 0.0f;
+        for (int i = 0; i < numSamples; ++i)
+        {
+            if (priming > 0)
+            {
+                --priming;
+                wetGains[(size_t) i] = 0.0f;
+                dryGains[(size_t) i] = 1.0f;
+                continue;
+            }
+
+            position = target > position ? juce::jmin (target, position + step)
+                                         : juce::jmax (target, position - step);
+            const auto angle = position * juce::MathConstants<float>::halfPi;
+            wetGains[(size_t) i] = std::cos (angle);
+            dryGains[(size_t) i] = std::sin (angle);
+        }
+
+        const auto numChannels = juce::jmin (buffer.getNumChannels(), (int) dryLines.size());
+        for (int ch = 0; ch < numChannels; ++ch)
+        {
+            auto* out = buffer.getWritePointer (ch);
+            dryLines[(size_t) ch].read (dryScratch.data(), numSamples, (float) latency);
+
+            for (int i = 0; i < numSamples; ++i)
+                out[i] = out[i] * wetGains[(size_t) i] + dryScratch[(size_t) i] * dryGains[(size_t) i];
+        }
+    }
+
+private:
+    bool isSettled() const noexcept
+    {
+        return priming == 0 && position == (bypassRequested ? 1.0f : 0.0f);
+    }
+
+    std::vector<DelayLine<float>> dryLines;
+    std::vector<float> dryScratch, wetGains, dryGains;
+    std::vector<SmoothedParameter*> resumeSmoothers;
+    DryWetStage* resumeStage = nullptr;
+    int capacity = 1, maximumDelay = 0, latency = 0, priming = 0;
+    float position = 0.0f, step = 1.0f;
+    bool bypassRequested = false, fading = false, settlePending = true, resumePending = false;
+};
+} // namespace gls::dsp
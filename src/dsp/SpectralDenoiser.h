@@ -0,0 +1,344 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include "FFTEngine.h"
+#include <utility>
+#include <vector>
+
+namespace gls::dsp
+{
+/** Streaming STFT noise and late-reverb suppressor.
+
+    Each hop, every bin's power is smoothed over time and compared against the
+    interference expected in it: the captured noise profile or, where louder, a
+    minimum-tracking noise floor, plus a slow per-bin average of past frames standing
+    in for late reverb. The resulting power-subtraction (Wiener) gain is clamped to a
+    floor and smoothed with a fast attack and slower release, which keeps musical
+    noise down. Bin math runs on split real/imaginary arrays so it vectorises.
+
+    Frames use a periodic Hann window at 75% overlap and the output is delayed by one
+    frame, getLatencySamples(). While no reduction is asked for and no capture is
+    running, frames skip the transforms and overlap-add the windowed input directly,
+    which is sample-identical to a unity-gain frame, so idle instances cost next to
+    nothing and engaging the effect never clicks.
+
+    Profiles are exchanged as noise power spectral densities on a fixed grid of
+    profileSize points from DC to Nyquist, so a capture recalls at any frame size. */
+class SpectralDenoiser
+{
+public:
+    enum class Mode
+    {
+        standard,       // ~43 ms frame
+        lowLatency      // ~11 ms frame
+    };
+
+    static constexpr int overlap = 4;
+    static constexpr int profileSize = 1025;
+
+    struct Settings
+    {
+        float oversubtraction = 1.0f;   // scale on the noise estimate
+        float reverbWeight = 0.0f;      // scale on the late-reverb estimate
+        float floorGain = 1.0f;         // lowest gain any bin may reach; 1 disables reduction
+    };
+
+    /** Frame size for a mode, kept at the same duration at any sample rate. */
+    static int getOrder (Mode mode, double sampleRate) noexcept
+    {
+        const auto base = mode == Mode::lowLatency ? 9 : 11;
+        const auto rateSteps = juce::roundToInt (std::log2 (juce::jmax (1.0, sampleRate / 48000.0)));
+        return juce::jlimit (8, 14, base + rateSteps);
+    }
+
+    void prepare (double newSampleRate, int maxChannels, Mode newMode)
+    {
+        sampleRate = newSampleRate > 0.0 ? newSampleRate : 44100.0;
+        mode = newMode;
+
+        const auto order = getOrder (mode, sampleRate);
+        fft.prepare (order);
+        fftSize = 1 << order;
+        hopSize = fftSize / overlap;
+        numBins = fftSize / 2 + 1;
+
+        // Periodic Hann analysis and synthesis windows sum to 1.5 at 75% overlap.
+        window.resize ((size_t) fftSize);
+        identityWindow.resize ((size_t) fftSize);
+        float windowEnergy = 0.0f;
+        for (int i = 0; i < fftSize; ++i)
+        {
+            const auto w = 0.5f - 0.5f * std::cos (juce::MathConstants<float>::twoPi * (float) i / (float) fftSize);
+            window[(size_t) i] = w;
+            identityWindow[(size_t) i] = w * w / 1.5f;
+            windowEnergy += w * w;
+        }
+
+        synthesisGain = 1.0f / 1.5f;
+        psdScale = 1.0f / windowEnergy;
+
+        const auto hopSeconds = (double) hopSize / sampleRate;
+        auto coefficient = [hopSeconds] (double seconds) { return (float) std::exp (-hopSeconds / seconds); };
+        powerSmoothing = coefficient (0.02);
+        attackCoefficient = coefficient (0.005);
+        releaseCoefficient = coefficient (0.06);
+        reverbCoefficient = coefficient (0.25);
+        floorRise = (float) juce::Decibels::decibelsToGain (6.0 * hopSeconds);    // +6 dB/s
+        trackerFloor = 1.0e-10f / psdScale;                                          // ~-100 dBFS
+
+        fftData.assign ((size_t) fftSize * 2, 0.0f);
+        real.assign ((size_t) numBins, 0.0f);
+        imag.assign ((size_t) numBins, 0.0f);
+        power.assign ((size_t) numBins, 0.0f);
+        target.assign ((size_t) numBins, 0.0f);
+        interference.assign ((size_t) numBins, 0.0f);
+        profileNoise.assign ((size_t) numBins, 0.0f);
+        captureSum.assign ((size_t) numBins, 0.0f);
+
+        channels.resize ((size_t) juce::jmax (1, maxChannels));
+        for (auto& state : channels)
+        {
+            state.input.assign ((size_t) fftSize, 0.0f);
+            state.output.assign ((size_t) fftSize, 0.0f);
+            state.smoothedPower.assign ((size_t) numBins, 0.0f);
+            state.trackedNoise.assign ((size_t) numBins, 1.0e30f);
+            state.reverbTail.assign ((size_t) numBins, 0.0f);
+            state.gain.assign ((size_t) numBins, 1.0f);
+        }
+
+        reset();
+    }
+
+    void reset() noexcept
+    {
+        for (auto& state : channels)
+        {
+            std::fill (state.input.begin(), state.input.end(), 0.0f);
+            std::fill (state.output.begin(), state.output.end(), 0.0f);
+            std::fill (state.smoothedPower.begin(), state.smoothedPower.end(), 0.0f);
+            std::fill (state.trackedNoise.begin(), state.trackedNoise.end(), 1.0e30f);
+            std::fill (state.reverbTail.begin(), state.reverbTail.end(), 0.0f);
+            std::fill (state.gain.begin(), state.gain.end(), 1.0f);
+        }
+
+        writePosition = 0;
+        hopPosition = 0;
+        captureFramesRemaining = 0;
+        captureFramesDone = 0;
+        captureComplete = false;
+    }
+
+    Mode getMode() const noexcept                       { return mode; }
+    int getLatencySamples() const noexcept              { return fftSize; }
+
+    void setSettings (const Settings& newSettings) noexcept
+    {
+        settings = newSettings;
+        settings.floorGain = juce::jlimit (0.0f, 1.0f, settings.floorGain);
+    }
+
+    //==============================================================================
+    /** Loads a profile of profileSize noise PSD values; all zeros means none. */
+    void setNoiseProfile (const float* profile) noexcept
+    {
+        const auto step = (float) (profileSize - 1) / (float) (numBins - 1);
+        for (int k = 0; k < numBins; ++k)
+            profileNoise[(size_t) k] = sampleGrid (profile, profileSize, (float) k * step) / psdScale;
+    }
+
+    /** Averages the power of every channel over the next durationSeconds, in whole hops. */
+    void startCapture (double durationSeconds) noexcept
+    {
+        std::fill (captureSum.begin(), captureSum.end(), 0.0f);
+        captureFramesRemaining = juce::jmax (1, (int) std::ceil (durationSeconds * sampleRate / (double) hopSize));
+        captureFramesDone = 0;
+        captureComplete = false;
+    }
+
+    bool isCapturing() const noexcept                   { return captureFramesRemaining > 0; }
+
+    float getCaptureProgress() const noexcept
+    {
+        const auto total = captureFramesDone + captureFramesRemaining;
+        return total > 0 ? (float) captureFramesDone / (float) total : 0.0f;
+    }
+
+    void cancelCapture() noexcept                       { captureFramesRemaining = 0; }
+
+    /** True once after a capture finishes; the result is then ready in getCapturedProfile(). */
+    bool popCaptureComplete() noexcept
+    {
+        return std::exchange (captureComplete, false);
+    }
+
+    /** Writes the last capture as profileSize noise PSD values. */
+    void getCapturedProfile (float* profile) const noexcept
+    {
+        const auto step = (float) (numBins - 1) / (float) (profileSize - 1);
+        const auto scale = psdScale / (float) juce::jmax (1, captureFramesDone);
+        for (int i = 0; i < profileSize; ++i)
+            profile[i] = sampleGrid (captureSum.data(), numBins, (float) i * step) * scale;
+    }
+
+    //==============================================================================
+    /** Processes up to the prepared number of channels in place. */
+    void process (juce::AudioBuffer<float>& buffer) noexcept
+    {
+        if (! fft.isPrepared())
+            return;
+
+        const auto numChannels = juce::jmin ((int) channels.size(), buffer.getNumChannels());
+        const auto numSamples = buffer.getNumSamples();
+
+        // Segments end on hop boundaries, which are multiples of hopSize, so they never
+        // wrap around the frame-sized rings.
+        for (int start = 0; start < numSamples;)
+        {
+            const auto length = juce::jmin (numSamples - start, hopSize - hopPosition);
+
+            for (int ch = 0; ch < numChannels; ++ch)
+            {
+                auto& state = channels[(size_t) ch];
+                auto* data = buffer.getWritePointer (ch, start);
+                auto* output = state.output.data() + writePosition;
+
+                std::copy (data, data + length, state.input.data() + writePosition);
+                std::copy (output, output + length, data);
+                std::fill (output, output + length, 0.0f);
+            }
+
+            writePosition = (writePosition + length) & (fftSize - 1);
+            hopPosition += length;
+            start += length;
+
+            if (hopPosition == hopSize)
+            {
+                hopPosition = 0;
+
+                for (int ch = 0; ch < numChannels; ++ch)
+                    processFrame (channels[(size_t) ch], numChannels);
+
+                if (captureFramesRemaining > 0)
+                {
+                    ++captureFramesDone;
+                    captureComplete = --captureFramesRemaining == 0;
+                }
+            }
+        }
+    }
+
+private:
+    struct ChannelState
+    {
+        std::vector<float> input, output;       // frame-sized rings, oldest sample at writePosition
+        std::vector<float> smoothedPower, trackedNoise, reverbTail, gain;
+    };
+
+    static float sampleGrid (const float* values, int size, float position) noexcept
+    {
+        const auto index = juce::jlimit (0, size - 2, (int) position);
+        const auto fraction = juce::jlimit (0.0f, 1.0f, position - (float) index);
+        return values[index] + fraction * (values[index + 1] - values[index]);
+    }
+
+    void processFrame (ChannelState& state, int numChannels) noexcept
+    {
+        const auto mask = fftSize - 1;
+
+        if (settings.floorGain >= 1.0f && captureFramesRemaining == 0)
+        {
+            for (int i = 0; i < fftSize; ++i)
+            {
+                const auto index = (size_t) ((writePosition + i) & mask);
+                state.output[index] += state.input[index] * identityWindow[(size_t) i];
+            }
+
+            return;
+        }
+
+        for (int i = 0; i < fftSize; ++i)
+            fftData[(size_t) i] = state.input[(size_t) ((writePosition + i) & mask)] * window[(size_t) i];
+
+        std::fill (fftData.begin() + fftSize, fftData.end(), 0.0f);
+        fft->performRealOnlyForwardTransform (fftData.data(), true);
+
+        for (int k = 0; k < numBins; ++k)
+        {
+            real[(size_t) k] = fftData[(size_t) (2 * k)];
+            imag[(size_t) k] = fftData[(size_t) (2 * k + 1)];
+        }
+
+        using FVO = juce::FloatVectorOperations;
+        auto* p = power.data();
+        FVO::multiply (p, real.data(), real.data(), numBins);
+        FVO::addWithMultiply (p, imag.data(), imag.data(), numBins);
+
+        if (captureFramesRemaining > 0)
+            FVO::addWithMultiply (captureSum.data(), p, 1.0f / (float) numChannels, numBins);
+
+        // The reverb estimate is formed from past frames only, so it lags the direct sound.
+        auto* smoothed = state.smoothedPower.data();
+        auto* tail = state.reverbTail.data();
+        FVO::multiply (tail, reverbCoefficient, numBins);
+        FVO::addWithMultiply (tail, smoothed, 1.0f - reverbCoefficient, numBins);
+
+        FVO::multiply (smoothed, powerSmoothing, numBins);
+        FVO::addWithMultiply (smoothed, p, 1.0f - powerSmoothing, numBins);
+
+        auto* tracked = state.trackedNoise.data();
+        FVO::multiply (tracked, floorRise, numBins);
+        FVO::min (tracked, tracked, smoothed, numBins);
+        FVO::max (tracked, tracked, trackerFloor, numBins);
+
+        auto* noise = interference.data();
+        FVO::max (noise, tracked, profileNoise.data(), numBins);
+        FVO::multiply (noise, settings.oversubtraction, numBins);
+        FVO::addWithMultiply (noise, tail, settings.reverbWeight, numBins);
+
+        auto* g = target.data();
+        for (int k = 0; k < numBins; ++k)
+            g[k] = 1.0f - noise[k] / (smoothed[k] + 1.0e-20f);
+
+        FVO::clip (g, g, settings.floorGain, 1.0f, numBins);
+
+        auto* current = state.gain.data();
+        for (int k = 0; k < numBins; ++k)
+        {
+            const auto coefficient = g[k] > current[k] ? attackCoefficient : releaseCoefficient;
+            current[k] = g[k] + coefficient * (current[k] - g[k]);
+        }
+
+        FVO::multiply (real.data(), current, numBins);
+        FVO::multiply (imag.data(), current, numBins);
+
+        for (int k = 0; k < numBins; ++k)
+        {
+            fftData[(size_t) (2 * k)] = real[(size_t) k];
+            fftData[(size_t) (2 * k + 1)] = imag[(size_t) k];
+        }
+
+        fft->performRealOnlyInverseTransform (fftData.data());
+
+        for (int i = 0; i < fftSize; ++i)
+            state.output[(size_t) ((writePosition + i) & mask)] += fftData[(size_t) i] * window[(size_t) i] * synthesisGain;
+    }
+
+    FFTEngine fft;
+    double sampleRate = 44100.0;
+    Mode mode = Mode::standard;
+    int fftSize = 0, hopSize = 0, numBins = 0;
+    int writePosition = 0, hopPosition = 0;
+    float synthesisGain = 1.0f, psdScale = 1.0f;
+    float powerSmoothing = 0.0f, attackCoefficient = 0.0f, releaseCoefficient = 0.0f;
+    float reverbCoefficient = 0.0f, floorRise = 1.0f, trackerFloor = 0.0f;
+    Settings settings;
+
+    int captureFramesRemaining = 0, captureFramesDone = 0;
+    bool captureComplete = false;
+
+    std::vector<float> window, identityWindow;
+    std::vector<float> fftData, real, imag, power, target, interference;
+    std::vector<float> profileNoise, captureSum;
+    std::vector<ChannelState> channels;
+};
+} // namespace gls::dsp
@@ -0,0 +1,266 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include "FFTEngine.h"
+#include "LockFreeTransport.h"
+#include <array>
+#include <atomic>
+#include <vector>
+
+namespace gls::dsp
+{
+class SpectrumAnalysisService;
+
+/** One processor's spectrum feed. The audio thread calls push() with its output; while
+    no editor is watching that costs a single atomic load. Once a view calls
+    addViewer(), pushed audio is summed to mono into a juce::AbstractFifo and the
+    process-wide SpectrumAnalysisService turns it into log-spaced, smoothed dB levels
+    that the view fetches with fetch(). The FFT never runs on the audio thread. */
+class SpectrumAnalyser
+{
+public:
+    static constexpr int numBins = 128;
+    static constexpr float minFrequency = 20.0f, maxFrequency = 20000.0f;
+    static constexpr float floorDb = -100.0f;
+
+    /** Levels in dBFS (a full-scale sine reads 0), lowest band first. */
+    using Frame = std::array<float, (size_t) numBins>;
+
+    SpectrumAnalyser();
+    ~SpectrumAnalyser();
+
+    /** Audio side. Storage is fixed at construction, so this may run while a view is open. */
+    void prepare (double sampleRate) noexcept           { rate.store (sampleRate, std::memory_order_relaxed); }
+
+    /** Audio thread: queues the channel average. Drops audio when the worker falls behind. */
+    void push (const juce::AudioBuffer<float>& buffer, int numSamples) noexcept
+    {
+        if (viewers.load (std::memory_order_relaxed) == 0)
+            return;
+
+        const auto numChannels = buffer.getNumChannels();
+        if (numChannels == 0 || fifo.getFreeSpace() < numSamples)
+            return;
+
+        const auto gain = 1.0f / (float) numChannels;
+        const auto scope = fifo.write (numSamples);
+
+        auto mix = [&] (int start, float* destination, int length)
+        {
+            juce::FloatVectorOperations::copyWithMultiply (destination, buffer.getReadPointer (0, start), gain, length);
+            for (int ch = 1; ch < numChannels; ++ch)
+                juce::FloatVectorOperations::addWithMultiply (destination, buffer.getReadPointer (ch, start), gain, length);
+        };
+
+        if (scope.blockSize1 > 0)
+            mix (0, capture.data() + scope.startIndex1, scope.blockSize1);
+        if (scope.blockSize2 > 0)
+            mix (scope.blockSize1, capture.data() + scope.startIndex2, scope.blockSize2);
+    }
+
+    /** Message thread: views register while visible so idle instances cost nothing. */
+    void addViewer();
+    void removeViewer();
+
+    /** Message thread (one view): the newest analysed frame. Returns false if nothing new arrived. */
+    bool fetch (Frame& destination) noexcept
+    {
+        if (! frames.fetch())
+            return false;
+
+        destination = frames.getReadBuffer();
+        return true;
+    }
+
+    /** Centre frequency of a band, for drawing a frequency axis. */
+    static float getBinFrequency (float bin) noexcept
+    {
+        return minFrequency * std::pow (maxFrequency / minFrequency, bin / (float) (numBins - 1));
+    }
+
+private:
+    friend class SpectrumAnalysisService;
+
+    static constexpr int fftOrder = 11;
+    static constexpr int fftSize = 1 << fftOrder;
+    static constexpr int hopSize = fftSize / 2;
+    static constexpr float attack = 0.6f, release = 0.12f;   // per frame, in dB
+
+    /** Worker thread: drains the FIFO and publishes a frame for every completed hop,
+        on the worker's own FFT engine. */
+    void analyse (const juce::dsp::FFT& fft);
+    void updateBinMap (double sampleRate);
+
+    juce::AbstractFifo fifo { fftSize * 8 };
+    std::vector<float> capture = std::vector<float> ((size_t) fftSize * 8, 0.0f);
+    std::atomic<double> rate { 44100.0 };
+    std::atomic<int> viewers { 0 };
+    TripleBuffer<Frame> frames;
+
+    // Worker-side state.
+    struct BinRange
+    {
+        int first = 0, last = 0;
+    };
+
+    std::vector<float> history = std::vector<float> ((size_t) fftSize, 0.0f);
+    std::vector<float> window = std::vector<float> ((size_t) fftSize, 0.0f);
+    std::vector<float> fftData = std::vector<float> ((size_t) fftSize * 2, 0.0f);
+    std::vector<float> power = std::vector<float> ((size_t) fftSize / 2 + 1, 0.0f);
+    std::array<BinRange, (size_t) numBins> binMap {};
+    Frame smoothed {};
+    double mappedRate = 0.0;
+    int filled = 0;
+
+    juce::SharedResourcePointer<SpectrumAnalysisService> service;
+
+    JUCE_DECLARE_NON_COPYABLE (SpectrumAnalyser)
+};
+
+//==============================================================================
+/** The single worker thread shared by every SpectrumAnalyser in the process. It only
+    visits analysers that have a viewer and sleeps when there are none. Held through
+    juce::SharedResourcePointer, so it exists while any analyser does. */
+class SpectrumAnalysisService : private juce::Thread
+{
+public:
+    SpectrumAnalysisService() : juce::Thread ("GLS Spectrum Analysis")
+    {
+        fft.prepare (SpectrumAnalyser::fftOrder);
+        startThread (juce::Thread::Priority::low);
+    }
+
+    ~SpectrumAnalysisService() override                 { stopThread (2000); }
+
+    void attach (SpectrumAnalyser& analyser)
+    {
+        {
+            const juce::ScopedLock sl (lock);
+            analysers.addIfNotAlreadyThere (&analyser);
+        }
+
+        notify();
+    }
+
+    void detach (SpectrumAnalyser& analyser)
+    {
+        const juce::ScopedLock sl (lock);
+        analysers.removeAllInstancesOf (&analyser);
+    }
+
+private:
+    static constexpr int intervalMs = 10;
+
+    void run() override
+    {
+        while (! threadShouldExit())
+        {
+            bool idle;
+            {
+                const juce::ScopedLock sl (lock);
+                for (auto* analyser : analysers)
+                    analyser->analyse (*fft);
+
+                idle = analysers.isEmpty();
+            }
+
+            wait (idle ? -1 : intervalMs);
+        }
+    }
+
+    juce::CriticalSection lock;
+    juce::Array<SpectrumAnalyser*> analysers;
+    FFTEngine fft;
+};
+
+//==============================================================================
+inline SpectrumAnalyser::SpectrumAnalyser()
+{
+    frames.getWriteBuffer().fill (floorDb);
+    smoothed.fill (floorDb);
+
+    // Hann, scaled so a full-scale sine's peak bin reads 0 dB.
+    for (int i = 0; i < fftSize; ++i)
+        window[(size_t) i] = (1.0f - std::cos (juce::MathConstants<float>::twoPi * (float) i / (float) fftSize)) * (2.0f / (float) fftSize);
+}
+
+inline SpectrumAnalyser::~SpectrumAnalyser()
+{
+    service->detach (*this);
+}
+
+inline void SpectrumAnalyser::addViewer()
+{
+    if (viewers.fetch_add (1) == 0)
+        service->attach (*this);
+}
+
+inline void SpectrumAnalyser::removeViewer()
+{
+    if (viewers.fetch_sub (1) == 1)
+        service->detach (*this);
+}
+
+inline void SpectrumAnalyser::updateBinMap (double sampleRate)
+{
+    mappedRate = sampleRate;
+    const auto binWidth = sampleRate / fftSize;
+    const auto lastFFTBin = fftSize / 2;
+
+    // Each band spans half-way to its neighbours; bands narrower than an FFT bin
+    // collapse onto the nearest one.
+    for (int b = 0; b < numBins; ++b)
+    {
+        const auto low = getBinFrequency ((float) b - 0.5f) / binWidth;
+        const auto high = getBinFrequency ((float) b + 0.5f) / binWidth;
+        auto& range = binMap[(size_t) b];
+        range.first = juce::jlimit (1, lastFFTBin, (int) std::ceil (low));
+        range.last = juce::jlimit (1, lastFFTBin, (int) std::floor (high));
+
+        if (range.last < range.first)
+            range.first = range.last = juce::jlimit (1, lastFFTBin, juce::roundToInt (0.5 * (low + high)));
+    }
+}
+
+inline void SpectrumAnalyser::analyse (const juce::dsp::FFT& fft)
+{
+    const auto sampleRate = rate.load (std::memory_order_relaxed);
+    if (sampleRate != mappedRate)
+        updateBinMap (sampleRate);
+
+    while (fifo.getNumReady() > 0)
+    {
+        // The newest hop goes at the end of the history.
+        const auto scope = fifo.read (juce::jmin (hopSize - filled, fifo.getNumReady()));
+        auto* tail = history.data() + fftSize - hopSize + filled;
+        std::copy_n (capture.data() + scope.startIndex1, scope.blockSize1, tail);
+        std::copy_n (capture.data() + scope.startIndex2, scope.blockSize2, tail + scope.blockSize1);
+        filled += scope.blockSize1 + scope.blockSize2;
+
+        if (filled < hopSize)
+            break;
+
+        filled = 0;
+        juce::FloatVectorOperations::multiply (fftData.data(), history.data(), window.data(), fftSize);
+        std::copy (history.begin() + hopSize, history.end(), history.begin());
+        fft.performRealOnlyForwardTransform (fftData.data(), true);
+
+        for (size_t k = 0; k < power.size(); ++k)
+            power[k] = fftData[2 * k] * fftData[2 * k] + fftData[2 * k + 1] * fftData[2 * k + 1];
+
+        auto& frame = frames.getWriteBuffer();
+        for (size_t b = 0; b < (size_t) numBins; ++b)
+        {
+            const auto& range = binMap[b];
+            const auto peak = juce::FloatVectorOperations::findMaximum (power.data() + range.first, range.last - range.first + 1);
+            const auto db = juce::jmax (floorDb, 10.0f * std::log10 (peak + 1.0e-12f));
+
+            auto& level = smoothed[b];
+            level += (db - level) * (db > level ? attack : release);
+            frame[b] = level;
+        }
+
+        frames.publish();
+    }
+}
+} // namespace gls::dsp
@@ -0,0 +1,151 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include <atomic>
+#include <limits>
+
+namespace gls::dsp
+{
+/** Reports a processor's real tail to the host and lets it skip its DSP on silence.
+
+    DualPrecisionAudioProcessor owns one and drives it around every host block; a
+    processor only describes its decay from its current state with setTail() in its
+    updateTail() override: a fixed part (delay lines, IR length, meter hold) plus an
+    optional RT60. The RT60 is stretched to the silence threshold, so a 4 s reverb at
+    the default -90 dB reports 6 s. The base adds the reported latency on top, so the
+    decay never counts lookahead or oversampling filters. getTailSeconds() is what
+    getTailLengthSeconds() returns.
+
+    Around the DSP, beginBlock() sees the input and endBlock() the output:
+
+        if (! tail.beginBlock (buffer, numSamples))
+        {
+            buffer.clear();
+            return;
+        }
+        // ... DSP ...
+        tail.setLatency (getLatencySamples());
+        tail.endBlock (buffer, numSamples);
+
+    The processor suspends once input has been below the threshold for a whole tail
+    and the last output block was too, so its internal state has decayed into the
+    noise floor. It wakes on the first block with input above the threshold. The DSP
+    resumes from state that was already below the threshold, so nothing jumps. A
+    processor that makes sound from nothing (a noise source, tape hiss) reports an
+    infinite tail while it does. */
+class TailTracker
+{
+public:
+    static constexpr float defaultThresholdDb = -90.0f;
+
+    void prepare (double newSampleRate, float thresholdDb = defaultThresholdDb) noexcept
+    {
+        sampleRate = newSampleRate > 0.0 ? newSampleRate : 44100.0;
+        thresholdGain = juce::Decibels::decibelsToGain (thresholdDb);
+        decayScale = -thresholdDb / 60.0f;
+        updateTailSamples();
+        wake();
+    }
+
+    /** The decay from the processor's current settings; call from prepareToPlay or the
+        audio thread. */
+    void setTail (double fixedSeconds, double rt60Seconds = 0.0) noexcept
+    {
+        const auto seconds = juce::jmax (0.0, fixedSeconds) + juce::jmax (0.0, rt60Seconds) * (double) decayScale;
+        if (seconds == decaySeconds)
+            return;
+
+        decaySeconds = seconds;
+        updateTailSamples();
+    }
+
+    /** The processor's reported latency, which delays its decay by as much. */
+    void setLatency (int numSamples) noexcept
+    {
+        numSamples = juce::jmax (0, numSamples);
+        if (numSamples == latencySamples)
+            return;
+
+        latencySamples = numSamples;
+        updateTailSamples();
+    }
+
+    /** RT60 of a feedback loop of loopSeconds with the given gain per pass. A loop that
+        does not decay has an infinite tail, which JUCE passes on to the host as such. */
+    static double getFeedbackRT60 (double loopSeconds, double loopGain) noexcept
+    {
+        loopGain = std::abs (loopGain);
+        if (loopGain <= 0.0)
+            return 0.0;
+
+        if (loopGain >= 1.0)
+            return std::numeric_limits<double>::infinity();
+
+        return 3.0 * loopSeconds / -std::log10 (loopGain);
+    }
+
+    /** RT60 of a one-pole envelope or smoother with the given time constant, for state
+        that never reaches the output, such as a compressor's gain computer. */
+    static double getEnvelopeRT60 (double timeConstantSeconds) noexcept
+    {
+        return juce::jmax (0.0, timeConstantSeconds) * 3.0 * std::log (10.0);
+    }
+
+    double getTailSeconds() const noexcept              { return tailSeconds.load (std::memory_order_relaxed); }
+    bool isSuspended() const noexcept                   { return suspended; }
+
+    /** Forces the next block to render, e.g. after a reset or a state load. */
+    void wake() noexcept
+    {
+        suspended = false;
+        silentSamples = 0;
+    }
+
+    /** Audio thread, before the DSP. Returns false while the processor may skip it and
+        output silence. */
+    template <typename SampleType>
+    bool beginBlock (const juce::AudioBuffer<SampleType>& input, int numSamples) noexcept
+    {
+        if (input.getMagnitude (0, numSamples) > (SampleType) thresholdGain)
+        {
+            wake();
+            return true;
+        }
+
+        if (suspended)
+            return false;
+
+        silentSamples += numSamples;
+        return true;
+    }
+
+    /** Audio thread, after the DSP. */
+    template <typename SampleType>
+    void endBlock (const juce::AudioBuffer<SampleType>& output, int numSamples) noexcept
+    {
+        if (silentSamples >= tailSamples
+             && output.getMagnitude (0, numSamples) <= (SampleType) thresholdGain)
+            suspended = true;
+    }
+
+private:
+    void updateTailSamples() noexcept
+    {
+        const auto seconds = decaySeconds + (double) latencySamples / sampleRate;
+        tailSeconds.store (seconds, std::memory_order_relaxed);
+
+        const auto samples = std::ceil (seconds * sampleRate);
+        tailSamples = samples < (double) std::numeric_limits<juce::int64>::max()
+                          ? (juce::int64) samples : std::numeric_limits<juce::int64>::max();
+    }
+
+    double sampleRate = 44100.0;
+    float thresholdGain = juce::Decibels::decibelsToGain (defaultThresholdDb);
+    float decayScale = -defaultThresholdDb / 60.0f;
+    double decaySeconds = 0.0;
+    int latencySamples = 0;
+    std::atomic<double> tailSeconds { 0.0 };
+    juce::int64 tailSamples = 0, silentSamples = 0;
+    bool suspended = false;
+};
+} // namespace gls::dsp
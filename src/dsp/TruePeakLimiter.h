@@ -0,0 +1,219 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include <array>
+#include <vector>
+
+namespace gls::dsp
+{
+/** ITU-R BS.1770-4 Annex 2 true-peak estimate: a 48-tap polyphase FIR upsamples 4x
+    and the largest absolute phase output is taken per input sample.
+
+    The estimate for input sample n is available latencySamples later, so callers
+    delay the audio by that much on top of their lookahead. */
+class TruePeakDetector
+{
+public:
+    static constexpr int oversamplingFactor = 4;
+    static constexpr int tapsPerPhase = 12;
+    static constexpr int latencySamples = tapsPerPhase / 2;
+
+    void prepare (int numChannels)
+    {
+        histories.assign ((size_t) juce::jmax (1, numChannels), {});
+        reset();
+    }
+
+    void reset() noexcept
+    {
+        for (auto& history : histories)
+            history = {};
+    }
+
+    /** Folds the true-peak estimate of one channel into peaks: peaks[i] = max (peaks[i], tp[i]).
+        Calling it for every channel leaves the linked peak across channels. */
+    void processMax (int channel, const float* input, float* peaks, int numSamples) noexcept
+    {
+        auto& history = histories[(size_t) channel];
+
+        for (int i = 0; i < numSamples; ++i)
+        {
+            // Each sample is written twice so the newest tapsPerPhase values are always contiguous.
+            history.samples[(size_t) history.position] = input[i];
+            history.samples[(size_t) (history.position + tapsPerPhase)] = input[i];
+
+            if (++history.position == tapsPerPhase)
+                history.position = 0;
+
+            const auto* x = history.samples.data() + history.position;
+            auto peak = peaks[i];
+
+            // The phase set is time-reversal symmetric (phase 3 mirrors phase 0), so running
+            // the taps over oldest-first history yields the same four outputs, in reverse order.
+            for (const auto& phase : coefficients)
+            {
+                float sum = 0.0f;
+                for (int t = 0; t < tapsPerPhase; ++t)
+                    sum += phase[(size_t) t] * x[t];
+
+                peak = juce::jmax (peak, std::abs (sum));
+            }
+
+            peaks[i] = peak;
+        }
+    }
+
+private:
+    struct History
+    {
+        std::array<float, 2 * tapsPerPhase> samples {};
+        int position = 0;
+    };
+
+    static constexpr float coefficients[oversamplingFactor][tapsPerPhase] {
+        {  0.0017089843750f,  0.0109863281250f, -0.0196533203125f,  0.0332031250000f,
+          -0.0594482421875f,  0.1373291015625f,  0.9721679687500f, -0.1022949218750f,
+           0.0476074218750f, -0.0266113281250f,  0.0148925781250f, -0.0083007812500f },
+        { -0.0291748046875f,  0.0292968750000f, -0.0517578125000f,  0.0891113281250f,
+          -0.1665039062500f,  0.4650878906250f,  0.7797851562500f, -0.2003173828125f,
+           0.1015625000000f, -0.0582275390625f,  0.0330810546875f, -0.0189208984375f },
+        { -0.0189208984375f,  0.0330810546875f, -0.0582275390625f,  0.1015625000000f,
+          -0.2003173828125f,  0.7797851562500f,  0.4650878906250f, -0.1665039062500f,
+           0.0891113281250f, -0.0517578125000f,  0.0292968750000f, -0.0291748046875f },
+        { -0.0083007812500f,  0.0148925781250f, -0.0266113281250f,  0.0476074218750f,
+          -0.1022949218750f,  0.9721679687500f,  0.1373291015625f, -0.0594482421875f,
+           0.0332031250000f, -0.0196533203125f,  0.0109863281250f,  0.0017089843750f }
+    };
+
+    std::vector<History> histories;
+};
+
+/** Running minimum over the last `window` values (monotonic deque, O(1) amortised).
+    The window may change between calls up to the size given to prepare(). */
+class SlidingWindowMinimum
+{
+public:
+    void prepare (int maximumWindow)
+    {
+        entries.resize ((size_t) juce::jmax (1, maximumWindow) + 1);
+        reset();
+    }
+
+    void reset() noexcept
+    {
+        head = count = 0;
+        index = 0;
+    }
+
+    void setWindow (int newWindow) noexcept
+    {
+        window = juce::jlimit (1, (int) entries.size() - 1, newWindow);
+    }
+
+    float process (float value) noexcept
+    {
+        const auto capacity = (int) entries.size();
+
+        while (count > 0 && entries[(size_t) ((head + count - 1) % capacity)].value >= value)
+            --count;
+
+        entries[(size_t) ((head + count) % capacity)] = { value, index };
+        ++count;
+
+        while (entries[(size_t) head].index <= index - window)
+        {
+            head = (head + 1) % capacity;
+            --count;
+        }
+
+        ++index;
+        return entries[(size_t) head].value;
+    }
+
+private:
+    struct Entry
+    {
+        float value;
+        juce::int64 index;
+    };
+
+    std::vector<Entry> entries;
+    int head = 0, count = 0, window = 1;
+    juce::int64 index = 0;
+};
+
+/** Block gain computer for a lookahead limiter.
+
+    Takes the gain each sample requires and returns a smoothed gain that is never above
+    it once the audio is delayed by getLookahead() samples: a sliding minimum over
+    lookahead + 1 samples, an exponential release, then a moving average over the same
+    span, which doubles as the attack ramp. */
+class LookaheadGainComputer
+{
+public:
+    void prepare (int maximumLookaheadSamples)
+    {
+        maximumWindow = juce::jmax (1, maximumLookaheadSamples + 1);
+        minimum.prepare (maximumWindow);
+        history.resize ((size_t) maximumWindow);
+        reset();
+    }
+
+    void reset() noexcept
+    {
+        minimum.reset();
+        std::fill (history.begin(), history.end(), 1.0f);
+        historyPosition = 0;
+        held = 1.0f;
+        runningSum = (double) window;
+    }
+
+    void setLookahead (int lookaheadSamples) noexcept
+    {
+        const auto newWindow = juce::jlimit (1, maximumWindow, lookaheadSamples + 1);
+        if (newWindow == window)
+            return;
+
+        window = newWindow;
+        minimum.setWindow (window);
+
+        // Re-sum the most recent `window` values; only happens when the control moves.
+        runningSum = 0.0;
+        for (int i = 1; i <= window; ++i)
+            runningSum += history[(size_t) ((historyPosition - i + maximumWindow) % maximumWindow)];
+    }
+
+    int getLookahead() const noexcept                   { return window - 1; }
+
+    void setReleaseCoefficient (float coefficient) noexcept { releaseCoefficient = coefficient; }
+
+    /** In place: required gain in, applied gain out. */
+    void process (float* gain, int numSamples) noexcept
+    {
+        const auto invWindow = 1.0 / (double) window;
+
+        for (int i = 0; i < numSamples; ++i)
+        {
+            const auto floor = minimum.process (gain[i]);
+            held = floor < held ? floor : floor + releaseCoefficient * (held - floor);
+
+            const auto oldest = (historyPosition - window + maximumWindow) % maximumWindow;
+            runningSum += (double) held - (double) history[(size_t) oldest];
+            history[(size_t) historyPosition] = held;
+
+            if (++historyPosition == maximumWindow)
+                historyPosition = 0;
+
+            gain[i] = (float) (runningSum * invWindow);
+        }
+    }
+
+private:
+    SlidingWindowMinimum minimum;
+    std::vector<float> history;
+    int maximumWindow = 1, window = 1, historyPosition = 0;
+    double runningSum = 1.0;
+    float held = 1.0f;
+    float releaseCoefficient = 0.0f;
+};
+} // namespace gls::dsp
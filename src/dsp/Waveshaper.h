@@ -0,0 +1,591 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include <array>
+#include <atomic>
+#include <vector>
+
+namespace gls::dsp
+{
+/** log cosh (x), the first antiderivative of tanh, as cubic Hermite segments on |x|,
+    each matching the exact value and slope (tanh) at its knots. One lookup and a
+    cubic replace the exp and log1p fits of the first-order tanh path, and the slope
+    of the same cubic serves as tanh, so that path needs no divide. The piecewise
+    cubic is C1, so ADAA difference quotients over it track tanh to within 1e-6. The
+    last knot sits on the asymptote |x| - ln 2, which takes over beyond the table. */
+class TanhAntiderivativeTable
+{
+public:
+    using Lanes = juce::dsp::SIMDRegister<double>;
+
+    static constexpr int knotsPerUnit = 32;
+    static constexpr int range = 9;
+    static constexpr int numSegments = range * knotsPerUnit;
+    static constexpr double ln2 = 0.69314718055994531;
+
+    TanhAntiderivativeTable() noexcept
+    {
+        const auto h = 1.0 / knotsPerUnit;
+        auto valueAt = [h] (int knot) { return knot == numSegments ? range - ln2 : std::log (std::cosh (knot * h)); };
+        auto slopeAt = [h] (int knot) { return knot == numSegments ? 1.0 : std::tanh (knot * h); };
+
+        for (int i = 0; i < numSegments; ++i)
+        {
+            const auto F0 = valueAt (i), F1 = valueAt (i + 1);
+            const auto d0 = slopeAt (i) * h, d1 = slopeAt (i + 1) * h;
+            segments[(size_t) i] = { F0, d0, 3.0 * (F1 - F0) - 2.0 * d0 - d1, 2.0 * (F0 - F1) + d0 + d1 };
+        }
+    }
+
+    /** log cosh (x) and tanh (x), both from the table. */
+    void evaluate (Lanes x, Lanes& F1, Lanes& f) const noexcept
+    {
+        // The segments are gathered per lane, so the cubic is evaluated there too.
+        alignas (Lanes::SIMDRegisterSize) double in[Lanes::SIMDNumElements], values[Lanes::SIMDNumElements],
+                                                 slopes[Lanes::SIMDNumElements];
+        x.copyToRawArray (in);
+
+        for (size_t lane = 0; lane < Lanes::SIMDNumElements; ++lane)
+        {
+            const auto a = std::abs (in[lane]);
+
+            if (a >= (double) range)
+            {
+                values[lane] = a - ln2;
+                slopes[lane] = in[lane] < 0.0 ? -1.0 : 1.0;
+                continue;
+            }
+
+            const auto p = a * (double) knotsPerUnit;
+            const auto index = (int) p;
+            const auto t = p - (double) index;
+            const auto& s = segments[(size_t) index];
+            const auto slope = ((s[3] * 3.0 * t + s[2] * 2.0) * t + s[1]) * (double) knotsPerUnit;
+
+            values[lane] = ((s[3] * t + s[2]) * t + s[1]) * t + s[0];
+            slopes[lane] = in[lane] < 0.0 ? -slope : slope;
+        }
+
+        F1 = Lanes::fromRawArray (values);
+        f = Lanes::fromRawArray (slopes);
+    }
+
+private:
+    std::array<std::array<double, 4>, (size_t) numSegments> segments;
+};
+
+/** Built once when the plugin loads, never on the audio thread. */
+inline const TanhAntiderivativeTable tanhAntiderivativeTable;
+
+/** Saturation curves with their first and second antiderivatives, evaluated on SIMD
+    lanes of doubles.
+
+    Everything is built from adds, multiplies, one divide and fixed polynomials, so a
+    lane group costs the same whatever the input and no libm call is made per sample.
+    tanh and expo share one range-reduced exp(-|x|); the tanh antiderivatives use
+    log1p and the dilogarithm as degree-14 fits in u = exp(-2|x|) that are exact at
+    both ends of [0, 1], so F1 (0) and F2 (0) are zero and the curves stay odd/even.
+    First-order tanh, the common case, reads TanhAntiderivativeTable instead. */
+struct WaveshaperCurves
+{
+    using Lanes = juce::dsp::SIMDRegister<double>;
+    using Mask = Lanes::vMaskType;
+
+    enum class Curve
+    {
+        hard,   // clamp to [-1, 1]
+        tanh,
+        expo,   // sign (x) * (1 - exp (-|x|))
+        fold    // sin (x)
+    };
+
+    struct Values
+    {
+        Lanes f, F1, F2;
+    };
+
+    /** f and the first `antiderivatives` antiderivatives (0 to 2) at x; the rest are left at zero. */
+    template <int antiderivatives>
+    static Values evaluate (Curve curve, Lanes x) noexcept
+    {
+        switch (curve)
+        {
+            case Curve::hard:   return hard<antiderivatives> (x);
+            case Curve::tanh:   return tanh<antiderivatives> (x);
+            case Curve::expo:   return expo<antiderivatives> (x);
+            case Curve::fold:   return fold<antiderivatives> (x);
+        }
+
+        return {};
+    }
+
+    static Lanes select (Mask mask, Lanes whenTrue, Lanes whenFalse) noexcept
+    {
+        // One side is all zero bits after masking, so the add just picks the other.
+        return (whenTrue & mask) + (whenFalse & ~mask);
+    }
+
+    static bool any (Mask mask) noexcept                { return (Lanes (1.0) & mask).sum() > 0.0; }
+
+    static Lanes divide (Lanes a, Lanes b) noexcept
+    {
+       #if JUCE_USE_SIMD && JUCE_INTEL && defined (__AVX2__)
+        return Lanes::fromNative (_mm256_div_pd (a.value, b.value));
+       #elif JUCE_USE_SIMD && JUCE_INTEL
+        return Lanes::fromNative (_mm_div_pd (a.value, b.value));
+       #elif JUCE_USE_SIMD && JUCE_ARM && JUCE_64BIT
+        return Lanes::fromNative (vdivq_f64 (a.value, b.value));
+       #else
+        Lanes result;
+        for (size_t i = 0; i < Lanes::size(); ++i)
+            result.set (i, a.get (i) / b.get (i));
+        return result;
+       #endif
+    }
+
+private:
+    static Lanes withSignOf (Lanes magnitude, Lanes x) noexcept
+    {
+        return select (Lanes::lessThan (x, Lanes (0.0)), Lanes (0.0) - magnitude, magnitude);
+    }
+
+    /** Even and odd coefficients run as two independent Horner chains in x^2, which
+        halves the dependency chain of the long fits. */
+    template <size_t n>
+    static Lanes polynomial (Lanes x, const double (&c)[n]) noexcept
+    {
+        const auto xx = x * x;
+        auto even = Lanes (c[(n - 1) & ~(size_t) 1]);
+        auto odd = Lanes (n > 1 ? c[(n - 2) | 1] : 0.0);
+
+        for (auto i = (int) ((n - 1) & ~(size_t) 1) - 2; i >= 0; i -= 2)
+            even = even * xx + c[i];
+
+        for (auto i = (int) ((n - 2) | 1) - 2; i >= 1; i -= 2)
+            odd = odd * xx + c[i];
+
+        return even + odd * x;
+    }
+
+    /** exp (-a) for a >= 0: Taylor series at a / 64, squared back up six times. */
+    static Lanes expNegative (Lanes a) noexcept
+    {
+        static constexpr double taylor[] { 1.0, -1.0, 1.0 / 2.0, -1.0 / 6.0, 1.0 / 24.0, -1.0 / 120.0, 1.0 / 720.0,
+                                           -1.0 / 5040.0, 1.0 / 40320.0, -1.0 / 362880.0, 1.0 / 3628800.0,
+                                           -1.0 / 39916800.0, 1.0 / 479001600.0 };
+
+        auto result = polynomial (Lanes::min (a, Lanes (40.0)) * (1.0 / 64.0), taylor);
+        for (int i = 0; i < 6; ++i)
+            result = result * result;
+        return result;
+    }
+
+    template <int antiderivatives>
+    static Values hard (Lanes x) noexcept
+    {
+        Values v;
+        v.f = Lanes::max (Lanes (-1.0), Lanes::min (Lanes (1.0), x));
+
+        if constexpr (antiderivatives > 0)
+        {
+            const auto a = Lanes::abs (x);
+            const auto inside = Lanes::lessThanOrEqual (a, Lanes (1.0));
+            const auto x2 = x * x * 0.5;
+            v.F1 = select (inside, x2, a - 0.5);
+
+            if constexpr (antiderivatives > 1)
+                v.F2 = select (inside, x2 * x * (1.0 / 3.0), withSignOf (x2 + 1.0 / 6.0, x) - x * 0.5);
+        }
+
+        return v;
+    }
+
+    template <int antiderivatives>
+    static Values tanh (Lanes x) noexcept
+    {
+        static constexpr double ln2 = 0.69314718055994531;
+        static constexpr double halfLi2AtMinusOne = -0.41123351671205660;   // -pi^2 / 24
+
+        // log1p (u) and Li2 (-u) on u in [0, 1], Chebyshev-Lobatto interpolants.
+        static constexpr double log1p[] { 0.0, 0.99999999993027489, -0.49999999080205165, 0.33333296776431087,
+                                          -0.24999311765507345, 0.1999254972439114, -0.16615084268749081,
+                                          0.14041674079805982, -0.11674916502392434, 0.090503960197492281,
+                                          -0.060883277311573308, 0.032735922975017394, -0.012786201472922221,
+                                          0.0031619626914995754, -0.0003672760875850773 };
+        static constexpr double li2[] { 0.0, -0.99999999999371481, 0.2499999991713332, -0.11111107821901772,
+                                        0.062499382077611305, -0.039993331690675718, 0.027731811598768891,
+                                        -0.020192020832681564, 0.014900485506305251, -0.010558144741360017,
+                                        0.0066665492233670999, -0.0034343653503882501, 0.0013036782371415054,
+                                        -0.00031624627859982833, 3.6247867797397052e-05 };
+
+        Values v;
+
+        if constexpr (antiderivatives == 1)
+        {
+            tanhAntiderivativeTable.evaluate (x, v.F1, v.f);
+            return v;
+        }
+
+        const auto a = Lanes::abs (x);
+        const auto u = expNegative (a * 2.0);
+
+        v.f = withSignOf (divide (Lanes (1.0) - u, u + 1.0), x);
+
+        if constexpr (antiderivatives > 0)
+        {
+            v.F1 = a - ln2 + polynomial (u, log1p);
+
+            if constexpr (antiderivatives > 1)
+                v.F2 = withSignOf (x * x * 0.5 + (polynomial (u, li2) * 0.5 - halfLi2AtMinusOne), x) - x * ln2;
+        }
+
+        return v;
+    }
+
+    template <int antiderivatives>
+    static Values expo (Lanes x) noexcept
+    {
+        const auto a = Lanes::abs (x);
+        const auto e = expNegative (a);
+
+        Values v;
+        v.f = withSignOf (Lanes (1.0) - e, x);
+
+        if constexpr (antiderivatives > 0)
+        {
+            v.F1 = a + e - 1.0;
+
+            if constexpr (antiderivatives > 1)
+                v.F2 = withSignOf (x * x * 0.5 - e + 1.0, x) - x;
+        }
+
+        return v;
+    }
+
+    template <int antiderivatives>
+    static Values fold (Lanes x) noexcept
+    {
+        static constexpr double sinTaylor[] { 1.0, -1.0 / 6.0, 1.0 / 120.0, -1.0 / 5040.0, 1.0 / 362880.0,
+                                              -1.0 / 39916800.0, 1.0 / 6227020800.0, -1.0 / 1307674368000.0 };
+        static constexpr double cosTaylor[] { 1.0, -1.0 / 2.0, 1.0 / 24.0, -1.0 / 720.0, 1.0 / 40320.0,
+                                              -1.0 / 3628800.0, 1.0 / 479001600.0, -1.0 / 87178291200.0,
+                                              1.0 / 20922789888000.0 };
+
+        // Reduce to [-pi, pi] (two-part 2 pi keeps k * 2 pi exact), then work on the half
+        // angle: sin x = 2 s c and 1 - cos x = 2 s^2, with no cancellation near zero.
+        constexpr double twoPiHigh = 6.28125, twoPiLow = 0.0019353071795864769;
+        const auto rounding = select (Lanes::lessThan (x, Lanes (0.0)), Lanes (-0.5), Lanes (0.5));
+        const auto k = Lanes::truncate (x * (1.0 / juce::MathConstants<double>::twoPi) + rounding);
+        const auto h = (x - k * twoPiHigh - k * twoPiLow) * 0.5;
+        const auto h2 = h * h;
+        const auto s = h * polynomial (h2, sinTaylor);
+        const auto c = polynomial (h2, cosTaylor);
+
+        Values v;
+        v.f = s * c * 2.0;
+
+        if constexpr (antiderivatives > 0)
+        {
+            v.F1 = s * s * 2.0;
+
+            if constexpr (antiderivatives > 1)
+                v.F2 = x - v.f;
+        }
+
+        return v;
+    }
+};
+
+/** Antiderivative anti-aliasing (ADAA) around a WaveshaperCurves curve.
+
+    First order outputs the difference quotient of F1 over the last two inputs; second
+    order takes the divided difference of F2 over the last three. Both fall back to the
+    curve at the midpoint when the inputs are too close for the quotient to be reliable.
+    Aliasing drops by roughly the same amount as one to two extra oversampling steps, at
+    the cost of half a sample (first order) or one sample (second order) of delay, which
+    AntiderivativeDelayMatch reproduces on the dry path.
+
+    The curve can be cross-faded with the identity, e.g. for a fold amount; the blend is
+    applied to the antiderivatives too, so it is anti-aliased as a single curve. Channels
+    are packed into SIMD lanes, like ModulatedAllPassCascade. */
+class AntiderivativeWaveshaper
+{
+public:
+    using Lanes = WaveshaperCurves::Lanes;
+    using Curve = WaveshaperCurves::Curve;
+
+    static constexpr int lanesPerGroup = (int) Lanes::SIMDNumElements;
+
+    enum class Order
+    {
+        direct,
+        first,
+        second
+    };
+
+    static constexpr const char* orderParameterId = "adaa_order";
+
+    static void addParameters (std::vector<std::unique_ptr<juce::RangedAudioParameter>>& params,
+                               Order defaultOrder = Order::first)
+    {
+        params.push_back (std::make_unique<juce::AudioParameterChoice> (orderParameterId, "Anti-Aliasing",
+                                                                        juce::StringArray { "Off", "ADAA 1", "ADAA 2" }, (int) defaultOrder));
+    }
+
+    /** Maps the "adaa_order" value; processors resolve its handle once, in their constructor. */
+    static Order getOrder (const std::atomic<float>& parameter) noexcept
+    {
+        return (Order) juce::jlimit (0, 2, (int) parameter.load (std::memory_order_relaxed));
+    }
+
+    void prepare (int numChannels)
+    {
+        groups.resize ((size_t) ((juce::jmax (1, numChannels) + lanesPerGroup - 1) / lanesPerGroup));
+        reset();
+    }
+
+    void reset() noexcept
+    {
+        for (auto& group : groups)
+            group = {};
+
+        refreshHistory();
+    }
+
+    int getNumGroups() const noexcept                   { return (int) groups.size(); }
+
+    void setCurve (Curve newCurve) noexcept
+    {
+        if (newCurve != curve)
+        {
+            curve = newCurve;
+            refreshHistory();
+        }
+    }
+
+    /** 0 = identity, 1 = the curve alone. */
+    void setCurveAmount (double newAmount) noexcept
+    {
+        newAmount = juce::jlimit (0.0, 1.0, newAmount);
+        if (! juce::exactlyEqual (newAmount, amount))
+        {
+            amount = newAmount;
+            refreshHistory();
+        }
+    }
+
+    void setOrder (Order newOrder) noexcept
+    {
+        if (newOrder != order)
+        {
+            order = newOrder;
+            refreshHistory();
+        }
+    }
+
+    /** One sample of lane group `group` (channels group * lanesPerGroup onwards). */
+    Lanes processSample (int group, Lanes x) noexcept
+    {
+        auto& state = groups[(size_t) group];
+        x = Lanes::max (Lanes (-inputLimit), Lanes::min (Lanes (inputLimit), x));
+
+        Lanes y;
+        switch (order)
+        {
+            case Order::direct:     y = shape<0> (x).f; break;
+            case Order::first:      y = processFirstOrder (state, x); break;
+            case Order::second:     y = processSecondOrder (state, x); break;
+        }
+
+        state.x2 = state.x1;
+        state.x1 = x;
+        return y;
+    }
+
+private:
+    using Math = WaveshaperCurves;
+
+    static constexpr double tolerance = 1.0e-4;
+    static constexpr double inputLimit = 1000.0;
+
+    struct GroupState
+    {
+        Lanes x1 { 0.0 }, x2 { 0.0 };
+        Lanes F1 { 0.0 }, F2 { 0.0 };   // at x1
+        Lanes quotient { 0.0 };         // (F2 (x1) - F2 (x2)) / (x1 - x2)
+    };
+
+    template <int antiderivatives>
+    WaveshaperCurves::Values shape (Lanes x) const noexcept
+    {
+        auto v = Math::evaluate<antiderivatives> (curve, x);
+
+        if (amount < 1.0)
+        {
+            const auto x2 = x * x * 0.5;
+            v.f = x + (v.f - x) * amount;
+
+            if constexpr (antiderivatives > 0)
+                v.F1 = x2 + (v.F1 - x2) * amount;
+
+            if constexpr (antiderivatives > 1)
+                v.F2 = x2 * x * (1.0 / 3.0) + (v.F2 - x2 * x * (1.0 / 3.0)) * amount;
+        }
+
+        return v;
+    }
+
+    static WaveshaperCurves::Mask isIllConditioned (Lanes difference) noexcept
+    {
+        return Lanes::lessThan (Lanes::abs (difference), Lanes (tolerance));
+    }
+
+    /** Ill-conditioned lanes divide by one instead; the caller replaces their result. */
+    static Lanes safeDivide (Lanes numerator, Lanes denominator, WaveshaperCurves::Mask illConditioned) noexcept
+    {
+        return Math::divide (numerator, Math::select (illConditioned, Lanes (1.0), denominator));
+    }
+
+    /** (F2 (a) - F2 (b)) / (a - b), or F1 at the midpoint when a and b nearly coincide. */
+    Lanes secondOrderQuotient (Lanes a, Lanes b, Lanes F2a, Lanes F2b) const noexcept
+    {
+        const auto difference = a - b;
+        const auto ill = isIllConditioned (difference);
+        auto quotient = safeDivide (F2a - F2b, difference, ill);
+
+        if (Math::any (ill))
+            quotient = Math::select (ill, shape<1> ((a + b) * 0.5).F1, quotient);
+
+        return quotient;
+    }
+
+    Lanes processFirstOrder (GroupState& state, Lanes x) const noexcept
+    {
+        const auto v = shape<1> (x);
+        const auto difference = x - state.x1;
+        const auto ill = isIllConditioned (difference);
+        auto y = safeDivide (v.F1 - state.F1, difference, ill);
+
+        if (Math::any (ill))
+            y = Math::select (ill, shape<0> ((x + state.x1) * 0.5).f, y);
+
+        state.F1 = v.F1;
+        return y;
+    }
+
+    Lanes processSecondOrder (GroupState& state, Lanes x) const noexcept
+    {
+        const auto v = shape<2> (x);
+        const auto quotient = secondOrderQuotient (x, state.x1, v.F2, state.F2);
+        const auto difference = x - state.x2;
+        const auto ill = isIllConditioned (difference);
+        auto y = safeDivide ((quotient - state.quotient) * 2.0, difference, ill);
+
+        if (Math::any (ill))
+        {
+            // x ~ x2: expand around their mean instead of dividing by their difference.
+            const auto mean = (x + state.x2) * 0.5;
+            const auto delta = mean - state.x1;
+            const auto illDelta = isIllConditioned (delta);
+            const auto m = shape<2> (mean);
+            auto fallback = safeDivide ((m.F1 + safeDivide (state.F2 - m.F2, delta, illDelta)) * 2.0, delta, illDelta);
+
+            if (Math::any (illDelta))
+                fallback = Math::select (illDelta, shape<0> ((mean + state.x1) * 0.5).f, fallback);
+
+            y = Math::select (ill, fallback, y);
+        }
+
+        state.F2 = v.F2;
+        state.quotient = quotient;
+        return y;
+    }
+
+    /** Re-derives the cached antiderivatives after the curve, amount or order changed. */
+    void refreshHistory() noexcept
+    {
+        for (auto& state : groups)
+        {
+            const auto v1 = shape<2> (state.x1);
+            const auto v2 = shape<2> (state.x2);
+            state.F1 = shape<1> (state.x1).F1;      // as processFirstOrder() will compute it
+            state.F2 = v1.F2;
+            state.quotient = secondOrderQuotient (state.x1, state.x2, v1.F2, v2.F2);
+        }
+    }
+
+    std::vector<GroupState> groups;
+    Curve curve = Curve::tanh;
+    Order order = Order::first;
+    double amount = 1.0;
+};
+
+/** The response ADAA gives the linear part of a curve: a 2-tap (first order) or 3-tap
+    (second order) moving average per shaper stage. Run the dry signal through it so
+    dry/wet mixes line up with the anti-aliased path instead of combing. */
+class AntiderivativeDelayMatch
+{
+public:
+    using Lanes = AntiderivativeWaveshaper::Lanes;
+    using Order = AntiderivativeWaveshaper::Order;
+
+    static constexpr int maxStages = 2;
+    static constexpr int maxTaps = 2 * maxStages + 1;
+
+    void prepare (int numChannels)
+    {
+        histories.resize ((size_t) ((juce::jmax (1, numChannels) + AntiderivativeWaveshaper::lanesPerGroup - 1)
+                                    / AntiderivativeWaveshaper::lanesPerGroup));
+        reset();
+    }
+
+    void reset() noexcept
+    {
+        for (auto& history : histories)
+            history.fill (Lanes (0.0));
+    }
+
+    /** Matches `numStages` cascaded shapers running at `order`. */
+    void setOrder (Order order, int numStages = 1) noexcept
+    {
+        std::array<double, maxTaps> kernel {};
+        kernel[0] = 1.0;
+        numTaps = 1;
+
+        const auto stageTaps = (int) order + 1;
+        for (int stage = 0; stage < juce::jlimit (0, maxStages, numStages); ++stage)
+        {
+            std::array<double, maxTaps> next {};
+            for (int i = 0; i < numTaps; ++i)
+                for (int j = 0; j < stageTaps; ++j)
+                    next[(size_t) (i + j)] += kernel[(size_t) i] / (double) stageTaps;
+
+            kernel = next;
+            numTaps += stageTaps - 1;
+        }
+
+        coefficients = kernel;
+    }
+
+    Lanes processSample (int group, Lanes x) noexcept
+    {
+        auto& history = histories[(size_t) group];
+
+        for (int i = numTaps - 1; i > 0; --i)
+            history[(size_t) i] = history[(size_t) i - 1];
+
+        history[0] = x;
+
+        auto y = x * coefficients[0];
+        for (int i = 1; i < numTaps; ++i)
+            y += history[(size_t) i] * coefficients[(size_t) i];
+
+        return y;
+    }
+
+private:
+    std::vector<std::array<Lanes, maxTaps>> histories;
+    std::array<double, maxTaps> coefficients { 1.0 };
+    int numTaps = 1;
+};
+} // namespace gls::dsp
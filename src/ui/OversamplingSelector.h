@@ -0,0 +1,56 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include "../dsp/Oversampler.h"
+#include "../dsp/Waveshaper.h"
+
+namespace gls::ui
+{
+/** Factor and filter-mode boxes for a processor that uses gls::dsp::Oversampler, plus
+    the ADAA order when the processor also exposes gls::dsp::AntiderivativeWaveshaper. */
+class OversamplingSelector : public juce::Component
+{
+public:
+    explicit OversamplingSelector (juce::AudioProcessorValueTreeState& state)
+    {
+        initBox (factorBox, state, gls::dsp::Oversampler<float>::factorParameterId, factorAttachment);
+        initBox (modeBox, state, gls::dsp::Oversampler<float>::modeParameterId, modeAttachment);
+
+        if (state.getParameter (gls::dsp::AntiderivativeWaveshaper::orderParameterId) != nullptr)
+            initBox (orderBox, state, gls::dsp::AntiderivativeWaveshaper::orderParameterId, orderAttachment);
+
+        label.setText ("Oversampling", juce::dontSendNotification);
+        label.setJustificationType (juce::Justification::centredRight);
+        addAndMakeVisible (label);
+    }
+
+    void resized() override
+    {
+        auto area = getLocalBounds();
+
+        if (orderAttachment != nullptr)
+            orderBox.setBounds (area.removeFromRight (juce::jmin (100, area.getWidth() / 3)).reduced (2));
+
+        modeBox.setBounds (area.removeFromRight (juce::jmin (130, area.getWidth() / 2)).reduced (2));
+        factorBox.setBounds (area.removeFromRight (juce::jmin (70, area.getWidth() / 2)).reduced (2));
+        label.setBounds (area);
+    }
+
+private:
+    using Attachment = juce::AudioProcessorValueTreeState::ComboBoxAttachment;
+
+    void initBox (juce::ComboBox& box, juce::AudioProcessorValueTreeState& state, const char* id,
+                  std::unique_ptr<Attachment>& attachment)
+    {
+        if (auto* choice = dynamic_cast<juce::AudioParameterChoice*> (state.getParameter (id)))
+            box.addItemList (choice->choices, 1);
+
+        addAndMakeVisible (box);
+        attachment = std::make_unique<Attachment> (state, id, box);
+    }
+
+    juce::Label label;
+    juce::ComboBox factorBox, modeBox, orderBox;
+    std::unique_ptr<Attachment> factorAttachment, modeAttachment, orderAttachment;
+};
+} // namespace gls::ui
@@ -0,0 +1,111 @@
+#pragma once
+
+#include <JuceHeader.h>
+#include "../dsp/SpectrumAnalyser.h"
+#include "GoodluckLookAndFeel.h"
+
+namespace gls::ui
+{
+/** Log-frequency spectrum of a gls::dsp::SpectrumAnalyser, drawn as a filled curve with
+    a transparent background so it can sit behind other visuals. Registers as a viewer
+    only while showing, and rebuilds its path only when a new frame has arrived. */
+class SpectrumView : public juce::Component, private juce::Timer
+{
+public:
+    SpectrumView (gls::dsp::SpectrumAnalyser& source, juce::Colour colour)
+        : analyser (source), accent (colour)
+    {
+        levels.fill (gls::dsp::SpectrumAnalyser::floorDb);
+        setInterceptsMouseClicks (false, false);
+    }
+
+    ~SpectrumView() override
+    {
+        setViewing (false);
+    }
+
+    /** Range mapped to the component's height. */
+    void setRange (float newMinimumDb, float newMaximumDb)
+    {
+        minimumDb = newMinimumDb;
+        maximumDb = juce::jmax (newMinimumDb + 1.0f, newMaximumDb);
+        rebuildPath();
+    }
+
+    void paint (juce::Graphics& g) override
+    {
+        if (curve.isEmpty())
+            return;
+
+        auto filled = curve;
+        const auto bounds = getLocalBounds().toFloat();
+        filled.lineTo (bounds.getBottomRight());
+        filled.lineTo (bounds.getBottomLeft());
+        filled.closeSubPath();
+
+        g.setColour (accent.withAlpha (0.18f));
+        g.fillPath (filled);
+        g.setColour (accent.withAlpha (0.7f));
+        g.strokePath (curve, juce::PathStrokeType (1.3f));
+    }
+
+    void resized() override                             { rebuildPath(); }
+    void visibilityChanged() override                   { setViewing (isShowing()); }
+    void parentHierarchyChanged() override              { setViewing (isShowing()); }
+
+private:
+    gls::dsp::SpectrumAnalyser& analyser;
+    juce::Colour accent;
+    gls::dsp::SpectrumAnalyser::Frame levels;
+    juce::Path curve;
+    float minimumDb = -90.0f, maximumDb = 0.0f;
+    bool viewing = false;
+
+    void setViewing (bool shouldView)
+    {
+        if (shouldView == viewing)
+            return;
+
+        viewing = shouldView;
+        if (viewing)
+        {
+            analyser.addViewer();
+            startTimerHz (30);
+        }
+        else
+        {
+            stopTimer();
+            analyser.removeViewer();
+        }
+    }
+
+    void timerCallback() override
+    {
+        if (analyser.fetch (levels))
+        {
+            rebuildPath();
+            repaint();
+        }
+    }
+
+    void rebuildPath()
+    {
+        curve.clear();
+        const auto bounds = getLocalBounds().toFloat();
+        if (bounds.isEmpty())
+            return;
+
+        const auto step = bounds.getWidth() / (float) (gls::dsp::SpectrumAnalyser::numBins - 1);
+        for (int b = 0; b < gls::dsp::SpectrumAnalyser::numBins; ++b)
+        {
+            const auto norm = juce::jlimit (0.0f, 1.0f, (levels[(size_t) b] - minimumDb) / (maximumDb - minimumDb));
+            const juce::Point<float> point (bounds.getX() + (float) b * step, bounds.getBottom() - norm * bounds.getHeight());
+
+            if (b == 0)
+                curve.startNewSubPath (point);
+            else
+                curve.lineTo (point);
+        }
+    }
+};
+} // namespace gls::ui